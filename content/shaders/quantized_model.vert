@@ -0,0 +1,55 @@
+#version 450
+
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+//vertex shader of VERTEX_QUANTIZED_POSITION_NORMAL_UV_TANGENT_COLOR_BLEND_WEIGHT_BLEND_INDICES, fragment shader can be basic.frag
+
+layout(binding=0) uniform UBO
+{
+    mat4 projection_view;
+	mat4 model;
+} ubo;
+
+//w_mesh_dequantization of mesh
+layout(push_constant) uniform DEQUANTIZATION
+{
+	vec4 position_scale;
+	vec4 position_offset;
+} dequantization;
+
+//snorm and unorm attributes are converted to float by vertex input, blend weight and blend indices are not used
+layout(location = 0) in vec4 i_position;
+layout(location = 1) in vec2 i_normal;
+layout(location = 2) in vec2 i_uv;
+layout(location = 3) in vec4 i_tangent;
+layout(location = 4) in vec4 i_color;
+
+layout(location = 0) out vec2 o_uv;
+layout(location = 1) out vec3 o_normal;
+layout(location = 2) out vec4 o_tangent;
+layout(location = 3) out vec4 o_color;
+
+vec3 decode_octahedral(vec2 pEncoded)
+{
+	vec3 _n = vec3(pEncoded, 1.0 - abs(pEncoded.x) - abs(pEncoded.y));
+	if (_n.z < 0.0)
+	{
+		vec2 _sign = vec2(_n.x >= 0.0 ? 1.0 : -1.0, _n.y >= 0.0 ? 1.0 : -1.0);
+		_n.xy = (1.0 - abs(_n.yx)) * _sign;
+	}
+	return normalize(_n);
+}
+
+void main() 
+{
+	vec3 _position = i_position.xyz * dequantization.position_scale.xyz + dequantization.position_offset.xyz;
+	gl_Position = ubo.projection_view * ubo.model * vec4(_position, 1.0);
+
+	mat3 _normal_mat = mat3(ubo.model);
+	o_uv = i_uv;
+	o_normal = normalize(_normal_mat * decode_octahedral(i_normal));
+	//w is the sign of binormal
+	o_tangent = vec4(normalize(_normal_mat * decode_octahedral(i_tangent.xy)), i_tangent.w < 0.0 ? -1.0 : 1.0);
+	o_color = i_color;
+}
@@ -70,6 +70,10 @@ OBJECTFILES= \
 	${OBJECTDIR}/_ext/80a4cd0d/c_parser.o \
 	${OBJECTDIR}/_ext/cbdfc7ea/w_bounding.o \
 	${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_model.o \
+	${OBJECTDIR}/_ext/cbdfc7ea/w_mapped_scene.o \
+	${OBJECTDIR}/_ext/cbdfc7ea/w_mesh_optimizer.o \
+	${OBJECTDIR}/_ext/cbdfc7ea/w_texture_cooker.o \
+	${OBJECTDIR}/_ext/cbdfc7ea/w_vertex_quantizer.o \
 	${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_pch.o \
 	${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_scene.o
 
@@ -273,6 +277,26 @@ ${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_model.o: ../../../src/wolf.content_pipeli
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__WOLF_CONTENT_PIPELINE__ -I../../../src/wolf.system -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_model.o ../../../src/wolf.content_pipeline/w_cpipeline_model.cpp
 
+${OBJECTDIR}/_ext/cbdfc7ea/w_mapped_scene.o: ../../../src/wolf.content_pipeline/w_mapped_scene.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/cbdfc7ea
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__WOLF_CONTENT_PIPELINE__ -I../../../src/wolf.system -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/cbdfc7ea/w_mapped_scene.o ../../../src/wolf.content_pipeline/w_mapped_scene.cpp
+
+${OBJECTDIR}/_ext/cbdfc7ea/w_mesh_optimizer.o: ../../../src/wolf.content_pipeline/w_mesh_optimizer.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/cbdfc7ea
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__WOLF_CONTENT_PIPELINE__ -I../../../src/wolf.system -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/cbdfc7ea/w_mesh_optimizer.o ../../../src/wolf.content_pipeline/w_mesh_optimizer.cpp
+
+${OBJECTDIR}/_ext/cbdfc7ea/w_texture_cooker.o: ../../../src/wolf.content_pipeline/w_texture_cooker.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/cbdfc7ea
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__WOLF_CONTENT_PIPELINE__ -I../../../src/wolf.system -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/cbdfc7ea/w_texture_cooker.o ../../../src/wolf.content_pipeline/w_texture_cooker.cpp
+
+${OBJECTDIR}/_ext/cbdfc7ea/w_vertex_quantizer.o: ../../../src/wolf.content_pipeline/w_vertex_quantizer.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/cbdfc7ea
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__WOLF_CONTENT_PIPELINE__ -I../../../src/wolf.system -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/cbdfc7ea/w_vertex_quantizer.o ../../../src/wolf.content_pipeline/w_vertex_quantizer.cpp
+
 ${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_pch.o: ../../../src/wolf.content_pipeline/w_cpipeline_pch.cpp nbproject/Makefile-${CND_CONF}.mk
 	${MKDIR} -p ${OBJECTDIR}/_ext/cbdfc7ea
 	${RM} "$@.d"
@@ -70,6 +70,10 @@ OBJECTFILES= \
 	${OBJECTDIR}/_ext/80a4cd0d/c_parser.o \
 	${OBJECTDIR}/_ext/cbdfc7ea/w_bounding.o \
 	${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_model.o \
+	${OBJECTDIR}/_ext/cbdfc7ea/w_mapped_scene.o \
+	${OBJECTDIR}/_ext/cbdfc7ea/w_mesh_optimizer.o \
+	${OBJECTDIR}/_ext/cbdfc7ea/w_texture_cooker.o \
+	${OBJECTDIR}/_ext/cbdfc7ea/w_vertex_quantizer.o \
 	${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_pch.o \
 	${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_scene.o
 
@@ -275,6 +279,26 @@ ${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_model.o: ../../../src/wolf.content_pipeli
 	${RM} "$@.d"
 	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_model.o ../../../src/wolf.content_pipeline/w_cpipeline_model.cpp
 
+${OBJECTDIR}/_ext/cbdfc7ea/w_mapped_scene.o: ../../../src/wolf.content_pipeline/w_mapped_scene.cpp
+	${MKDIR} -p ${OBJECTDIR}/_ext/cbdfc7ea
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/cbdfc7ea/w_mapped_scene.o ../../../src/wolf.content_pipeline/w_mapped_scene.cpp
+
+${OBJECTDIR}/_ext/cbdfc7ea/w_mesh_optimizer.o: ../../../src/wolf.content_pipeline/w_mesh_optimizer.cpp
+	${MKDIR} -p ${OBJECTDIR}/_ext/cbdfc7ea
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/cbdfc7ea/w_mesh_optimizer.o ../../../src/wolf.content_pipeline/w_mesh_optimizer.cpp
+
+${OBJECTDIR}/_ext/cbdfc7ea/w_texture_cooker.o: ../../../src/wolf.content_pipeline/w_texture_cooker.cpp
+	${MKDIR} -p ${OBJECTDIR}/_ext/cbdfc7ea
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/cbdfc7ea/w_texture_cooker.o ../../../src/wolf.content_pipeline/w_texture_cooker.cpp
+
+${OBJECTDIR}/_ext/cbdfc7ea/w_vertex_quantizer.o: ../../../src/wolf.content_pipeline/w_vertex_quantizer.cpp
+	${MKDIR} -p ${OBJECTDIR}/_ext/cbdfc7ea
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/cbdfc7ea/w_vertex_quantizer.o ../../../src/wolf.content_pipeline/w_vertex_quantizer.cpp
+
 ${OBJECTDIR}/_ext/cbdfc7ea/w_cpipeline_pch.o: ../../../src/wolf.content_pipeline/w_cpipeline_pch.cpp
 	${MKDIR} -p ${OBJECTDIR}/_ext/cbdfc7ea
 	${RM} "$@.d"
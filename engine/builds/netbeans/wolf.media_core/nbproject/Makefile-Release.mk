@@ -36,6 +36,9 @@ OBJECTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}
 # Object Files
 OBJECTFILES= \
 	${OBJECTDIR}/_ext/a83248dc/w_media_core.o \
+	${OBJECTDIR}/_ext/a83248dc/w_media_frame_converter.o \
+	${OBJECTDIR}/_ext/a83248dc/w_media_pipeline.o \
+	${OBJECTDIR}/_ext/a83248dc/w_media_stream_server.o \
 	${OBJECTDIR}/_ext/a83248dc/w_media_core_pch.o
 
 
@@ -68,6 +71,21 @@ ${OBJECTDIR}/_ext/a83248dc/w_media_core.o: ../../../src/wolf.media_core/w_media_
 	${RM} "$@.d"
 	$(COMPILE.cc) -O2 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/a83248dc/w_media_core.o ../../../src/wolf.media_core/w_media_core.cpp
 
+${OBJECTDIR}/_ext/a83248dc/w_media_frame_converter.o: ../../../src/wolf.media_core/w_media_frame_converter.cpp
+	${MKDIR} -p ${OBJECTDIR}/_ext/a83248dc
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/a83248dc/w_media_frame_converter.o ../../../src/wolf.media_core/w_media_frame_converter.cpp
+
+${OBJECTDIR}/_ext/a83248dc/w_media_pipeline.o: ../../../src/wolf.media_core/w_media_pipeline.cpp
+	${MKDIR} -p ${OBJECTDIR}/_ext/a83248dc
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/a83248dc/w_media_pipeline.o ../../../src/wolf.media_core/w_media_pipeline.cpp
+
+${OBJECTDIR}/_ext/a83248dc/w_media_stream_server.o: ../../../src/wolf.media_core/w_media_stream_server.cpp
+	${MKDIR} -p ${OBJECTDIR}/_ext/a83248dc
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/a83248dc/w_media_stream_server.o ../../../src/wolf.media_core/w_media_stream_server.cpp
+
 ${OBJECTDIR}/_ext/a83248dc/w_media_core_pch.o: ../../../src/wolf.media_core/w_media_core_pch.cpp
 	${MKDIR} -p ${OBJECTDIR}/_ext/a83248dc
 	${RM} "$@.d"
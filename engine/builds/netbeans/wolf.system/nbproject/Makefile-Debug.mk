@@ -37,6 +37,7 @@ OBJECTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}
 OBJECTFILES= \
 	${OBJECTDIR}/_ext/a293c7f6/glm.o \
 	${OBJECTDIR}/_ext/26f1a4f1/w_inputs_manager.o \
+	${OBJECTDIR}/_ext/26f1a4f1/w_async_loader.o \
 	${OBJECTDIR}/_ext/26f1a4f1/w_logger.o \
 	${OBJECTDIR}/_ext/26f1a4f1/w_lua.o \
 	${OBJECTDIR}/_ext/26f1a4f1/w_network.o \
@@ -46,6 +47,9 @@ OBJECTFILES= \
 	${OBJECTDIR}/_ext/26f1a4f1/w_tcp_client.o \
 	${OBJECTDIR}/_ext/26f1a4f1/w_thread.o \
 	${OBJECTDIR}/_ext/26f1a4f1/w_thread_pool.o \
+	${OBJECTDIR}/_ext/26f1a4f1/w_job_system.o \
+	${OBJECTDIR}/_ext/26f1a4f1/w_bounding_batch.o \
+	${OBJECTDIR}/_ext/26f1a4f1/w_cpu.o \
 	${OBJECTDIR}/_ext/26f1a4f1/w_time_span.o \
 	${OBJECTDIR}/_ext/26f1a4f1/w_window.o \
 	${OBJECTDIR}/_ext/26f1a4f1/w_xml.o \
@@ -86,6 +90,11 @@ ${OBJECTDIR}/_ext/26f1a4f1/w_inputs_manager.o: ../../../src/wolf.system/w_inputs
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -DNN_HAVE_ACCEPT4=1 -DNN_HAVE_BACKTRACE=1 -DNN_HAVE_CLOCK_GETTIME=1 -DNN_HAVE_CLOCK_MONOTONIC=1 -DNN_HAVE_EPOLL=1 -DNN_HAVE_EVENTFD=1 -DNN_HAVE_GCC_ATOMIC_BUILTINS -DNN_HAVE_GETADDRINFO_A=1 -DNN_HAVE_LIBNSL=1 -DNN_HAVE_LINUX -DNN_HAVE_MSG_CONTROL=1 -DNN_HAVE_PIPE2=1 -DNN_HAVE_PIPE=1 -DNN_HAVE_POLL=1 -DNN_HAVE_SEMAPHORE -DNN_HAVE_SEMAPHORE_PTHREAD=1 -DNN_HAVE_SOCKETPAIR=1 -DNN_HAVE_UNIX_SOCKETS=1 -DNN_MAX_SOCKETS=512 -DNN_STATIC_LIB -D_DEBUG -D_GNU_SOURCE -D_POSIX_PTHREAD_SEMANTICS -D_REENTRANT -D_THREAD_SAFE -D__LUA__ -D__WOLF_SYSTEM__ -I../../../src/wolf.system -I../../../dependencies/luaJIT/include -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/nanomsg/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/26f1a4f1/w_inputs_manager.o ../../../src/wolf.system/w_inputs_manager.cpp
 
+${OBJECTDIR}/_ext/26f1a4f1/w_async_loader.o: ../../../src/wolf.system/w_async_loader.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/26f1a4f1
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -DNN_HAVE_ACCEPT4=1 -DNN_HAVE_BACKTRACE=1 -DNN_HAVE_CLOCK_GETTIME=1 -DNN_HAVE_CLOCK_MONOTONIC=1 -DNN_HAVE_EPOLL=1 -DNN_HAVE_EVENTFD=1 -DNN_HAVE_GCC_ATOMIC_BUILTINS -DNN_HAVE_GETADDRINFO_A=1 -DNN_HAVE_LIBNSL=1 -DNN_HAVE_LINUX -DNN_HAVE_MSG_CONTROL=1 -DNN_HAVE_PIPE2=1 -DNN_HAVE_PIPE=1 -DNN_HAVE_POLL=1 -DNN_HAVE_SEMAPHORE -DNN_HAVE_SEMAPHORE_PTHREAD=1 -DNN_HAVE_SOCKETPAIR=1 -DNN_HAVE_UNIX_SOCKETS=1 -DNN_MAX_SOCKETS=512 -DNN_STATIC_LIB -D_DEBUG -D_GNU_SOURCE -D_POSIX_PTHREAD_SEMANTICS -D_REENTRANT -D_THREAD_SAFE -D__LUA__ -D__WOLF_SYSTEM__ -I../../../src/wolf.system -I../../../dependencies/luaJIT/include -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/nanomsg/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/26f1a4f1/w_async_loader.o ../../../src/wolf.system/w_async_loader.cpp
+
 ${OBJECTDIR}/_ext/26f1a4f1/w_logger.o: ../../../src/wolf.system/w_logger.cpp nbproject/Makefile-${CND_CONF}.mk
 	${MKDIR} -p ${OBJECTDIR}/_ext/26f1a4f1
 	${RM} "$@.d"
@@ -131,6 +140,21 @@ ${OBJECTDIR}/_ext/26f1a4f1/w_thread_pool.o: ../../../src/wolf.system/w_thread_po
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -DNN_HAVE_ACCEPT4=1 -DNN_HAVE_BACKTRACE=1 -DNN_HAVE_CLOCK_GETTIME=1 -DNN_HAVE_CLOCK_MONOTONIC=1 -DNN_HAVE_EPOLL=1 -DNN_HAVE_EVENTFD=1 -DNN_HAVE_GCC_ATOMIC_BUILTINS -DNN_HAVE_GETADDRINFO_A=1 -DNN_HAVE_LIBNSL=1 -DNN_HAVE_LINUX -DNN_HAVE_MSG_CONTROL=1 -DNN_HAVE_PIPE2=1 -DNN_HAVE_PIPE=1 -DNN_HAVE_POLL=1 -DNN_HAVE_SEMAPHORE -DNN_HAVE_SEMAPHORE_PTHREAD=1 -DNN_HAVE_SOCKETPAIR=1 -DNN_HAVE_UNIX_SOCKETS=1 -DNN_MAX_SOCKETS=512 -DNN_STATIC_LIB -D_DEBUG -D_GNU_SOURCE -D_POSIX_PTHREAD_SEMANTICS -D_REENTRANT -D_THREAD_SAFE -D__LUA__ -D__WOLF_SYSTEM__ -I../../../src/wolf.system -I../../../dependencies/luaJIT/include -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/nanomsg/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/26f1a4f1/w_thread_pool.o ../../../src/wolf.system/w_thread_pool.cpp
 
+${OBJECTDIR}/_ext/26f1a4f1/w_job_system.o: ../../../src/wolf.system/w_job_system.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/26f1a4f1
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -DNN_HAVE_ACCEPT4=1 -DNN_HAVE_BACKTRACE=1 -DNN_HAVE_CLOCK_GETTIME=1 -DNN_HAVE_CLOCK_MONOTONIC=1 -DNN_HAVE_EPOLL=1 -DNN_HAVE_EVENTFD=1 -DNN_HAVE_GCC_ATOMIC_BUILTINS -DNN_HAVE_GETADDRINFO_A=1 -DNN_HAVE_LIBNSL=1 -DNN_HAVE_LINUX -DNN_HAVE_MSG_CONTROL=1 -DNN_HAVE_PIPE2=1 -DNN_HAVE_PIPE=1 -DNN_HAVE_POLL=1 -DNN_HAVE_SEMAPHORE -DNN_HAVE_SEMAPHORE_PTHREAD=1 -DNN_HAVE_SOCKETPAIR=1 -DNN_HAVE_UNIX_SOCKETS=1 -DNN_MAX_SOCKETS=512 -DNN_STATIC_LIB -D_DEBUG -D_GNU_SOURCE -D_POSIX_PTHREAD_SEMANTICS -D_REENTRANT -D_THREAD_SAFE -D__LUA__ -D__WOLF_SYSTEM__ -I../../../src/wolf.system -I../../../dependencies/luaJIT/include -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/nanomsg/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/26f1a4f1/w_job_system.o ../../../src/wolf.system/w_job_system.cpp
+
+${OBJECTDIR}/_ext/26f1a4f1/w_bounding_batch.o: ../../../src/wolf.system/w_bounding_batch.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/26f1a4f1
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -DNN_HAVE_ACCEPT4=1 -DNN_HAVE_BACKTRACE=1 -DNN_HAVE_CLOCK_GETTIME=1 -DNN_HAVE_CLOCK_MONOTONIC=1 -DNN_HAVE_EPOLL=1 -DNN_HAVE_EVENTFD=1 -DNN_HAVE_GCC_ATOMIC_BUILTINS -DNN_HAVE_GETADDRINFO_A=1 -DNN_HAVE_LIBNSL=1 -DNN_HAVE_LINUX -DNN_HAVE_MSG_CONTROL=1 -DNN_HAVE_PIPE2=1 -DNN_HAVE_PIPE=1 -DNN_HAVE_POLL=1 -DNN_HAVE_SEMAPHORE -DNN_HAVE_SEMAPHORE_PTHREAD=1 -DNN_HAVE_SOCKETPAIR=1 -DNN_HAVE_UNIX_SOCKETS=1 -DNN_MAX_SOCKETS=512 -DNN_STATIC_LIB -D_DEBUG -D_GNU_SOURCE -D_POSIX_PTHREAD_SEMANTICS -D_REENTRANT -D_THREAD_SAFE -D__LUA__ -D__WOLF_SYSTEM__ -I../../../src/wolf.system -I../../../dependencies/luaJIT/include -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/nanomsg/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/26f1a4f1/w_bounding_batch.o ../../../src/wolf.system/w_bounding_batch.cpp
+
+${OBJECTDIR}/_ext/26f1a4f1/w_cpu.o: ../../../src/wolf.system/w_cpu.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/26f1a4f1
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -DNN_HAVE_ACCEPT4=1 -DNN_HAVE_BACKTRACE=1 -DNN_HAVE_CLOCK_GETTIME=1 -DNN_HAVE_CLOCK_MONOTONIC=1 -DNN_HAVE_EPOLL=1 -DNN_HAVE_EVENTFD=1 -DNN_HAVE_GCC_ATOMIC_BUILTINS -DNN_HAVE_GETADDRINFO_A=1 -DNN_HAVE_LIBNSL=1 -DNN_HAVE_LINUX -DNN_HAVE_MSG_CONTROL=1 -DNN_HAVE_PIPE2=1 -DNN_HAVE_PIPE=1 -DNN_HAVE_POLL=1 -DNN_HAVE_SEMAPHORE -DNN_HAVE_SEMAPHORE_PTHREAD=1 -DNN_HAVE_SOCKETPAIR=1 -DNN_HAVE_UNIX_SOCKETS=1 -DNN_MAX_SOCKETS=512 -DNN_STATIC_LIB -D_DEBUG -D_GNU_SOURCE -D_POSIX_PTHREAD_SEMANTICS -D_REENTRANT -D_THREAD_SAFE -D__LUA__ -D__WOLF_SYSTEM__ -I../../../src/wolf.system -I../../../dependencies/luaJIT/include -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/nanomsg/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/26f1a4f1/w_cpu.o ../../../src/wolf.system/w_cpu.cpp
+
 ${OBJECTDIR}/_ext/26f1a4f1/w_time_span.o: ../../../src/wolf.system/w_time_span.cpp nbproject/Makefile-${CND_CONF}.mk
 	${MKDIR} -p ${OBJECTDIR}/_ext/26f1a4f1
 	${RM} "$@.d"
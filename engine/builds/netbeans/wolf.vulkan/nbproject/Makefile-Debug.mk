@@ -48,6 +48,14 @@ OBJECTFILES= \
 	${OBJECTDIR}/_ext/1b66276a/w_buffer.o \
 	${OBJECTDIR}/_ext/1b66276a/w_command_buffer.o \
 	${OBJECTDIR}/_ext/1b66276a/w_fences.o \
+	${OBJECTDIR}/_ext/1b66276a/w_memory_allocator.o \
+	${OBJECTDIR}/_ext/1b66276a/w_upload_manager.o \
+	${OBJECTDIR}/_ext/1b66276a/w_uniform_ring.o \
+	${OBJECTDIR}/_ext/1b66276a/w_video_texture.o \
+	${OBJECTDIR}/_ext/1b66276a/w_bindless_texture_table.o \
+	${OBJECTDIR}/_ext/1b66276a/w_texture_streamer.o \
+	${OBJECTDIR}/_ext/1b66276a/w_parallel_command_buffers.o \
+	${OBJECTDIR}/_ext/1b66276a/w_gpu_driven_renderer.o \
 	${OBJECTDIR}/_ext/1b66276a/w_frame_buffer.o \
 	${OBJECTDIR}/_ext/1b66276a/w_imgui.o \
 	${OBJECTDIR}/_ext/1b66276a/w_mesh.o \
@@ -151,6 +159,46 @@ ${OBJECTDIR}/_ext/1b66276a/w_fences.o: ../../../src/wolf.render/w_graphics/w_fen
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__VULKAN__ -D__WOLF_RENDER__ -I../../../src/wolf.system -I../../../src/wolf.render -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -I../../../../../../VulkanSDK/1.0.65.0/x86_64/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/1b66276a/w_fences.o ../../../src/wolf.render/w_graphics/w_fences.cpp
 
+${OBJECTDIR}/_ext/1b66276a/w_memory_allocator.o: ../../../src/wolf.render/w_graphics/w_memory_allocator.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/1b66276a
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__VULKAN__ -D__WOLF_RENDER__ -I../../../src/wolf.system -I../../../src/wolf.render -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -I../../../../../../VulkanSDK/1.0.65.0/x86_64/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/1b66276a/w_memory_allocator.o ../../../src/wolf.render/w_graphics/w_memory_allocator.cpp
+
+${OBJECTDIR}/_ext/1b66276a/w_upload_manager.o: ../../../src/wolf.render/w_graphics/w_upload_manager.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/1b66276a
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__VULKAN__ -D__WOLF_RENDER__ -I../../../src/wolf.system -I../../../src/wolf.render -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -I../../../../../../VulkanSDK/1.0.65.0/x86_64/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/1b66276a/w_upload_manager.o ../../../src/wolf.render/w_graphics/w_upload_manager.cpp
+
+${OBJECTDIR}/_ext/1b66276a/w_uniform_ring.o: ../../../src/wolf.render/w_graphics/w_uniform_ring.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/1b66276a
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__VULKAN__ -D__WOLF_RENDER__ -I../../../src/wolf.system -I../../../src/wolf.render -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -I../../../../../../VulkanSDK/1.0.65.0/x86_64/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/1b66276a/w_uniform_ring.o ../../../src/wolf.render/w_graphics/w_uniform_ring.cpp
+
+${OBJECTDIR}/_ext/1b66276a/w_video_texture.o: ../../../src/wolf.render/w_graphics/w_video_texture.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/1b66276a
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__VULKAN__ -D__WOLF_RENDER__ -I../../../src/wolf.system -I../../../src/wolf.render -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -I../../../../../../VulkanSDK/1.0.65.0/x86_64/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/1b66276a/w_video_texture.o ../../../src/wolf.render/w_graphics/w_video_texture.cpp
+
+${OBJECTDIR}/_ext/1b66276a/w_bindless_texture_table.o: ../../../src/wolf.render/w_graphics/w_bindless_texture_table.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/1b66276a
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__VULKAN__ -D__WOLF_RENDER__ -I../../../src/wolf.system -I../../../src/wolf.render -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -I../../../../../../VulkanSDK/1.0.65.0/x86_64/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/1b66276a/w_bindless_texture_table.o ../../../src/wolf.render/w_graphics/w_bindless_texture_table.cpp
+
+${OBJECTDIR}/_ext/1b66276a/w_texture_streamer.o: ../../../src/wolf.render/w_graphics/w_texture_streamer.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/1b66276a
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__VULKAN__ -D__WOLF_RENDER__ -I../../../src/wolf.system -I../../../src/wolf.render -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -I../../../../../../VulkanSDK/1.0.65.0/x86_64/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/1b66276a/w_texture_streamer.o ../../../src/wolf.render/w_graphics/w_texture_streamer.cpp
+
+${OBJECTDIR}/_ext/1b66276a/w_parallel_command_buffers.o: ../../../src/wolf.render/w_graphics/w_parallel_command_buffers.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/1b66276a
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__VULKAN__ -D__WOLF_RENDER__ -I../../../src/wolf.system -I../../../src/wolf.render -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -I../../../../../../VulkanSDK/1.0.65.0/x86_64/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/1b66276a/w_parallel_command_buffers.o ../../../src/wolf.render/w_graphics/w_parallel_command_buffers.cpp
+
+${OBJECTDIR}/_ext/1b66276a/w_gpu_driven_renderer.o: ../../../src/wolf.render/w_graphics/w_gpu_driven_renderer.cpp nbproject/Makefile-${CND_CONF}.mk
+	${MKDIR} -p ${OBJECTDIR}/_ext/1b66276a
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -DGLM_FORCE_DEPTH_ZERO_TO_ONE -D_DEBUG -D__VULKAN__ -D__WOLF_RENDER__ -I../../../src/wolf.system -I../../../src/wolf.render -I../../../src/wolf.content_pipeline -I../../../dependencies/tbb/oss/linux/include -I../../../dependencies/msgpack/include -I../../../../../../VulkanSDK/1.0.65.0/x86_64/include -std=c++14 -fPIC  -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/_ext/1b66276a/w_gpu_driven_renderer.o ../../../src/wolf.render/w_graphics/w_gpu_driven_renderer.cpp
+
 ${OBJECTDIR}/_ext/1b66276a/w_frame_buffer.o: ../../../src/wolf.render/w_graphics/w_frame_buffer.cpp nbproject/Makefile-${CND_CONF}.mk
 	${MKDIR} -p ${OBJECTDIR}/_ext/1b66276a
 	${RM} "$@.d"
@@ -391,122 +391,19 @@ HRESULT model::_load_shader()
     _param.stage = w_shader_stage::COMPUTE_SHADER;
 
     //load compute uniform then assign it to shader
-    switch (this->cs.batch_local_size)
+    if (this->cs.batch_local_size > MAX_BATCH_LOCAL_SIZE)
     {
-    default:
         V(S_FALSE, "batch_local_size " + std::to_string(this->cs.batch_local_size) + " not supported " + this->_full_name, _trace);
         return S_FALSE;
-    case 1:
-        this->_visibilities.resize(1);
-        this->cs.unifrom_x1 = new w_uniform<compute_unifrom_x1>();
-        if (this->cs.unifrom_x1->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader uniform_x1 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x1->get_descriptor_info();
-        break;
-    case 2:
-        this->_visibilities.resize(2);
-        this->cs.unifrom_x2 = new w_uniform<compute_unifrom_x2>();
-        if (this->cs.unifrom_x2->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader unifrom_x2 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x2->get_descriptor_info();
-        break;
-    case 4:
-        this->_visibilities.resize(4);
-        this->cs.unifrom_x4 = new w_uniform<compute_unifrom_x4>();
-        if (this->cs.unifrom_x4->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader unifrom_x4 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x4->get_descriptor_info();
-        break;
-    case 8:
-        this->_visibilities.resize(8);
-        this->cs.unifrom_x8 = new w_uniform<compute_unifrom_x8>();
-        if (this->cs.unifrom_x8->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader unifrom_x8 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x8->get_descriptor_info();
-        break;
-    case 16:
-        this->_visibilities.resize(16);
-        this->cs.unifrom_x16 = new w_uniform<compute_unifrom_x16>();
-        if (this->cs.unifrom_x16->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader unifrom_x16 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x16->get_descriptor_info();
-        break;
-    case 32:
-        this->_visibilities.resize(32);
-        this->cs.unifrom_x32 = new w_uniform<compute_unifrom_x32>();
-        if (this->cs.unifrom_x32->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader unifrom_x32 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x32->get_descriptor_info();
-        break;
-    case 64:
-        this->_visibilities.resize(64);
-        this->cs.unifrom_x64 = new w_uniform<compute_unifrom_x64>();
-        if (this->cs.unifrom_x64->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader unifrom_x64 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x64->get_descriptor_info();
-        break;
-    case 128:
-        this->_visibilities.resize(128);
-        this->cs.unifrom_x128 = new w_uniform<compute_unifrom_x128>();
-        if (this->cs.unifrom_x128->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader uniform_x128 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x128->get_descriptor_info();
-        break;
-    case 256:
-        this->_visibilities.resize(256);
-        this->cs.unifrom_x256 = new w_uniform<compute_unifrom_x256>();
-        if (this->cs.unifrom_x256->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader uniform_x256 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x256->get_descriptor_info();
-        break;
-    case 512:
-        this->_visibilities.resize(512);
-        this->cs.unifrom_x512 = new w_uniform<compute_unifrom_x512>();
-        if (this->cs.unifrom_x512->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader uniform_x512 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x512->get_descriptor_info();
-        break;
-    case 1024:
-        this->_visibilities.resize(1024);
-        this->cs.unifrom_x1024 = new w_uniform<compute_unifrom_x1024>();
-        if (this->cs.unifrom_x1024->load(this->_gDevice) == S_FALSE)
-        {
-            V(S_FALSE, "loading compute shader uniform_x512 for " + this->_full_name, _trace);
-            return S_FALSE;
-        }
-        _param.buffer_info = this->cs.unifrom_x1024->get_descriptor_info();
-        break;
     }
+    this->_visibilities.resize(this->cs.batch_local_size);
+    this->cs.unifrom = new w_uniform<compute_unifrom>();
+    if (this->cs.unifrom->load(this->_gDevice) == S_FALSE)
+    {
+        V(S_FALSE, "loading compute shader uniform for " + this->_full_name, _trace);
+        return S_FALSE;
+    }
+    _param.buffer_info = this->cs.unifrom->get_descriptor_info();
     _shader_params.push_back(_param);
 
     _param.index = 3;
@@ -521,10 +418,8 @@ HRESULT model::_load_shader()
     _param.buffer_info = this->cs.lod_levels_buffers.get_descriptor_info();
     _shader_params.push_back(_param);
 
-    //check path of shader
-    auto _lod_level = this->_lod_levels.size() ? this->_lod_levels.size() - 1 : 0;
-    auto _shader_name = "cull_lod_" + std::to_string(_lod_level) + "_local_size_x" + std::to_string(cs.batch_local_size) + ".comp.spv";
-    auto _compute_shader_path = content_path + L"shaders/compute/" + wolf::system::convert::string_to_wstring(_shader_name);
+    //local size and max lod level of cull_lod.comp are specialization constants of compute pipeline variant
+    auto _compute_shader_path = content_path + L"shaders/compute/cull_lod.comp.spv";
     if (wolf::system::io::get_is_file(_compute_shader_path.c_str()) == S_FALSE)
     {
         V(S_FALSE, L"compute shader not exists on path " + _compute_shader_path, _trace);
@@ -534,7 +429,7 @@ HRESULT model::_load_shader()
     //load shaders
     if (w_shader::load_shader(
         this->_gDevice,
-        _shader_name,
+        "model_cull_lod",
         content_path + L"shaders/compute/indirect_draw.vert.spv",
         L"",
         L"",
@@ -626,7 +521,7 @@ HRESULT model::_load_buffers()
     if (this->indirect.indirect_draw_count_buffer.load(
         this->_gDevice,
         _size,
-        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == S_FALSE)
     {
         V(S_FALSE, "loading device buffer of indirect_draw_count", _trace, 3);
@@ -826,15 +721,27 @@ HRESULT model::_load_pipelines(_In_ w_render_pass& pRenderPass)
     //    V(S_FALSE, "creating vertex pipeline for " + this->_full_name, _trace);
     //    return S_FALSE;
     //}
-    auto _compute_descriptor_set_layout_binding = this->_shader->get_compute_descriptor_set_layout();
-    auto _compute_shader_stage = this->_shader->get_compute_shader_stage();
+    //use wavefront size of device as local size, batch is split into workgroups of local size
+    this->cs.local_size = std::min(w_pipeline::get_preferred_compute_local_size(this->_gDevice), this->cs.batch_local_size);
+    while (this->cs.batch_local_size % this->cs.local_size)
+    {
+        this->cs.local_size /= 2;
+    }
 
-    if (this->cs.pipeline.load_compute(
+    //stats will be cleared by compute command buffer, because more than one workgroup may write them
+    w_specialization_info _specialization_info;
+    _specialization_info.add(0, this->cs.local_size);
+    _specialization_info.add(1, static_cast<uint32_t>(std::min<size_t>(
+        this->_lod_levels.size() ? this->_lod_levels.size() - 1 : 0,
+        MAX_LOD_LEVEL)));
+    _specialization_info.add(2, static_cast<VkBool32>(VK_FALSE));
+
+    this->cs.pipeline = w_pipeline::get_compute_pipeline_variant(
         this->_gDevice,
-        _compute_shader_stage,
-        _compute_descriptor_set_layout_binding,
-        6,
-        "model_pipeline_cache") == S_FALSE)
+        this->_shader,
+        _specialization_info,
+        "model_pipeline_cache");
+    if (!this->cs.pipeline)
     {
         V(S_FALSE, "loading compute pipeline for " + this->_full_name, _trace);
         return S_FALSE;
@@ -888,9 +795,31 @@ HRESULT model::_build_compute_command_buffers()
         1, &_buffer_barrier,
         0, nullptr);
 
-    auto _pipline_layout_handle = this->cs.pipeline.get_layout_handle();
+    //clear stats before all workgroups of dispatch
+    auto _count_handle = this->indirect.indirect_draw_count_buffer.get_handle();
+    vkCmdFillBuffer(_cmd, _count_handle, 0, VK_WHOLE_SIZE, 0);
+
+    VkBufferMemoryBarrier _count_barrier = {};
+    _count_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    _count_barrier.buffer = _count_handle;
+    _count_barrier.size = VK_WHOLE_SIZE;
+    _count_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    _count_barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+    _count_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    _count_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+
+    vkCmdPipelineBarrier(
+        _cmd,
+        VK_PIPELINE_STAGE_TRANSFER_BIT,
+        VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+        0,
+        0, nullptr,
+        1, &_count_barrier,
+        0, nullptr);
+
+    auto _pipline_layout_handle = this->cs.pipeline->get_layout_handle();
     auto _desciptor_set = this->_shader->get_compute_descriptor_set();
-    vkCmdBindPipeline(_cmd, VK_PIPELINE_BIND_POINT_COMPUTE, this->cs.pipeline.get_handle());
+    vkCmdBindPipeline(_cmd, VK_PIPELINE_BIND_POINT_COMPUTE, this->cs.pipeline->get_handle());
     vkCmdBindDescriptorSets(
         _cmd,
         VK_PIPELINE_BIND_POINT_COMPUTE,
@@ -900,7 +829,7 @@ HRESULT model::_build_compute_command_buffers()
         0,
         0);
 
-    vkCmdDispatch(_cmd, (uint32_t)(this->indirect.indirect_draw_commands.size() / cs.batch_local_size), 1, 1);
+    vkCmdDispatch(_cmd, (uint32_t)(this->indirect.indirect_draw_commands.size() / cs.local_size), 1, 1);
 
     // Add memory barrier to ensure that the compute shader has finished writing the indirect command buffer before it's consumed
     _buffer_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
@@ -1141,75 +1070,10 @@ HRESULT model::submit_compute_shader(_In_ const wolf::framework::w_first_person_
         V(_hr, "updating fragment shader unifrom", _trace, 3);
     }
 
-    switch (this->cs.batch_local_size)
-    {
-    case 1:
-        this->cs.unifrom_x1->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x1->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x1->data.is_visible));
-        _hr = this->cs.unifrom_x1->update();
-        break;
-    case 2:
-        this->cs.unifrom_x2->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x2->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x2->data.is_visible));
-        _hr = this->cs.unifrom_x2->update();
-        break;
-    case 4:
-        this->cs.unifrom_x4->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x4->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x4->data.is_visible));
-        _hr = this->cs.unifrom_x4->update();
-        break;
-    case 8:
-        this->cs.unifrom_x8->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x8->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x8->data.is_visible));
-        _hr = this->cs.unifrom_x8->update();
-        break;
-    case 16:
-        this->cs.unifrom_x16->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x16->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x16->data.is_visible));
-        _hr = this->cs.unifrom_x16->update();
-        break;
-    case 32:
-        this->cs.unifrom_x32->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x32->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x32->data.is_visible));
-        _hr = this->cs.unifrom_x32->update();
-        break;
-    case 64:
-        this->cs.unifrom_x64->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x64->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x64->data.is_visible));
-        _hr = this->cs.unifrom_x64->update();
-        break;
-    case 128:
-        this->cs.unifrom_x128->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x128->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x128->data.is_visible));
-        _hr = this->cs.unifrom_x128->update();
-        break;
-    case 256:
-        this->cs.unifrom_x256->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x256->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x256->data.is_visible));
-        _hr = this->cs.unifrom_x256->update();
-        break;
-    case 512:
-        this->cs.unifrom_x512->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x512->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x512->data.is_visible));
-        _hr = this->cs.unifrom_x512->update();
-        break;
-    case 1024:
-        this->cs.unifrom_x1024->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
-        std::memcpy(&this->cs.unifrom_x1024->data.is_visible[0],
-            this->_visibilities.data(), sizeof(this->cs.unifrom_x1024->data.is_visible));
-        _hr = this->cs.unifrom_x1024->update();
-        break;
-    }
+    this->cs.unifrom->data.camera_pos = glm::vec4(_camera_pos, 1.0f);
+    std::memcpy(&this->cs.unifrom->data.is_visible[0],
+        this->_visibilities.data(), this->_visibilities.size() * sizeof(float));
+    _hr = this->cs.unifrom->update();
 
     if (_hr == S_FALSE)
     {
@@ -1247,6 +1111,8 @@ ULONG model::release()
     }
 
     this->cs.release();
+    //compute pipeline variants will be released with shader
+    SAFE_RELEASE(this->_shader);
     this->vs.release();
     this->fs.release();
     this->indirect.release();
@@ -21,6 +21,8 @@
 #include "masked_occlusion_culling/CullingThreadpool.h"
 
 #define MAX_LOD_LEVEL 2
+//maximum local size of compute shader, each vec4 contains visibility of 4 instances
+#define MAX_BATCH_LOCAL_SIZE 1024
 
 struct clipspace_vertex { float x, y, z, w; };
 
@@ -158,98 +160,14 @@ private:
     };
 #pragma pack(pop)
 
-#pragma region compute uniforms
-
 #pragma pack(push,1)
-    struct compute_unifrom_x1
+    struct compute_unifrom
     {
         glm::vec4           camera_pos;
-        glm::vec4	        is_visible;
+        glm::vec4	        is_visible[MAX_BATCH_LOCAL_SIZE / 4];
     };
 #pragma pack(pop)
 
-#pragma pack(push,1)
-    struct compute_unifrom_x2
-    {
-        glm::vec4           camera_pos;
-        glm::vec4	        is_visible;
-    };
-#pragma pack(pop)
-
-#pragma pack(push,1)
-    struct compute_unifrom_x4
-    {
-        glm::vec4           camera_pos;
-        glm::vec4	        is_visible;
-    };
-#pragma pack(pop)
-
-#pragma pack(push,1)
-    struct compute_unifrom_x8
-    {
-        glm::vec4           camera_pos;
-        glm::vec4	        is_visible[2];
-    };
-#pragma pack(pop)
-
-#pragma pack(push,1)
-    struct compute_unifrom_x16
-    {
-        glm::vec4           camera_pos;
-        glm::vec4	        is_visible[4];
-    };
-#pragma pack(pop)
-
-#pragma pack(push,1)
-    struct compute_unifrom_x32
-    {
-        glm::vec4           camera_pos;
-        glm::vec4	        is_visible[8];
-    };
-#pragma pack(pop)
-
-#pragma pack(push,1)
-    struct compute_unifrom_x64
-    {
-        glm::vec4           camera_pos;
-        glm::vec4	        is_visible[16];
-    };
-#pragma pack(pop)
-
-#pragma pack(push,1)
-    struct compute_unifrom_x128
-    {
-        glm::vec4           camera_pos;
-        glm::vec4	        is_visible[32];
-    };
-#pragma pack(pop)
-
-#pragma pack(push,1)
-    struct compute_unifrom_x256
-    {
-        glm::vec4           camera_pos;
-        glm::vec4	        is_visible[64];
-    };
-#pragma pack(pop)
-
-#pragma pack(push,1)
-    struct compute_unifrom_x512
-    {
-        glm::vec4           camera_pos;
-        glm::vec4	        is_visible[128];
-    };
-#pragma pack(pop)
-
-#pragma pack(push,1)
-    struct compute_unifrom_x1024
-    {
-        glm::vec4           camera_pos;
-        glm::vec4	        is_visible[256];
-    };
-#pragma pack(pop)
-
-#pragma endregion
-
 #pragma pack(push,1)
     struct color_unifrom
     {
@@ -287,44 +205,27 @@ private:
     struct compute_stage
     {
         uint32_t                                                batch_local_size = 1;
+        //local size of compute pipeline variant, batch_local_size is multiple of it
+        uint32_t                                                local_size = 1;
         
-        wolf::graphics::w_uniform<compute_unifrom_x1>*          unifrom_x1;
-        wolf::graphics::w_uniform<compute_unifrom_x2>*          unifrom_x2;
-        wolf::graphics::w_uniform<compute_unifrom_x4>*          unifrom_x4;
-        wolf::graphics::w_uniform<compute_unifrom_x8>*          unifrom_x8;
-        wolf::graphics::w_uniform<compute_unifrom_x16>*         unifrom_x16;
-        wolf::graphics::w_uniform<compute_unifrom_x32>*         unifrom_x32;
-        wolf::graphics::w_uniform<compute_unifrom_x64>*         unifrom_x64;
-        wolf::graphics::w_uniform<compute_unifrom_x128>*        unifrom_x128;
-        wolf::graphics::w_uniform<compute_unifrom_x256>*        unifrom_x256;
-        wolf::graphics::w_uniform<compute_unifrom_x512>*        unifrom_x512;
-        wolf::graphics::w_uniform<compute_unifrom_x1024>*       unifrom_x1024;
+        wolf::graphics::w_uniform<compute_unifrom>*             unifrom = nullptr;
 
         wolf::graphics::w_buffer                                instance_buffer;
 
         wolf::graphics::w_buffer                                lod_levels_buffers;
         
-        wolf::graphics::w_pipeline                              pipeline;
+        //owned by compute pipeline variants of shader
+        wolf::graphics::w_pipeline*                             pipeline = nullptr;
         wolf::graphics::w_command_buffer                        command_buffers;
         VkSemaphore                                             semaphore = 0;
 
         void release()
         {
-            SAFE_RELEASE(this->unifrom_x1);
-            SAFE_RELEASE(this->unifrom_x2);
-            SAFE_RELEASE(this->unifrom_x4);
-            SAFE_RELEASE(this->unifrom_x8);
-            SAFE_RELEASE(this->unifrom_x16);
-            SAFE_RELEASE(this->unifrom_x32);
-            SAFE_RELEASE(this->unifrom_x64);
-            SAFE_RELEASE(this->unifrom_x128);
-            SAFE_RELEASE(this->unifrom_x256);
-            SAFE_RELEASE(this->unifrom_x512);
-            SAFE_RELEASE(this->unifrom_x1024);
+            SAFE_RELEASE(this->unifrom);
 
             this->instance_buffer.release();
             this->lod_levels_buffers.release();
-            this->pipeline.release();
+            this->pipeline = nullptr;
             this->command_buffers.release();
         }
 
@@ -136,7 +136,7 @@ namespace wolf
 				std::string name;
 				std::vector<c_source*> sources;
 				std::vector<c_triangles*> triangles;
-				c_vertices* vertices;
+				c_vertices* vertices = nullptr;
 
 				ULONG release()
 				{
@@ -2,6 +2,7 @@
 #include "c_parser.h"
 #include "w_cpipeline_model.h"
 #include "c_skin.h"
+#include <w_job_system.h>
 
 using namespace std;
 using namespace wolf::system;
@@ -18,10 +19,15 @@ W_RESULT c_parser::parse_collada_from_file(
 	_In_ const bool& pSimplygonOptimizing,
 #endif
     _In_ const bool& pInvertNormals,
-    _In_ const bool& pFindLODs)
+    _In_ const bool& pFindLODs,
+    _In_ const w_vertex_welding_configs& pVertexWeldingConfigs,
+    _In_ const w_mesh_optimizer_configs& pMeshOptimizerConfigs)
 {
 	auto _hr = W_PASSED;
 
+	sVertexWeldingConfigs = pVertexWeldingConfigs;
+	sMeshOptimizerConfigs = pMeshOptimizerConfigs;
+
 #if defined(__WIN32) || defined(__UWP)
     auto _path = pFilePath;
 #else
@@ -146,24 +152,35 @@ W_RESULT c_parser::_process_xml_node(_In_ rapidxml::xml_node<>* pXNode)
 	else if (_node_name == "library_effects")
 	{
         sSkipChildrenOfThisNode = _node_name;
-        _get_library_effects(pXNode);
+        //will be read while building models
+        sLibraryNodes.push_back(pXNode);
         return W_PASSED;
 	}
 	else if (_node_name == "library_materials")
 	{
         sSkipChildrenOfThisNode = _node_name;
-        _get_library_materials(pXNode);
+        //will be read while building models
+        sLibraryNodes.push_back(pXNode);
         return W_PASSED;
 	}
     else if (_node_name == "library_images")
     {
         sSkipChildrenOfThisNode = _node_name;
-        _get_library_images(pXNode);
+        //will be read while building models
+        sLibraryNodes.push_back(pXNode);
         return W_PASSED;
     }
 	else if (_node_name == "library_geometries")
 	{
 		SGeometryLibraryNode = pXNode;
+
+		//store geometries by id, the first geometry will be used for duplicated ids
+		for (auto _child = pXNode->first_node(); _child != nullptr; _child = _child->next_sibling())
+		{
+			std::string _id;
+			_get_node_attribute_value(_child, "id", _id);
+			sGeometryNodes.emplace(_id, _child);
+		}
 	}
 	else if (_node_name == "library_visual_scenes")
 	{
@@ -570,6 +587,26 @@ void c_parser::_get_library_images(_In_ rapidxml::xml_node<>* pXNode)
     }
 }
 
+void c_parser::_get_libraries()
+{
+    for (auto _node : sLibraryNodes)
+    {
+        auto _node_name = _get_node_name(_node);
+        if (_node_name == "library_effects")
+        {
+            _get_library_effects(_node);
+        }
+        else if (_node_name == "library_materials")
+        {
+            _get_library_materials(_node);
+        }
+        else if (_node_name == "library_images")
+        {
+            _get_library_images(_node);
+        }
+    }
+}
+
 void c_parser::_read_visual_scene_nodes(_In_ rapidxml::xml_node<>* pXNode, _Inout_ std::vector<c_node*>& pNodes)
 {
 #ifdef DEBUG
@@ -1048,7 +1085,8 @@ void c_parser::_get_bones(_In_ rapidxml::xml_node<>* pXNode, _Inout_ c_bone* pBo
 
 void c_parser::_get_sources(_In_ rapidxml::xml_node<>* pXNode, std::string pID, std::string pName, _Inout_ c_geometry& pGeometry)
 {
-	string _float_array_str = "";
+	rapidxml::xml_node<>* _float_array = nullptr;
+	size_t _float_array_count = 0;
 
 	for (auto _child = pXNode->first_node(); _child != nullptr; _child = _child->next_sibling())
 	{
@@ -1060,7 +1098,13 @@ void c_parser::_get_sources(_In_ rapidxml::xml_node<>* pXNode, std::string pID,
 
 		if (_node_name == "float_array")
 		{
-			_float_array_str = _child->value();
+			//parse numbers in place, count attribute is used for reserving memory
+			_float_array = _child;
+
+			std::string _count_str;
+			_get_node_attribute_value(_child, "count", _count_str);
+			auto _count_val = std::atoi(_count_str.c_str());
+			_float_array_count = _count_val > 0 ? static_cast<size_t>(_count_val) : 0;
 		}
 		else if (_node_name == "technique_common")
 		{
@@ -1081,7 +1125,14 @@ void c_parser::_get_sources(_In_ rapidxml::xml_node<>* pXNode, std::string pID,
 			_source->c_name = pName;
 			_source->stride = _stride;
             
-			wolf::system::convert::find_all_numbers_then_convert_to<float>(_float_array_str, _source->float_array);
+			if (_float_array)
+			{
+				wolf::system::convert::parse_all_numbers_then_convert_to<float>(
+					_float_array->value(),
+					_float_array->value_size(),
+					_source->float_array,
+					_float_array_count);
+			}
 			pGeometry.sources.push_back(_source);
 		}
 	}
@@ -1118,6 +1169,11 @@ void c_parser::_get_triangles(_In_ rapidxml::xml_node<>* pXNode, _In_ c_node* pN
 {
 	std::string _material_name;
 	_get_node_attribute_value(pXNode, "material", _material_name);
+
+	std::string _count_str;
+	_get_node_attribute_value(pXNode, "count", _count_str);
+	auto _triangles_count = std::atoi(_count_str.c_str());
+	auto _max_offset = -1;
     
     auto _triangles = new c_triangles();
 
@@ -1152,6 +1208,7 @@ void c_parser::_get_triangles(_In_ rapidxml::xml_node<>* pXNode, _In_ c_node* pN
 			{
 				if (_source_str[0] == '#') _source_str = _source_str.erase(0, 1);
 				int _offset_val = atoi(_offset_str.c_str());
+				_max_offset = std::max(_max_offset, _offset_val);
 
 				if (pGeometry.vertices->id != _source_str)
 				{
@@ -1187,8 +1244,17 @@ void c_parser::_get_triangles(_In_ rapidxml::xml_node<>* pXNode, _In_ c_node* pN
 		}
 		else if (_node_name == "p")
 		{
-            //wolf::system::convert::find_all_numbers_then_convert_to<float>(_float_array_str, _source->float_array);
-			wolf::system::convert::find_all_numbers_then_convert_to<uint32_t>(_child->value(), _triangles->indices);
+			//each vertex of triangle has one index per offset
+			size_t _expected_count = 0;
+			if (_triangles_count > 0 && _max_offset >= 0)
+			{
+				_expected_count = static_cast<size_t>(_triangles_count) * 3 * static_cast<size_t>(_max_offset + 1);
+			}
+			wolf::system::convert::parse_all_numbers_then_convert_to<uint32_t>(
+				_child->value(),
+				_child->value_size(),
+				_triangles->indices,
+				_expected_count);
 		}
 	}
 
@@ -1207,30 +1273,103 @@ W_RESULT c_parser::_create_scene(
     std::vector<c_node*> _mesh_with_unknown_instance_ref;
     std::vector<w_cpipeline_model*> _models;
 
+    //find models and their instances in order of nodes
+    std::vector<c_model_job> _jobs;
+    std::unordered_map<std::string, size_t> _jobs_of_geometries;
     _iterate_over_nodes(
-        pAMDTootleOptimizing,
-#ifdef __WIN32
-		pSimplygonOptimizing,
-#endif
-        pInvertNormals,
         sNodes,
-        _models,
+        _jobs,
+        _jobs_of_geometries,
         _mesh_with_unknown_instance_ref);
+
+    //the first model owns the bones, same as building models one by one
+    auto _build_models = [&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+    {
+        for (auto i = pBegin; i < pEnd; ++i)
+        {
+            std::vector<c_bone*> _bones;
+            _create_model(
+                pAMDTootleOptimizing,
+#ifdef __WIN32
+                pSimplygonOptimizing,
+#endif
+                pInvertNormals,
+                i == 0 ? sBones : _bones,
+                _jobs[i]);
+        }
+    };
+
+    if (sNumberOfThreads == 1 || _jobs.size() < 2)
+    {
+        _get_libraries();
+        for (auto& _job : _jobs)
+        {
+            _read_geometry(_job);
+        }
+        _build_models(0, _jobs.size());
+    }
+    else
+    {
+        w_job_system _job_system;
+        _job_system.allocate(sNumberOfThreads);
+
+        //read effects, materials and images while reading geometries
+        w_job_counter _libraries_counter;
+        _job_system.submit([this]()
+        {
+            _get_libraries();
+        }, &_libraries_counter);
+
+        _job_system.parallel_for(_jobs.size(), 1, [this, &_jobs](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+        {
+            for (auto i = pBegin; i < pEnd; ++i)
+            {
+                _read_geometry(_jobs[i]);
+            }
+        });
+
+        //materials are required for building models
+        _job_system.wait(_libraries_counter);
+        _job_system.parallel_for(_jobs.size(), 1, _build_models);
+        _job_system.release();
+    }
+
+    //add models and their instances in order of nodes
+    for (auto& _job : _jobs)
+    {
+        if (!_job.model) continue;
+        for (auto& _instance : _job.instances)
+        {
+            _job.model->add_instance(_instance);
+        }
+        _models.push_back(_job.model);
+    }
+    _jobs.clear();
+    _jobs_of_geometries.clear();
     
     //if we have nodes without unknown instance ref
     if (_mesh_with_unknown_instance_ref.size())
     {
         for (auto pNode : _mesh_with_unknown_instance_ref)
         {
-            w_cpipeline_model* _model = nullptr;
+            auto _iter = sGeometryNodes.find(pNode->instanced_geometry_name);
+            if (_iter == sGeometryNodes.end()) continue;
+
+            c_model_job _job;
+            _job.node = pNode;
+            _job.geometry_node = _iter->second;
+
+            _read_geometry(_job);
             _create_model(
                 pAMDTootleOptimizing,
 #ifdef __WIN32
 				pSimplygonOptimizing,
 #endif
                 pInvertNormals,
-                &pNode,
-                &_model);
+                sBones,
+                _job);
+
+            auto _model = _job.model;
             if (_model)
             {
                 //check scale
@@ -1552,13 +1691,9 @@ W_RESULT c_parser::_create_scene(
 }
 
 void c_parser::_iterate_over_nodes(
-    _In_ const bool& pAMDTootleOptimizing,
-#ifdef __WIN32
-	_In_ const bool& pSimplygonOptimizing,
-#endif
-    _In_ const bool& pInvertNormals, 
     _Inout_ std::vector<c_node*> pNodes, 
-    _Inout_ std::vector<w_cpipeline_model*>& pModels,
+    _Inout_ std::vector<c_model_job>& pJobs,
+    _Inout_ std::unordered_map<std::string, size_t>& pJobsOfGeometries,
     _Inout_ std::vector<c_node*>& pMeshWithUnknownInstanceRef)
 {
     for (auto _node : pNodes)
@@ -1589,12 +1724,8 @@ void c_parser::_iterate_over_nodes(
         else if (_type == c_node_type::MESH)
         {
             //find instance if avaiable in models
-            auto _iter = std::find_if(pModels.begin(), pModels.end(), [_node](_In_ w_cpipeline_model* pModel)
-            {
-                return pModel->get_instance_geometry_name() == _node->instanced_geometry_name;
-            });
-
-            if (_iter != pModels.end())
+            auto _iter = pJobsOfGeometries.find(_node->instanced_geometry_name);
+            if (_iter != pJobsOfGeometries.end())
             {
                 //we find source model
                 w_instance_info _instance_info;
@@ -1635,24 +1766,22 @@ void c_parser::_iterate_over_nodes(
                     _instance_info.scale = glm::length(_node->scale);
                 }
 
-                (*_iter)->add_instance(_instance_info);
+                pJobs[_iter->second].instances.push_back(_instance_info);
                 _node->proceeded = true;
             }
             else
             {
-                w_cpipeline_model* _model = nullptr;
-                _create_model(
-                    pAMDTootleOptimizing,
-#ifdef __WIN32
-					pSimplygonOptimizing,
-#endif
-                    pInvertNormals,
-                    &_node,
-                    &_model);
-                //if node procceded and model created
-                if (_model)
+                //model will be created from geometry after iterating over all nodes
+                auto _geometry = sGeometryNodes.find(_node->instanced_geometry_name);
+                if (_geometry != sGeometryNodes.end())
                 {
-                    pModels.push_back(_model);
+                    c_model_job _job;
+                    _job.node = _node;
+                    _job.geometry_node = _geometry->second;
+                    _node->proceeded = true;
+
+                    pJobsOfGeometries[_node->instanced_geometry_name] = pJobs.size();
+                    pJobs.push_back(_job);
                 }
                 else
                 {
@@ -1670,13 +1799,9 @@ void c_parser::_iterate_over_nodes(
                         }
                     }
                     _iterate_over_nodes(
-                        pAMDTootleOptimizing,
-#ifdef __WIN32
-						pSimplygonOptimizing,
-#endif
-                        pInvertNormals,
                         _node->child_nodes,
-                        pModels,
+                        pJobs,
+                        pJobsOfGeometries,
                         pMeshWithUnknownInstanceRef);
                 }
             }
@@ -1684,77 +1809,72 @@ void c_parser::_iterate_over_nodes(
     }
 }
 
-void c_parser::_create_model(
-    _In_ const bool& pAMDTootleOptimizing,
-#ifdef __WIN32
-	_In_ const bool& pSimplygonOptimizing,
-#endif
-    _In_ const bool& pInvertNormals,
-    _Inout_ c_node** pNode,
-    _Inout_ w_cpipeline_model** pModel)
+void c_parser::_read_geometry(_Inout_ c_model_job& pJob)
 {
     //Loading geometries
-    c_geometry _g;
-    bool _found_geometry = false;
-    auto _node_ptr = *pNode;
-    for (auto _child = SGeometryLibraryNode->first_node();
-        _child != nullptr;
-        _child = _child->next_sibling())
-    {
-        string _id;
-        _get_node_attribute_value(_child, "id", _id);
-        if (_node_ptr->instanced_geometry_name == _id)
-        {
-            _found_geometry = true;
-            _node_ptr->proceeded = true;
-            _get_node_attribute_value(_child, "id", _g.id);
-            _get_node_attribute_value(_child, "name", _g.name);
+    auto& _g = pJob.geometry;
+    auto _child = pJob.geometry_node;
+    if (!_child) return;
 
-            for (auto __child = _child->first_node(); __child != nullptr; __child = __child->next_sibling())
-            {
-                auto _node_name = _get_node_name(__child);
+    _get_node_attribute_value(_child, "id", _g.id);
+    _get_node_attribute_value(_child, "name", _g.name);
+
+    for (auto __child = _child->first_node(); __child != nullptr; __child = __child->next_sibling())
+    {
+        auto _node_name = _get_node_name(__child);
 #ifdef DEBUG
-                //logger.write(_node_name);
+        //logger.write(_node_name);
 #endif
 
-                if (_node_name == "mesh")
-                {
+        if (_node_name == "mesh")
+        {
 #pragma region read mesh data
 
-                    for (auto ___child = __child->first_node(); ___child != nullptr; ___child = ___child->next_sibling())
-                    {
-                        std::string _name = ___child->name();
+            for (auto ___child = __child->first_node(); ___child != nullptr; ___child = ___child->next_sibling())
+            {
+                std::string _name = ___child->name();
 
-                        std::string __id, __name;
-                        _get_node_attribute_value(___child, "id", __id);
-                        _get_node_attribute_value(___child, "name", __name);
+                std::string __id, __name;
+                _get_node_attribute_value(___child, "id", __id);
+                _get_node_attribute_value(___child, "name", __name);
 
 #ifdef DEBUG
-                        //logger.write(_name);
+                //logger.write(_name);
 #endif
 
-                        if (_name == "source")
-                        {
-                            _get_sources(___child, __id, __name, _g);
-                        }
-                        else if (_name == "vertices")
-                        {
-                            _g.vertices = new c_vertices();
-                            _get_node_attribute_value(___child, "id", _g.vertices->id);
+                if (_name == "source")
+                {
+                    _get_sources(___child, __id, __name, _g);
+                }
+                else if (_name == "vertices")
+                {
+                    _g.vertices = new c_vertices();
+                    _get_node_attribute_value(___child, "id", _g.vertices->id);
 
-                            _get_vertices(___child, _g);
-                        }
-                        else if (_name == "triangles")
-                        {
-                            _get_triangles(___child, *pNode, _g);
-                        }
-                    }
-#pragma endregion
+                    _get_vertices(___child, _g);
+                }
+                else if (_name == "triangles")
+                {
+                    _get_triangles(___child, pJob.node, _g);
                 }
             }
-            break;
+#pragma endregion
         }
     }
+}
+
+void c_parser::_create_model(
+    _In_ const bool& pAMDTootleOptimizing,
+#ifdef __WIN32
+	_In_ const bool& pSimplygonOptimizing,
+#endif
+    _In_ const bool& pInvertNormals,
+    _Inout_ std::vector<c_bone*>& pBones,
+    _Inout_ c_model_job& pJob)
+{
+    auto _node_ptr = pJob.node;
+    auto& _g = pJob.geometry;
+    auto _found_geometry = pJob.geometry_node != nullptr;
 
     if (_found_geometry)
     {
@@ -1815,7 +1935,7 @@ void c_parser::_create_model(
         auto _model = w_cpipeline_model::create_model(
             _g,
             skin,
-            sBones,
+            pBones,
             sSkeletonNames.data(),
             sLibraryMaterials,
             sLibraryEffects,
@@ -1826,7 +1946,9 @@ void c_parser::_create_model(
 			pSimplygonOptimizing,
 #endif
             sZ_Up,
-            pInvertNormals);
+            pInvertNormals,
+            sVertexWeldingConfigs,
+            sMeshOptimizerConfigs);
 
         _model->set_name(_node_ptr->c_name);
         _model->set_instance_geometry_name(_node_ptr->instanced_geometry_name);
@@ -1839,8 +1961,11 @@ void c_parser::_create_model(
         ////_model.AnimationContainers.Add("Animation 1", animContainer);
         ////_model.SetAnimation("Animation 1");
 
-        *pModel = _model;
+        pJob.model = _model;
     }
+
+    //vertices and indices have been copied to model
+    _g.release();
 }
 
 void c_parser::_clear_all_resources()
@@ -1854,6 +1979,8 @@ void c_parser::_clear_all_resources()
     sLibraryEffects.clear();
     sLibraryMaterials.clear();
     sLibraryImages.clear();
+    sLibraryNodes.clear();
+    sGeometryNodes.clear();
 
 	if (sBones.size() > 0)
 	{
@@ -13,10 +13,12 @@
 #include <w_xml.h>
 #include "w_cpipeline_scene.h"
 #include "w_cpipeline_export.h"
+#include "w_mesh_optimizer.h"
 #include "c_node.h"
 #include "c_bone.h"
 #include "c_extra.h"
 #include "c_animation.h"
+#include <unordered_map>
 
 namespace wolf
 {
@@ -24,10 +26,20 @@ namespace wolf
 	{
 		namespace collada
 		{
+			//a model which will be created from a geometry of library, nodes which refer to the same geometry will be instances of it
+			struct c_model_job
+			{
+				c_node*										node = nullptr;
+				rapidxml::xml_node<>*						geometry_node = nullptr;
+				c_geometry									geometry;
+				std::vector<w_instance_info>				instances;
+				w_cpipeline_model*							model = nullptr;
+			};
+
 			class c_parser
 			{
 			public:
-                c_parser() : sZ_Up(true) {}
+                c_parser() : sZ_Up(true), sNumberOfThreads(0) {}
 				virtual ~c_parser() {};
 
 				WCP_EXP W_RESULT parse_collada_from_file(
@@ -38,7 +50,14 @@ namespace wolf
 					_In_ const bool& pSimplygonOptimizing = true,
 #endif
                     _In_ const bool& pInvertNormals = false,
-                    _In_ const bool& pFind_LODs_BBs = true);
+                    _In_ const bool& pFind_LODs_BBs = true,
+                    _In_ const w_vertex_welding_configs& pVertexWeldingConfigs = w_vertex_welding_configs(),
+                    _In_ const w_mesh_optimizer_configs& pMeshOptimizerConfigs = w_mesh_optimizer_configs());
+
+#pragma region Setters
+				//number of threads for building models, zero means number of hardware threads and one means building models on calling thread
+				WCP_EXP void set_number_of_threads(_In_ const size_t& pValue)		{ this->sNumberOfThreads = pValue; }
+#pragma endregion
 
 			private:
 				W_RESULT	                                _process_xml_node(_In_ rapidxml::xml_node<>* pXNode);
@@ -46,6 +65,7 @@ namespace wolf
                 void                                        _get_library_effects(_In_ rapidxml::xml_node<>* pXNode);
                 void                                        _get_library_materials(_In_ rapidxml::xml_node<>* pXNode);
                 void                                        _get_library_images(_In_ rapidxml::xml_node<>* pXNode);
+                void                                        _get_libraries();
 				void			                            _read_visual_scene_nodes(_In_ rapidxml::xml_node<>* pXNode, _Inout_ std::vector<c_node*>& pNodes);
                 std::tuple<std::string,std::string>         _get_instance_material_symbol_target_name(_In_ rapidxml::xml_node<>* pXNode);
                 void			                            _get_si_scene_data(_In_ rapidxml::xml_node<>* pXNode, _Inout_ std::vector<c_value_obj*>& pNodes);
@@ -60,23 +80,21 @@ namespace wolf
 				void			                            _get_triangles(_In_ rapidxml::xml_node<>* pXNode, _In_ c_node* pNode, _Inout_ c_geometry& pGeometry);
                 
 				void                                        _iterate_over_nodes(
-                                                                _In_ const bool& pAMDTootleOptimizing,
-#ifdef __WIN32
-																_In_ const bool& pSimplygonOptimizing,
-#endif
-                                                                _In_ const bool& pInvertNormals,
                                                                 _Inout_ std::vector<c_node*> pNodes,
-                                                                _Inout_ std::vector<w_cpipeline_model*>& pModels,
+                                                                _Inout_ std::vector<c_model_job>& pJobs,
+                                                                _Inout_ std::unordered_map<std::string, size_t>& pJobsOfGeometries,
                                                                 _Inout_ std::vector<c_node*>& pNodeWithUnknownInstanceRef);
-                
+
+                void                                        _read_geometry(_Inout_ c_model_job& pJob);
+
                 void                                        _create_model(
                     _In_ const bool& pAMDTootleOptimizing,
 #ifdef __WIN32
 					_In_ const bool& pSimplygonOptimizing,
 #endif
                     _In_ const bool& pInvertNormals,
-                    _Inout_ c_node** pNode,
-                    _Inout_ w_cpipeline_model** pModel);
+                    _Inout_ std::vector<c_bone*>& pBones,
+                    _Inout_ c_model_job& pJob);
                 
 				W_RESULT	                                _create_scene(
                     _Inout_ w_cpipeline_scene* pScene,
@@ -103,7 +121,14 @@ namespace wolf
                 std::string					                sSkipChildrenOfThisNode;
                 c_xsi_extra					                sXSI_Extra;
                 rapidxml::xml_node<>*		                SGeometryLibraryNode;
+                //geometries of library by their ids
+                std::unordered_map<std::string, rapidxml::xml_node<>*> sGeometryNodes;
+                //library nodes of effects, materials and images in order of document, they will be read while building models
+                std::vector<rapidxml::xml_node<>*>          sLibraryNodes;
                 bool                                        sZ_Up;
+                size_t                                      sNumberOfThreads;
+                w_vertex_welding_configs                    sVertexWeldingConfigs;
+                w_mesh_optimizer_configs                    sMeshOptimizerConfigs;
 			};
 		}
 	}
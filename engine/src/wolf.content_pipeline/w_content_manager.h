@@ -13,8 +13,10 @@
 #include "w_cpipeline_export.h"
 #include <string>
 #include <w_io.h>
+#include <w_async_loader.h>
 #include "collada/c_parser.h"
 #include "w_cpipeline_scene.h"
+#include "w_mapped_scene.h"
 #include <msgpack/msgpack.hpp>
 #include "simplygon/simplygon.h"
 
@@ -56,6 +58,12 @@ namespace wolf
                         auto _scene = new w_cpipeline_scene();
                         _scene->set_name(_name);
 
+                        //AMD Tootle is used on windows, other platforms use portable mesh optimizer
+                        w_mesh_optimizer_configs _mesh_optimizer_configs;
+#ifndef __WIN32
+                        _mesh_optimizer_configs.vertex_cache_optimizer = w_vertex_cache_optimizer::TIPSIFY_VERTEX_CACHE_OPTIMIZING;
+#endif
+
                         collada::c_parser _parser;
                         auto _hr = _parser.parse_collada_from_file(pAssetPath,
                                                                    _scene,
@@ -64,7 +72,9 @@ namespace wolf
                                                                    true,
 #endif
                                                                    true,
-                                                                   true);
+                                                                   true,
+                                                                   w_vertex_welding_configs(),
+                                                                   _mesh_optimizer_configs);
 
                         _extension.clear();
                         _name.clear();
@@ -83,8 +93,8 @@ namespace wolf
                         auto _hr = load_wolf_scenes_from_file(_scenes, pAssetPath);
                         if (_hr == W_PASSED && _scenes.size())
                         {
-                            //make a deep copy from first element
-                            auto _scene = new w_cpipeline_scene(_scenes[0]);
+                            //take the first scene, its models and meshes will not be copied
+                            auto _scene = new w_cpipeline_scene(std::move(_scenes[0]));
                             _scenes.clear();
                             return _scene;
                         }
@@ -95,6 +105,42 @@ namespace wolf
                 return nullptr;
             }
 
+            /*
+                load asset on a thread of async loader, pOnLoaded will be called with the loaded asset on the thread which calls
+                w_async_loader::update, the owner of asset is pOnLoaded. If request has been canceled, the loaded asset will be released
+            */
+            template<class T>
+            static std::shared_ptr<wolf::system::w_async_load_request> load_async(
+                _In_ wolf::system::w_async_loader& pAsyncLoader,
+                _In_z_ const std::wstring& pAssetPath,
+                _In_ const int& pPriority,
+                _In_ const std::function<void(const W_RESULT&, T*)>& pOnLoaded)
+            {
+                //release asset if it has not been passed to pOnLoaded
+                std::shared_ptr<T*> _asset(new T*(nullptr), [](_In_ T** pAsset)
+                {
+                    auto _loaded = *pAsset;
+                    SAFE_RELEASE(_loaded);
+                    delete pAsset;
+                });
+
+                return pAsyncLoader.load(
+                    pPriority,
+                    [_asset, pAssetPath]() -> W_RESULT
+                    {
+                        *_asset = load<T>(pAssetPath);
+                        return *_asset ? W_PASSED : W_FAILED;
+                    },
+                    [_asset, pOnLoaded](_In_ const W_RESULT& pResult)
+                    {
+                        if (!pOnLoaded) return;
+
+                        auto _loaded = *_asset;
+                        *_asset = nullptr;
+                        pOnLoaded(pResult, _loaded);
+                    });
+            }
+
             static W_RESULT save_wolf_scenes_to_file(_In_ std::vector<w_cpipeline_scene>& pScenePacks, _In_z_ std::wstring pWolfSceneFilePath)
             {
 #if defined(__WIN32) || defined(__UWP)
@@ -126,9 +172,28 @@ namespace wolf
                 return W_PASSED;
             }
 
+            //save scenes in memory mapped format, vertices, indices and quantized vertices of meshes will be stored as raw blobs
+            static W_RESULT save_mapped_wolf_scenes_to_file(_In_ std::vector<w_cpipeline_scene>& pScenePacks, _In_z_ std::wstring pWolfSceneFilePath)
+            {
+                return w_mapped_scene::save(pScenePacks, pWolfSceneFilePath);
+            }
+
             static W_RESULT load_wolf_scenes_from_file(_In_ std::vector<w_cpipeline_scene>& pScenePacks, _In_z_ std::wstring pWolfSceneFilePath)
                                                       
             {
+                //memory mapped scene files start with their own header, older files are plain msgpack
+                if (w_mapped_scene::is_mapped_scene_file(pWolfSceneFilePath))
+                {
+                    w_mapped_scene _mapped_scene;
+                    auto _hr = _mapped_scene.load(pWolfSceneFilePath);
+                    if (_hr == W_PASSED)
+                    {
+                        _hr = _mapped_scene.move_to(pScenePacks);
+                    }
+                    _mapped_scene.release();
+                    return _hr;
+                }
+
 #if defined(__WIN32) || defined(__UWP)
                 auto _path = pWolfSceneFilePath;
 #else
@@ -3,6 +3,7 @@
 
 #include "amd/amd_tootle.h"
 #include "simplygon/simplygon.h"
+#include "w_mesh_optimizer.h"
 
 #include <mutex>
 #include "wavefront/obj.h"
@@ -14,6 +15,8 @@ using namespace wolf::content_pipeline::collada;
 
 static std::once_flag	do_init_simplygon_once_over_time;
 static std::mutex		simplygon_mutex;
+//amd tootle has global state, models might be created by multiple threads of collada parser
+static std::mutex		amd_tootle_mutex;
 
 w_cpipeline_model::w_cpipeline_model() :
 	_name("unknown"),
@@ -44,7 +47,9 @@ w_cpipeline_model* w_cpipeline_model::create_model(
 	_In_ const bool& pSimplygonOptimizing,
 #endif
     _In_ const bool& pZUp,
-    _In_ const bool& pInvertNormal)
+    _In_ const bool& pInvertNormal,
+    _In_ const w_vertex_welding_configs& pVertexWeldingConfigs,
+    _In_ const w_mesh_optimizer_configs& pMeshOptimizerConfigs)
 {
 	const std::string _trace_info = "w_cpipeline_model::create_model";
 
@@ -171,8 +176,9 @@ w_cpipeline_model* w_cpipeline_model::create_model(
 		std::vector<float> _vertices_positions;
 		std::vector<uint32_t> _indices_data;// (_faces * 3 * 2, -1);
 
-		//read vertices and indices
+		//read vertices and indices, attributes which are not available in collada will be zero
 		w_vertex_struct _vertex;
+		std::memset(&_vertex, 0, sizeof(_vertex));
 		glm::vec3 _min_vertex;
 		glm::vec3 _max_vertex;
 
@@ -258,10 +264,6 @@ w_cpipeline_model* w_cpipeline_model::create_model(
 			std::memset(&_vertex.blend_weight[0], -1, 4 * sizeof(float));
 			std::memset(&_vertex.blend_indices[0], -1, 4 * sizeof(int));
 
-			if (pAMDTootleOptimizing)
-			{
-				_vertices_positions.insert(_vertices_positions.end(), _pos.begin(), _pos.end());
-			}
 			//store vertices and indices
 			auto _index = _vertices_data.size();
 			_vertex.vertex_index = _index + 1;
@@ -276,6 +278,26 @@ w_cpipeline_model* w_cpipeline_model::create_model(
 
 #pragma endregion
 
+#pragma region VERTEX WELDING
+		if (pVertexWeldingConfigs.enable)
+		{
+			auto _vertices_count_before = _vertices_data.size();
+			auto _acmr_before = w_mesh_optimizer::compute_acmr(_indices_data, _vertices_count_before);
+
+			if (w_mesh_optimizer::weld_vertices(_vertices_data, _indices_data, pVertexWeldingConfigs) == W_PASSED)
+			{
+				auto _acmr_after = w_mesh_optimizer::compute_acmr(_indices_data, _vertices_data.size());
+				logger.write("vertex welding of " + pGeometry.name +
+					" vertices: " + std::to_string(_vertices_count_before) + " -> " + std::to_string(_vertices_data.size()) +
+					" ACMR: " + std::to_string(_acmr_before) + " -> " + std::to_string(_acmr_after));
+			}
+			else
+			{
+				V(W_FAILED, "welding vertices of " + pGeometry.name, _trace_info, 3);
+			}
+		}
+#pragma endregion
+
 		//sort vertices
 		//std::sort(_vertices_data.begin(), _vertices_data.end(), [](_In_ const w_vertex_struct& pA, _In_ const w_vertex_struct& pB)
 		//{
@@ -402,9 +424,30 @@ w_cpipeline_model* w_cpipeline_model::create_model(
 
 #pragma endregion
 
-#pragma region AMD TOOTLE OPTIMIZING
-		if (pAMDTootleOptimizing)
+#pragma region MESH OPTIMIZING
+		if (pMeshOptimizerConfigs.vertex_cache_optimizer != w_vertex_cache_optimizer::NO_VERTEX_CACHE_OPTIMIZING)
 		{
+			//portable optimizer has been selected instead of AMD Tootle
+			if (w_mesh_optimizer::optimize(_vertices_data, _indices_data, pMeshOptimizerConfigs) == W_PASSED)
+			{
+				logger.write("optimized " + pGeometry.name +
+					" ACMR: " + std::to_string(w_mesh_optimizer::compute_acmr(_indices_data, _vertices_data.size(), pMeshOptimizerConfigs.cache_size)) +
+					" ATVR: " + std::to_string(w_mesh_optimizer::compute_atvr(_indices_data, _vertices_data.size(), pMeshOptimizerConfigs.cache_size)));
+			}
+			else
+			{
+				V(W_FAILED, "optimizing mesh of " + pGeometry.name, _trace_info, 3);
+			}
+		}
+		else if (pAMDTootleOptimizing)
+		{
+			_vertices_positions.clear();
+			_vertices_positions.reserve(_vertices_data.size() * 3);
+			for (auto& _v : _vertices_data)
+			{
+				_vertices_positions.insert(_vertices_positions.end(), &_v.position[0], &_v.position[0] + 3);
+			}
+			std::lock_guard<std::mutex> _lock(amd_tootle_mutex);
 			amd::tootle::apply(_vertices_data, _vertices_positions, _indices_data);
 		}
 #pragma endregion
@@ -508,6 +551,28 @@ void w_cpipeline_model::update_world()
         glm::vec3(this->_transform.position[0], this->_transform.position[1], this->_transform.position[2]));
 }
 
+W_RESULT w_cpipeline_model::quantize_meshes(_Inout_ w_vertex_quantization_report* pReport)
+{
+    for (auto& _mesh : this->_meshes)
+    {
+        w_vertex_quantization_report _report;
+        if (w_vertex_quantizer::quantize(_mesh.vertices, _mesh.quantized, pReport ? &_report : nullptr) == W_FAILED) return W_FAILED;
+        if (pReport) pReport->merge(_report);
+    }
+
+    for (auto& _lod : this->_lods)
+    {
+        if (_lod.quantize_meshes(pReport) == W_FAILED) return W_FAILED;
+    }
+
+    for (auto& _ch : this->_convex_hulls)
+    {
+        if (_ch.quantize_meshes(pReport) == W_FAILED) return W_FAILED;
+    }
+
+    return W_PASSED;
+}
+
 void w_cpipeline_model::release()
 {
     this->_bone_names.clear();
@@ -20,6 +20,8 @@
 #include "collada/c_skin.h"
 #include "collada/c_animation.h"
 #include "w_vertex_struct.h"
+#include "w_mesh_optimizer.h"
+#include "w_vertex_quantizer.h"
 #include "w_bounding.h"
 #include "python_exporter/w_boost_python_helper.h"
 
@@ -170,11 +172,14 @@ namespace wolf
 			//std::vector<c_effect*>			effects;
 			std::string							textures_path;
 			wolf::system::w_bounding_box		bounding_box;
+			//quantized vertices, they will be filled by w_cpipeline_model::quantize_meshes and stored only in mapped scenes
+			w_quantized_mesh					quantized;
 
 			void release()
 			{
 				this->vertices.clear();
 				this->indices.clear();
+				this->quantized.vertices.clear();
 			}
 
 			MSGPACK_DEFINE(vertices, indices, textures_path, bounding_box);
@@ -207,6 +212,12 @@ namespace wolf
 			WCP_EXP void add_convex_hulls(_In_ const std::vector<w_cpipeline_model*>& pCHs);
 
 			WCP_EXP void update_world();
+			/*
+				quantize vertices of meshes, lods and convex hulls, the quantized vertices will be stored in quantized of each mesh
+				@param pReport, if not null, merged report of all meshes will be stored in it
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP W_RESULT quantize_meshes(_Inout_ w_vertex_quantization_report* pReport = nullptr);
 			WCP_EXP void release();
 
 #pragma region Getters
@@ -261,7 +272,9 @@ namespace wolf
 				_In_ const bool& pSimplygonOptimizing,
 #endif
                 _In_ const bool& pZUp,
-                _In_ const bool& pInvertNormal);
+                _In_ const bool& pInvertNormal,
+                _In_ const w_vertex_welding_configs& pVertexWeldingConfigs,
+                _In_ const w_mesh_optimizer_configs& pMeshOptimizerConfigs);
 
             MSGPACK_DEFINE(_name, _instanced_geo_name, _transform, _instances_info, _lods, _convex_hulls, _bounding_box, _meshes);
 
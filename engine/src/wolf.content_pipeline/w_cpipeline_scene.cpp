@@ -14,6 +14,29 @@ w_cpipeline_scene::~w_cpipeline_scene()
 {
 }
 
+w_cpipeline_scene::w_cpipeline_scene(_Inout_ w_cpipeline_scene&& pOther) :
+    _name(std::move(pOther._name)),
+    _cameras(std::move(pOther._cameras)),
+    _models(std::move(pOther._models)),
+    _boundaries(std::move(pOther._boundaries)),
+    _z_up(pOther._z_up)
+{
+}
+
+w_cpipeline_scene& w_cpipeline_scene::operator= (_Inout_ w_cpipeline_scene&& pOther)
+{
+    if (this != &pOther)
+    {
+        release();
+        this->_name = std::move(pOther._name);
+        this->_cameras = std::move(pOther._cameras);
+        this->_models = std::move(pOther._models);
+        this->_boundaries = std::move(pOther._boundaries);
+        this->_z_up = pOther._z_up;
+    }
+    return *this;
+}
+
 void w_cpipeline_scene::add_model(_In_ w_cpipeline_model* pModel)
 {
     if (!pModel) return;
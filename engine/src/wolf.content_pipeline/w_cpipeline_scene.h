@@ -26,6 +26,11 @@ namespace wolf
 		public:
 			WCP_EXP w_cpipeline_scene();
 			WCP_EXP virtual ~w_cpipeline_scene();
+			w_cpipeline_scene(_In_ const w_cpipeline_scene& pOther) = default;
+			w_cpipeline_scene& operator= (_In_ const w_cpipeline_scene& pOther) = default;
+			//take models, boundaries and cameras of other scene without copying their vertices and indices
+			WCP_EXP w_cpipeline_scene(_Inout_ w_cpipeline_scene&& pOther);
+			WCP_EXP w_cpipeline_scene& operator= (_Inout_ w_cpipeline_scene&& pOther);
 			
 			WCP_EXP void add_model(_In_ w_cpipeline_model* pModel);
             WCP_EXP void add_models(_In_ std::vector<w_cpipeline_model*>& pModel);
@@ -0,0 +1,800 @@
+#include "w_cpipeline_pch.h"
+#include "w_mapped_scene.h"
+#include <unordered_map>
+#include <type_traits>
+#include <iterator>
+
+#if defined(__WIN32)
+#include <Windows.h>
+#elif !defined(__UWP)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+static const char			MAPPED_SCENE_MAGIC[8] = { 'W', 'L', 'F', 'S', 'C', 'E', 'N', 'E' };
+static const uint32_t		MAPPED_SCENE_VERSION = 2;
+static const uint32_t		MAPPED_SCENE_BYTE_ORDER = 0x01020304;
+static const uint64_t		MAPPED_SCENE_ALIGNMENT = 64;
+
+static_assert(sizeof(w_mapped_scene_header) == 64, "size of w_mapped_scene_header must be 64 bytes");
+static_assert(sizeof(w_mapped_scene_section) == 32, "size of w_mapped_scene_section must be 32 bytes");
+static_assert(sizeof(w_mapped_scene_mesh_entry) == 64, "size of w_mapped_scene_mesh_entry must be 64 bytes");
+static_assert(sizeof(w_quantized_vertex_struct) == 32, "size of w_quantized_vertex_struct must be 32 bytes");
+static_assert(std::is_trivially_copyable<w_vertex_struct>::value, "w_vertex_struct must be trivially copyable");
+static_assert(std::is_trivially_copyable<w_quantized_vertex_struct>::value, "w_quantized_vertex_struct must be trivially copyable");
+
+static uint64_t align_up(_In_ const uint64_t& pValue)
+{
+	return (pValue + MAPPED_SCENE_ALIGNMENT - 1) & ~(MAPPED_SCENE_ALIGNMENT - 1);
+}
+
+static void collect_meshes(_In_ w_cpipeline_model* pModel, _Inout_ std::vector<w_cpipeline_mesh*>& pMeshes)
+{
+	pModel->get_meshes(pMeshes);
+
+	std::vector<w_cpipeline_model*> _models;
+	pModel->get_lods(_models);
+	pModel->get_convex_hulls(_models);
+	for (auto _model : _models)
+	{
+		collect_meshes(_model, pMeshes);
+	}
+}
+
+//all meshes of scenes in order of scene, model, meshes of model, lods and convex hulls
+static void collect_meshes(_In_ std::vector<w_cpipeline_scene>& pScenes, _Inout_ std::vector<w_cpipeline_mesh*>& pMeshes)
+{
+	for (auto& _scene : pScenes)
+	{
+		std::vector<w_cpipeline_model*> _models;
+		_scene.get_all_models(_models);
+		for (auto _model : _models)
+		{
+			collect_meshes(_model, pMeshes);
+		}
+	}
+}
+
+namespace wolf
+{
+	namespace content_pipeline
+	{
+		class w_mapped_scene_pimp
+		{
+		public:
+			w_mapped_scene_pimp() :
+				_name("w_mapped_scene"),
+				_data(nullptr),
+				_size(0),
+				_scenes_section(nullptr),
+				_meshes(nullptr),
+				_meshes_count(0)
+#if defined(__WIN32)
+				, _file(INVALID_HANDLE_VALUE),
+				_mapping(NULL)
+#endif
+			{
+			}
+
+			~w_mapped_scene_pimp()
+			{
+				release();
+			}
+
+			static W_RESULT save(
+				_Inout_ std::vector<w_cpipeline_scene>& pScenes,
+				_In_z_ const std::wstring& pPath)
+			{
+				const std::string _trace_info = "w_mapped_scene::save";
+
+				std::vector<w_cpipeline_mesh*> _meshes;
+				collect_meshes(pScenes, _meshes);
+
+				//move out vertices and indices while packing the descriptions of scenes
+				std::vector<std::vector<w_vertex_struct>> _vertices(_meshes.size());
+				std::vector<std::vector<uint32_t>> _indices(_meshes.size());
+				for (size_t i = 0; i < _meshes.size(); ++i)
+				{
+					_vertices[i].swap(_meshes[i]->vertices);
+					_indices[i].swap(_meshes[i]->indices);
+				}
+
+				msgpack::sbuffer _scenes_buffer;
+				msgpack::pack(_scenes_buffer, pScenes);
+
+				for (size_t i = 0; i < _meshes.size(); ++i)
+				{
+					_vertices[i].swap(_meshes[i]->vertices);
+					_indices[i].swap(_meshes[i]->indices);
+				}
+
+				//layout of file, section of quantized vertices will be written only if any mesh has been quantized
+				uint32_t _sections_count = 4;
+				for (auto _mesh : _meshes)
+				{
+					if (!_mesh->quantized.vertices.empty())
+					{
+						_sections_count = 5;
+						break;
+					}
+				}
+				std::vector<w_mapped_scene_section> _sections(_sections_count);
+				std::vector<w_mapped_scene_mesh_entry> _entries(_meshes.size());
+
+				uint64_t _offset = align_up(sizeof(w_mapped_scene_header) + _sections_count * sizeof(w_mapped_scene_section));
+
+				_sections[0].type = w_mapped_scene_section_type::SCENES_SECTION;
+				_sections[0].offset = _offset;
+				_sections[0].size = _scenes_buffer.size();
+				_sections[0].count = pScenes.size();
+				_offset = align_up(_offset + _sections[0].size);
+
+				_sections[1].type = w_mapped_scene_section_type::MESHES_SECTION;
+				_sections[1].offset = _offset;
+				_sections[1].size = _entries.size() * sizeof(w_mapped_scene_mesh_entry);
+				_sections[1].count = _entries.size();
+				_offset = align_up(_offset + _sections[1].size);
+
+				_sections[2].type = w_mapped_scene_section_type::VERTICES_SECTION;
+				_sections[2].offset = _offset;
+				for (size_t i = 0; i < _meshes.size(); ++i)
+				{
+					_entries[i].vertices_offset = _offset;
+					_entries[i].vertices_count = _meshes[i]->vertices.size();
+					_offset = align_up(_offset + _entries[i].vertices_count * sizeof(w_vertex_struct));
+				}
+				_sections[2].size = _offset - _sections[2].offset;
+				_sections[2].count = _meshes.size();
+
+				_sections[3].type = w_mapped_scene_section_type::INDICES_SECTION;
+				_sections[3].offset = _offset;
+				for (size_t i = 0; i < _meshes.size(); ++i)
+				{
+					_entries[i].indices_offset = _offset;
+					_entries[i].indices_count = _meshes[i]->indices.size();
+					_offset = align_up(_offset + _entries[i].indices_count * sizeof(uint32_t));
+				}
+				_sections[3].size = _offset - _sections[3].offset;
+				_sections[3].count = _meshes.size();
+
+				for (size_t i = 0; i < _meshes.size(); ++i)
+				{
+					const auto& _quantized = _meshes[i]->quantized;
+					_entries[i].quantized_vertices_offset = 0;
+					std::memcpy(&_entries[i].position_scale[0], &_quantized.position_scale[0], sizeof(_entries[i].position_scale));
+					std::memcpy(&_entries[i].position_offset[0], &_quantized.position_offset[0], sizeof(_entries[i].position_offset));
+				}
+
+				if (_sections_count == 5)
+				{
+					uint64_t _quantized_meshes_count = 0;
+					_sections[4].type = w_mapped_scene_section_type::QUANTIZED_VERTICES_SECTION;
+					_sections[4].offset = _offset;
+					for (size_t i = 0; i < _meshes.size(); ++i)
+					{
+						const auto& _quantized = _meshes[i]->quantized;
+						if (_quantized.vertices.empty()) continue;
+						if (_quantized.vertices.size() != _meshes[i]->vertices.size())
+						{
+							logger.error(L"Quantized vertices do not match vertices of mesh, mapped scene file will not be written: " + pPath);
+							return W_FAILED;
+						}
+						_entries[i].quantized_vertices_offset = _offset;
+						_offset = align_up(_offset + _quantized.vertices.size() * sizeof(w_quantized_vertex_struct));
+						_quantized_meshes_count++;
+					}
+					_sections[4].size = _offset - _sections[4].offset;
+					_sections[4].count = _quantized_meshes_count;
+				}
+
+				for (auto& _section : _sections)
+				{
+					_section.alignment = static_cast<uint32_t>(MAPPED_SCENE_ALIGNMENT);
+				}
+
+				w_mapped_scene_header _header;
+				std::memset(&_header, 0, sizeof(_header));
+				std::memcpy(&_header.magic[0], &MAPPED_SCENE_MAGIC[0], sizeof(MAPPED_SCENE_MAGIC));
+				_header.version = MAPPED_SCENE_VERSION;
+				_header.header_size = sizeof(w_mapped_scene_header);
+				_header.byte_order = MAPPED_SCENE_BYTE_ORDER;
+				_header.vertex_stride = sizeof(w_vertex_struct);
+				_header.sections_count = _sections_count;
+				_header.section_table_offset = sizeof(w_mapped_scene_header);
+				_header.file_size = _offset;
+
+#if defined(__WIN32) || defined(__UWP)
+				auto _path = pPath;
+#else
+				auto _path = wolf::system::convert::wstring_to_string(pPath);
+#endif
+				std::ofstream _file(_path, std::ios::out | std::ios::binary);
+				if (!_file || _file.bad())
+				{
+					logger.error(L"Error on creating mapped scene file on following path: " + pPath);
+					return W_FAILED;
+				}
+
+				uint64_t _written = 0;
+				auto _write = [&_file, &_written](_In_ const void* pData, _In_ const uint64_t& pSize)
+				{
+					if (pSize)
+					{
+						_file.write(static_cast<const char*>(pData), static_cast<std::streamsize>(pSize));
+					}
+					_written += pSize;
+				};
+				auto _pad = [&_file, &_written](_In_ const uint64_t& pOffset)
+				{
+					static const char _zeros[MAPPED_SCENE_ALIGNMENT] = {};
+					while (_written < pOffset)
+					{
+						auto _size = std::min<uint64_t>(pOffset - _written, MAPPED_SCENE_ALIGNMENT);
+						_file.write(_zeros, static_cast<std::streamsize>(_size));
+						_written += _size;
+					}
+				};
+
+				_write(&_header, sizeof(_header));
+				_write(_sections.data(), _sections.size() * sizeof(w_mapped_scene_section));
+
+				_pad(_sections[0].offset);
+				_write(_scenes_buffer.data(), _scenes_buffer.size());
+
+				_pad(_sections[1].offset);
+				_write(_entries.data(), _entries.size() * sizeof(w_mapped_scene_mesh_entry));
+
+				for (size_t i = 0; i < _meshes.size(); ++i)
+				{
+					_pad(_entries[i].vertices_offset);
+					_write(_meshes[i]->vertices.data(), _entries[i].vertices_count * sizeof(w_vertex_struct));
+				}
+				for (size_t i = 0; i < _meshes.size(); ++i)
+				{
+					_pad(_entries[i].indices_offset);
+					_write(_meshes[i]->indices.data(), _entries[i].indices_count * sizeof(uint32_t));
+				}
+				for (size_t i = 0; i < _meshes.size(); ++i)
+				{
+					if (!_entries[i].quantized_vertices_offset) continue;
+					_pad(_entries[i].quantized_vertices_offset);
+					_write(_meshes[i]->quantized.vertices.data(), _entries[i].vertices_count * sizeof(w_quantized_vertex_struct));
+				}
+				_pad(_header.file_size);
+
+				_file.flush();
+				auto _failed = _file.bad() || _file.fail();
+				_file.close();
+
+				if (_failed)
+				{
+					logger.error(L"Error on writing mapped scene file on following path: " + pPath);
+					return W_FAILED;
+				}
+
+				return W_PASSED;
+			}
+
+			static bool is_mapped_scene_file(_In_z_ const std::wstring& pPath)
+			{
+#if defined(__WIN32) || defined(__UWP)
+				auto _path = pPath;
+#else
+				auto _path = wolf::system::convert::wstring_to_string(pPath);
+#endif
+				std::ifstream _file(_path, std::ios::in | std::ios::binary);
+				if (!_file || _file.bad()) return false;
+
+				char _magic[sizeof(MAPPED_SCENE_MAGIC)];
+				_file.read(_magic, sizeof(_magic));
+				auto _read = _file.gcount() == static_cast<std::streamsize>(sizeof(_magic));
+				_file.close();
+
+				return _read && std::memcmp(_magic, MAPPED_SCENE_MAGIC, sizeof(_magic)) == 0;
+			}
+
+			W_RESULT load(_In_z_ const std::wstring& pPath)
+			{
+				release();
+
+				if (_map(pPath) == W_FAILED) return W_FAILED;
+
+				if (_validate(pPath) == W_FAILED ||
+					_read_scenes(pPath) == W_FAILED)
+				{
+					release();
+					return W_FAILED;
+				}
+
+				return W_PASSED;
+			}
+
+			W_RESULT copy_to(_Inout_ std::vector<w_cpipeline_scene>& pScenes) const
+			{
+				if (!this->_data)
+				{
+					logger.error("mapped scene has not been loaded. trace info: " + this->_name + "::copy_to");
+					return W_FAILED;
+				}
+
+				auto _first_scene = pScenes.size();
+				pScenes.insert(pScenes.end(), this->_scenes.begin(), this->_scenes.end());
+				fill_meshes(pScenes, _first_scene);
+
+				return W_PASSED;
+			}
+
+			W_RESULT move_to(_Inout_ std::vector<w_cpipeline_scene>& pScenes)
+			{
+				if (!this->_data)
+				{
+					logger.error("mapped scene has not been loaded. trace info: " + this->_name + "::move_to");
+					return W_FAILED;
+				}
+
+				//meshes will be owned by pScenes, so they can not be found by get_mesh anymore
+				auto _first_scene = pScenes.size();
+				pScenes.insert(pScenes.end(), std::make_move_iterator(this->_scenes.begin()), std::make_move_iterator(this->_scenes.end()));
+				this->_scenes.clear();
+				this->_mesh_indices.clear();
+				fill_meshes(pScenes, _first_scene);
+
+				return W_PASSED;
+			}
+
+			//copy vertices, indices and quantized vertices of mapped file into meshes of scenes which start from pFirstScene
+			void fill_meshes(_Inout_ std::vector<w_cpipeline_scene>& pScenes, _In_ const size_t& pFirstScene) const
+			{
+				std::vector<w_cpipeline_mesh*> _meshes;
+				for (auto i = pFirstScene; i < pScenes.size(); ++i)
+				{
+					std::vector<w_cpipeline_model*> _models;
+					pScenes[i].get_all_models(_models);
+					for (auto _model : _models)
+					{
+						collect_meshes(_model, _meshes);
+					}
+				}
+
+				for (size_t i = 0; i < _meshes.size(); ++i)
+				{
+					w_mapped_mesh _mapped_mesh;
+					get_mesh(i, _mapped_mesh);
+
+					_meshes[i]->vertices.assign(_mapped_mesh.vertices, _mapped_mesh.vertices + _mapped_mesh.vertices_count);
+					_meshes[i]->indices.assign(_mapped_mesh.indices, _mapped_mesh.indices + _mapped_mesh.indices_count);
+
+					auto& _quantized = _meshes[i]->quantized;
+					_quantized.vertices.clear();
+					if (_mapped_mesh.quantized_vertices)
+					{
+						_quantized.vertices.assign(_mapped_mesh.quantized_vertices, _mapped_mesh.quantized_vertices + _mapped_mesh.vertices_count);
+					}
+					std::memcpy(&_quantized.position_scale[0], &_mapped_mesh.position_scale[0], sizeof(_quantized.position_scale));
+					std::memcpy(&_quantized.position_offset[0], &_mapped_mesh.position_offset[0], sizeof(_quantized.position_offset));
+				}
+			}
+
+			W_RESULT get_mesh(_In_ const size_t& pIndex, _Out_ w_mapped_mesh& pMesh) const
+			{
+				pMesh = w_mapped_mesh();
+				if (pIndex >= this->_meshes_count) return W_FAILED;
+
+				const auto& _entry = this->_meshes[pIndex];
+				pMesh.vertices = reinterpret_cast<const w_vertex_struct*>(this->_data + _entry.vertices_offset);
+				pMesh.vertices_count = static_cast<size_t>(_entry.vertices_count);
+				pMesh.indices = reinterpret_cast<const uint32_t*>(this->_data + _entry.indices_offset);
+				pMesh.indices_count = static_cast<size_t>(_entry.indices_count);
+				if (_entry.quantized_vertices_offset)
+				{
+					pMesh.quantized_vertices = reinterpret_cast<const w_quantized_vertex_struct*>(this->_data + _entry.quantized_vertices_offset);
+				}
+				std::memcpy(&pMesh.position_scale[0], &_entry.position_scale[0], sizeof(pMesh.position_scale));
+				std::memcpy(&pMesh.position_offset[0], &_entry.position_offset[0], sizeof(pMesh.position_offset));
+
+				return W_PASSED;
+			}
+
+			W_RESULT get_mesh(_In_ const w_cpipeline_mesh* pSceneMesh, _Out_ w_mapped_mesh& pMesh) const
+			{
+				auto _iter = this->_mesh_indices.find(pSceneMesh);
+				if (_iter == this->_mesh_indices.end())
+				{
+					pMesh = w_mapped_mesh();
+					return W_FAILED;
+				}
+				return get_mesh(_iter->second, pMesh);
+			}
+
+			void release()
+			{
+				this->_mesh_indices.clear();
+				for (auto& _scene : this->_scenes)
+				{
+					_scene.release();
+				}
+				this->_scenes.clear();
+				this->_meshes = nullptr;
+				this->_meshes_count = 0;
+
+#if defined(__WIN32)
+				if (this->_data)
+				{
+					UnmapViewOfFile(this->_data);
+				}
+				if (this->_mapping)
+				{
+					CloseHandle(this->_mapping);
+					this->_mapping = NULL;
+				}
+				if (this->_file != INVALID_HANDLE_VALUE)
+				{
+					CloseHandle(this->_file);
+					this->_file = INVALID_HANDLE_VALUE;
+				}
+#elif defined(__UWP)
+				this->_buffer.clear();
+				this->_buffer.shrink_to_fit();
+#else
+				if (this->_data)
+				{
+					munmap(const_cast<uint8_t*>(this->_data), this->_size);
+				}
+#endif
+				this->_data = nullptr;
+				this->_size = 0;
+			}
+
+#pragma region Getters
+
+			size_t get_scenes_count() const
+			{
+				return this->_scenes.size();
+			}
+
+			w_cpipeline_scene* get_scene(_In_ const size_t& pIndex)
+			{
+				return pIndex < this->_scenes.size() ? &this->_scenes[pIndex] : nullptr;
+			}
+
+			size_t get_meshes_count() const
+			{
+				return this->_meshes_count;
+			}
+
+			size_t get_mapped_size() const
+			{
+				return this->_size;
+			}
+
+#pragma endregion
+
+		private:
+			W_RESULT _map(_In_z_ const std::wstring& pPath)
+			{
+#if defined(__WIN32)
+				this->_file = CreateFileW(
+					pPath.c_str(),
+					GENERIC_READ,
+					FILE_SHARE_READ,
+					NULL,
+					OPEN_EXISTING,
+					FILE_ATTRIBUTE_NORMAL,
+					NULL);
+				if (this->_file == INVALID_HANDLE_VALUE)
+				{
+					logger.error(L"Error on opening mapped scene file from following path: " + pPath);
+					return W_FAILED;
+				}
+
+				LARGE_INTEGER _file_size;
+				if (!GetFileSizeEx(this->_file, &_file_size) || _file_size.QuadPart == 0)
+				{
+					logger.error(L"Mapped scene file is empty: " + pPath);
+					release();
+					return W_FAILED;
+				}
+				this->_size = static_cast<size_t>(_file_size.QuadPart);
+
+				this->_mapping = CreateFileMappingW(this->_file, NULL, PAGE_READONLY, 0, 0, NULL);
+				if (!this->_mapping)
+				{
+					logger.error(L"Error on creating file mapping of mapped scene file: " + pPath);
+					release();
+					return W_FAILED;
+				}
+
+				this->_data = static_cast<const uint8_t*>(MapViewOfFile(this->_mapping, FILE_MAP_READ, 0, 0, 0));
+				if (!this->_data)
+				{
+					logger.error(L"Error on mapping view of mapped scene file: " + pPath);
+					release();
+					return W_FAILED;
+				}
+#elif defined(__UWP)
+				//memory mapping is not available, so read the whole file
+				std::ifstream _file(pPath, std::ios::in | std::ios::binary | std::ios::ate);
+				if (!_file || _file.bad())
+				{
+					logger.error(L"Error on opening mapped scene file from following path: " + pPath);
+					return W_FAILED;
+				}
+				this->_size = static_cast<size_t>(_file.tellg());
+				_file.seekg(0, std::ios::beg);
+				this->_buffer.resize(this->_size);
+				_file.read(reinterpret_cast<char*>(this->_buffer.data()), this->_size);
+				_file.close();
+				this->_data = this->_buffer.data();
+#else
+				auto _path = wolf::system::convert::wstring_to_string(pPath);
+				auto _fd = open(_path.c_str(), O_RDONLY);
+				if (_fd == -1)
+				{
+					logger.error("Error on opening mapped scene file from following path: " + _path);
+					return W_FAILED;
+				}
+
+				struct stat _stat;
+				if (fstat(_fd, &_stat) == -1 || _stat.st_size == 0)
+				{
+					logger.error("Mapped scene file is empty: " + _path);
+					close(_fd);
+					return W_FAILED;
+				}
+				this->_size = static_cast<size_t>(_stat.st_size);
+
+				auto _ptr = mmap(nullptr, this->_size, PROT_READ, MAP_PRIVATE, _fd, 0);
+				//file descriptor is not needed after mapping
+				close(_fd);
+				if (_ptr == MAP_FAILED)
+				{
+					logger.error("Error on mapping mapped scene file: " + _path);
+					this->_size = 0;
+					return W_FAILED;
+				}
+				this->_data = static_cast<const uint8_t*>(_ptr);
+#endif
+				return W_PASSED;
+			}
+
+			bool _is_in_range(_In_ const uint64_t& pOffset, _In_ const uint64_t& pSize) const
+			{
+				return pOffset <= this->_size && pSize <= this->_size - pOffset;
+			}
+
+			W_RESULT _validate(_In_z_ const std::wstring& pPath)
+			{
+				if (this->_size < sizeof(w_mapped_scene_header))
+				{
+					logger.error(L"Invalid mapped scene file: " + pPath);
+					return W_FAILED;
+				}
+
+				auto _header = reinterpret_cast<const w_mapped_scene_header*>(this->_data);
+				if (std::memcmp(_header->magic, MAPPED_SCENE_MAGIC, sizeof(MAPPED_SCENE_MAGIC)) != 0 ||
+					_header->header_size != sizeof(w_mapped_scene_header))
+				{
+					logger.error(L"Invalid header of mapped scene file: " + pPath);
+					return W_FAILED;
+				}
+				if (_header->version != MAPPED_SCENE_VERSION)
+				{
+					logger.error(L"Unsupported version of mapped scene file: " + pPath);
+					return W_FAILED;
+				}
+				if (_header->byte_order != MAPPED_SCENE_BYTE_ORDER)
+				{
+					logger.error(L"Byte order of mapped scene file is not supported: " + pPath);
+					return W_FAILED;
+				}
+				if (_header->vertex_stride != sizeof(w_vertex_struct))
+				{
+					logger.error(L"Vertex layout of mapped scene file does not match: " + pPath);
+					return W_FAILED;
+				}
+				if (_header->file_size != this->_size ||
+					!_is_in_range(_header->section_table_offset, uint64_t(_header->sections_count) * sizeof(w_mapped_scene_section)) ||
+					_header->section_table_offset % alignof(w_mapped_scene_section))
+				{
+					logger.error(L"Mapped scene file is truncated: " + pPath);
+					return W_FAILED;
+				}
+
+				//find sections
+				const w_mapped_scene_section* _meshes_section = nullptr;
+				this->_scenes_section = nullptr;
+				auto _sections = reinterpret_cast<const w_mapped_scene_section*>(this->_data + _header->section_table_offset);
+				for (uint32_t i = 0; i < _header->sections_count; ++i)
+				{
+					const auto& _section = _sections[i];
+					if (!_is_in_range(_section.offset, _section.size))
+					{
+						logger.error(L"Section of mapped scene file is out of range: " + pPath);
+						return W_FAILED;
+					}
+					if (_section.type == w_mapped_scene_section_type::SCENES_SECTION)
+					{
+						this->_scenes_section = &_section;
+					}
+					else if (_section.type == w_mapped_scene_section_type::MESHES_SECTION)
+					{
+						_meshes_section = &_section;
+					}
+				}
+
+				if (!this->_scenes_section || !_meshes_section ||
+					_meshes_section->offset % alignof(w_mapped_scene_mesh_entry) ||
+					_meshes_section->size != _meshes_section->count * sizeof(w_mapped_scene_mesh_entry))
+				{
+					logger.error(L"Missing sections of mapped scene file: " + pPath);
+					return W_FAILED;
+				}
+
+				this->_meshes = reinterpret_cast<const w_mapped_scene_mesh_entry*>(this->_data + _meshes_section->offset);
+				this->_meshes_count = static_cast<size_t>(_meshes_section->count);
+				for (size_t i = 0; i < this->_meshes_count; ++i)
+				{
+					const auto& _entry = this->_meshes[i];
+					if (_entry.vertices_count > this->_size / sizeof(w_vertex_struct) ||
+						_entry.indices_count > this->_size / sizeof(uint32_t) ||
+						!_is_in_range(_entry.vertices_offset, _entry.vertices_count * sizeof(w_vertex_struct)) ||
+						!_is_in_range(_entry.indices_offset, _entry.indices_count * sizeof(uint32_t)) ||
+						_entry.vertices_offset % alignof(w_vertex_struct) ||
+						_entry.indices_offset % alignof(uint32_t) ||
+						(_entry.quantized_vertices_offset &&
+						(_entry.vertices_count > this->_size / sizeof(w_quantized_vertex_struct) ||
+							!_is_in_range(_entry.quantized_vertices_offset, _entry.vertices_count * sizeof(w_quantized_vertex_struct)) ||
+							_entry.quantized_vertices_offset % alignof(w_quantized_vertex_struct))))
+					{
+						logger.error(L"Mesh of mapped scene file is out of range: " + pPath);
+						return W_FAILED;
+					}
+				}
+
+				return W_PASSED;
+			}
+
+			W_RESULT _read_scenes(_In_z_ const std::wstring& pPath)
+			{
+				try
+				{
+					auto _msg = msgpack::unpack(
+						reinterpret_cast<const char*>(this->_data + this->_scenes_section->offset),
+						static_cast<size_t>(this->_scenes_section->size));
+					_msg.get().convert(this->_scenes);
+				}
+				catch (...)
+				{
+					logger.error(L"Error on reading scenes of mapped scene file: " + pPath);
+					return W_FAILED;
+				}
+
+				std::vector<w_cpipeline_mesh*> _meshes;
+				collect_meshes(this->_scenes, _meshes);
+				if (_meshes.size() != this->_meshes_count)
+				{
+					logger.error(L"Number of meshes of mapped scene file does not match: " + pPath);
+					return W_FAILED;
+				}
+
+				this->_mesh_indices.reserve(_meshes.size());
+				for (size_t i = 0; i < _meshes.size(); ++i)
+				{
+					this->_mesh_indices[_meshes[i]] = i;
+				}
+
+				return W_PASSED;
+			}
+
+			std::string													_name;
+			const uint8_t*												_data;
+			size_t														_size;
+			const w_mapped_scene_section*								_scenes_section;
+			const w_mapped_scene_mesh_entry*							_meshes;
+			size_t														_meshes_count;
+			std::vector<w_cpipeline_scene>								_scenes;
+			std::unordered_map<const w_cpipeline_mesh*, size_t>			_mesh_indices;
+#if defined(__WIN32)
+			HANDLE														_file;
+			HANDLE														_mapping;
+#elif defined(__UWP)
+			std::vector<uint8_t>										_buffer;
+#endif
+		};
+	}
+}
+
+w_mapped_scene::w_mapped_scene() :
+	_pimp(new w_mapped_scene_pimp())
+{
+}
+
+w_mapped_scene::~w_mapped_scene()
+{
+	release();
+}
+
+W_RESULT w_mapped_scene::save(
+	_Inout_ std::vector<w_cpipeline_scene>& pScenes,
+	_In_z_ const std::wstring& pPath)
+{
+	return w_mapped_scene_pimp::save(pScenes, pPath);
+}
+
+bool w_mapped_scene::is_mapped_scene_file(_In_z_ const std::wstring& pPath)
+{
+	return w_mapped_scene_pimp::is_mapped_scene_file(pPath);
+}
+
+W_RESULT w_mapped_scene::load(_In_z_ const std::wstring& pPath)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->load(pPath);
+}
+
+W_RESULT w_mapped_scene::copy_to(_Inout_ std::vector<w_cpipeline_scene>& pScenes) const
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->copy_to(pScenes);
+}
+
+W_RESULT w_mapped_scene::move_to(_Inout_ std::vector<w_cpipeline_scene>& pScenes)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->move_to(pScenes);
+}
+
+ULONG w_mapped_scene::release()
+{
+	SAFE_DELETE(this->_pimp);
+	return 0;
+}
+
+#pragma region Getters
+
+size_t w_mapped_scene::get_scenes_count() const
+{
+	return this->_pimp ? this->_pimp->get_scenes_count() : 0;
+}
+
+w_cpipeline_scene* w_mapped_scene::get_scene(_In_ const size_t& pIndex)
+{
+	return this->_pimp ? this->_pimp->get_scene(pIndex) : nullptr;
+}
+
+size_t w_mapped_scene::get_meshes_count() const
+{
+	return this->_pimp ? this->_pimp->get_meshes_count() : 0;
+}
+
+W_RESULT w_mapped_scene::get_mesh(_In_ const size_t& pIndex, _Out_ w_mapped_mesh& pMesh) const
+{
+	if (!this->_pimp)
+	{
+		pMesh = w_mapped_mesh();
+		return W_FAILED;
+	}
+	return this->_pimp->get_mesh(pIndex, pMesh);
+}
+
+W_RESULT w_mapped_scene::get_mesh(_In_ const w_cpipeline_mesh* pSceneMesh, _Out_ w_mapped_mesh& pMesh) const
+{
+	if (!this->_pimp)
+	{
+		pMesh = w_mapped_mesh();
+		return W_FAILED;
+	}
+	return this->_pimp->get_mesh(pSceneMesh, pMesh);
+}
+
+size_t w_mapped_scene::get_mapped_size() const
+{
+	return this->_pimp ? this->_pimp->get_mapped_size() : 0;
+}
+
+#pragma endregion
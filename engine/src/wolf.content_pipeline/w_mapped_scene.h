@@ -0,0 +1,166 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_mapped_scene.h
+	Description		 : Versioned binary container of wolf scenes which will be memory mapped
+	Comment          : Layout of file is a 64 bytes header, a section table and sections which are aligned to 64 bytes.
+					   Scene descriptions (models, instances, cameras, ...) are stored in a msgpack section without vertices and indices,
+					   vertices and indices of each mesh are stored as raw blobs, so they can be copied to staging buffers directly
+					   from the mapped file. Quantized vertices of meshes are stored in an optional section. Files are little endian
+*/
+
+#ifndef __W_MAPPED_SCENE_H__
+#define __W_MAPPED_SCENE_H__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "w_cpipeline_export.h"
+#include "w_cpipeline_scene.h"
+
+namespace wolf
+{
+	namespace content_pipeline
+	{
+		enum w_mapped_scene_section_type : uint32_t
+		{
+			//msgpack of scenes without vertices and indices
+			SCENES_SECTION = 1,
+			//array of w_mapped_scene_mesh_entry
+			MESHES_SECTION,
+			//vertices of all meshes
+			VERTICES_SECTION,
+			//indices of all meshes
+			INDICES_SECTION,
+			//w_quantized_vertex_struct of meshes which have been quantized
+			QUANTIZED_VERTICES_SECTION
+		};
+
+		struct w_mapped_scene_header
+		{
+			char			magic[8];
+			uint32_t		version;
+			uint32_t		header_size;
+			//0x01020304 written in byte order of writer
+			uint32_t		byte_order;
+			//size of w_vertex_struct of writer
+			uint32_t		vertex_stride;
+			uint32_t		sections_count;
+			uint32_t		reserved_0;
+			uint64_t		section_table_offset;
+			uint64_t		file_size;
+			uint8_t			reserved_1[16];
+		};
+
+		struct w_mapped_scene_section
+		{
+			uint32_t		type;
+			uint32_t		alignment;
+			//offset from the beginning of file
+			uint64_t		offset;
+			uint64_t		size;
+			//number of elements
+			uint64_t		count;
+		};
+
+		struct w_mapped_scene_mesh_entry
+		{
+			//offsets are from the beginning of file
+			uint64_t		vertices_offset;
+			uint64_t		vertices_count;
+			uint64_t		indices_offset;
+			uint64_t		indices_count;
+			//zero means mesh does not have quantized vertices, otherwise there are vertices_count quantized vertices
+			uint64_t		quantized_vertices_offset;
+			float			position_scale[3];
+			float			position_offset[3];
+		};
+
+		//vertices and indices of mesh inside mapped file, they are valid until w_mapped_scene released
+		struct w_mapped_mesh
+		{
+			const w_vertex_struct*		vertices = nullptr;
+			size_t						vertices_count = 0;
+			const uint32_t*				indices = nullptr;
+			size_t						indices_count = 0;
+			//null if mesh has not been quantized, the count is vertices_count
+			const w_quantized_vertex_struct*	quantized_vertices = nullptr;
+			float						position_scale[3] = { 1.0f, 1.0f, 1.0f };
+			float						position_offset[3] = { 0.0f, 0.0f, 0.0f };
+		};
+
+		class w_mapped_scene_pimp;
+		class w_mapped_scene
+		{
+		public:
+			WCP_EXP w_mapped_scene();
+			WCP_EXP ~w_mapped_scene();
+
+			/*
+				write scenes to a mapped scene file, vertices and indices of meshes will be moved out temporarily while
+				writing scene descriptions, so scenes will not be copied. Quantized vertices of meshes will be written too
+				@param pScenes, scenes
+				@param pPath, path of file
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT save(
+				_Inout_ std::vector<w_cpipeline_scene>& pScenes,
+				_In_z_ const std::wstring& pPath);
+
+			//returns true if file starts with header of mapped scene
+			WCP_EXP static bool is_mapped_scene_file(_In_z_ const std::wstring& pPath);
+
+			/*
+				map file and read scene descriptions, vertices and indices will not be read.
+				Meshes of scenes do not have vertices and indices, use get_mesh for accessing them in place
+				@param pPath, path of file
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP W_RESULT load(_In_z_ const std::wstring& pPath);
+
+			/*
+				copy scenes with their vertices and indices, this is used for compatibility with msgpack scenes
+				@param pScenes, output scenes
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP W_RESULT copy_to(_Inout_ std::vector<w_cpipeline_scene>& pScenes) const;
+
+			/*
+				move scenes with their vertices and indices, the descriptions will not be copied and mapped scene
+				will not have any scene after this call, so use it when mapped scene will be released
+				@param pScenes, output scenes
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP W_RESULT move_to(_Inout_ std::vector<w_cpipeline_scene>& pScenes);
+
+			//unmap file and release all resources
+			WCP_EXP ULONG release();
+
+#pragma region Getters
+
+			WCP_EXP size_t get_scenes_count() const;
+			//scene description, meshes of it are empty
+			WCP_EXP w_cpipeline_scene* get_scene(_In_ const size_t& pIndex);
+			WCP_EXP size_t get_meshes_count() const;
+			//get mesh by index, meshes are ordered by scene, model, meshes of model, lods and convex hulls
+			WCP_EXP W_RESULT get_mesh(_In_ const size_t& pIndex, _Out_ w_mapped_mesh& pMesh) const;
+			//get mapped data of a mesh of scenes which have been returned by get_scene
+			WCP_EXP W_RESULT get_mesh(_In_ const w_cpipeline_mesh* pSceneMesh, _Out_ w_mapped_mesh& pMesh) const;
+			//size of mapped file in bytes
+			WCP_EXP size_t get_mapped_size() const;
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_mapped_scene(w_mapped_scene const&);
+			w_mapped_scene& operator= (w_mapped_scene const&);
+
+			w_mapped_scene_pimp*		_pimp;
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,748 @@
+#include "w_cpipeline_pch.h"
+#include "w_mesh_optimizer.h"
+#include <unordered_map>
+
+using namespace wolf;
+using namespace wolf::content_pipeline;
+
+namespace
+{
+	struct w_welding_key
+	{
+		int64_t		attributes[8];
+		uint32_t	blend_weight[4];
+		int			blend_indices[4];
+
+		bool operator==(_In_ const w_welding_key& pOther) const
+		{
+			return std::memcmp(this, &pOther, sizeof(w_welding_key)) == 0;
+		}
+	};
+
+	struct w_welding_key_hasher
+	{
+		size_t operator()(_In_ const w_welding_key& pKey) const
+		{
+			//FNV-1a over bytes of key
+			uint64_t _hash = 14695981039346656037ull;
+			auto _bytes = reinterpret_cast<const uint8_t*>(&pKey);
+			for (size_t i = 0; i < sizeof(w_welding_key); ++i)
+			{
+				_hash ^= _bytes[i];
+				_hash *= 1099511628211ull;
+			}
+			return static_cast<size_t>(_hash);
+		}
+	};
+
+	static int64_t quantize(_In_ float pValue, _In_ const float& pInvEpsilon)
+	{
+		if (pInvEpsilon > 0.0f && std::isfinite(pValue))
+		{
+			return static_cast<int64_t>(std::floor(static_cast<double>(pValue) * pInvEpsilon + 0.5));
+		}
+
+		//compare bits, but -0.0 and +0.0 are same
+		if (pValue == 0.0f) pValue = 0.0f;
+		uint32_t _bits;
+		std::memcpy(&_bits, &pValue, sizeof(_bits));
+		return static_cast<int64_t>(_bits);
+	}
+
+	static bool validate_indices(
+		_In_ const std::vector<uint32_t>& pIndices,
+		_In_ const size_t& pVerticesCount,
+		_In_z_ const std::string& pTraceInfo)
+	{
+		if (pIndices.size() % 3)
+		{
+			logger.error("indices must be a triangle list. trace info: " + pTraceInfo);
+			return false;
+		}
+		for (auto _index : pIndices)
+		{
+			if (_index >= pVerticesCount)
+			{
+				logger.error("index out of range of vertices. trace info: " + pTraceInfo);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//returns number of misses of a triangle in FIFO cache, a vertex is in cache if it was pushed less than pCacheSize misses ago
+	static uint32_t update_fifo_cache(
+		_In_ const uint32_t* pTriangle,
+		_In_ const uint32_t& pCacheSize,
+		_Inout_ std::vector<size_t>& pTimeStamps,
+		_Inout_ size_t& pTime)
+	{
+		uint32_t _misses = 0;
+		for (size_t i = 0; i < 3; ++i)
+		{
+			auto _index = pTriangle[i];
+			if (pTime - pTimeStamps[_index] > pCacheSize)
+			{
+				pTimeStamps[_index] = pTime++;
+				_misses++;
+			}
+		}
+		return _misses;
+	}
+
+	static size_t simulate_fifo_cache(
+		_In_ const std::vector<uint32_t>& pIndices,
+		_In_ const size_t& pVerticesCount,
+		_In_ const uint32_t& pCacheSize)
+	{
+		std::vector<size_t> _time_stamps(pVerticesCount, 0);
+		size_t _time = pCacheSize + 1;
+		size_t _misses = 0;
+		for (size_t i = 0; i + 2 < pIndices.size(); i += 3)
+		{
+			_misses += update_fifo_cache(&pIndices[i], pCacheSize, _time_stamps, _time);
+		}
+		return _misses;
+	}
+
+	//triangles of each vertex in compressed rows, triangles of vertex v are in [offsets[v], offsets[v + 1])
+	struct w_triangle_adjacency
+	{
+		std::vector<uint32_t>	offsets;
+		std::vector<uint32_t>	triangles;
+
+		void build(_In_ const std::vector<uint32_t>& pIndices, _In_ const size_t& pVerticesCount)
+		{
+			this->offsets.assign(pVerticesCount + 1, 0);
+			for (auto _index : pIndices)
+			{
+				this->offsets[_index + 1]++;
+			}
+			for (size_t i = 0; i < pVerticesCount; ++i)
+			{
+				this->offsets[i + 1] += this->offsets[i];
+			}
+
+			this->triangles.resize(pIndices.size());
+			std::vector<uint32_t> _fill(this->offsets.begin(), this->offsets.end() - 1);
+			for (size_t i = 0; i < pIndices.size(); ++i)
+			{
+				this->triangles[_fill[pIndices[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+	};
+
+	static const float FORSYTH_CACHE_DECAY_POWER = 1.5f;
+	static const float FORSYTH_LAST_TRIANGLE_SCORE = 0.75f;
+	static const float FORSYTH_VALENCE_BOOST_SCALE = 2.0f;
+	static const float FORSYTH_VALENCE_BOOST_POWER = 0.5f;
+
+	static float forsyth_vertex_score(
+		_In_ const int& pCachePosition,
+		_In_ const uint32_t& pLiveTriangles,
+		_In_ const uint32_t& pCacheSize)
+	{
+		//vertex is not used by any remaining triangles
+		if (pLiveTriangles == 0) return -1.0f;
+
+		float _score = 0.0f;
+		if (pCachePosition >= 0)
+		{
+			if (pCachePosition < 3)
+			{
+				//vertices of the last triangle get a fixed score, so the next triangle does not prefer them over others
+				_score = FORSYTH_LAST_TRIANGLE_SCORE;
+			}
+			else
+			{
+				auto _scaler = 1.0f / static_cast<float>(pCacheSize - 3);
+				_score = std::pow(1.0f - static_cast<float>(pCachePosition - 3) * _scaler, FORSYTH_CACHE_DECAY_POWER);
+			}
+		}
+
+		//boost vertices with few remaining triangles, so they will be finished and do not leave lonely triangles
+		_score += FORSYTH_VALENCE_BOOST_SCALE * std::pow(static_cast<float>(pLiveTriangles), -FORSYTH_VALENCE_BOOST_POWER);
+		return _score;
+	}
+}
+
+W_RESULT w_mesh_optimizer::optimize(
+	_Inout_ std::vector<w_vertex_struct>& pVertices,
+	_Inout_ std::vector<uint32_t>& pIndices,
+	_In_ const w_mesh_optimizer_configs& pConfigs)
+{
+	const std::string _trace_info = "w_mesh_optimizer::optimize";
+
+	if (pVertices.empty() || pIndices.empty()) return W_PASSED;
+	if (!validate_indices(pIndices, pVertices.size(), _trace_info)) return W_FAILED;
+
+	W_RESULT _hr = W_PASSED;
+	switch (pConfigs.vertex_cache_optimizer)
+	{
+	default:
+	case w_vertex_cache_optimizer::NO_VERTEX_CACHE_OPTIMIZING:
+		break;
+	case w_vertex_cache_optimizer::FORSYTH_VERTEX_CACHE_OPTIMIZING:
+		//Forsyth models an LRU cache which needs a few more entries than the FIFO
+		_hr = optimize_vertex_cache_forsyth(pIndices, pVertices.size(), std::max(pConfigs.cache_size, 32u));
+		break;
+	case w_vertex_cache_optimizer::TIPSIFY_VERTEX_CACHE_OPTIMIZING:
+		_hr = optimize_vertex_cache_tipsify(pIndices, pVertices.size(), pConfigs.cache_size);
+		break;
+	}
+	if (_hr == W_FAILED) return _hr;
+
+	if (pConfigs.optimize_overdraw && pConfigs.vertex_cache_optimizer != w_vertex_cache_optimizer::NO_VERTEX_CACHE_OPTIMIZING)
+	{
+		_hr = optimize_overdraw(pIndices, pVertices, pConfigs.cache_size, pConfigs.overdraw_threshold);
+		if (_hr == W_FAILED) return _hr;
+	}
+
+	if (pConfigs.optimize_vertex_fetch)
+	{
+		_hr = optimize_vertex_fetch(pVertices, pIndices);
+	}
+
+	return _hr;
+}
+
+W_RESULT w_mesh_optimizer::optimize_vertex_cache_forsyth(
+	_Inout_ std::vector<uint32_t>& pIndices,
+	_In_ const size_t& pVerticesCount,
+	_In_ const uint32_t& pCacheSize)
+{
+	const std::string _trace_info = "w_mesh_optimizer::optimize_vertex_cache_forsyth";
+
+	if (pIndices.empty()) return W_PASSED;
+	if (pCacheSize < 4)
+	{
+		logger.error("cache size must be at least 4. trace info: " + _trace_info);
+		return W_FAILED;
+	}
+	if (!validate_indices(pIndices, pVerticesCount, _trace_info)) return W_FAILED;
+
+	auto _triangles_count = pIndices.size() / 3;
+
+	w_triangle_adjacency _adjacency;
+	_adjacency.build(pIndices, pVerticesCount);
+
+	//live triangles of vertex v are the first _live_triangles[v] entries of its adjacency row
+	std::vector<uint32_t> _live_triangles(pVerticesCount);
+	std::vector<int> _cache_positions(pVerticesCount, -1);
+	std::vector<float> _vertex_scores(pVerticesCount);
+	for (size_t i = 0; i < pVerticesCount; ++i)
+	{
+		_live_triangles[i] = _adjacency.offsets[i + 1] - _adjacency.offsets[i];
+		_vertex_scores[i] = forsyth_vertex_score(-1, _live_triangles[i], pCacheSize);
+	}
+
+	std::vector<float> _triangle_scores(_triangles_count);
+	std::vector<bool> _emitted(_triangles_count, false);
+
+	size_t _best_triangle = 0;
+	for (size_t i = 0; i < _triangles_count; ++i)
+	{
+		auto _t = &pIndices[i * 3];
+		_triangle_scores[i] = _vertex_scores[_t[0]] + _vertex_scores[_t[1]] + _vertex_scores[_t[2]];
+		if (_triangle_scores[i] > _triangle_scores[_best_triangle])
+		{
+			_best_triangle = i;
+		}
+	}
+
+	std::vector<uint32_t> _result;
+	_result.reserve(pIndices.size());
+
+	//the cache keeps three extra entries for the vertices of new triangle
+	std::vector<uint32_t> _cache, _new_cache;
+	_cache.reserve(pCacheSize + 3);
+	_new_cache.reserve(pCacheSize + 3);
+
+	size_t _cursor = 0;
+	const size_t _no_triangle = SIZE_MAX;
+	while (_best_triangle != _no_triangle)
+	{
+		auto _triangle = &pIndices[_best_triangle * 3];
+		_result.insert(_result.end(), _triangle, _triangle + 3);
+		_emitted[_best_triangle] = true;
+
+		_new_cache.clear();
+		for (size_t i = 0; i < 3; ++i)
+		{
+			auto _v = _triangle[i];
+
+			//remove the triangle from live triangles of vertex
+			auto _row = &_adjacency.triangles[_adjacency.offsets[_v]];
+			auto _live = _live_triangles[_v];
+			for (uint32_t j = 0; j < _live; ++j)
+			{
+				if (_row[j] == _best_triangle)
+				{
+					std::swap(_row[j], _row[_live - 1]);
+					break;
+				}
+			}
+			_live_triangles[_v]--;
+
+			if (std::find(_new_cache.begin(), _new_cache.end(), _v) == _new_cache.end())
+			{
+				_new_cache.push_back(_v);
+			}
+		}
+		for (auto _v : _cache)
+		{
+			if (std::find(_new_cache.begin(), _new_cache.end(), _v) == _new_cache.end())
+			{
+				_new_cache.push_back(_v);
+			}
+		}
+
+		//vertices which have been pushed out of cache
+		for (size_t i = pCacheSize; i < _new_cache.size(); ++i)
+		{
+			auto _v = _new_cache[i];
+			_cache_positions[_v] = -1;
+			_vertex_scores[_v] = forsyth_vertex_score(-1, _live_triangles[_v], pCacheSize);
+		}
+		if (_new_cache.size() > pCacheSize)
+		{
+			_new_cache.resize(pCacheSize);
+		}
+		_cache.swap(_new_cache);
+
+		for (size_t i = 0; i < _cache.size(); ++i)
+		{
+			auto _v = _cache[i];
+			_cache_positions[_v] = static_cast<int>(i);
+			_vertex_scores[_v] = forsyth_vertex_score(_cache_positions[_v], _live_triangles[_v], pCacheSize);
+		}
+
+		//only triangles of vertices in cache are candidates for the next triangle
+		_best_triangle = _no_triangle;
+		float _best_score = -1.0f;
+		for (auto _v : _cache)
+		{
+			auto _row = &_adjacency.triangles[_adjacency.offsets[_v]];
+			for (uint32_t j = 0; j < _live_triangles[_v]; ++j)
+			{
+				auto _t = _row[j];
+				auto _tri = &pIndices[_t * 3];
+				_triangle_scores[_t] = _vertex_scores[_tri[0]] + _vertex_scores[_tri[1]] + _vertex_scores[_tri[2]];
+				if (_triangle_scores[_t] > _best_score)
+				{
+					_best_score = _triangle_scores[_t];
+					_best_triangle = _t;
+				}
+			}
+		}
+
+		if (_best_triangle == _no_triangle)
+		{
+			//dead end, continue from the next triangle which has not been emitted yet
+			while (_cursor < _triangles_count && _emitted[_cursor]) _cursor++;
+			if (_cursor < _triangles_count)
+			{
+				_best_triangle = _cursor;
+			}
+		}
+	}
+
+	pIndices.swap(_result);
+	return W_PASSED;
+}
+
+W_RESULT w_mesh_optimizer::optimize_vertex_cache_tipsify(
+	_Inout_ std::vector<uint32_t>& pIndices,
+	_In_ const size_t& pVerticesCount,
+	_In_ const uint32_t& pCacheSize)
+{
+	const std::string _trace_info = "w_mesh_optimizer::optimize_vertex_cache_tipsify";
+
+	if (pIndices.empty()) return W_PASSED;
+	if (pCacheSize < 3)
+	{
+		logger.error("cache size must be at least 3. trace info: " + _trace_info);
+		return W_FAILED;
+	}
+	if (!validate_indices(pIndices, pVerticesCount, _trace_info)) return W_FAILED;
+
+	auto _triangles_count = pIndices.size() / 3;
+
+	w_triangle_adjacency _adjacency;
+	_adjacency.build(pIndices, pVerticesCount);
+
+	std::vector<uint32_t> _live_triangles(pVerticesCount);
+	for (size_t i = 0; i < pVerticesCount; ++i)
+	{
+		_live_triangles[i] = _adjacency.offsets[i + 1] - _adjacency.offsets[i];
+	}
+
+	std::vector<size_t> _time_stamps(pVerticesCount, 0);
+	size_t _time = pCacheSize + 1;
+
+	std::vector<bool> _emitted(_triangles_count, false);
+	std::vector<uint32_t> _dead_end_stack;
+	std::vector<uint32_t> _candidates;
+	std::vector<uint32_t> _result;
+	_result.reserve(pIndices.size());
+
+	//start fanning from the first vertex of the first triangle
+	int64_t _fanning_vertex = pIndices[0];
+	size_t _cursor = 0;
+
+	while (_fanning_vertex >= 0)
+	{
+		auto _f = static_cast<uint32_t>(_fanning_vertex);
+		_candidates.clear();
+
+		//emit all live triangles of fanning vertex
+		for (auto j = _adjacency.offsets[_f]; j < _adjacency.offsets[_f + 1]; ++j)
+		{
+			auto _t = _adjacency.triangles[j];
+			if (_emitted[_t]) continue;
+
+			auto _triangle = &pIndices[_t * 3];
+			for (size_t k = 0; k < 3; ++k)
+			{
+				auto _v = _triangle[k];
+				_dead_end_stack.push_back(_v);
+				_candidates.push_back(_v);
+				_live_triangles[_v]--;
+				if (_time - _time_stamps[_v] > pCacheSize)
+				{
+					_time_stamps[_v] = _time++;
+				}
+			}
+			_result.insert(_result.end(), _triangle, _triangle + 3);
+			_emitted[_t] = true;
+		}
+
+		//select the candidate which will be still in cache after emitting its triangles and is the oldest one
+		_fanning_vertex = -1;
+		int64_t _best_priority = -1;
+		for (auto _v : _candidates)
+		{
+			if (_live_triangles[_v] == 0) continue;
+
+			int64_t _priority = 0;
+			auto _age = static_cast<int64_t>(_time - _time_stamps[_v]);
+			if (_age + 2 * static_cast<int64_t>(_live_triangles[_v]) <= static_cast<int64_t>(pCacheSize))
+			{
+				_priority = _age;
+			}
+			if (_priority > _best_priority)
+			{
+				_best_priority = _priority;
+				_fanning_vertex = _v;
+			}
+		}
+
+		if (_fanning_vertex == -1)
+		{
+			//dead end, try the recent vertices which still have live triangles
+			while (!_dead_end_stack.empty())
+			{
+				auto _v = _dead_end_stack.back();
+				_dead_end_stack.pop_back();
+				if (_live_triangles[_v] > 0)
+				{
+					_fanning_vertex = _v;
+					break;
+				}
+			}
+		}
+		if (_fanning_vertex == -1)
+		{
+			//then continue from the next vertex in input order
+			while (_cursor < pVerticesCount && _live_triangles[_cursor] == 0) _cursor++;
+			if (_cursor < pVerticesCount)
+			{
+				_fanning_vertex = static_cast<int64_t>(_cursor);
+			}
+		}
+	}
+
+	pIndices.swap(_result);
+	return W_PASSED;
+}
+
+W_RESULT w_mesh_optimizer::optimize_overdraw(
+	_Inout_ std::vector<uint32_t>& pIndices,
+	_In_ const std::vector<w_vertex_struct>& pVertices,
+	_In_ const uint32_t& pCacheSize,
+	_In_ const float& pThreshold)
+{
+	const std::string _trace_info = "w_mesh_optimizer::optimize_overdraw";
+
+	if (pIndices.empty()) return W_PASSED;
+	if (pCacheSize < 3)
+	{
+		logger.error("cache size must be at least 3. trace info: " + _trace_info);
+		return W_FAILED;
+	}
+	if (!validate_indices(pIndices, pVertices.size(), _trace_info)) return W_FAILED;
+
+	auto _triangles_count = pIndices.size() / 3;
+	std::vector<size_t> _time_stamps(pVertices.size(), 0);
+	size_t _time = pCacheSize + 1;
+
+	//patches start where all three vertices of a triangle miss the cache, the vertex cache optimizer jumped to a disjoint part of mesh
+	std::vector<size_t> _patches;
+	std::vector<uint32_t> _misses(_triangles_count);
+	for (size_t i = 0; i < _triangles_count; ++i)
+	{
+		_misses[i] = update_fifo_cache(&pIndices[i * 3], pCacheSize, _time_stamps, _time);
+		if (i == 0 || _misses[i] == 3)
+		{
+			_patches.push_back(i);
+		}
+	}
+	_patches.push_back(_triangles_count);
+
+	//split patches into smaller clusters while ACMR of clusters does not exceed threshold times ACMR of patch
+	std::vector<size_t> _clusters;
+	for (size_t p = 0; p + 1 < _patches.size(); ++p)
+	{
+		auto _start = _patches[p];
+		auto _end = _patches[p + 1];
+
+		size_t _patch_misses = 0;
+		for (auto i = _start; i < _end; ++i)
+		{
+			_patch_misses += _misses[i];
+		}
+		auto _patch_threshold = pThreshold * static_cast<float>(_patch_misses) / static_cast<float>(_end - _start);
+
+		//simulate each cluster with an empty cache
+		_time += pCacheSize + 1;
+		_clusters.push_back(_start);
+
+		size_t _cluster_misses = 0, _cluster_triangles = 0;
+		for (auto i = _start; i < _end; ++i)
+		{
+			_cluster_misses += update_fifo_cache(&pIndices[i * 3], pCacheSize, _time_stamps, _time);
+			_cluster_triangles++;
+
+			if (i + 1 < _end && static_cast<float>(_cluster_misses) / static_cast<float>(_cluster_triangles) <= _patch_threshold)
+			{
+				_clusters.push_back(i + 1);
+				_cluster_misses = 0;
+				_cluster_triangles = 0;
+				_time += pCacheSize + 1;
+			}
+		}
+	}
+	auto _clusters_count = _clusters.size();
+	_clusters.push_back(_triangles_count);
+
+	//centroid of mesh
+	double _mesh_centroid[3] = { 0.0, 0.0, 0.0 };
+	for (auto _index : pIndices)
+	{
+		const auto& _p = pVertices[_index].position;
+		_mesh_centroid[0] += _p[0];
+		_mesh_centroid[1] += _p[1];
+		_mesh_centroid[2] += _p[2];
+	}
+	for (size_t i = 0; i < 3; ++i)
+	{
+		_mesh_centroid[i] /= static_cast<double>(pIndices.size());
+	}
+
+	//clusters which face outward of mesh are more likely to occlude the others
+	std::vector<float> _sort_keys(_clusters_count);
+	for (size_t c = 0; c < _clusters_count; ++c)
+	{
+		double _centroid[3] = { 0.0, 0.0, 0.0 };
+		double _normal[3] = { 0.0, 0.0, 0.0 };
+		double _area = 0.0;
+
+		for (auto i = _clusters[c]; i < _clusters[c + 1]; ++i)
+		{
+			const auto& _p0 = pVertices[pIndices[i * 3 + 0]].position;
+			const auto& _p1 = pVertices[pIndices[i * 3 + 1]].position;
+			const auto& _p2 = pVertices[pIndices[i * 3 + 2]].position;
+
+			double _e1[3] = { _p1[0] - _p0[0], _p1[1] - _p0[1], _p1[2] - _p0[2] };
+			double _e2[3] = { _p2[0] - _p0[0], _p2[1] - _p0[1], _p2[2] - _p0[2] };
+			double _n[3] =
+			{
+				_e1[1] * _e2[2] - _e1[2] * _e2[1],
+				_e1[2] * _e2[0] - _e1[0] * _e2[2],
+				_e1[0] * _e2[1] - _e1[1] * _e2[0]
+			};
+			auto _triangle_area = std::sqrt(_n[0] * _n[0] + _n[1] * _n[1] + _n[2] * _n[2]);
+
+			for (size_t k = 0; k < 3; ++k)
+			{
+				_centroid[k] += (_p0[k] + _p1[k] + _p2[k]) / 3.0 * _triangle_area;
+				_normal[k] += _n[k];
+			}
+			_area += _triangle_area;
+		}
+
+		auto _normal_length = std::sqrt(_normal[0] * _normal[0] + _normal[1] * _normal[1] + _normal[2] * _normal[2]);
+		if (_area <= 0.0 || _normal_length <= 0.0)
+		{
+			_sort_keys[c] = 0.0f;
+			continue;
+		}
+
+		double _key = 0.0;
+		for (size_t k = 0; k < 3; ++k)
+		{
+			_key += (_centroid[k] / _area - _mesh_centroid[k]) * (_normal[k] / _normal_length);
+		}
+		_sort_keys[c] = static_cast<float>(_key);
+	}
+
+	std::vector<size_t> _order(_clusters_count);
+	for (size_t c = 0; c < _clusters_count; ++c) _order[c] = c;
+	std::stable_sort(_order.begin(), _order.end(), [&_sort_keys](_In_ const size_t& pA, _In_ const size_t& pB)
+	{
+		return _sort_keys[pA] > _sort_keys[pB];
+	});
+
+	std::vector<uint32_t> _result;
+	_result.reserve(pIndices.size());
+	for (auto c : _order)
+	{
+		_result.insert(_result.end(), pIndices.begin() + _clusters[c] * 3, pIndices.begin() + _clusters[c + 1] * 3);
+	}
+
+	pIndices.swap(_result);
+	return W_PASSED;
+}
+
+W_RESULT w_mesh_optimizer::optimize_vertex_fetch(
+	_Inout_ std::vector<w_vertex_struct>& pVertices,
+	_Inout_ std::vector<uint32_t>& pIndices)
+{
+	const std::string _trace_info = "w_mesh_optimizer::optimize_vertex_fetch";
+
+	if (pVertices.empty() || pIndices.empty()) return W_PASSED;
+	if (!validate_indices(pIndices, pVertices.size(), _trace_info)) return W_FAILED;
+
+	std::vector<uint32_t> _remap(pVertices.size(), UINT32_MAX);
+	std::vector<w_vertex_struct> _vertices;
+	_vertices.reserve(pVertices.size());
+
+	for (auto& _index : pIndices)
+	{
+		auto& _new_index = _remap[_index];
+		if (_new_index == UINT32_MAX)
+		{
+			_new_index = static_cast<uint32_t>(_vertices.size());
+			_vertices.push_back(pVertices[_index]);
+			_vertices.back().vertex_index = _new_index + 1;
+		}
+		_index = _new_index;
+	}
+
+	pVertices.swap(_vertices);
+	return W_PASSED;
+}
+
+W_RESULT w_mesh_optimizer::weld_vertices(
+	_Inout_ std::vector<w_vertex_struct>& pVertices,
+	_Inout_ std::vector<uint32_t>& pIndices,
+	_In_ const w_vertex_welding_configs& pConfigs)
+{
+	const std::string _trace_info = "w_mesh_optimizer::weld_vertices";
+
+	if (pVertices.empty() || pIndices.empty()) return W_PASSED;
+
+	auto _vertices_count = pVertices.size();
+	if (!validate_indices(pIndices, _vertices_count, _trace_info)) return W_FAILED;
+
+	const float _inv_pos_eps = pConfigs.position_epsilon > 0.0f ? 1.0f / pConfigs.position_epsilon : 0.0f;
+	const float _inv_nor_eps = pConfigs.normal_epsilon > 0.0f ? 1.0f / pConfigs.normal_epsilon : 0.0f;
+	const float _inv_uv_eps = pConfigs.uv_epsilon > 0.0f ? 1.0f / pConfigs.uv_epsilon : 0.0f;
+
+	std::unordered_map<w_welding_key, uint32_t, w_welding_key_hasher> _unique_vertices;
+	_unique_vertices.reserve(_vertices_count);
+
+	//old index to new index, UINT32_MAX means not visited yet
+	std::vector<uint32_t> _remap(_vertices_count, UINT32_MAX);
+	std::vector<w_vertex_struct> _welded_vertices;
+	_welded_vertices.reserve(_vertices_count);
+
+	w_welding_key _key;
+	for (auto& _index : pIndices)
+	{
+		auto& _new_index = _remap[_index];
+		if (_new_index == UINT32_MAX)
+		{
+			const auto& _vertex = pVertices[_index];
+
+			std::memset(&_key, 0, sizeof(_key));
+			_key.attributes[0] = quantize(_vertex.position[0], _inv_pos_eps);
+			_key.attributes[1] = quantize(_vertex.position[1], _inv_pos_eps);
+			_key.attributes[2] = quantize(_vertex.position[2], _inv_pos_eps);
+			_key.attributes[3] = quantize(_vertex.normal[0], _inv_nor_eps);
+			_key.attributes[4] = quantize(_vertex.normal[1], _inv_nor_eps);
+			_key.attributes[5] = quantize(_vertex.normal[2], _inv_nor_eps);
+			_key.attributes[6] = quantize(_vertex.uv[0], _inv_uv_eps);
+			_key.attributes[7] = quantize(_vertex.uv[1], _inv_uv_eps);
+			std::memcpy(&_key.blend_weight[0], &_vertex.blend_weight[0], sizeof(_key.blend_weight));
+			std::memcpy(&_key.blend_indices[0], &_vertex.blend_indices[0], sizeof(_key.blend_indices));
+
+			auto _iter = _unique_vertices.find(_key);
+			if (_iter == _unique_vertices.end())
+			{
+				//vertices are stored in order of first use, which is also a good order for vertex fetch
+				_new_index = static_cast<uint32_t>(_welded_vertices.size());
+				_unique_vertices.insert({ _key, _new_index });
+
+				_welded_vertices.push_back(_vertex);
+				_welded_vertices.back().vertex_index = _new_index + 1;
+			}
+			else
+			{
+				_new_index = _iter->second;
+			}
+		}
+		_index = _new_index;
+	}
+
+	pVertices.swap(_welded_vertices);
+	_welded_vertices.clear();
+
+	return W_PASSED;
+}
+
+float w_mesh_optimizer::compute_acmr(
+	_In_ const std::vector<uint32_t>& pIndices,
+	_In_ const size_t& pVerticesCount,
+	_In_ const uint32_t& pCacheSize)
+{
+	auto _triangles_count = pIndices.size() / 3;
+	if (_triangles_count == 0 || pCacheSize == 0) return 0.0f;
+	if (!validate_indices(pIndices, pVerticesCount, "w_mesh_optimizer::compute_acmr")) return 0.0f;
+
+	auto _misses = simulate_fifo_cache(pIndices, pVerticesCount, pCacheSize);
+	return static_cast<float>(_misses) / static_cast<float>(_triangles_count);
+}
+
+float w_mesh_optimizer::compute_atvr(
+	_In_ const std::vector<uint32_t>& pIndices,
+	_In_ const size_t& pVerticesCount,
+	_In_ const uint32_t& pCacheSize)
+{
+	if (pIndices.size() < 3 || pCacheSize == 0) return 0.0f;
+	if (!validate_indices(pIndices, pVerticesCount, "w_mesh_optimizer::compute_atvr")) return 0.0f;
+
+	std::vector<bool> _referenced(pVerticesCount, false);
+	size_t _referenced_count = 0;
+	for (auto _index : pIndices)
+	{
+		if (!_referenced[_index])
+		{
+			_referenced[_index] = true;
+			_referenced_count++;
+		}
+	}
+
+	auto _misses = simulate_fifo_cache(pIndices, pVerticesCount, pCacheSize);
+	return static_cast<float>(_misses) / static_cast<float>(_referenced_count);
+}
@@ -0,0 +1,171 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_mesh_optimizer.h
+	Description		 : Portable mesh optimizations of content pipeline
+	Comment          : Welding compares quantized attributes, so two vertices will be welded when position, normal and uv
+					   of them fall in the same cell of size epsilon.
+					   Vertex cache optimizers are Tom Forsyth's "Linear-Speed Vertex Cache Optimisation" and Tipsify from
+					   "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" of Sander, Nehab and Barczak,
+					   overdraw optimizer is the cluster sorting of the same paper
+*/
+
+#ifndef __W_MESH_OPTIMIZER_H__
+#define __W_MESH_OPTIMIZER_H__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "w_cpipeline_export.h"
+#include <w_std.h>
+#include "w_vertex_struct.h"
+
+namespace wolf
+{
+	namespace content_pipeline
+	{
+		struct w_vertex_welding_configs
+		{
+			//enable welding vertices with same attributes
+			bool		enable = true;
+			//epsilon of positions, zero means positions must be exactly equal
+			float		position_epsilon = 0.00001f;
+			//epsilon of normals, zero means normals must be exactly equal
+			float		normal_epsilon = 0.001f;
+			//epsilon of texture coordinates, zero means uvs must be exactly equal
+			float		uv_epsilon = 0.00001f;
+		};
+
+		enum w_vertex_cache_optimizer : uint8_t
+		{
+			//do not reorder triangles
+			NO_VERTEX_CACHE_OPTIMIZING = 0,
+			//score based greedy reordering of Tom Forsyth
+			FORSYTH_VERTEX_CACHE_OPTIMIZING,
+			//fan based reordering of Tipsify, faster than Forsyth
+			TIPSIFY_VERTEX_CACHE_OPTIMIZING
+		};
+
+		struct w_mesh_optimizer_configs
+		{
+			//algorithm of vertex cache optimization, NO_VERTEX_CACHE_OPTIMIZING disables the portable optimizer
+			w_vertex_cache_optimizer	vertex_cache_optimizer = NO_VERTEX_CACHE_OPTIMIZING;
+			//size of post transform vertex cache
+			uint32_t					cache_size = 16;
+			//sort clusters of triangles from outside to inside for reducing overdraw
+			bool						optimize_overdraw = true;
+			//a cluster will be split once its ACMR reaches this threshold times ACMR of the whole patch, bigger values make more clusters
+			float						overdraw_threshold = 1.05f;
+			//reorder vertices in order of first use by indices
+			bool						optimize_vertex_fetch = true;
+		};
+
+		class w_mesh_optimizer
+		{
+		public:
+			/*
+				run the vertex cache, overdraw and vertex fetch optimizers based on configs
+				@param pVertices, vertices of mesh, will be reordered if vertex fetch optimizing was enabled
+				@param pIndices, indices of triangle list
+				@param pConfigs, configs of optimizer
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT optimize(
+				_Inout_ std::vector<w_vertex_struct>& pVertices,
+				_Inout_ std::vector<uint32_t>& pIndices,
+				_In_ const w_mesh_optimizer_configs& pConfigs);
+
+			/*
+				reorder triangles for post transform vertex cache with Tom Forsyth's algorithm
+				@param pIndices, indices of triangle list
+				@param pVerticesCount, number of vertices
+				@param pCacheSize, size of modeled LRU cache
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT optimize_vertex_cache_forsyth(
+				_Inout_ std::vector<uint32_t>& pIndices,
+				_In_ const size_t& pVerticesCount,
+				_In_ const uint32_t& pCacheSize = 32);
+
+			/*
+				reorder triangles for post transform vertex cache with Tipsify
+				@param pIndices, indices of triangle list
+				@param pVerticesCount, number of vertices
+				@param pCacheSize, size of FIFO cache
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT optimize_vertex_cache_tipsify(
+				_Inout_ std::vector<uint32_t>& pIndices,
+				_In_ const size_t& pVerticesCount,
+				_In_ const uint32_t& pCacheSize = 16);
+
+			/*
+				split vertex cache optimized triangles into clusters and sort them from outside to inside of mesh,
+				so the triangles which might occlude others will be drawn first
+				@param pIndices, indices of triangle list which have been optimized for vertex cache
+				@param pVertices, vertices of mesh
+				@param pCacheSize, size of FIFO cache
+				@param pThreshold, maximum allowed ACMR of clusters relative to ACMR of their patch
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT optimize_overdraw(
+				_Inout_ std::vector<uint32_t>& pIndices,
+				_In_ const std::vector<w_vertex_struct>& pVertices,
+				_In_ const uint32_t& pCacheSize = 16,
+				_In_ const float& pThreshold = 1.05f);
+
+			/*
+				reorder vertices in order of first use and remap indices, unused vertices will be removed.
+				vertex_index of each output vertex will be its new index plus one
+				@param pVertices, vertices of mesh
+				@param pIndices, indices of mesh
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT optimize_vertex_fetch(
+				_Inout_ std::vector<w_vertex_struct>& pVertices,
+				_Inout_ std::vector<uint32_t>& pIndices);
+
+			/*
+				weld vertices which have same position, normal, uv, blend weights and blend indices,
+				the first vertex of each group will be kept and indices will be remapped to it.
+				vertex_index of each output vertex will be its new index plus one
+				@param pVertices, vertices of mesh which will be replaced by welded vertices
+				@param pIndices, indices of mesh which will be remapped to welded vertices
+				@param pConfigs, epsilons of welding
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT weld_vertices(
+				_Inout_ std::vector<w_vertex_struct>& pVertices,
+				_Inout_ std::vector<uint32_t>& pIndices,
+				_In_ const w_vertex_welding_configs& pConfigs);
+
+			/*
+				compute average cache miss ratio (number of transformed vertices per triangle) of a triangle list with a FIFO cache
+				@param pIndices, indices of triangle list
+				@param pVerticesCount, number of vertices
+				@param pCacheSize, size of post transform vertex cache
+				@return ACMR, 3.0 is the worst case and 0.5 is the best case for a regular grid
+			*/
+			WCP_EXP static float compute_acmr(
+				_In_ const std::vector<uint32_t>& pIndices,
+				_In_ const size_t& pVerticesCount,
+				_In_ const uint32_t& pCacheSize = 16);
+
+			/*
+				compute average transform to vertex ratio (number of transformed vertices per referenced vertex) of a triangle list with a FIFO cache
+				@param pIndices, indices of triangle list
+				@param pVerticesCount, number of vertices
+				@param pCacheSize, size of post transform vertex cache
+				@return ATVR, 1.0 is the best case
+			*/
+			WCP_EXP static float compute_atvr(
+				_In_ const std::vector<uint32_t>& pIndices,
+				_In_ const size_t& pVerticesCount,
+				_In_ const uint32_t& pCacheSize = 16);
+		};
+	}
+}
+
+#endif
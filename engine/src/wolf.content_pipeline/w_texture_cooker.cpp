@@ -0,0 +1,1217 @@
+#include "w_cpipeline_pch.h"
+#include "w_texture_cooker.h"
+#include <w_convert.h>
+#include <w_job_system.h>
+#include <gli/gli.hpp>
+#include <algorithm>
+#include <chrono>
+
+//wolf.render has its own copy of stb_image, keep this one private to content pipeline
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+namespace
+{
+	typedef std::chrono::steady_clock w_clock;
+
+	static double elapsed_ms(_In_ const w_clock::time_point& pStart)
+	{
+		return std::chrono::duration<double, std::milli>(w_clock::now() - pStart).count();
+	}
+
+	//linear rgba pixels of one level
+	struct w_float_image
+	{
+		uint32_t			width = 0;
+		uint32_t			height = 0;
+		std::vector<float>	pixels;
+	};
+
+	static const float* srgb_to_linear_table()
+	{
+		//initialization of local statics is thread safe, textures are cooked in parallel
+		static const std::vector<float> _table = []()
+		{
+			std::vector<float> _values(256);
+			for (int i = 0; i < 256; ++i)
+			{
+				auto _c = static_cast<float>(i) / 255.0f;
+				_values[i] = _c <= 0.04045f ? _c / 12.92f : std::pow((_c + 0.055f) / 1.055f, 2.4f);
+			}
+			return _values;
+		}();
+		return _table.data();
+	}
+
+	static float linear_to_srgb(_In_ const float& pValue)
+	{
+		if (pValue <= 0.0031308f) return std::max(pValue, 0.0f) * 12.92f;
+		return 1.055f * std::pow(std::min(pValue, 1.0f), 1.0f / 2.4f) - 0.055f;
+	}
+
+	static uint8_t to_unorm8(_In_ const float& pValue)
+	{
+		auto _v = std::min(std::max(pValue, 0.0f), 1.0f);
+		return static_cast<uint8_t>(_v * 255.0f + 0.5f);
+	}
+
+	static void to_float_image(
+		_In_ const uint8_t* pRGBA,
+		_In_ const uint32_t& pWidth,
+		_In_ const uint32_t& pHeight,
+		_In_ const bool& pSRGB,
+		_In_ w_job_system& pJobSystem,
+		_Inout_ w_float_image& pImage)
+	{
+		auto _srgb_table = srgb_to_linear_table();
+
+		pImage.width = pWidth;
+		pImage.height = pHeight;
+		pImage.pixels.resize(static_cast<size_t>(pWidth) * pHeight * 4);
+		pJobSystem.parallel_for(pHeight, 0, [&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+		{
+			for (size_t i = pBegin * pWidth * 4; i < pEnd * pWidth * 4; i += 4)
+			{
+				for (size_t c = 0; c < 3; ++c)
+				{
+					pImage.pixels[i + c] = pSRGB ? _srgb_table[pRGBA[i + c]] : static_cast<float>(pRGBA[i + c]) / 255.0f;
+				}
+				pImage.pixels[i + 3] = static_cast<float>(pRGBA[i + 3]) / 255.0f;
+			}
+		});
+	}
+
+	//filter 4 taps of [1 3 3 1] kernel around the pair of source texels, clamp to edges
+	static void downsample(
+		_In_ const w_float_image& pSource,
+		_In_ w_job_system& pJobSystem,
+		_Inout_ w_float_image& pDestination)
+	{
+		const float _kernel[4] = { 1.0f / 8.0f, 3.0f / 8.0f, 3.0f / 8.0f, 1.0f / 8.0f };
+
+		auto _sw = pSource.width;
+		auto _sh = pSource.height;
+		auto _dw = std::max(1u, _sw / 2);
+		auto _dh = std::max(1u, _sh / 2);
+
+		//horizontal pass
+		std::vector<float> _temp(static_cast<size_t>(_dw) * _sh * 4);
+		pJobSystem.parallel_for(_sh, 0, [&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+		{
+			for (size_t y = pBegin; y < pEnd; ++y)
+			{
+				auto _src_row = &pSource.pixels[y * _sw * 4];
+				auto _dst_row = &_temp[y * _dw * 4];
+				for (uint32_t x = 0; x < _dw; ++x)
+				{
+					float _sum[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+					for (int k = 0; k < 4; ++k)
+					{
+						auto _sx = _sw == 1 ? 0 : std::min(std::max(static_cast<int>(2 * x) - 1 + k, 0), static_cast<int>(_sw) - 1);
+						auto _texel = &_src_row[_sx * 4];
+						for (int c = 0; c < 4; ++c) _sum[c] += _kernel[k] * _texel[c];
+					}
+					std::memcpy(&_dst_row[x * 4], _sum, sizeof(_sum));
+				}
+			}
+		});
+
+		//vertical pass
+		pDestination.width = _dw;
+		pDestination.height = _dh;
+		pDestination.pixels.resize(static_cast<size_t>(_dw) * _dh * 4);
+		pJobSystem.parallel_for(_dh, 0, [&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+		{
+			for (size_t y = pBegin; y < pEnd; ++y)
+			{
+				auto _dst_row = &pDestination.pixels[y * _dw * 4];
+				std::fill(_dst_row, _dst_row + _dw * 4, 0.0f);
+				for (int k = 0; k < 4; ++k)
+				{
+					auto _sy = _sh == 1 ? 0 : std::min(std::max(static_cast<int>(2 * y) - 1 + k, 0), static_cast<int>(_sh) - 1);
+					auto _src_row = &_temp[_sy * _dw * 4];
+					for (size_t i = 0; i < _dw * 4; ++i)
+					{
+						_dst_row[i] += _kernel[k] * _src_row[i];
+					}
+				}
+			}
+		});
+	}
+
+	static float alpha_coverage(
+		_In_ const w_float_image& pImage,
+		_In_ const float& pReference,
+		_In_ const float& pScale)
+	{
+		size_t _covered = 0;
+		auto _count = pImage.pixels.size() / 4;
+		for (size_t i = 0; i < _count; ++i)
+		{
+			if (pImage.pixels[i * 4 + 3] * pScale > pReference) _covered++;
+		}
+		return static_cast<float>(_covered) / static_cast<float>(_count);
+	}
+
+	//find the scale of alpha which gives the same coverage as the first level
+	static float find_alpha_scale(
+		_In_ const w_float_image& pImage,
+		_In_ const float& pReference,
+		_In_ const float& pCoverage)
+	{
+		float _min = 0.0f;
+		float _max = 4.0f;
+		float _scale = 1.0f;
+		for (int i = 0; i < 16; ++i)
+		{
+			auto _coverage = alpha_coverage(pImage, pReference, _scale);
+			if (_coverage < pCoverage)
+			{
+				_min = _scale;
+			}
+			else if (_coverage > pCoverage)
+			{
+				_max = _scale;
+			}
+			else
+			{
+				break;
+			}
+			_scale = 0.5f * (_min + _max);
+		}
+		return _scale;
+	}
+
+	static void to_rgba8(
+		_In_ const w_float_image& pImage,
+		_In_ const bool& pSRGB,
+		_In_ const bool& pNormalMap,
+		_In_ const float& pAlphaScale,
+		_In_ w_job_system& pJobSystem,
+		_Inout_ std::vector<uint8_t>& pRGBA)
+	{
+		pRGBA.resize(pImage.pixels.size());
+		pJobSystem.parallel_for(pImage.height, 0, [&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+		{
+			for (size_t i = pBegin * pImage.width * 4; i < pEnd * pImage.width * 4; i += 4)
+			{
+				auto _texel = &pImage.pixels[i];
+				if (pNormalMap)
+				{
+					//filtering shortens normals
+					auto _normal = glm::vec3(_texel[0], _texel[1], _texel[2]) * 2.0f - 1.0f;
+					auto _length = glm::length(_normal);
+					_normal = _length > 0.0f ? _normal / _length : glm::vec3(0.0f, 0.0f, 1.0f);
+					for (int c = 0; c < 3; ++c) pRGBA[i + c] = to_unorm8(_normal[c] * 0.5f + 0.5f);
+				}
+				else
+				{
+					for (int c = 0; c < 3; ++c) pRGBA[i + c] = to_unorm8(pSRGB ? linear_to_srgb(_texel[c]) : _texel[c]);
+				}
+				pRGBA[i + 3] = to_unorm8(_texel[3] * pAlphaScale);
+			}
+		});
+	}
+
+#pragma region block encoders
+
+	static void load_block(
+		_In_ const uint8_t* pRGBA,
+		_In_ const uint32_t& pWidth,
+		_In_ const uint32_t& pHeight,
+		_In_ const uint32_t& pBlockX,
+		_In_ const uint32_t& pBlockY,
+		_Out_ uint8_t pBlock[16][4])
+	{
+		for (uint32_t y = 0; y < 4; ++y)
+		{
+			auto _y = std::min(pBlockY * 4 + y, pHeight - 1);
+			for (uint32_t x = 0; x < 4; ++x)
+			{
+				auto _x = std::min(pBlockX * 4 + x, pWidth - 1);
+				std::memcpy(pBlock[y * 4 + x], &pRGBA[(static_cast<size_t>(_y) * pWidth + _x) * 4], 4);
+			}
+		}
+	}
+
+	//principal axis of pixels with power iteration over covariance
+	template<int N>
+	static void principal_axis(
+		_In_ const float pPoints[16][4],
+		_In_ const bool pUsed[16],
+		_Out_ float pMean[4],
+		_Out_ float pAxis[4])
+	{
+		int _count = 0;
+		for (int c = 0; c < 4; ++c) pMean[c] = 0.0f;
+		for (int i = 0; i < 16; ++i)
+		{
+			if (!pUsed[i]) continue;
+			for (int c = 0; c < N; ++c) pMean[c] += pPoints[i][c];
+			_count++;
+		}
+		for (int c = 0; c < N; ++c) pMean[c] /= static_cast<float>(std::max(_count, 1));
+
+		float _cov[4][4] = {};
+		for (int i = 0; i < 16; ++i)
+		{
+			if (!pUsed[i]) continue;
+			float _d[4];
+			for (int c = 0; c < N; ++c) _d[c] = pPoints[i][c] - pMean[c];
+			for (int r = 0; r < N; ++r)
+			{
+				for (int c = 0; c < N; ++c) _cov[r][c] += _d[r] * _d[c];
+			}
+		}
+
+		//start from the channel with the largest variance, diagonal of bounding box may be orthogonal to the axis
+		int _largest = 0;
+		for (int c = 1; c < N; ++c)
+		{
+			if (_cov[c][c] > _cov[_largest][_largest]) _largest = c;
+		}
+		for (int c = 0; c < 4; ++c) pAxis[c] = c < N ? _cov[_largest][c] : 0.0f;
+		for (int k = 0; k < 8; ++k)
+		{
+			float _next[4] = {};
+			for (int r = 0; r < N; ++r)
+			{
+				for (int c = 0; c < N; ++c) _next[r] += _cov[r][c] * pAxis[c];
+			}
+			float _length = 0.0f;
+			for (int c = 0; c < N; ++c) _length += _next[c] * _next[c];
+			if (_length < 1e-12f) break;
+			_length = 1.0f / std::sqrt(_length);
+			for (int c = 0; c < N; ++c) pAxis[c] = _next[c] * _length;
+		}
+	}
+
+	static uint16_t pack_565(_In_ const float pColor[3])
+	{
+		auto _r = static_cast<uint16_t>(std::min(std::max(pColor[0], 0.0f), 255.0f) * 31.0f / 255.0f + 0.5f);
+		auto _g = static_cast<uint16_t>(std::min(std::max(pColor[1], 0.0f), 255.0f) * 63.0f / 255.0f + 0.5f);
+		auto _b = static_cast<uint16_t>(std::min(std::max(pColor[2], 0.0f), 255.0f) * 31.0f / 255.0f + 0.5f);
+		return static_cast<uint16_t>((_r << 11) | (_g << 5) | _b);
+	}
+
+	static void unpack_565(_In_ const uint16_t& pColor, _Out_ int pRGB[3])
+	{
+		auto _r = (pColor >> 11) & 31;
+		auto _g = (pColor >> 5) & 63;
+		auto _b = pColor & 31;
+		pRGB[0] = (_r << 3) | (_r >> 2);
+		pRGB[1] = (_g << 2) | (_g >> 4);
+		pRGB[2] = (_b << 3) | (_b >> 2);
+	}
+
+	//color blocks of BC2 and BC3 always have four colors
+	static void bc1_palette(
+		_In_ const uint16_t& pC0,
+		_In_ const uint16_t& pC1,
+		_In_ const bool& pAlwaysFourColors,
+		_Out_ int pPalette[4][4])
+	{
+		auto _four_colors = pAlwaysFourColors || pC0 > pC1;
+		unpack_565(pC0, pPalette[0]);
+		unpack_565(pC1, pPalette[1]);
+		pPalette[0][3] = pPalette[1][3] = 255;
+		for (int c = 0; c < 3; ++c)
+		{
+			if (_four_colors)
+			{
+				pPalette[2][c] = (2 * pPalette[0][c] + pPalette[1][c]) / 3;
+				pPalette[3][c] = (pPalette[0][c] + 2 * pPalette[1][c]) / 3;
+			}
+			else
+			{
+				pPalette[2][c] = (pPalette[0][c] + pPalette[1][c]) / 2;
+				pPalette[3][c] = 0;
+			}
+		}
+		pPalette[2][3] = 255;
+		pPalette[3][3] = _four_colors ? 255 : 0;
+	}
+
+	//returns squared error of block, transparent pixels of punch through mode always take index 3
+	static uint32_t bc1_indices(
+		_In_ const uint8_t pBlock[16][4],
+		_In_ const uint16_t& pC0,
+		_In_ const uint16_t& pC1,
+		_In_ const bool pTransparent[16],
+		_Out_ uint32_t& pIndices)
+	{
+		int _palette[4][4];
+		bc1_palette(pC0, pC1, false, _palette);
+		auto _colors = pC0 > pC1 ? 4 : 3;
+
+		uint32_t _error = 0;
+		pIndices = 0;
+		for (int i = 0; i < 16; ++i)
+		{
+			uint32_t _best = 3;
+			uint32_t _best_error = 0;
+			if (!pTransparent[i])
+			{
+				_best_error = UINT32_MAX;
+				for (int j = 0; j < _colors; ++j)
+				{
+					uint32_t _e = 0;
+					for (int c = 0; c < 3; ++c)
+					{
+						auto _d = static_cast<int>(pBlock[i][c]) - _palette[j][c];
+						_e += static_cast<uint32_t>(_d * _d);
+					}
+					if (_e < _best_error)
+					{
+						_best_error = _e;
+						_best = static_cast<uint32_t>(j);
+					}
+				}
+			}
+			_error += _best_error;
+			pIndices |= _best << (i * 2);
+		}
+		return _error;
+	}
+
+	//solve endpoints which minimize error of the given weights with least squares
+	template<int N>
+	static bool least_squares_endpoints(
+		_In_ const float pPoints[16][4],
+		_In_ const bool pUsed[16],
+		_In_ const float pWeights[16],
+		_Out_ float pE0[4],
+		_Out_ float pE1[4])
+	{
+		float _aa = 0.0f, _bb = 0.0f, _ab = 0.0f;
+		float _ax[4] = {}, _bx[4] = {};
+		for (int i = 0; i < 16; ++i)
+		{
+			if (!pUsed[i]) continue;
+			auto _b = pWeights[i];
+			auto _a = 1.0f - _b;
+			_aa += _a * _a;
+			_bb += _b * _b;
+			_ab += _a * _b;
+			for (int c = 0; c < N; ++c)
+			{
+				_ax[c] += _a * pPoints[i][c];
+				_bx[c] += _b * pPoints[i][c];
+			}
+		}
+		auto _det = _aa * _bb - _ab * _ab;
+		if (std::fabs(_det) < 1e-6f) return false;
+		auto _inv = 1.0f / _det;
+		for (int c = 0; c < N; ++c)
+		{
+			pE0[c] = (_ax[c] * _bb - _bx[c] * _ab) * _inv;
+			pE1[c] = (_bx[c] * _aa - _ax[c] * _ab) * _inv;
+		}
+		return true;
+	}
+
+	static void encode_bc1_block(
+		_In_ const uint8_t pBlock[16][4],
+		_In_ const bool& pAllowPunchThrough,
+		_Out_ uint8_t* pOut)
+	{
+		float _points[16][4];
+		bool _used[16];
+		bool _transparent[16];
+		auto _punch_through = false;
+		for (int i = 0; i < 16; ++i)
+		{
+			for (int c = 0; c < 4; ++c) _points[i][c] = static_cast<float>(pBlock[i][c]);
+			_transparent[i] = pAllowPunchThrough && pBlock[i][3] < 128;
+			_used[i] = !_transparent[i];
+			_punch_through |= _transparent[i];
+		}
+
+		uint16_t _c0 = 0, _c1 = 0;
+		uint32_t _indices = 0xFFFFFFFF;
+		auto _all_transparent = std::none_of(_used, _used + 16, [](bool pUsed) { return pUsed; });
+		if (!_all_transparent)
+		{
+			float _mean[4], _axis[4];
+			principal_axis<3>(_points, _used, _mean, _axis);
+
+			float _min_t = FLT_MAX, _max_t = -FLT_MAX;
+			for (int i = 0; i < 16; ++i)
+			{
+				if (!_used[i]) continue;
+				float _t = 0.0f;
+				for (int c = 0; c < 3; ++c) _t += (_points[i][c] - _mean[c]) * _axis[c];
+				_min_t = std::min(_min_t, _t);
+				_max_t = std::max(_max_t, _t);
+			}
+			float _e0[4], _e1[4];
+			for (int c = 0; c < 3; ++c)
+			{
+				_e0[c] = _mean[c] + _axis[c] * _max_t;
+				_e1[c] = _mean[c] + _axis[c] * _min_t;
+			}
+
+			//four colors need c0 > c1, punch through needs c0 <= c1
+			auto _order = [&](uint16_t& pA, uint16_t& pB)
+			{
+				if (_punch_through ? pA > pB : pA < pB) std::swap(pA, pB);
+			};
+
+			_c0 = pack_565(_e0);
+			_c1 = pack_565(_e1);
+			_order(_c0, _c1);
+			auto _error = bc1_indices(pBlock, _c0, _c1, _transparent, _indices);
+
+			//refine endpoints once with least squares of the chosen indices
+			const float _weights_4[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+			const float _weights_3[4] = { 0.0f, 1.0f, 0.5f, 0.0f };
+			float _weights[16];
+			for (int i = 0; i < 16; ++i)
+			{
+				auto _index = (_indices >> (i * 2)) & 3;
+				_weights[i] = _c0 > _c1 ? _weights_4[_index] : _weights_3[_index];
+			}
+			if (_error > 0 && least_squares_endpoints<3>(_points, _used, _weights, _e0, _e1))
+			{
+				auto _r0 = pack_565(_e0);
+				auto _r1 = pack_565(_e1);
+				_order(_r0, _r1);
+				uint32_t _refined_indices = 0;
+				if (bc1_indices(pBlock, _r0, _r1, _transparent, _refined_indices) < _error)
+				{
+					_c0 = _r0;
+					_c1 = _r1;
+					_indices = _refined_indices;
+				}
+			}
+
+			//equal endpoints fall into three colors mode, index 3 would be black
+			if (_c0 == _c1 && !_punch_through) _indices = 0;
+		}
+
+		pOut[0] = static_cast<uint8_t>(_c0 & 0xFF);
+		pOut[1] = static_cast<uint8_t>(_c0 >> 8);
+		pOut[2] = static_cast<uint8_t>(_c1 & 0xFF);
+		pOut[3] = static_cast<uint8_t>(_c1 >> 8);
+		std::memcpy(pOut + 4, &_indices, 4);
+	}
+
+	static void bc4_palette(_In_ const int& pR0, _In_ const int& pR1, _Out_ int pPalette[8])
+	{
+		pPalette[0] = pR0;
+		pPalette[1] = pR1;
+		if (pR0 > pR1)
+		{
+			for (int i = 2; i < 8; ++i) pPalette[i] = ((8 - i) * pR0 + (i - 1) * pR1) / 7;
+		}
+		else
+		{
+			for (int i = 2; i < 6; ++i) pPalette[i] = ((6 - i) * pR0 + (i - 1) * pR1) / 5;
+			pPalette[6] = 0;
+			pPalette[7] = 255;
+		}
+	}
+
+	static void encode_bc4_block(
+		_In_ const uint8_t pBlock[16][4],
+		_In_ const int& pChannel,
+		_Out_ uint8_t* pOut)
+	{
+		int _min = 255, _max = 0;
+		for (int i = 0; i < 16; ++i)
+		{
+			_min = std::min(_min, static_cast<int>(pBlock[i][pChannel]));
+			_max = std::max(_max, static_cast<int>(pBlock[i][pChannel]));
+		}
+
+		int _palette[8];
+		bc4_palette(_max, _min, _palette);
+
+		uint64_t _indices = 0;
+		for (int i = 0; i < 16; ++i)
+		{
+			auto _value = static_cast<int>(pBlock[i][pChannel]);
+			int _best = 0;
+			int _best_error = INT32_MAX;
+			for (int j = 0; j < 8; ++j)
+			{
+				auto _e = std::abs(_value - _palette[j]);
+				if (_e < _best_error)
+				{
+					_best_error = _e;
+					_best = j;
+				}
+			}
+			_indices |= static_cast<uint64_t>(_best) << (i * 3);
+		}
+
+		pOut[0] = static_cast<uint8_t>(_max);
+		pOut[1] = static_cast<uint8_t>(_min);
+		for (int i = 0; i < 6; ++i) pOut[2 + i] = static_cast<uint8_t>(_indices >> (i * 8));
+	}
+
+	static const int sBC7Weights4[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	static int bc7_interpolate(_In_ const int& pE0, _In_ const int& pE1, _In_ const int& pIndex)
+	{
+		return ((64 - sBC7Weights4[pIndex]) * pE0 + sBC7Weights4[pIndex] * pE1 + 32) >> 6;
+	}
+
+	//quantize endpoint to 7 bits per channel plus shared p bit
+	static void bc7_quantize(_In_ const float pEndpoint[4], _In_ const int& pPBit, _Out_ int pQuantized[4])
+	{
+		for (int c = 0; c < 4; ++c)
+		{
+			auto _q = static_cast<int>(std::floor((std::min(std::max(pEndpoint[c], 0.0f), 255.0f) - pPBit) * 0.5f + 0.5f));
+			pQuantized[c] = std::min(std::max(_q, 0), 127);
+		}
+	}
+
+	static uint32_t bc7_indices(
+		_In_ const uint8_t pBlock[16][4],
+		_In_ const int pE0[4],
+		_In_ const int pE1[4],
+		_Out_ uint8_t pIndices[16])
+	{
+		int _palette[16][4];
+		for (int j = 0; j < 16; ++j)
+		{
+			for (int c = 0; c < 4; ++c) _palette[j][c] = bc7_interpolate(pE0[c], pE1[c], j);
+		}
+
+		int _direction[4];
+		int _length = 0;
+		for (int c = 0; c < 4; ++c)
+		{
+			_direction[c] = pE1[c] - pE0[c];
+			_length += _direction[c] * _direction[c];
+		}
+
+		uint32_t _error = 0;
+		for (int i = 0; i < 16; ++i)
+		{
+			//project on the line of endpoints, then only check the nearest entries of palette
+			int _first = 0, _last = 15;
+			if (_length > 0)
+			{
+				int _dot = 0;
+				for (int c = 0; c < 4; ++c) _dot += (static_cast<int>(pBlock[i][c]) - pE0[c]) * _direction[c];
+				auto _index = static_cast<int>(static_cast<float>(_dot) / static_cast<float>(_length) * 15.0f + 0.5f);
+				_index = std::min(std::max(_index, 0), 15);
+				_first = std::max(_index - 1, 0);
+				_last = std::min(_index + 1, 15);
+			}
+			else
+			{
+				_last = 0;
+			}
+
+			uint32_t _best_error = UINT32_MAX;
+			for (int j = _first; j <= _last; ++j)
+			{
+				uint32_t _e = 0;
+				for (int c = 0; c < 4; ++c)
+				{
+					auto _d = static_cast<int>(pBlock[i][c]) - _palette[j][c];
+					_e += static_cast<uint32_t>(_d * _d);
+				}
+				if (_e < _best_error)
+				{
+					_best_error = _e;
+					pIndices[i] = static_cast<uint8_t>(j);
+				}
+			}
+			_error += _best_error;
+		}
+		return _error;
+	}
+
+	struct w_bc7_mode6
+	{
+		int			e0[4];
+		int			e1[4];
+		int			p0;
+		int			p1;
+		uint8_t		indices[16];
+		uint32_t	error = UINT32_MAX;
+	};
+
+	//try all p bits of the endpoints and keep the best one
+	static void bc7_fit(
+		_In_ const uint8_t pBlock[16][4],
+		_In_ const float pE0[4],
+		_In_ const float pE1[4],
+		_Inout_ w_bc7_mode6& pBest)
+	{
+		for (int _p0 = 0; _p0 < 2; ++_p0)
+		{
+			for (int _p1 = 0; _p1 < 2; ++_p1)
+			{
+				int _q0[4], _q1[4];
+				bc7_quantize(pE0, _p0, _q0);
+				bc7_quantize(pE1, _p1, _q1);
+
+				int _e0[4], _e1[4];
+				for (int c = 0; c < 4; ++c)
+				{
+					_e0[c] = (_q0[c] << 1) | _p0;
+					_e1[c] = (_q1[c] << 1) | _p1;
+				}
+
+				uint8_t _indices[16];
+				auto _error = bc7_indices(pBlock, _e0, _e1, _indices);
+				if (_error < pBest.error)
+				{
+					std::memcpy(pBest.e0, _q0, sizeof(_q0));
+					std::memcpy(pBest.e1, _q1, sizeof(_q1));
+					pBest.p0 = _p0;
+					pBest.p1 = _p1;
+					std::memcpy(pBest.indices, _indices, sizeof(_indices));
+					pBest.error = _error;
+				}
+			}
+		}
+	}
+
+	struct w_bit_writer
+	{
+		uint8_t*	data;
+		uint32_t	position = 0;
+
+		void write(_In_ const uint32_t& pValue, _In_ const uint32_t& pBits)
+		{
+			for (uint32_t i = 0; i < pBits; ++i, ++position)
+			{
+				if ((pValue >> i) & 1) data[position >> 3] |= static_cast<uint8_t>(1 << (position & 7));
+			}
+		}
+	};
+
+	struct w_bit_reader
+	{
+		const uint8_t*	data;
+		uint32_t		position = 0;
+
+		uint32_t read(_In_ const uint32_t& pBits)
+		{
+			uint32_t _value = 0;
+			for (uint32_t i = 0; i < pBits; ++i, ++position)
+			{
+				_value |= static_cast<uint32_t>((data[position >> 3] >> (position & 7)) & 1) << i;
+			}
+			return _value;
+		}
+	};
+
+	static void encode_bc7_block(_In_ const uint8_t pBlock[16][4], _Out_ uint8_t* pOut)
+	{
+		float _points[16][4];
+		bool _used[16];
+		for (int i = 0; i < 16; ++i)
+		{
+			for (int c = 0; c < 4; ++c) _points[i][c] = static_cast<float>(pBlock[i][c]);
+			_used[i] = true;
+		}
+
+		float _mean[4], _axis[4];
+		principal_axis<4>(_points, _used, _mean, _axis);
+
+		float _min_t = FLT_MAX, _max_t = -FLT_MAX;
+		for (int i = 0; i < 16; ++i)
+		{
+			float _t = 0.0f;
+			for (int c = 0; c < 4; ++c) _t += (_points[i][c] - _mean[c]) * _axis[c];
+			_min_t = std::min(_min_t, _t);
+			_max_t = std::max(_max_t, _t);
+		}
+		float _e0[4], _e1[4];
+		for (int c = 0; c < 4; ++c)
+		{
+			_e0[c] = _mean[c] + _axis[c] * _min_t;
+			_e1[c] = _mean[c] + _axis[c] * _max_t;
+		}
+
+		w_bc7_mode6 _best;
+		bc7_fit(pBlock, _e0, _e1, _best);
+
+		//refine endpoints with least squares of the chosen indices
+		for (int k = 0; k < 2 && _best.error > 0; ++k)
+		{
+			float _weights[16];
+			for (int i = 0; i < 16; ++i) _weights[i] = static_cast<float>(sBC7Weights4[_best.indices[i]]) / 64.0f;
+			if (!least_squares_endpoints<4>(_points, _used, _weights, _e0, _e1)) break;
+
+			auto _previous_error = _best.error;
+			bc7_fit(pBlock, _e0, _e1, _best);
+			if (_best.error >= _previous_error) break;
+		}
+
+		//msb of anchor index is implicit zero
+		if (_best.indices[0] & 8)
+		{
+			std::swap(_best.e0, _best.e1);
+			std::swap(_best.p0, _best.p1);
+			for (int i = 0; i < 16; ++i) _best.indices[i] = static_cast<uint8_t>(15 - _best.indices[i]);
+		}
+
+		std::memset(pOut, 0, 16);
+		w_bit_writer _writer;
+		_writer.data = pOut;
+		_writer.write(1 << 6, 7);
+		for (int c = 0; c < 4; ++c)
+		{
+			_writer.write(static_cast<uint32_t>(_best.e0[c]), 7);
+			_writer.write(static_cast<uint32_t>(_best.e1[c]), 7);
+		}
+		_writer.write(static_cast<uint32_t>(_best.p0), 1);
+		_writer.write(static_cast<uint32_t>(_best.p1), 1);
+		_writer.write(_best.indices[0], 3);
+		for (int i = 1; i < 16; ++i) _writer.write(_best.indices[i], 4);
+	}
+
+#pragma endregion
+
+#pragma region block decoders
+
+	static void decode_bc1_block(_In_ const uint8_t* pIn, _In_ const bool& pAlwaysFourColors, _Out_ uint8_t pBlock[16][4])
+	{
+		auto _c0 = static_cast<uint16_t>(pIn[0] | (pIn[1] << 8));
+		auto _c1 = static_cast<uint16_t>(pIn[2] | (pIn[3] << 8));
+		uint32_t _indices;
+		std::memcpy(&_indices, pIn + 4, 4);
+
+		int _palette[4][4];
+		bc1_palette(_c0, _c1, pAlwaysFourColors, _palette);
+		for (int i = 0; i < 16; ++i)
+		{
+			auto _index = (_indices >> (i * 2)) & 3;
+			for (int c = 0; c < 4; ++c) pBlock[i][c] = static_cast<uint8_t>(_palette[_index][c]);
+		}
+	}
+
+	static void decode_bc4_block(_In_ const uint8_t* pIn, _In_ const int& pChannel, _Inout_ uint8_t pBlock[16][4])
+	{
+		int _palette[8];
+		bc4_palette(pIn[0], pIn[1], _palette);
+
+		uint64_t _indices = 0;
+		for (int i = 0; i < 6; ++i) _indices |= static_cast<uint64_t>(pIn[2 + i]) << (i * 8);
+		for (int i = 0; i < 16; ++i)
+		{
+			pBlock[i][pChannel] = static_cast<uint8_t>(_palette[(_indices >> (i * 3)) & 7]);
+		}
+	}
+
+	static bool decode_bc7_block(_In_ const uint8_t* pIn, _Out_ uint8_t pBlock[16][4])
+	{
+		w_bit_reader _reader;
+		_reader.data = pIn;
+		if (_reader.read(7) != (1 << 6)) return false;
+
+		int _e0[4], _e1[4];
+		for (int c = 0; c < 4; ++c)
+		{
+			_e0[c] = static_cast<int>(_reader.read(7)) << 1;
+			_e1[c] = static_cast<int>(_reader.read(7)) << 1;
+		}
+		auto _p0 = static_cast<int>(_reader.read(1));
+		auto _p1 = static_cast<int>(_reader.read(1));
+		for (int c = 0; c < 4; ++c)
+		{
+			_e0[c] |= _p0;
+			_e1[c] |= _p1;
+		}
+		for (int i = 0; i < 16; ++i)
+		{
+			auto _index = static_cast<int>(_reader.read(i == 0 ? 3 : 4));
+			for (int c = 0; c < 4; ++c) pBlock[i][c] = static_cast<uint8_t>(bc7_interpolate(_e0[c], _e1[c], _index));
+		}
+		return true;
+	}
+
+#pragma endregion
+
+	static uint32_t block_size(_In_ const w_texture_cooker_format& pFormat)
+	{
+		switch (pFormat)
+		{
+		case BC1_TEXTURE_COOKER_FORMAT:
+		case BC4_TEXTURE_COOKER_FORMAT:
+			return 8;
+		case BC3_TEXTURE_COOKER_FORMAT:
+		case BC5_TEXTURE_COOKER_FORMAT:
+		case BC7_TEXTURE_COOKER_FORMAT:
+			return 16;
+		default:
+			return 0;
+		}
+	}
+
+	//color of block compressed formats can be stored as sRGB, BC4 and BC5 are always linear
+	static bool is_srgb(_In_ const w_texture_cooker_configs& pConfigs)
+	{
+		return pConfigs.srgb && !pConfigs.normal_map &&
+			pConfigs.format != BC4_TEXTURE_COOKER_FORMAT &&
+			pConfigs.format != BC5_TEXTURE_COOKER_FORMAT;
+	}
+
+	static gli::format to_gli_format(_In_ const w_texture_cooker_configs& pConfigs)
+	{
+		auto _srgb = is_srgb(pConfigs);
+		switch (pConfigs.format)
+		{
+		default:
+		case RGBA8_TEXTURE_COOKER_FORMAT:
+			return _srgb ? gli::FORMAT_RGBA8_SRGB_PACK8 : gli::FORMAT_RGBA8_UNORM_PACK8;
+		case BC1_TEXTURE_COOKER_FORMAT:
+			return _srgb ? gli::FORMAT_RGBA_DXT1_SRGB_BLOCK8 : gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8;
+		case BC3_TEXTURE_COOKER_FORMAT:
+			return _srgb ? gli::FORMAT_RGBA_DXT5_SRGB_BLOCK16 : gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16;
+		case BC4_TEXTURE_COOKER_FORMAT:
+			return gli::FORMAT_R_ATI1N_UNORM_BLOCK8;
+		case BC5_TEXTURE_COOKER_FORMAT:
+			return gli::FORMAT_RG_ATI2N_UNORM_BLOCK16;
+		case BC7_TEXTURE_COOKER_FORMAT:
+			return _srgb ? gli::FORMAT_RGBA_BP_SRGB_BLOCK16 : gli::FORMAT_RGBA_BP_UNORM_BLOCK16;
+		}
+	}
+
+	static W_RESULT encode_level(
+		_In_ const uint8_t* pRGBA,
+		_In_ const uint32_t& pWidth,
+		_In_ const uint32_t& pHeight,
+		_In_ const w_texture_cooker_format& pFormat,
+		_In_ w_job_system* pJobSystem,
+		_Inout_ std::vector<uint8_t>& pBlocks)
+	{
+		if (!pRGBA || pWidth == 0 || pHeight == 0) return W_FAILED;
+
+		if (pFormat == RGBA8_TEXTURE_COOKER_FORMAT)
+		{
+			pBlocks.assign(pRGBA, pRGBA + static_cast<size_t>(pWidth) * pHeight * 4);
+			return W_PASSED;
+		}
+
+		auto _block_size = block_size(pFormat);
+		if (!_block_size) return W_FAILED;
+
+		auto _blocks_x = (pWidth + 3) / 4;
+		auto _blocks_y = (pHeight + 3) / 4;
+		pBlocks.resize(static_cast<size_t>(_blocks_x) * _blocks_y * _block_size);
+
+		//each range of block rows is one tile
+		auto _encode_rows = [&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+		{
+			uint8_t _block[16][4];
+			for (size_t y = pBegin; y < pEnd; ++y)
+			{
+				for (uint32_t x = 0; x < _blocks_x; ++x)
+				{
+					load_block(pRGBA, pWidth, pHeight, x, static_cast<uint32_t>(y), _block);
+					auto _out = &pBlocks[(y * _blocks_x + x) * _block_size];
+					switch (pFormat)
+					{
+					case BC1_TEXTURE_COOKER_FORMAT:
+						encode_bc1_block(_block, true, _out);
+						break;
+					case BC3_TEXTURE_COOKER_FORMAT:
+						encode_bc4_block(_block, 3, _out);
+						encode_bc1_block(_block, false, _out + 8);
+						break;
+					case BC4_TEXTURE_COOKER_FORMAT:
+						encode_bc4_block(_block, 0, _out);
+						break;
+					case BC5_TEXTURE_COOKER_FORMAT:
+						encode_bc4_block(_block, 0, _out);
+						encode_bc4_block(_block, 1, _out + 8);
+						break;
+					case BC7_TEXTURE_COOKER_FORMAT:
+						encode_bc7_block(_block, _out);
+						break;
+					default:
+						break;
+					}
+				}
+			}
+		};
+
+		if (pJobSystem)
+		{
+			pJobSystem->parallel_for(_blocks_y, 0, _encode_rows);
+		}
+		else
+		{
+			_encode_rows(0, _blocks_y);
+		}
+		return W_PASSED;
+	}
+
+	static W_RESULT cook_texture(
+		_In_z_ const std::wstring& pSourcePath,
+		_In_z_ const std::wstring& pDestinationPath,
+		_In_ const w_texture_cooker_configs& pConfigs,
+		_In_ w_job_system& pJobSystem,
+		_Inout_ w_texture_cooker_statistics& pStatistics)
+	{
+		const std::string _trace_info = "w_texture_cooker::cook";
+
+		auto _source_path = wolf::system::convert::wstring_to_string(pSourcePath);
+		auto _destination_path = wolf::system::convert::wstring_to_string(pDestinationPath);
+
+		//decode
+		auto _start = w_clock::now();
+		std::ifstream _file(_source_path, std::ios::binary | std::ios::ate);
+		if (!_file)
+		{
+			logger.error("could not open source texture: " + _source_path + " trace info: " + _trace_info);
+			return W_FAILED;
+		}
+		std::vector<uint8_t> _file_data(static_cast<size_t>(_file.tellg()));
+		_file.seekg(0, std::ios::beg);
+		_file.read(reinterpret_cast<char*>(_file_data.data()), _file_data.size());
+		_file.close();
+
+		int _width = 0, _height = 0, _comp = 0;
+		auto _rgba = stbi_load_from_memory(
+			_file_data.data(),
+			static_cast<int>(_file_data.size()),
+			&_width,
+			&_height,
+			&_comp,
+			STBI_rgb_alpha);
+		if (!_rgba || _width <= 0 || _height <= 0)
+		{
+			if (_rgba) stbi_image_free(_rgba);
+			logger.error("could not decode source texture: " + _source_path + " trace info: " + _trace_info);
+			return W_FAILED;
+		}
+		pStatistics.source_file_bytes = _file_data.size();
+		pStatistics.decode_time_in_ms = elapsed_ms(_start);
+		_file_data.clear();
+
+		auto _srgb = is_srgb(pConfigs);
+		auto _levels = pConfigs.generate_mip_maps ?
+			static_cast<uint32_t>(std::floor(std::log2(std::max(_width, _height)))) + 1 : 1u;
+
+		pStatistics.width = static_cast<uint32_t>(_width);
+		pStatistics.height = static_cast<uint32_t>(_height);
+		pStatistics.levels = _levels;
+		pStatistics.rgba_bytes = 0;
+		pStatistics.cooked_bytes = 0;
+		pStatistics.mip_maps_time_in_ms = 0.0;
+		pStatistics.encode_time_in_ms = 0.0;
+
+		gli::texture2d _texture(to_gli_format(pConfigs), gli::extent2d(_width, _height), _levels);
+
+		//the first level is stored as it is, other levels are filtered in linear space
+		w_float_image _image;
+		if (_levels > 1)
+		{
+			_start = w_clock::now();
+			to_float_image(_rgba, _width, _height, _srgb, pJobSystem, _image);
+			pStatistics.mip_maps_time_in_ms += elapsed_ms(_start);
+		}
+
+		float _coverage = 0.0f;
+		auto _preserve_coverage = pConfigs.alpha_coverage_reference > 0.0f && _levels > 1;
+		if (_preserve_coverage)
+		{
+			_coverage = alpha_coverage(_image, pConfigs.alpha_coverage_reference, 1.0f);
+		}
+
+		std::vector<uint8_t> _level_rgba(_rgba, _rgba + static_cast<size_t>(_width) * _height * 4);
+		stbi_image_free(_rgba);
+
+		auto _hr = W_PASSED;
+		std::vector<uint8_t> _blocks;
+		for (uint32_t i = 0; i < _levels; ++i)
+		{
+			auto _level_width = std::max(1u, static_cast<uint32_t>(_width) >> i);
+			auto _level_height = std::max(1u, static_cast<uint32_t>(_height) >> i);
+
+			if (i > 0)
+			{
+				_start = w_clock::now();
+
+				w_float_image _next;
+				downsample(_image, pJobSystem, _next);
+				_image = std::move(_next);
+
+				auto _alpha_scale = _preserve_coverage ?
+					find_alpha_scale(_image, pConfigs.alpha_coverage_reference, _coverage) : 1.0f;
+				to_rgba8(_image, _srgb, pConfigs.normal_map, _alpha_scale, pJobSystem, _level_rgba);
+
+				pStatistics.mip_maps_time_in_ms += elapsed_ms(_start);
+			}
+
+			_start = w_clock::now();
+			_hr = encode_level(_level_rgba.data(), _level_width, _level_height, pConfigs.format, &pJobSystem, _blocks);
+			pStatistics.encode_time_in_ms += elapsed_ms(_start);
+			if (_hr == W_FAILED || _blocks.size() != _texture[i].size())
+			{
+				logger.error("could not encode level " + std::to_string(i) + " of texture: " + _source_path +
+					" trace info: " + _trace_info);
+				return W_FAILED;
+			}
+
+			std::memcpy(_texture[i].data(), _blocks.data(), _blocks.size());
+			pStatistics.rgba_bytes += static_cast<uint64_t>(_level_width) * _level_height * 4;
+			pStatistics.cooked_bytes += _blocks.size();
+		}
+
+		//rgba8 texture which is generated at runtime always has all levels
+		for (auto i = _levels; i < static_cast<uint32_t>(std::floor(std::log2(std::max(_width, _height)))) + 1; ++i)
+		{
+			pStatistics.rgba_bytes += static_cast<uint64_t>(std::max(1, _width >> i)) * std::max(1, _height >> i) * 4;
+		}
+
+		_start = w_clock::now();
+		auto _saved = pConfigs.container == KTX_TEXTURE_COOKER_CONTAINER ?
+			gli::save_ktx(_texture, _destination_path) :
+			gli::save_dds(_texture, _destination_path);
+		pStatistics.save_time_in_ms = elapsed_ms(_start);
+		if (!_saved)
+		{
+			logger.error("could not save cooked texture: " + _destination_path + " trace info: " + _trace_info);
+			return W_FAILED;
+		}
+
+		return W_PASSED;
+	}
+}
+
+W_RESULT w_texture_cooker::cook(
+	_In_z_ const std::wstring& pSourcePath,
+	_In_z_ const std::wstring& pDestinationPath,
+	_In_ const w_texture_cooker_configs& pConfigs,
+	_Out_opt_ w_texture_cooker_statistics* pStatistics)
+{
+	w_job_system _job_system;
+	if (_job_system.allocate(pConfigs.number_of_threads) == W_FAILED) return W_FAILED;
+
+	w_texture_cooker_statistics _statistics;
+	auto _hr = cook_texture(pSourcePath, pDestinationPath, pConfigs, _job_system, _statistics);
+	_job_system.release();
+
+	if (pStatistics) *pStatistics = _statistics;
+	return _hr;
+}
+
+W_RESULT w_texture_cooker::cook(
+	_In_ const std::vector<std::wstring>& pSourcePaths,
+	_In_ const std::vector<std::wstring>& pDestinationPaths,
+	_In_ const std::vector<w_texture_cooker_configs>& pConfigs,
+	_Out_opt_ std::vector<w_texture_cooker_statistics>* pStatistics)
+{
+	if (pSourcePaths.size() != pDestinationPaths.size() || pSourcePaths.size() != pConfigs.size())
+	{
+		logger.error("number of sources, destinations and configs must be equal. trace info: w_texture_cooker::cook");
+		return W_FAILED;
+	}
+	if (pSourcePaths.empty()) return W_PASSED;
+
+	w_job_system _job_system;
+	if (_job_system.allocate(pConfigs[0].number_of_threads) == W_FAILED) return W_FAILED;
+
+	//textures are jobs and their levels and tiles are nested jobs, waiting workers help the others
+	std::vector<w_texture_cooker_statistics> _statistics(pSourcePaths.size());
+	std::vector<W_RESULT> _results(pSourcePaths.size(), W_FAILED);
+	w_job_counter _counter;
+	for (size_t i = 0; i < pSourcePaths.size(); ++i)
+	{
+		_job_system.submit([&, i]()
+		{
+			_results[i] = cook_texture(pSourcePaths[i], pDestinationPaths[i], pConfigs[i], _job_system, _statistics[i]);
+		}, &_counter);
+	}
+	_job_system.wait(_counter);
+	_job_system.release();
+
+	if (pStatistics) *pStatistics = std::move(_statistics);
+	return std::all_of(_results.begin(), _results.end(), [](W_RESULT pResult) { return pResult == W_PASSED; }) ?
+		W_PASSED : W_FAILED;
+}
+
+W_RESULT w_texture_cooker::encode(
+	_In_ const uint8_t* pRGBA,
+	_In_ const uint32_t& pWidth,
+	_In_ const uint32_t& pHeight,
+	_In_ const w_texture_cooker_format& pFormat,
+	_Inout_ std::vector<uint8_t>& pBlocks)
+{
+	return encode_level(pRGBA, pWidth, pHeight, pFormat, nullptr, pBlocks);
+}
+
+W_RESULT w_texture_cooker::decode(
+	_In_ const uint8_t* pBlocks,
+	_In_ const uint32_t& pWidth,
+	_In_ const uint32_t& pHeight,
+	_In_ const w_texture_cooker_format& pFormat,
+	_Inout_ std::vector<uint8_t>& pRGBA)
+{
+	if (!pBlocks || pWidth == 0 || pHeight == 0) return W_FAILED;
+
+	pRGBA.resize(static_cast<size_t>(pWidth) * pHeight * 4);
+	if (pFormat == RGBA8_TEXTURE_COOKER_FORMAT)
+	{
+		std::memcpy(pRGBA.data(), pBlocks, pRGBA.size());
+		return W_PASSED;
+	}
+
+	auto _block_size = block_size(pFormat);
+	if (!_block_size) return W_FAILED;
+
+	auto _blocks_x = (pWidth + 3) / 4;
+	auto _blocks_y = (pHeight + 3) / 4;
+	uint8_t _block[16][4];
+	for (uint32_t by = 0; by < _blocks_y; ++by)
+	{
+		for (uint32_t bx = 0; bx < _blocks_x; ++bx)
+		{
+			auto _in = pBlocks + (static_cast<size_t>(by) * _blocks_x + bx) * _block_size;
+			for (int i = 0; i < 16; ++i)
+			{
+				_block[i][0] = _block[i][1] = _block[i][2] = 0;
+				_block[i][3] = 255;
+			}
+
+			switch (pFormat)
+			{
+			case BC1_TEXTURE_COOKER_FORMAT:
+				decode_bc1_block(_in, false, _block);
+				break;
+			case BC3_TEXTURE_COOKER_FORMAT:
+				decode_bc1_block(_in + 8, true, _block);
+				decode_bc4_block(_in, 3, _block);
+				break;
+			case BC4_TEXTURE_COOKER_FORMAT:
+				decode_bc4_block(_in, 0, _block);
+				break;
+			case BC5_TEXTURE_COOKER_FORMAT:
+				decode_bc4_block(_in, 0, _block);
+				decode_bc4_block(_in + 8, 1, _block);
+				break;
+			case BC7_TEXTURE_COOKER_FORMAT:
+				//only mode 6 blocks of this cooker are supported
+				if (!decode_bc7_block(_in, _block)) return W_FAILED;
+				break;
+			default:
+				return W_FAILED;
+			}
+
+			for (uint32_t y = 0; y < 4 && by * 4 + y < pHeight; ++y)
+			{
+				for (uint32_t x = 0; x < 4 && bx * 4 + x < pWidth; ++x)
+				{
+					std::memcpy(&pRGBA[((static_cast<size_t>(by) * 4 + y) * pWidth + bx * 4 + x) * 4], _block[y * 4 + x], 4);
+				}
+			}
+		}
+	}
+	return W_PASSED;
+}
@@ -0,0 +1,149 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_texture_cooker.h
+	Description		 : Offline cooker of textures, generates mip chains and block compresses them into dds or ktx files
+	Comment          : Cooked files contain all levels, so w_texture uploads them directly without generating mip maps at runtime.
+					   Levels are filtered in linear space with a [1 3 3 1] separable kernel, color textures are converted from sRGB
+					   before filtering. Alpha coverage of alpha tested textures is preserved with the method of Ignacio Castano's
+					   "Computing Alpha Mipmaps". BC7 is encoded with mode 6 only, which is fast and fits most of color textures
+*/
+
+#ifndef __W_TEXTURE_COOKER_H__
+#define __W_TEXTURE_COOKER_H__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "w_cpipeline_export.h"
+#include <w_std.h>
+#include <vector>
+
+namespace wolf
+{
+	namespace content_pipeline
+	{
+		enum w_texture_cooker_format : uint8_t
+		{
+			//uncompressed, 4 bytes per pixel
+			RGBA8_TEXTURE_COOKER_FORMAT = 0,
+			//opaque or punch through alpha color, 0.5 byte per pixel
+			BC1_TEXTURE_COOKER_FORMAT,
+			//color with smooth alpha, 1 byte per pixel
+			BC3_TEXTURE_COOKER_FORMAT,
+			//one channel, i.e. specular or mask, 0.5 byte per pixel
+			BC4_TEXTURE_COOKER_FORMAT,
+			//two channels, i.e. xy of tangent space normal maps, 1 byte per pixel
+			BC5_TEXTURE_COOKER_FORMAT,
+			//high quality color and alpha, 1 byte per pixel
+			BC7_TEXTURE_COOKER_FORMAT
+		};
+
+		enum w_texture_cooker_container : uint8_t
+		{
+			DDS_TEXTURE_COOKER_CONTAINER = 0,
+			KTX_TEXTURE_COOKER_CONTAINER
+		};
+
+		struct w_texture_cooker_configs
+		{
+			w_texture_cooker_format		format = BC7_TEXTURE_COOKER_FORMAT;
+			w_texture_cooker_container	container = DDS_TEXTURE_COOKER_CONTAINER;
+			//rgb channels contain sRGB colors, they will be filtered in linear space and stored with sRGB format
+			bool						srgb = true;
+			//rgb channels contain tangent space normals, they will be normalized after filtering
+			bool						normal_map = false;
+			//generate all levels down to 1x1, otherwise only the first level will be stored
+			bool						generate_mip_maps = true;
+			//alpha test reference of shaders, coverage of alpha at this reference will be preserved on all levels. Zero disables it
+			float						alpha_coverage_reference = 0.0f;
+			//number of threads, zero means number of hardware thread contexts
+			size_t						number_of_threads = 0;
+		};
+
+		struct w_texture_cooker_statistics
+		{
+			uint32_t	width = 0;
+			uint32_t	height = 0;
+			uint32_t	levels = 0;
+			//size of source file on disk
+			uint64_t	source_file_bytes = 0;
+			//memory of rgba8 texture with all levels, what runtime mip generation allocates
+			uint64_t	rgba_bytes = 0;
+			//memory of cooked levels, what runtime allocates for cooked file
+			uint64_t	cooked_bytes = 0;
+			double		decode_time_in_ms = 0.0;
+			double		mip_maps_time_in_ms = 0.0;
+			double		encode_time_in_ms = 0.0;
+			double		save_time_in_ms = 0.0;
+		};
+
+		class w_texture_cooker
+		{
+		public:
+			/*
+				cook one texture, levels and blocks are processed in parallel
+				@param pSourcePath, path of jpg, png, tga, bmp or psd file
+				@param pDestinationPath, path of cooked file
+				@param pConfigs, configs of cooker
+				@param pStatistics, optional statistics of cooking
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT cook(
+				_In_z_ const std::wstring& pSourcePath,
+				_In_z_ const std::wstring& pDestinationPath,
+				_In_ const w_texture_cooker_configs& pConfigs,
+				_Out_opt_ w_texture_cooker_statistics* pStatistics = nullptr);
+
+			/*
+				cook textures in parallel, each texture has its own configs
+				@param pSourcePaths, paths of source files
+				@param pDestinationPaths, paths of cooked files
+				@param pConfigs, configs of each texture, number_of_threads of the first one will be used for all of them
+				@param pStatistics, optional statistics of each texture
+				@return W_PASSED means all textures have been cooked and W_FAILED means at least one of them failed
+			*/
+			WCP_EXP static W_RESULT cook(
+				_In_ const std::vector<std::wstring>& pSourcePaths,
+				_In_ const std::vector<std::wstring>& pDestinationPaths,
+				_In_ const std::vector<w_texture_cooker_configs>& pConfigs,
+				_Out_opt_ std::vector<w_texture_cooker_statistics>* pStatistics = nullptr);
+
+			/*
+				encode rgba pixels of one level, blocks out of image will be filled by clamping to edges
+				@param pRGBA, rgba8 pixels
+				@param pWidth, width of level
+				@param pHeight, height of level
+				@param pFormat, compressed format
+				@param pBlocks, encoded blocks in row major order
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT encode(
+				_In_ const uint8_t* pRGBA,
+				_In_ const uint32_t& pWidth,
+				_In_ const uint32_t& pHeight,
+				_In_ const w_texture_cooker_format& pFormat,
+				_Inout_ std::vector<uint8_t>& pBlocks);
+
+			/*
+				decode blocks of one level to rgba pixels, useful for measuring quality of encoders
+				@param pBlocks, encoded blocks in row major order
+				@param pWidth, width of level
+				@param pHeight, height of level
+				@param pFormat, compressed format
+				@param pRGBA, decoded rgba8 pixels
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT decode(
+				_In_ const uint8_t* pBlocks,
+				_In_ const uint32_t& pWidth,
+				_In_ const uint32_t& pHeight,
+				_In_ const w_texture_cooker_format& pFormat,
+				_Inout_ std::vector<uint8_t>& pRGBA);
+		};
+	}
+}
+
+#endif //__W_TEXTURE_COOKER_H__
@@ -0,0 +1,357 @@
+#include "w_cpipeline_pch.h"
+#include "w_vertex_quantizer.h"
+#include <glm/gtc/packing.hpp>
+
+using namespace wolf;
+using namespace wolf::content_pipeline;
+
+namespace
+{
+	const float RADIANS_TO_DEGREES = 57.2957795f;
+
+	static float sign_not_zero(_In_ const float& pValue)
+	{
+		return pValue >= 0.0f ? 1.0f : -1.0f;
+	}
+
+	//normalize vector, returns false for zero or invalid vector
+	static bool normalize(_In_ const float pVector[3], _Out_ float pNormalized[3])
+	{
+		auto _length = std::sqrt(pVector[0] * pVector[0] + pVector[1] * pVector[1] + pVector[2] * pVector[2]);
+		if (!(_length > 0.0f) || !std::isfinite(_length))
+		{
+			pNormalized[0] = 0.0f;
+			pNormalized[1] = 0.0f;
+			pNormalized[2] = 1.0f;
+			return false;
+		}
+		pNormalized[0] = pVector[0] / _length;
+		pNormalized[1] = pVector[1] / _length;
+		pNormalized[2] = pVector[2] / _length;
+		return true;
+	}
+
+	//angle between two unit vectors in degrees
+	static float angle_in_degrees(_In_ const float pA[3], _In_ const float pB[3])
+	{
+		auto _dot = pA[0] * pB[0] + pA[1] * pB[1] + pA[2] * pB[2];
+		_dot = std::max(-1.0f, std::min(1.0f, _dot));
+		return std::acos(_dot) * RADIANS_TO_DEGREES;
+	}
+
+	static void decode_vertex(
+		_In_ const w_quantized_vertex_struct& pQuantized,
+		_In_ const w_quantized_mesh& pMesh,
+		_Inout_ w_vertex_struct& pVertex)
+	{
+		for (size_t i = 0; i < 3; ++i)
+		{
+			pVertex.position[i] = glm::unpackSnorm1x16(static_cast<uint16_t>(pQuantized.position[i])) * pMesh.position_scale[i] +
+				pMesh.position_offset[i];
+		}
+
+		int32_t _encoded[2] = { pQuantized.normal[0], pQuantized.normal[1] };
+		w_vertex_quantizer::decode_octahedral(_encoded, 16, pVertex.normal);
+
+		pVertex.uv[0] = glm::unpackHalf1x16(pQuantized.uv[0]);
+		pVertex.uv[1] = glm::unpackHalf1x16(pQuantized.uv[1]);
+
+		_encoded[0] = pQuantized.tangent[0];
+		_encoded[1] = pQuantized.tangent[1];
+		w_vertex_quantizer::decode_octahedral(_encoded, 8, pVertex.tangent);
+
+		//binormal = cross(normal, tangent) * sign
+		auto _sign = pQuantized.tangent[3] < 0 ? -1.0f : 1.0f;
+		auto _n = pVertex.normal;
+		auto _t = pVertex.tangent;
+		pVertex.binormal[0] = (_n[1] * _t[2] - _n[2] * _t[1]) * _sign;
+		pVertex.binormal[1] = (_n[2] * _t[0] - _n[0] * _t[2]) * _sign;
+		pVertex.binormal[2] = (_n[0] * _t[1] - _n[1] * _t[0]) * _sign;
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			pVertex.color[i] = glm::unpackUnorm1x8(pQuantized.color[i]);
+			pVertex.blend_weight[i] = glm::unpackUnorm1x8(pQuantized.blend_weight[i]);
+			pVertex.blend_indices[i] = pQuantized.blend_indices[i] == W_UNUSED_BLEND_INDEX ? -1 : pQuantized.blend_indices[i];
+		}
+	}
+}
+
+void w_vertex_quantization_report::merge(_In_ const w_vertex_quantization_report& pReport)
+{
+	auto _count = this->vertices_count + pReport.vertices_count;
+	if (_count)
+	{
+		auto _weight = static_cast<double>(pReport.vertices_count) / static_cast<double>(_count);
+		this->average_position_error = static_cast<float>(this->average_position_error * (1.0 - _weight) + pReport.average_position_error * _weight);
+		this->average_normal_error_in_degrees = static_cast<float>(this->average_normal_error_in_degrees * (1.0 - _weight) + pReport.average_normal_error_in_degrees * _weight);
+	}
+	this->vertices_count = _count;
+	this->source_bytes_per_vertex = std::max(this->source_bytes_per_vertex, pReport.source_bytes_per_vertex);
+	this->quantized_bytes_per_vertex = std::max(this->quantized_bytes_per_vertex, pReport.quantized_bytes_per_vertex);
+	this->max_position_error = std::max(this->max_position_error, pReport.max_position_error);
+	this->max_normal_error_in_degrees = std::max(this->max_normal_error_in_degrees, pReport.max_normal_error_in_degrees);
+	this->max_uv_error = std::max(this->max_uv_error, pReport.max_uv_error);
+	this->max_tangent_error_in_degrees = std::max(this->max_tangent_error_in_degrees, pReport.max_tangent_error_in_degrees);
+	this->max_color_error = std::max(this->max_color_error, pReport.max_color_error);
+	this->max_blend_weight_error = std::max(this->max_blend_weight_error, pReport.max_blend_weight_error);
+}
+
+void w_vertex_quantizer::encode_octahedral(
+	_In_ const float pVector[3],
+	_In_ const uint32_t& pBits,
+	_Out_ int32_t pEncoded[2])
+{
+	float _n[3];
+	if (!normalize(pVector, _n) || pBits < 2 || pBits > 16)
+	{
+		pEncoded[0] = 0;
+		pEncoded[1] = 0;
+		return;
+	}
+
+	//project on octahedron, then unfold the lower hemisphere
+	auto _l1 = std::abs(_n[0]) + std::abs(_n[1]) + std::abs(_n[2]);
+	auto _u = _n[0] / _l1;
+	auto _v = _n[1] / _l1;
+	if (_n[2] < 0.0f)
+	{
+		auto _old_u = _u;
+		_u = (1.0f - std::abs(_v)) * sign_not_zero(_old_u);
+		_v = (1.0f - std::abs(_old_u)) * sign_not_zero(_v);
+	}
+
+	//choose the closest of the four neighbours on the grid
+	const auto _max = static_cast<float>((1 << (pBits - 1)) - 1);
+	auto _fu = std::floor(_u * _max);
+	auto _fv = std::floor(_v * _max);
+
+	float _best_dot = -2.0f;
+	for (int i = 0; i < 4; ++i)
+	{
+		int32_t _candidate[2] =
+		{
+			static_cast<int32_t>(std::max(-_max, std::min(_max, _fu + (i & 1)))),
+			static_cast<int32_t>(std::max(-_max, std::min(_max, _fv + (i >> 1))))
+		};
+
+		float _decoded[3];
+		decode_octahedral(_candidate, pBits, _decoded);
+		auto _dot = _decoded[0] * _n[0] + _decoded[1] * _n[1] + _decoded[2] * _n[2];
+		if (_dot > _best_dot)
+		{
+			_best_dot = _dot;
+			pEncoded[0] = _candidate[0];
+			pEncoded[1] = _candidate[1];
+		}
+	}
+}
+
+void w_vertex_quantizer::decode_octahedral(
+	_In_ const int32_t pEncoded[2],
+	_In_ const uint32_t& pBits,
+	_Out_ float pVector[3])
+{
+	const auto _max = static_cast<float>((1 << (pBits - 1)) - 1);
+	auto _u = std::max(-1.0f, std::min(1.0f, pEncoded[0] / _max));
+	auto _v = std::max(-1.0f, std::min(1.0f, pEncoded[1] / _max));
+
+	float _vector[3] = { _u, _v, 1.0f - std::abs(_u) - std::abs(_v) };
+	if (_vector[2] < 0.0f)
+	{
+		_vector[0] = (1.0f - std::abs(_v)) * sign_not_zero(_u);
+		_vector[1] = (1.0f - std::abs(_u)) * sign_not_zero(_v);
+	}
+	normalize(_vector, pVector);
+}
+
+W_RESULT w_vertex_quantizer::quantize(
+	_In_ const std::vector<w_vertex_struct>& pVertices,
+	_Inout_ w_quantized_mesh& pQuantizedMesh,
+	_Inout_ w_vertex_quantization_report* pReport)
+{
+	const std::string _trace_info = "w_vertex_quantizer::quantize";
+
+	pQuantizedMesh.vertices.clear();
+	if (pVertices.empty()) return W_PASSED;
+
+	//scale and offset of positions from bounds of vertices
+	float _min[3] = { FLT_MAX, FLT_MAX, FLT_MAX };
+	float _max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX };
+	for (auto& _vertex : pVertices)
+	{
+		for (size_t i = 0; i < 3; ++i)
+		{
+			_min[i] = std::min(_min[i], _vertex.position[i]);
+			_max[i] = std::max(_max[i], _vertex.position[i]);
+		}
+	}
+	for (size_t i = 0; i < 3; ++i)
+	{
+		if (!std::isfinite(_min[i]) || !std::isfinite(_max[i]))
+		{
+			logger.error("positions must be finite. trace info: " + _trace_info);
+			return W_FAILED;
+		}
+		auto _extent = (_max[i] - _min[i]) * 0.5f;
+		pQuantizedMesh.position_offset[i] = (_max[i] + _min[i]) * 0.5f;
+		pQuantizedMesh.position_scale[i] = _extent > 0.0f ? _extent : 1.0f;
+	}
+
+	pQuantizedMesh.vertices.resize(pVertices.size());
+	for (size_t v = 0; v < pVertices.size(); ++v)
+	{
+		auto& _vertex = pVertices[v];
+		auto& _quantized = pQuantizedMesh.vertices[v];
+
+		for (size_t i = 0; i < 3; ++i)
+		{
+			_quantized.position[i] = static_cast<int16_t>(glm::packSnorm1x16(
+				(_vertex.position[i] - pQuantizedMesh.position_offset[i]) / pQuantizedMesh.position_scale[i]));
+		}
+		_quantized.position[3] = INT16_MAX;
+
+		int32_t _encoded[2];
+		encode_octahedral(_vertex.normal, 16, _encoded);
+		_quantized.normal[0] = static_cast<int16_t>(_encoded[0]);
+		_quantized.normal[1] = static_cast<int16_t>(_encoded[1]);
+
+		_quantized.uv[0] = glm::packHalf1x16(_vertex.uv[0]);
+		_quantized.uv[1] = glm::packHalf1x16(_vertex.uv[1]);
+
+		encode_octahedral(_vertex.tangent, 8, _encoded);
+		_quantized.tangent[0] = static_cast<int8_t>(_encoded[0]);
+		_quantized.tangent[1] = static_cast<int8_t>(_encoded[1]);
+		_quantized.tangent[2] = 0;
+		//sign of binormal relative to cross(normal, tangent)
+		auto _n = _vertex.normal;
+		auto _t = _vertex.tangent;
+		auto _b = _vertex.binormal;
+		auto _handedness =
+			(_n[1] * _t[2] - _n[2] * _t[1]) * _b[0] +
+			(_n[2] * _t[0] - _n[0] * _t[2]) * _b[1] +
+			(_n[0] * _t[1] - _n[1] * _t[0]) * _b[2];
+		_quantized.tangent[3] = _handedness < 0.0f ? INT8_MIN + 1 : INT8_MAX;
+
+		//blend weights will be normalized, then the remainder of rounding goes to the biggest weight
+		float _sum = 0.0f;
+		size_t _biggest = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			_sum += std::max(0.0f, _vertex.blend_weight[i]);
+			if (_vertex.blend_weight[i] > _vertex.blend_weight[_biggest])
+			{
+				_biggest = i;
+			}
+		}
+		int _total = 0;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			auto _weight = _sum > 0.0f ? std::max(0.0f, _vertex.blend_weight[i]) / _sum : 0.0f;
+			_quantized.blend_weight[i] = glm::packUnorm1x8(_weight);
+			_total += _quantized.blend_weight[i];
+		}
+		if (_sum > 0.0f)
+		{
+			_quantized.blend_weight[_biggest] = static_cast<uint8_t>(_quantized.blend_weight[_biggest] + (UINT8_MAX - _total));
+		}
+
+		for (size_t i = 0; i < 4; ++i)
+		{
+			_quantized.color[i] = glm::packUnorm1x8(_vertex.color[i]);
+
+			//unused indices are -1
+			if (_vertex.blend_indices[i] == -1)
+			{
+				_quantized.blend_indices[i] = W_UNUSED_BLEND_INDEX;
+				continue;
+			}
+			if (_vertex.blend_indices[i] < 0 || _vertex.blend_indices[i] >= W_UNUSED_BLEND_INDEX)
+			{
+				logger.error("blend index " + std::to_string(_vertex.blend_indices[i]) + " is out of range of uint8. trace info: " + _trace_info);
+				pQuantizedMesh.vertices.clear();
+				return W_FAILED;
+			}
+			_quantized.blend_indices[i] = static_cast<uint8_t>(_vertex.blend_indices[i]);
+		}
+	}
+
+	if (!pReport) return W_PASSED;
+
+	w_vertex_quantization_report _report;
+	_report.vertices_count = pVertices.size();
+	//position, normal, uv, tangent, binormal, color and blend weight as floats, blend indices as ints
+	_report.source_bytes_per_vertex = static_cast<uint32_t>(sizeof(float) * (3 + 3 + 2 + 3 + 3 + 4 + 4) + sizeof(int) * 4);
+	_report.quantized_bytes_per_vertex = static_cast<uint32_t>(sizeof(w_quantized_vertex_struct));
+
+	double _position_error_sum = 0.0;
+	double _normal_error_sum = 0.0;
+	size_t _normals_count = 0;
+	w_vertex_struct _decoded;
+	for (size_t v = 0; v < pVertices.size(); ++v)
+	{
+		auto& _vertex = pVertices[v];
+		decode_vertex(pQuantizedMesh.vertices[v], pQuantizedMesh, _decoded);
+
+		float _delta[3] =
+		{
+			_decoded.position[0] - _vertex.position[0],
+			_decoded.position[1] - _vertex.position[1],
+			_decoded.position[2] - _vertex.position[2]
+		};
+		auto _position_error = std::sqrt(_delta[0] * _delta[0] + _delta[1] * _delta[1] + _delta[2] * _delta[2]);
+		_report.max_position_error = std::max(_report.max_position_error, _position_error);
+		_position_error_sum += _position_error;
+
+		float _unit[3];
+		if (normalize(_vertex.normal, _unit))
+		{
+			auto _normal_error = angle_in_degrees(_unit, _decoded.normal);
+			_report.max_normal_error_in_degrees = std::max(_report.max_normal_error_in_degrees, _normal_error);
+			_normal_error_sum += _normal_error;
+			_normals_count++;
+		}
+		if (normalize(_vertex.tangent, _unit))
+		{
+			_report.max_tangent_error_in_degrees = std::max(_report.max_tangent_error_in_degrees, angle_in_degrees(_unit, _decoded.tangent));
+		}
+
+		for (size_t i = 0; i < 2; ++i)
+		{
+			_report.max_uv_error = std::max(_report.max_uv_error, std::abs(_decoded.uv[i] - _vertex.uv[i]));
+		}
+
+		float _sum = 0.0f;
+		for (size_t i = 0; i < 4; ++i)
+		{
+			_sum += std::max(0.0f, _vertex.blend_weight[i]);
+		}
+		for (size_t i = 0; i < 4; ++i)
+		{
+			auto _color = std::max(0.0f, std::min(1.0f, _vertex.color[i]));
+			_report.max_color_error = std::max(_report.max_color_error, std::abs(_decoded.color[i] - _color));
+
+			auto _weight = _sum > 0.0f ? std::max(0.0f, _vertex.blend_weight[i]) / _sum : 0.0f;
+			_report.max_blend_weight_error = std::max(_report.max_blend_weight_error, std::abs(_decoded.blend_weight[i] - _weight));
+		}
+	}
+	_report.average_position_error = static_cast<float>(_position_error_sum / static_cast<double>(pVertices.size()));
+	_report.average_normal_error_in_degrees = _normals_count ? static_cast<float>(_normal_error_sum / static_cast<double>(_normals_count)) : 0.0f;
+
+	*pReport = _report;
+
+	return W_PASSED;
+}
+
+W_RESULT w_vertex_quantizer::dequantize(
+	_In_ const w_quantized_mesh& pQuantizedMesh,
+	_Inout_ std::vector<w_vertex_struct>& pVertices)
+{
+	pVertices.resize(pQuantizedMesh.vertices.size());
+	for (size_t v = 0; v < pQuantizedMesh.vertices.size(); ++v)
+	{
+		decode_vertex(pQuantizedMesh.vertices[v], pQuantizedMesh, pVertices[v]);
+		pVertices[v].vertex_index = static_cast<uint32_t>(v + 1);
+	}
+	return W_PASSED;
+}
@@ -0,0 +1,117 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_vertex_quantizer.h
+	Description		 : Quantize vertices of content pipeline to packed vertex formats
+	Comment          : Positions are stored as snorm16 relative to the bounds of each mesh, so they must be decoded with
+					   position * position_scale + position_offset. Normals and tangents are stored with octahedral encoding of
+					   "A Survey of Efficient Representations for Independent Unit Vectors" of Cigolle et al.
+*/
+
+#ifndef __W_VERTEX_QUANTIZER_H__
+#define __W_VERTEX_QUANTIZER_H__
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#include "w_cpipeline_export.h"
+#include <w_std.h>
+#include "w_vertex_struct.h"
+
+namespace wolf
+{
+	namespace content_pipeline
+	{
+		//quantized value of unused blend index, which is -1 in w_vertex_struct
+		const uint8_t W_UNUSED_BLEND_INDEX = 255;
+
+		//layout of VERTEX_QUANTIZED_POSITION_NORMAL_UV_TANGENT_COLOR_BLEND_WEIGHT_BLEND_INDICES, 32 bytes per vertex
+		struct w_quantized_vertex_struct
+		{
+			//snorm16 xyz relative to bounds of mesh, w is always one
+			int16_t		position[4];
+			//octahedral snorm16
+			int16_t		normal[2];
+			//half floats
+			uint16_t	uv[2];
+			//octahedral snorm8 xy of tangent, z is zero and w is the sign of binormal
+			int8_t		tangent[4];
+			//unorm8
+			uint8_t		color[4];
+			//unorm8, sum of weights is always 255
+			uint8_t		blend_weight[4];
+			//unused indices are W_UNUSED_BLEND_INDEX
+			uint8_t		blend_indices[4];
+		};
+
+		struct w_quantized_mesh
+		{
+			std::vector<w_quantized_vertex_struct>	vertices;
+			//decoded position = position * position_scale + position_offset
+			float									position_scale[3] = { 1.0f, 1.0f, 1.0f };
+			float									position_offset[3] = { 0.0f, 0.0f, 0.0f };
+		};
+
+		struct w_vertex_quantization_report
+		{
+			size_t		vertices_count = 0;
+			//size of the same attributes with float formats
+			uint32_t	source_bytes_per_vertex = 0;
+			uint32_t	quantized_bytes_per_vertex = 0;
+			//in units of model
+			float		max_position_error = 0.0f;
+			float		average_position_error = 0.0f;
+			float		max_normal_error_in_degrees = 0.0f;
+			float		average_normal_error_in_degrees = 0.0f;
+			float		max_uv_error = 0.0f;
+			float		max_tangent_error_in_degrees = 0.0f;
+			float		max_color_error = 0.0f;
+			float		max_blend_weight_error = 0.0f;
+
+			//merge with report of another mesh
+			WCP_EXP void merge(_In_ const w_vertex_quantization_report& pReport);
+		};
+
+		class w_vertex_quantizer
+		{
+		public:
+			/*
+				quantize vertices to packed vertex formats
+				@param pVertices, source vertices
+				@param pQuantizedMesh, quantized vertices with scale and offset of positions
+				@param pReport, if not null, bytes per vertex and quantization errors will be stored in it
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT quantize(
+				_In_ const std::vector<w_vertex_struct>& pVertices,
+				_Inout_ w_quantized_mesh& pQuantizedMesh,
+				_Inout_ w_vertex_quantization_report* pReport = nullptr);
+
+			/*
+				decode quantized vertices to float vertices, vertex_index of each vertex will be its index plus one
+				@param pQuantizedMesh, quantized mesh
+				@param pVertices, decoded vertices
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WCP_EXP static W_RESULT dequantize(
+				_In_ const w_quantized_mesh& pQuantizedMesh,
+				_Inout_ std::vector<w_vertex_struct>& pVertices);
+
+			//encode unit vector with octahedral encoding, the result is the closest representable value with pBits per component
+			WCP_EXP static void encode_octahedral(
+				_In_ const float pVector[3],
+				_In_ const uint32_t& pBits,
+				_Out_ int32_t pEncoded[2]);
+
+			//decode unit vector from octahedral encoding
+			WCP_EXP static void decode_octahedral(
+				_In_ const int32_t pEncoded[2],
+				_In_ const uint32_t& pBits,
+				_Out_ float pVector[3]);
+		};
+	}
+}
+
+#endif
@@ -1,9 +1,9 @@
 #include "w_media_core_pch.h"
 #include "w_media_core.h"
+#include "w_media_frame_converter.h"
 #include <cmath>
 #include <iomanip>      // For std::hex
 #include <codecvt>      // For Unicode conversions
-#include <w_task.h>
 #include <w_thread.h>
 #include "w_std.h"
 
@@ -55,14 +55,11 @@ namespace wolf
         public:
             w_media_core_pimp() :
                 _name("w_media_core"),
+                _job_system(nullptr),
                 _is_media_open(false),
                 _av_format_ctx(nullptr),
                 _av_packet(nullptr),
-                _audio_convert(nullptr),
-                _stream(nullptr),
-                _stream_output_ctx(nullptr),
-                _stream_frame(nullptr),
-                _frame_max_delay_in_ms(1000)
+                _audio_convert(nullptr)
             {
                 this->_name = "w_ffmpeg";
 
@@ -278,30 +275,6 @@ namespace wolf
                         auto videoBitRater = get_bit_rate();
                         auto videoChannels = get_video_channels();
                         auto videoSampleRate = get_video_sample_rate();
-
-                        auto width = get_video_frame_width();
-                        auto height = get_video_frame_height();
-
-                        //Create destination avFrame
-                        this->_av_frame.reset(av_frame_alloc());
-                        av_frame_unref(this->_av_frame.get()); // avcodec_get_frame_defaults deprecated function
-
-                                                               //This time we need BGRA for directX
-                        avpicture_alloc(
-                            (AVPicture*) this->_av_frame.get(),
-                            AV_PIX_FMT_BGRA,
-                            width,
-                            height);
-
-                        this->_down_sample_avFrame.reset(av_frame_alloc());
-                        av_frame_unref(this->_down_sample_avFrame.get()); // avcodec_get_frame_defaults deprecated function
-
-                                                                          //This time we need BGRA for directX
-                        avpicture_alloc(
-                            (AVPicture*) this->_down_sample_avFrame.get(),
-                            AV_PIX_FMT_BGRA,
-                            width / 2,
-                            height / 2);
                     }
 
 
@@ -380,213 +353,27 @@ namespace wolf
                 _In_ const uint32_t& pHeight,
                 _In_ system::w_signal<void(const w_media_core::w_stream_connection_info&)>& pOnConnectionEstablished,
                 _In_ system::w_signal<void(const w_media_core::w_stream_frame_info&)>& pOnFillingVideoFrameBuffer,
-                _In_ system::w_signal<void(const char*)>& pOnConnectionLost)
+                _In_ system::w_signal<void(const char*)>& pOnConnectionLost,
+                _In_ const w_stream_server_configs& pConfigs)
             {
-                w_task::execute_async(
-                    [this, 
-                    pURL, 
-                    pFormatName, 
-                    pCodecID, 
-                    pFrameRate, 
+                //capture, encode and send run on their own threads, so a slow encoder or network does not delay filling frames
+                this->_stream_server.open_async(
+                    pURL,
+                    pFormatName,
+                    pCodecID,
+                    pFrameRate,
                     pPixelFormat,
                     pWidth,
                     pHeight,
                     pOnConnectionEstablished,
                     pOnFillingVideoFrameBuffer,
-                    pOnConnectionLost]() -> W_RESULT
-                {
-                    const std::string _trace_info = this->_name + "open_stream_server";
-
-                    //create output context
-                    avformat_alloc_output_context2(&this->_stream_output_ctx, NULL, pFormatName, pURL);
-                    if (!this->_stream_output_ctx)
-                    {
-                        V(W_FAILED, L"allocating output context for streaming", _trace_info, 3);
-                        return W_FAILED;
-                    }
-                    if (!this->_stream_output_ctx->oformat)
-                    {
-                        V(W_FAILED, L"creating output streaming format : " + system::convert::string_to_wstring(pFormatName),
-                            _trace_info, 3);
-                        _release_stream_server();
-                        return W_FAILED;
-                    }
-
-                    //find the encoder
-                    auto _stream_video_codec = avcodec_find_encoder(pCodecID);
-                    if (!_stream_video_codec)
-                    {
-                        V(W_FAILED, L"finding encoder for codec id: " +
-                            system::convert::string_to_wstring(avcodec_get_name(pCodecID)),
-                            _trace_info, 3);
-                        _release_stream_server();
-                        return W_FAILED;
-                    }
-                    else
-                    {
-                        this->_stream = avformat_new_stream(this->_stream_output_ctx, _stream_video_codec);
-                        if (!this->_stream)
-                        {
-                            V(W_FAILED, L"allocating stream", _trace_info, 3);
-                            _release_stream_server();
-                            return W_FAILED;
-                        }
-                        else
-                        {
-                            this->_stream->id = this->_stream_output_ctx->nb_streams - 1;
-                            this->_stream->time_base.den = this->_stream->pts.den = 90000;
-                            this->_stream->time_base.num = this->_stream->pts.num = 1;
-
-                            auto _bit_rate = 5000 * 1000; //5000 kbps * 1000
-
-                            this->_stream->codec->codec_id = pCodecID;
-                            this->_stream->codec->bit_rate = _bit_rate;
-                            this->_stream->codec->bit_rate_tolerance = _bit_rate;
-                            this->_stream->codec->rc_max_rate = _bit_rate;
-                            this->_stream->codec->width = static_cast<int>(pWidth);
-                            this->_stream->codec->height = static_cast<int>(pHeight);
-                            this->_stream->codec->time_base.den = pFrameRate;
-                            this->_stream->codec->time_base.num = 1;
-                            this->_stream->codec->gop_size = 12; //emit one intra frame every twelve frames at most
-                            this->_stream->codec->pix_fmt = pPixelFormat;
-                        }
-                    }
-
-                    AVDictionary* _av_dic = NULL; // "create" an empty dictionary
-                    //av_dict_set(&_av_dic, "rtsp_flags", "listen", 0); // add an entry
-                    av_dict_set(&_av_dic, "rtsp_transport", "udp", 0); // add an entry
-                    av_dict_set(&_av_dic, "timeout", "-1", 0); // add an entry
-
-                    AVPicture  _stream_dst_picture = {};
-                    //now open video stream
-                    //open the codec
-                    if (avcodec_open2(this->_stream->codec, _stream_video_codec, &_av_dic))
-                    {
-                        V(W_FAILED, L"opening video codec", _trace_info, 3);
-                        _release_stream_server();
-                        return W_FAILED;
-                    }
-                    else
-                    {
-                        //allocate and init a re-usable frame */
-                        this->_stream_frame = av_frame_alloc();
-                        if (!this->_stream_frame)
-                        {
-                            V(W_FAILED, L"allocating video stream frame", _trace_info, 3);
-                            _release_stream_server();
-                            return W_FAILED;
-                        }
-                        else
-                        {
-                            auto _width = this->_stream->codec->width;
-                            auto _height = this->_stream->codec->height;
-
-                            this->_stream_frame->format = this->_stream->codec->pix_fmt;
-                            this->_stream_frame->width = _width;
-                            this->_stream_frame->height = _height;
-
-                            //Allocate the encoded raw picture.
-                            if (avpicture_alloc(&_stream_dst_picture, this->_stream->codec->pix_fmt, _width, _height) < 0)
-                            {
-                                V(W_FAILED, L"allocating video stream picture", _trace_info, 3);
-                                _release_stream_server();
-                                return W_FAILED;
-                            }
-                            else
-                            {
-                                //copy data and linesize picture pointers to frame
-                                *((AVPicture*)this->_stream_frame) = _stream_dst_picture;
-                            }
-                        }
-                    }
-
-                    if (avformat_write_header(this->_stream_output_ctx, NULL) != 0)
-                    {
-                        V(W_FAILED, L"connecting to server " + system::convert::string_to_wstring(pURL), _trace_info, 3);
-                        _release_stream_server();
-                        return W_FAILED;
-                    }
-
-                    //on connection established
-                    w_media_core::w_stream_connection_info _con_info;
-                    _con_info.url = pURL;
-                    _con_info.context = this->_stream_output_ctx;
-                    _con_info.stream = this->_stream;
-                    
-                    w_media_core::w_stream_frame_info _frame_info = {};
-                    _frame_info.picture = &_stream_dst_picture;
-                    _frame_info.width = static_cast<uint32_t>(this->_stream->codec->width);
-                    _frame_info.height = static_cast<uint32_t>(this->_stream->codec->height);
-
-                    int _got_packet = 0;
-                    AVPacket _packet = { 0 };
-                    pOnConnectionEstablished.emit(_con_info);
-                    {
-                        auto _start_send_time = std::chrono::system_clock::now();
-                        while (this->_stream)
-                        {
-                            auto _start_frame_time = std::chrono::system_clock::now();
-
-#pragma region Preparing Packets
-
-                            _frame_info.index++;
-
-                            pOnFillingVideoFrameBuffer.emit(_frame_info);
-
-                            //init packet
-                            av_init_packet(&_packet);
-
-                            //encode the image
-                            this->_stream_frame->pts = _frame_info.index;
-                            if (avcodec_encode_video2(this->_stream->codec, &_packet, this->_stream_frame, &_got_packet) < 0)
-                            {
-                                V(W_FAILED, "encoding video frame", _trace_info, 3);
-                            }
-                            else
-                            {
-                                if (_got_packet)
-                                {
-                                    _packet.stream_index = this->_stream->index;
-                                    _packet.pts = av_rescale_q_rnd(
-                                        _packet.pts,
-                                        this->_stream->codec->time_base,
-                                        this->_stream->time_base,
-                                        AVRounding(AV_ROUND_NEAR_INF | AV_ROUND_PASS_MINMAX));
-                                    if (av_write_frame(this->_stream_output_ctx, &_packet) < 0)
-                                    {
-                                        V(W_FAILED, "while writing video frame", _trace_info, 3);
-                                    }
-                                }
-                            }
-#pragma endregion
-
-                            auto _now = std::chrono::system_clock::now();
-                            _frame_info.stream_duration = std::chrono::duration_cast<std::chrono::milliseconds>(_now - _start_send_time).count();
-                            _frame_info.frame_duration = std::chrono::duration_cast<std::chrono::milliseconds>(_now - _start_frame_time).count();
-                            if (_frame_info.frame_duration > _frame_max_delay_in_ms)
-                            {
-                                logger.write(std::to_string(_frame_info.frame_duration));
-                                V(W_FAILED, "streaming delay is greater than max frame delay", _trace_info, 3);
-                                break;
-                            }
-                            else
-                            {
-                                std::this_thread::sleep_for(std::chrono::milliseconds((long)(1000.0 / (double)pFrameRate - (double)_frame_info.frame_duration)));
-                            }
+                    pOnConnectionLost,
+                    pConfigs);
+            }
 
-                            //free packet
-                            av_free_packet(&_packet);
-                        }
-                    }
-                    //free dst picture
-                    av_free(_stream_dst_picture.data[0]);
-                    //release stream server resources
-                    _release_stream_server();
-                    //on connection lost
-                    pOnConnectionLost.emit(pURL);
-
-                    return W_PASSED;
-                });
+            void stop_stream_server()
+            {
+                this->_stream_server.stop();
             }
 
             int64_t time_to_frame(_In_ int64_t pMilliSecond)
@@ -711,10 +498,7 @@ namespace wolf
 
 #pragma endregion
 
-#pragma region Re-Scale and store av frame in to the DirectX format
-
-                        //Set the target convert properties
-                        auto format = (AVPixelFormat)this->_video_codec.avFrame->format;
+#pragma region Convert av frame to RGBA directly in to the memory
 
                         auto _des_width = width;
                         auto _des_height = height;
@@ -727,121 +511,51 @@ namespace wolf
                             _des_height /= pDownSampling;
                         }
 
-                        struct SwsContext* swsContext = sws_getContext(
-                            width,
-                            height,
-                            format,
-                            _des_width,
-                            _des_height,
-                            AV_PIX_FMT_BGRA,
-                            SWS_BICUBIC,
-                            NULL,
-                            NULL,
-                            NULL);
-
-                        const size_t _slice_pitch = _des_width * _des_height * 4;
-
-                        bool _hr = false;
-                        if (_down_sampling)
+                        //RGBA bytes are the same as the ARGB integers which have been stored by previous versions on little endian machines
+                        const size_t _size = _des_width * _des_height;
+                        const size_t _allocation_size = _down_sampling ? sizeof(w_video_frame_down_sample_data) : sizeof(int) * _size;
+                        if (sizeof(int) * _size > _allocation_size)
                         {
-                            //Re-Scale it
-                            sws_scale(
-                                swsContext,
-                                this->_video_codec.avFrame->data,
-                                this->_video_codec.avFrame->linesize,
-                                0,
-                                height,
-                                this->_down_sample_avFrame->data,
-                                this->_down_sample_avFrame->linesize);
-
-                            //copy data to the destination
-                            auto _frame = (uint8_t*)(this->_down_sample_avFrame->data[0]);
-                            if (_frame)
+                            logger.error(L"Down sampled video frame is bigger than VIDEO_FRAME_DOWN_SAMPLE_SIZE");
+                            hr = W_FAILED;
+                        }
+                        else if (pVideoMemory.Allocate(_allocation_size, std::alignment_of<int>::value))
+                        {
+                            auto _address = pVideoMemory.Get_address() - 1;
+                            auto _data = static_cast<uint8_t*>(pVideoMemory.Read(_address));
+                            if (_data)
                             {
-                                _hr = pVideoMemory.Allocate(sizeof(w_video_frame_down_sample_data), std::alignment_of<w_video_frame_down_sample_data>::value);
-                                if (_hr)
+                                //convert directly into the memory of caller, SwsContext will be reused for the next frames
+                                if (this->_frame_converter.convert(
+                                    this->_video_codec.avFrame,
+                                    _data,
+                                    static_cast<uint32_t>(_des_width * 4),
+                                    AV_PIX_FMT_RGBA,
+                                    static_cast<uint32_t>(_des_width),
+                                    static_cast<uint32_t>(_des_height),
+                                    this->_job_system) == W_FAILED)
                                 {
-                                    auto _address = pVideoMemory.Get_address() - 1;
-                                    auto _memory = pVideoMemory.Read(_address);
-
-                                    auto _videoFrameData = static_cast<w_video_frame_down_sample_data*>(_memory);
-                                    if (_videoFrameData)
-                                    {
-                                        //first clear memory
-                                        std::fill(_videoFrameData->data.begin(), _videoFrameData->data.end(), 0);
-                                        tbb::parallel_for<size_t>(0, _slice_pitch, 4, [&](size_t i)
-                                        {
-                                            _videoFrameData->data.at(i / 4) = (int)((_frame[i + 3] & 0xFF) << 24) | ((_frame[i] & 0xFF) << 16) | ((_frame[i + 1] & 0xFF) << 8) | (_frame[i + 2] & 0xFF);//argb
-                                        });
-                                    }
-                                    else
-                                    {
-                                        logger.error(L"Could not cast allocated memory for video");
-                                        hr = W_FAILED;
-                                    }
-
+                                    logger.error(L"Could not convert video frame");
+                                    hr = W_FAILED;
                                 }
-                                else
+                                else if (_allocation_size > sizeof(int) * _size)
                                 {
-                                    logger.error(L"Could not allocate memory for video");
-                                    hr = W_FAILED;
+                                    //clear the rest of down sampled frame
+                                    std::memset(_data + sizeof(int) * _size, 0, _allocation_size - sizeof(int) * _size);
                                 }
-
-                                _frame = nullptr;
+                            }
+                            else
+                            {
+                                logger.error(L"Could not cast allocated memory for video");
+                                hr = W_FAILED;
                             }
                         }
                         else
                         {
-                            //Re-Scale it
-                            sws_scale(
-                                swsContext,
-                                this->_video_codec.avFrame->data,
-                                this->_video_codec.avFrame->linesize,
-                                0,
-                                height,
-                                this->_av_frame->data,
-                                this->_av_frame->linesize);
-
-                            //copy data to the destination
-                            auto _frame = (uint8_t*)(this->_av_frame->data[0]);
-                            if (_frame)
-                            {
-                                auto _size = width * height;
-                                _hr = pVideoMemory.Allocate(4 * _size, std::alignment_of<int>::value);
-                                if (_hr)
-                                {
-                                    auto _address = pVideoMemory.Get_address() - 1;
-                                    auto _memory = pVideoMemory.Read(_address);
-
-                                    auto _data = static_cast<int*>(_memory);
-                                    if (_data)
-                                    {
-                                        //first clear memory
-                                        std::fill(&_data[0], &_data[_size - 1], 0);
-                                        tbb::parallel_for<size_t>(0, _slice_pitch, 4, [&](size_t i)
-                                        {
-                                            _data[i / 4] = (int)((_frame[i + 3] & 0xFF) << 24) | ((_frame[i] & 0xFF) << 16) | ((_frame[i + 1] & 0xFF) << 8) | (_frame[i + 2] & 0xFF);//argb
-                                        });
-                                    }
-                                    else
-                                    {
-                                        logger.error(L"Could not cast allocated memory for video");
-                                        hr = W_FAILED;
-                                    }
-
-                                }
-                                else
-                                {
-                                    logger.error(L"Could not allocate memory for video");
-                                    hr = W_FAILED;
-                                }
-
-                                _frame = nullptr;
-                            }
+                            logger.error(L"Could not allocate memory for video");
+                            hr = W_FAILED;
                         }
 
-                        sws_freeContext(swsContext);
-
 #pragma endregion
 
                     }
@@ -997,76 +711,40 @@ namespace wolf
                         _update_clock(this->_video_codec);
                         _update_time(this->_video_codec.clock);
 
-#pragma region Re-Scale and store av frame in to the DirectX format
-
-                        //Set the target convert properties
-                        auto format = (AVPixelFormat)this->_video_codec.avFrame->format;
-
-                        struct SwsContext* swsContext = sws_getContext(
-                            width,
-                            height,
-                            format,
-                            width,
-                            height,
-                            AV_PIX_FMT_BGRA,
-                            SWS_BICUBIC,
-                            NULL,
-                            NULL,
-                            NULL);
-
-                        //Re-Scale it
-                        sws_scale(
-                            swsContext,
-                            this->_video_codec.avFrame->data,
-                            this->_video_codec.avFrame->linesize,
-                            0,
-                            height,
-                            this->_av_frame->data,
-                            this->_av_frame->linesize);
-
-                        const size_t _rowPitch = width * 4; // 4 bytes of RGBA
-                        const size_t _rowCount = height;
-                        const size_t _slicePitch = _rowPitch * _rowCount;
+#pragma region Convert av frame to RGBA directly in to the memory
 
-                        //copy data to the destination
-                        auto _frame = (uint8_t*)(this->_av_frame->data[0]);
-                        if (_frame)
+                        //RGBA bytes are the same as the ARGB integers which have been stored by previous versions on little endian machines
+                        const size_t _size = width * height;
+                        if (pVideoMemory.Allocate(sizeof(int) * _size, std::alignment_of<int>::value))
                         {
-                            auto _size = width * height;
-                            auto _hr = pVideoMemory.Allocate(sizeof(int) * _size,
-                                std::alignment_of<int>::value);
-                            if (_hr)
+                            auto _address = pVideoMemory.Get_address() - 1;
+                            auto _videoFrameData = static_cast<uint8_t*>(pVideoMemory.Read(_address));
+                            if (_videoFrameData)
                             {
-                                auto _address = pVideoMemory.Get_address() - 1;
-                                auto _memory = pVideoMemory.Read(_address);
-
-                                auto _videoFrameData = static_cast<int*>(_memory);
-                                if (_videoFrameData)
+                                if (this->_frame_converter.convert(
+                                    this->_video_codec.avFrame,
+                                    _videoFrameData,
+                                    static_cast<uint32_t>(width * 4),
+                                    AV_PIX_FMT_RGBA,
+                                    0,
+                                    0,
+                                    this->_job_system) == W_FAILED)
                                 {
-                                    //first clear memory
-                                    std::memset(&_videoFrameData, 0, _size);
-                                    tbb::parallel_for<size_t>(0, _slicePitch, 4, [&](size_t i)
-                                    {
-                                        _videoFrameData[i / 4] = (int)((_frame[i + 3] & 0xFF) << 24) | ((_frame[i] & 0xFF) << 16) | ((_frame[i + 1] & 0xFF) << 8) | (_frame[i + 2] & 0xFF);//argb
-                                    });
-                                }
-                                else
-                                {
-                                    logger.error(L"Could not cast allocated memory for video");
+                                    logger.error(L"Could not convert video frame");
                                     hr = W_FAILED;
                                 }
-
                             }
                             else
                             {
-                                logger.error(L"Could not allocate memory for video");
+                                logger.error(L"Could not cast allocated memory for video");
                                 hr = W_FAILED;
                             }
-
-                            _frame = nullptr;
                         }
-
-                        sws_freeContext(swsContext);
+                        else
+                        {
+                            logger.error(L"Could not allocate memory for video");
+                            hr = W_FAILED;
+                        }
 
 #pragma endregion
 
@@ -1169,21 +847,6 @@ namespace wolf
                     av_free(this->_audio_codec.avFrame);
                 }
                 
-                //release av frame
-                if (this->_av_frame)
-                {
-                    auto getdstFrame = this->_av_frame.get();
-                    av_frame_free(&getdstFrame);
-                    this->_av_frame.release();
-                }
-
-                if (this->_down_sample_avFrame)
-                {
-                    auto getdstFrame = this->_down_sample_avFrame.get();
-                    av_frame_free(&getdstFrame);
-                    this->_down_sample_avFrame.release();
-                }
-
                 //free the packet
                 if (this->_av_packet)
                 {
@@ -1205,6 +868,11 @@ namespace wolf
                 return 0;
             }
 
+            void set_job_system(_In_opt_ system::w_job_system* pJobSystem)
+            {
+                this->_job_system = pJobSystem;
+            }
+
 #pragma region Getters
 
             bool is_open() const
@@ -1339,29 +1007,15 @@ namespace wolf
                 return this->_av_packet->pts;
             }
 
+            w_stream_server_statistics get_stream_server_statistics() const
+            {
+                return this->_stream_server.get_statistics();
+            }
+
 #pragma endregion
             
         private:
 
-            ULONG _release_stream_server()
-            {
-                //release objects related to stream
-                if (this->_stream)
-                {
-                    avcodec_close(this->_stream->codec);
-                }
-                if (this->_stream_frame)
-                {
-                    av_frame_free(&this->_stream_frame);
-                }
-                if (this->_stream_output_ctx)
-                {
-                    avformat_free_context(this->_stream_output_ctx);
-                }
-
-                return 0;
-            }
-
             //Copy audio frame to the buffer
             W_RESULT _copy_audio_frame_to(uint8_t* pBuffer, int& pBufferSize)
             {
@@ -1444,8 +1098,9 @@ namespace wolf
 
             std::string                                 _name;
 
-            std::unique_ptr<AVFrame>					_av_frame;
-            std::unique_ptr<AVFrame>					_down_sample_avFrame;
+            //converts decoded frames directly in to the memory of caller and caches SwsContext between frames
+            w_media_frame_converter                     _frame_converter;
+            system::w_job_system*                       _job_system;
 
             bool										_is_media_open;
             AVFormatContext*							_av_format_ctx;
@@ -1470,10 +1125,7 @@ namespace wolf
             float										_frame_rate;
             double										_audio_frame_volume_db;
 
-            AVStream*                                   _stream;
-            AVFormatContext*                            _stream_output_ctx;
-            AVFrame*                                    _stream_frame;
-            double                                      _frame_max_delay_in_ms;
+            w_media_stream_server                       _stream_server;
         };
     }
 }
@@ -1520,7 +1172,8 @@ void w_media_core::open_stream_server_async(
     _In_ const uint32_t& pHeight,
     _In_ system::w_signal<void(const w_stream_connection_info&)>& pOnConnectionEstablished,
     _In_ system::w_signal<void(const w_stream_frame_info&)>& pOnFillingVideoFrameBuffer,
-    _In_ system::w_signal<void(const char*)>& pOnConnectionLost)
+    _In_ system::w_signal<void(const char*)>& pOnConnectionLost,
+    _In_ const w_stream_server_configs& pConfigs)
 {
     if (this->_pimp)
     {
@@ -1534,7 +1187,16 @@ void w_media_core::open_stream_server_async(
             pHeight,
             pOnConnectionEstablished,
             pOnFillingVideoFrameBuffer,
-            pOnConnectionLost);
+            pOnConnectionLost,
+            pConfigs);
+    }
+}
+
+void w_media_core::stop_stream_server()
+{
+    if (this->_pimp)
+    {
+        this->_pimp->stop_stream_server();
     }
 }
 
@@ -1575,6 +1237,7 @@ W_RESULT w_media_core::buffer_to_memory(w_memory& pVideoMemory, w_memory& pAudio
 ULONG w_media_core::release()
 {
     if (this->get_is_released()) return 1;
+    this->_pimp->stop_stream_server();
     this->_pimp->release_media();
     return _super::release();
 }
@@ -1584,6 +1247,14 @@ ULONG w_media_core::release_media()
     return this->_pimp ? this->_pimp->release_media() : 1;
 }
 
+void w_media_core::set_job_system(_In_opt_ system::w_job_system* pJobSystem)
+{
+    if (this->_pimp)
+    {
+        this->_pimp->set_job_system(pJobSystem);
+    }
+}
+
 void w_media_core::shut_down()
 {
 #ifdef __WIN32
@@ -1696,4 +1367,9 @@ int64_t w_media_core::get_packet_pts() const
     return this->_pimp ? this->_pimp->get_packet_pts() : 0.0;
 }
 
+w_stream_server_statistics w_media_core::get_stream_server_statistics() const
+{
+    return this->_pimp ? this->_pimp->get_stream_server_statistics() : w_stream_server_statistics();
+}
+
 #pragma endregion
@@ -19,6 +19,7 @@
 #include <memory>
 #include <array>
 #include <w_signal.h>
+#include "w_media_stream_server.h"
 
 #ifdef __WIN32
 #pragma warning(disable:4996)//for deprecated ffmpeg objects
@@ -53,27 +54,19 @@ extern "C"
 
 namespace wolf
 {
+    namespace system
+    {
+        class w_job_system;
+    }
+
 	namespace framework
 	{
         class w_media_core_pimp;
 		class w_media_core : public system::w_object
 		{
 		public:
-            struct w_stream_connection_info
-            {
-                const char*         url;
-                AVFormatContext*    context;
-                AVStream*           stream;
-            };
-            struct w_stream_frame_info
-            {
-                AVPicture*      picture = nullptr;
-                uint32_t        width = 0;
-                uint32_t        height = 0;
-                long long       index = 0;
-                long long       stream_duration = 0.0;
-                long long       frame_duration = 0.0;
-            };
+            typedef framework::w_stream_connection_info     w_stream_connection_info;
+            typedef framework::w_stream_frame_info          w_stream_frame_info;
 
 			//Must be call once before using class
             WMC_EXP static void register_all();
@@ -89,7 +82,7 @@ namespace wolf
             WMC_EXP W_RESULT open_media(_In_z_ std::wstring pMediaPath, _In_ int64_t pSeekToFrame = 0);
 
             /*
-                Open a stream server in async mode
+                Open a stream server in async mode, see w_media_stream_server
                 This function will wait for client to make a connection
                 For testing, use ffplay, e.g. ./ffplay -rtsp_flags listen -i rtsp://127.0.0.1:8554/live.sdp
                 @param pURL, the connection url
@@ -102,6 +95,7 @@ namespace wolf
                 @param pOnConnectionEstablished, rised when connection esablished. The argument is w_stream_connection_info  
                 @param pOnFillingVideoFrameBuffer, rised for each filling video frame buffer. The argument is w_stream_frame_info
                 @param pOnConnectionLost, rised when connection lost. The argument is w_stream_connection_info
+                @param pConfigs, configs of capture, encode and send pipeline, e.g. policy of late frames
             */
             WMC_EXP void open_stream_server_async(
                 _In_z_ const char* pURL,
@@ -113,7 +107,11 @@ namespace wolf
                 _In_ const uint32_t& pHeight,
                 _In_ system::w_signal<void(const w_stream_connection_info&)>& pOnConnectionEstablished,
                 _In_ system::w_signal<void(const w_stream_frame_info&)>& pOnUpdatingStreamVideoFrame,
-                _In_ system::w_signal<void(const char*)>& pOnConnectionLost);
+                _In_ system::w_signal<void(const char*)>& pOnConnectionLost,
+                _In_ const w_stream_server_configs& pConfigs = w_stream_server_configs());
+
+            //stop stream server and wait for its threads
+            WMC_EXP void stop_stream_server();
 
 			//Convert specific milliseconds to frame number
             WMC_EXP int64_t time_to_frame(int64_t pMilliSecond);
@@ -141,7 +139,8 @@ namespace wolf
             WMC_EXP int seek_frame_milliSecond(int64_t pMilliSecond);
 
 #ifdef __WIN32
-            
+
+            //following functions decode on the calling thread, use w_media_pipeline for cross platform playback which decodes on its own threads
             //TODO: change wolf::system::w_memory with wolf::system::w_memory_pool
 			//Store video frame data in to the memory
             WMC_EXP W_RESULT buffer_video_to_memory(wolf::system::w_memory& pVideoMemory, UINT pDownSampling = 1);
@@ -159,6 +158,9 @@ namespace wolf
             //release media resources
             WMC_EXP ULONG release_media();
 
+            //set job system which converts bands of rows of video frames in parallel, nullptr means frames will be converted on the calling thread
+            WMC_EXP void set_job_system(_In_opt_ system::w_job_system* pJobSystem);
+
 #pragma region Getters
 
 			//Is the media opened successfully
@@ -205,6 +207,8 @@ namespace wolf
             WMC_EXP double get_audio_frame_volume_db() const;
 			//Get the current timestamp of packet
             WMC_EXP int64_t get_packet_pts() const;
+            //Get the statistics of stream server, e.g. dropped frames and glass to wire latency
+            WMC_EXP w_stream_server_statistics get_stream_server_statistics() const;
 
 #pragma endregion
 
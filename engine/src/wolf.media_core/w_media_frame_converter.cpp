@@ -0,0 +1,585 @@
+#include "w_media_core_pch.h"
+#include "w_media_frame_converter.h"
+#include <w_job_system.h>
+#include <chrono>
+#include <vector>
+#include <cstring>
+
+extern "C"
+{
+	#include <libavutil/pixdesc.h>
+	#include <libavutil/imgutils.h>
+}
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define W_SWIZZLE_AVX2
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#define W_SWIZZLE_SSSE3
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define W_SWIZZLE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define W_SWIZZLE_NEON
+#endif
+
+using namespace wolf::system;
+using namespace wolf::framework;
+
+//minimum number of rows of each band or chunk which will be processed by one job
+static const uint32_t W_MIN_ROWS_PER_JOB = 32;
+//maximum number of bands of one frame
+static const uint32_t W_MAX_BANDS = 16;
+
+#pragma region swizzle kernels
+
+//swap red and blue channels of one row
+static inline void swizzle_row(
+	_In_ const uint8_t* pSource,
+	_Inout_ uint8_t* pDestination,
+	_In_ const uint32_t& pWidth)
+{
+	uint32_t i = 0;
+
+#if defined(W_SWIZZLE_AVX2)
+
+	const __m256i _mask = _mm256_setr_epi8(
+		2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+		2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+	for (; i + 8 <= pWidth; i += 8)
+	{
+		auto _pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pSource + i * 4));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(pDestination + i * 4), _mm256_shuffle_epi8(_pixels, _mask));
+	}
+
+#elif defined(W_SWIZZLE_SSSE3)
+
+	const __m128i _mask = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+	for (; i + 4 <= pWidth; i += 4)
+	{
+		auto _pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i * 4));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i * 4), _mm_shuffle_epi8(_pixels, _mask));
+	}
+
+#elif defined(W_SWIZZLE_SSE2)
+
+	//keep green and alpha, move the first byte to the third one and vice versa
+	const __m128i _green_alpha = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+	const __m128i _low_byte = _mm_set1_epi32(0x000000FF);
+	for (; i + 4 <= pWidth; i += 4)
+	{
+		auto _pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSource + i * 4));
+		auto _swizzled = _mm_or_si128(
+			_mm_and_si128(_pixels, _green_alpha),
+			_mm_or_si128(
+				_mm_and_si128(_mm_srli_epi32(_pixels, 16), _low_byte),
+				_mm_slli_epi32(_mm_and_si128(_pixels, _low_byte), 16)));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i * 4), _swizzled);
+	}
+
+#elif defined(W_SWIZZLE_NEON)
+
+	for (; i + 16 <= pWidth; i += 16)
+	{
+		auto _pixels = vld4q_u8(pSource + i * 4);
+		auto _red = _pixels.val[0];
+		_pixels.val[0] = _pixels.val[2];
+		_pixels.val[2] = _red;
+		vst4q_u8(pDestination + i * 4, _pixels);
+	}
+
+#endif
+
+	//remaining pixels
+	for (; i < pWidth; ++i)
+	{
+		auto _src = pSource + i * 4;
+		auto _dst = pDestination + i * 4;
+		uint8_t _pixel[4] = { _src[2], _src[1], _src[0], _src[3] };
+		std::memcpy(_dst, _pixel, 4);
+	}
+}
+
+const char* w_media_frame_converter::get_swizzle_kernel_name()
+{
+#if defined(W_SWIZZLE_AVX2)
+	return "avx2";
+#elif defined(W_SWIZZLE_SSSE3)
+	return "ssse3";
+#elif defined(W_SWIZZLE_SSE2)
+	return "sse2";
+#elif defined(W_SWIZZLE_NEON)
+	return "neon";
+#else
+	return "scalar";
+#endif
+}
+
+#pragma endregion
+
+//split rows into chunks and call pFunction(begin, end) for each chunk, in parallel if job system is available
+template<typename F>
+static void for_each_rows(
+	_In_ const uint32_t& pHeight,
+	_In_opt_ w_job_system* pJobSystem,
+	_In_ const F& pFunction)
+{
+	if (!pJobSystem || pJobSystem->get_number_of_workers() < 2 || pHeight < 2 * W_MIN_ROWS_PER_JOB)
+	{
+		pFunction(0, pHeight);
+		return;
+	}
+
+	auto _chunks = 4 * pJobSystem->get_number_of_workers();
+	size_t _rows = (pHeight + _chunks - 1) / _chunks;
+	if (_rows < W_MIN_ROWS_PER_JOB) _rows = W_MIN_ROWS_PER_JOB;
+
+	pJobSystem->parallel_for(pHeight, _rows, [&pFunction](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+	{
+		pFunction(static_cast<uint32_t>(pBegin), static_cast<uint32_t>(pEnd));
+	});
+}
+
+void w_media_frame_converter::swizzle_red_blue(
+	_In_ const uint8_t* pSource,
+	_In_ const uint32_t& pSourceRowPitch,
+	_Inout_ uint8_t* pDestination,
+	_In_ const uint32_t& pDestinationRowPitch,
+	_In_ const uint32_t& pWidth,
+	_In_ const uint32_t& pHeight,
+	_In_opt_ w_job_system* pJobSystem)
+{
+	if (!pSource || !pDestination || pWidth == 0 || pHeight == 0) return;
+
+	for_each_rows(pHeight, pJobSystem, [&](_In_ const uint32_t& pBegin, _In_ const uint32_t& pEnd)
+	{
+		for (auto _row = pBegin; _row < pEnd; ++_row)
+		{
+			swizzle_row(
+				pSource + static_cast<size_t>(_row) * pSourceRowPitch,
+				pDestination + static_cast<size_t>(_row) * pDestinationRowPitch,
+				pWidth);
+		}
+	});
+}
+
+namespace wolf
+{
+	namespace framework
+	{
+		//parameters of a SwsContext
+		struct w_sws_key
+		{
+			AVPixelFormat	src_format = AV_PIX_FMT_NONE;
+			int				src_width = 0;
+			int				src_height = 0;
+			AVPixelFormat	dst_format = AV_PIX_FMT_NONE;
+			int				dst_width = 0;
+			int				dst_height = 0;
+			int				flags = 0;
+
+			bool operator == (_In_ const w_sws_key& pOther) const
+			{
+				return
+					this->src_format == pOther.src_format &&
+					this->src_width == pOther.src_width &&
+					this->src_height == pOther.src_height &&
+					this->dst_format == pOther.dst_format &&
+					this->dst_width == pOther.dst_width &&
+					this->dst_height == pOther.dst_height &&
+					this->flags == pOther.flags;
+			}
+		};
+
+		//a band of rows of frame with its own context
+		struct w_sws_band
+		{
+			w_sws_key		key;
+			SwsContext*		context = nullptr;
+			uint32_t		begin_row = 0;
+			uint32_t		end_row = 0;
+		};
+
+		class w_media_frame_converter_pimp
+		{
+		public:
+			w_media_frame_converter_pimp() :
+				_name("w_media_frame_converter")
+			{
+			}
+
+			W_RESULT convert(
+				_In_ const AVFrame* pSource,
+				_Inout_ uint8_t* const pDestinations[4],
+				_In_ const uint32_t pDestinationRowPitches[4],
+				_In_ const AVPixelFormat& pDestinationFormat,
+				_In_ const uint32_t& pDestinationWidth,
+				_In_ const uint32_t& pDestinationHeight,
+				_In_opt_ w_job_system* pJobSystem,
+				_In_ const int& pFlags)
+			{
+				const std::string _trace_info = this->_name + "::convert";
+
+				if (!pSource || !pDestinations || !pDestinations[0] || pSource->width <= 0 || pSource->height <= 0)
+				{
+					V(W_FAILED, "converting frame, source or destination is invalid", _trace_info, 3);
+					return W_FAILED;
+				}
+
+				auto _src_format = static_cast<AVPixelFormat>(pSource->format);
+				auto _src_desc = av_pix_fmt_desc_get(_src_format);
+				auto _dst_desc = av_pix_fmt_desc_get(pDestinationFormat);
+				if (!_src_desc || !_dst_desc || (_src_desc->flags & AV_PIX_FMT_FLAG_HWACCEL))
+				{
+					V(W_FAILED, "converting frame, pixel format of source or destination is not supported", _trace_info, 3);
+					return W_FAILED;
+				}
+				auto _dst_planes = av_pix_fmt_count_planes(pDestinationFormat);
+				for (int p = 1; p < _dst_planes; ++p)
+				{
+					if (!pDestinations[p])
+					{
+						V(W_FAILED, "converting frame, destination of plane " + std::to_string(p) + " is null", _trace_info, 3);
+						return W_FAILED;
+					}
+				}
+
+				auto _start = std::chrono::steady_clock::now();
+
+				auto _src_width = static_cast<uint32_t>(pSource->width);
+				auto _src_height = static_cast<uint32_t>(pSource->height);
+				auto _dst_width = pDestinationWidth ? pDestinationWidth : _src_width;
+				auto _dst_height = pDestinationHeight ? pDestinationHeight : _src_height;
+				auto _scaled = _dst_width != _src_width || _dst_height != _src_height;
+
+				W_RESULT _hr = W_PASSED;
+				if (!_scaled && _is_red_blue_swap(_src_format, pDestinationFormat))
+				{
+					//swscale is not required
+					w_media_frame_converter::swizzle_red_blue(
+						pSource->data[0],
+						static_cast<uint32_t>(pSource->linesize[0]),
+						pDestinations[0],
+						pDestinationRowPitches[0],
+						_src_width,
+						_src_height,
+						pJobSystem);
+					this->_statistics.swizzled_frames++;
+					this->_statistics.bands = 1;
+				}
+				else if (!_scaled && _src_format == pDestinationFormat)
+				{
+					//copy each plane, chroma planes of subsampled formats have fewer rows
+					for (int p = 0; p < _dst_planes; ++p)
+					{
+						if (p == 1 && (_src_desc->flags & AV_PIX_FMT_FLAG_PAL))
+						{
+							std::memcpy(pDestinations[1], pSource->data[1], 256 * 4);
+							continue;
+						}
+						auto _src = pSource->data[p];
+						auto _src_pitch = pSource->linesize[p];
+						auto _dst = pDestinations[p];
+						auto _dst_pitch = pDestinationRowPitches[p];
+						auto _bytes = av_image_get_linesize(_src_format, pSource->width, p);
+						auto _rows = (p == 1 || p == 2) ? static_cast<uint32_t>(AV_CEIL_RSHIFT(pSource->height, _src_desc->log2_chroma_h)) : _src_height;
+						for_each_rows(_rows, pJobSystem, [&](_In_ const uint32_t& pBegin, _In_ const uint32_t& pEnd)
+						{
+							av_image_copy_plane(
+								_dst + static_cast<size_t>(pBegin) * _dst_pitch,
+								static_cast<int>(_dst_pitch),
+								_src + static_cast<ptrdiff_t>(pBegin) * _src_pitch,
+								_src_pitch,
+								_bytes,
+								static_cast<int>(pEnd - pBegin));
+						});
+					}
+					this->_statistics.copied_frames++;
+					this->_statistics.bands = 1;
+				}
+				else
+				{
+					_hr = _scale(pSource, _src_desc, pDestinations, pDestinationRowPitches, pDestinationFormat, _dst_desc,
+						_dst_width, _dst_height, _scaled ? nullptr : pJobSystem, pFlags);
+					if (_hr == W_PASSED)
+					{
+						this->_statistics.scaled_frames++;
+					}
+				}
+
+				if (_hr == W_PASSED)
+				{
+					auto _time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start).count();
+					this->_statistics.frames++;
+					this->_statistics.last_convert_time_in_ms = _time;
+					this->_statistics.total_convert_time_in_ms += _time;
+				}
+
+				return _hr;
+			}
+
+			ULONG release()
+			{
+				for (auto& _band : this->_bands)
+				{
+					if (_band.context)
+					{
+						sws_freeContext(_band.context);
+						_band.context = nullptr;
+					}
+				}
+				this->_bands.clear();
+				return 0;
+			}
+
+#pragma region Getters
+
+			w_media_frame_converter_statistics get_statistics() const
+			{
+				return this->_statistics;
+			}
+
+#pragma endregion
+
+		private:
+			static bool _is_red_blue_swap(_In_ const AVPixelFormat& pSource, _In_ const AVPixelFormat& pDestination)
+			{
+				return
+					(pSource == AV_PIX_FMT_BGRA && pDestination == AV_PIX_FMT_RGBA) ||
+					(pSource == AV_PIX_FMT_RGBA && pDestination == AV_PIX_FMT_BGRA) ||
+					(pSource == AV_PIX_FMT_BGR0 && pDestination == AV_PIX_FMT_RGB0) ||
+					(pSource == AV_PIX_FMT_RGB0 && pDestination == AV_PIX_FMT_BGR0);
+			}
+
+			W_RESULT _scale(
+				_In_ const AVFrame* pSource,
+				_In_ const AVPixFmtDescriptor* pSourceDesc,
+				_Inout_ uint8_t* const pDestinations[4],
+				_In_ const uint32_t pDestinationRowPitches[4],
+				_In_ const AVPixelFormat& pDestinationFormat,
+				_In_ const AVPixFmtDescriptor* pDestinationDesc,
+				_In_ const uint32_t& pDestinationWidth,
+				_In_ const uint32_t& pDestinationHeight,
+				_In_opt_ w_job_system* pJobSystem,
+				_In_ const int& pFlags)
+			{
+				const std::string _trace_info = this->_name + "::_scale";
+
+				auto _height = static_cast<uint32_t>(pSource->height);
+
+				//rows of each band must be aligned to subsampled chroma rows of source and destination, palette of paletted formats must not be offset
+				uint32_t _number_of_bands = 1;
+				if (pJobSystem && !(pSourceDesc->flags & AV_PIX_FMT_FLAG_PAL))
+				{
+					_number_of_bands = static_cast<uint32_t>(pJobSystem->get_number_of_workers());
+					if (_number_of_bands > W_MAX_BANDS) _number_of_bands = W_MAX_BANDS;
+					while (_number_of_bands > 1 && _height / _number_of_bands < W_MIN_ROWS_PER_JOB)
+					{
+						_number_of_bands--;
+					}
+				}
+				auto _log2_alignment = pSourceDesc->log2_chroma_h > pDestinationDesc->log2_chroma_h ? pSourceDesc->log2_chroma_h : pDestinationDesc->log2_chroma_h;
+				const uint32_t _alignment = 1u << _log2_alignment;
+				auto _rows_per_band = (_height + _number_of_bands - 1) / _number_of_bands;
+				_rows_per_band = (_rows_per_band + _alignment - 1) & ~(_alignment - 1);
+
+				//create or reuse context of each band
+				if (this->_bands.size() < _number_of_bands)
+				{
+					this->_bands.resize(_number_of_bands);
+				}
+				for (uint32_t i = 0; i < _number_of_bands; ++i)
+				{
+					auto& _band = this->_bands[i];
+					_band.begin_row = i * _rows_per_band;
+					_band.end_row = _band.begin_row + _rows_per_band < _height ? _band.begin_row + _rows_per_band : _height;
+					auto _band_height = _band.end_row > _band.begin_row ? _band.end_row - _band.begin_row : 0;
+
+					w_sws_key _key;
+					_key.src_format = static_cast<AVPixelFormat>(pSource->format);
+					_key.src_width = pSource->width;
+					_key.src_height = _number_of_bands == 1 ? pSource->height : static_cast<int>(_band_height);
+					_key.dst_format = pDestinationFormat;
+					_key.dst_width = static_cast<int>(pDestinationWidth);
+					_key.dst_height = _number_of_bands == 1 ? static_cast<int>(pDestinationHeight) : static_cast<int>(_band_height);
+					_key.flags = pFlags;
+
+					if (_band_height == 0) continue;
+					if (_band.context && _band.key == _key) continue;
+
+					if (_band.context)
+					{
+						sws_freeContext(_band.context);
+					}
+					_band.key = _key;
+					_band.context = sws_getContext(
+						_key.src_width,
+						_key.src_height,
+						_key.src_format,
+						_key.dst_width,
+						_key.dst_height,
+						_key.dst_format,
+						_key.flags,
+						NULL,
+						NULL,
+						NULL);
+					if (!_band.context)
+					{
+						V(W_FAILED, "creating SwsContext", _trace_info, 3);
+						return W_FAILED;
+					}
+					this->_statistics.context_rebuilds++;
+				}
+				this->_statistics.bands = _number_of_bands;
+
+				int _dst_linesize[4] = { 0, 0, 0, 0 };
+				for (int p = 0; p < 4; ++p)
+				{
+					if (pDestinations[p]) _dst_linesize[p] = static_cast<int>(pDestinationRowPitches[p]);
+				}
+
+				if (_number_of_bands == 1)
+				{
+					uint8_t* _dst_data[4] = { pDestinations[0], pDestinations[1], pDestinations[2], pDestinations[3] };
+					sws_scale(
+						this->_bands[0].context,
+						pSource->data,
+						pSource->linesize,
+						0,
+						pSource->height,
+						_dst_data,
+						_dst_linesize);
+					return W_PASSED;
+				}
+
+				//each band is an independent image which starts from the first row of band
+				auto _log2_chroma_h = pSourceDesc->log2_chroma_h;
+				auto _dst_log2_chroma_h = pDestinationDesc->log2_chroma_h;
+				auto _bands = this->_bands.data();
+				pJobSystem->parallel_for(_number_of_bands, 1, [&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+				{
+					for (auto i = pBegin; i < pEnd; ++i)
+					{
+						auto& _band = _bands[i];
+						if (_band.end_row <= _band.begin_row) continue;
+
+						const uint8_t* _src_data[4] = { nullptr, nullptr, nullptr, nullptr };
+						for (int p = 0; p < 4; ++p)
+						{
+							if (!pSource->data[p]) continue;
+							auto _shift = (p == 1 || p == 2) ? _log2_chroma_h : 0;
+							_src_data[p] = pSource->data[p] +
+								static_cast<ptrdiff_t>(_band.begin_row >> _shift) * pSource->linesize[p];
+						}
+
+						uint8_t* _dst_data[4] = { nullptr, nullptr, nullptr, nullptr };
+						for (int p = 0; p < 4; ++p)
+						{
+							if (!pDestinations[p]) continue;
+							auto _shift = (p == 1 || p == 2) ? _dst_log2_chroma_h : 0;
+							_dst_data[p] = pDestinations[p] +
+								static_cast<size_t>(_band.begin_row >> _shift) * pDestinationRowPitches[p];
+						}
+
+						sws_scale(
+							_band.context,
+							_src_data,
+							pSource->linesize,
+							0,
+							static_cast<int>(_band.end_row - _band.begin_row),
+							_dst_data,
+							_dst_linesize);
+					}
+				});
+
+				return W_PASSED;
+			}
+
+			std::string											_name;
+			std::vector<w_sws_band>								_bands;
+			w_media_frame_converter_statistics					_statistics;
+		};
+	}
+}
+
+w_media_frame_converter::w_media_frame_converter() :
+	_pimp(new w_media_frame_converter_pimp())
+{
+	_super::set_class_name("w_media_frame_converter");
+}
+
+w_media_frame_converter::~w_media_frame_converter()
+{
+	release();
+}
+
+W_RESULT w_media_frame_converter::convert(
+	_In_ const AVFrame* pSource,
+	_Inout_ uint8_t* pDestination,
+	_In_ const uint32_t& pDestinationRowPitch,
+	_In_ const AVPixelFormat& pDestinationFormat,
+	_In_ const uint32_t& pDestinationWidth,
+	_In_ const uint32_t& pDestinationHeight,
+	_In_opt_ w_job_system* pJobSystem,
+	_In_ const int& pFlags)
+{
+	auto _dst_desc = av_pix_fmt_desc_get(pDestinationFormat);
+	if (_dst_desc && (_dst_desc->flags & AV_PIX_FMT_FLAG_PLANAR))
+	{
+		V(W_FAILED, "converting frame, destination format must be packed, use convert_planes for planar formats", "w_media_frame_converter::convert", 3);
+		return W_FAILED;
+	}
+
+	uint8_t* const _destinations[4] = { pDestination, nullptr, nullptr, nullptr };
+	const uint32_t _row_pitches[4] = { pDestinationRowPitch, 0, 0, 0 };
+	return this->_pimp ? this->_pimp->convert(
+		pSource,
+		_destinations,
+		_row_pitches,
+		pDestinationFormat,
+		pDestinationWidth,
+		pDestinationHeight,
+		pJobSystem,
+		pFlags) : W_FAILED;
+}
+
+W_RESULT w_media_frame_converter::convert_planes(
+	_In_ const AVFrame* pSource,
+	_Inout_ uint8_t* const pDestinations[4],
+	_In_ const uint32_t pDestinationRowPitches[4],
+	_In_ const AVPixelFormat& pDestinationFormat,
+	_In_ const uint32_t& pDestinationWidth,
+	_In_ const uint32_t& pDestinationHeight,
+	_In_opt_ w_job_system* pJobSystem,
+	_In_ const int& pFlags)
+{
+	return this->_pimp ? this->_pimp->convert(
+		pSource,
+		pDestinations,
+		pDestinationRowPitches,
+		pDestinationFormat,
+		pDestinationWidth,
+		pDestinationHeight,
+		pJobSystem,
+		pFlags) : W_FAILED;
+}
+
+ULONG w_media_frame_converter::release()
+{
+	if (_super::get_is_released()) return 1;
+
+	SAFE_RELEASE(this->_pimp);
+
+	return _super::release();
+}
+
+#pragma region Getters
+
+w_media_frame_converter_statistics w_media_frame_converter::get_statistics() const
+{
+	return this->_pimp ? this->_pimp->get_statistics() : w_media_frame_converter_statistics();
+}
+
+#pragma endregion
@@ -0,0 +1,151 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_media_frame_converter.h
+	Description		 : Converts decoded video frames to packed or planar pixel formats directly into memory of caller
+	Comment          : SwsContext is cached for each (source format, source size, destination format, destination size, flags)
+					   and rebuilt only when one of them changes. Frames which are not scaled are split into bands of rows,
+					   each band has its own cached SwsContext and will be converted on a worker of w_job_system.
+					   Swizzling between BGRA and RGBA bypasses swscale and is vectorized with AVX2, SSSE3, SSE2 or NEON
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_MEDIA_FRAME_CONVERTER_H__
+#define __W_MEDIA_FRAME_CONVERTER_H__
+
+#include "w_media_core_export.h"
+#include <w_object.h>
+#include <stdint.h>
+
+extern "C"
+{
+	#include <libavutil/frame.h>
+	#include <libavutil/pixfmt.h>
+	#include <libswscale/swscale.h>
+}
+
+namespace wolf
+{
+	namespace system
+	{
+		class w_job_system;
+	}
+
+	namespace framework
+	{
+		struct w_media_frame_converter_statistics
+		{
+			//number of converted frames
+			uint64_t	frames = 0;
+			//number of frames which have been swizzled without swscale
+			uint64_t	swizzled_frames = 0;
+			//number of frames which their planes have been copied without swscale
+			uint64_t	copied_frames = 0;
+			//number of frames which have been converted by sws_scale passes
+			uint64_t	scaled_frames = 0;
+			//number of times which SwsContext has been created because source or destination has been changed
+			uint32_t	context_rebuilds = 0;
+			//number of bands of the last frame
+			uint32_t	bands = 0;
+			double		last_convert_time_in_ms = 0.0;
+			double		total_convert_time_in_ms = 0.0;
+		};
+
+		class w_media_frame_converter_pimp;
+		class w_media_frame_converter : public system::w_object
+		{
+		public:
+			WMC_EXP w_media_frame_converter();
+			WMC_EXP virtual ~w_media_frame_converter();
+
+			/*
+				convert decoded frame and write it to destination memory, i.e. memory of caller or mapped staging buffer of GPU
+				@param pSource, decoded frame
+				@param pDestination, destination memory which must be at least pDestinationRowPitch * height bytes
+				@param pDestinationRowPitch, size of each row of destination in bytes
+				@param pDestinationFormat, packed destination format, i.e. AV_PIX_FMT_RGBA or AV_PIX_FMT_BGRA
+				@param pDestinationWidth, width of destination, zero means width of source
+				@param pDestinationHeight, height of destination, zero means height of source
+				@param pJobSystem, optional job system, if it is not null and frame is not scaled, bands of rows will be converted in parallel
+				@param pFlags, swscale flags which will be used for scaling
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WMC_EXP W_RESULT convert(
+				_In_ const AVFrame* pSource,
+				_Inout_ uint8_t* pDestination,
+				_In_ const uint32_t& pDestinationRowPitch,
+				_In_ const AVPixelFormat& pDestinationFormat,
+				_In_ const uint32_t& pDestinationWidth = 0,
+				_In_ const uint32_t& pDestinationHeight = 0,
+				_In_opt_ system::w_job_system* pJobSystem = nullptr,
+				_In_ const int& pFlags = SWS_BICUBIC);
+
+			/*
+				convert decoded frame and write each plane to its destination memory, i.e. planes of mapped staging buffer of GPU
+				which will be converted to RGB in shader. Planes of frames which have the same format and size will be copied
+				@param pSource, decoded frame
+				@param pDestinations, destination memory of each plane, unused planes must be null
+				@param pDestinationRowPitches, size of each row of each plane of destination in bytes
+				@param pDestinationFormat, packed or planar destination format, i.e. AV_PIX_FMT_RGBA or AV_PIX_FMT_YUV420P
+				@param pDestinationWidth, width of destination, zero means width of source
+				@param pDestinationHeight, height of destination, zero means height of source
+				@param pJobSystem, optional job system, if it is not null and frame is not scaled, bands of rows will be converted in parallel
+				@param pFlags, swscale flags which will be used for scaling
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WMC_EXP W_RESULT convert_planes(
+				_In_ const AVFrame* pSource,
+				_Inout_ uint8_t* const pDestinations[4],
+				_In_ const uint32_t pDestinationRowPitches[4],
+				_In_ const AVPixelFormat& pDestinationFormat,
+				_In_ const uint32_t& pDestinationWidth = 0,
+				_In_ const uint32_t& pDestinationHeight = 0,
+				_In_opt_ system::w_job_system* pJobSystem = nullptr,
+				_In_ const int& pFlags = SWS_BICUBIC);
+
+			/*
+				swap red and blue channels of 4 bytes pixels, converts BGRA to RGBA and vice versa
+				@param pSource, source pixels
+				@param pSourceRowPitch, size of each row of source in bytes
+				@param pDestination, destination pixels, it can be the same as source
+				@param pDestinationRowPitch, size of each row of destination in bytes
+				@param pWidth, width of image
+				@param pHeight, height of image
+				@param pJobSystem, optional job system, if it is not null rows will be swizzled in parallel chunks
+			*/
+			WMC_EXP static void swizzle_red_blue(
+				_In_ const uint8_t* pSource,
+				_In_ const uint32_t& pSourceRowPitch,
+				_Inout_ uint8_t* pDestination,
+				_In_ const uint32_t& pDestinationRowPitch,
+				_In_ const uint32_t& pWidth,
+				_In_ const uint32_t& pHeight,
+				_In_opt_ system::w_job_system* pJobSystem = nullptr);
+
+			//release all cached contexts
+			WMC_EXP ULONG release() override;
+
+#pragma region Getters
+
+			WMC_EXP w_media_frame_converter_statistics get_statistics() const;
+			//returns name of swizzle kernel which has been compiled, i.e. "avx2", "ssse3", "sse2", "neon" or "scalar"
+			WMC_EXP static const char* get_swizzle_kernel_name();
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_media_frame_converter(w_media_frame_converter const&);
+			w_media_frame_converter& operator= (w_media_frame_converter const&);
+
+			typedef	system::w_object								_super;
+			w_media_frame_converter_pimp*							_pimp;
+		};
+	}
+}
+
+#endif //__W_MEDIA_FRAME_CONVERTER_H__
@@ -0,0 +1,1117 @@
+#include "w_media_core_pch.h"
+#include "w_media_pipeline.h"
+#include "w_media_frame_converter.h"
+#include <w_spsc_queue.h>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+extern "C"
+{
+	#include <libavcodec/avcodec.h>
+	#include <libavformat/avformat.h>
+	#include <libswresample/swresample.h>
+	#include <libavutil/imgutils.h>
+	#include <libavutil/pixdesc.h>
+	#include <libavutil/channel_layout.h>
+}
+
+using namespace wolf::system;
+using namespace wolf::framework;
+
+typedef std::chrono::steady_clock w_clock;
+
+//number of yields before an idle stage starts sleeping
+static const uint32_t W_IDLE_SPINS = 64;
+//sleep of an idle stage, it is much shorter than one frame of 4K60
+static const std::chrono::microseconds W_IDLE_SLEEP(500);
+
+//yield for a while and then sleep, reset pSpins when stage did some work
+static inline void w_idle(_Inout_ uint32_t& pSpins)
+{
+	if (pSpins < W_IDLE_SPINS)
+	{
+		pSpins++;
+		std::this_thread::yield();
+	}
+	else
+	{
+		std::this_thread::sleep_for(W_IDLE_SLEEP);
+	}
+}
+
+static inline uint64_t w_elapsed_in_us(_In_ const w_clock::time_point& pStart)
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(w_clock::now() - pStart).count());
+}
+
+namespace wolf
+{
+	namespace framework
+	{
+		//a decoder with its own pool of packets
+		struct w_pipeline_decoder
+		{
+			int											stream_index = -1;
+			AVStream*									stream = nullptr;
+			AVCodecContext*								context = nullptr;
+			//demux pushes packets, decoder pops them
+			w_spsc_queue<AVPacket*>						packets;
+			//decoder returns empty packets, demux pops them
+			w_spsc_queue<AVPacket*>						free_packets;
+			std::vector<AVPacket*>						packets_storage;
+			std::thread									thread;
+			std::atomic<bool>							done;
+
+			w_pipeline_decoder() : done(false) {}
+		};
+
+		class w_media_pipeline_pimp
+		{
+		public:
+			w_media_pipeline_pimp() :
+				_name("w_media_pipeline"),
+				_job_system(nullptr),
+				_format_ctx(nullptr),
+				_swr(nullptr),
+				_pending_decoded_frame(nullptr),
+				_audio_frame(nullptr),
+				_video_width(0),
+				_video_height(0),
+				_video_frame_rate(0.0),
+				_duration_in_seconds(0.0),
+				_stop(false),
+				_demux_done(false),
+				_convert_done(false),
+				_demuxed_packets(0),
+				_decoded_video_frames(0),
+				_decoded_audio_frames(0),
+				_converted_video_frames(0),
+				_copied_video_frames(0),
+				_swizzled_video_frames(0),
+				_scaled_video_frames(0),
+				_stalls(0),
+				_dropped_audio_frames(0),
+				_decode_time_in_us(0),
+				_convert_time_in_us(0),
+				_skipped_video_frames(0),
+				_audio_consumed(false),
+				_audio_clock_pts(0.0),
+				_audio_clock_duration(0.0),
+				_has_audio_clock(false),
+				_has_wall_clock(false)
+			{
+			}
+
+			~w_media_pipeline_pimp()
+			{
+				release();
+			}
+
+			W_RESULT open(
+				_In_z_ const std::wstring& pMediaPath,
+				_In_ const w_media_pipeline_configs& pConfigs,
+				_In_opt_ w_job_system* pJobSystem)
+			{
+				const std::string _trace_info = this->_name + "::open";
+
+				release();
+
+				this->_configs = pConfigs;
+				this->_job_system = pJobSystem;
+
+				auto _path = wolf::system::convert::to_utf8(pMediaPath);
+				if (avformat_open_input(&this->_format_ctx, _path.c_str(), NULL, NULL) != 0)
+				{
+					V(W_FAILED, L"opening media " + pMediaPath, _trace_info, 3);
+					release();
+					return W_FAILED;
+				}
+				if (avformat_find_stream_info(this->_format_ctx, NULL) < 0)
+				{
+					V(W_FAILED, L"finding stream information of media " + pMediaPath, _trace_info, 3);
+					release();
+					return W_FAILED;
+				}
+
+				auto _video_index = av_find_best_stream(this->_format_ctx, AVMEDIA_TYPE_VIDEO, -1, -1, NULL, 0);
+				auto _audio_index = pConfigs.enable_audio ?
+					av_find_best_stream(this->_format_ctx, AVMEDIA_TYPE_AUDIO, -1, _video_index, NULL, 0) : -1;
+				if (_video_index < 0 && _audio_index < 0)
+				{
+					V(W_FAILED, L"media does not have any video or audio stream " + pMediaPath, _trace_info, 3);
+					release();
+					return W_FAILED;
+				}
+
+				if (this->_format_ctx->duration != AV_NOPTS_VALUE)
+				{
+					this->_duration_in_seconds = static_cast<double>(this->_format_ctx->duration) / AV_TIME_BASE;
+				}
+
+				if (_video_index >= 0)
+				{
+					if (_open_decoder(_video_index, this->_video) == W_FAILED)
+					{
+						release();
+						return W_FAILED;
+					}
+					if (_allocate_video() == W_FAILED)
+					{
+						release();
+						return W_FAILED;
+					}
+				}
+				if (_audio_index >= 0)
+				{
+					if (_open_decoder(_audio_index, this->_audio) == W_FAILED || _allocate_audio() == W_FAILED)
+					{
+						//play video without audio
+						logger.warning("could not open audio of media, media will be played without audio");
+						_release_decoder(this->_audio);
+					}
+				}
+
+				//start stages from the last one
+				if (this->_video.context)
+				{
+					this->_convert_thread = std::thread(&w_media_pipeline_pimp::_convert_loop, this);
+					this->_video.thread = std::thread(&w_media_pipeline_pimp::_video_decode_loop, this);
+				}
+				if (this->_audio.context)
+				{
+					this->_audio.thread = std::thread(&w_media_pipeline_pimp::_audio_decode_loop, this);
+				}
+				this->_demux_thread = std::thread(&w_media_pipeline_pimp::_demux_loop, this);
+
+				logger.write("media " + _path + " opened in pipeline, video: " +
+					std::to_string(this->_video_width) + "x" + std::to_string(this->_video_height) + "@" +
+					std::to_string(this->_video_frame_rate) + ", audio: " + (this->_audio.context ? "yes" : "no"));
+
+				return W_PASSED;
+			}
+
+			bool try_pop_latest_video_frame(_Inout_ w_media_video_frame& pFrame)
+			{
+				w_media_video_frame _frame;
+				if (!this->_ready_video_frames.try_pop(_frame)) return false;
+
+				w_media_video_frame _next;
+				while (this->_ready_video_frames.try_pop(_next))
+				{
+					release_video_frame(_frame);
+					this->_skipped_video_frames++;
+					_frame = _next;
+				}
+
+				_start_wall_clock(_frame.pts);
+				pFrame = _frame;
+				return true;
+			}
+
+			bool try_pop_video_frame_at(_In_ const double& pPTS, _Inout_ w_media_video_frame& pFrame)
+			{
+				auto _head = this->_ready_video_frames.peek();
+				if (!_head || _head->pts > pPTS) return false;
+
+				w_media_video_frame _frame;
+				this->_ready_video_frames.try_pop(_frame);
+
+				//skip the frames which have been passed
+				while ((_head = this->_ready_video_frames.peek()) != nullptr && _head->pts <= pPTS)
+				{
+					release_video_frame(_frame);
+					this->_skipped_video_frames++;
+					this->_ready_video_frames.try_pop(_frame);
+				}
+
+				pFrame = _frame;
+				return true;
+			}
+
+			bool try_pop_video_frame(_Inout_ w_media_video_frame& pFrame)
+			{
+				if (!this->_has_audio_clock && !this->_has_wall_clock)
+				{
+					//wall clock starts with the first frame
+					auto _head = this->_ready_video_frames.peek();
+					if (!_head) return false;
+					_start_wall_clock(_head->pts);
+				}
+				return try_pop_video_frame_at(get_clock(), pFrame);
+			}
+
+			void release_video_frame(_In_ const w_media_video_frame& pFrame)
+			{
+				if (pFrame.data == nullptr || pFrame.slot >= this->_video_slots.size()) return;
+				this->_free_video_slots.try_push(pFrame.slot);
+			}
+
+			bool try_pop_audio_frame(_Inout_ w_media_audio_frame& pFrame)
+			{
+				if (!this->_ready_audio_frames.try_pop(pFrame)) return false;
+				this->_audio_consumed.store(true, std::memory_order_release);
+
+				this->_audio_clock_pts = pFrame.pts;
+				this->_audio_clock_duration = pFrame.duration;
+				this->_audio_clock_time = w_clock::now();
+				this->_has_audio_clock = true;
+
+				return true;
+			}
+
+			void release_audio_frame(_In_ const w_media_audio_frame& pFrame)
+			{
+				if (pFrame.data == nullptr || pFrame.slot >= this->_audio_buffers.size()) return;
+				this->_free_audio_slots.try_push(pFrame.slot);
+			}
+
+			ULONG release()
+			{
+				//stop all stages
+				this->_stop.store(true, std::memory_order_release);
+				if (this->_demux_thread.joinable()) this->_demux_thread.join();
+				if (this->_video.thread.joinable()) this->_video.thread.join();
+				if (this->_audio.thread.joinable()) this->_audio.thread.join();
+				if (this->_convert_thread.joinable()) this->_convert_thread.join();
+
+				_release_decoder(this->_video);
+				_release_decoder(this->_audio);
+
+				for (auto& _frame : this->_decoded_frames_storage)
+				{
+					av_frame_free(&_frame);
+				}
+				this->_decoded_frames_storage.clear();
+				this->_pending_decoded_frame = nullptr;
+				if (this->_audio_frame)
+				{
+					av_frame_free(&this->_audio_frame);
+				}
+				if (this->_swr)
+				{
+					swr_free(&this->_swr);
+				}
+				if (this->_format_ctx)
+				{
+					avformat_close_input(&this->_format_ctx);
+				}
+
+				//queues may still hold frames and slots of released buffers
+				this->_decoded_frames.allocate(0);
+				this->_free_decoded_frames.allocate(0);
+				this->_ready_video_frames.allocate(0);
+				this->_free_video_slots.allocate(0);
+				this->_ready_audio_frames.allocate(0);
+				this->_free_audio_slots.allocate(0);
+
+				this->_video_buffers.clear();
+				this->_video_slots.clear();
+				this->_audio_buffers.clear();
+
+				this->_video_width = 0;
+				this->_video_height = 0;
+				this->_video_frame_rate = 0.0;
+				this->_duration_in_seconds = 0.0;
+
+				this->_demux_done.store(false);
+				this->_convert_done.store(false);
+				this->_demuxed_packets.store(0);
+				this->_decoded_video_frames.store(0);
+				this->_decoded_audio_frames.store(0);
+				this->_converted_video_frames.store(0);
+				this->_copied_video_frames.store(0);
+				this->_swizzled_video_frames.store(0);
+				this->_scaled_video_frames.store(0);
+				this->_stalls.store(0);
+				this->_dropped_audio_frames.store(0);
+				this->_decode_time_in_us.store(0);
+				this->_convert_time_in_us.store(0);
+				this->_skipped_video_frames = 0;
+				this->_audio_consumed.store(false);
+				this->_has_audio_clock = false;
+				this->_has_wall_clock = false;
+				this->_stop.store(false);
+
+				return 0;
+			}
+
+#pragma region Getters
+
+			double get_clock() const
+			{
+				if (this->_has_audio_clock)
+				{
+					//audio clock moves forward while the last popped audio frame is playing
+					auto _elapsed = std::chrono::duration<double>(w_clock::now() - this->_audio_clock_time).count();
+					return this->_audio_clock_pts + (_elapsed < this->_audio_clock_duration ? _elapsed : this->_audio_clock_duration);
+				}
+				if (this->_has_wall_clock)
+				{
+					return std::chrono::duration<double>(w_clock::now() - this->_wall_clock_origin).count();
+				}
+				return 0.0;
+			}
+
+			bool get_is_end_of_stream() const
+			{
+				if (!this->_format_ctx) return true;
+
+				auto _video_done = !this->_video.context ||
+					(this->_convert_done.load(std::memory_order_acquire) && this->_ready_video_frames.get_is_empty());
+				auto _audio_done = !this->_audio.context ||
+					(this->_audio.done.load(std::memory_order_acquire) && this->_ready_audio_frames.get_is_empty());
+				return _video_done && _audio_done;
+			}
+
+			bool get_has_video() const
+			{
+				return this->_video.context != nullptr;
+			}
+
+			bool get_has_audio() const
+			{
+				return this->_audio.context != nullptr;
+			}
+
+			uint32_t get_video_width() const
+			{
+				return this->_video_width;
+			}
+
+			uint32_t get_video_height() const
+			{
+				return this->_video_height;
+			}
+
+			double get_video_frame_rate() const
+			{
+				return this->_video_frame_rate;
+			}
+
+			double get_duration_in_seconds() const
+			{
+				return this->_duration_in_seconds;
+			}
+
+			w_media_pipeline_statistics get_statistics() const
+			{
+				w_media_pipeline_statistics _statistics;
+				_statistics.demuxed_packets = this->_demuxed_packets.load(std::memory_order_relaxed);
+				_statistics.decoded_video_frames = this->_decoded_video_frames.load(std::memory_order_relaxed);
+				_statistics.decoded_audio_frames = this->_decoded_audio_frames.load(std::memory_order_relaxed);
+				_statistics.converted_video_frames = this->_converted_video_frames.load(std::memory_order_relaxed);
+				_statistics.copied_video_frames = this->_copied_video_frames.load(std::memory_order_relaxed);
+				_statistics.swizzled_video_frames = this->_swizzled_video_frames.load(std::memory_order_relaxed);
+				_statistics.scaled_video_frames = this->_scaled_video_frames.load(std::memory_order_relaxed);
+				_statistics.skipped_video_frames = this->_skipped_video_frames;
+				_statistics.dropped_audio_frames = this->_dropped_audio_frames.load(std::memory_order_relaxed);
+				_statistics.stalls = this->_stalls.load(std::memory_order_relaxed);
+				_statistics.total_decode_time_in_ms = static_cast<double>(this->_decode_time_in_us.load(std::memory_order_relaxed)) / 1000.0;
+				_statistics.total_convert_time_in_ms = static_cast<double>(this->_convert_time_in_us.load(std::memory_order_relaxed)) / 1000.0;
+				return _statistics;
+			}
+
+#pragma endregion
+
+		private:
+
+			W_RESULT _open_decoder(_In_ const int& pStreamIndex, _Inout_ w_pipeline_decoder& pDecoder)
+			{
+				const std::string _trace_info = this->_name + "::_open_decoder";
+
+				auto _stream = this->_format_ctx->streams[pStreamIndex];
+				auto _codec = avcodec_find_decoder(_stream->codecpar->codec_id);
+				if (!_codec)
+				{
+					V(W_FAILED, "finding decoder " + std::string(avcodec_get_name(_stream->codecpar->codec_id)), _trace_info, 3);
+					return W_FAILED;
+				}
+
+				pDecoder.context = avcodec_alloc_context3(_codec);
+				if (!pDecoder.context)
+				{
+					V(W_FAILED, "allocating codec context", _trace_info, 3);
+					return W_FAILED;
+				}
+				if (avcodec_parameters_to_context(pDecoder.context, _stream->codecpar) < 0)
+				{
+					V(W_FAILED, "copying codec parameters", _trace_info, 3);
+					return W_FAILED;
+				}
+
+				//frame threading decodes several frames in parallel, slice threading splits each frame
+				pDecoder.context->thread_count = this->_configs.decoder_threads;
+				pDecoder.context->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+				pDecoder.context->pkt_timebase = _stream->time_base;
+
+				if (avcodec_open2(pDecoder.context, _codec, NULL) < 0)
+				{
+					V(W_FAILED, "opening decoder " + std::string(_codec->name), _trace_info, 3);
+					return W_FAILED;
+				}
+
+				pDecoder.stream_index = pStreamIndex;
+				pDecoder.stream = _stream;
+				pDecoder.done.store(false);
+
+				auto _size = this->_configs.packet_queue_size ? this->_configs.packet_queue_size : 1;
+				pDecoder.packets.allocate(_size);
+				pDecoder.free_packets.allocate(_size);
+				pDecoder.packets_storage.resize(_size, nullptr);
+				for (auto& _packet : pDecoder.packets_storage)
+				{
+					_packet = av_packet_alloc();
+					if (!_packet)
+					{
+						V(W_FAILED, "allocating packets", _trace_info, 3);
+						return W_FAILED;
+					}
+					pDecoder.free_packets.try_push(_packet);
+				}
+
+				return W_PASSED;
+			}
+
+			void _release_decoder(_Inout_ w_pipeline_decoder& pDecoder)
+			{
+				if (pDecoder.context)
+				{
+					avcodec_free_context(&pDecoder.context);
+				}
+				for (auto& _packet : pDecoder.packets_storage)
+				{
+					av_packet_free(&_packet);
+				}
+				pDecoder.packets_storage.clear();
+				pDecoder.packets.allocate(0);
+				pDecoder.free_packets.allocate(0);
+				pDecoder.stream_index = -1;
+				pDecoder.stream = nullptr;
+				pDecoder.done.store(false);
+			}
+
+			W_RESULT _allocate_video()
+			{
+				const std::string _trace_info = this->_name + "::_allocate_video";
+
+				auto _context = this->_video.context;
+				this->_video_width = this->_configs.video_width ? this->_configs.video_width : static_cast<uint32_t>(_context->width);
+				this->_video_height = this->_configs.video_height ? this->_configs.video_height : static_cast<uint32_t>(_context->height);
+
+				auto _format = this->_configs.video_format;
+				auto _desc = av_pix_fmt_desc_get(_format);
+				auto _planes = av_pix_fmt_count_planes(_format);
+				if (!_desc || _planes <= 0 || _planes > 3 || this->_video_height == 0)
+				{
+					V(W_FAILED, "invalid size or format of video frames", _trace_info, 3);
+					return W_FAILED;
+				}
+				//minimum row pitch and number of rows of each plane
+				int _line_sizes[3] = { 0, 0, 0 };
+				uint32_t _rows[3] = { 0, 0, 0 };
+				for (int p = 0; p < _planes; ++p)
+				{
+					_line_sizes[p] = av_image_get_linesize(_format, static_cast<int>(this->_video_width), p);
+					if (_line_sizes[p] <= 0)
+					{
+						V(W_FAILED, "invalid size or format of video frames", _trace_info, 3);
+						return W_FAILED;
+					}
+					_rows[p] = (p == 1 || p == 2) ?
+						static_cast<uint32_t>(AV_CEIL_RSHIFT(static_cast<int>(this->_video_height), _desc->log2_chroma_h)) : this->_video_height;
+				}
+				this->_video_frame_rate = av_q2d(av_guess_frame_rate(this->_format_ctx, this->_video.stream, NULL));
+
+				//pooled AVFrames between decoder and converter
+				auto _decoded_frames = this->_configs.decoded_frame_pool_size ? this->_configs.decoded_frame_pool_size : 1;
+				this->_decoded_frames.allocate(_decoded_frames);
+				this->_free_decoded_frames.allocate(_decoded_frames);
+				this->_decoded_frames_storage.resize(_decoded_frames, nullptr);
+				for (auto& _frame : this->_decoded_frames_storage)
+				{
+					_frame = av_frame_alloc();
+					if (!_frame)
+					{
+						V(W_FAILED, "allocating decoded frames", _trace_info, 3);
+						return W_FAILED;
+					}
+					this->_free_decoded_frames.try_push(_frame);
+				}
+
+				//pooled buffers of converted frames, either external buffers of caller or owned ones
+				auto& _external = this->_configs.video_buffers;
+				if (!_external.empty())
+				{
+					if (!this->_configs.video_width || !this->_configs.video_height)
+					{
+						V(W_FAILED, "video_width and video_height must be set for external video buffers", _trace_info, 3);
+						return W_FAILED;
+					}
+					for (auto& _buffer : _external)
+					{
+						for (int p = 0; p < _planes; ++p)
+						{
+							if (!_buffer.planes[p] || _buffer.row_pitches[p] < static_cast<uint32_t>(_line_sizes[p]))
+							{
+								V(W_FAILED, "plane " + std::to_string(p) + " of external video buffer is null or its row pitch is too small", _trace_info, 3);
+								return W_FAILED;
+							}
+						}
+					}
+					this->_video_slots = _external;
+				}
+				else
+				{
+					auto _pool_size = this->_configs.video_frame_pool_size ? this->_configs.video_frame_pool_size : 1;
+					this->_video_buffers.resize(_pool_size);
+					this->_video_slots.resize(_pool_size);
+					for (uint32_t i = 0; i < _pool_size; ++i)
+					{
+						size_t _size = 0;
+						for (int p = 0; p < _planes; ++p)
+						{
+							_size += static_cast<size_t>(_line_sizes[p]) * _rows[p];
+						}
+						this->_video_buffers[i].resize(_size);
+
+						auto _data = this->_video_buffers[i].data();
+						for (int p = 0; p < _planes; ++p)
+						{
+							this->_video_slots[i].planes[p] = _data;
+							this->_video_slots[i].row_pitches[p] = static_cast<uint32_t>(_line_sizes[p]);
+							_data += static_cast<size_t>(_line_sizes[p]) * _rows[p];
+						}
+					}
+				}
+
+				auto _video_frames = static_cast<uint32_t>(this->_video_slots.size());
+				this->_ready_video_frames.allocate(_video_frames);
+				this->_free_video_slots.allocate(_video_frames);
+				for (uint32_t i = 0; i < _video_frames; ++i)
+				{
+					this->_free_video_slots.try_push(i);
+				}
+
+				return W_PASSED;
+			}
+
+			W_RESULT _allocate_audio()
+			{
+				const std::string _trace_info = this->_name + "::_allocate_audio";
+
+				auto _context = this->_audio.context;
+				auto _channel_layout = _context->channel_layout ?
+					static_cast<int64_t>(_context->channel_layout) : av_get_default_channel_layout(_context->channels);
+
+				//interleaved signed 16 bits stereo
+				this->_swr = swr_alloc_set_opts(
+					NULL,
+					AV_CH_LAYOUT_STEREO,
+					AV_SAMPLE_FMT_S16,
+					_context->sample_rate,
+					_channel_layout,
+					_context->sample_fmt,
+					_context->sample_rate,
+					0,
+					NULL);
+				if (!this->_swr || swr_init(this->_swr) < 0)
+				{
+					V(W_FAILED, "creating audio resampler", _trace_info, 3);
+					return W_FAILED;
+				}
+
+				this->_audio_frame = av_frame_alloc();
+				if (!this->_audio_frame)
+				{
+					V(W_FAILED, "allocating audio frame", _trace_info, 3);
+					return W_FAILED;
+				}
+
+				//buffers will grow on the audio decoder thread if a frame does not fit
+				auto _audio_frames = this->_configs.audio_frame_pool_size ? this->_configs.audio_frame_pool_size : 1;
+				this->_ready_audio_frames.allocate(_audio_frames);
+				this->_free_audio_slots.allocate(_audio_frames);
+				this->_audio_buffers.resize(_audio_frames);
+				for (uint32_t i = 0; i < _audio_frames; ++i)
+				{
+					this->_audio_buffers[i].resize(4096 * 2 * sizeof(int16_t));
+					this->_free_audio_slots.try_push(i);
+				}
+
+				return W_PASSED;
+			}
+
+			//wait for an item of a queue which is filled by a later stage, returns false if pipeline is stopping
+			template<typename T>
+			bool _wait_for(_Inout_ w_spsc_queue<T>& pQueue, _Inout_ T& pItem)
+			{
+				if (pQueue.try_pop(pItem)) return true;
+
+				this->_stalls.fetch_add(1, std::memory_order_relaxed);
+				uint32_t _spins = 0;
+				while (!pQueue.try_pop(pItem))
+				{
+					if (this->_stop.load(std::memory_order_acquire)) return false;
+					w_idle(_spins);
+				}
+				return true;
+			}
+
+			//stage 1, reads packets and moves them to pooled packets of decoders
+			void _demux_loop()
+			{
+				auto _packet = av_packet_alloc();
+				while (_packet && !this->_stop.load(std::memory_order_acquire))
+				{
+					auto _hr = av_read_frame(this->_format_ctx, _packet);
+					if (_hr < 0)
+					{
+						if (_hr != AVERROR_EOF)
+						{
+							logger.error("error while reading packets of media, stream will be ended");
+						}
+						break;
+					}
+					this->_demuxed_packets.fetch_add(1, std::memory_order_relaxed);
+
+					w_pipeline_decoder* _decoder = nullptr;
+					if (this->_video.context && _packet->stream_index == this->_video.stream_index)
+					{
+						_decoder = &this->_video;
+					}
+					else if (this->_audio.context && _packet->stream_index == this->_audio.stream_index)
+					{
+						_decoder = &this->_audio;
+					}
+
+					AVPacket* _pooled = nullptr;
+					if (_decoder && _wait_for(_decoder->free_packets, _pooled))
+					{
+						av_packet_move_ref(_pooled, _packet);
+						_decoder->packets.try_push(_pooled);
+					}
+					else
+					{
+						av_packet_unref(_packet);
+					}
+				}
+				av_packet_free(&_packet);
+				this->_demux_done.store(true, std::memory_order_release);
+			}
+
+			//runs decode loop of send/receive API, pOnFrame will be called for each decoded frame
+			template<typename F>
+			void _decode_loop(_Inout_ w_pipeline_decoder& pDecoder, _In_ const F& pOnFrame)
+			{
+				uint32_t _spins = 0;
+				while (!this->_stop.load(std::memory_order_acquire))
+				{
+					//all packets have been pushed before demux was marked as done
+					auto _demux_done = this->_demux_done.load(std::memory_order_acquire);
+
+					AVPacket* _packet = nullptr;
+					if (!pDecoder.packets.try_pop(_packet))
+					{
+						if (_demux_done) break;
+						w_idle(_spins);
+						continue;
+					}
+					_spins = 0;
+
+					_send_packet(pDecoder, _packet, pOnFrame);
+
+					av_packet_unref(_packet);
+					pDecoder.free_packets.try_push(_packet);
+				}
+
+				//drain frames which are still inside decoder
+				if (!this->_stop.load(std::memory_order_acquire))
+				{
+					_send_packet(pDecoder, nullptr, pOnFrame);
+				}
+				pDecoder.done.store(true, std::memory_order_release);
+			}
+
+			template<typename F>
+			void _send_packet(_Inout_ w_pipeline_decoder& pDecoder, _In_opt_ const AVPacket* pPacket, _In_ const F& pOnFrame)
+			{
+				auto _start = w_clock::now();
+				for (;;)
+				{
+					auto _hr = avcodec_send_packet(pDecoder.context, pPacket);
+					if (_hr == AVERROR(EAGAIN))
+					{
+						//decoder is full, receive frames and send the packet again
+						if (!pOnFrame()) break;
+						continue;
+					}
+					if (_hr < 0 && _hr != AVERROR_EOF)
+					{
+						logger.warning("could not send packet to decoder, packet will be skipped");
+					}
+					break;
+				}
+				while (pOnFrame()) {}
+				this->_decode_time_in_us.fetch_add(w_elapsed_in_us(_start), std::memory_order_relaxed);
+			}
+
+			//stage 2 of video, decodes packets into pooled AVFrames
+			void _video_decode_loop()
+			{
+				_decode_loop(this->_video, [this]() -> bool
+				{
+					if (!this->_pending_decoded_frame && !_wait_for(this->_free_decoded_frames, this->_pending_decoded_frame))
+					{
+						return false;
+					}
+					if (avcodec_receive_frame(this->_video.context, this->_pending_decoded_frame) < 0) return false;
+
+					this->_decoded_video_frames.fetch_add(1, std::memory_order_relaxed);
+					this->_decoded_frames.try_push(this->_pending_decoded_frame);
+					this->_pending_decoded_frame = nullptr;
+					return true;
+				});
+			}
+
+			//stage 3 of video, converts pooled AVFrames into pooled buffers of consumer
+			void _convert_loop()
+			{
+				const auto _time_base = av_q2d(this->_video.stream->time_base);
+				const auto _frame_duration = this->_video_frame_rate > 0.0 ? 1.0 / this->_video_frame_rate : 0.0;
+
+				uint64_t _index = 0;
+				double _next_pts = 0.0;
+				uint32_t _spins = 0;
+				//slot which has been popped but not pushed to consumer
+				uint32_t _slot = 0;
+				bool _has_slot = false;
+				while (!this->_stop.load(std::memory_order_acquire))
+				{
+					auto _decode_done = this->_video.done.load(std::memory_order_acquire);
+
+					AVFrame* _decoded = nullptr;
+					if (!this->_decoded_frames.try_pop(_decoded))
+					{
+						if (_decode_done) break;
+						w_idle(_spins);
+						continue;
+					}
+					_spins = 0;
+
+					if (!_has_slot && !_wait_for(this->_free_video_slots, _slot))
+					{
+						av_frame_unref(_decoded);
+						this->_free_decoded_frames.try_push(_decoded);
+						break;
+					}
+					_has_slot = true;
+
+					auto _start = w_clock::now();
+
+					auto& _buffer = this->_video_slots[_slot];
+					w_media_video_frame _frame;
+					_frame.data = _buffer.planes[0];
+					_frame.width = this->_video_width;
+					_frame.height = this->_video_height;
+					_frame.row_pitch = _buffer.row_pitches[0];
+					for (int p = 0; p < 3; ++p)
+					{
+						_frame.planes[p] = _buffer.planes[p];
+						_frame.row_pitches[p] = _buffer.row_pitches[p];
+					}
+					_frame.slot = _slot;
+					_frame.index = _index++;
+
+					auto _timestamp = _decoded->best_effort_timestamp;
+					_frame.pts = _timestamp != AV_NOPTS_VALUE ? static_cast<double>(_timestamp) * _time_base : _next_pts;
+					_frame.duration = _decoded->pkt_duration > 0 ? static_cast<double>(_decoded->pkt_duration) * _time_base : _frame_duration;
+					_next_pts = _frame.pts + _frame.duration;
+
+					uint8_t* const _planes[4] = { _buffer.planes[0], _buffer.planes[1], _buffer.planes[2], nullptr };
+					const uint32_t _row_pitches[4] = { _buffer.row_pitches[0], _buffer.row_pitches[1], _buffer.row_pitches[2], 0 };
+					//statistics of converter are owned by this thread, so the path of this frame is the difference of them
+					auto _before = this->_converter.get_statistics();
+					if (this->_converter.convert_planes(
+						_decoded,
+						_planes,
+						_row_pitches,
+						this->_configs.video_format,
+						this->_video_width,
+						this->_video_height,
+						this->_job_system) == W_FAILED)
+					{
+						//keep the slot for the next frame
+						logger.error("could not convert video frame, frame will be skipped");
+					}
+					else
+					{
+						auto _after = this->_converter.get_statistics();
+						this->_converted_video_frames.fetch_add(1, std::memory_order_relaxed);
+						this->_copied_video_frames.fetch_add(_after.copied_frames - _before.copied_frames, std::memory_order_relaxed);
+						this->_swizzled_video_frames.fetch_add(_after.swizzled_frames - _before.swizzled_frames, std::memory_order_relaxed);
+						this->_scaled_video_frames.fetch_add(_after.scaled_frames - _before.scaled_frames, std::memory_order_relaxed);
+						this->_ready_video_frames.try_push(_frame);
+						_has_slot = false;
+					}
+
+					av_frame_unref(_decoded);
+					this->_free_decoded_frames.try_push(_decoded);
+
+					this->_convert_time_in_us.fetch_add(w_elapsed_in_us(_start), std::memory_order_relaxed);
+				}
+				this->_convert_done.store(true, std::memory_order_release);
+			}
+
+			//stage 2 of audio, decodes and resamples packets into pooled buffers of consumer
+			void _audio_decode_loop()
+			{
+				const auto _time_base = av_q2d(this->_audio.stream->time_base);
+				double _next_pts = 0.0;
+
+				_decode_loop(this->_audio, [this, _time_base, &_next_pts]() -> bool
+				{
+					if (avcodec_receive_frame(this->_audio.context, this->_audio_frame) < 0) return false;
+					this->_decoded_audio_frames.fetch_add(1, std::memory_order_relaxed);
+
+					uint32_t _slot = 0;
+					if (!this->_free_audio_slots.try_pop(_slot))
+					{
+						if (!this->_audio_consumed.load(std::memory_order_acquire))
+						{
+							//consumer does not pop audio, drop the frame instead of stalling demuxer and video
+							this->_dropped_audio_frames.fetch_add(1, std::memory_order_relaxed);
+							av_frame_unref(this->_audio_frame);
+							return true;
+						}
+						if (!_wait_for(this->_free_audio_slots, _slot))
+						{
+							av_frame_unref(this->_audio_frame);
+							return false;
+						}
+					}
+
+					auto _sample_rate = this->_audio.context->sample_rate;
+					auto _out_samples = swr_get_out_samples(this->_swr, this->_audio_frame->nb_samples);
+					auto& _buffer = this->_audio_buffers[_slot];
+					auto _needed = static_cast<size_t>(_out_samples > 0 ? _out_samples : 0) * 2 * sizeof(int16_t);
+					if (_buffer.size() < _needed) _buffer.resize(_needed);
+
+					auto _data = _buffer.data();
+					auto _samples = swr_convert(
+						this->_swr,
+						&_data,
+						_out_samples,
+						(const uint8_t**)this->_audio_frame->extended_data,
+						this->_audio_frame->nb_samples);
+
+					w_media_audio_frame _frame;
+					_frame.data = _data;
+					_frame.samples = static_cast<uint32_t>(_samples > 0 ? _samples : 0);
+					_frame.channels = 2;
+					_frame.sample_rate = static_cast<uint32_t>(_sample_rate);
+					_frame.size_in_bytes = _frame.samples * _frame.channels * sizeof(int16_t);
+					_frame.slot = _slot;
+
+					auto _timestamp = this->_audio_frame->best_effort_timestamp;
+					_frame.pts = _timestamp != AV_NOPTS_VALUE ? static_cast<double>(_timestamp) * _time_base : _next_pts;
+					_frame.duration = _sample_rate > 0 ? static_cast<double>(_frame.samples) / _sample_rate : 0.0;
+					_next_pts = _frame.pts + _frame.duration;
+
+					av_frame_unref(this->_audio_frame);
+					this->_ready_audio_frames.try_push(_frame);
+					return true;
+				});
+			}
+
+			void _start_wall_clock(_In_ const double& pPTS)
+			{
+				if (this->_has_wall_clock) return;
+				this->_wall_clock_origin = w_clock::now() -
+					std::chrono::duration_cast<w_clock::duration>(std::chrono::duration<double>(pPTS));
+				this->_has_wall_clock = true;
+			}
+
+			std::string											_name;
+			w_media_pipeline_configs							_configs;
+			w_job_system*										_job_system;
+
+			AVFormatContext*									_format_ctx;
+			w_pipeline_decoder									_video;
+			w_pipeline_decoder									_audio;
+			struct SwrContext*									_swr;
+			w_media_frame_converter								_converter;
+
+			//decoder pushes decoded frames, converter pops them
+			w_spsc_queue<AVFrame*>								_decoded_frames;
+			//converter returns unreferenced frames, decoder pops them
+			w_spsc_queue<AVFrame*>								_free_decoded_frames;
+			std::vector<AVFrame*>								_decoded_frames_storage;
+			//owned by video decoder
+			AVFrame*											_pending_decoded_frame;
+			//owned by audio decoder
+			AVFrame*											_audio_frame;
+
+			//converter pushes converted frames, consumer pops them
+			w_spsc_queue<w_media_video_frame>					_ready_video_frames;
+			//consumer returns slots of released frames, converter pops them
+			w_spsc_queue<uint32_t>								_free_video_slots;
+			//owned storage of slots when caller did not pass video buffers
+			std::vector<std::vector<uint8_t>>					_video_buffers;
+			//planes of each slot of converted frames
+			std::vector<w_media_video_buffer>					_video_slots;
+
+			w_spsc_queue<w_media_audio_frame>					_ready_audio_frames;
+			w_spsc_queue<uint32_t>								_free_audio_slots;
+			std::vector<std::vector<uint8_t>>					_audio_buffers;
+
+			uint32_t											_video_width;
+			uint32_t											_video_height;
+			double												_video_frame_rate;
+			double												_duration_in_seconds;
+
+			std::thread											_demux_thread;
+			std::thread											_convert_thread;
+			std::atomic<bool>									_stop;
+			std::atomic<bool>									_demux_done;
+			std::atomic<bool>									_convert_done;
+
+			std::atomic<uint64_t>								_demuxed_packets;
+			std::atomic<uint64_t>								_decoded_video_frames;
+			std::atomic<uint64_t>								_decoded_audio_frames;
+			std::atomic<uint64_t>								_converted_video_frames;
+			std::atomic<uint64_t>								_copied_video_frames;
+			std::atomic<uint64_t>								_swizzled_video_frames;
+			std::atomic<uint64_t>								_scaled_video_frames;
+			std::atomic<uint64_t>								_stalls;
+			std::atomic<uint64_t>								_dropped_audio_frames;
+			std::atomic<uint64_t>								_decode_time_in_us;
+			std::atomic<uint64_t>								_convert_time_in_us;
+
+			//owned by consumer
+			uint64_t											_skipped_video_frames;
+			//set by consumer at first popped audio frame
+			std::atomic<bool>									_audio_consumed;
+			double												_audio_clock_pts;
+			double												_audio_clock_duration;
+			w_clock::time_point									_audio_clock_time;
+			bool												_has_audio_clock;
+			w_clock::time_point									_wall_clock_origin;
+			bool												_has_wall_clock;
+		};
+	}
+}
+
+w_media_pipeline::w_media_pipeline() :
+	_pimp(new w_media_pipeline_pimp())
+{
+	_super::set_class_name("w_media_pipeline");
+}
+
+w_media_pipeline::~w_media_pipeline()
+{
+	release();
+}
+
+W_RESULT w_media_pipeline::open(
+	_In_z_ const std::wstring& pMediaPath,
+	_In_ const w_media_pipeline_configs& pConfigs,
+	_In_opt_ w_job_system* pJobSystem)
+{
+	return this->_pimp ? this->_pimp->open(pMediaPath, pConfigs, pJobSystem) : W_FAILED;
+}
+
+bool w_media_pipeline::try_pop_latest_video_frame(_Inout_ w_media_video_frame& pFrame)
+{
+	return this->_pimp ? this->_pimp->try_pop_latest_video_frame(pFrame) : false;
+}
+
+bool w_media_pipeline::try_pop_video_frame_at(_In_ const double& pPTS, _Inout_ w_media_video_frame& pFrame)
+{
+	return this->_pimp ? this->_pimp->try_pop_video_frame_at(pPTS, pFrame) : false;
+}
+
+bool w_media_pipeline::try_pop_video_frame(_Inout_ w_media_video_frame& pFrame)
+{
+	return this->_pimp ? this->_pimp->try_pop_video_frame(pFrame) : false;
+}
+
+void w_media_pipeline::release_video_frame(_In_ const w_media_video_frame& pFrame)
+{
+	if (this->_pimp)
+	{
+		this->_pimp->release_video_frame(pFrame);
+	}
+}
+
+bool w_media_pipeline::try_pop_audio_frame(_Inout_ w_media_audio_frame& pFrame)
+{
+	return this->_pimp ? this->_pimp->try_pop_audio_frame(pFrame) : false;
+}
+
+void w_media_pipeline::release_audio_frame(_In_ const w_media_audio_frame& pFrame)
+{
+	if (this->_pimp)
+	{
+		this->_pimp->release_audio_frame(pFrame);
+	}
+}
+
+ULONG w_media_pipeline::release()
+{
+	if (_super::get_is_released()) return 1;
+
+	SAFE_RELEASE(this->_pimp);
+
+	return _super::release();
+}
+
+#pragma region Getters
+
+double w_media_pipeline::get_clock() const
+{
+	return this->_pimp ? this->_pimp->get_clock() : 0.0;
+}
+
+bool w_media_pipeline::get_is_end_of_stream() const
+{
+	return this->_pimp ? this->_pimp->get_is_end_of_stream() : true;
+}
+
+bool w_media_pipeline::get_has_video() const
+{
+	return this->_pimp ? this->_pimp->get_has_video() : false;
+}
+
+bool w_media_pipeline::get_has_audio() const
+{
+	return this->_pimp ? this->_pimp->get_has_audio() : false;
+}
+
+uint32_t w_media_pipeline::get_video_width() const
+{
+	return this->_pimp ? this->_pimp->get_video_width() : 0;
+}
+
+uint32_t w_media_pipeline::get_video_height() const
+{
+	return this->_pimp ? this->_pimp->get_video_height() : 0;
+}
+
+double w_media_pipeline::get_video_frame_rate() const
+{
+	return this->_pimp ? this->_pimp->get_video_frame_rate() : 0.0;
+}
+
+double w_media_pipeline::get_duration_in_seconds() const
+{
+	return this->_pimp ? this->_pimp->get_duration_in_seconds() : 0.0;
+}
+
+w_media_pipeline_statistics w_media_pipeline::get_statistics() const
+{
+	return this->_pimp ? this->_pimp->get_statistics() : w_media_pipeline_statistics();
+}
+
+#pragma endregion
@@ -0,0 +1,203 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_media_pipeline.h
+	Description		 : A cross platform playback pipeline which demuxes, decodes and converts media on its own threads
+	Comment          : Demux, video decode, video convert and audio decode stages run on separate threads and are connected
+					   with bounded lock free queues. Decoders use send/receive API with frame and slice threading,
+					   AVPackets and AVFrames are pooled and converted frames are written into pooled buffers,
+					   so nothing will be allocated per frame after open. Consumer pops the latest frame or the frame
+					   at a given pts without blocking, and the master clock follows audio when audio is consumed
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_MEDIA_PIPELINE_H__
+#define __W_MEDIA_PIPELINE_H__
+
+#include "w_media_core_export.h"
+#include <w_object.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+extern "C"
+{
+	#include <libavutil/pixfmt.h>
+}
+
+namespace wolf
+{
+	namespace system
+	{
+		class w_job_system;
+	}
+
+	namespace framework
+	{
+		struct w_media_video_buffer
+		{
+			//planes of a converted frame, packed formats only use the first plane
+			uint8_t*		planes[3] = { nullptr, nullptr, nullptr };
+			uint32_t		row_pitches[3] = { 0, 0, 0 };
+		};
+
+		struct w_media_pipeline_configs
+		{
+			//pixel format of converted video frames, packed or planar e.g. AV_PIX_FMT_RGBA or AV_PIX_FMT_YUV420P
+			AVPixelFormat	video_format = AV_PIX_FMT_RGBA;
+			//size of converted video frames, zero means size of source
+			uint32_t		video_width = 0;
+			uint32_t		video_height = 0;
+			//number of demuxed packets which can be queued for each decoder
+			uint32_t		packet_queue_size = 128;
+			//number of pooled AVFrames between video decoder and converter
+			uint32_t		decoded_frame_pool_size = 4;
+			//number of converted video frames which can be ready for consumer, must be bigger than number of frames which consumer holds
+			uint32_t		video_frame_pool_size = 4;
+			//number of converted audio frames which can be ready for consumer
+			uint32_t		audio_frame_pool_size = 32;
+			//number of decoder threads, zero means ffmpeg picks it from number of cores
+			int				decoder_threads = 0;
+			/*
+				decode and output audio, audio frames are interleaved signed 16 bits stereo.
+				Consumer must pop audio frames, until the first pop audio frames are dropped when audio pool is full
+			*/
+			bool			enable_audio = false;
+			/*
+				optional buffers which converted frames will be written into, e.g. mapped staging memory of w_video_texture.
+				Each buffer is one slot of pool and replaces video_frame_pool_size, video_width and video_height must be set
+				and buffers must be valid until release. Empty means pipeline allocates its own buffers
+			*/
+			std::vector<w_media_video_buffer>	video_buffers;
+		};
+
+		struct w_media_video_frame
+		{
+			//first plane, same as planes[0]
+			uint8_t*		data = nullptr;
+			uint32_t		width = 0;
+			uint32_t		height = 0;
+			uint32_t		row_pitch = 0;
+			//all planes of frame, chroma planes of planar formats are subsampled
+			uint8_t*		planes[3] = { nullptr, nullptr, nullptr };
+			uint32_t		row_pitches[3] = { 0, 0, 0 };
+			//presentation time and duration in seconds
+			double			pts = 0.0;
+			double			duration = 0.0;
+			uint64_t		index = 0;
+			//index of pooled buffer, used by release_video_frame
+			uint32_t		slot = 0;
+		};
+
+		struct w_media_audio_frame
+		{
+			uint8_t*		data = nullptr;
+			uint32_t		size_in_bytes = 0;
+			uint32_t		samples = 0;
+			uint32_t		channels = 0;
+			uint32_t		sample_rate = 0;
+			//presentation time and duration in seconds
+			double			pts = 0.0;
+			double			duration = 0.0;
+			//index of pooled buffer, used by release_audio_frame
+			uint32_t		slot = 0;
+		};
+
+		struct w_media_pipeline_statistics
+		{
+			uint64_t	demuxed_packets = 0;
+			uint64_t	decoded_video_frames = 0;
+			uint64_t	decoded_audio_frames = 0;
+			uint64_t	converted_video_frames = 0;
+			//number of converted frames which their planes have been copied into slots without swscale
+			uint64_t	copied_video_frames = 0;
+			//number of converted frames which have been swizzled into slots without swscale
+			uint64_t	swizzled_video_frames = 0;
+			//number of converted frames which have been written into slots by sws_scale
+			uint64_t	scaled_video_frames = 0;
+			//number of ready frames which have been skipped by try_pop_latest_video_frame or try_pop_video_frame_at
+			uint64_t	skipped_video_frames = 0;
+			//number of decoded audio frames which have been dropped because consumer did not pop audio frames
+			uint64_t	dropped_audio_frames = 0;
+			//number of times which a stage waited because the next queue was full or its pool was empty
+			uint64_t	stalls = 0;
+			double		total_decode_time_in_ms = 0.0;
+			double		total_convert_time_in_ms = 0.0;
+		};
+
+		class w_media_pipeline_pimp;
+		class w_media_pipeline : public system::w_object
+		{
+		public:
+			WMC_EXP w_media_pipeline();
+			WMC_EXP virtual ~w_media_pipeline();
+
+			/*
+				open media and start the pipeline threads, make sure w_media_core::register_all has been called once before
+				@param pMediaPath, path of media
+				@param pConfigs, configs of pipeline
+				@param pJobSystem, optional job system which converts bands of rows of each video frame in parallel
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			WMC_EXP W_RESULT open(
+				_In_z_ const std::wstring& pMediaPath,
+				_In_ const w_media_pipeline_configs& pConfigs,
+				_In_opt_ system::w_job_system* pJobSystem = nullptr);
+
+			//non blocking, skips all ready frames except the newest one. Returned frame must be released with release_video_frame
+			WMC_EXP bool try_pop_latest_video_frame(_Inout_ w_media_video_frame& pFrame);
+
+			/*
+				non blocking, returns the frame which must be shown at pPTS and skips the older ones
+				returns false when no frame is ready or the next ready frame starts after pPTS
+				Returned frame must be released with release_video_frame
+			*/
+			WMC_EXP bool try_pop_video_frame_at(_In_ const double& pPTS, _Inout_ w_media_video_frame& pFrame);
+
+			//non blocking, returns the frame which must be shown at current master clock
+			WMC_EXP bool try_pop_video_frame(_Inout_ w_media_video_frame& pFrame);
+
+			//return pooled buffer of video frame to the pipeline
+			WMC_EXP void release_video_frame(_In_ const w_media_video_frame& pFrame);
+
+			//non blocking, returns the next audio frame and moves audio clock to its pts. Returned frame must be released with release_audio_frame
+			WMC_EXP bool try_pop_audio_frame(_Inout_ w_media_audio_frame& pFrame);
+
+			//return pooled buffer of audio frame to the pipeline
+			WMC_EXP void release_audio_frame(_In_ const w_media_audio_frame& pFrame);
+
+			//stop all threads and release all resources
+			WMC_EXP ULONG release() override;
+
+#pragma region Getters
+
+			//master clock in seconds, follows audio frames which have been popped, otherwise the wall clock since the first popped video frame
+			WMC_EXP double get_clock() const;
+			//returns true when all packets have been demuxed, decoded, converted and popped
+			WMC_EXP bool get_is_end_of_stream() const;
+			WMC_EXP bool get_has_video() const;
+			WMC_EXP bool get_has_audio() const;
+			WMC_EXP uint32_t get_video_width() const;
+			WMC_EXP uint32_t get_video_height() const;
+			WMC_EXP double get_video_frame_rate() const;
+			WMC_EXP double get_duration_in_seconds() const;
+			WMC_EXP w_media_pipeline_statistics get_statistics() const;
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_media_pipeline(w_media_pipeline const&);
+			w_media_pipeline& operator= (w_media_pipeline const&);
+
+			typedef	system::w_object								_super;
+			w_media_pipeline_pimp*									_pimp;
+		};
+	}
+}
+
+#endif //__W_MEDIA_PIPELINE_H__
@@ -0,0 +1,738 @@
+#include "w_media_core_pch.h"
+#include "w_media_stream_server.h"
+#include <w_spsc_queue.h>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <cstring>
+
+extern "C"
+{
+	#include <libavutil/imgutils.h>
+}
+
+using namespace wolf::system;
+using namespace wolf::framework;
+
+typedef std::chrono::steady_clock w_clock;
+
+//number of yields before an idle stage starts sleeping
+static const uint32_t W_IDLE_SPINS = 64;
+static const std::chrono::microseconds W_IDLE_SLEEP(250);
+//size of ring which maps pts of frames to their capture time, must be bigger than delay of encoder
+static const size_t W_CAPTURE_TIMES_SIZE = 256;
+//number of consecutive failed writes which means connection has been lost
+static const uint32_t W_MAX_WRITE_ERRORS = 8;
+
+static inline void w_idle(_Inout_ uint32_t& pSpins)
+{
+	if (pSpins < W_IDLE_SPINS)
+	{
+		pSpins++;
+		std::this_thread::yield();
+	}
+	else
+	{
+		std::this_thread::sleep_for(W_IDLE_SLEEP);
+	}
+}
+
+namespace wolf
+{
+	namespace framework
+	{
+		//a picture which has been filled and must be encoded repeat + 1 times
+		struct w_stream_frame_job
+		{
+			uint32_t									slot = 0;
+			int64_t										pts = 0;
+			int64_t										repeat = 0;
+			w_clock::time_point							capture_time;
+		};
+
+		struct w_stream_packet
+		{
+			AVPacket*									packet = nullptr;
+			w_clock::time_point							capture_time;
+		};
+
+		class w_media_stream_server_pimp
+		{
+		public:
+			w_media_stream_server_pimp() :
+				_name("w_media_stream_server"),
+				_codec_id(AV_CODEC_ID_NONE),
+				_frame_rate(0),
+				_pixel_format(AV_PIX_FMT_NONE),
+				_width(0),
+				_height(0),
+				_output_ctx(nullptr),
+				_stream(nullptr),
+				_codec_ctx(nullptr),
+				_encoder_frame(nullptr),
+				_pending_packet(nullptr),
+				_capture_times(W_CAPTURE_TIMES_SIZE),
+				_stop(false),
+				_running(false),
+				_capture_done(false),
+				_encode_done(false),
+				_connection_lost(false),
+				_captured_frames(0),
+				_dropped_frames(0),
+				_duplicated_frames(0),
+				_encoded_frames(0),
+				_sent_packets(0),
+				_sent_bytes(0),
+				_latency_sum_in_us(0),
+				_latency_max_in_us(0),
+				_start_time_in_ns(0)
+			{
+			}
+
+			void open_async(
+				_In_z_ const char* pURL,
+				_In_z_ const char* pFormatName,
+				_In_ const AVCodecID& pCodecID,
+				_In_ const int64_t& pFrameRate,
+				_In_ const AVPixelFormat& pPixelFormat,
+				_In_ const uint32_t& pWidth,
+				_In_ const uint32_t& pHeight,
+				_In_ const system::w_signal<void(const w_stream_connection_info&)>& pOnConnectionEstablished,
+				_In_ const system::w_signal<void(const w_stream_frame_info&)>& pOnFillingVideoFrameBuffer,
+				_In_ const system::w_signal<void(const char*)>& pOnConnectionLost,
+				_In_ const w_stream_server_configs& pConfigs)
+			{
+				stop();
+
+				this->_url = pURL ? pURL : "";
+				this->_format_name = pFormatName ? pFormatName : "";
+				this->_codec_id = pCodecID;
+				this->_frame_rate = pFrameRate > 0 ? pFrameRate : 1;
+				this->_pixel_format = pPixelFormat;
+				this->_width = pWidth;
+				this->_height = pHeight;
+				this->_on_connection_established = pOnConnectionEstablished;
+				this->_on_filling_video_frame_buffer = pOnFillingVideoFrameBuffer;
+				this->_on_connection_lost = pOnConnectionLost;
+				this->_configs = pConfigs;
+
+				_reset_statistics();
+				this->_running.store(true);
+				this->_capture_thread = std::thread(&w_media_stream_server_pimp::_capture_loop, this);
+			}
+
+			void stop()
+			{
+				this->_stop.store(true, std::memory_order_release);
+				if (this->_capture_thread.joinable())
+				{
+					this->_capture_thread.join();
+				}
+				this->_stop.store(false, std::memory_order_release);
+			}
+
+			ULONG release()
+			{
+				stop();
+				return 0;
+			}
+
+#pragma region Getters
+
+			bool get_is_running() const
+			{
+				return this->_running.load(std::memory_order_acquire);
+			}
+
+			w_stream_server_statistics get_statistics() const
+			{
+				w_stream_server_statistics _statistics;
+				_statistics.captured_frames = this->_captured_frames.load(std::memory_order_relaxed);
+				_statistics.dropped_frames = this->_dropped_frames.load(std::memory_order_relaxed);
+				_statistics.duplicated_frames = this->_duplicated_frames.load(std::memory_order_relaxed);
+				_statistics.encoded_frames = this->_encoded_frames.load(std::memory_order_relaxed);
+				_statistics.sent_packets = this->_sent_packets.load(std::memory_order_relaxed);
+				_statistics.sent_bytes = this->_sent_bytes.load(std::memory_order_relaxed);
+				if (_statistics.sent_packets)
+				{
+					_statistics.average_glass_to_wire_latency_in_ms =
+						static_cast<double>(this->_latency_sum_in_us.load(std::memory_order_relaxed)) / 1000.0 / _statistics.sent_packets;
+				}
+				_statistics.max_glass_to_wire_latency_in_ms = static_cast<double>(this->_latency_max_in_us.load(std::memory_order_relaxed)) / 1000.0;
+
+				auto _start = this->_start_time_in_ns.load(std::memory_order_acquire);
+				if (_start)
+				{
+					auto _now = std::chrono::duration_cast<std::chrono::nanoseconds>(w_clock::now().time_since_epoch()).count();
+					_statistics.elapsed_time_in_seconds = static_cast<double>(_now - _start) / 1e9;
+				}
+				return _statistics;
+			}
+
+#pragma endregion
+
+		private:
+
+			W_RESULT _open()
+			{
+				const std::string _trace_info = this->_name + "::_open";
+
+				//create output context
+				avformat_alloc_output_context2(&this->_output_ctx, NULL, this->_format_name.c_str(), this->_url.c_str());
+				if (!this->_output_ctx || !this->_output_ctx->oformat)
+				{
+					V(W_FAILED, "creating output streaming format : " + this->_format_name, _trace_info, 3);
+					return W_FAILED;
+				}
+
+				//find the encoder
+				auto _codec = avcodec_find_encoder(this->_codec_id);
+				if (!_codec)
+				{
+					V(W_FAILED, "finding encoder for codec id: " + std::string(avcodec_get_name(this->_codec_id)), _trace_info, 3);
+					return W_FAILED;
+				}
+
+				this->_stream = avformat_new_stream(this->_output_ctx, NULL);
+				if (!this->_stream)
+				{
+					V(W_FAILED, "allocating stream", _trace_info, 3);
+					return W_FAILED;
+				}
+				this->_stream->id = this->_output_ctx->nb_streams - 1;
+				this->_stream->time_base.num = 1;
+				this->_stream->time_base.den = 90000;
+
+				this->_codec_ctx = avcodec_alloc_context3(_codec);
+				if (!this->_codec_ctx)
+				{
+					V(W_FAILED, "allocating encoder context", _trace_info, 3);
+					return W_FAILED;
+				}
+
+				auto _ctx = this->_codec_ctx;
+				_ctx->codec_id = this->_codec_id;
+				_ctx->bit_rate = this->_configs.bit_rate;
+				_ctx->bit_rate_tolerance = static_cast<int>(this->_configs.bit_rate);
+				_ctx->rc_max_rate = this->_configs.bit_rate;
+				_ctx->width = static_cast<int>(this->_width);
+				_ctx->height = static_cast<int>(this->_height);
+				_ctx->time_base.num = 1;
+				_ctx->time_base.den = static_cast<int>(this->_frame_rate);
+				_ctx->framerate.num = static_cast<int>(this->_frame_rate);
+				_ctx->framerate.den = 1;
+				_ctx->gop_size = this->_configs.gop_size;
+				_ctx->pix_fmt = this->_pixel_format;
+				//frame threading encodes several frames in parallel, slice threading splits each frame
+				_ctx->thread_count = this->_configs.encoder_threads;
+				_ctx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+				if (this->_output_ctx->oformat->flags & AVFMT_GLOBALHEADER)
+				{
+					_ctx->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+				}
+
+				if (avcodec_open2(_ctx, _codec, NULL) < 0)
+				{
+					V(W_FAILED, "opening video codec", _trace_info, 3);
+					return W_FAILED;
+				}
+				if (avcodec_parameters_from_context(this->_stream->codecpar, _ctx) < 0)
+				{
+					V(W_FAILED, "copying parameters of encoder to stream", _trace_info, 3);
+					return W_FAILED;
+				}
+
+				//formats which write to a file or socket by themselves, e.g. mpegts over udp
+				if (!(this->_output_ctx->oformat->flags & AVFMT_NOFILE))
+				{
+					if (avio_open(&this->_output_ctx->pb, this->_url.c_str(), AVIO_FLAG_WRITE) < 0)
+					{
+						V(W_FAILED, "opening " + this->_url, _trace_info, 3);
+						return W_FAILED;
+					}
+				}
+
+				AVDictionary* _av_dic = NULL;
+				av_dict_set(&_av_dic, "rtsp_transport", "udp", 0);
+				auto _hr = avformat_write_header(this->_output_ctx, &_av_dic);
+				av_dict_free(&_av_dic);
+				if (_hr < 0)
+				{
+					V(W_FAILED, "connecting to server " + this->_url, _trace_info, 3);
+					return W_FAILED;
+				}
+
+				//ring of reusable pictures
+				auto _ring_size = this->_configs.picture_ring_size ? this->_configs.picture_ring_size : 1;
+				this->_pictures.resize(_ring_size);
+				this->_frames.allocate(_ring_size);
+				this->_free_pictures.allocate(_ring_size);
+				for (uint32_t i = 0; i < _ring_size; ++i)
+				{
+					auto& _picture = this->_pictures[i];
+					std::memset(&_picture, 0, sizeof(AVPicture));
+					if (av_image_alloc(_picture.data, _picture.linesize, _ctx->width, _ctx->height, _ctx->pix_fmt, 32) < 0)
+					{
+						V(W_FAILED, "allocating video stream picture", _trace_info, 3);
+						return W_FAILED;
+					}
+					this->_free_pictures.try_push(i);
+				}
+
+				this->_encoder_frame = av_frame_alloc();
+				if (!this->_encoder_frame)
+				{
+					V(W_FAILED, "allocating video stream frame", _trace_info, 3);
+					return W_FAILED;
+				}
+				this->_encoder_frame->format = _ctx->pix_fmt;
+				this->_encoder_frame->width = _ctx->width;
+				this->_encoder_frame->height = _ctx->height;
+
+				//pooled packets between encoder and mux
+				auto _queue_size = this->_configs.packet_queue_size ? this->_configs.packet_queue_size : 1;
+				this->_packets.allocate(_queue_size);
+				this->_free_packets.allocate(_queue_size);
+				this->_packets_storage.resize(_queue_size, nullptr);
+				for (auto& _packet : this->_packets_storage)
+				{
+					_packet = av_packet_alloc();
+					if (!_packet)
+					{
+						V(W_FAILED, "allocating packets", _trace_info, 3);
+						return W_FAILED;
+					}
+					this->_free_packets.try_push(_packet);
+				}
+
+				return W_PASSED;
+			}
+
+			void _release_stream()
+			{
+				for (auto& _picture : this->_pictures)
+				{
+					av_freep(&_picture.data[0]);
+				}
+				this->_pictures.clear();
+				for (auto& _packet : this->_packets_storage)
+				{
+					av_packet_free(&_packet);
+				}
+				this->_packets_storage.clear();
+				this->_pending_packet = nullptr;
+				if (this->_encoder_frame)
+				{
+					//encoder frame does not own pictures
+					std::memset(this->_encoder_frame->data, 0, sizeof(this->_encoder_frame->data));
+					av_frame_free(&this->_encoder_frame);
+				}
+				if (this->_codec_ctx)
+				{
+					avcodec_free_context(&this->_codec_ctx);
+				}
+				if (this->_output_ctx)
+				{
+					if (this->_output_ctx->oformat && !(this->_output_ctx->oformat->flags & AVFMT_NOFILE))
+					{
+						avio_closep(&this->_output_ctx->pb);
+					}
+					avformat_free_context(this->_output_ctx);
+					this->_output_ctx = nullptr;
+				}
+				this->_stream = nullptr;
+			}
+
+			void _reset_statistics()
+			{
+				this->_captured_frames.store(0);
+				this->_dropped_frames.store(0);
+				this->_duplicated_frames.store(0);
+				this->_encoded_frames.store(0);
+				this->_sent_packets.store(0);
+				this->_sent_bytes.store(0);
+				this->_latency_sum_in_us.store(0);
+				this->_latency_max_in_us.store(0);
+				this->_start_time_in_ns.store(0);
+			}
+
+			//stage 1, fills pictures on a steady clock schedule
+			void _capture_loop()
+			{
+				const std::string _trace_info = this->_name + "::_capture_loop";
+
+				if (_open() == W_FAILED)
+				{
+					_release_stream();
+					this->_running.store(false, std::memory_order_release);
+					this->_on_connection_lost.emit(this->_url.c_str());
+					return;
+				}
+
+				this->_capture_done.store(false);
+				this->_encode_done.store(false);
+				this->_connection_lost.store(false);
+				this->_encode_thread = std::thread(&w_media_stream_server_pimp::_encode_loop, this);
+				this->_mux_thread = std::thread(&w_media_stream_server_pimp::_mux_loop, this);
+
+				//on connection established
+				w_stream_connection_info _con_info;
+				_con_info.url = this->_url.c_str();
+				_con_info.context = this->_output_ctx;
+				_con_info.stream = this->_stream;
+				this->_on_connection_established.emit(_con_info);
+
+				w_stream_frame_info _frame_info;
+				_frame_info.width = this->_width;
+				_frame_info.height = this->_height;
+
+				const auto _period = std::chrono::duration_cast<w_clock::duration>(std::chrono::duration<double>(1.0 / static_cast<double>(this->_frame_rate)));
+				const auto _start = w_clock::now();
+				this->_start_time_in_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(_start.time_since_epoch()).count(), std::memory_order_release);
+
+				int64_t _pts = 0;
+				while (!this->_stop.load(std::memory_order_acquire))
+				{
+					auto _deadline = _start + _period * _pts;
+					std::this_thread::sleep_until(_deadline);
+
+					uint32_t _slot = 0;
+					if (!this->_free_pictures.try_pop(_slot))
+					{
+						//encoder is behind, skip this frame
+						this->_dropped_frames.fetch_add(1, std::memory_order_relaxed);
+						_pts++;
+						continue;
+					}
+
+					w_stream_frame_job _job;
+					_job.slot = _slot;
+					_job.pts = _pts;
+					_job.capture_time = w_clock::now();
+
+					_frame_info.picture = &this->_pictures[_slot];
+					_frame_info.index = _pts;
+					this->_on_filling_video_frame_buffer.emit(_frame_info);
+
+					auto _now = w_clock::now();
+					_frame_info.stream_duration = std::chrono::duration_cast<std::chrono::milliseconds>(_now - _start).count();
+					_frame_info.frame_duration = std::chrono::duration_cast<std::chrono::milliseconds>(_now - _job.capture_time).count();
+					if (_frame_info.frame_duration > this->_configs.max_frame_delay_in_ms)
+					{
+						logger.warning("filling frame " + std::to_string(_pts) + " took " + std::to_string(_frame_info.frame_duration) +
+							" ms which is greater than max frame delay");
+					}
+
+					//number of deadlines which have been passed while filling this frame
+					int64_t _missed = 0;
+					if (_now >= _deadline + _period)
+					{
+						_missed = static_cast<int64_t>((_now - _deadline) / _period);
+						if (this->_configs.late_frame_policy == STREAM_DUPLICATE_LATE_FRAMES)
+						{
+							_job.repeat = _missed;
+							this->_duplicated_frames.fetch_add(static_cast<uint64_t>(_missed), std::memory_order_relaxed);
+						}
+						else
+						{
+							this->_dropped_frames.fetch_add(static_cast<uint64_t>(_missed), std::memory_order_relaxed);
+						}
+					}
+
+					this->_frames.try_push(_job);
+					this->_captured_frames.fetch_add(1, std::memory_order_relaxed);
+					_pts += 1 + _missed;
+				}
+
+				this->_capture_done.store(true, std::memory_order_release);
+				this->_encode_thread.join();
+				this->_mux_thread.join();
+
+				_release_stream();
+				this->_running.store(false, std::memory_order_release);
+
+				//on connection lost
+				this->_on_connection_lost.emit(this->_url.c_str());
+			}
+
+			//receive all ready packets of encoder and push them to mux, returns false if stream is stopping
+			bool _receive_packets()
+			{
+				for (;;)
+				{
+					if (!this->_pending_packet)
+					{
+						if (!this->_free_packets.try_pop(this->_pending_packet))
+						{
+							//mux is behind
+							uint32_t _spins = 0;
+							while (!this->_free_packets.try_pop(this->_pending_packet))
+							{
+								if (this->_stop.load(std::memory_order_acquire)) return false;
+								w_idle(_spins);
+							}
+						}
+					}
+
+					if (avcodec_receive_packet(this->_codec_ctx, this->_pending_packet) < 0) return true;
+
+					w_stream_packet _packet;
+					_packet.packet = this->_pending_packet;
+					_packet.capture_time = this->_capture_times[static_cast<size_t>(_packet.packet->pts) % W_CAPTURE_TIMES_SIZE];
+
+					av_packet_rescale_ts(_packet.packet, this->_codec_ctx->time_base, this->_stream->time_base);
+					_packet.packet->stream_index = this->_stream->index;
+
+					this->_packets.try_push(_packet);
+					this->_pending_packet = nullptr;
+				}
+			}
+
+			bool _send_frame(_In_opt_ const AVFrame* pFrame)
+			{
+				for (;;)
+				{
+					auto _hr = avcodec_send_frame(this->_codec_ctx, pFrame);
+					if (_hr == AVERROR(EAGAIN))
+					{
+						//encoder is full, receive packets and send the frame again
+						if (!_receive_packets()) return false;
+						continue;
+					}
+					if (_hr < 0 && _hr != AVERROR_EOF)
+					{
+						V(W_FAILED, "encoding video frame", this->_name, 3);
+					}
+					break;
+				}
+				return _receive_packets();
+			}
+
+			//stage 2, encodes filled pictures
+			void _encode_loop()
+			{
+				uint32_t _spins = 0;
+				while (!this->_stop.load(std::memory_order_acquire))
+				{
+					//all frames have been pushed before capture was marked as done
+					auto _capture_done = this->_capture_done.load(std::memory_order_acquire);
+
+					w_stream_frame_job _job;
+					if (!this->_frames.try_pop(_job))
+					{
+						if (_capture_done) break;
+						w_idle(_spins);
+						continue;
+					}
+					_spins = 0;
+
+					auto& _picture = this->_pictures[_job.slot];
+					for (int i = 0; i < AV_NUM_DATA_POINTERS; ++i)
+					{
+						this->_encoder_frame->data[i] = i < 4 ? _picture.data[i] : nullptr;
+						this->_encoder_frame->linesize[i] = i < 4 ? _picture.linesize[i] : 0;
+					}
+
+					//encoder copies pictures which are not reference counted, so picture can be filled again after sending
+					for (int64_t i = 0; i <= _job.repeat; ++i)
+					{
+						this->_encoder_frame->pts = _job.pts + i;
+						this->_capture_times[static_cast<size_t>(this->_encoder_frame->pts) % W_CAPTURE_TIMES_SIZE] = _job.capture_time;
+						if (!_send_frame(this->_encoder_frame)) break;
+						this->_encoded_frames.fetch_add(1, std::memory_order_relaxed);
+					}
+
+					this->_free_pictures.try_push(_job.slot);
+				}
+
+				//flush delayed packets of encoder
+				if (!this->_stop.load(std::memory_order_acquire) || !this->_connection_lost.load(std::memory_order_acquire))
+				{
+					_send_frame(nullptr);
+				}
+				this->_encode_done.store(true, std::memory_order_release);
+			}
+
+			//stage 3, writes packets to the network
+			void _mux_loop()
+			{
+				uint32_t _spins = 0;
+				uint32_t _write_errors = 0;
+				while (true)
+				{
+					auto _encode_done = this->_encode_done.load(std::memory_order_acquire);
+
+					w_stream_packet _packet;
+					if (!this->_packets.try_pop(_packet))
+					{
+						if (_encode_done) break;
+						w_idle(_spins);
+						continue;
+					}
+					_spins = 0;
+
+					if (!this->_connection_lost.load(std::memory_order_relaxed))
+					{
+						auto _size = _packet.packet->size;
+						if (av_write_frame(this->_output_ctx, _packet.packet) < 0)
+						{
+							V(W_FAILED, "writing video frame", this->_name, 3);
+							if (++_write_errors >= W_MAX_WRITE_ERRORS)
+							{
+								//end the stream
+								this->_connection_lost.store(true, std::memory_order_release);
+								this->_stop.store(true, std::memory_order_release);
+							}
+						}
+						else
+						{
+							_write_errors = 0;
+							auto _latency = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(w_clock::now() - _packet.capture_time).count());
+							this->_sent_packets.fetch_add(1, std::memory_order_relaxed);
+							this->_sent_bytes.fetch_add(static_cast<uint64_t>(_size), std::memory_order_relaxed);
+							this->_latency_sum_in_us.fetch_add(_latency, std::memory_order_relaxed);
+							if (_latency > this->_latency_max_in_us.load(std::memory_order_relaxed))
+							{
+								this->_latency_max_in_us.store(_latency, std::memory_order_relaxed);
+							}
+						}
+					}
+
+					av_packet_unref(_packet.packet);
+					this->_free_packets.try_push(_packet.packet);
+				}
+
+				if (!this->_connection_lost.load(std::memory_order_acquire))
+				{
+					av_write_trailer(this->_output_ctx);
+				}
+			}
+
+			std::string											_name;
+			std::string											_url;
+			std::string											_format_name;
+			AVCodecID											_codec_id;
+			int64_t												_frame_rate;
+			AVPixelFormat										_pixel_format;
+			uint32_t											_width;
+			uint32_t											_height;
+			w_stream_server_configs								_configs;
+
+			system::w_signal<void(const w_stream_connection_info&)>	_on_connection_established;
+			system::w_signal<void(const w_stream_frame_info&)>		_on_filling_video_frame_buffer;
+			system::w_signal<void(const char*)>						_on_connection_lost;
+
+			AVFormatContext*									_output_ctx;
+			AVStream*											_stream;
+			AVCodecContext*										_codec_ctx;
+			//owned by encoder, points to one of pictures
+			AVFrame*											_encoder_frame;
+			//owned by encoder
+			AVPacket*											_pending_packet;
+			std::vector<w_clock::time_point>					_capture_times;
+
+			std::vector<AVPicture>								_pictures;
+			//capture pushes filled pictures, encoder pops them
+			w_spsc_queue<w_stream_frame_job>					_frames;
+			//encoder returns sent pictures, capture pops them
+			w_spsc_queue<uint32_t>								_free_pictures;
+			//encoder pushes packets, mux pops them
+			w_spsc_queue<w_stream_packet>						_packets;
+			//mux returns written packets, encoder pops them
+			w_spsc_queue<AVPacket*>								_free_packets;
+			std::vector<AVPacket*>								_packets_storage;
+
+			std::thread											_capture_thread;
+			std::thread											_encode_thread;
+			std::thread											_mux_thread;
+			std::atomic<bool>									_stop;
+			std::atomic<bool>									_running;
+			std::atomic<bool>									_capture_done;
+			std::atomic<bool>									_encode_done;
+			std::atomic<bool>									_connection_lost;
+
+			std::atomic<uint64_t>								_captured_frames;
+			std::atomic<uint64_t>								_dropped_frames;
+			std::atomic<uint64_t>								_duplicated_frames;
+			std::atomic<uint64_t>								_encoded_frames;
+			std::atomic<uint64_t>								_sent_packets;
+			std::atomic<uint64_t>								_sent_bytes;
+			std::atomic<uint64_t>								_latency_sum_in_us;
+			std::atomic<uint64_t>								_latency_max_in_us;
+			std::atomic<int64_t>								_start_time_in_ns;
+		};
+	}
+}
+
+w_media_stream_server::w_media_stream_server() :
+	_pimp(new w_media_stream_server_pimp())
+{
+	_super::set_class_name("w_media_stream_server");
+}
+
+w_media_stream_server::~w_media_stream_server()
+{
+	release();
+}
+
+void w_media_stream_server::open_async(
+	_In_z_ const char* pURL,
+	_In_z_ const char* pFormatName,
+	_In_ const AVCodecID& pCodecID,
+	_In_ const int64_t& pFrameRate,
+	_In_ const AVPixelFormat& pPixelFormat,
+	_In_ const uint32_t& pWidth,
+	_In_ const uint32_t& pHeight,
+	_In_ const system::w_signal<void(const w_stream_connection_info&)>& pOnConnectionEstablished,
+	_In_ const system::w_signal<void(const w_stream_frame_info&)>& pOnFillingVideoFrameBuffer,
+	_In_ const system::w_signal<void(const char*)>& pOnConnectionLost,
+	_In_ const w_stream_server_configs& pConfigs)
+{
+	if (this->_pimp)
+	{
+		this->_pimp->open_async(
+			pURL,
+			pFormatName,
+			pCodecID,
+			pFrameRate,
+			pPixelFormat,
+			pWidth,
+			pHeight,
+			pOnConnectionEstablished,
+			pOnFillingVideoFrameBuffer,
+			pOnConnectionLost,
+			pConfigs);
+	}
+}
+
+void w_media_stream_server::stop()
+{
+	if (this->_pimp)
+	{
+		this->_pimp->stop();
+	}
+}
+
+ULONG w_media_stream_server::release()
+{
+	if (_super::get_is_released()) return 1;
+
+	SAFE_RELEASE(this->_pimp);
+
+	return _super::release();
+}
+
+#pragma region Getters
+
+bool w_media_stream_server::get_is_running() const
+{
+	return this->_pimp ? this->_pimp->get_is_running() : false;
+}
+
+w_stream_server_statistics w_media_stream_server::get_statistics() const
+{
+	return this->_pimp ? this->_pimp->get_statistics() : w_stream_server_statistics();
+}
+
+#pragma endregion
@@ -0,0 +1,153 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_media_stream_server.h
+	Description		 : A pipelined stream server which captures, encodes and sends video frames on separate threads
+	Comment          : Capture thread fills a ring of reusable pictures on a steady clock schedule, encoder thread encodes
+					   them with send/receive API and frame threading, and mux thread writes packets to the network.
+					   Late captures drop or duplicate frames instead of ending the stream, and only a lost connection
+					   or stop ends it
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_MEDIA_STREAM_SERVER_H__
+#define __W_MEDIA_STREAM_SERVER_H__
+
+#include "w_media_core_export.h"
+#include <w_object.h>
+#include <w_signal.h>
+#include <stdint.h>
+
+extern "C"
+{
+	#include <libavcodec/avcodec.h>
+	#include <libavformat/avformat.h>
+}
+
+namespace wolf
+{
+	namespace framework
+	{
+		struct w_stream_connection_info
+		{
+			const char*         url;
+			AVFormatContext*    context;
+			AVStream*           stream;
+		};
+
+		struct w_stream_frame_info
+		{
+			AVPicture*      picture = nullptr;
+			uint32_t        width = 0;
+			uint32_t        height = 0;
+			long long       index = 0;
+			long long       stream_duration = 0.0;
+			long long       frame_duration = 0.0;
+		};
+
+		enum w_stream_late_frame_policy
+		{
+			//skip the frames whose time have been passed while capturing, stream keeps real time but its frame rate drops
+			STREAM_DROP_LATE_FRAMES = 0,
+			//repeat the last captured picture for the frames whose time have been passed, stream keeps its frame rate
+			STREAM_DUPLICATE_LATE_FRAMES
+		};
+
+		struct w_stream_server_configs
+		{
+			//number of reusable pictures between capture and encoder
+			uint32_t						picture_ring_size = 4;
+			//number of encoded packets which can be queued for mux thread
+			uint32_t						packet_queue_size = 64;
+			w_stream_late_frame_policy		late_frame_policy = STREAM_DROP_LATE_FRAMES;
+			//number of encoder threads, zero means ffmpeg picks it from number of cores
+			int								encoder_threads = 0;
+			int64_t							bit_rate = 5000 * 1000;
+			//emit one intra frame every gop_size frames at most
+			int								gop_size = 12;
+			//a warning will be logged when filling a frame takes longer than this
+			double							max_frame_delay_in_ms = 1000.0;
+		};
+
+		struct w_stream_server_statistics
+		{
+			uint64_t	captured_frames = 0;
+			//frames which have been skipped because capture was late or ring of pictures was full
+			uint64_t	dropped_frames = 0;
+			//frames which have been repeated because capture was late
+			uint64_t	duplicated_frames = 0;
+			uint64_t	encoded_frames = 0;
+			uint64_t	sent_packets = 0;
+			uint64_t	sent_bytes = 0;
+			//time from start of filling a picture until its packet has been written to the network
+			double		average_glass_to_wire_latency_in_ms = 0.0;
+			double		max_glass_to_wire_latency_in_ms = 0.0;
+			//seconds since connection has been established
+			double		elapsed_time_in_seconds = 0.0;
+		};
+
+		class w_media_stream_server_pimp;
+		class w_media_stream_server : public system::w_object
+		{
+		public:
+			WMC_EXP w_media_stream_server();
+			WMC_EXP virtual ~w_media_stream_server();
+
+			/*
+				open stream server and start capture, encode and mux threads, previous stream will be stopped
+				For testing, use ffplay, e.g. ./ffplay -rtsp_flags listen -i rtsp://127.0.0.1:8554/live.sdp
+				@param pURL, the connection url
+				@param pFormatName, format of streaming, e.g. "rtsp", "mpegts"
+				@param pCodecID, codec of streaming, e.g. "AV_CODEC_ID_H264"
+				@param pFrameRate, streaming frame rate, e.g. "25", "60"
+				@param pPixelFormat, streaming pixel format, e.g. "AV_PIX_FMT_YUV420P"
+				@param pWidth, frame width
+				@param pHeight, frame height
+				@param pOnConnectionEstablished, rised on capture thread when connection esablished
+				@param pOnFillingVideoFrameBuffer, rised on capture thread for filling each picture of ring
+				@param pOnConnectionLost, rised on capture thread when stream ended
+				@param pConfigs, configs of pipeline
+			*/
+			WMC_EXP void open_async(
+				_In_z_ const char* pURL,
+				_In_z_ const char* pFormatName,
+				_In_ const AVCodecID& pCodecID,
+				_In_ const int64_t& pFrameRate,
+				_In_ const AVPixelFormat& pPixelFormat,
+				_In_ const uint32_t& pWidth,
+				_In_ const uint32_t& pHeight,
+				_In_ const system::w_signal<void(const w_stream_connection_info&)>& pOnConnectionEstablished,
+				_In_ const system::w_signal<void(const w_stream_frame_info&)>& pOnFillingVideoFrameBuffer,
+				_In_ const system::w_signal<void(const char*)>& pOnConnectionLost,
+				_In_ const w_stream_server_configs& pConfigs = w_stream_server_configs());
+
+			//stop stream and wait for all threads
+			WMC_EXP void stop();
+
+			//release all resources
+			WMC_EXP ULONG release() override;
+
+#pragma region Getters
+
+			//returns true from open_async until stream ends
+			WMC_EXP bool get_is_running() const;
+			WMC_EXP w_stream_server_statistics get_statistics() const;
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_media_stream_server(w_media_stream_server const&);
+			w_media_stream_server& operator= (w_media_stream_server const&);
+
+			typedef	system::w_object								_super;
+			w_media_stream_server_pimp*								_pimp;
+		};
+	}
+}
+
+#endif //__W_MEDIA_STREAM_SERVER_H__
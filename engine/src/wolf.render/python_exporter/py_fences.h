@@ -20,6 +20,7 @@ namespace pyWolf
 
 	BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(initialize_overloads, w_fences::py_initialize, 1, 2)
 	BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(wait_overloads, w_fences::wait, 0, 1)
+	BOOST_PYTHON_MEMBER_FUNCTION_OVERLOADS(wait_at_overloads, w_fences::wait_at, 1, 2)
 
 	static void py_fences_export()
 	{
@@ -30,7 +31,9 @@ namespace pyWolf
 		class_<w_fences, boost::noncopyable>("w_fences")
 			.def("initialize", &w_fences::py_initialize, initialize_overloads())
 			.def("wait", &w_fences::wait, wait_overloads())
+			.def("wait_at", &w_fences::wait_at, wait_at_overloads())
 			.def("reset", &w_fences::reset, "reset all fences")
+			.def("reset_at", &w_fences::reset_at, "reset fence at index")
 			.def("get_count", &w_fences::get_count, "get number of fences")
 			.def("release", &w_fences::release, "release resources of all fences")
 			;
@@ -36,6 +36,7 @@ namespace pyWolf
 		class_<w_graphics_device_manager_configs>("w_graphics_device_manager_configs", init<>())
 			.def_readwrite("debug_gpu", &w_graphics_device_manager_configs::debug_gpu, "debug_gpu")
 			.def_readwrite("off_screen_mode", &w_graphics_device_manager_configs::off_screen_mode, "off_screen_mode")
+			.def_readwrite("frames_in_flight", &w_graphics_device_manager_configs::frames_in_flight, "frames_in_flight")
 			;
 
 		//export w_viewport class
@@ -523,6 +524,8 @@ namespace pyWolf
 				.add_property("depth_buffer_format", &w_output_presentation_window::depth_buffer_format, "get depth buffer format")
 				.add_property("swap_chain_image_is_available_semaphore", &w_output_presentation_window::swap_chain_image_is_available_semaphore, "semaphore for checking whether swap chain's image is available or not")
 				.add_property("rendering_done_semaphore", &w_output_presentation_window::rendering_done_semaphore, "semaphore for signaling, when all rendering is done")
+				.add_property("frames_in_flight", &w_output_presentation_window::frames_in_flight, "get number of frames in flight")
+				.add_property("frame_index", &w_output_presentation_window::frame_index, "get index of current frame in flight")
 				.add_property("width", &w_output_presentation_window::width, "get width of presentation window")
 				.add_property("height", &w_output_presentation_window::height, "get height of presentation window")
 				.add_property("v_sync", &w_output_presentation_window::v_sync, "get status of v-sync")
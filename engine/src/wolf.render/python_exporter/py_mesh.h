@@ -41,6 +41,7 @@ namespace pyWolf
 			.value("VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL", w_vertex_declaration::VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL)
 			.value("VERTEX_POSITION_NORMAL_UV_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES", w_vertex_declaration::VERTEX_POSITION_NORMAL_UV_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES)
 			.value("VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES", w_vertex_declaration::VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES)
+			.value("VERTEX_QUANTIZED_POSITION_NORMAL_UV_TANGENT_COLOR_BLEND_WEIGHT_BLEND_INDICES", w_vertex_declaration::VERTEX_QUANTIZED_POSITION_NORMAL_UV_TANGENT_COLOR_BLEND_WEIGHT_BLEND_INDICES)
 			.export_values()
 			;
 
@@ -50,6 +51,13 @@ namespace pyWolf
 			.value("Vec2", w_vertex_attribute::W_VEC2)
 			.value("Vec3", w_vertex_attribute::W_VEC3)
 			.value("Vec4", w_vertex_attribute::W_VEC4)
+			.value("Half2", w_vertex_attribute::W_HALF2)
+			.value("Half4", w_vertex_attribute::W_HALF4)
+			.value("Snorm16_2", w_vertex_attribute::W_SNORM16_2)
+			.value("Snorm16_4", w_vertex_attribute::W_SNORM16_4)
+			.value("Snorm8_4", w_vertex_attribute::W_SNORM8_4)
+			.value("Unorm8_4", w_vertex_attribute::W_UNORM8_4)
+			.value("Uint8_4", w_vertex_attribute::W_UINT8_4)
 			.export_values()
 			;
 
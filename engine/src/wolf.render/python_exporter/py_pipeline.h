@@ -36,6 +36,8 @@ namespace pyWolf
 			.staticmethod("create_pipeline_cache")
 			.def("release_all_pipeline_caches", w_pipeline::py_release_all_pipeline_caches, "release all pipeline caches")
 			.staticmethod("release_all_pipeline_caches")
+			.def("set_pipeline_cache_directory", w_pipeline::set_pipeline_cache_directory, "set directory of pipeline cache files")
+			.staticmethod("set_pipeline_cache_directory")
 			;
 	}
 }
@@ -31,6 +31,8 @@ namespace pyWolf
 			.value("UNIFORM", w_shader_binding_type::UNIFORM)
 			.value("IMAGE", w_shader_binding_type::IMAGE)
 			.value("STORAGE", w_shader_binding_type::STORAGE)
+			.value("UNIFORM_DYNAMIC", w_shader_binding_type::UNIFORM_DYNAMIC)
+			.value("STORAGE_DYNAMIC", w_shader_binding_type::STORAGE_DYNAMIC)
 			.export_values()
 			;
 
@@ -31,7 +31,7 @@ namespace pyWolf
 			.def(init<const w_color&>())
 			.def("load", &w_shapes::py_load, "load shape")
 			.def("update", &w_shapes::py_update, "update shape")
-			.def("draw", &w_shapes::draw, "draw shape")
+			.def("draw", &w_shapes::py_draw, "draw shape")
 			.def("release", &w_shapes::release, "release resources of shape")
 			;
 	}
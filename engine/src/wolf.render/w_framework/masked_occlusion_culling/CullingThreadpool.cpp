@@ -16,6 +16,7 @@
 #include "w_render_pch.h"
 #include <assert.h>
 #include "CullingThreadpool.h"
+#include <w_thread.h>
 
 //#define SAFE_DELETE(X) {if (X != nullptr) delete X; X = nullptr;}
 //#define SAFE_DELETE_ARRAY(X) {if (X != nullptr) delete[] X; X = nullptr;}
@@ -230,6 +231,7 @@ void CullingThreadpool::SetupScissors()
 
 void CullingThreadpool::ThreadRun(CullingThreadpool *threadPool, unsigned int threadId)
 { 
+	wolf::system::w_thread::set_current_thread_name(("wolf_moc_" + std::to_string(threadId)).c_str());
 	threadPool->ThreadMain(threadId); 
 }
 
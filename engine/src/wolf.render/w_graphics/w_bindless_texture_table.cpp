@@ -0,0 +1,579 @@
+#include "w_render_pch.h"
+#include "w_bindless_texture_table.h"
+#include <deque>
+#include <set>
+#include <mutex>
+
+namespace wolf
+{
+	namespace graphics
+	{
+		//slots are shared with callbacks of textures, so a texture can be released after releasing the table
+		struct w_bindless_texture_table_slots
+		{
+			std::mutex											mutex;
+			std::map<const w_texture*, uint32_t>				slots;
+			//textures which have been subscribed to on_released
+			std::set<const w_texture*>							subscribed;
+			//released slots and the update which they have been released, they will be reused in order of releasing
+			//once frames in flight which may have used them have been completed
+			std::deque<std::pair<uint32_t, uint64_t>>			free_slots;
+			uint32_t											next_slot = 0;
+			//number of updates since loading
+			uint64_t											updates = 0;
+			//each frame has its own descriptor set and its own pending writes
+			std::vector<std::map<uint32_t, w_descriptor_image_info>>	pending_writes;
+			//unused slots refer to this texture
+			w_descriptor_image_info								default_info;
+			bool												has_default = false;
+
+			void free_slot(_In_ const w_texture* pTexture)
+			{
+				auto _iter = this->slots.find(pTexture);
+				if (_iter == this->slots.end()) return;
+
+				auto _slot = _iter->second;
+				this->slots.erase(_iter);
+				this->free_slots.push_back(std::make_pair(_slot, this->updates));
+				for (auto& _pending_writes : this->pending_writes)
+				{
+					if (this->has_default)
+					{
+						_pending_writes[_slot] = this->default_info;
+					}
+					else
+					{
+						_pending_writes.erase(_slot);
+					}
+				}
+			}
+
+			//write descriptor of slot to descriptor sets of all frames
+			void write(_In_ const uint32_t& pSlot, _In_ const w_descriptor_image_info& pInfo)
+			{
+				for (auto& _pending_writes : this->pending_writes)
+				{
+					_pending_writes[pSlot] = pInfo;
+				}
+			}
+		};
+
+		class w_bindless_texture_table_pimp
+		{
+		public:
+			w_bindless_texture_table_pimp() :
+				_name("w_bindless_texture_table"),
+				_gDevice(nullptr),
+				_capacity(0),
+				_number_of_frames(0),
+				_sampler_type(w_sampler_type::MIPMAP_AND_ANISOTROPY),
+				_descriptor_indexing(false),
+				_descriptor_pool(0)
+			{
+			}
+
+			~w_bindless_texture_table_pimp()
+			{
+				release();
+			}
+
+			W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const uint32_t& pCapacity,
+				_In_ const uint32_t& pNumberOfFrames,
+				_In_ const w_shader_stage_flag_bits& pShaderStages,
+				_In_ const w_sampler_type& pSamplerType)
+			{
+				const std::string _trace_info = this->_name + "::load";
+
+				if (!pGDevice || !pGDevice->device_info || !pGDevice->device_info->device_properties || pCapacity == 0 || pNumberOfFrames == 0)
+				{
+					V(W_FAILED, "loading bindless texture table with invalid parameters", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				this->_gDevice = pGDevice;
+				this->_sampler_type = pSamplerType;
+				this->_number_of_frames = pNumberOfFrames;
+				this->_slots = std::make_shared<w_bindless_texture_table_slots>();
+				this->_slots->pending_writes.resize(pNumberOfFrames);
+
+#ifdef VK_EXT_descriptor_indexing
+				this->_descriptor_indexing = pGDevice->vk_descriptor_indexing;
+#endif
+				this->_capacity = pCapacity;
+				if (this->_descriptor_indexing && pGDevice->vk_max_update_after_bind_sampled_images)
+				{
+					//update after bind descriptor sets have their own limits
+					this->_capacity = std::min(this->_capacity, pGDevice->vk_max_update_after_bind_sampled_images);
+				}
+				else
+				{
+					//all of slots are statically used, so they must not exceed limits of device
+					auto _limits = &pGDevice->device_info->device_properties->limits;
+					this->_capacity = std::min(this->_capacity, _limits->maxPerStageDescriptorSamplers);
+					this->_capacity = std::min(this->_capacity, _limits->maxPerStageDescriptorSampledImages);
+					this->_capacity = std::min(this->_capacity, _limits->maxDescriptorSetSamplers);
+					this->_capacity = std::min(this->_capacity, _limits->maxDescriptorSetSampledImages);
+				}
+				if (this->_capacity != pCapacity)
+				{
+					logger.warning("capacity of bindless texture table has been clamped to " + std::to_string(this->_capacity) +
+						" for graphics device: " + pGDevice->get_info());
+				}
+
+				if (!this->_descriptor_indexing && !w_texture::default_texture)
+				{
+					V(W_FAILED, "default texture is required when descriptor indexing is not available", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				if (w_texture::default_texture)
+				{
+					this->_slots->default_info = w_texture::default_texture->get_descriptor_info(pSamplerType);
+					this->_slots->has_default = true;
+				}
+
+				if (_create_descriptor_sets(pShaderStages) == W_FAILED)
+				{
+					V(W_FAILED, "creating descriptor sets for graphics device: " + pGDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//without partially bound array, all of slots must be valid before using the table
+				if (!this->_descriptor_indexing)
+				{
+					for (uint32_t i = 0; i < this->_capacity; ++i)
+					{
+						this->_slots->write(i, this->_slots->default_info);
+					}
+				}
+
+				//no command buffer has used the table yet, so descriptor sets of all frames can be written
+				for (uint32_t i = 0; i < pNumberOfFrames; ++i)
+				{
+					if (update(i, nullptr) == W_FAILED) return W_FAILED;
+				}
+
+				return W_PASSED;
+			}
+
+			W_RESULT add_texture(_In_ w_texture* pTexture, _Out_ uint32_t& pSlot)
+			{
+				pSlot = UINT32_MAX;
+				if (!this->_slots || !pTexture) return W_FAILED;
+
+				std::lock_guard<std::mutex> _lock(this->_slots->mutex);
+
+				auto _iter = this->_slots->slots.find(pTexture);
+				if (_iter != this->_slots->slots.end())
+				{
+					pSlot = _iter->second;
+					return W_PASSED;
+				}
+
+				//descriptor sets of all frames must have been updated since releasing the slot, so frames in flight
+				//which have used the slot do not see the new texture
+				uint32_t _slot;
+				if (!this->_slots->free_slots.empty() &&
+					this->_slots->updates - this->_slots->free_slots.front().second >= this->_number_of_frames)
+				{
+					_slot = this->_slots->free_slots.front().first;
+					this->_slots->free_slots.pop_front();
+				}
+				else if (this->_slots->next_slot < this->_capacity)
+				{
+					_slot = this->_slots->next_slot++;
+				}
+				else
+				{
+					logger.error("bindless texture table is full, capacity: " + std::to_string(this->_capacity) + ", " +
+						std::to_string(this->_slots->free_slots.size()) + " released slots are waiting for frames in flight");
+					return W_FAILED;
+				}
+
+				this->_slots->slots[pTexture] = _slot;
+				this->_slots->write(_slot, pTexture->get_descriptor_info(this->_sampler_type));
+				_subscribe(pTexture);
+
+				pSlot = _slot;
+				return W_PASSED;
+			}
+
+			W_RESULT replace_texture(_In_ w_texture* pTexture, _In_ w_texture* pNewTexture)
+			{
+				if (!this->_slots || !pTexture || !pNewTexture) return W_FAILED;
+				if (pTexture == pNewTexture) return W_PASSED;
+
+				std::lock_guard<std::mutex> _lock(this->_slots->mutex);
+
+				auto _iter = this->_slots->slots.find(pTexture);
+				if (_iter == this->_slots->slots.end() ||
+					this->_slots->slots.find(pNewTexture) != this->_slots->slots.end()) return W_FAILED;
+
+				//releasing previous texture will not free the slot anymore
+				auto _slot = _iter->second;
+				this->_slots->slots.erase(_iter);
+				this->_slots->slots[pNewTexture] = _slot;
+				this->_slots->write(_slot, pNewTexture->get_descriptor_info(this->_sampler_type));
+				_subscribe(pNewTexture);
+
+				return W_PASSED;
+			}
+
+			W_RESULT remove_texture(_In_ w_texture* pTexture)
+			{
+				if (!this->_slots || !pTexture) return W_FAILED;
+
+				std::lock_guard<std::mutex> _lock(this->_slots->mutex);
+				this->_slots->free_slot(pTexture);
+
+				return W_PASSED;
+			}
+
+			W_RESULT update(_In_ const uint32_t& pFrameIndex, _Out_opt_ uint32_t* pNumberOfWrites)
+			{
+				if (pNumberOfWrites) *pNumberOfWrites = 0;
+				if (!this->_slots || pFrameIndex >= this->_descriptor_sets.size()) return W_FAILED;
+
+				std::lock_guard<std::mutex> _lock(this->_slots->mutex);
+				this->_slots->updates++;
+
+				auto _pending_writes = &this->_slots->pending_writes[pFrameIndex];
+				if (_pending_writes->empty()) return W_PASSED;
+
+				std::vector<VkWriteDescriptorSet> _write_descriptor_sets;
+				_write_descriptor_sets.reserve(_pending_writes->size());
+				for (auto& _iter : *_pending_writes)
+				{
+					VkWriteDescriptorSet _write = {};
+					_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+					_write.dstSet = this->_descriptor_sets[pFrameIndex].handle;
+					_write.dstBinding = 0;
+					_write.dstArrayElement = _iter.first;
+					_write.descriptorCount = 1;
+					_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+					_write.pImageInfo = &_iter.second;
+					_write_descriptor_sets.push_back(_write);
+				}
+
+				vkUpdateDescriptorSets(
+					this->_gDevice->vk_device,
+					static_cast<uint32_t>(_write_descriptor_sets.size()),
+					_write_descriptor_sets.data(),
+					0,
+					nullptr);
+				if (pNumberOfWrites) *pNumberOfWrites = static_cast<uint32_t>(_write_descriptor_sets.size());
+				_pending_writes->clear();
+
+				return W_PASSED;
+			}
+
+			W_RESULT bind(
+				_In_ const w_command_buffer& pCommandBuffer,
+				_In_ const w_pipeline_bind_point& pPipelineBindPoint,
+				_In_ const VkPipelineLayout& pPipelineLayout,
+				_In_ const uint32_t& pSetIndex,
+				_In_ const uint32_t& pFrameIndex)
+			{
+				if (!pCommandBuffer.handle || !pPipelineLayout || pFrameIndex >= this->_descriptor_sets.size()) return W_FAILED;
+
+				vkCmdBindDescriptorSets(pCommandBuffer.handle,
+					(VkPipelineBindPoint)pPipelineBindPoint,
+					pPipelineLayout,
+					pSetIndex,
+					1,
+					&this->_descriptor_sets[pFrameIndex].handle,
+					0,
+					nullptr);
+
+				return W_PASSED;
+			}
+
+			ULONG release()
+			{
+				//callbacks of textures will not access the slots anymore
+				this->_slots.reset();
+
+				if (this->_gDevice)
+				{
+					if (this->_descriptor_pool)
+					{
+						vkDestroyDescriptorPool(this->_gDevice->vk_device, this->_descriptor_pool, nullptr);
+						this->_descriptor_pool = 0;
+					}
+					if (this->_descriptor_set_layout.handle)
+					{
+						vkDestroyDescriptorSetLayout(this->_gDevice->vk_device, this->_descriptor_set_layout.handle, nullptr);
+						this->_descriptor_set_layout.handle = 0;
+					}
+				}
+				this->_descriptor_sets.clear();
+				this->_number_of_frames = 0;
+				this->_gDevice = nullptr;
+
+				return 0;
+			}
+
+#pragma region Getters
+
+			uint32_t get_slot(_In_ const w_texture* pTexture) const
+			{
+				if (!this->_slots) return UINT32_MAX;
+
+				std::lock_guard<std::mutex> _lock(this->_slots->mutex);
+				auto _iter = this->_slots->slots.find(pTexture);
+				return _iter == this->_slots->slots.end() ? UINT32_MAX : _iter->second;
+			}
+
+			const w_descriptor_set get_descriptor_set(_In_ const uint32_t& pFrameIndex) const
+			{
+				if (pFrameIndex >= this->_descriptor_sets.size()) return w_descriptor_set();
+				return this->_descriptor_sets[pFrameIndex];
+			}
+
+			const w_descriptor_set_layout get_descriptor_set_layout() const
+			{
+				return this->_descriptor_set_layout;
+			}
+
+			const w_bindless_texture_table_statistics get_statistics() const
+			{
+				w_bindless_texture_table_statistics _statistics;
+				_statistics.capacity = this->_capacity;
+				_statistics.number_of_frames = this->_number_of_frames;
+				_statistics.descriptor_indexing = this->_descriptor_indexing;
+				if (this->_slots)
+				{
+					std::lock_guard<std::mutex> _lock(this->_slots->mutex);
+					_statistics.used_slots = static_cast<uint32_t>(this->_slots->slots.size());
+					_statistics.released_slots = static_cast<uint32_t>(this->_slots->free_slots.size());
+					for (auto& _pending_writes : this->_slots->pending_writes)
+					{
+						_statistics.pending_writes = std::max(_statistics.pending_writes, static_cast<uint32_t>(_pending_writes.size()));
+					}
+				}
+				return _statistics;
+			}
+
+#pragma endregion
+
+		private:
+			//free the slot once texture has been released, mutex of slots must be locked
+			void _subscribe(_In_ w_texture* pTexture)
+			{
+				if (!this->_slots->subscribed.insert(pTexture).second) return;
+
+				std::weak_ptr<w_bindless_texture_table_slots> _weak_slots = this->_slots;
+				pTexture->on_released += [_weak_slots](w_texture* pReleasedTexture)
+				{
+					auto _slots = _weak_slots.lock();
+					if (!_slots) return;
+
+					std::lock_guard<std::mutex> _lock(_slots->mutex);
+					_slots->subscribed.erase(pReleasedTexture);
+					_slots->free_slot(pReleasedTexture);
+				};
+			}
+
+			W_RESULT _create_descriptor_sets(_In_ const w_shader_stage_flag_bits& pShaderStages)
+			{
+				VkDescriptorSetLayoutBinding _layout_binding = {};
+				_layout_binding.binding = 0;
+				_layout_binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				_layout_binding.descriptorCount = this->_capacity;
+				_layout_binding.stageFlags = (VkShaderStageFlags)pShaderStages;
+				_layout_binding.pImmutableSamplers = nullptr;
+
+				VkDescriptorSetLayoutCreateInfo _layout_create_info = {};
+				_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+				_layout_create_info.bindingCount = 1;
+				_layout_create_info.pBindings = &_layout_binding;
+
+				VkDescriptorPoolCreateInfo _pool_create_info = {};
+				_pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+
+#ifdef VK_EXT_descriptor_indexing
+				//slots can be written while command buffers which use other slots are pending
+				VkDescriptorBindingFlagsEXT _binding_flags =
+					VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT |
+					VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT |
+					VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT;
+
+				VkDescriptorSetLayoutBindingFlagsCreateInfoEXT _binding_flags_create_info = {};
+				_binding_flags_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+				_binding_flags_create_info.bindingCount = 1;
+				_binding_flags_create_info.pBindingFlags = &_binding_flags;
+
+				if (this->_descriptor_indexing)
+				{
+					_layout_create_info.pNext = &_binding_flags_create_info;
+					_layout_create_info.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+					_pool_create_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+				}
+#endif
+
+				auto _hr = vkCreateDescriptorSetLayout(
+					this->_gDevice->vk_device,
+					&_layout_create_info,
+					nullptr,
+					&this->_descriptor_set_layout.handle);
+				if (_hr) return W_FAILED;
+
+				VkDescriptorPoolSize _pool_size = {};
+				_pool_size.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				_pool_size.descriptorCount = this->_capacity * this->_number_of_frames;
+
+				_pool_create_info.maxSets = this->_number_of_frames;
+				_pool_create_info.poolSizeCount = 1;
+				_pool_create_info.pPoolSizes = &_pool_size;
+
+				_hr = vkCreateDescriptorPool(
+					this->_gDevice->vk_device,
+					&_pool_create_info,
+					nullptr,
+					&this->_descriptor_pool);
+				if (_hr) return W_FAILED;
+
+				std::vector<VkDescriptorSetLayout> _layouts(this->_number_of_frames, this->_descriptor_set_layout.handle);
+				std::vector<VkDescriptorSet> _descriptor_sets(this->_number_of_frames);
+
+				VkDescriptorSetAllocateInfo _allocate_info = {};
+				_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+				_allocate_info.descriptorPool = this->_descriptor_pool;
+				_allocate_info.descriptorSetCount = this->_number_of_frames;
+				_allocate_info.pSetLayouts = _layouts.data();
+
+				_hr = vkAllocateDescriptorSets(
+					this->_gDevice->vk_device,
+					&_allocate_info,
+					_descriptor_sets.data());
+				if (_hr) return W_FAILED;
+
+				for (auto _handle : _descriptor_sets)
+				{
+					w_descriptor_set _descriptor_set;
+					_descriptor_set.handle = _handle;
+					this->_descriptor_sets.push_back(_descriptor_set);
+				}
+
+				return W_PASSED;
+			}
+
+			std::string											_name;
+			std::shared_ptr<w_graphics_device>					_gDevice;
+			uint32_t											_capacity;
+			uint32_t											_number_of_frames;
+			w_sampler_type										_sampler_type;
+			bool												_descriptor_indexing;
+			VkDescriptorPool									_descriptor_pool;
+			w_descriptor_set_layout								_descriptor_set_layout;
+			//one descriptor set for each frame in flight
+			std::vector<w_descriptor_set>						_descriptor_sets;
+			std::shared_ptr<w_bindless_texture_table_slots>	_slots;
+		};
+	}
+}
+
+using namespace wolf::graphics;
+
+w_bindless_texture_table::w_bindless_texture_table() : _pimp(new w_bindless_texture_table_pimp())
+{
+	_super::set_class_name("w_bindless_texture_table");
+}
+
+w_bindless_texture_table::~w_bindless_texture_table()
+{
+	release();
+}
+
+W_RESULT w_bindless_texture_table::load(
+	_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_ const uint32_t& pCapacity,
+	_In_ const uint32_t& pNumberOfFrames,
+	_In_ const w_shader_stage_flag_bits& pShaderStages,
+	_In_ const w_sampler_type& pSamplerType)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->load(pGDevice, pCapacity, pNumberOfFrames, pShaderStages, pSamplerType);
+}
+
+W_RESULT w_bindless_texture_table::add_texture(_In_ w_texture* pTexture, _Out_ uint32_t& pSlot)
+{
+	if (!this->_pimp)
+	{
+		pSlot = UINT32_MAX;
+		return W_FAILED;
+	}
+	return this->_pimp->add_texture(pTexture, pSlot);
+}
+
+W_RESULT w_bindless_texture_table::remove_texture(_In_ w_texture* pTexture)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->remove_texture(pTexture);
+}
+
+W_RESULT w_bindless_texture_table::replace_texture(_In_ w_texture* pTexture, _In_ w_texture* pNewTexture)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->replace_texture(pTexture, pNewTexture);
+}
+
+W_RESULT w_bindless_texture_table::update(_In_ const uint32_t& pFrameIndex, _Out_opt_ uint32_t* pNumberOfWrites)
+{
+	if (!this->_pimp)
+	{
+		if (pNumberOfWrites) *pNumberOfWrites = 0;
+		return W_FAILED;
+	}
+	return this->_pimp->update(pFrameIndex, pNumberOfWrites);
+}
+
+W_RESULT w_bindless_texture_table::bind(
+	_In_ const w_command_buffer& pCommandBuffer,
+	_In_ const w_pipeline_bind_point& pPipelineBindPoint,
+	_In_ const VkPipelineLayout& pPipelineLayout,
+	_In_ const uint32_t& pSetIndex,
+	_In_ const uint32_t& pFrameIndex)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->bind(pCommandBuffer, pPipelineBindPoint, pPipelineLayout, pSetIndex, pFrameIndex);
+}
+
+ULONG w_bindless_texture_table::release()
+{
+	if (_super::get_is_released()) return 0;
+
+	SAFE_RELEASE(this->_pimp);
+
+	return _super::release();
+}
+
+#pragma region Getters
+
+uint32_t w_bindless_texture_table::get_slot(_In_ const w_texture* pTexture) const
+{
+	if (!this->_pimp) return UINT32_MAX;
+	return this->_pimp->get_slot(pTexture);
+}
+
+const w_descriptor_set w_bindless_texture_table::get_descriptor_set(_In_ const uint32_t& pFrameIndex) const
+{
+	if (!this->_pimp) return w_descriptor_set();
+	return this->_pimp->get_descriptor_set(pFrameIndex);
+}
+
+const w_descriptor_set_layout w_bindless_texture_table::get_descriptor_set_layout() const
+{
+	if (!this->_pimp) return w_descriptor_set_layout();
+	return this->_pimp->get_descriptor_set_layout();
+}
+
+const w_bindless_texture_table_statistics w_bindless_texture_table::get_statistics() const
+{
+	if (!this->_pimp) return w_bindless_texture_table_statistics();
+	return this->_pimp->get_statistics();
+}
+
+#pragma endregion
@@ -0,0 +1,143 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_bindless_texture_table.h
+	Description		 : Table of textures which are accessible from shaders by index, one descriptor set for all materials
+	Comment          : Each texture gets a stable slot of one large array of combined image samplers, so draws which only differ
+					   by texture can be batched and index of material is carried in instance data.
+					   If VK_EXT_descriptor_indexing has been enabled, array will be partially bound and can be indexed
+					   with nonuniformEXT, i.e. layout(set = 1, binding = 0) uniform sampler2D t_textures[];
+					   Otherwise unused slots will refer to w_texture::default_texture and index must be dynamically uniform,
+					   so draws must be split by material.
+					   Each frame in flight has its own descriptor set, so writes of one frame never touch descriptors which are
+					   used by pending command buffers of other frames, and released slots are reused once all frames have been updated
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_BINDLESS_TEXTURE_TABLE_H__
+#define __W_BINDLESS_TEXTURE_TABLE_H__
+
+#include "w_graphics_device_manager.h"
+#include "w_command_buffers.h"
+#include "w_texture.h"
+
+namespace wolf
+{
+	namespace graphics
+	{
+		struct w_bindless_texture_table_statistics
+		{
+			//number of slots of table
+			uint32_t	capacity = 0;
+			//number of descriptor sets, one for each frame in flight
+			uint32_t	number_of_frames = 0;
+			//number of slots which refer to textures
+			uint32_t	used_slots = 0;
+			//number of released slots which will be reused
+			uint32_t	released_slots = 0;
+			//the most descriptor writes which are pending for one frame
+			uint32_t	pending_writes = 0;
+			//true means array is partially bound and can be indexed non uniformly
+			bool		descriptor_indexing = false;
+		};
+
+		class w_bindless_texture_table_pimp;
+		class w_bindless_texture_table : public system::w_object
+		{
+		public:
+			W_EXP w_bindless_texture_table();
+			W_EXP ~w_bindless_texture_table();
+
+			/*
+				create descriptor sets of table
+				@param pGDevice, graphics device
+				@param pCapacity, maximum number of textures, will be clamped to limits of device if descriptor indexing is not available
+				@param pNumberOfFrames, number of frames in flight, i.e. number of swap chain images, each one has its own descriptor set
+				@param pShaderStages, shader stages which access the table
+				@param pSamplerType, type of sampler of all textures
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const uint32_t& pCapacity,
+				_In_ const uint32_t& pNumberOfFrames,
+				_In_ const w_shader_stage_flag_bits& pShaderStages = w_shader_stage_flag_bits::FRAGMENT_SHADER,
+				_In_ const w_sampler_type& pSamplerType = w_sampler_type::MIPMAP_AND_ANISOTROPY);
+
+			/*
+				add a loaded texture to table, slot of texture will be freed once texture has been released or removed and it will be reused
+				after descriptor sets of all frames have been updated
+				@param pTexture, loaded texture
+				@param pSlot, slot of texture which must be used as index of texture in shaders
+				@return W_PASSED means function did succesfully and W_FAILED means function failed or table is full
+			*/
+			W_EXP W_RESULT add_texture(_In_ w_texture* pTexture, _Out_ uint32_t& pSlot);
+
+			//remove texture from table, its slot will be recycled
+			W_EXP W_RESULT remove_texture(_In_ w_texture* pTexture);
+
+			/*
+				replace texture of a slot with another texture, i.e. when w_texture_streamer changes resident levels of a texture,
+				so indices of materials remain valid
+				@param pTexture, texture which has been added to table
+				@param pNewTexture, loaded texture which will use slot of pTexture
+				@return W_PASSED means function did succesfully and W_FAILED means pTexture has not been added to table
+			*/
+			W_EXP W_RESULT replace_texture(_In_ w_texture* pTexture, _In_ w_texture* pNewTexture);
+
+			/*
+				apply pending descriptor writes to descriptor set of a frame, call it once per frame after previous command buffers
+				of that frame have been completed. Without descriptor indexing, command buffers which have bound this descriptor set
+				must be recorded again if any descriptor has been written
+				@param pFrameIndex, index of frame, i.e. index of swap chain image
+				@param pNumberOfWrites, if not null, number of descriptors which have been written will be stored in it
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT update(_In_ const uint32_t& pFrameIndex, _Out_opt_ uint32_t* pNumberOfWrites = nullptr);
+
+			/*
+				bind descriptor set of a frame, i.e. after binding pipeline which has been created with descriptor set of frame 0
+				@param pCommandBuffer, command buffer of frame
+				@param pPipelineBindPoint, bind point of pipeline
+				@param pPipelineLayout, layout of pipeline
+				@param pSetIndex, index of set which table has been added to, i.e. 1 for w_shader::add_descriptor_set
+				@param pFrameIndex, index of frame
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT bind(
+				_In_ const w_command_buffer& pCommandBuffer,
+				_In_ const w_pipeline_bind_point& pPipelineBindPoint,
+				_In_ const VkPipelineLayout& pPipelineLayout,
+				_In_ const uint32_t& pSetIndex,
+				_In_ const uint32_t& pFrameIndex);
+
+			//release all resources
+			W_EXP ULONG release() override;
+
+#pragma region Getters
+
+			//returns UINT32_MAX if texture has not been added to table
+			W_EXP uint32_t get_slot(_In_ const w_texture* pTexture) const;
+			//add descriptor set of frame 0 to shader with w_shader::add_descriptor_set, then bind descriptor set of each frame with bind
+			W_EXP const w_descriptor_set get_descriptor_set(_In_ const uint32_t& pFrameIndex = 0) const;
+			W_EXP const w_descriptor_set_layout get_descriptor_set_layout() const;
+			W_EXP const w_bindless_texture_table_statistics get_statistics() const;
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_bindless_texture_table(w_bindless_texture_table const&);
+			w_bindless_texture_table& operator= (w_bindless_texture_table const&);
+
+			typedef system::w_object						_super;
+			w_bindless_texture_table_pimp*					_pimp;
+		};
+	}
+}
+
+#endif //__W_BINDLESS_TEXTURE_TABLE_H__
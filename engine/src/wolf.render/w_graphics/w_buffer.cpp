@@ -3,6 +3,7 @@
 #include "w_buffer.h"
 #include <w_convert.h>
 #include "w_command_buffers.h"
+#include "w_memory_allocator.h"
 
 namespace wolf
 {
@@ -58,34 +59,14 @@ namespace wolf
                     this->_buffer_handle.handle,
                     &_buffer_memory_requirements);
 
-                VkPhysicalDeviceMemoryProperties _memory_properties;
-                vkGetPhysicalDeviceMemoryProperties(this->_gDevice->vk_physical_device, &_memory_properties);
-
-				uint32_t _mem_index = 0;
-				if (w_graphics_device_manager::memory_type_from_properties(
-					_memory_properties,
-					_buffer_memory_requirements.memoryTypeBits,
-					_memory_property_flags,
-					&_mem_index))
-				{
-					V(W_FAILED, "finding memory index of buffer for graphics device: " + this->_gDevice->device_info->get_device_name() +
-						" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()), this->_name, 3, false);
-					return W_FAILED;
-				}
-
-				VkMemoryAllocateInfo _memory_allocate_info =
+				//sub allocate from memory blocks of graphics device
+				if (!this->_gDevice->memory_allocator ||
+					this->_gDevice->memory_allocator->allocate(
+						_buffer_memory_requirements,
+						this->_memory_property_flags,
+						false,
+						this->_allocation) == W_FAILED)
 				{
-					VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, // Type
-					nullptr,                                // Next
-					_buffer_memory_requirements.size,       // AllocationSize
-					_mem_index                              // MemoryTypeIndex
-				};
-				if (vkAllocateMemory(this->_gDevice->vk_device,
-					&_memory_allocate_info,
-					nullptr,
-					&this->_memory.handle))
-				{
-					
 					V(W_FAILED, "Allocating memory of buffer for graphics device: " + this->_gDevice->device_info->get_device_name() +
 						" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()), this->_name, 3, false);
 					return W_FAILED;
@@ -102,8 +83,8 @@ namespace wolf
             {
                 return vkBindBufferMemory(this->_gDevice->vk_device,
                     this->_buffer_handle.handle,
-                    this->_memory.handle,
-                    0) == VK_SUCCESS ? W_PASSED : W_FAILED;
+                    this->_allocation.memory.handle,
+                    this->_allocation.offset) == VK_SUCCESS ? W_PASSED : W_FAILED;
 
             }
 
@@ -185,19 +166,10 @@ namespace wolf
                 //we can not access to VRAM, but we can copy our data to DRAM
                 if (this->_memory_property_flags & w_memory_property_flag_bits::DEVICE_LOCAL_BIT) return nullptr;
 
-                auto _size = this->get_size();
-                auto _memory = this->get_memory();
-
-                auto _hr = vkMapMemory(this->_gDevice->vk_device,
-                    _memory.handle,
-                    0,
-                    _size,
-                    0,
-                    &this->_mapped);
-
-                if (_hr)
+                //host visible blocks are mapped persistently by memory allocator
+                this->_mapped = this->_allocation.mapped;
+                if (!this->_mapped)
                 {
-                    this->_mapped = nullptr;
                     V(W_FAILED, "mapping data to to vertex buffer's memory " +
                         _gDevice->get_info(),
                         _trace_info, 3, false);
@@ -210,22 +182,15 @@ namespace wolf
 
             void unmap()
             {
-                if (this->_mapped)
-                {
-                    vkUnmapMemory(this->_gDevice->vk_device, _memory.handle);
-                    this->_mapped = nullptr;
-                }
+                //memory remains mapped until the block is released
+                this->_mapped = nullptr;
             }
 
             W_RESULT flush(VkDeviceSize pSize, VkDeviceSize pOffset)
             {
-                VkMappedMemoryRange _mapped_range = {};
-                _mapped_range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
-                _mapped_range.memory = this->_memory.handle;
-                _mapped_range.offset = pOffset;
-                _mapped_range.size = pSize;
+                if (!this->_gDevice || !this->_gDevice->memory_allocator) return W_FAILED;
 
-                return vkFlushMappedMemoryRanges(this->_gDevice->vk_device, 1, &_mapped_range) == VK_SUCCESS ? W_PASSED : W_FAILED;
+                return this->_gDevice->memory_allocator->flush(this->_allocation, pOffset, pSize);
             }
             
             ULONG release()
@@ -244,13 +209,9 @@ namespace wolf
                     this->_buffer_handle.handle = 0;
                 }
                 
-                if(this->_memory.handle)
+                if(this->_allocation.memory.handle && this->_gDevice->memory_allocator)
                 {
-                    vkFreeMemory(this->_gDevice->vk_device,
-                                 this->_memory.handle,
-                                 nullptr);
-                    
-                    this->_memory.handle = 0;
+                    this->_gDevice->memory_allocator->free(this->_allocation);
                 }
 
                 this->_gDevice = nullptr;
@@ -280,7 +241,12 @@ namespace wolf
             
             const w_device_memory get_memory() const
             {
-                return this->_memory;
+                return this->_allocation.memory;
+            }
+
+            const uint64_t get_memory_offset() const
+            {
+                return this->_allocation.offset;
             }
             
             const w_descriptor_buffer_info get_descriptor_info() const
@@ -294,7 +260,7 @@ namespace wolf
             uint32_t                                            _size_in_bytes;
             void*                                               _mapped;            
 			w_buffer_handle                                     _buffer_handle;
-			w_device_memory                                     _memory;
+			w_memory_allocation                                 _allocation;
 			uint32_t											_memory_property_flags;
 			uint32_t											_usage_flags;
 			w_descriptor_buffer_info                            _descriptor_info;
@@ -426,6 +392,13 @@ const w_device_memory w_buffer::get_memory() const
     return this->_pimp->get_memory();
 }
 
+const uint64_t w_buffer::get_memory_offset() const
+{
+    if(!this->_pimp) return 0;
+    
+    return this->_pimp->get_memory_offset();
+}
+
 const w_descriptor_buffer_info w_buffer::get_descriptor_info() const
 {
 	if (!this->_pimp)
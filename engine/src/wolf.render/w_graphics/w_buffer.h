@@ -53,6 +53,8 @@ namespace wolf
             W_EXP const uint32_t				      get_memory_flags() const;
             W_EXP const w_buffer_handle               get_buffer_handle() const;
             W_EXP const w_device_memory               get_memory() const;
+            //offset of this buffer inside the device memory, the memory might be shared with other buffers
+            W_EXP const uint64_t                      get_memory_offset() const;
             W_EXP const w_descriptor_buffer_info      get_descriptor_info() const;
 
 #pragma endregion
@@ -357,7 +357,10 @@ const size_t w_command_buffers::get_commands_size() const
 
 #pragma region w_indirect_draws_command_buffer
 
-W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_graphics_device>& pGDevice, _In_ const uint32_t& pDrawCount)
+W_RESULT w_indirect_draws_command_buffer::load(
+	_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_ const uint32_t& pDrawCount,
+	_In_ const uint32_t& pNumberOfFrames)
 {
 	const std::string _trace_info = "w_indirect_draws_command_buffer::load";
 
@@ -378,7 +381,38 @@ W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_grap
 		_staging_buffer.release();
 	});
 
-	uint32_t _size = (uint32_t)(pDrawCount * sizeof(w_draw_indexed_indirect_command));
+	if (!pNumberOfFrames)
+	{
+		V(W_FAILED, "number of frames must be at least one", _trace_info, 3);
+		return W_FAILED;
+	}
+
+	this->frame_size = (uint32_t)(pDrawCount * sizeof(w_draw_indexed_indirect_command));
+	this->frame_stride = this->frame_size;
+
+	//data of all regions, drawing commands after draw count remain zero
+	std::vector<uint8_t> _data;
+	if (pNumberOfFrames > 1)
+	{
+		//compute shaders may write all drawing commands of their region
+		this->frame_size = (uint32_t)(this->drawing_commands.size() * sizeof(w_draw_indexed_indirect_command));
+
+		//dynamic offsets must be multiple of minStorageBufferOffsetAlignment
+		auto _alignment = static_cast<uint32_t>(std::max<VkDeviceSize>(1,
+			pGDevice->device_info->device_properties->limits.minStorageBufferOffsetAlignment));
+		this->frame_stride = (this->frame_size + _alignment - 1) / _alignment * _alignment;
+
+		_data.resize(this->frame_stride * pNumberOfFrames, 0);
+		for (uint32_t i = 0; i < pNumberOfFrames; ++i)
+		{
+			std::memcpy(
+				_data.data() + i * this->frame_stride,
+				this->drawing_commands.data(),
+				pDrawCount * sizeof(w_draw_indexed_indirect_command));
+		}
+	}
+
+	uint32_t _size = this->frame_stride * pNumberOfFrames;
 	if (_staging_buffer.load_as_staging(pGDevice, _size) == W_FAILED)
 	{
 		V(W_FAILED, "loading staging buffer of indirect_draw_commands", _trace_info, 3);
@@ -391,7 +425,7 @@ W_RESULT w_indirect_draws_command_buffer::load(_In_ const std::shared_ptr<w_grap
 		return W_FAILED;
 	}
 
-	if (_staging_buffer.set_data(this->drawing_commands.data()) == S_FALSE)
+	if (_staging_buffer.set_data(_data.size() ? (const void*)_data.data() : (const void*)this->drawing_commands.data()) == S_FALSE)
 	{
 		V(W_FAILED, "setting data for staging buffer of indirect_draw_commands", _trace_info, 3);
 		return W_FAILED;
@@ -108,8 +108,29 @@ namespace wolf
 		{
 			wolf::graphics::w_buffer                                buffer;
 			std::vector<w_draw_indexed_indirect_command>            drawing_commands;
+			//size of region of each frame in bytes
+			uint32_t                                                frame_size = 0;
+			//distance between regions of two frames in bytes
+			uint32_t                                                frame_stride = 0;
 
-			W_EXP W_RESULT load(_In_ const std::shared_ptr<w_graphics_device>& pGDevice, _In_ const uint32_t& pDrawCount);
+			/*
+				load buffer of indirect draws
+				@param pGDevice, graphics device
+				@param pDrawCount, number of drawing commands which will be copied to the region of each frame
+				@param pNumberOfFrames, number of frames in flight. More than one frame keeps one region for each frame,
+					regions have room for all drawing commands and they are aligned for binding as STORAGE_DYNAMIC
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const uint32_t& pDrawCount,
+				_In_ const uint32_t& pNumberOfFrames = 1);
+
+			//offset of region of a frame in bytes
+			uint32_t get_offset_at(_In_ const uint32_t& pFrameIndex) const
+			{
+				return pFrameIndex * this->frame_stride;
+			}
 		};
 	}
 }
@@ -46,14 +46,40 @@ W_RESULT w_fences::initialize(_In_ const std::shared_ptr<w_graphics_device>& pGD
 
 W_RESULT w_fences::wait(_In_ uint64_t pTimeOut)
 {
-    return vkWaitForFences(this->_gDevice->vk_device, 1, this->_fences.data(), VK_TRUE, pTimeOut) == VkResult::VK_SUCCESS ? W_PASSED : W_FAILED;
+    if (this->_fences.size() == 0) return W_FAILED;
+    return vkWaitForFences(
+        this->_gDevice->vk_device,
+        static_cast<uint32_t>(this->_fences.size()),
+        this->_fences.data(),
+        VK_TRUE,
+        pTimeOut) == VkResult::VK_SUCCESS ? W_PASSED : W_FAILED;
+}
+
+W_RESULT w_fences::wait_at(_In_ const uint32_t& pIndex, _In_ uint64_t pTimeOut)
+{
+    if (pIndex >= this->_fences.size()) return W_FAILED;
+    return vkWaitForFences(this->_gDevice->vk_device, 1, &this->_fences[pIndex], VK_TRUE, pTimeOut) == VkResult::VK_SUCCESS ? W_PASSED : W_FAILED;
 }
 
 W_RESULT w_fences::reset()
 {
-    //reset fence
+    //reset fences
 #ifdef __VULKAN__
-    return vkResetFences(this->_gDevice->vk_device, 1, this->_fences.data()) == VkResult::VK_SUCCESS ? W_PASSED : W_FAILED;
+    if (this->_fences.size() == 0) return W_FAILED;
+    return vkResetFences(
+        this->_gDevice->vk_device,
+        static_cast<uint32_t>(this->_fences.size()),
+        this->_fences.data()) == VkResult::VK_SUCCESS ? W_PASSED : W_FAILED;
+#elif defined(__DX12__)
+    
+#endif
+}
+
+W_RESULT w_fences::reset_at(_In_ const uint32_t& pIndex)
+{
+#ifdef __VULKAN__
+    if (pIndex >= this->_fences.size()) return W_FAILED;
+    return vkResetFences(this->_gDevice->vk_device, 1, &this->_fences[pIndex]) == VkResult::VK_SUCCESS ? W_PASSED : W_FAILED;
 #elif defined(__DX12__)
     
 #endif
@@ -65,6 +91,12 @@ VkFence* w_fences::get()
     return &(this->_fences.at(0));
 }
 
+VkFence* w_fences::get_at(_In_ const uint32_t& pIndex)
+{
+    if (pIndex >= this->_fences.size())  return nullptr;
+    return &(this->_fences.at(pIndex));
+}
+
 VkFence* w_fences::get_all()
 {
     if (this->_fences.size() == 0)  return nullptr;
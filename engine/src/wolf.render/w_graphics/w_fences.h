@@ -28,10 +28,16 @@ namespace wolf
             W_EXP W_RESULT initialize(_In_ const std::shared_ptr<w_graphics_device>& pGDevice, _In_ const uint32_t pNumberOfFences = 1);
             //wait for all fence for the timeout period in units of nanoseconds
             W_EXP W_RESULT wait(_In_ uint64_t pTimeOut = UINT64_MAX - 1);
+            //wait for the fence at index for the timeout period in units of nanoseconds
+            W_EXP W_RESULT wait_at(_In_ const uint32_t& pIndex, _In_ uint64_t pTimeOut = UINT64_MAX - 1);
             //reset all fences
             W_EXP W_RESULT reset();
+            //reset the fence at index
+            W_EXP W_RESULT reset_at(_In_ const uint32_t& pIndex);
             //get pointer to the first fence
             W_EXP VkFence* get();
+            //get pointer to the fence at index
+            W_EXP VkFence* get_at(_In_ const uint32_t& pIndex);
             //get all fences
             W_EXP VkFence* get_all();
             //get number of fences
@@ -0,0 +1,758 @@
+#include "w_render_pch.h"
+#include "w_gpu_driven_renderer.h"
+#include "w_buffer.h"
+#include "w_shader.h"
+#include "w_pipeline.h"
+#include "w_uniform.h"
+#include "w_upload_manager.h"
+
+namespace wolf
+{
+	namespace graphics
+	{
+		//layout of this structure must match with std140 layout of uniform of compute shader
+		struct w_gpu_driven_cull_uniform
+		{
+			glm::mat4	view_projection;
+			glm::vec4	frustum_planes[6];
+			//w is scale of lod distances
+			glm::vec4	camera_position;
+			//x is number of instances
+			glm::uvec4	counts;
+			//xy is size of first mip of hi-z pyramid and z is number of mips
+			glm::vec4	hi_z;
+		};
+
+		//layout of this structure must match with statistics buffer of compute shader, draw_count is the count buffer of indirect draws
+		struct w_gpu_driven_cull_output
+		{
+			uint32_t	draw_count;
+			uint32_t	culled_by_frustum;
+			uint32_t	culled_by_hi_z;
+			uint32_t	padding;
+		};
+
+		class w_gpu_driven_renderer_pimp
+		{
+		public:
+			w_gpu_driven_renderer_pimp() :
+				_name("w_gpu_driven_renderer"),
+				_gDevice(nullptr),
+				_shader(nullptr),
+				_number_of_instances(0),
+				_number_of_frames(1),
+				_local_size(64),
+				_upload_ticket(0),
+				_query_pool(0),
+				_timestamp_period(0.0f)
+#ifdef VK_KHR_draw_indirect_count
+				, _vkCmdDrawIndexedIndirectCountKHR(nullptr)
+#endif
+			{
+			}
+
+			~w_gpu_driven_renderer_pimp()
+			{
+				release();
+			}
+
+			W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const void* const pVertices,
+				_In_ const uint32_t& pVerticesSizeInBytes,
+				_In_ const std::vector<uint32_t>& pIndices,
+				_In_ const std::vector<w_gpu_driven_mesh>& pMeshes,
+				_In_ const std::vector<w_gpu_driven_lod>& pLODs,
+				_In_ const std::vector<w_gpu_driven_instance>& pInstances,
+				_In_opt_ const w_gpu_driven_hi_z* pHiZ,
+				_In_ const uint32_t& pNumberOfFrames)
+			{
+				const std::string _trace_info = this->_name + "::load";
+
+				if (!pGDevice || !pVertices || !pVerticesSizeInBytes || !pNumberOfFrames ||
+					pIndices.empty() || pMeshes.empty() || pLODs.empty() || pInstances.empty())
+				{
+					V(W_FAILED, "invalid parameters", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//first instance of each indirect draw is the index of its instance
+				if (!pGDevice->vk_physical_device_features.drawIndirectFirstInstance)
+				{
+					V(W_FAILED, "drawIndirectFirstInstance feature is not supported by graphics device: " + pGDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				release();
+
+				this->_gDevice = pGDevice;
+				this->_number_of_instances = static_cast<uint32_t>(pInstances.size());
+				this->_number_of_frames = pNumberOfFrames;
+				this->_statistics = w_gpu_driven_statistics();
+				this->_statistics.number_of_instances = this->_number_of_instances;
+				this->_statistics.hi_z = pHiZ != nullptr;
+
+				//shared vertex and index buffers
+				if (_load_device_buffer(
+					this->_vertex_buffer,
+					pVertices,
+					pVerticesSizeInBytes,
+					VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+					VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+					VK_PIPELINE_STAGE_VERTEX_INPUT_BIT) == W_FAILED ||
+					_load_device_buffer(
+						this->_index_buffer,
+						pIndices.data(),
+						static_cast<uint32_t>(pIndices.size() * sizeof(uint32_t)),
+						VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+						VK_ACCESS_INDEX_READ_BIT,
+						VK_PIPELINE_STAGE_VERTEX_INPUT_BIT) == W_FAILED)
+				{
+					V(W_FAILED, "loading shared vertex and index buffers", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//tables of compute shader
+				if (_load_device_buffer(
+					this->_instances_buffer,
+					pInstances.data(),
+					static_cast<uint32_t>(pInstances.size() * sizeof(w_gpu_driven_instance)),
+					VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+					VK_ACCESS_SHADER_READ_BIT,
+					VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) == W_FAILED ||
+					_load_device_buffer(
+						this->_meshes_buffer,
+						pMeshes.data(),
+						static_cast<uint32_t>(pMeshes.size() * sizeof(w_gpu_driven_mesh)),
+						VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+						VK_ACCESS_SHADER_READ_BIT,
+						VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) == W_FAILED ||
+					_load_device_buffer(
+						this->_lods_buffer,
+						pLODs.data(),
+						static_cast<uint32_t>(pLODs.size() * sizeof(w_gpu_driven_lod)),
+						VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+						VK_ACCESS_SHADER_READ_BIT,
+						VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT) == W_FAILED)
+				{
+					V(W_FAILED, "loading instances, meshes and lods tables", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//one indirect draw for each instance, it will be cleared and compacted by GPU in each frame
+				if (this->_indirect_draws_buffer.load(
+					this->_gDevice,
+					this->_number_of_instances * static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand)),
+					VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == W_FAILED ||
+					this->_indirect_draws_buffer.bind() == W_FAILED)
+				{
+					V(W_FAILED, "loading indirect draws buffer", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//output of compute shader is small and will be read by CPU for statistics, so it is hosted in DRAM
+				if (this->_output_buffer.load(
+					this->_gDevice,
+					static_cast<uint32_t>(sizeof(w_gpu_driven_cull_output)),
+					VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == W_FAILED ||
+					this->_output_buffer.bind() == W_FAILED)
+				{
+					V(W_FAILED, "loading output buffer", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//each frame has its own region of uniform, so camera of a frame can be updated while other frames are in flight
+				if (this->_uniform.load(this->_gDevice, true, this->_number_of_frames) == W_FAILED)
+				{
+					V(W_FAILED, "loading uniform", _trace_info, 3, false);
+					return W_FAILED;
+				}
+				std::memset(&this->_uniform.data, 0, sizeof(w_gpu_driven_cull_uniform));
+				this->_uniform.data.counts.x = this->_number_of_instances;
+				this->_uniform.data.camera_position.w = 1.0f;
+				if (pHiZ)
+				{
+					this->_uniform.data.hi_z = glm::vec4(
+						static_cast<float>(pHiZ->width),
+						static_cast<float>(pHiZ->height),
+						static_cast<float>(pHiZ->mip_levels),
+						0.0f);
+				}
+				if (this->_uniform.update() == W_FAILED)
+				{
+					V(W_FAILED, "updating uniform", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				if (_load_pipeline(pHiZ) == W_FAILED) return W_FAILED;
+
+				_load_draw_indirect_count();
+				_load_query_pool();
+
+				return W_PASSED;
+			}
+
+			W_RESULT set_camera(
+				_In_ const glm::mat4& pViewProjection,
+				_In_ const glm::vec3& pCameraPosition,
+				_In_ const float& pLODDistanceScale,
+				_In_ const uint32_t& pFrameIndex)
+			{
+				if (!this->_gDevice || pFrameIndex >= this->_number_of_frames) return W_FAILED;
+
+				auto _data = &this->_uniform.data;
+				_data->view_projection = pViewProjection;
+				_data->camera_position = glm::vec4(pCameraPosition, pLODDistanceScale);
+
+				//extract planes of frustum, depth range of projection is zero to one
+				const auto& _m = pViewProjection;
+				for (int i = 0; i < 3; ++i)
+				{
+					_data->frustum_planes[i * 2] = glm::vec4(_m[0][3] + _m[0][i], _m[1][3] + _m[1][i], _m[2][3] + _m[2][i], _m[3][3] + _m[3][i]);
+					_data->frustum_planes[i * 2 + 1] = glm::vec4(_m[0][3] - _m[0][i], _m[1][3] - _m[1][i], _m[2][3] - _m[2][i], _m[3][3] - _m[3][i]);
+				}
+				//near plane
+				_data->frustum_planes[4] = glm::vec4(_m[0][2], _m[1][2], _m[2][2], _m[3][2]);
+				for (auto& _plane : _data->frustum_planes)
+				{
+					auto _length = glm::length(glm::vec3(_plane));
+					if (_length > 0.0f)
+					{
+						_plane /= _length;
+					}
+				}
+
+				return this->_uniform.update_at(pFrameIndex);
+			}
+
+			W_RESULT record_culling(
+				_In_ const w_command_buffer& pCommandBuffer,
+				_In_ const uint32_t& pFrameIndex)
+			{
+				if (!this->_gDevice || !pCommandBuffer.handle || pFrameIndex >= this->_number_of_frames) return W_FAILED;
+
+				auto _cmd = pCommandBuffer.handle;
+				auto _indirect_draws_buffer = this->_indirect_draws_buffer.get_buffer_handle().handle;
+				auto _output_buffer = this->_output_buffer.get_buffer_handle().handle;
+
+				//each frame has two queries, which will be reset when command buffer of that frame is executed
+				auto _first_query = pFrameIndex * 2;
+				if (this->_query_pool)
+				{
+					vkCmdResetQueryPool(_cmd, this->_query_pool, _first_query, 2);
+					vkCmdWriteTimestamp(_cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, this->_query_pool, _first_query);
+				}
+
+				//wait for indirect draws of the previous pass, even if it belongs to another frame, before clearing them
+				VkBufferMemoryBarrier _barriers[2] = {};
+				for (auto& _barrier : _barriers)
+				{
+					_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+					_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+					_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+					_barrier.size = VK_WHOLE_SIZE;
+				}
+				_barriers[0].buffer = _indirect_draws_buffer;
+				_barriers[1].buffer = _output_buffer;
+
+				_set_barriers_access(_barriers, VK_ACCESS_INDIRECT_COMMAND_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT);
+				vkCmdPipelineBarrier(
+					_cmd,
+					VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+					VK_PIPELINE_STAGE_TRANSFER_BIT,
+					0,
+					0, nullptr,
+					2, _barriers,
+					0, nullptr);
+
+				//without count buffer, all indirect draws will be drawn, so draws after the compacted ones must have zero instances
+				if (!_use_draw_indirect_count())
+				{
+					vkCmdFillBuffer(_cmd, _indirect_draws_buffer, 0, VK_WHOLE_SIZE, 0);
+				}
+				vkCmdFillBuffer(_cmd, _output_buffer, 0, VK_WHOLE_SIZE, 0);
+
+				_set_barriers_access(_barriers, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT);
+				vkCmdPipelineBarrier(
+					_cmd,
+					VK_PIPELINE_STAGE_TRANSFER_BIT,
+					VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+					0,
+					0, nullptr,
+					2, _barriers,
+					0, nullptr);
+
+				if (this->_pipeline.bind(
+					pCommandBuffer,
+					w_pipeline_bind_point::COMPUTE,
+					{ this->_uniform.get_dynamic_offset_at(pFrameIndex) }) == W_FAILED) return W_FAILED;
+
+				vkCmdDispatch(_cmd, (this->_number_of_instances + this->_local_size - 1) / this->_local_size, 1, 1);
+
+				//indirect draws and count must be written before they are consumed, output will be read by host too
+				_set_barriers_access(_barriers, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_INDIRECT_COMMAND_READ_BIT);
+				_barriers[1].dstAccessMask |= VK_ACCESS_HOST_READ_BIT;
+				vkCmdPipelineBarrier(
+					_cmd,
+					VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+					VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_HOST_BIT,
+					0,
+					0, nullptr,
+					2, _barriers,
+					0, nullptr);
+
+				if (this->_query_pool)
+				{
+					vkCmdWriteTimestamp(_cmd, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, this->_query_pool, _first_query + 1);
+				}
+
+				return W_PASSED;
+			}
+
+			W_RESULT draw(
+				_In_ const w_command_buffer& pCommandBuffer,
+				_In_opt_ const w_buffer_handle* pInstanceHandle)
+			{
+				if (!this->_gDevice || !pCommandBuffer.handle) return W_FAILED;
+
+				auto _cmd = pCommandBuffer.handle;
+				VkDeviceSize _offsets[1] = { 0 };
+
+				auto _vertex_buffer = this->_vertex_buffer.get_buffer_handle().handle;
+				vkCmdBindVertexBuffers(_cmd, 0, 1, &_vertex_buffer, _offsets);
+				if (pInstanceHandle && pInstanceHandle->handle)
+				{
+					vkCmdBindVertexBuffers(_cmd, 1, 1, &pInstanceHandle->handle, _offsets);
+				}
+				vkCmdBindIndexBuffer(_cmd, this->_index_buffer.get_buffer_handle().handle, 0, VK_INDEX_TYPE_UINT32);
+
+				auto _stride = static_cast<uint32_t>(sizeof(VkDrawIndexedIndirectCommand));
+				auto _indirect_draws_buffer = this->_indirect_draws_buffer.get_buffer_handle().handle;
+
+#ifdef VK_KHR_draw_indirect_count
+				if (_use_draw_indirect_count())
+				{
+					this->_vkCmdDrawIndexedIndirectCountKHR(
+						_cmd,
+						_indirect_draws_buffer,
+						0,
+						this->_output_buffer.get_buffer_handle().handle,
+						0,
+						this->_number_of_instances,
+						_stride);
+					return W_PASSED;
+				}
+#endif
+				if (this->_gDevice->vk_physical_device_features.multiDrawIndirect)
+				{
+					vkCmdDrawIndexedIndirect(
+						_cmd,
+						_indirect_draws_buffer,
+						0,
+						this->_number_of_instances,
+						_stride);
+				}
+				else
+				{
+					//if multi draw is not available, we must issue separate draw commands
+					for (uint32_t i = 0; i < this->_number_of_instances; ++i)
+					{
+						vkCmdDrawIndexedIndirect(
+							_cmd,
+							_indirect_draws_buffer,
+							i * _stride,
+							1,
+							_stride);
+					}
+				}
+
+				return W_PASSED;
+			}
+
+			ULONG release()
+			{
+				if (!this->_gDevice) return 0;
+
+				//GPU must not be using uploads of this object
+				if (this->_upload_ticket && this->_gDevice->upload_manager)
+				{
+					this->_gDevice->upload_manager->wait(this->_upload_ticket);
+				}
+				this->_upload_ticket = 0;
+
+				if (this->_query_pool)
+				{
+					vkDestroyQueryPool(this->_gDevice->vk_device, this->_query_pool, nullptr);
+					this->_query_pool = 0;
+				}
+
+				this->_pipeline.release();
+				SAFE_RELEASE(this->_shader);
+
+				this->_uniform.release();
+				this->_output_buffer.release();
+				this->_indirect_draws_buffer.release();
+				this->_lods_buffer.release();
+				this->_meshes_buffer.release();
+				this->_instances_buffer.release();
+				this->_index_buffer.release();
+				this->_vertex_buffer.release();
+
+#ifdef VK_KHR_draw_indirect_count
+				this->_vkCmdDrawIndexedIndirectCountKHR = nullptr;
+#endif
+				this->_number_of_instances = 0;
+				this->_number_of_frames = 1;
+				this->_gDevice = nullptr;
+
+				return 0;
+			}
+
+#pragma region Getters
+
+			uint32_t get_number_of_instances() const
+			{
+				return this->_number_of_instances;
+			}
+
+			w_gpu_driven_statistics get_statistics()
+			{
+				if (!this->_gDevice) return this->_statistics;
+
+				_read_timestamps();
+
+				auto _mapped = static_cast<w_gpu_driven_cull_output*>(this->_output_buffer.map());
+				if (_mapped)
+				{
+					this->_statistics.number_of_draws = _mapped->draw_count;
+					this->_statistics.culled_by_frustum = _mapped->culled_by_frustum;
+					this->_statistics.culled_by_hi_z = _mapped->culled_by_hi_z;
+					this->_output_buffer.unmap();
+				}
+				return this->_statistics;
+			}
+
+#pragma endregion
+
+		private:
+			W_RESULT _load_device_buffer(
+				_Inout_ w_buffer& pBuffer,
+				_In_ const void* const pData,
+				_In_ const uint32_t& pSizeInBytes,
+				_In_ const uint32_t& pUsage,
+				_In_ const VkAccessFlags& pDstAccessMask,
+				_In_ const VkPipelineStageFlags& pDstStageMask)
+			{
+				if (pBuffer.load(
+					this->_gDevice,
+					pSizeInBytes,
+					pUsage | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+					VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == W_FAILED ||
+					pBuffer.bind() == W_FAILED)
+				{
+					return W_FAILED;
+				}
+
+				//copies will be submitted in one batch, before the first command buffer which uses this object
+				if (this->_gDevice->upload_manager)
+				{
+					return this->_gDevice->upload_manager->upload_buffer(
+						pData,
+						pSizeInBytes,
+						pBuffer.get_buffer_handle().handle,
+						0,
+						pDstAccessMask,
+						pDstStageMask,
+						&this->_upload_ticket);
+				}
+
+				w_buffer _staging_buffer;
+				if (_staging_buffer.load_as_staging(this->_gDevice, pSizeInBytes) == W_FAILED ||
+					_staging_buffer.bind() == W_FAILED ||
+					_staging_buffer.set_data(pData) == W_FAILED ||
+					_staging_buffer.copy_to(pBuffer) == W_FAILED)
+				{
+					_staging_buffer.release();
+					return W_FAILED;
+				}
+				_staging_buffer.release();
+
+				return W_PASSED;
+			}
+
+			W_RESULT _load_pipeline(_In_opt_ const w_gpu_driven_hi_z* pHiZ)
+			{
+				const std::string _trace_info = this->_name + "::_load_pipeline";
+
+				std::vector<w_shader_binding_param> _shader_params;
+
+				w_shader_binding_param _shader_param;
+				_shader_param.index = 0;
+				_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
+				_shader_param.stage = w_shader_stage_flag_bits::COMPUTE_SHADER;
+				_shader_param.buffer_info = this->_uniform.get_descriptor_info();
+				_shader_params.push_back(_shader_param);
+
+				const w_buffer* _storages[] =
+				{
+					&this->_instances_buffer,
+					&this->_meshes_buffer,
+					&this->_lods_buffer,
+					&this->_indirect_draws_buffer,
+					&this->_output_buffer
+				};
+				for (size_t i = 0; i < 5; ++i)
+				{
+					_shader_param.index = static_cast<uint32_t>(i + 1);
+					_shader_param.type = w_shader_binding_type::STORAGE;
+					_shader_param.buffer_info = _storages[i]->get_descriptor_info();
+					_shader_params.push_back(_shader_param);
+				}
+
+				if (pHiZ)
+				{
+					_shader_param.index = 6;
+					_shader_param.type = w_shader_binding_type::SAMPLER2D;
+					_shader_param.image_info = pHiZ->pyramid;
+					_shader_params.push_back(_shader_param);
+				}
+
+				auto _hr = w_shader::load_shader(
+					this->_gDevice,
+					pHiZ ? "gpu_driven_cull_hi_z" : "gpu_driven_cull",
+					L"",
+					L"",
+					L"",
+					L"",
+					L"",
+					content_path + (pHiZ ? L"shaders/compute/gpu_driven_cull_hi_z.comp.spv" : L"shaders/compute/gpu_driven_cull.comp.spv"),
+					_shader_params,
+					false,
+					&this->_shader);
+				_shader_params.clear();
+				if (_hr == W_FAILED)
+				{
+					V(W_FAILED, "loading compute shader", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//local_size_x_id of compute shaders will be specialized with preferred local size of device
+				this->_local_size = w_pipeline::get_preferred_compute_local_size(this->_gDevice);
+				w_specialization_info _specialization_info;
+				_specialization_info.add(0, this->_local_size);
+
+				if (this->_pipeline.load_compute(
+					this->_gDevice,
+					this->_shader,
+					_specialization_info,
+					"gpu_driven_renderer_pipeline_cache") == W_FAILED)
+				{
+					V(W_FAILED, "loading compute pipeline", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				return W_PASSED;
+			}
+
+			void _load_draw_indirect_count()
+			{
+#ifdef VK_KHR_draw_indirect_count
+				//extension must have been enabled by user before creating the device
+				auto _extensions = &this->_gDevice->device_info->device_extensions;
+				for (auto _extension : *_extensions)
+				{
+					if (std::strcmp(_extension, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) == 0)
+					{
+						this->_vkCmdDrawIndexedIndirectCountKHR = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+							vkGetDeviceProcAddr(this->_gDevice->vk_device, "vkCmdDrawIndexedIndirectCountKHR"));
+						break;
+					}
+				}
+#endif
+				this->_statistics.draw_indirect_count = _use_draw_indirect_count();
+			}
+
+			void _load_query_pool()
+			{
+				auto _properties = this->_gDevice->device_info->device_properties;
+				if (!_properties || !_properties->limits.timestampComputeAndGraphics) return;
+
+				VkQueryPoolCreateInfo _query_pool_info = {};
+				_query_pool_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+				_query_pool_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+				_query_pool_info.queryCount = 2 * this->_number_of_frames;
+
+				if (vkCreateQueryPool(this->_gDevice->vk_device, &_query_pool_info, nullptr, &this->_query_pool))
+				{
+					//timing is optional
+					this->_query_pool = 0;
+					return;
+				}
+				this->_timestamp_period = _properties->limits.timestampPeriod;
+			}
+
+			void _read_timestamps()
+			{
+				if (!this->_query_pool) return;
+
+				//do not wait, passes of frames in flight might not have been executed yet
+				for (uint32_t i = 0; i < this->_number_of_frames; ++i)
+				{
+					uint64_t _timestamps[2] = { 0, 0 };
+					if (vkGetQueryPoolResults(
+						this->_gDevice->vk_device,
+						this->_query_pool,
+						i * 2,
+						2,
+						sizeof(_timestamps),
+						_timestamps,
+						sizeof(uint64_t),
+						VK_QUERY_RESULT_64_BIT) == VK_SUCCESS)
+					{
+						this->_statistics.culling_time_in_ms = static_cast<double>(_timestamps[1] - _timestamps[0]) *
+							this->_timestamp_period / 1000000.0;
+					}
+				}
+			}
+
+			bool _use_draw_indirect_count() const
+			{
+#ifdef VK_KHR_draw_indirect_count
+				return this->_vkCmdDrawIndexedIndirectCountKHR != nullptr;
+#else
+				return false;
+#endif
+			}
+
+			static void _set_barriers_access(
+				_Inout_ VkBufferMemoryBarrier (&pBarriers)[2],
+				_In_ const VkAccessFlags& pSrcAccessMask,
+				_In_ const VkAccessFlags& pDstAccessMask)
+			{
+				for (auto& _barrier : pBarriers)
+				{
+					_barrier.srcAccessMask = pSrcAccessMask;
+					_barrier.dstAccessMask = pDstAccessMask;
+				}
+			}
+
+			std::string											_name;
+			std::shared_ptr<w_graphics_device>					_gDevice;
+
+			w_buffer											_vertex_buffer;
+			w_buffer											_index_buffer;
+			w_buffer											_instances_buffer;
+			w_buffer											_meshes_buffer;
+			w_buffer											_lods_buffer;
+			w_buffer											_indirect_draws_buffer;
+			w_buffer											_output_buffer;
+			w_uniform<w_gpu_driven_cull_uniform>				_uniform;
+
+			w_shader*											_shader;
+			w_pipeline											_pipeline;
+
+			uint32_t											_number_of_instances;
+			//number of regions of uniform and pairs of timestamp queries
+			uint32_t											_number_of_frames;
+			//local size of compute shader which has been specialized for device
+			uint32_t											_local_size;
+			uint64_t											_upload_ticket;
+
+			VkQueryPool											_query_pool;
+			float												_timestamp_period;
+#ifdef VK_KHR_draw_indirect_count
+			PFN_vkCmdDrawIndexedIndirectCountKHR				_vkCmdDrawIndexedIndirectCountKHR;
+#endif
+			w_gpu_driven_statistics								_statistics;
+		};
+	}
+}
+
+using namespace wolf::graphics;
+
+w_gpu_driven_renderer::w_gpu_driven_renderer() : _pimp(new w_gpu_driven_renderer_pimp())
+{
+	_super::set_class_name("w_gpu_driven_renderer");
+}
+
+w_gpu_driven_renderer::~w_gpu_driven_renderer()
+{
+	release();
+}
+
+W_RESULT w_gpu_driven_renderer::load(
+	_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_ const void* const pVertices,
+	_In_ const uint32_t& pVerticesSizeInBytes,
+	_In_ const std::vector<uint32_t>& pIndices,
+	_In_ const std::vector<w_gpu_driven_mesh>& pMeshes,
+	_In_ const std::vector<w_gpu_driven_lod>& pLODs,
+	_In_ const std::vector<w_gpu_driven_instance>& pInstances,
+	_In_opt_ const w_gpu_driven_hi_z* pHiZ,
+	_In_ const uint32_t& pNumberOfFrames)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->load(
+		pGDevice,
+		pVertices,
+		pVerticesSizeInBytes,
+		pIndices,
+		pMeshes,
+		pLODs,
+		pInstances,
+		pHiZ,
+		pNumberOfFrames);
+}
+
+W_RESULT w_gpu_driven_renderer::set_camera(
+	_In_ const glm::mat4& pViewProjection,
+	_In_ const glm::vec3& pCameraPosition,
+	_In_ const float& pLODDistanceScale,
+	_In_ const uint32_t& pFrameIndex)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->set_camera(pViewProjection, pCameraPosition, pLODDistanceScale, pFrameIndex);
+}
+
+W_RESULT w_gpu_driven_renderer::record_culling(
+	_In_ const w_command_buffer& pCommandBuffer,
+	_In_ const uint32_t& pFrameIndex)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->record_culling(pCommandBuffer, pFrameIndex);
+}
+
+W_RESULT w_gpu_driven_renderer::draw(
+	_In_ const w_command_buffer& pCommandBuffer,
+	_In_opt_ const w_buffer_handle* pInstanceHandle)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->draw(pCommandBuffer, pInstanceHandle);
+}
+
+ULONG w_gpu_driven_renderer::release()
+{
+	if (_super::get_is_released()) return 0;
+
+	SAFE_RELEASE(this->_pimp);
+
+	return _super::release();
+}
+
+#pragma region Getters
+
+uint32_t w_gpu_driven_renderer::get_number_of_instances() const
+{
+	if (!this->_pimp) return 0;
+	return this->_pimp->get_number_of_instances();
+}
+
+w_gpu_driven_statistics w_gpu_driven_renderer::get_statistics() const
+{
+	if (!this->_pimp) return w_gpu_driven_statistics();
+	return this->_pimp->get_statistics();
+}
+
+#pragma endregion
@@ -0,0 +1,170 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_gpu_driven_renderer.h
+	Description		 : GPU driven renderer stage, frustum culling, lod selection and optional hi-z occlusion culling of all instances
+					   will be done in one compute pass and surviving instances will be compacted into indirect draws
+	Comment          : Meshes of all instances share one vertex and index buffer, so all of them can be drawn with one indirect draw call.
+					   The only per frame work of CPU is updating the camera, which does not depend on number of instances.
+					   Compute shaders are "shaders/compute/gpu_driven_cull.comp.spv" and "shaders/compute/gpu_driven_cull_hi_z.comp.spv" of content path
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_GPU_DRIVEN_RENDERER_H__
+#define __W_GPU_DRIVEN_RENDERER_H__
+
+#include "w_graphics_device_manager.h"
+#include "w_command_buffers.h"
+#include <glm/glm.hpp>
+
+namespace wolf
+{
+	namespace graphics
+	{
+		//layout of these structures must match with std430 layout of compute shader
+		struct w_gpu_driven_instance
+		{
+			//xyz is center of bounding sphere in world space and w is its radius
+			glm::vec4	bounding_sphere;
+			//index of mesh in meshes table
+			uint32_t	mesh_index = 0;
+			uint32_t	padding[3];
+		};
+
+		struct w_gpu_driven_mesh
+		{
+			//index of first lod in lods table, lods must be sorted from the most detailed one
+			uint32_t	first_lod = 0;
+			//number of lods, must be at least one
+			uint32_t	lod_count = 1;
+			uint32_t	padding[2];
+		};
+
+		struct w_gpu_driven_lod
+		{
+			//first index of lod in shared index buffer
+			uint32_t	first_index = 0;
+			uint32_t	index_count = 0;
+			//offset which will be added to indices of lod
+			int32_t		vertex_offset = 0;
+			//lod will be used for instances which their distance to camera is less than or equal to this value,
+			//the last lod of each mesh will be used for all remaining distances
+			float		max_distance = 0.0f;
+		};
+
+		struct w_gpu_driven_hi_z
+		{
+			//sampler and image view of hi-z pyramid, each mip must store the farthest depth of 2x2 texels of previous mip
+			w_descriptor_image_info		pyramid;
+			uint32_t					width = 0;
+			uint32_t					height = 0;
+			uint32_t					mip_levels = 0;
+		};
+
+		struct w_gpu_driven_statistics
+		{
+			uint32_t	number_of_instances = 0;
+			//results of the last completed culling pass
+			uint32_t	number_of_draws = 0;
+			uint32_t	culled_by_frustum = 0;
+			uint32_t	culled_by_hi_z = 0;
+			//GPU time of the last completed culling pass, zero if timestamps are not supported
+			double		culling_time_in_ms = 0.0;
+			//true means vkCmdDrawIndexedIndirectCountKHR will be used, otherwise unused indirect draws will be drawn with zero instances
+			bool		draw_indirect_count = false;
+			bool		hi_z = false;
+		};
+
+		class w_gpu_driven_renderer_pimp;
+		class w_gpu_driven_renderer : public system::w_object
+		{
+		public:
+			W_EXP w_gpu_driven_renderer();
+			W_EXP ~w_gpu_driven_renderer();
+
+			/*
+				upload shared vertex and index buffers, tables of meshes, lods and instances and create the compute pipeline
+				@param pGDevice, graphics device, drawIndirectFirstInstance feature of device is required
+				@param pVertices, vertices of all meshes
+				@param pVerticesSizeInBytes, size of vertices in bytes
+				@param pIndices, indices of all lods of all meshes
+				@param pMeshes, table of meshes
+				@param pLODs, table of lods
+				@param pInstances, all instances, first instance of each indirect draw will be the index of its instance
+				@param pHiZ, if not null, instances which are behind hi-z pyramid will be culled too
+				@param pNumberOfFrames, number of frames in flight, usually number of swap chain images. Each frame has its own camera and timestamps
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const void* const pVertices,
+				_In_ const uint32_t& pVerticesSizeInBytes,
+				_In_ const std::vector<uint32_t>& pIndices,
+				_In_ const std::vector<w_gpu_driven_mesh>& pMeshes,
+				_In_ const std::vector<w_gpu_driven_lod>& pLODs,
+				_In_ const std::vector<w_gpu_driven_instance>& pInstances,
+				_In_opt_ const w_gpu_driven_hi_z* pHiZ = nullptr,
+				_In_ const uint32_t& pNumberOfFrames = 1);
+
+			/*
+				set camera of the next culling pass of a frame, the previous submission of this frame must be completed by GPU
+				@param pViewProjection, view projection matrix with depth range of zero to one
+				@param pCameraPosition, position of camera in world space
+				@param pLODDistanceScale, distance of instances will be multiplied by this value before selecting lods
+				@param pFrameIndex, index of frame
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT set_camera(
+				_In_ const glm::mat4& pViewProjection,
+				_In_ const glm::vec3& pCameraPosition,
+				_In_ const float& pLODDistanceScale = 1.0f,
+				_In_ const uint32_t& pFrameIndex = 0);
+
+			/*
+				record the culling pass of a frame, must be recorded outside of render pass and before draw.
+				Indirect draws are shared between frames, so passes of frames will be serialized on graphics queue
+				@param pCommandBuffer, command buffer of graphics queue
+				@param pFrameIndex, index of frame which its camera will be used
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT record_culling(
+				_In_ const w_command_buffer& pCommandBuffer,
+				_In_ const uint32_t& pFrameIndex = 0);
+
+			/*
+				bind shared vertex and index buffers and draw surviving instances, graphics pipeline must be bound before
+				@param pCommandBuffer, command buffer which has begun the render pass
+				@param pInstanceHandle, if not null, it will be bound as per instance vertex buffer at binding one
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT draw(
+				_In_ const w_command_buffer& pCommandBuffer,
+				_In_opt_ const w_buffer_handle* pInstanceHandle = nullptr);
+
+			//release all resources
+			W_EXP ULONG release() override;
+
+#pragma region Getters
+
+			W_EXP uint32_t get_number_of_instances() const;
+			//statistics will be read from the last completed frame, so they may be one or more frames old
+			W_EXP w_gpu_driven_statistics get_statistics() const;
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_gpu_driven_renderer(w_gpu_driven_renderer const&);
+			w_gpu_driven_renderer& operator= (w_gpu_driven_renderer const&);
+
+			typedef system::w_object						_super;
+			w_gpu_driven_renderer_pimp*						_pimp;
+		};
+	}
+}
+
+#endif //__W_GPU_DRIVEN_RENDERER_H__
@@ -20,8 +20,6 @@ namespace wolf
         public:
             w_imgui_pimp() :
                 _gDevice(nullptr),
-                _vertex_buffer(nullptr),
-                _index_buffer(nullptr),
                 _font_texture(nullptr)
             {
             }
@@ -139,6 +137,9 @@ namespace wolf
 					V(W_FAILED, "creating command buffers", _trace_info, 3);
 					return W_FAILED;
 				}
+				//one vertex and index buffer for each frame in flight
+				this->_vertex_buffers.resize(this->_command_buffers.get_commands_size(), nullptr);
+				this->_index_buffers.resize(this->_command_buffers.get_commands_size(), nullptr);
 
 				// Create fonts texture
 				uint8_t* _font_data = nullptr;
@@ -441,36 +442,35 @@ namespace wolf
                 ImGui::Render();
             }
 
-			W_RESULT render()
+			W_RESULT render(_In_ const uint32_t& pFrameIndex)
 			{
 				const std::string _trace_info = this->_name + "::render";
 				W_RESULT _hr = W_PASSED;
 
-				auto _size = this->_command_buffers.get_commands_size();
-				for (uint32_t i = 0; i < _size; ++i)
+				if (pFrameIndex >= this->_command_buffers.get_commands_size()) return W_FAILED;
+
+				//only buffers and command buffer of this frame will be written, other frames stay in flight
+				this->_command_buffers.begin(pFrameIndex);
 				{
-					this->_command_buffers.begin(i);
+					auto _cmd = this->_command_buffers.get_command_at(pFrameIndex);
+					this->_render_pass.begin(
+						pFrameIndex,
+						_cmd,
+						w_color::TRANSPARENT_());
 					{
-						auto _cmd = this->_command_buffers.get_command_at(i);
-						this->_render_pass.begin(
-							i,
-							_cmd,
-							w_color::TRANSPARENT_());
+						if (_update_buffers(pFrameIndex) == W_PASSED)
 						{
-							if (_update_buffers() == W_PASSED)
-							{
-								auto _cmd = this->_command_buffers.get_command_at(i);
-								_draw(_cmd.handle);
-							}
-							else
-							{
-								_hr = W_FAILED;
-							}
+							_draw(_cmd.handle, pFrameIndex);
+						}
+						else
+						{
+							_hr = W_FAILED;
 						}
-						this->_render_pass.end(_cmd);
 					}
-					this->_command_buffers.end(i);
+					this->_render_pass.end(_cmd);
 				}
+				this->_command_buffers.end(pFrameIndex);
+
 				return _hr;
 			}
 
@@ -478,8 +478,16 @@ namespace wolf
             {
                 ImGui::Shutdown();
 
-                SAFE_RELEASE(this->_vertex_buffer);
-                SAFE_RELEASE(this->_index_buffer);
+                for (auto& _iter : this->_vertex_buffers)
+                {
+                    SAFE_RELEASE(_iter);
+                }
+                this->_vertex_buffers.clear();
+                for (auto& _iter : this->_index_buffers)
+                {
+                    SAFE_RELEASE(_iter);
+                }
+                this->_index_buffers.clear();
 
                 SAFE_RELEASE(this->_images_texture);
                 SAFE_RELEASE(this->_font_texture);
@@ -537,7 +545,7 @@ namespace wolf
 #pragma endregion
 
         private:
-			W_RESULT _update_buffers()
+			W_RESULT _update_buffers(_In_ const uint32_t& pFrameIndex)
 			{
 				ImDrawData* _im_draw_data = ImGui::GetDrawData();
 				if (!_im_draw_data || !_im_draw_data->CmdListsCount) return W_PASSED;
@@ -548,15 +556,17 @@ namespace wolf
 
 				// Update buffers only if vertex or index count has been changed compared to current buffer size
 				W_RESULT _hr;
+				auto& _vertex_buffer = this->_vertex_buffers[pFrameIndex];
+				auto& _index_buffer = this->_index_buffers[pFrameIndex];
 
 				//Vertex buffer
-				if (!this->_vertex_buffer || this->_vertex_buffer->get_size() != _vertex_buffer_size)
+				if (!_vertex_buffer || _vertex_buffer->get_size() != _vertex_buffer_size)
 				{
-					SAFE_RELEASE(this->_vertex_buffer);
+					SAFE_RELEASE(_vertex_buffer);
 
 					//vertex bufer as property host visible memory
-					this->_vertex_buffer = new wolf::graphics::w_buffer();
-					_hr = this->_vertex_buffer->load(
+					_vertex_buffer = new wolf::graphics::w_buffer();
+					_hr = _vertex_buffer->load(
 						this->_gDevice,
 						_vertex_buffer_size,
 						VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
@@ -566,7 +576,7 @@ namespace wolf
 						V(_hr, "loading staging vertex buffer", this->_name);
 						return _hr;
 					}
-					_hr = this->_vertex_buffer->bind();
+					_hr = _vertex_buffer->bind();
 					if (_hr == W_FAILED)
 					{
 						V(_hr, "binding staging vertex buffer", this->_name);
@@ -575,12 +585,12 @@ namespace wolf
 				}
 
 				// Index buffer
-				if (!this->_index_buffer || this->_index_buffer->get_size() != _index_buffer_size)
+				if (!_index_buffer || _index_buffer->get_size() != _index_buffer_size)
 				{
-					SAFE_RELEASE(this->_index_buffer);
+					SAFE_RELEASE(_index_buffer);
 
-					this->_index_buffer = new wolf::graphics::w_buffer();
-					_hr = this->_index_buffer->load(
+					_index_buffer = new wolf::graphics::w_buffer();
+					_hr = _index_buffer->load(
 						this->_gDevice,
 						_index_buffer_size,
 						VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
@@ -590,7 +600,7 @@ namespace wolf
 						V(_hr, "loading staging index buffer", this->_name);
 						return _hr;
 					}
-					_hr = this->_index_buffer->bind();
+					_hr = _index_buffer->bind();
 					if (_hr == W_FAILED)
 					{
 						V(_hr, "binding staging index buffer", this->_name);
@@ -598,8 +608,8 @@ namespace wolf
 					}
 				}
 
-				ImDrawVert* vtxDst = (ImDrawVert*)this->_vertex_buffer->map();
-				ImDrawIdx* idxDst = (ImDrawIdx*)this->_index_buffer->map();
+				ImDrawVert* vtxDst = (ImDrawVert*)_vertex_buffer->map();
+				ImDrawIdx* idxDst = (ImDrawIdx*)_index_buffer->map();
 
 				for (int n = 0; n < _im_draw_data->CmdListsCount; n++)
 				{
@@ -610,21 +620,21 @@ namespace wolf
 					idxDst += cmd_list->IdxBuffer.Size;
 				}
 
-				_hr = this->_vertex_buffer->flush();
+				_hr = _vertex_buffer->flush();
 				if (_hr == W_FAILED)
 				{
 					V(_hr, "flushing staging index buffer", this->_name);
 					return _hr;
 				}
-				_hr = this->_index_buffer->flush();
+				_hr = _index_buffer->flush();
 				if (_hr == W_FAILED)
 				{
 					V(_hr, "flushing staging index buffer", this->_name);
 					return _hr;
 				}
 
-				this->_vertex_buffer->unmap();
-				this->_index_buffer->unmap();
+				_vertex_buffer->unmap();
+				_index_buffer->unmap();
 
 				vtxDst = nullptr;
 				idxDst = nullptr;
@@ -632,7 +642,7 @@ namespace wolf
 				return W_PASSED;
 			}
 
-			void _draw(_In_ VkCommandBuffer pCommandBuffer)
+			void _draw(_In_ VkCommandBuffer pCommandBuffer, _In_ const uint32_t& pFrameIndex)
 			{
 				ImGuiIO& _io = ImGui::GetIO();
 
@@ -652,8 +662,8 @@ namespace wolf
 				vkCmdBindPipeline(pCommandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, this->_pipeline);
 
 				// Bind vertex and index buffer
-				auto _vertex_buffer_handle = this->_vertex_buffer->get_buffer_handle().handle;
-				auto _index_buffer_handle = this->_index_buffer->get_buffer_handle().handle;
+				auto _vertex_buffer_handle = this->_vertex_buffers[pFrameIndex]->get_buffer_handle().handle;
+				auto _index_buffer_handle = this->_index_buffers[pFrameIndex]->get_buffer_handle().handle;
 
 				VkDeviceSize offsets[1] = { 0 };
 				vkCmdBindVertexBuffers(pCommandBuffer, 0, 1, &_vertex_buffer_handle, offsets);
@@ -754,8 +764,9 @@ namespace wolf
             HWND _hwnd;
 #endif
 
-            w_buffer*                                               _vertex_buffer;
-            w_buffer*                                               _index_buffer;
+            //vertex and index buffers of each frame in flight
+            std::vector<w_buffer*>                                  _vertex_buffers;
+            std::vector<w_buffer*>                                  _index_buffers;
             VkPipelineCache                                         _pipeline_cache;
             VkPipelineLayout                                        _pipeline_layout;
             VkPipeline                                              _pipeline;
@@ -815,10 +826,10 @@ void w_imgui::new_frame(_In_ const float& pDeltaTime, _In_ const std::function<v
     _pimp->new_frame(pDeltaTime, pMakeGuiWork);
 }
 
-void w_imgui::render()
+void w_imgui::render(_In_ const uint32_t& pFrameIndex)
 {
     if (!_pimp) return;
-    _pimp->render();
+    _pimp->render(pFrameIndex);
 }
 
 ULONG w_imgui::release()
@@ -57,7 +57,8 @@ namespace wolf
                 _In_ const float& pFontPixelSize = 15.0f);
 
             static W_EXP void new_frame(_In_ const float& pDeltaTime, _In_ const std::function<void(void)>& pGuiWorkFlow);
-            static W_EXP void render();
+            //update buffers and record command buffer of a frame, previous submission of this frame must be completed by GPU
+            static W_EXP void render(_In_ const uint32_t& pFrameIndex);
             static W_EXP ULONG release();
 
 #pragma region Getters
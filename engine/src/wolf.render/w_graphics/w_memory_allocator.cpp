@@ -0,0 +1,795 @@
+#include "w_render_pch.h"
+#include "w_graphics_device_manager.h"
+#include "w_memory_allocator.h"
+#include <map>
+#include <set>
+#include <mutex>
+#include <algorithm>
+
+//size of the smallest buddy is 2^8 = 256 bytes, which is bigger than nonCoherentAtomSize of most devices
+#define MIN_BUDDY_ORDER		8
+#define MIN_BLOCK_SIZE		(1024 * 1024)
+
+namespace wolf
+{
+	namespace graphics
+	{
+		struct w_memory_buddy
+		{
+			uint32_t		order;
+			VkDeviceSize	size;
+			void*			user_data;
+		};
+
+		struct w_memory_block
+		{
+			VkDeviceMemory											memory = 0;
+			VkDeviceSize											size = 0;
+			void*													mapped = nullptr;
+			uint32_t												memory_type_index = 0;
+			w_memory_allocation_type								type = w_memory_allocation_type::BUDDY_ALLOCATION;
+			//bytes which have been requested
+			VkDeviceSize											used_bytes = 0;
+			//bytes which have been consumed, including rounding and alignment
+			VkDeviceSize											consumed_bytes = 0;
+			//buddy allocator, free lists for each order and allocated buddies by offset
+			uint32_t												max_order = 0;
+			std::vector<std::set<VkDeviceSize>>						free_lists;
+			std::map<VkDeviceSize, w_memory_buddy>					buddies;
+			//current offset of linear allocator
+			VkDeviceSize											linear_offset = 0;
+		};
+
+		class w_memory_allocator_pimp
+		{
+		public:
+			w_memory_allocator_pimp() :
+				_name("w_memory_allocator"),
+				_gDevice(nullptr),
+				_non_coherent_atom_size(1),
+				_device_local_block_size(0),
+				_host_visible_block_size(0),
+				_linear_block_size(0),
+				_total_number_of_allocations(0)
+			{
+			}
+
+			~w_memory_allocator_pimp()
+			{
+				release();
+			}
+
+			W_RESULT initialize(
+				_In_ w_graphics_device* pGDevice,
+				_In_ const VkDeviceSize& pDeviceLocalBlockSize,
+				_In_ const VkDeviceSize& pHostVisibleBlockSize,
+				_In_ const VkDeviceSize& pLinearBlockSize)
+			{
+				if (!pGDevice || !pGDevice->vk_device) return W_FAILED;
+
+				this->_gDevice = pGDevice;
+				this->_memory_properties = pGDevice->vk_physical_device_memory_properties;
+				if (pGDevice->device_info && pGDevice->device_info->device_properties)
+				{
+					this->_non_coherent_atom_size = pGDevice->device_info->device_properties->limits.nonCoherentAtomSize;
+					if (this->_non_coherent_atom_size == 0) this->_non_coherent_atom_size = 1;
+				}
+
+				//blocks of buddy allocator must be power of two
+				this->_device_local_block_size = _floor_power_of_two(std::max<VkDeviceSize>(pDeviceLocalBlockSize, MIN_BLOCK_SIZE));
+				this->_host_visible_block_size = _floor_power_of_two(std::max<VkDeviceSize>(pHostVisibleBlockSize, MIN_BLOCK_SIZE));
+				this->_linear_block_size = std::max<VkDeviceSize>(pLinearBlockSize, MIN_BLOCK_SIZE);
+
+				//two pools for each memory type, one for buffers and one for images
+				this->_pools.resize(this->_memory_properties.memoryTypeCount * 2);
+
+				return W_PASSED;
+			}
+
+			W_RESULT allocate(
+				_In_ const VkMemoryRequirements& pMemoryRequirements,
+				_In_ const uint32_t& pMemoryPropertyFlags,
+				_In_ const bool& pIsImage,
+				_Out_ w_memory_allocation& pAllocation,
+				_In_opt_ void* pUserData)
+			{
+				const std::string _trace_info = this->_name + "::allocate";
+
+				pAllocation = w_memory_allocation();
+				if (!this->_gDevice) return W_FAILED;
+
+				uint32_t _memory_type_index = 0;
+				if (w_graphics_device_manager::memory_type_from_properties(
+					this->_memory_properties,
+					pMemoryRequirements.memoryTypeBits,
+					pMemoryPropertyFlags,
+					&_memory_type_index))
+				{
+					V(W_FAILED, "finding memory type for graphics device: " + this->_gDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				std::lock_guard<std::recursive_mutex> _lock(this->_mutex);
+
+				auto _block_size = _get_block_size(_memory_type_index);
+				auto _size = std::max<VkDeviceSize>(pMemoryRequirements.size, pMemoryRequirements.alignment);
+				if (_size > _block_size / 2)
+				{
+					//too big for sub allocation
+					auto _block = _create_block(pMemoryRequirements.size, _memory_type_index, w_memory_allocation_type::DEDICATED_ALLOCATION);
+					if (!_block)
+					{
+						V(W_FAILED, "allocating dedicated memory for graphics device: " + this->_gDevice->get_info(), _trace_info, 3, false);
+						return W_FAILED;
+					}
+					_block->used_bytes = pMemoryRequirements.size;
+					_block->consumed_bytes = pMemoryRequirements.size;
+					this->_dedicated.insert(_block);
+
+					_fill_allocation(_block, 0, pMemoryRequirements.size, pUserData, pAllocation);
+					this->_total_number_of_allocations++;
+					return W_PASSED;
+				}
+
+				auto _pool_index = _memory_type_index * 2 + (pIsImage ? 1 : 0);
+				if (_allocate_from_pool(_pool_index, pMemoryRequirements.size, _size, pUserData, nullptr, pAllocation)) return W_PASSED;
+
+				//all blocks are full, create a new one
+				auto _block = _create_block(_block_size, _memory_type_index, w_memory_allocation_type::BUDDY_ALLOCATION);
+				if (!_block)
+				{
+					V(W_FAILED, "allocating memory block for graphics device: " + this->_gDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+				this->_pools[_pool_index].push_back(_block);
+
+				return _allocate_from_pool(_pool_index, pMemoryRequirements.size, _size, pUserData, nullptr, pAllocation) ? W_PASSED : W_FAILED;
+			}
+
+			W_RESULT allocate_linear(
+				_In_ const VkMemoryRequirements& pMemoryRequirements,
+				_In_ const uint32_t& pMemoryPropertyFlags,
+				_In_ const uint32_t& pFrameIndex,
+				_Out_ w_memory_allocation& pAllocation)
+			{
+				const std::string _trace_info = this->_name + "::allocate_linear";
+
+				pAllocation = w_memory_allocation();
+				if (!this->_gDevice) return W_FAILED;
+
+				uint32_t _memory_type_index = 0;
+				if (w_graphics_device_manager::memory_type_from_properties(
+					this->_memory_properties,
+					pMemoryRequirements.memoryTypeBits,
+					pMemoryPropertyFlags,
+					&_memory_type_index))
+				{
+					V(W_FAILED, "finding memory type for graphics device: " + this->_gDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				std::lock_guard<std::recursive_mutex> _lock(this->_mutex);
+
+				if (this->_linear_pools.size() <= pFrameIndex)
+				{
+					this->_linear_pools.resize(pFrameIndex + 1);
+				}
+				auto _chunks = &this->_linear_pools[pFrameIndex][_memory_type_index];
+
+				auto _alignment = std::max<VkDeviceSize>(pMemoryRequirements.alignment, 1);
+				if (!(this->_memory_properties.memoryTypes[_memory_type_index].propertyFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+				{
+					//flush ranges of non coherent memories must be aligned to nonCoherentAtomSize
+					_alignment = std::max(_alignment, this->_non_coherent_atom_size);
+				}
+
+				w_memory_block* _block = nullptr;
+				VkDeviceSize _offset = 0;
+				for (auto _chunk : *_chunks)
+				{
+					_offset = _align(_chunk->linear_offset, _alignment);
+					if (_offset + pMemoryRequirements.size <= _chunk->size)
+					{
+						_block = _chunk;
+						break;
+					}
+				}
+
+				if (!_block)
+				{
+					_block = _create_block(
+						std::max(this->_linear_block_size, pMemoryRequirements.size),
+						_memory_type_index,
+						w_memory_allocation_type::LINEAR_ALLOCATION);
+					if (!_block)
+					{
+						V(W_FAILED, "allocating linear memory block for graphics device: " + this->_gDevice->get_info(), _trace_info, 3, false);
+						return W_FAILED;
+					}
+					_chunks->push_back(_block);
+					_offset = 0;
+				}
+
+				_block->linear_offset = _offset + pMemoryRequirements.size;
+				_block->used_bytes += pMemoryRequirements.size;
+				_block->consumed_bytes = _block->linear_offset;
+
+				_fill_allocation(_block, _offset, pMemoryRequirements.size, nullptr, pAllocation);
+				this->_total_number_of_allocations++;
+
+				return W_PASSED;
+			}
+
+			void free(_Inout_ w_memory_allocation& pAllocation)
+			{
+				if (!pAllocation.block) return;
+
+				std::lock_guard<std::recursive_mutex> _lock(this->_mutex);
+
+				switch (pAllocation.type)
+				{
+				case w_memory_allocation_type::BUDDY_ALLOCATION:
+					_buddy_free(pAllocation.block, pAllocation.offset);
+					break;
+				case w_memory_allocation_type::DEDICATED_ALLOCATION:
+					this->_dedicated.erase(pAllocation.block);
+					_destroy_block(pAllocation.block);
+					break;
+				case w_memory_allocation_type::LINEAR_ALLOCATION:
+					//will be released by reset_linear_pool
+					break;
+				}
+
+				pAllocation = w_memory_allocation();
+			}
+
+			void reset_linear_pool(_In_ const uint32_t& pFrameIndex)
+			{
+				std::lock_guard<std::recursive_mutex> _lock(this->_mutex);
+
+				if (pFrameIndex >= this->_linear_pools.size()) return;
+				for (auto& _iter : this->_linear_pools[pFrameIndex])
+				{
+					for (auto _chunk : _iter.second)
+					{
+						_chunk->linear_offset = 0;
+						_chunk->used_bytes = 0;
+						_chunk->consumed_bytes = 0;
+					}
+				}
+			}
+
+			W_RESULT flush(
+				_In_ const w_memory_allocation& pAllocation,
+				_In_ const VkDeviceSize& pOffset,
+				_In_ const VkDeviceSize& pSize)
+			{
+				if (!pAllocation.block || !this->_gDevice) return W_FAILED;
+
+				auto _flags = this->_memory_properties.memoryTypes[pAllocation.memory_type_index].propertyFlags;
+				if (!(_flags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)) return W_FAILED;
+				if (_flags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) return W_PASSED;
+
+				auto _start = pAllocation.offset + pOffset;
+				auto _end = pSize == VK_WHOLE_SIZE ? pAllocation.offset + pAllocation.size : _start + pSize;
+
+				//range must be aligned to nonCoherentAtomSize or reach the end of memory
+				_start = (_start / this->_non_coherent_atom_size) * this->_non_coherent_atom_size;
+				_end = std::min(_align(_end, this->_non_coherent_atom_size), pAllocation.block->size);
+
+				VkMappedMemoryRange _mapped_range = {};
+				_mapped_range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+				_mapped_range.memory = pAllocation.memory.handle;
+				_mapped_range.offset = _start;
+				_mapped_range.size = _end - _start;
+
+				return vkFlushMappedMemoryRanges(this->_gDevice->vk_device, 1, &_mapped_range) == VK_SUCCESS ? W_PASSED : W_FAILED;
+			}
+
+			size_t defragment(
+				_In_ const std::function<bool(const w_memory_allocation&, const w_memory_allocation&)>& pOnMove,
+				_In_ const size_t& pMaxMoves)
+			{
+				if (!pOnMove) return 0;
+
+				std::lock_guard<std::recursive_mutex> _lock(this->_mutex);
+
+				size_t _moves = 0;
+				for (size_t _pool_index = 0; _pool_index < this->_pools.size() && _moves < pMaxMoves; ++_pool_index)
+				{
+					auto _pool = &this->_pools[_pool_index];
+
+					//find the most empty block which still has allocations
+					w_memory_block* _source = nullptr;
+					size_t _number_of_used_blocks = 0;
+					for (auto _block : *_pool)
+					{
+						if (_block->buddies.empty()) continue;
+						_number_of_used_blocks++;
+						if (!_source || _block->used_bytes < _source->used_bytes)
+						{
+							_source = _block;
+						}
+					}
+					if (!_source || _number_of_used_blocks < 2) continue;
+
+					//copy them, pOnMove may free other allocations
+					auto _buddies = _source->buddies;
+					for (auto& _iter : _buddies)
+					{
+						if (_moves >= pMaxMoves) break;
+						if (_source->buddies.find(_iter.first) == _source->buddies.end()) continue;
+
+						w_memory_allocation _old_allocation;
+						_fill_allocation(_source, _iter.first, _iter.second.size, _iter.second.user_data, _old_allocation);
+
+						w_memory_allocation _new_allocation;
+						if (!_allocate_from_pool(
+							_pool_index,
+							_iter.second.size,
+							static_cast<VkDeviceSize>(1) << _iter.second.order,
+							_iter.second.user_data,
+							_source,
+							_new_allocation))
+						{
+							//other blocks are full
+							break;
+						}
+						//this is not a new allocation
+						this->_total_number_of_allocations--;
+
+						if (pOnMove(_old_allocation, _new_allocation))
+						{
+							_buddy_free(_source, _iter.first);
+							_moves++;
+						}
+						else
+						{
+							_buddy_free(_new_allocation.block, _new_allocation.offset);
+						}
+					}
+				}
+
+				release_empty_blocks();
+
+				return _moves;
+			}
+
+			void release_empty_blocks()
+			{
+				std::lock_guard<std::recursive_mutex> _lock(this->_mutex);
+
+				for (auto& _pool : this->_pools)
+				{
+					auto _end = std::remove_if(_pool.begin(), _pool.end(), [this](_In_ w_memory_block* pBlock)
+					{
+						if (!pBlock->buddies.empty()) return false;
+						_destroy_block(pBlock);
+						return true;
+					});
+					_pool.erase(_end, _pool.end());
+				}
+			}
+
+			ULONG release()
+			{
+				std::lock_guard<std::recursive_mutex> _lock(this->_mutex);
+
+				for (auto& _pool : this->_pools)
+				{
+					for (auto _block : _pool)
+					{
+						_destroy_block(_block);
+					}
+				}
+				this->_pools.clear();
+
+				for (auto _block : this->_dedicated)
+				{
+					_destroy_block(_block);
+				}
+				this->_dedicated.clear();
+
+				for (auto& _frame : this->_linear_pools)
+				{
+					for (auto& _iter : _frame)
+					{
+						for (auto _chunk : _iter.second)
+						{
+							_destroy_block(_chunk);
+						}
+					}
+				}
+				this->_linear_pools.clear();
+
+				this->_gDevice = nullptr;
+
+				return 0;
+			}
+
+#pragma region Getters
+
+			w_memory_allocator_statistics get_statistics()
+			{
+				std::lock_guard<std::recursive_mutex> _lock(this->_mutex);
+
+				w_memory_allocator_statistics _statistics;
+				_statistics.total_number_of_allocations = this->_total_number_of_allocations;
+
+				for (auto& _pool : this->_pools)
+				{
+					for (auto _block : _pool)
+					{
+						_statistics.number_of_blocks++;
+						_statistics.number_of_allocations += _block->buddies.size();
+						_statistics.reserved_bytes += _block->size;
+						_statistics.used_bytes += _block->used_bytes;
+						_statistics.wasted_bytes += _block->consumed_bytes - _block->used_bytes;
+						_statistics.free_bytes += _block->size - _block->consumed_bytes;
+					}
+				}
+
+				for (auto _block : this->_dedicated)
+				{
+					_statistics.number_of_dedicated_allocations++;
+					_statistics.number_of_allocations++;
+					_statistics.reserved_bytes += _block->size;
+					_statistics.used_bytes += _block->used_bytes;
+				}
+
+				size_t _number_of_chunks = 0;
+				for (auto& _frame : this->_linear_pools)
+				{
+					for (auto& _iter : _frame)
+					{
+						for (auto _chunk : _iter.second)
+						{
+							_number_of_chunks++;
+							_statistics.linear_reserved_bytes += _chunk->size;
+							_statistics.linear_used_bytes += _chunk->used_bytes;
+						}
+					}
+				}
+
+				_statistics.number_of_device_memory_allocations =
+					_statistics.number_of_blocks +
+					_statistics.number_of_dedicated_allocations +
+					_number_of_chunks;
+
+				return _statistics;
+			}
+
+#pragma endregion
+
+		private:
+			static VkDeviceSize _align(_In_ const VkDeviceSize& pValue, _In_ const VkDeviceSize& pAlignment)
+			{
+				return (pValue + pAlignment - 1) / pAlignment * pAlignment;
+			}
+
+			static VkDeviceSize _floor_power_of_two(_In_ const VkDeviceSize& pValue)
+			{
+				VkDeviceSize _result = 1;
+				while (_result <= pValue / 2) _result <<= 1;
+				return _result;
+			}
+
+			static uint32_t _get_order(_In_ const VkDeviceSize& pSize)
+			{
+				uint32_t _order = MIN_BUDDY_ORDER;
+				while ((static_cast<VkDeviceSize>(1) << _order) < pSize) _order++;
+				return _order;
+			}
+
+			VkDeviceSize _get_block_size(_In_ const uint32_t& pMemoryTypeIndex)
+			{
+				auto _memory_type = this->_memory_properties.memoryTypes[pMemoryTypeIndex];
+				auto _heap_size = this->_memory_properties.memoryHeaps[_memory_type.heapIndex].size;
+
+				auto _size = (_memory_type.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) ?
+					this->_host_visible_block_size : this->_device_local_block_size;
+
+				//do not let one block consume a big part of small heaps
+				while (_size > MIN_BLOCK_SIZE && _size > _heap_size / 8)
+				{
+					_size >>= 1;
+				}
+				return _size;
+			}
+
+			w_memory_block* _create_block(
+				_In_ const VkDeviceSize& pSize,
+				_In_ const uint32_t& pMemoryTypeIndex,
+				_In_ const w_memory_allocation_type& pType)
+			{
+				const VkMemoryAllocateInfo _memory_allocate_info =
+				{
+					VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,     // Type
+					nullptr,                                    // Next
+					pSize,                                      // AllocationSize
+					pMemoryTypeIndex                            // MemoryTypeIndex
+				};
+
+				VkDeviceMemory _memory = 0;
+				if (vkAllocateMemory(this->_gDevice->vk_device, &_memory_allocate_info, nullptr, &_memory))
+				{
+					return nullptr;
+				}
+
+				void* _mapped = nullptr;
+				if (this->_memory_properties.memoryTypes[pMemoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+				{
+					//map it persistently, a memory object can not be mapped twice
+					if (vkMapMemory(this->_gDevice->vk_device, _memory, 0, VK_WHOLE_SIZE, 0, &_mapped))
+					{
+						vkFreeMemory(this->_gDevice->vk_device, _memory, nullptr);
+						return nullptr;
+					}
+				}
+
+				auto _block = new (std::nothrow) w_memory_block();
+				if (!_block)
+				{
+					if (_mapped) vkUnmapMemory(this->_gDevice->vk_device, _memory);
+					vkFreeMemory(this->_gDevice->vk_device, _memory, nullptr);
+					return nullptr;
+				}
+
+				_block->memory = _memory;
+				_block->size = pSize;
+				_block->mapped = _mapped;
+				_block->memory_type_index = pMemoryTypeIndex;
+				_block->type = pType;
+
+				if (pType == w_memory_allocation_type::BUDDY_ALLOCATION)
+				{
+					//whole block is one free buddy
+					_block->max_order = _get_order(pSize);
+					_block->free_lists.resize(_block->max_order - MIN_BUDDY_ORDER + 1);
+					_block->free_lists.back().insert(0);
+				}
+
+				return _block;
+			}
+
+			void _destroy_block(_In_ w_memory_block* pBlock)
+			{
+				if (!pBlock) return;
+
+				if (this->_gDevice && pBlock->memory)
+				{
+					if (pBlock->mapped)
+					{
+						vkUnmapMemory(this->_gDevice->vk_device, pBlock->memory);
+					}
+					vkFreeMemory(this->_gDevice->vk_device, pBlock->memory, nullptr);
+				}
+				delete pBlock;
+			}
+
+			bool _allocate_from_pool(
+				_In_ const size_t& pPoolIndex,
+				_In_ const VkDeviceSize& pSize,
+				_In_ const VkDeviceSize& pAlignedSize,
+				_In_opt_ void* pUserData,
+				_In_opt_ const w_memory_block* pExclude,
+				_Out_ w_memory_allocation& pAllocation)
+			{
+				auto _order = _get_order(pAlignedSize);
+				for (auto _block : this->_pools[pPoolIndex])
+				{
+					if (_block == pExclude) continue;
+
+					VkDeviceSize _offset = 0;
+					if (_buddy_allocate(_block, _order, pSize, pUserData, _offset))
+					{
+						_fill_allocation(_block, _offset, pSize, pUserData, pAllocation);
+						this->_total_number_of_allocations++;
+						return true;
+					}
+				}
+				return false;
+			}
+
+			bool _buddy_allocate(
+				_In_ w_memory_block* pBlock,
+				_In_ const uint32_t& pOrder,
+				_In_ const VkDeviceSize& pSize,
+				_In_opt_ void* pUserData,
+				_Out_ VkDeviceSize& pOffset)
+			{
+				if (pOrder > pBlock->max_order) return false;
+
+				//find the smallest free buddy which fits
+				auto _order = pOrder;
+				while (_order <= pBlock->max_order && pBlock->free_lists[_order - MIN_BUDDY_ORDER].empty())
+				{
+					_order++;
+				}
+				if (_order > pBlock->max_order) return false;
+
+				auto _free_list = &pBlock->free_lists[_order - MIN_BUDDY_ORDER];
+				pOffset = *_free_list->begin();
+				_free_list->erase(_free_list->begin());
+
+				//split it until it reaches the requested order, second halves become free
+				while (_order > pOrder)
+				{
+					_order--;
+					pBlock->free_lists[_order - MIN_BUDDY_ORDER].insert(pOffset + (static_cast<VkDeviceSize>(1) << _order));
+				}
+
+				w_memory_buddy _buddy;
+				_buddy.order = pOrder;
+				_buddy.size = pSize;
+				_buddy.user_data = pUserData;
+				pBlock->buddies[pOffset] = _buddy;
+
+				pBlock->used_bytes += pSize;
+				pBlock->consumed_bytes += static_cast<VkDeviceSize>(1) << pOrder;
+
+				return true;
+			}
+
+			void _buddy_free(_In_ w_memory_block* pBlock, _In_ VkDeviceSize pOffset)
+			{
+				auto _iter = pBlock->buddies.find(pOffset);
+				if (_iter == pBlock->buddies.end()) return;
+
+				auto _order = _iter->second.order;
+				pBlock->used_bytes -= _iter->second.size;
+				pBlock->consumed_bytes -= static_cast<VkDeviceSize>(1) << _order;
+				pBlock->buddies.erase(_iter);
+
+				//merge with free buddies
+				while (_order < pBlock->max_order)
+				{
+					auto _buddy_offset = pOffset ^ (static_cast<VkDeviceSize>(1) << _order);
+					auto _free_list = &pBlock->free_lists[_order - MIN_BUDDY_ORDER];
+					auto _buddy = _free_list->find(_buddy_offset);
+					if (_buddy == _free_list->end()) break;
+
+					_free_list->erase(_buddy);
+					pOffset = std::min(pOffset, _buddy_offset);
+					_order++;
+				}
+				pBlock->free_lists[_order - MIN_BUDDY_ORDER].insert(pOffset);
+			}
+
+			void _fill_allocation(
+				_In_ w_memory_block* pBlock,
+				_In_ const VkDeviceSize& pOffset,
+				_In_ const VkDeviceSize& pSize,
+				_In_opt_ void* pUserData,
+				_Out_ w_memory_allocation& pAllocation)
+			{
+				pAllocation.memory.handle = pBlock->memory;
+				pAllocation.offset = pOffset;
+				pAllocation.size = pSize;
+				pAllocation.mapped = pBlock->mapped ? static_cast<uint8_t*>(pBlock->mapped) + pOffset : nullptr;
+				pAllocation.memory_type_index = pBlock->memory_type_index;
+				pAllocation.type = pBlock->type;
+				pAllocation.user_data = pUserData;
+				pAllocation.block = pBlock;
+			}
+
+			std::string															_name;
+			w_graphics_device*													_gDevice;
+			VkPhysicalDeviceMemoryProperties									_memory_properties;
+			VkDeviceSize														_non_coherent_atom_size;
+			VkDeviceSize														_device_local_block_size;
+			VkDeviceSize														_host_visible_block_size;
+			VkDeviceSize														_linear_block_size;
+			//blocks of buddy allocators, index is memory type index * 2 + 1 for images
+			std::vector<std::vector<w_memory_block*>>							_pools;
+			std::set<w_memory_block*>											_dedicated;
+			//blocks of linear pools for each frame and memory type
+			std::vector<std::map<uint32_t, std::vector<w_memory_block*>>>		_linear_pools;
+			size_t																_total_number_of_allocations;
+			//recursive, because defragment calls the owner of allocation which may allocate or free
+			std::recursive_mutex												_mutex;
+		};
+	}
+}
+
+using namespace wolf::graphics;
+
+w_memory_allocator::w_memory_allocator() : _pimp(new w_memory_allocator_pimp())
+{
+}
+
+w_memory_allocator::~w_memory_allocator()
+{
+	release();
+}
+
+W_RESULT w_memory_allocator::initialize(
+	_In_ w_graphics_device* pGDevice,
+	_In_ const VkDeviceSize& pDeviceLocalBlockSize,
+	_In_ const VkDeviceSize& pHostVisibleBlockSize,
+	_In_ const VkDeviceSize& pLinearBlockSize)
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->initialize(pGDevice, pDeviceLocalBlockSize, pHostVisibleBlockSize, pLinearBlockSize);
+}
+
+W_RESULT w_memory_allocator::allocate(
+	_In_ const VkMemoryRequirements& pMemoryRequirements,
+	_In_ const uint32_t& pMemoryPropertyFlags,
+	_In_ const bool& pIsImage,
+	_Out_ w_memory_allocation& pAllocation,
+	_In_opt_ void* pUserData)
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->allocate(pMemoryRequirements, pMemoryPropertyFlags, pIsImage, pAllocation, pUserData);
+}
+
+W_RESULT w_memory_allocator::allocate_linear(
+	_In_ const VkMemoryRequirements& pMemoryRequirements,
+	_In_ const uint32_t& pMemoryPropertyFlags,
+	_In_ const uint32_t& pFrameIndex,
+	_Out_ w_memory_allocation& pAllocation)
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->allocate_linear(pMemoryRequirements, pMemoryPropertyFlags, pFrameIndex, pAllocation);
+}
+
+void w_memory_allocator::free(_Inout_ w_memory_allocation& pAllocation)
+{
+	if (!this->_pimp) return;
+
+	this->_pimp->free(pAllocation);
+}
+
+void w_memory_allocator::reset_linear_pool(_In_ const uint32_t& pFrameIndex)
+{
+	if (!this->_pimp) return;
+
+	this->_pimp->reset_linear_pool(pFrameIndex);
+}
+
+W_RESULT w_memory_allocator::flush(
+	_In_ const w_memory_allocation& pAllocation,
+	_In_ const VkDeviceSize& pOffset,
+	_In_ const VkDeviceSize& pSize)
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->flush(pAllocation, pOffset, pSize);
+}
+
+size_t w_memory_allocator::defragment(
+	_In_ const std::function<bool(const w_memory_allocation&, const w_memory_allocation&)>& pOnMove,
+	_In_ const size_t& pMaxMoves)
+{
+	if (!this->_pimp) return 0;
+
+	return this->_pimp->defragment(pOnMove, pMaxMoves);
+}
+
+void w_memory_allocator::release_empty_blocks()
+{
+	if (!this->_pimp) return;
+
+	this->_pimp->release_empty_blocks();
+}
+
+ULONG w_memory_allocator::release()
+{
+	SAFE_DELETE(this->_pimp);
+	return 0;
+}
+
+#pragma region Getters
+
+w_memory_allocator_statistics w_memory_allocator::get_statistics() const
+{
+	if (!this->_pimp) return w_memory_allocator_statistics();
+
+	return this->_pimp->get_statistics();
+}
+
+#pragma endregion
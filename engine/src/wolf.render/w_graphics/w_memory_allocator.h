@@ -0,0 +1,182 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_memory_allocator.h
+	Description		 : Device memory allocator of graphics device
+	Comment          : Allocates large blocks of device memory for each memory type and sub allocates them with a buddy allocator,
+					   buffers and images never share a block, so bufferImageGranularity does not need to be respected.
+					   Allocations bigger than half of a block get their own device memory.
+					   Per frame data can be allocated from linear pools which will be reset once GPU finished that frame
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_MEMORY_ALLOCATOR_H__
+#define __W_MEMORY_ALLOCATOR_H__
+
+#include <w_graphics_headers.h>
+#include <w_render_export.h>
+#include <functional>
+
+namespace wolf
+{
+	namespace graphics
+	{
+		struct w_memory_block;
+
+		enum w_memory_allocation_type : uint8_t
+		{
+			//sub allocated from a block with buddy allocator
+			BUDDY_ALLOCATION = 0,
+			//has its own device memory
+			DEDICATED_ALLOCATION,
+			//allocated from linear pool of a frame
+			LINEAR_ALLOCATION
+		};
+
+		struct w_memory_allocation
+		{
+			//device memory which contains this allocation, it might be shared with other allocations
+			w_device_memory                     memory;
+			//offset of this allocation inside the device memory
+			VkDeviceSize                        offset = 0;
+			//requested size
+			VkDeviceSize                        size = 0;
+			//pointer to the first byte of this allocation, will be nullptr for memories which are not host visible
+			void*                               mapped = nullptr;
+			uint32_t                            memory_type_index = 0;
+			w_memory_allocation_type            type = w_memory_allocation_type::BUDDY_ALLOCATION;
+			//user data which will be passed back on defragmentation
+			void*                               user_data = nullptr;
+			//owner block, used by allocator
+			w_memory_block*                     block = nullptr;
+		};
+
+		struct w_memory_allocator_statistics
+		{
+			//number of vkAllocateMemory calls which are alive
+			size_t		number_of_device_memory_allocations = 0;
+			//number of blocks which have been used for sub allocations
+			size_t		number_of_blocks = 0;
+			//number of allocations which have their own device memory
+			size_t		number_of_dedicated_allocations = 0;
+			//number of alive allocations
+			size_t		number_of_allocations = 0;
+			//total number of allocations since initializing allocator
+			size_t		total_number_of_allocations = 0;
+			//bytes of device memory which have been allocated
+			VkDeviceSize	reserved_bytes = 0;
+			//bytes which have been requested by alive allocations
+			VkDeviceSize	used_bytes = 0;
+			//bytes which have been lost because of rounding and alignment
+			VkDeviceSize	wasted_bytes = 0;
+			//bytes of blocks which are free
+			VkDeviceSize	free_bytes = 0;
+			//bytes of linear pools
+			VkDeviceSize	linear_reserved_bytes = 0;
+			//bytes which have been used in linear pools
+			VkDeviceSize	linear_used_bytes = 0;
+		};
+
+		class w_memory_allocator_pimp;
+		class w_memory_allocator
+		{
+		public:
+			W_EXP w_memory_allocator();
+			W_EXP ~w_memory_allocator();
+
+			/*
+				initialize allocator for graphics device, this function will be called by graphics device manager
+				@param pGDevice, graphics device
+				@param pDeviceLocalBlockSize, size of each block of device local memory
+				@param pHostVisibleBlockSize, size of each block of host visible memory
+				@param pLinearBlockSize, size of each block of linear pools
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT initialize(
+				_In_ w_graphics_device* pGDevice,
+				_In_ const VkDeviceSize& pDeviceLocalBlockSize,
+				_In_ const VkDeviceSize& pHostVisibleBlockSize,
+				_In_ const VkDeviceSize& pLinearBlockSize);
+
+			/*
+				allocate memory, host visible memories will be mapped persistently
+				@param pMemoryRequirements, memory requirements of buffer or image
+				@param pMemoryPropertyFlags, memory property flags
+				@param pIsImage, true for optimal tiling images, buffers and images will be allocated from different blocks
+				@param pAllocation, the result allocation
+				@param pUserData, user data which will be passed back on defragmentation
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT allocate(
+				_In_ const VkMemoryRequirements& pMemoryRequirements,
+				_In_ const uint32_t& pMemoryPropertyFlags,
+				_In_ const bool& pIsImage,
+				_Out_ w_memory_allocation& pAllocation,
+				_In_opt_ void* pUserData = nullptr);
+
+			/*
+				allocate memory for a buffer from linear pool of the frame, all allocations of this frame will be released
+				by calling reset_linear_pool. Graphics device resets the pool once GPU finished executing the frame
+				@param pMemoryRequirements, memory requirements of buffer
+				@param pMemoryPropertyFlags, memory property flags
+				@param pFrameIndex, index of frame in flight
+				@param pAllocation, the result allocation
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT allocate_linear(
+				_In_ const VkMemoryRequirements& pMemoryRequirements,
+				_In_ const uint32_t& pMemoryPropertyFlags,
+				_In_ const uint32_t& pFrameIndex,
+				_Out_ w_memory_allocation& pAllocation);
+
+			//free allocation, allocations of linear pools will be ignored
+			W_EXP void free(_Inout_ w_memory_allocation& pAllocation);
+
+			//release all allocations of linear pools of the frame
+			W_EXP void reset_linear_pool(_In_ const uint32_t& pFrameIndex);
+
+			//flush mapped memory of allocation, will be ignored for host coherent memories
+			W_EXP W_RESULT flush(
+				_In_ const w_memory_allocation& pAllocation,
+				_In_ const VkDeviceSize& pOffset = 0,
+				_In_ const VkDeviceSize& pSize = VK_WHOLE_SIZE);
+
+			/*
+				move allocations of the most empty blocks to the other blocks and release the empty blocks. For each move
+				a new allocation will be created and pOnMove will be called, the owner must copy its data and bind its resource to the new allocation and return true,
+				then the old allocation will be released. If pOnMove returns false the new allocation will be released and the old one remains
+				@param pOnMove, function which will be called for each move (inputs are: old allocation, new allocation and output is true if resource moved)
+				@param pMaxMoves, maximum number of moves
+				@return number of moved allocations
+			*/
+			W_EXP size_t defragment(
+				_In_ const std::function<bool(const w_memory_allocation&, const w_memory_allocation&)>& pOnMove,
+				_In_ const size_t& pMaxMoves = SIZE_MAX);
+
+			//release all blocks which do not have any allocations
+			W_EXP void release_empty_blocks();
+
+			//release all resources
+			W_EXP ULONG release();
+
+#pragma region Getters
+
+			W_EXP w_memory_allocator_statistics get_statistics() const;
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_memory_allocator(w_memory_allocator const&);
+			w_memory_allocator& operator= (w_memory_allocator const&);
+
+			w_memory_allocator_pimp*		_pimp;
+		};
+	}
+}
+
+#endif //__W_MEMORY_ALLOCATOR_H__
@@ -3,6 +3,7 @@
 #include "w_buffer.h"
 #include "w_command_buffers.h"
 #include "w_uniform.h"
+#include "w_upload_manager.h"
 
 using namespace wolf::graphics;
 
@@ -19,6 +20,7 @@ namespace wolf
                 _copy_command_buffer(nullptr),
                 _vertices_count(0),
                 _indices_count(0),
+                _upload_ticket(0),
 				_vertex_binding_attributes(w_vertex_declaration::NOT_DEFINED)
             {
         
@@ -60,8 +62,11 @@ namespace wolf
                     _there_is_no_index_buffer = true;
                 }
 
+                //static buffers are uploaded through staging ring buffer of upload manager
+                auto _use_upload_manager = !pUseDynamicBuffer && pGDevice->upload_manager;
+
                 //create a buffers hosted into the DRAM named staging buffers
-                if (_create_buffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                if (!_use_upload_manager && _create_buffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                     pVerticesData,
 					pVerticesSizeInBytes,
                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
@@ -70,7 +75,7 @@ namespace wolf
                     return W_FAILED;
                 }
 
-                if (!_there_is_no_index_buffer)
+                if (!_use_upload_manager && !_there_is_no_index_buffer)
                 {
                     if (_create_buffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
                         pIndicesData,
@@ -104,12 +109,39 @@ namespace wolf
                     }
                 }
 
-                if (_copy_DRAM_to_VRAM(pVerticesSizeInBytes, _indices_size) == W_FAILED)
+                if (_use_upload_manager)
+                {
+                    //copies will be submitted in one batch, before the first command buffer which uses this mesh
+                    if (pGDevice->upload_manager->upload_buffer(
+                        pVerticesData,
+                        pVerticesSizeInBytes,
+                        this->_vertex_buffer.get_buffer_handle().handle,
+                        0,
+                        VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT,
+                        VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                        &this->_upload_ticket) == W_FAILED)
+                    {
+                        return W_FAILED;
+                    }
+                    if (!_there_is_no_index_buffer &&
+                        pGDevice->upload_manager->upload_buffer(
+                            pIndicesData,
+                            _indices_size,
+                            this->_index_buffer.get_buffer_handle().handle,
+                            0,
+                            VK_ACCESS_INDEX_READ_BIT,
+                            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                            &this->_upload_ticket) == W_FAILED)
+                    {
+                        return W_FAILED;
+                    }
+                }
+                else if (_copy_DRAM_to_VRAM(pVerticesSizeInBytes, _indices_size) == W_FAILED)
                 {
                     return W_FAILED;
                 }
 
-                if (!pUseDynamicBuffer)
+                if (!pUseDynamicBuffer && !_use_upload_manager)
                 {
                     //release staging buffers
                     this->_stagings_buffers.vertices.release();
@@ -127,6 +159,31 @@ namespace wolf
                 return W_PASSED;
             }
 
+            W_RESULT load(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+                _In_ const content_pipeline::w_quantized_vertex_struct* const pQuantizedVertices,
+                _In_ const uint32_t& pVerticesCount,
+                _In_ const float pPositionScale[3],
+                _In_ const float pPositionOffset[3],
+                _In_ const uint32_t* const pIndicesData,
+                _In_ const uint32_t& pIndicesCount)
+            {
+                if (!pPositionScale || !pPositionOffset) return W_FAILED;
+
+                this->_vertex_binding_attributes = w_vertex_binding_attributes(
+                    w_vertex_declaration::VERTEX_QUANTIZED_POSITION_NORMAL_UV_TANGENT_COLOR_BLEND_WEIGHT_BLEND_INDICES);
+                this->_dequantization.position_scale = glm::vec4(pPositionScale[0], pPositionScale[1], pPositionScale[2], 1.0f);
+                this->_dequantization.position_offset = glm::vec4(pPositionOffset[0], pPositionOffset[1], pPositionOffset[2], 0.0f);
+
+                return load(
+                    pGDevice,
+                    pQuantizedVertices,
+                    static_cast<uint32_t>(pVerticesCount * sizeof(content_pipeline::w_quantized_vertex_struct)),
+                    pVerticesCount,
+                    pIndicesData,
+                    pIndicesCount,
+                    false);
+            }
+
             W_RESULT update_dynamic_buffer(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
                 _In_ const void* const pVerticesData,
                 _In_ const uint32_t& pVerticesSize,
@@ -174,7 +231,8 @@ namespace wolf
 				_In_ const int& pIndexCount,
 				_In_ const uint32_t& pFirstIndex,
 				_In_ const int& pVertexCount,
-				_In_ const uint32_t& pFirstVertex)
+				_In_ const uint32_t& pFirstVertex,
+				_In_ const uint32_t& pIndirectDrawsOffset)
             {
 				if (!pCommandBuffer.handle) return W_FAILED;
 
@@ -209,7 +267,7 @@ namespace wolf
 						vkCmdDrawIndexedIndirect(
 							pCommandBuffer.handle,
 							_buffer_handle,
-							0,
+							pIndirectDrawsOffset,
 							_draw_counts,
 							_size);
 					}
@@ -221,7 +279,7 @@ namespace wolf
 							vkCmdDrawIndexedIndirect(
 								pCommandBuffer.handle,
 								_buffer_handle,
-								i * _size,
+								pIndirectDrawsOffset + i * _size,
 								1,
 								_size);
 						}
@@ -289,6 +347,11 @@ namespace wolf
                 return this->_vertex_binding_attributes;
             }
 
+            const w_mesh_dequantization get_dequantization() const
+            {
+                return this->_dequantization;
+            }
+
 #pragma endregion
 
 #pragma region Setters
@@ -307,6 +370,13 @@ namespace wolf
 
             void release()
             {
+                //buffers may still be the destination of a pending upload
+                if (this->_upload_ticket && this->_gDevice && this->_gDevice->upload_manager)
+                {
+                    this->_gDevice->upload_manager->wait(this->_upload_ticket);
+                }
+                this->_upload_ticket = 0;
+
                 //release vertex and index buffers
 
                 this->_vertex_buffer.release();
@@ -435,8 +505,11 @@ namespace wolf
             uint32_t                                            _vertices_count;
             w_texture*                                          _texture;
             w_vertex_binding_attributes                         _vertex_binding_attributes;
+            w_mesh_dequantization                               _dequantization;
             bool                                                _dynamic_buffer;
             w_command_buffers*                                   _copy_command_buffer;
+            //ticket of upload manager for vertex and index buffers
+            uint64_t                                            _upload_ticket;
             struct
             {
                 w_buffer vertices;
@@ -476,6 +549,26 @@ W_RESULT w_mesh::load(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
         pUseDynamicBuffer);
 }
 
+W_RESULT w_mesh::load(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+                     _In_ const content_pipeline::w_quantized_vertex_struct* const pQuantizedVertices,
+                     _In_ const uint32_t& pVerticesCount,
+                     _In_ const float pPositionScale[3],
+                     _In_ const float pPositionOffset[3],
+                     _In_ const uint32_t* const pIndicesData,
+                     _In_ const uint32_t& pIndicesCount)
+{
+    if (!this->_pimp) return W_FAILED;
+
+    return this->_pimp->load(
+        pGDevice,
+        pQuantizedVertices,
+        pVerticesCount,
+        pPositionScale,
+        pPositionOffset,
+        pIndicesData,
+        pIndicesCount);
+}
+
 W_RESULT w_mesh::update_dynamic_buffer(
     _In_ const std::shared_ptr<w_graphics_device>& pGDevice,
     _In_ const void* const pVerticesData,
@@ -503,7 +596,8 @@ W_RESULT w_mesh::draw(
 	_In_ const int& pIndexCount,
 	_In_ const uint32_t& pFirstIndex,
 	_In_ const int& pVertexCount,
-	_In_ const uint32_t& pFirstVertex)
+	_In_ const uint32_t& pFirstVertex,
+	_In_ const uint32_t& pIndirectDrawsOffset)
 {
 	if (!this->_pimp) return W_FAILED;
 	return this->_pimp->draw(
@@ -516,7 +610,8 @@ W_RESULT w_mesh::draw(
 		pIndexCount,
 		pFirstIndex,
 		pVertexCount,
-		pFirstVertex);
+		pFirstVertex,
+		pIndirectDrawsOffset);
 }
 
 ULONG w_mesh::release()
@@ -561,6 +656,11 @@ const w_vertex_binding_attributes w_mesh::get_vertex_binding_attributes() const
     return this->_pimp->get_vertex_binding_attributes();
 }
 
+const w_mesh_dequantization w_mesh::get_dequantization() const
+{
+    return this->_pimp ? this->_pimp->get_dequantization() : w_mesh_dequantization();
+}
+
 #pragma endregion
 
 #pragma region Setters
@@ -14,6 +14,7 @@
 #include "w_render_pass.h"
 #include <glm/mat4x4.hpp>
 #include <w_vertex_declaration.h>
+#include <w_vertex_quantizer.h>
 
 namespace wolf
 {
@@ -49,7 +50,10 @@ namespace wolf
 			//Position(Float3) + Float3 + Float2 + Float3 + Float3 + Float3 + Float3
             VERTEX_POSITION_NORMAL_UV_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES,
             //Position(Float3) + Float3 + Float3 + Float3 + Float3 + Float3 + Float3
-            VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES
+            VERTEX_POSITION_NORMAL_UV_INDEX_TANGENT_BINORMAL_BLEND_WEIGHT_BLEND_INDICES,
+            //Position(Snorm16x4) + Octahedral Normal(Snorm16x2) + UV(Half2) + Octahedral Tangent(Snorm8x4) + Color(Unorm8x4) + Blend Weight(Unorm8x4) + Blend Indices(Uint8x4)
+            //Layout of w_quantized_vertex_struct, position must be decoded with scale and offset of w_quantized_mesh
+            VERTEX_QUANTIZED_POSITION_NORMAL_UV_TANGENT_COLOR_BLEND_WEIGHT_BLEND_INDICES
         } w_vertex_declaration;
 
 		typedef enum w_vertex_attribute : uint32_t
@@ -68,7 +72,22 @@ namespace wolf
             W_VEC4,
 			W_COLOR,
 			W_BLEND_WEIGHT,
-			W_BLEND_INDICES
+			W_BLEND_INDICES,
+			//packed formats
+			W_HALF2,
+			W_UV_HALF,
+			W_HALF4,
+			W_SNORM16_2,
+			W_NORM_OCTAHEDRAL,
+			W_SNORM16_4,
+			W_POS_QUANTIZED,
+			W_SNORM8_4,
+			W_TANGENT_OCTAHEDRAL,
+			W_UNORM8_4,
+			W_COLOR_PACKED,
+			W_BLEND_WEIGHT_PACKED,
+			W_UINT8_4,
+			W_BLEND_INDICES_PACKED
         } w_vertex_attribute;
 
         struct w_vertex_binding_attributes
@@ -140,6 +159,15 @@ namespace wolf
                          _v.attributes.push_back(w_mesh::w_vertex_attribute::Vec3);
                          _v.attributes.push_back(w_mesh::w_vertex_attribute::Vec3);*/
                         break;
+				case w_vertex_declaration::VERTEX_QUANTIZED_POSITION_NORMAL_UV_TANGENT_COLOR_BLEND_WEIGHT_BLEND_INDICES:
+					_attr.push_back(w_vertex_attribute::W_POS_QUANTIZED);//position
+					_attr.push_back(w_vertex_attribute::W_NORM_OCTAHEDRAL);//normal
+					_attr.push_back(w_vertex_attribute::W_UV_HALF);//texture coordinate
+					_attr.push_back(w_vertex_attribute::W_TANGENT_OCTAHEDRAL);//tangent with sign of binormal
+					_attr.push_back(w_vertex_attribute::W_COLOR_PACKED);//color
+					_attr.push_back(w_vertex_attribute::W_BLEND_WEIGHT_PACKED);//blend weight
+					_attr.push_back(w_vertex_attribute::W_BLEND_INDICES_PACKED);//blend indices
+					break;
 				case w_vertex_declaration::VERTEX_POSITION_UV:
 					_attr.push_back(w_vertex_attribute::W_VEC3);//position
 					_attr.push_back(w_vertex_attribute::W_VEC2);//texture coordinate
@@ -234,6 +262,13 @@ namespace wolf
 #endif
         };
 
+        //push constant of vertex shaders of quantized meshes, decoded position = position * position_scale + position_offset
+        struct w_mesh_dequantization
+        {
+            glm::vec4                                               position_scale = glm::vec4(1.0f);
+            glm::vec4                                               position_offset = glm::vec4(0.0f);
+        };
+
         class w_mesh_pimp;
 		//Represents a 3D model mesh composed of multiple meshpart objects.
 		class w_mesh : public system::w_object
@@ -250,6 +285,25 @@ namespace wolf
                                _In_ const uint32_t* const pIndicesData,
                                _In_ const uint32_t& pIndicesCount,
                                _In_ const bool& pUseDynamicBuffer = false);
+
+			/*
+				load quantized vertices, vertex binding attributes of mesh will be VERTEX_QUANTIZED_POSITION_NORMAL_UV_TANGENT_COLOR_BLEND_WEIGHT_BLEND_INDICES
+				and scale and offset of positions will be stored in get_dequantization, which must be sent to vertex shader with push constants
+				@param pGDevice, The graphics device
+				@param pQuantizedVertices, The quantized vertices, such as vertices of w_quantized_mesh or quantized_vertices of w_mapped_mesh
+				@param pVerticesCount, The count of quantized vertices
+				@param pPositionScale, The scale of positions
+				@param pPositionOffset, The offset of positions
+				@param pIndicesData, The indices
+				@param pIndicesCount, The count of indices
+			*/
+			W_EXP W_RESULT load(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+                               _In_ const content_pipeline::w_quantized_vertex_struct* const pQuantizedVertices,
+                               _In_ const uint32_t& pVerticesCount,
+                               _In_ const float pPositionScale[3],
+                               _In_ const float pPositionOffset[3],
+                               _In_ const uint32_t* const pIndicesData,
+                               _In_ const uint32_t& pIndicesCount);
             
             //update data of vertices and indices
             W_EXP W_RESULT update_dynamic_buffer(
@@ -272,6 +326,7 @@ namespace wolf
 				@param pFirstIndex, The first index in index buffer for drawing with indexed buffer
 				@param pVertexCount, The count of vertices for drawing without indexed buffer
 				@param pFirstVertex, The first vertex of vertex buffer for drawing without indexed buffer
+				@param pIndirectDrawsOffset, offset of indirect draw commands in bytes, i.e. offset of region of a frame
 			*/
             W_EXP W_RESULT draw(
 				_In_ const w_command_buffer& pCommandBuffer,
@@ -283,7 +338,8 @@ namespace wolf
 				_In_ const int& pIndexCount = -1,
 				_In_ const uint32_t& pFirstIndex = 0,
 				_In_ const int& pVertexCount = -1,
-				_In_ const uint32_t& pFirstVertex = 0);
+				_In_ const uint32_t& pFirstVertex = 0,
+				_In_ const uint32_t& pIndirectDrawsOffset = 0);
 
 			//release all resources
 			W_EXP virtual ULONG release() override;
@@ -296,6 +352,8 @@ namespace wolf
             W_EXP const uint32_t                                            get_indices_count() const;
             W_EXP w_texture*                                                get_texture() const;
             W_EXP const w_vertex_binding_attributes                         get_vertex_binding_attributes() const;
+            //scale and offset of positions of quantized mesh
+            W_EXP const w_mesh_dequantization                               get_dequantization() const;
 
 #pragma endregion
 
@@ -0,0 +1,351 @@
+#include "w_render_pch.h"
+#include "w_parallel_command_buffers.h"
+#include <atomic>
+#include <chrono>
+
+namespace wolf
+{
+	namespace graphics
+	{
+		//command pool of a worker for a frame, only that worker allocates and records from it
+		struct w_worker_command_pool
+		{
+			VkCommandPool										handle = 0;
+			std::vector<VkCommandBuffer>						command_buffers;
+			//number of command buffers which have been used since the last reset
+			size_t												used = 0;
+		};
+
+		class w_parallel_command_buffers_pimp
+		{
+		public:
+			w_parallel_command_buffers_pimp() :
+				_name("w_parallel_command_buffers"),
+				_gDevice(nullptr),
+				_job_system(nullptr),
+				_number_of_workers(0),
+				_number_of_frames(0)
+			{
+			}
+
+			~w_parallel_command_buffers_pimp()
+			{
+				release();
+			}
+
+			W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ wolf::system::w_job_system* pJobSystem,
+				_In_ const uint32_t& pNumberOfFrames)
+			{
+				const std::string _trace_info = this->_name + "::load";
+
+				if (!pGDevice || !pJobSystem || !pJobSystem->get_number_of_workers() || !pNumberOfFrames)
+				{
+					V(W_FAILED, "invalid parameters", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				release();
+
+				this->_gDevice = pGDevice;
+				this->_job_system = pJobSystem;
+				this->_number_of_workers = pJobSystem->get_number_of_workers();
+				this->_number_of_frames = pNumberOfFrames;
+
+				VkCommandPoolCreateInfo _command_pool_info = {};
+				_command_pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+				_command_pool_info.pNext = nullptr;
+				_command_pool_info.queueFamilyIndex = this->_gDevice->vk_graphics_queue.index;
+				//command buffers will be reset together with their pool
+				_command_pool_info.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+
+				this->_pools.resize(this->_number_of_frames * this->_number_of_workers);
+				for (auto& _pool : this->_pools)
+				{
+					if (vkCreateCommandPool(this->_gDevice->vk_device, &_command_pool_info, nullptr, &_pool.handle))
+					{
+						_pool.handle = 0;
+						V(W_FAILED, "creating command pool of worker for graphics device: " +
+							this->_gDevice->device_info->get_device_name() +
+							" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()),
+							_trace_info, 3, false);
+						release();
+						return W_FAILED;
+					}
+				}
+
+				return W_PASSED;
+			}
+
+			W_RESULT record(
+				_In_ const uint32_t& pFrameIndex,
+				_In_ const w_command_buffer& pPrimaryCommandBuffer,
+				_In_ const w_render_pass& pRenderPass,
+				_In_ const uint32_t& pFrameBufferIndex,
+				_In_ const size_t& pNumberOfDrawables,
+				_In_ const w_record_function& pRecordFunction,
+				_In_ const size_t& pNumberOfPartitions,
+				_In_ const uint32_t& pSubpass)
+			{
+				const std::string _trace_info = this->_name + "::record";
+
+				if (!this->_gDevice || pFrameIndex >= this->_number_of_frames || !pRecordFunction) return W_FAILED;
+
+				auto _start = std::chrono::high_resolution_clock::now();
+
+				//GPU finished the previous commands of this frame, so all of its command buffers can be reused
+				auto _frame_pools = &this->_pools[pFrameIndex * this->_number_of_workers];
+				for (size_t i = 0; i < this->_number_of_workers; ++i)
+				{
+					if (_frame_pools[i].used)
+					{
+						vkResetCommandPool(this->_gDevice->vk_device, _frame_pools[i].handle, 0);
+						_frame_pools[i].used = 0;
+					}
+				}
+
+				auto _number_of_partitions = pNumberOfPartitions ? pNumberOfPartitions : this->_number_of_workers;
+				if (_number_of_partitions > pNumberOfDrawables) _number_of_partitions = pNumberOfDrawables;
+				if (!_number_of_partitions)
+				{
+					_update_statistics(0, 0, _start);
+					return W_PASSED;
+				}
+
+				const VkCommandBufferInheritanceInfo _inheritance_info =
+				{
+					VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,					// Type
+					nullptr,															// Next
+					pRenderPass.get_handle().handle,									// RenderPass
+					pSubpass,															// Subpass
+					pRenderPass.get_frame_buffer_handle(pFrameBufferIndex),			// Framebuffer
+					VK_FALSE,															// OcclusionQueryEnable
+					0,																	// QueryFlags
+					0																	// PipelineStatistics
+				};
+				const VkCommandBufferBeginInfo _begin_info =
+				{
+					VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,						// Type
+					nullptr,															// Next
+					VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT |
+					VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT,						// Flags
+					&_inheritance_info													// InheritanceInfo
+				};
+				auto _viewport = pRenderPass.get_viewport();
+				auto _viewport_scissor = pRenderPass.get_viewport_scissor();
+
+				std::vector<VkCommandBuffer> _secondaries(_number_of_partitions, (VkCommandBuffer)0);
+				std::atomic<bool> _failed(false);
+
+				this->_job_system->parallel_for(_number_of_partitions, 1, [&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+				{
+					auto _worker_index = wolf::system::w_job_system::get_current_worker_index();
+					if (_worker_index < 0 || static_cast<size_t>(_worker_index) >= this->_number_of_workers)
+					{
+						_failed = true;
+						return;
+					}
+					auto _pool = &_frame_pools[_worker_index];
+
+					for (auto p = pBegin; p < pEnd; ++p)
+					{
+						auto _cmd = _get_command_buffer(*_pool);
+						if (!_cmd || vkBeginCommandBuffer(_cmd, &_begin_info) != VK_SUCCESS)
+						{
+							_failed = true;
+							return;
+						}
+
+						//secondary command buffers do not inherit dynamic states of primary
+						vkCmdSetViewport(_cmd, 0, 1, &_viewport);
+						vkCmdSetScissor(_cmd, 0, 1, &_viewport_scissor);
+
+						//split drawables as evenly as possible
+						auto _first = p * pNumberOfDrawables / _number_of_partitions;
+						auto _last = (p + 1) * pNumberOfDrawables / _number_of_partitions;
+
+						w_command_buffer _command_buffer;
+						_command_buffer.handle = _cmd;
+						if (pRecordFunction(_command_buffer, _first, _last) == W_FAILED)
+						{
+							_failed = true;
+						}
+						if (vkEndCommandBuffer(_cmd) != VK_SUCCESS)
+						{
+							_failed = true;
+						}
+						_secondaries[p] = _cmd;
+					}
+				});
+
+				if (_failed)
+				{
+					V(W_FAILED, "recording secondary command buffers for graphics device: " +
+						this->_gDevice->device_info->get_device_name() +
+						" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()),
+						_trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				vkCmdExecuteCommands(pPrimaryCommandBuffer.handle, static_cast<uint32_t>(_secondaries.size()), _secondaries.data());
+
+				_update_statistics(_number_of_partitions, pNumberOfDrawables, _start);
+
+				return W_PASSED;
+			}
+
+			ULONG release()
+			{
+				if (this->_gDevice)
+				{
+					//command buffers will be freed with their pools
+					for (auto& _pool : this->_pools)
+					{
+						if (_pool.handle)
+						{
+							vkDestroyCommandPool(this->_gDevice->vk_device, _pool.handle, nullptr);
+						}
+					}
+				}
+				this->_pools.clear();
+				this->_job_system = nullptr;
+				this->_number_of_workers = 0;
+				this->_number_of_frames = 0;
+				this->_statistics = w_parallel_command_buffers_statistics();
+				this->_gDevice = nullptr;
+
+				return 0;
+			}
+
+#pragma region Getters
+
+			size_t get_number_of_workers() const
+			{
+				return this->_number_of_workers;
+			}
+
+			w_parallel_command_buffers_statistics get_statistics() const
+			{
+				auto _statistics = this->_statistics;
+				_statistics.number_of_workers = this->_number_of_workers;
+				_statistics.number_of_secondary_command_buffers = 0;
+				for (auto& _pool : this->_pools)
+				{
+					_statistics.number_of_secondary_command_buffers += _pool.command_buffers.size();
+				}
+				return _statistics;
+			}
+
+#pragma endregion
+
+		private:
+			//get next free command buffer of pool, it will be allocated if pool does not have any free one
+			VkCommandBuffer _get_command_buffer(_Inout_ w_worker_command_pool& pPool)
+			{
+				if (pPool.used == pPool.command_buffers.size())
+				{
+					VkCommandBufferAllocateInfo _command_buffer_info = {};
+					_command_buffer_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+					_command_buffer_info.pNext = nullptr;
+					_command_buffer_info.commandPool = pPool.handle;
+					_command_buffer_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+					_command_buffer_info.commandBufferCount = 1;
+
+					VkCommandBuffer _cmd = 0;
+					if (vkAllocateCommandBuffers(this->_gDevice->vk_device, &_command_buffer_info, &_cmd)) return 0;
+					pPool.command_buffers.push_back(_cmd);
+				}
+				return pPool.command_buffers[pPool.used++];
+			}
+
+			void _update_statistics(
+				_In_ const size_t& pNumberOfPartitions,
+				_In_ const size_t& pNumberOfDrawables,
+				_In_ const std::chrono::high_resolution_clock::time_point& pStart)
+			{
+				this->_statistics.number_of_partitions = pNumberOfPartitions;
+				this->_statistics.number_of_drawables = pNumberOfDrawables;
+				this->_statistics.recording_time_in_ms = std::chrono::duration<double, std::milli>(
+					std::chrono::high_resolution_clock::now() - pStart).count();
+			}
+
+			std::string											_name;
+			std::shared_ptr<w_graphics_device>					_gDevice;
+			wolf::system::w_job_system*							_job_system;
+			size_t												_number_of_workers;
+			uint32_t											_number_of_frames;
+			//pools of frame f and worker w are stored in index f * _number_of_workers + w
+			std::vector<w_worker_command_pool>					_pools;
+			w_parallel_command_buffers_statistics				_statistics;
+		};
+	}
+}
+
+using namespace wolf::graphics;
+
+w_parallel_command_buffers::w_parallel_command_buffers() : _pimp(new w_parallel_command_buffers_pimp())
+{
+	_super::set_class_name("w_parallel_command_buffers");
+}
+
+w_parallel_command_buffers::~w_parallel_command_buffers()
+{
+	release();
+}
+
+W_RESULT w_parallel_command_buffers::load(
+	_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_ wolf::system::w_job_system* pJobSystem,
+	_In_ const uint32_t& pNumberOfFrames)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->load(pGDevice, pJobSystem, pNumberOfFrames);
+}
+
+W_RESULT w_parallel_command_buffers::record(
+	_In_ const uint32_t& pFrameIndex,
+	_In_ const w_command_buffer& pPrimaryCommandBuffer,
+	_In_ const w_render_pass& pRenderPass,
+	_In_ const uint32_t& pFrameBufferIndex,
+	_In_ const size_t& pNumberOfDrawables,
+	_In_ const w_record_function& pRecordFunction,
+	_In_ const size_t& pNumberOfPartitions,
+	_In_ const uint32_t& pSubpass)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->record(
+		pFrameIndex,
+		pPrimaryCommandBuffer,
+		pRenderPass,
+		pFrameBufferIndex,
+		pNumberOfDrawables,
+		pRecordFunction,
+		pNumberOfPartitions,
+		pSubpass);
+}
+
+ULONG w_parallel_command_buffers::release()
+{
+	if (_super::get_is_released()) return 0;
+
+	SAFE_RELEASE(this->_pimp);
+
+	return _super::release();
+}
+
+#pragma region Getters
+
+size_t w_parallel_command_buffers::get_number_of_workers() const
+{
+	if (!this->_pimp) return 0;
+	return this->_pimp->get_number_of_workers();
+}
+
+w_parallel_command_buffers_statistics w_parallel_command_buffers::get_statistics() const
+{
+	if (!this->_pimp) return w_parallel_command_buffers_statistics();
+	return this->_pimp->get_statistics();
+}
+
+#pragma endregion
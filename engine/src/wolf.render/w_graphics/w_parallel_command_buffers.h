@@ -0,0 +1,112 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_parallel_command_buffers.h
+	Description		 : Record secondary command buffers of a render pass in parallel with w_job_system
+	Comment          : Each worker of job system has its own command pool for each frame, so recording never needs a lock.
+					   Drawables are split into partitions, each partition will be recorded into one secondary command buffer
+					   and all of them will be executed from the primary command buffer in order of partitions.
+					   The render pass of primary command buffer must be begun with VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_PARALLEL_COMMAND_BUFFERS_H__
+#define __W_PARALLEL_COMMAND_BUFFERS_H__
+
+#include "w_graphics_device_manager.h"
+#include "w_command_buffers.h"
+#include "w_render_pass.h"
+#include <w_job_system.h>
+#include <functional>
+
+namespace wolf
+{
+	namespace graphics
+	{
+		struct w_parallel_command_buffers_statistics
+		{
+			size_t		number_of_workers = 0;
+			//number of secondary command buffers which have been allocated for all frames
+			size_t		number_of_secondary_command_buffers = 0;
+			//partitions and drawables of the last recording
+			size_t		number_of_partitions = 0;
+			size_t		number_of_drawables = 0;
+			//time of the last recording, including executing secondary command buffers from primary
+			double		recording_time_in_ms = 0.0;
+		};
+
+		/*
+			record drawables of [pBegin, pEnd) into secondary command buffer, the viewport and scissor of render pass have already been set.
+			This function will be called from workers of job system at the same time, so it must not modify shared states
+		*/
+		typedef std::function<W_RESULT(_In_ const w_command_buffer& pCommandBuffer, _In_ const size_t& pBegin, _In_ const size_t& pEnd)> w_record_function;
+
+		class w_parallel_command_buffers_pimp;
+		class w_parallel_command_buffers : public system::w_object
+		{
+		public:
+			W_EXP w_parallel_command_buffers();
+			W_EXP ~w_parallel_command_buffers();
+
+			/*
+				create command pools for each worker of job system and each frame
+				@param pGDevice, graphics device
+				@param pJobSystem, allocated job system, must be alive until releasing this object and recording must be called from
+				the thread which allocated the job system
+				@param pNumberOfFrames, number of frames which can be recorded independently, i.e. number of swap chain images
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ wolf::system::w_job_system* pJobSystem,
+				_In_ const uint32_t& pNumberOfFrames);
+
+			/*
+				reset command pools of frame, record secondary command buffers in parallel and execute them from primary command buffer.
+				GPU must have finished the previous commands of this frame
+				@param pFrameIndex, index of frame
+				@param pPrimaryCommandBuffer, primary command buffer which has begun the render pass with secondary contents
+				@param pRenderPass, render pass
+				@param pFrameBufferIndex, index of frame buffer of render pass
+				@param pNumberOfDrawables, number of drawables which will be split into partitions
+				@param pRecordFunction, function which records a partition
+				@param pNumberOfPartitions, number of partitions, zero means number of workers
+				@param pSubpass, index of subpass
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT record(
+				_In_ const uint32_t& pFrameIndex,
+				_In_ const w_command_buffer& pPrimaryCommandBuffer,
+				_In_ const w_render_pass& pRenderPass,
+				_In_ const uint32_t& pFrameBufferIndex,
+				_In_ const size_t& pNumberOfDrawables,
+				_In_ const w_record_function& pRecordFunction,
+				_In_ const size_t& pNumberOfPartitions = 0,
+				_In_ const uint32_t& pSubpass = 0);
+
+			//release all resources
+			W_EXP ULONG release() override;
+
+#pragma region Getters
+
+			W_EXP size_t get_number_of_workers() const;
+			W_EXP w_parallel_command_buffers_statistics get_statistics() const;
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_parallel_command_buffers(w_parallel_command_buffers const&);
+			w_parallel_command_buffers& operator= (w_parallel_command_buffers const&);
+
+			typedef system::w_object						_super;
+			w_parallel_command_buffers_pimp*				_pimp;
+		};
+	}
+}
+
+#endif //__W_PARALLEL_COMMAND_BUFFERS_H__
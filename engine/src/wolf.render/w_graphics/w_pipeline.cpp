@@ -1,6 +1,12 @@
 #include "w_render_pch.h"
 #include "w_pipeline.h"
 #include <w_cpipeline_model.h>
+#include <chrono>
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <sstream>
+#include <algorithm>
 
 namespace wolf
 {
@@ -73,11 +79,20 @@ namespace wolf
 				auto _shader_des_set = pShaderBinding->get_descriptor_set().handle;
 				this->_shader_descriptor_set = _shader_des_set  ? _shader_des_set : nullptr;
 				
+				std::vector<VkDescriptorSetLayout> _descriptor_set_layouts;
+				this->_descriptor_sets.clear();
 				const auto _shader_descriptor_set_layout = pShaderBinding->get_descriptor_set_layout().handle;
+				if (_shader_descriptor_set_layout && this->_shader_descriptor_set)
+				{
+					_descriptor_set_layouts.push_back(_shader_descriptor_set_layout);
+					this->_descriptor_sets.push_back(this->_shader_descriptor_set);
+					_get_additional_descriptor_sets(pShaderBinding, _descriptor_set_layouts, this->_descriptor_sets);
+				}
+
                 auto _pipeline_layout_create_info = _generate_pipeline_layout_create_info(
                     pVertexBindingAttributes,
                     pPrimitiveTopology,
-					_shader_descriptor_set_layout ? &_shader_descriptor_set_layout : nullptr,
+					_descriptor_set_layouts,
                     pDynamicStates,
                     pPushConstantRanges,
                     &_vertex_input_state_create_info,
@@ -174,12 +189,14 @@ namespace wolf
 
                 auto _pipeline_cache = w_pipeline::get_pipeline_cache(pPipelineCacheName);
 
+                auto _start_time = std::chrono::steady_clock::now();
                 auto _hr = vkCreateGraphicsPipelines(this->_gDevice->vk_device,
                     _pipeline_cache == nullptr ? VK_NULL_HANDLE : _pipeline_cache,
                     1,
                     &_pipeline_create_info,
                     nullptr,
                     &this->_pipeline);
+                record_pipeline_creation(pPipelineCacheName, _start_time);
                 if (_hr)
                 {
                     V(W_FAILED, "creating pipeline for graphics device: " +
@@ -193,7 +210,7 @@ namespace wolf
 
             W_RESULT load_compute(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
                 _In_ const w_shader* pShaderBinding,
-                _In_ const uint32_t& pSpecializationData,
+                _In_ const w_specialization_info& pSpecializationInfo,
                 _In_ const std::string& pPipelineCacheName,
                 _In_ const std::vector<w_push_constant_range> pPushConstantRanges)
             {
@@ -207,9 +224,12 @@ namespace wolf
 
                 std::vector<VkDescriptorSetLayout> _descriptor_set_layouts;
 				auto _shader_descriptor_set_layout = pShaderBinding->get_compute_descriptor_set_layout().handle;
-				if (_shader_descriptor_set_layout)
+				this->_compute_descriptor_sets.clear();
+				if (_shader_descriptor_set_layout && this->_compute_shader_descriptor_set)
 				{
 					_descriptor_set_layouts.push_back(_shader_descriptor_set_layout);
+					this->_compute_descriptor_sets.push_back(this->_compute_shader_descriptor_set);
+					_get_additional_descriptor_sets(pShaderBinding, _descriptor_set_layouts, this->_compute_descriptor_sets);
 				}
                 auto _push_const_size = pPushConstantRanges.size();
 
@@ -241,22 +261,15 @@ namespace wolf
                 _compute_pipeline_create_info.flags = 0;
                 _compute_pipeline_create_info.stage = pShaderBinding->get_compute_shader_stage();
 
-                // Use specialization constants to pass max. level of detail (determined by no. of meshes)
-                VkSpecializationMapEntry specializationEntry{};
-                specializationEntry.constantID = 0;
-                specializationEntry.offset = 0;
-                specializationEntry.size = sizeof(uint32_t);
-
-                uint32_t _specialization_data = pSpecializationData;
-
+                //otherwise specialization info of compute stage of shader will be used
                 VkSpecializationInfo _specialization_info;
-                _specialization_info.mapEntryCount = 1;
-                _specialization_info.pMapEntries = &specializationEntry;
-                _specialization_info.dataSize = sizeof(_specialization_data);
-                _specialization_info.pData = &_specialization_data;
-
-                _compute_pipeline_create_info.stage.pSpecializationInfo = &_specialization_info;
+                if (!pSpecializationInfo.empty())
+                {
+                    _specialization_info = pSpecializationInfo.get_vk_info();
+                    _compute_pipeline_create_info.stage.pSpecializationInfo = &_specialization_info;
+                }
 
+                auto _start_time = std::chrono::steady_clock::now();
                 _hr = vkCreateComputePipelines(
                     pGDevice->vk_device,
                     _pipeline_cache,
@@ -264,6 +277,7 @@ namespace wolf
                     &_compute_pipeline_create_info,
                     nullptr,
                     &this->_pipeline);
+                record_pipeline_creation(pPipelineCacheName, _start_time);
 
                 if (_hr)
                 {
@@ -277,43 +291,34 @@ namespace wolf
             }
 
 			void bind(_In_ const w_command_buffer& pCommandBuffer, 
-				_In_ const w_pipeline_bind_point& pPipelineBindPoint)
+				_In_ const w_pipeline_bind_point& pPipelineBindPoint,
+				_In_ const std::vector<uint32_t>& pDynamicOffsets)
+			{
+				bind_descriptor_set(pCommandBuffer, pPipelineBindPoint, pDynamicOffsets);
+				vkCmdBindPipeline(pCommandBuffer.handle, (VkPipelineBindPoint)pPipelineBindPoint, this->_pipeline);
+			}
+
+			void bind_descriptor_set(_In_ const w_command_buffer& pCommandBuffer,
+				_In_ const w_pipeline_bind_point& pPipelineBindPoint,
+				_In_ const std::vector<uint32_t>& pDynamicOffsets)
 			{
-				auto _cmd = pCommandBuffer.handle;
 				auto _bind_point = (VkPipelineBindPoint)pPipelineBindPoint;
 
-				if (_bind_point == VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS)
-				{
-					//set descriptor set of shader
-					if (this->_shader_descriptor_set)
-					{
-						vkCmdBindDescriptorSets(_cmd,
-							_bind_point,
-							this->_pipeline_layout,
-							0,
-							1,
-							&this->_shader_descriptor_set,
-							0,
-							nullptr);
-					}
-				}
-				else
-				{
-					//set descriptor set of compute shader
-					if (this->_compute_shader_descriptor_set)
-					{
-						vkCmdBindDescriptorSets(_cmd,
-							_bind_point,
-							this->_pipeline_layout,
-							0,
-							1,
-							&this->_compute_shader_descriptor_set,
-							0,
-							nullptr);
-					}
-				}
-				vkCmdBindPipeline(_cmd, _bind_point, this->_pipeline);
-				_cmd = nullptr;
+				//descriptor set of shader or compute shader, followed by additional descriptor sets of shader at set 1, 2, ...
+				//they will not be changed after loading, so pipeline can be bound from multiple threads
+				auto _descriptor_sets = _bind_point == VkPipelineBindPoint::VK_PIPELINE_BIND_POINT_GRAPHICS ?
+					&this->_descriptor_sets : &this->_compute_descriptor_sets;
+				if (_descriptor_sets->empty()) return;
+
+				//one offset for each dynamic uniform or storage buffer, in order of binding numbers
+				vkCmdBindDescriptorSets(pCommandBuffer.handle,
+					_bind_point,
+					this->_pipeline_layout,
+					0,
+					static_cast<uint32_t>(_descriptor_sets->size()),
+					_descriptor_sets->data(),
+					static_cast<uint32_t>(pDynamicOffsets.size()),
+					pDynamicOffsets.size() ? pDynamicOffsets.data() : nullptr);
 			}
 
             ULONG release()
@@ -334,6 +339,8 @@ namespace wolf
                 }
 
 				this->_shader_descriptor_set = nullptr;
+				this->_descriptor_sets.clear();
+				this->_compute_descriptor_sets.clear();
                 this->_gDevice = nullptr;
 				_name.clear();
 
@@ -374,14 +381,186 @@ namespace wolf
 
 #pragma endregion
 
-            static std::map<std::string, VkPipelineCache> pipeline_caches;
+            //add the elapsed time of creating a pipeline to the statistics of its pipeline cache
+            static void record_pipeline_creation(
+                _In_ const std::string& pPipelineCacheName,
+                _In_ const std::chrono::steady_clock::time_point& pStartTime)
+            {
+                auto _elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - pStartTime).count();
+
+                std::lock_guard<std::mutex> _lock(pipeline_caches_mutex);
+                auto _iter = pipeline_caches.find(pPipelineCacheName);
+                if (_iter == pipeline_caches.end()) return;
+
+                _iter->second.statistics.number_of_pipelines++;
+                _iter->second.statistics.pipelines_creation_time_in_ms += _elapsed;
+            }
+
+            //file of pipeline cache is keyed by vendor, device and driver version
+            static std::string get_pipeline_cache_path(
+                _In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+                _In_z_ const std::string& pPipelineCacheName)
+            {
+                auto _properties = pGDevice->device_info->device_properties;
+                return w_pipeline::get_pipeline_cache_directory() + pPipelineCacheName + "_" +
+                    std::to_string(_properties->vendorID) + "_" +
+                    std::to_string(_properties->deviceID) + "_" +
+                    std::to_string(_properties->driverVersion) + ".cache";
+            }
+
+            //write data of pipeline cache to its file, it does not lock pipeline_caches_mutex
+            static W_RESULT write_pipeline_cache(
+                _In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+                _In_z_ const std::string& pPipelineCacheName,
+                _In_ const VkPipelineCache& pPipelineCache)
+            {
+                size_t _size = 0;
+                if (vkGetPipelineCacheData(pGDevice->vk_device, pPipelineCache, &_size, nullptr) || _size == 0)
+                {
+                    return W_FAILED;
+                }
+
+                std::vector<uint8_t> _data(_size);
+                if (vkGetPipelineCacheData(pGDevice->vk_device, pPipelineCache, &_size, _data.data()))
+                {
+                    return W_FAILED;
+                }
+
+                //write to a temporary file first, so a crash will not leave a broken cache behind
+                auto _path = get_pipeline_cache_path(pGDevice, pPipelineCacheName);
+                auto _temp_path = _path + ".tmp";
+                std::ofstream _file(_temp_path, std::ios::binary | std::ios::trunc);
+                if (!_file)
+                {
+                    logger.warning("could not create pipeline cache file: " + _temp_path);
+                    return W_FAILED;
+                }
+                _file.write(reinterpret_cast<const char*>(_data.data()), _size);
+                _file.close();
+                if (_file.fail())
+                {
+                    std::remove(_temp_path.c_str());
+                    return W_FAILED;
+                }
+
+                std::remove(_path.c_str());
+                if (std::rename(_temp_path.c_str(), _path.c_str()))
+                {
+                    std::remove(_temp_path.c_str());
+                    return W_FAILED;
+                }
+
+                return W_PASSED;
+            }
+
+            //validate header of pipeline cache data against the graphics device, stale data will be rejected
+            static bool validate_pipeline_cache_data(
+                _In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+                _In_ const std::vector<uint8_t>& pData)
+            {
+                //header version one contains: header size, header version, vendor ID, device ID and pipeline cache UUID
+                const size_t _header_size = 4 * sizeof(uint32_t) + VK_UUID_SIZE;
+                if (pData.size() < _header_size) return false;
+
+                uint32_t _header[4];
+                std::memcpy(_header, pData.data(), sizeof(_header));
+
+                auto _properties = pGDevice->device_info->device_properties;
+                if (_header[0] < _header_size || _header[0] > pData.size()) return false;
+                if (_header[1] != VK_PIPELINE_CACHE_HEADER_VERSION_ONE) return false;
+                if (_header[2] != _properties->vendorID) return false;
+                if (_header[3] != _properties->deviceID) return false;
+
+                return std::memcmp(pData.data() + sizeof(_header), _properties->pipelineCacheUUID, VK_UUID_SIZE) == 0;
+            }
+
+            struct pipeline_cache
+            {
+                VkPipelineCache                 handle;
+                //the device which owns this pipeline cache
+                VkDevice                        device;
+                w_pipeline_cache_statistics     statistics;
+            };
+
+            static std::map<std::string, pipeline_cache> pipeline_caches;
+            static std::mutex pipeline_caches_mutex;
+
+            struct compute_pipeline_variant
+            {
+                VkDevice            device = 0;
+                const w_shader*     shader = nullptr;
+                w_pipeline*         pipeline = nullptr;
+            };
+            //key is made of compute stage and descriptor set layouts of shader, push constant ranges, pipeline cache and specialization constants
+            static std::map<std::string, compute_pipeline_variant> compute_pipeline_variants;
+            static std::mutex compute_pipeline_variants_mutex;
+            static std::string pipeline_cache_directory;
+
+            //two shaders which have the same key will create identical compute pipelines, address of w_shader is not part of key because it may be reused after release
+            static std::string get_compute_pipeline_variant_key(
+                _In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+                _In_ const w_shader* pShaderBinding,
+                _In_ const w_specialization_info& pSpecializationInfo,
+                _In_ const std::string& pPipelineCacheName,
+                _In_ const std::vector<w_push_constant_range>& pPushConstantRanges)
+            {
+                auto _stage = pShaderBinding->get_compute_shader_stage();
+
+                std::ostringstream _key_stream;
+                _key_stream << (const void*)pGDevice->vk_device << "|" << 
+                    (const void*)_stage.module << ":" << (_stage.pName ? _stage.pName : "") << "|" <<
+                    (const void*)pShaderBinding->get_compute_descriptor_set_layout().handle;
+                for (auto& _iter : pShaderBinding->get_additional_descriptor_set_layouts())
+                {
+                    _key_stream << "," << (const void*)_iter.handle;
+                }
+                _key_stream << "|";
+                for (auto& _iter : pPushConstantRanges)
+                {
+                    _key_stream << _iter.stageFlags << ":" << _iter.offset << ":" << _iter.size << ";";
+                }
+                _key_stream << "|" << pPipelineCacheName << "|";
+
+                //empty specialization info means the specialization info of compute stage will be used
+                if (!pSpecializationInfo.empty() || !_stage.pSpecializationInfo)
+                {
+                    _key_stream << pSpecializationInfo.get_key();
+                }
+                else
+                {
+                    auto _info = _stage.pSpecializationInfo;
+                    for (uint32_t i = 0; i < _info->mapEntryCount; ++i)
+                    {
+                        auto _entry = &_info->pMapEntries[i];
+                        uint32_t _value = 0;
+                        std::memcpy(&_value, (const uint8_t*)_info->pData + _entry->offset, std::min(_entry->size, sizeof(uint32_t)));
+                        _key_stream << _entry->constantID << "=" << _value << ";";
+                    }
+                }
+                return _key_stream.str();
+            }
 
         private:
 
+            void _get_additional_descriptor_sets(
+                _In_ const w_shader* pShaderBinding,
+                _Inout_ std::vector<VkDescriptorSetLayout>& pDescriptorSetLayouts,
+                _Inout_ std::vector<VkDescriptorSet>& pDescriptorSets)
+            {
+                for (auto& _iter : pShaderBinding->get_additional_descriptor_set_layouts())
+                {
+                    pDescriptorSetLayouts.push_back(_iter.handle);
+                }
+                for (auto& _iter : pShaderBinding->get_additional_descriptor_sets())
+                {
+                    pDescriptorSets.push_back(_iter.handle);
+                }
+            }
+
             const VkPipelineLayoutCreateInfo _generate_pipeline_layout_create_info(
                 _In_ const w_vertex_binding_attributes& pVertexBindingAttributes,
                 _In_ const w_primitive_topology pPrimitiveTopology,
-                _In_ const VkDescriptorSetLayout* const pDescriptorSetLayoutBinding,
+                _In_ const std::vector<VkDescriptorSetLayout>& pDescriptorSetLayouts,
                 _In_ const std::vector<w_dynamic_state>& pDynamicStates,
                 _In_ const std::vector<w_push_constant_range>& pPushConstantRanges,
                 _Out_ VkPipelineVertexInputStateCreateInfo** pVertexInputStateCreateInfo,
@@ -399,34 +578,14 @@ namespace wolf
                 for (auto& _binding : pVertexBindingAttributes.binding_attributes)
                 {
                     uint32_t _stride = 0;
+                    VkFormat _format;
+                    uint32_t _size;
                     for (auto& _iter : _binding.second)
                     {
-						switch (_iter)
-						{
-						case w_vertex_attribute::W_FLOAT:
-						case w_vertex_attribute::W_TEXTURE_INDEX:
-						case w_vertex_attribute::W_SCALE:
-							_stride += 4;//floats
-							break;
-						case w_vertex_attribute::W_VEC2:
-						case w_vertex_attribute::W_UV:
-							_stride += 8;//floats
-							break;
-						case w_vertex_attribute::W_VEC3:
-						case w_vertex_attribute::W_POS:
-						case w_vertex_attribute::W_ROT:
-						case w_vertex_attribute::W_NORM:
-						case w_vertex_attribute::W_TANGENT:
-						case w_vertex_attribute::W_BINORMAL:
-							_stride += 12;//floats
-							break;
-						case w_vertex_attribute::W_VEC4:
-						case w_vertex_attribute::W_COLOR:
-						case w_vertex_attribute::W_BLEND_WEIGHT:
-						case w_vertex_attribute::W_BLEND_INDICES:
-							_stride += 16;//floats
-							break;
-						}
+                        if (_get_vertex_attribute_format(_iter, _format, _size))
+                        {
+                            _stride += _size;
+                        }
                     }
 
                     _vertex_binding_descriptions->push_back(
@@ -439,61 +598,21 @@ namespace wolf
                     uint32_t _offset = 0;
                     for (auto& _attr : _binding.second)
                     {
-                        switch (_attr)
+                        if (!_get_vertex_attribute_format(_attr, _format, _size))
                         {
-                        case w_vertex_attribute::W_FLOAT:
-						case w_vertex_attribute::W_TEXTURE_INDEX:
-						case w_vertex_attribute::W_SCALE:
-                            _vertex_attribute_descriptions->push_back(
-                            {
-                                _location_index,                                               // Location
-                                _vertex_binding_descriptions->at(_binding.first).binding,      // Binding
-                                VK_FORMAT_R32_SFLOAT,                                          // Format
-                                _offset                                                        // Offset
-                            });
-                            _offset += 4;//floats
-                            break;
-                        case w_vertex_attribute::W_VEC2:
-						case w_vertex_attribute::W_UV:
-                            _vertex_attribute_descriptions->push_back(
-                            {
-                                _location_index,                                               // Location
-                                _vertex_binding_descriptions->at(_binding.first).binding,      // Binding
-                                VK_FORMAT_R32G32_SFLOAT,                                       // Format
-                                _offset                                                        // Offset
-                            });
-                            _offset += 8;//floats
-                            break;
-                        case w_vertex_attribute::W_VEC3:
-						case w_vertex_attribute::W_POS:
-						case w_vertex_attribute::W_ROT:
-						case w_vertex_attribute::W_NORM:
-						case w_vertex_attribute::W_TANGENT:
-						case w_vertex_attribute::W_BINORMAL:
-                            _vertex_attribute_descriptions->push_back(
-                            {
-                                _location_index,                                               // Location
-                                _vertex_binding_descriptions->at(_binding.first).binding,      // Binding
-                                VK_FORMAT_R32G32B32_SFLOAT,                                    // Format
-                                _offset                                                        // Offset
-                            });
-                            _offset += 12;//floats
-                            break;
-                        case w_vertex_attribute::W_VEC4:
-						case w_vertex_attribute::W_COLOR:
-						case w_vertex_attribute::W_BLEND_WEIGHT:
-						case w_vertex_attribute::W_BLEND_INDICES:
-                            _vertex_attribute_descriptions->push_back(
-                            {
-                                _location_index,                                               // Location
-                                _vertex_binding_descriptions->at(_binding.first).binding,      // Binding
-                                VK_FORMAT_R32G32B32A32_SFLOAT,                                 // Format
-                                _offset                                                        // Offset
-                            });
-                            _offset += 16;//floats
-                            break;
+                            logger.error("unknown vertex attribute " + std::to_string(_attr) + " for pipeline: " + this->_name);
+                            continue;
                         }
 
+                        _vertex_attribute_descriptions->push_back(
+                        {
+                            _location_index,                                               // Location
+                            _vertex_binding_descriptions->at(_binding.first).binding,      // Binding
+                            _format,                                                       // Format
+                            _offset                                                        // Offset
+                        });
+                        _offset += _size;
+
                         _location_index++;
                     }
                 }
@@ -539,8 +658,8 @@ namespace wolf
                     VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,                                      // Type
                     nullptr,                                                                            // Next
                     0,                                                                                  // Flags
-                    static_cast<uint32_t>(pDescriptorSetLayoutBinding == nullptr ? 0 : 1),              // SetLayoutCount
-                    pDescriptorSetLayoutBinding == nullptr ? nullptr : pDescriptorSetLayoutBinding,     // SetLayouts
+                    static_cast<uint32_t>(pDescriptorSetLayouts.size()),                                // SetLayoutCount
+                    pDescriptorSetLayouts.size() ? pDescriptorSetLayouts.data() : nullptr,              // SetLayouts
                     _push_constant_range_count,                                                         // PushConstantRangeCount
                     _push_constant_range_count ? pPushConstantRanges.data() : nullptr                   // PushConstantRanges
                 };
@@ -548,6 +667,80 @@ namespace wolf
                 return _pipeline_layout_create_info;
             }
 
+            //get vulkan format and size in bytes of vertex attribute, returns false for unknown attribute
+            static bool _get_vertex_attribute_format(
+                _In_ const w_vertex_attribute& pAttribute,
+                _Out_ VkFormat& pFormat,
+                _Out_ uint32_t& pSize)
+            {
+                switch (pAttribute)
+                {
+                case w_vertex_attribute::W_FLOAT:
+                case w_vertex_attribute::W_TEXTURE_INDEX:
+                case w_vertex_attribute::W_SCALE:
+                    pFormat = VK_FORMAT_R32_SFLOAT;
+                    pSize = 4;//floats
+                    return true;
+                case w_vertex_attribute::W_VEC2:
+                case w_vertex_attribute::W_UV:
+                    pFormat = VK_FORMAT_R32G32_SFLOAT;
+                    pSize = 8;//floats
+                    return true;
+                case w_vertex_attribute::W_VEC3:
+                case w_vertex_attribute::W_POS:
+                case w_vertex_attribute::W_ROT:
+                case w_vertex_attribute::W_NORM:
+                case w_vertex_attribute::W_TANGENT:
+                case w_vertex_attribute::W_BINORMAL:
+                    pFormat = VK_FORMAT_R32G32B32_SFLOAT;
+                    pSize = 12;//floats
+                    return true;
+                case w_vertex_attribute::W_VEC4:
+                case w_vertex_attribute::W_COLOR:
+                case w_vertex_attribute::W_BLEND_WEIGHT:
+                case w_vertex_attribute::W_BLEND_INDICES:
+                    pFormat = VK_FORMAT_R32G32B32A32_SFLOAT;
+                    pSize = 16;//floats
+                    return true;
+                case w_vertex_attribute::W_HALF2:
+                case w_vertex_attribute::W_UV_HALF:
+                    pFormat = VK_FORMAT_R16G16_SFLOAT;
+                    pSize = 4;//half floats
+                    return true;
+                case w_vertex_attribute::W_HALF4:
+                    pFormat = VK_FORMAT_R16G16B16A16_SFLOAT;
+                    pSize = 8;//half floats
+                    return true;
+                case w_vertex_attribute::W_SNORM16_2:
+                case w_vertex_attribute::W_NORM_OCTAHEDRAL:
+                    pFormat = VK_FORMAT_R16G16_SNORM;
+                    pSize = 4;//shorts
+                    return true;
+                case w_vertex_attribute::W_SNORM16_4:
+                case w_vertex_attribute::W_POS_QUANTIZED:
+                    pFormat = VK_FORMAT_R16G16B16A16_SNORM;
+                    pSize = 8;//shorts
+                    return true;
+                case w_vertex_attribute::W_SNORM8_4:
+                case w_vertex_attribute::W_TANGENT_OCTAHEDRAL:
+                    pFormat = VK_FORMAT_R8G8B8A8_SNORM;
+                    pSize = 4;//bytes
+                    return true;
+                case w_vertex_attribute::W_UNORM8_4:
+                case w_vertex_attribute::W_COLOR_PACKED:
+                case w_vertex_attribute::W_BLEND_WEIGHT_PACKED:
+                    pFormat = VK_FORMAT_R8G8B8A8_UNORM;
+                    pSize = 4;//bytes
+                    return true;
+                case w_vertex_attribute::W_UINT8_4:
+                case w_vertex_attribute::W_BLEND_INDICES_PACKED:
+                    pFormat = VK_FORMAT_R8G8B8A8_UINT;
+                    pSize = 4;//bytes
+                    return true;
+                }
+                return false;
+            }
+
 
             std::string                                     _name;
             std::shared_ptr<w_graphics_device>              _gDevice;
@@ -555,13 +748,20 @@ namespace wolf
             VkPipelineLayout                                _pipeline_layout;
 			VkDescriptorSet									_shader_descriptor_set;
 			VkDescriptorSet									_compute_shader_descriptor_set;
+			//descriptor sets which will be bound for graphics and compute bind points
+			std::vector<VkDescriptorSet>					_descriptor_sets;
+			std::vector<VkDescriptorSet>					_compute_descriptor_sets;
         };
     }
 }
 
 using namespace wolf::graphics;
 
-std::map<std::string, VkPipelineCache> w_pipeline_pimp::pipeline_caches;
+std::map<std::string, w_pipeline_pimp::pipeline_cache> w_pipeline_pimp::pipeline_caches;
+std::mutex w_pipeline_pimp::pipeline_caches_mutex;
+std::map<std::string, w_pipeline_pimp::compute_pipeline_variant> w_pipeline_pimp::compute_pipeline_variants;
+std::mutex w_pipeline_pimp::compute_pipeline_variants_mutex;
+std::string w_pipeline_pimp::pipeline_cache_directory;
 
 w_pipeline::w_pipeline() : _pimp(new w_pipeline_pimp())
 {
@@ -618,12 +818,30 @@ W_EXP W_RESULT w_pipeline::load_compute(
 	_In_ const std::string& pPipelineCacheName,
 	_In_ const std::vector<w_push_constant_range> pPushConstantRanges)
 {
-	if (!this->_pimp) return W_FAILED;
+	w_specialization_info _specialization_info;
+	_specialization_info.add(0, pSpecializationData);
+
+	return load_compute(
+		pGDevice,
+		pShaderBinding,
+		_specialization_info,
+		pPipelineCacheName,
+		pPushConstantRanges);
+}
+
+W_EXP W_RESULT w_pipeline::load_compute(
+	_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_ const w_shader* pShaderBinding,
+	_In_ const w_specialization_info& pSpecializationInfo,
+	_In_ const std::string& pPipelineCacheName,
+	_In_ const std::vector<w_push_constant_range> pPushConstantRanges)
+{
+	if (!this->_pimp || !pShaderBinding) return W_FAILED;
 
 	return this->_pimp->load_compute(
 		pGDevice,
 		pShaderBinding,
-		pSpecializationData,
+		pSpecializationInfo,
 		pPipelineCacheName,
 		pPushConstantRanges);
 }
@@ -632,7 +850,25 @@ W_RESULT w_pipeline::bind(_In_ const w_command_buffer& pCommandBuffer,
 	_In_ const w_pipeline_bind_point& pPipelineBindPoint)
 {
     if (!this->_pimp) return W_FAILED;
-    this->_pimp->bind(pCommandBuffer, pPipelineBindPoint);
+    this->_pimp->bind(pCommandBuffer, pPipelineBindPoint, {});
+	return W_PASSED;
+}
+
+W_RESULT w_pipeline::bind(_In_ const w_command_buffer& pCommandBuffer,
+	_In_ const w_pipeline_bind_point& pPipelineBindPoint,
+	_In_ const std::vector<uint32_t>& pDynamicOffsets)
+{
+	if (!this->_pimp) return W_FAILED;
+	this->_pimp->bind(pCommandBuffer, pPipelineBindPoint, pDynamicOffsets);
+	return W_PASSED;
+}
+
+W_RESULT w_pipeline::bind_descriptor_set(_In_ const w_command_buffer& pCommandBuffer,
+	_In_ const w_pipeline_bind_point& pPipelineBindPoint,
+	_In_ const std::vector<uint32_t>& pDynamicOffsets)
+{
+	if (!this->_pimp) return W_FAILED;
+	this->_pimp->bind_descriptor_set(pCommandBuffer, pPipelineBindPoint, pDynamicOffsets);
 	return W_PASSED;
 }
 
@@ -702,12 +938,38 @@ W_RESULT w_pipeline::create_pipeline_cache(_In_ const std::shared_ptr<w_graphics
 	auto _old_pipline_cache = get_pipeline_cache(pPipelineCacheName);
 	if (_old_pipline_cache) return W_PASSED;
 	
+	//load the pipeline cache which has been saved by previous run
+	std::vector<uint8_t> _initial_data;
+	auto _path = w_pipeline_pimp::get_pipeline_cache_path(pGDevice, pPipelineCacheName);
+	std::ifstream _file(_path, std::ios::binary);
+	if (_file)
+	{
+		_initial_data.assign(std::istreambuf_iterator<char>(_file), std::istreambuf_iterator<char>());
+		_file.close();
+
+		if (!w_pipeline_pimp::validate_pipeline_cache_data(pGDevice, _initial_data))
+		{
+			logger.warning("pipeline cache file: " + _path + " is stale or corrupted and will be ignored");
+			_initial_data.clear();
+		}
+	}
 
-    VkPipelineCache _pipeline_cache;
+    VkPipelineCache _pipeline_cache = 0;
     VkPipelineCacheCreateInfo _pipeline_cache_create_info = {};
     _pipeline_cache_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    _pipeline_cache_create_info.initialDataSize = _initial_data.size();
+    _pipeline_cache_create_info.pInitialData = _initial_data.size() ? _initial_data.data() : nullptr;
     
     auto _hr = vkCreatePipelineCache(pGDevice->vk_device, &_pipeline_cache_create_info, nullptr, &_pipeline_cache);
+    if (_hr && _initial_data.size())
+    {
+        //driver rejected the data, fallback to an empty pipeline cache
+        logger.warning("driver rejected pipeline cache file: " + _path);
+        _initial_data.clear();
+        _pipeline_cache_create_info.initialDataSize = 0;
+        _pipeline_cache_create_info.pInitialData = nullptr;
+        _hr = vkCreatePipelineCache(pGDevice->vk_device, &_pipeline_cache_create_info, nullptr, &_pipeline_cache);
+    }
     if (_hr)
     {
         V(W_FAILED, "Error on creating pipeline cache with graphics device: " +
@@ -715,31 +977,220 @@ W_RESULT w_pipeline::create_pipeline_cache(_In_ const std::shared_ptr<w_graphics
         return W_FAILED;
     }
 
-    w_pipeline_pimp::pipeline_caches[pPipelineCacheName] = _pipeline_cache;
+    w_pipeline_pimp::pipeline_cache _item;
+    _item.handle = _pipeline_cache;
+    _item.device = pGDevice->vk_device;
+    _item.statistics.loaded_from_disk = _initial_data.size() != 0;
+    _item.statistics.initial_data_size = _initial_data.size();
+
+    std::lock_guard<std::mutex> _lock(w_pipeline_pimp::pipeline_caches_mutex);
+    w_pipeline_pimp::pipeline_caches[pPipelineCacheName] = _item;
     
     return W_PASSED;
 }
 
+W_RESULT w_pipeline::save_pipeline_cache(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_z_ const std::string& pPipelineCacheName)
+{
+	auto _pipeline_cache = get_pipeline_cache(pPipelineCacheName);
+	if (!_pipeline_cache) return W_FAILED;
+
+	return w_pipeline_pimp::write_pipeline_cache(pGDevice, pPipelineCacheName, _pipeline_cache);
+}
+
 VkPipelineCache w_pipeline::get_pipeline_cache(_In_z_ const std::string& pPipelineCacheName)
 {
+    std::lock_guard<std::mutex> _lock(w_pipeline_pimp::pipeline_caches_mutex);
     auto _iter = w_pipeline_pimp::pipeline_caches.find(pPipelineCacheName);
     if (_iter != w_pipeline_pimp::pipeline_caches.end())
     {
-        return _iter->second;
+        return _iter->second.handle;
     }
     return 0;
 }
 
+w_pipeline_cache_statistics w_pipeline::get_pipeline_cache_statistics(_In_z_ const std::string& pPipelineCacheName)
+{
+	std::lock_guard<std::mutex> _lock(w_pipeline_pimp::pipeline_caches_mutex);
+	auto _iter = w_pipeline_pimp::pipeline_caches.find(pPipelineCacheName);
+	if (_iter != w_pipeline_pimp::pipeline_caches.end())
+	{
+		return _iter->second.statistics;
+	}
+	return w_pipeline_cache_statistics();
+}
+
+const std::string w_pipeline::get_pipeline_cache_directory()
+{
+	std::string _directory = w_pipeline_pimp::pipeline_cache_directory;
+	if (_directory.empty())
+	{
+		_directory = wolf::system::io::get_current_directory();
+	}
+	if (!_directory.empty() && _directory.back() != '/' && _directory.back() != '\\')
+	{
+		_directory += "/";
+	}
+	return _directory;
+}
+
+void w_pipeline::set_pipeline_cache_directory(_In_z_ const std::string& pDirectory)
+{
+	w_pipeline_pimp::pipeline_cache_directory = pDirectory;
+}
+
 ULONG w_pipeline::release_all_pipeline_caches(_In_ const std::shared_ptr<w_graphics_device>& pGDevice)
 {
+	std::lock_guard<std::mutex> _lock(w_pipeline_pimp::pipeline_caches_mutex);
 	if (!w_pipeline_pimp::pipeline_caches.size()) return 0;
 
-	for (auto& _iter : w_pipeline_pimp::pipeline_caches)
+	auto _iter = w_pipeline_pimp::pipeline_caches.begin();
+	while (_iter != w_pipeline_pimp::pipeline_caches.end())
 	{
-		vkDestroyPipelineCache(pGDevice->vk_device, _iter.second, nullptr);
-		_iter.second = 0;
+		//pipeline cache belongs to another graphics device
+		if (_iter->second.device != pGDevice->vk_device)
+		{
+			_iter++;
+			continue;
+		}
+
+		//report the time of pipeline creation, compare cold start with warm start
+		auto _statistics = &_iter->second.statistics;
+		logger.write("pipeline cache: " + _iter->first +
+			(_statistics->loaded_from_disk ? " (warm start, " + std::to_string(_statistics->initial_data_size) + " bytes loaded)" : " (cold start)") +
+			", created " + std::to_string(_statistics->number_of_pipelines) + " pipeline(s) in " +
+			std::to_string(_statistics->pipelines_creation_time_in_ms) + " ms");
+
+		//store it for the next run
+		if (w_pipeline_pimp::write_pipeline_cache(pGDevice, _iter->first, _iter->second.handle) == W_FAILED)
+		{
+			logger.warning("could not save pipeline cache: " + _iter->first);
+		}
+
+		vkDestroyPipelineCache(pGDevice->vk_device, _iter->second.handle, nullptr);
+		_iter = w_pipeline_pimp::pipeline_caches.erase(_iter);
 	}
-	w_pipeline_pimp::pipeline_caches.clear();
 
 	return 1;
 }
+
+w_pipeline* w_pipeline::get_compute_pipeline_variant(
+	_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_ const w_shader* pShaderBinding,
+	_In_ const w_specialization_info& pSpecializationInfo,
+	_In_ const std::string& pPipelineCacheName,
+	_In_ const std::vector<w_push_constant_range> pPushConstantRanges)
+{
+	if (!pGDevice || !pShaderBinding) return nullptr;
+
+	auto _key = w_pipeline_pimp::get_compute_pipeline_variant_key(
+		pGDevice,
+		pShaderBinding,
+		pSpecializationInfo,
+		pPipelineCacheName,
+		pPushConstantRanges);
+
+	std::lock_guard<std::mutex> _lock(w_pipeline_pimp::compute_pipeline_variants_mutex);
+	auto _iter = w_pipeline_pimp::compute_pipeline_variants.find(_key);
+	if (_iter != w_pipeline_pimp::compute_pipeline_variants.end())
+	{
+		return _iter->second.pipeline;
+	}
+
+	auto _pipeline = new (std::nothrow) w_pipeline();
+	if (!_pipeline)
+	{
+		logger.error("could not allocate memory for compute pipeline variant: " + _key);
+		return nullptr;
+	}
+	if (_pipeline->load_compute(
+		pGDevice,
+		pShaderBinding,
+		pSpecializationInfo,
+		pPipelineCacheName,
+		pPushConstantRanges) == W_FAILED)
+	{
+		logger.error("could not create compute pipeline variant: " + _key);
+		SAFE_RELEASE(_pipeline);
+		return nullptr;
+	}
+
+	w_pipeline_pimp::compute_pipeline_variant _variant;
+	_variant.device = pGDevice->vk_device;
+	_variant.shader = pShaderBinding;
+	_variant.pipeline = _pipeline;
+	w_pipeline_pimp::compute_pipeline_variants[_key] = _variant;
+
+	return _pipeline;
+}
+
+ULONG w_pipeline::release_compute_pipeline_variants(_In_ const w_shader* pShaderBinding)
+{
+	std::lock_guard<std::mutex> _lock(w_pipeline_pimp::compute_pipeline_variants_mutex);
+	auto _iter = w_pipeline_pimp::compute_pipeline_variants.begin();
+	while (_iter != w_pipeline_pimp::compute_pipeline_variants.end())
+	{
+		if (_iter->second.shader != pShaderBinding)
+		{
+			_iter++;
+			continue;
+		}
+		SAFE_RELEASE(_iter->second.pipeline);
+		_iter = w_pipeline_pimp::compute_pipeline_variants.erase(_iter);
+	}
+	return 1;
+}
+
+ULONG w_pipeline::release_all_compute_pipeline_variants(_In_ const std::shared_ptr<w_graphics_device>& pGDevice)
+{
+	std::lock_guard<std::mutex> _lock(w_pipeline_pimp::compute_pipeline_variants_mutex);
+	auto _iter = w_pipeline_pimp::compute_pipeline_variants.begin();
+	while (_iter != w_pipeline_pimp::compute_pipeline_variants.end())
+	{
+		//variant belongs to another graphics device
+		if (_iter->second.device != pGDevice->vk_device)
+		{
+			_iter++;
+			continue;
+		}
+		SAFE_RELEASE(_iter->second.pipeline);
+		_iter = w_pipeline_pimp::compute_pipeline_variants.erase(_iter);
+	}
+	return 1;
+}
+
+uint32_t w_pipeline::get_preferred_compute_local_size(_In_ const std::shared_ptr<w_graphics_device>& pGDevice)
+{
+	const uint32_t _default_local_size = 64;
+	if (!pGDevice || !pGDevice->device_info || !pGDevice->device_info->device_properties) return _default_local_size;
+
+	auto _properties = pGDevice->device_info->device_properties;
+
+	//wavefront size of vendors
+	uint32_t _local_size;
+	switch (_properties->vendorID)
+	{
+	default:
+		_local_size = _default_local_size;
+		break;
+	case 0x1002://AMD
+		_local_size = 64;
+		break;
+	case 0x10DE://NVIDIA
+		_local_size = 32;
+		break;
+	case 0x8086://Intel
+		_local_size = 32;
+		break;
+	case 0x13B5://ARM
+		_local_size = 16;
+		break;
+	}
+
+	//clamp to limits of device
+	auto _limits = &_properties->limits;
+	_local_size = std::min(_local_size, _limits->maxComputeWorkGroupSize[0]);
+	_local_size = std::min(_local_size, _limits->maxComputeWorkGroupInvocations);
+
+	return _local_size ? _local_size : 1;
+}
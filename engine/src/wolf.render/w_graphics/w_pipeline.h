@@ -18,6 +18,18 @@ namespace wolf
 {
 	namespace graphics
 	{
+		struct w_pipeline_cache_statistics
+		{
+			//true means the pipeline cache has been created from the data of previous run
+			bool		loaded_from_disk = false;
+			//size of data which has been loaded from disk
+			size_t		initial_data_size = 0;
+			//number of pipelines which have been created with this pipeline cache
+			uint32_t	number_of_pipelines = 0;
+			//total time of creating pipelines with this pipeline cache in milliseconds
+			double		pipelines_creation_time_in_ms = 0;
+		};
+
         class w_pipeline_pimp;
 		class w_pipeline : public system::w_object
 		{
@@ -42,18 +54,39 @@ namespace wolf
 				_In_ const w_pipeline_color_blend_attachment_state& pBlendState = w_graphics_device::defaults_states::blend_states::premulitplied_alpha,
 				_In_ const w_color& pBlendColors = w_color::TRANSPARENT_());
 
-            //load pipeline for compute stage
+            //load pipeline for compute stage, pSpecializationData will be used as specialization constant with constant_id 0
             W_EXP W_RESULT load_compute(
                 _In_ const std::shared_ptr<w_graphics_device>& pGDevice,
 				_In_ const w_shader* pShaderBinding,
                 _In_ const uint32_t& pSpecializationData,
                 _In_ const std::string& pPipelineCacheName = "compute_pipeline_cache",
                 _In_ const std::vector<w_push_constant_range> pPushConstantRanges = {});
+
+			/*
+				load pipeline for compute stage with specialization constants, one SPIR-V can be used for all variants
+				@param pSpecializationInfo, if empty, specialization info of compute stage of shader will be used
+			*/
+			W_EXP W_RESULT load_compute(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const w_shader* pShaderBinding,
+				_In_ const w_specialization_info& pSpecializationInfo,
+				_In_ const std::string& pPipelineCacheName = "compute_pipeline_cache",
+				_In_ const std::vector<w_push_constant_range> pPushConstantRanges = {});
 			
 			//bind to pipeline
             W_EXP W_RESULT bind(_In_ const w_command_buffer& pCommandBuffer, 
 				_In_ const w_pipeline_bind_point& pPipelineBindPoint);
 
+			//bind to pipeline, pDynamicOffsets contains one offset for each dynamic uniform or storage buffer of shader in order of binding numbers
+			W_EXP W_RESULT bind(_In_ const w_command_buffer& pCommandBuffer,
+				_In_ const w_pipeline_bind_point& pPipelineBindPoint,
+				_In_ const std::vector<uint32_t>& pDynamicOffsets);
+
+			//only bind descriptor set of shader with new dynamic offsets, use it between draws of the same pipeline
+			W_EXP W_RESULT bind_descriptor_set(_In_ const w_command_buffer& pCommandBuffer,
+				_In_ const w_pipeline_bind_point& pPipelineBindPoint,
+				_In_ const std::vector<uint32_t>& pDynamicOffsets);
+
             //release all resources
             W_EXP virtual ULONG release() override;
             
@@ -78,13 +111,46 @@ namespace wolf
 
             W_EXP static VkPipelineLayout create_pipeline_layout(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
                 _In_ const VkPipelineLayoutCreateInfo* const pPipelineLayoutCreateInfo);
-			//create pipeline cache
+			/*
+				create pipeline cache, the data which has been saved by previous run will be loaded from pipeline cache directory.
+				The file is keyed by vendor ID, device ID and driver version and stale data will be ignored
+			*/
             W_EXP static W_RESULT create_pipeline_cache(_In_ const std::shared_ptr<w_graphics_device>& pGDevice, 
                 _In_z_ const std::string& pPipelineCacheName);            
+			//save data of pipeline cache to pipeline cache directory
+			W_EXP static W_RESULT save_pipeline_cache(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_z_ const std::string& pPipelineCacheName);
             W_EXP static VkPipelineCache get_pipeline_cache(_In_z_ const std::string& pPipelineCacheName);
-            //release all pipeline caches
+			//get number of pipelines and time of creating them with pipeline cache
+			W_EXP static w_pipeline_cache_statistics get_pipeline_cache_statistics(_In_z_ const std::string& pPipelineCacheName);
+			//get directory of pipeline cache files, default is current directory
+			W_EXP static const std::string get_pipeline_cache_directory();
+			//set directory of pipeline cache files
+			W_EXP static void set_pipeline_cache_directory(_In_z_ const std::string& pDirectory);
+            //save and release all pipeline caches
             W_EXP static ULONG release_all_pipeline_caches(_In_ const std::shared_ptr<w_graphics_device>& pGDevice);
 
+			/*
+				get compute pipeline variant of shader, variants are cached by compute stage and descriptor set layouts of shader, push constant ranges,
+				pipeline cache and specialization constants, so each variant will be created once. Returned pipeline is owned by cache, do not release it.
+				Variants of shader will be released with the shader
+			*/
+			W_EXP static w_pipeline* get_compute_pipeline_variant(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const w_shader* pShaderBinding,
+				_In_ const w_specialization_info& pSpecializationInfo,
+				_In_ const std::string& pPipelineCacheName = "compute_pipeline_cache",
+				_In_ const std::vector<w_push_constant_range> pPushConstantRanges = {});
+			//release all cached compute pipeline variants which belong to shader
+			W_EXP static ULONG release_compute_pipeline_variants(_In_ const w_shader* pShaderBinding);
+			//release all cached compute pipeline variants of graphics device
+			W_EXP static ULONG release_all_compute_pipeline_variants(_In_ const std::shared_ptr<w_graphics_device>& pGDevice);
+			/*
+				get preferred local size of one dimensional compute shaders for graphics device, use it as specialization constant of local_size_x_id.
+				It is the wavefront size of vendor, clamped to limits of device
+			*/
+			W_EXP static uint32_t get_preferred_compute_local_size(_In_ const std::shared_ptr<w_graphics_device>& pGDevice);
+
 #ifdef __PYTHON__
 
 			W_RESULT py_load(
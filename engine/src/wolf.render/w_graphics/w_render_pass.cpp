@@ -237,8 +237,12 @@ namespace wolf
 
 				auto _cmd = pCommandBuffer.handle;
 				vkCmdBeginRenderPass(_cmd, &_render_pass_begin_info, pSubpassContents);
-				vkCmdSetViewport(_cmd, 0, 1, &this->_viewport);
-				vkCmdSetScissor(_cmd, 0, 1, &this->_viewport_scissor);
+				//commands of secondary command buffers can not be recorded inside this render pass, so they must set their own dynamic states
+				if (pSubpassContents == VK_SUBPASS_CONTENTS_INLINE)
+				{
+					vkCmdSetViewport(_cmd, 0, 1, &this->_viewport);
+					vkCmdSetScissor(_cmd, 0, 1, &this->_viewport_scissor);
+				}
 			}
 
 			void end(_In_ const w_command_buffer pCommandBuffer)
@@ -287,6 +291,11 @@ namespace wolf
 				return this->_frame_buffers.size();
 			}
 
+			const VkFramebuffer get_frame_buffer_handle(_In_ const size_t& pIndex) const
+			{
+				return pIndex < this->_frame_buffers.size() ? this->_frame_buffers[pIndex] : 0;
+			}
+
 			const bool get_depth_stencil_enabled() const
 			{
 				return this->_depth_stencil_enabled;
@@ -411,6 +420,12 @@ const size_t w_render_pass::get_number_of_frame_buffers() const
     return this->_pimp->get_number_of_frame_buffers();
 }
 
+const VkFramebuffer w_render_pass::get_frame_buffer_handle(_In_ const size_t& pIndex) const
+{
+    if (!this->_pimp) return 0;
+    return this->_pimp->get_frame_buffer_handle(pIndex);
+}
+
 const bool w_render_pass::get_depth_stencil_enabled() const
 {
 	return this->_pimp ? this->_pimp->get_depth_stencil_enabled() : false;
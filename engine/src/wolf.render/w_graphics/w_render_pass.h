@@ -55,6 +55,7 @@ namespace wolf
             W_EXP w_viewport get_viewport() const;
             W_EXP w_viewport_scissor get_viewport_scissor() const;
             W_EXP const size_t get_number_of_frame_buffers() const;
+            W_EXP const VkFramebuffer get_frame_buffer_handle(_In_ const size_t& pIndex) const;
 			W_EXP const bool get_depth_stencil_enabled() const;
 
 #pragma endregion
@@ -133,25 +133,51 @@ namespace wolf
 				W_RESULT _hr = W_PASSED;
 				for (uint32_t i = 0; i < _cmd_size; ++i)
 				{
-					pCommandBuffers->begin(i);
+					if (record_command_buffer_at(pCommandBuffers, i, pDrawFunction, pClearColor, pClearDepth, pClearStencil) == W_FAILED)
 					{
-						auto _cmd = pCommandBuffers->get_command_at(i);
-						this->_render_pass.begin(
-                            i,
-							_cmd,
-							pClearColor,
-							pClearDepth,
-							pClearStencil);
+						_hr = W_FAILED;
+					}
+				}
+				return _hr;
+			}
+
+			W_RESULT record_command_buffer_at(
+				_In_ wolf::graphics::w_command_buffers* pCommandBuffers,
+				_In_ const uint32_t& pIndex,
+				_In_ std::function<W_RESULT(void)> pDrawFunction,
+				_In_ w_color pClearColor,
+				_In_ const float& pClearDepth,
+				_In_ const uint32_t&  pClearStencil)
+			{
+				const std::string _trace_info = this->_name + "::record_command_buffer_at";
+
+				if (!pCommandBuffers) return W_FAILED;
+				if (pIndex >= pCommandBuffers->get_commands_size() || pIndex >= this->_render_pass.get_number_of_frame_buffers())
+				{
+					V(W_FAILED, "index of command buffer is out of range", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				W_RESULT _hr = W_PASSED;
+				pCommandBuffers->begin(pIndex);
+				{
+					auto _cmd = pCommandBuffers->get_command_at(pIndex);
+					this->_render_pass.begin(
+						pIndex,
+						_cmd,
+						pClearColor,
+						pClearDepth,
+						pClearStencil);
+					{
+						if (pDrawFunction)
 						{
-							if (pDrawFunction)
-							{
-								_hr = pDrawFunction();
-							}
+							_hr = pDrawFunction();
 						}
-						this->_render_pass.end(_cmd);
 					}
-					pCommandBuffers->end(i);
+					this->_render_pass.end(_cmd);
 				}
+				pCommandBuffers->end(pIndex);
+
 				return _hr;
 			}
             
@@ -301,6 +327,24 @@ W_RESULT w_render_target::record_command_buffer(
 		pClearStencil);
 }
 
+W_RESULT w_render_target::record_command_buffer_at(
+	_In_ w_command_buffers* pCommandBuffer,
+	_In_ const uint32_t& pIndex,
+	_In_ std::function<W_RESULT(void)> pDrawFunction,
+	_In_ w_color pClearColor,
+	_In_ const float& pClearDepth,
+	_In_ const uint32_t&  pClearStencil)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->record_command_buffer_at(
+		pCommandBuffer,
+		pIndex,
+		pDrawFunction,
+		pClearColor,
+		pClearDepth,
+		pClearStencil);
+}
+
 //W_RESULT w_render_target::save_to_file(_In_z_ const char* pFilename)
 //{
 ////    short header[] = { 0x4D42, 0, 0, 0, 0, 26, 0, 12, 0, (short)pWidth, (short)pHeight, 1, 24 };
@@ -38,6 +38,14 @@ namespace wolf
 				_In_ const float& pClearDepth = 1.0f, 
 				_In_ const uint32_t&  pClearStencil = 0);
 
+			//record only one command buffer, the previous submission of this command buffer must be completed by GPU
+			W_EXP W_RESULT record_command_buffer_at(_In_ w_command_buffers* pCommandBuffer,
+				_In_ const uint32_t& pIndex,
+				_In_ std::function<W_RESULT(void)> pDrawFunction,
+				_In_ w_color pClearColor = w_color::PURPLE(),
+				_In_ const float& pClearDepth = 1.0f,
+				_In_ const uint32_t&  pClearStencil = 0);
+
             //save texture as bitmap file
            // W_EXP W_RESULT save_to_file(_In_z_ const char* pFileName);
 
@@ -1,5 +1,6 @@
 #include "w_render_pch.h"
 #include "w_shader.h"
+#include "w_pipeline.h"
 #include <w_io.h>
 #include <w_convert.h>
 #include <w_logger.h>
@@ -122,6 +123,11 @@ namespace wolf
             {
                 this->_shader_stages.clear();
                 this->_shader_binding_params.clear();
+                this->_vk_specializations.clear();
+                this->_specializations.clear();
+                //additional descriptor sets are owned by their creators
+                this->_additional_descriptor_sets.clear();
+                this->_additional_descriptor_set_layouts.clear();
 
                 for (size_t i = 0; i < this->_shader_modules.size(); ++i)
                 {
@@ -167,6 +173,55 @@ namespace wolf
                 return 0;
             }
             
+            W_RESULT add_descriptor_set(
+                _In_ const w_descriptor_set_layout& pDescriptorSetLayout,
+                _In_ const w_descriptor_set& pDescriptorSet)
+            {
+                if (!pDescriptorSetLayout.handle || !pDescriptorSet.handle)
+                {
+                    V(W_FAILED, "adding invalid descriptor set", this->_name, 3, false);
+                    return W_FAILED;
+                }
+                this->_additional_descriptor_set_layouts.push_back(pDescriptorSetLayout);
+                this->_additional_descriptor_sets.push_back(pDescriptorSet);
+                return W_PASSED;
+            }
+
+            W_RESULT set_specialization_info(
+                _In_ const w_shader_stage_flag_bits& pShaderStage,
+                _In_ const w_specialization_info& pSpecializationInfo)
+            {
+                w_pipeline_shader_stage_create_info* _stage = nullptr;
+                if (pShaderStage == w_shader_stage_flag_bits::COMPUTE_SHADER)
+                {
+                    if (this->_compute_shader_stage.module) _stage = &this->_compute_shader_stage;
+                }
+                else
+                {
+                    for (auto& _iter : this->_shader_stages)
+                    {
+                        if (_iter.stage == (VkShaderStageFlagBits)pShaderStage)
+                        {
+                            _stage = &_iter;
+                            break;
+                        }
+                    }
+                }
+                if (!_stage)
+                {
+                    V(W_FAILED, "setting specialization info for a shader stage which has not been loaded", this->_name, 3, false);
+                    return W_FAILED;
+                }
+
+                //copies are stored in maps, so pointers of stage remain valid until releasing shader
+                auto _key = static_cast<uint32_t>(pShaderStage);
+                this->_specializations[_key] = pSpecializationInfo;
+                this->_vk_specializations[_key] = this->_specializations[_key].get_vk_info();
+                _stage->pSpecializationInfo = pSpecializationInfo.empty() ? nullptr : &this->_vk_specializations[_key];
+
+                return W_PASSED;
+            }
+
 #pragma region Getters
 
             const std::vector<w_pipeline_shader_stage_create_info>* get_shader_stages() const
@@ -204,6 +259,16 @@ namespace wolf
                 return this->_shader_binding_params;
             }
 
+            const std::vector<w_descriptor_set> get_additional_descriptor_sets() const
+            {
+                return this->_additional_descriptor_sets;
+            }
+
+            const std::vector<w_descriptor_set_layout> get_additional_descriptor_set_layouts() const
+            {
+                return this->_additional_descriptor_set_layouts;
+            }
+
 #pragma endregion
 
         private:
@@ -293,6 +358,27 @@ namespace wolf
                     });
                 }
                 break;
+                case w_shader_binding_type::UNIFORM_DYNAMIC:
+                case w_shader_binding_type::STORAGE_DYNAMIC:
+                {
+                    //range of buffer info is the size of each sub allocation, offset will be passed at bind time
+                    pWriteDescriptorSets.push_back(
+                    {
+                        VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,         // Type
+                        nullptr,                                        // Next
+                        pDescriptoSet,                                  // DstSet
+                        pBindingParam.index,                            // DstBinding
+                        0,                                              // DstArrayElement
+                        1,                                              // DescriptorCount
+                        pBindingParam.type == w_shader_binding_type::UNIFORM_DYNAMIC ?
+                        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC :
+                        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,      // DescriptorType
+                        nullptr,                                        // ImageInfo
+                        &pBindingParam.buffer_info,                     // BufferInfo
+                        nullptr                                         // TexelBufferView
+                    });
+                }
+                break;
                 case w_shader_binding_type::SAMPLER2D:
                 {
                     pWriteDescriptorSets.push_back(
@@ -382,6 +468,8 @@ namespace wolf
                 _In_    const w_shader_binding_param& pParam,
                 _Inout_ uint32_t& pNumberOfUniforms,
                 _Inout_ uint32_t& pNumberOfStorages,
+                _Inout_ uint32_t& pNumberOfDynamicUniforms,
+                _Inout_ uint32_t& pNumberOfDynamicStorages,
                 _Inout_ uint32_t& pNumberOfSampler2Ds,
 				_Inout_ uint32_t& pNumberOfSamplers,
 				_Inout_ uint32_t& pNumberOfImages,
@@ -415,6 +503,32 @@ namespace wolf
                     });
                 }
                 break;
+                case w_shader_binding_type::UNIFORM_DYNAMIC:
+                {
+                    pNumberOfDynamicUniforms++;
+                    pDescriptorSetLayoutBindings.push_back(
+                    {
+                        pParam.index,                                       // Binding
+                        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,          // DescriptorType
+                        1,                                                  // DescriptorCount
+                        (VkShaderStageFlags)pParam.stage,                   // StageFlags
+                        nullptr                                             // ImmutableSamplers
+                    });
+                }
+                break;
+                case w_shader_binding_type::STORAGE_DYNAMIC:
+                {
+                    pNumberOfDynamicStorages++;
+                    pDescriptorSetLayoutBindings.push_back(
+                    {
+                        pParam.index,                                       // Binding
+                        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,          // DescriptorType
+                        1,                                                  // DescriptorCount
+                        (VkShaderStageFlags)pParam.stage,                   // StageFlags
+                        nullptr                                             // ImmutableSamplers
+                    });
+                }
+                break;
                 case w_shader_binding_type::SAMPLER2D:
                 {
 					pNumberOfSampler2Ds++;
@@ -521,6 +635,8 @@ namespace wolf
 
                 uint32_t _number_of_uniforms = 0;
                 uint32_t _number_of_storages = 0;
+                uint32_t _number_of_dynamic_uniforms = 0;
+                uint32_t _number_of_dynamic_storages = 0;
                 uint32_t _number_of_sampler2ds = 0;
 				uint32_t _number_of_images = 0;
 				uint32_t _number_of_samplers = 0;
@@ -536,6 +652,8 @@ namespace wolf
                             _iter,
                             _number_of_uniforms,
                             _number_of_storages,
+                            _number_of_dynamic_uniforms,
+                            _number_of_dynamic_storages,
                             _number_of_sampler2ds,
 							_number_of_samplers,
 							_number_of_images,
@@ -547,6 +665,8 @@ namespace wolf
                             _iter,
 							_number_of_uniforms,
 							_number_of_storages,
+							_number_of_dynamic_uniforms,
+							_number_of_dynamic_storages,
 							_number_of_sampler2ds,
 							_number_of_samplers,
 							_number_of_images,
@@ -571,6 +691,22 @@ namespace wolf
                         _number_of_storages                                 // DescriptorCount
                     });
                 }
+                if (_number_of_dynamic_uniforms)
+                {
+                    _descriptor_pool_sizes.push_back(
+                    {
+                        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,          // Type
+                        _number_of_dynamic_uniforms                         // DescriptorCount
+                    });
+                }
+                if (_number_of_dynamic_storages)
+                {
+                    _descriptor_pool_sizes.push_back(
+                    {
+                        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,          // Type
+                        _number_of_dynamic_storages                         // DescriptorCount
+                    });
+                }
                 if (_number_of_sampler2ds)
                 {
                     _descriptor_pool_sizes.push_back(
@@ -651,6 +787,11 @@ namespace wolf
 			w_descriptor_set                                        _compute_descriptor_set;
             std::vector<w_shader_binding_param>                     _shader_binding_params;
 			char*													_entry_point_name;
+            //specialization constants of each stage
+            std::map<uint32_t, w_specialization_info>               _specializations;
+            std::map<uint32_t, VkSpecializationInfo>                _vk_specializations;
+            std::vector<w_descriptor_set>                           _additional_descriptor_sets;
+            std::vector<w_descriptor_set_layout>                    _additional_descriptor_set_layouts;
         };
     }
 }
@@ -687,6 +828,9 @@ ULONG w_shader::release()
 {
     if (_super::get_is_released()) return 1;
  
+    //compute pipeline variants of this shader can not be used anymore
+    w_pipeline::release_compute_pipeline_variants(this);
+
     //release the private implementation
     SAFE_RELEASE(this->_pimp);
     
@@ -742,6 +886,18 @@ const std::vector<w_shader_binding_param> w_shader::get_shader_binding_params()
     return this->_pimp->get_shader_binding_params();
 }
 
+const std::vector<w_descriptor_set> w_shader::get_additional_descriptor_sets() const
+{
+    if (!this->_pimp) return {};
+    return this->_pimp->get_additional_descriptor_sets();
+}
+
+const std::vector<w_descriptor_set_layout> w_shader::get_additional_descriptor_set_layouts() const
+{
+    if (!this->_pimp) return {};
+    return this->_pimp->get_additional_descriptor_set_layouts();
+}
+
 #pragma endregion
 
 #pragma region Setters
@@ -752,6 +908,22 @@ W_RESULT w_shader::set_shader_binding_params(_In_ std::vector<w_shader_binding_p
     return this->_pimp->set_shader_binding_params(pShaderBindingParams);
 }
 
+W_RESULT w_shader::set_specialization_info(
+	_In_ const w_shader_stage_flag_bits& pShaderStage,
+	_In_ const w_specialization_info& pSpecializationInfo)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->set_specialization_info(pShaderStage, pSpecializationInfo);
+}
+
+W_RESULT w_shader::add_descriptor_set(
+	_In_ const w_descriptor_set_layout& pDescriptorSetLayout,
+	_In_ const w_descriptor_set& pDescriptorSet)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->add_descriptor_set(pDescriptorSetLayout, pDescriptorSet);
+}
+
 #pragma endregion
 
 W_RESULT w_shader::load_shader(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
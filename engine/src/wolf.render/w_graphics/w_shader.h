@@ -28,7 +28,10 @@ namespace wolf
 			SAMPLER,
 			UNIFORM,
 			IMAGE,
-			STORAGE
+			STORAGE,
+			//uniform and storage buffers which will be bound with dynamic offsets, i.e. sub allocations of w_uniform_ring
+			UNIFORM_DYNAMIC,
+			STORAGE_DYNAMIC
 		};
 
 		struct w_pipeline_shader_stage_create_info : public
@@ -38,6 +41,64 @@ namespace wolf
 		{
 		};
 
+#ifdef __VULKAN__
+		/*
+			constants of a shader stage which will be specialized at pipeline creation time, so one SPIR-V module can be used
+			for different workgroup sizes, lod levels and feature toggles. i.e. layout (local_size_x_id = 0) in; or
+			layout (constant_id = 1) const uint MAX_LOD_LEVEL = 2;
+		*/
+		struct w_specialization_info
+		{
+			//add a 32 bit constant, use VkBool32 for bool constants
+			template<typename T>
+			void add(_In_ const uint32_t& pConstantID, _In_ const T& pValue)
+			{
+				static_assert(sizeof(T) == sizeof(uint32_t), "specialization constant must be 32 bit");
+
+				VkSpecializationMapEntry _entry;
+				_entry.constantID = pConstantID;
+				_entry.offset = static_cast<uint32_t>(this->data.size());
+				_entry.size = sizeof(T);
+				this->map_entries.push_back(_entry);
+
+				auto _bytes = reinterpret_cast<const uint8_t*>(&pValue);
+				this->data.insert(this->data.end(), _bytes, _bytes + sizeof(T));
+			}
+
+			//pipelines which have been created from the same shader and the same key are identical
+			std::string get_key() const
+			{
+				std::string _key;
+				for (auto& _entry : this->map_entries)
+				{
+					uint32_t _value = 0;
+					std::memcpy(&_value, this->data.data() + _entry.offset, sizeof(uint32_t));
+					_key += std::to_string(_entry.constantID) + "=" + std::to_string(_value) + ";";
+				}
+				return _key;
+			}
+
+			//returned structure points to members of this object, so it must be alive until creating pipeline
+			VkSpecializationInfo get_vk_info() const
+			{
+				VkSpecializationInfo _info;
+				_info.mapEntryCount = static_cast<uint32_t>(this->map_entries.size());
+				_info.pMapEntries = this->map_entries.size() ? this->map_entries.data() : nullptr;
+				_info.dataSize = this->data.size();
+				_info.pData = this->data.size() ? this->data.data() : nullptr;
+				return _info;
+			}
+
+			bool empty() const
+			{
+				return this->map_entries.empty();
+			}
+
+			std::vector<VkSpecializationMapEntry>	map_entries;
+			std::vector<uint8_t>					data;
+		};
+#endif
+
 		struct w_shader_binding_param
 		{
 			//index of shader variable
@@ -80,12 +141,30 @@ namespace wolf
             W_EXP const w_descriptor_set_layout get_descriptor_set_layout() const;
             W_EXP const w_descriptor_set_layout get_compute_descriptor_set_layout() const;
 
+			//descriptor sets which are not owned by shader, they will be bound after descriptor set of shader
+			W_EXP const std::vector<w_descriptor_set> get_additional_descriptor_sets() const;
+			W_EXP const std::vector<w_descriptor_set_layout> get_additional_descriptor_set_layouts() const;
+
 #pragma endregion
 
 #pragma region Setters
             
 			//set and update shader binding params
             W_EXP W_RESULT set_shader_binding_params(_In_ std::vector<w_shader_binding_param> pShaderBindingParams);
+#ifdef __VULKAN__
+			//set specialization constants of a loaded shader stage, they will be used by all pipelines which will be created from this shader
+			W_EXP W_RESULT set_specialization_info(
+				_In_ const w_shader_stage_flag_bits& pShaderStage,
+				_In_ const w_specialization_info& pSpecializationInfo);
+#endif
+			/*
+				add a descriptor set which is not owned by shader, i.e. descriptor set of w_bindless_texture_table.
+				Additional descriptor sets will be bound at set 1, 2, ... so shader must have its own descriptor set at set 0.
+				Add them before creating pipelines
+			*/
+			W_EXP W_RESULT add_descriptor_set(
+				_In_ const w_descriptor_set_layout& pDescriptorSetLayout,
+				_In_ const w_descriptor_set& pDescriptorSet);
 
 #pragma endregion
 
@@ -123,7 +123,8 @@ namespace wolf
 				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
 				_In_ const wolf::graphics::w_render_pass& pRenderPass,
 				_In_ const wolf::graphics::w_viewport& pViewport,
-				_In_ const wolf::graphics::w_viewport_scissor& pViewportScissor)
+				_In_ const wolf::graphics::w_viewport_scissor& pViewportScissor,
+				_In_ const uint32_t& pNumberOfFrames)
 			{
 				const std::string _trace_info = this->_name + "::load";
 
@@ -192,8 +193,8 @@ namespace wolf
 					return W_FAILED;
 				}
 
-				//load vertex shader uniform
-				_hr = this->_u0.load(_gDevice);
+				//load vertex shader uniform, one region for each frame in flight
+				_hr = this->_u0.load(_gDevice, false, pNumberOfFrames);
 				if (_hr == W_FAILED)
 				{
 					release();
@@ -211,7 +212,7 @@ namespace wolf
 
 				w_shader_binding_param _shader_param;
 				_shader_param.index = 0;
-				_shader_param.type = w_shader_binding_type::UNIFORM;
+				_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 				_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
 				_shader_param.buffer_info = this->_u0.get_descriptor_info();
 				_shader_params.push_back(_shader_param);
@@ -255,13 +256,13 @@ namespace wolf
 				return set_color(this->_color);
 			}
 
-			W_RESULT update(_In_ const glm::mat4& pWorldViewProjection)
+			W_RESULT update(_In_ const glm::mat4& pWorldViewProjection, _In_ const uint32_t& pFrameIndex)
 			{
 				const std::string _trace_info = this->_name + "::update";
 
-				//we must update uniform
+				//we must update uniform of this frame
 				this->_u0.data.wvp = pWorldViewProjection;
-				auto _hr = this->_u0.update();
+				auto _hr = this->_u0.update_at(pFrameIndex);
 				if (_hr == W_FAILED)
 				{
 					V(W_FAILED, "updating uniform WorldViewProjection", _trace_info, 3, false);
@@ -291,11 +292,11 @@ namespace wolf
 				return W_PASSED;
 			}
 
-			W_RESULT draw(_In_ const w_command_buffer& pCommandBuffer)
+			W_RESULT draw(_In_ const w_command_buffer& pCommandBuffer, _In_ const uint32_t& pFrameIndex)
 			{
 				const std::string _trace_info = this->_name + "::draw";
 
-				this->_pipeline.bind(pCommandBuffer, w_pipeline_bind_point::GRAPHICS);
+				this->_pipeline.bind(pCommandBuffer, w_pipeline_bind_point::GRAPHICS, { this->_u0.get_dynamic_offset_at(pFrameIndex) });
 
 				if (this->_shape_drawer.draw(pCommandBuffer, nullptr, 0) == W_FAILED)
 				{
@@ -940,20 +941,21 @@ w_shapes::~w_shapes()
 W_RESULT w_shapes::load(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
 	_In_ const w_render_pass& pRenderPass,
 	_In_ const w_viewport& pViewport,
-	_In_ const w_viewport_scissor& pViewportScissor)
+	_In_ const w_viewport_scissor& pViewportScissor,
+	_In_ const uint32_t& pNumberOfFrames)
 {
-	return (!this->_pimp) ? W_FAILED : this->_pimp->load(pGDevice, pRenderPass, pViewport, pViewportScissor);
+	return (!this->_pimp) ? W_FAILED : this->_pimp->load(pGDevice, pRenderPass, pViewport, pViewportScissor, pNumberOfFrames);
 }
 
-W_RESULT w_shapes::update(_In_ const glm::mat4& pWorldViewProjection)
+W_RESULT w_shapes::update(_In_ const glm::mat4& pWorldViewProjection, _In_ const uint32_t& pFrameIndex)
 {
-	return (!this->_pimp) ? W_FAILED : this->_pimp->update(pWorldViewProjection);
+	return (!this->_pimp) ? W_FAILED : this->_pimp->update(pWorldViewProjection, pFrameIndex);
 }
 
-W_RESULT w_shapes::draw(_In_ const w_command_buffer& pCommandBuffer)
+W_RESULT w_shapes::draw(_In_ const w_command_buffer& pCommandBuffer, _In_ const uint32_t& pFrameIndex)
 {
 	if (!this->_pimp) return W_FAILED;
-	return this->_pimp->draw(pCommandBuffer);
+	return this->_pimp->draw(pCommandBuffer, pFrameIndex);
 }
 
 ULONG w_shapes::release()
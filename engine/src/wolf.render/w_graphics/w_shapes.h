@@ -68,18 +68,19 @@ namespace wolf
 			//destructor of w_shapes
 			W_EXP virtual ~w_shapes();
 
-			//load shapes render
+			//load shapes render, pNumberOfFrames is number of frames in flight which keep their own WorldViewProjection
 			W_EXP W_RESULT load(
 				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
 				_In_ const w_render_pass& pRenderPass,
 				_In_ const w_viewport& pViewport,
-				_In_ const w_viewport_scissor& pViewportScissor);
+				_In_ const w_viewport_scissor& pViewportScissor,
+				_In_ const uint32_t& pNumberOfFrames = 1);
 
-			//update uniform of shape
-			W_EXP W_RESULT update(_In_ const glm::mat4& pWorldViewProjection);
+			//update uniform of shape for a frame, the previous submission of this frame must be completed by GPU
+			W_EXP W_RESULT update(_In_ const glm::mat4& pWorldViewProjection, _In_ const uint32_t& pFrameIndex = 0);
 
-            //draw shape
-            W_EXP W_RESULT draw(_In_ const w_command_buffer& pCommandBuffer);
+            //draw shape with uniform of a frame
+            W_EXP W_RESULT draw(_In_ const w_command_buffer& pCommandBuffer, _In_ const uint32_t& pFrameIndex = 0);
             
 			W_EXP ULONG release();
 
@@ -135,6 +136,12 @@ namespace wolf
 				return update(pWorldViewProjection.data());
 			}
 
+			//draw shape
+			W_RESULT py_draw(_In_ const w_command_buffer& pCommandBuffer)
+			{
+				return draw(pCommandBuffer);
+			}
+
 #endif
 
 		private:
@@ -4,6 +4,8 @@
 #include <w_io.h>
 #include "w_buffer.h"
 #include "w_command_buffers.h"
+#include "w_memory_allocator.h"
+#include "w_upload_manager.h"
 #include <map>
 
 #include <gli/gli.hpp>
@@ -17,6 +19,46 @@ namespace wolf
 {
     namespace graphics
     {
+		//decoded image of texture file, it does not own any gpu resources
+		struct w_texture_decoded_data
+		{
+			w_texture_decoded_data() :
+				width(0),
+				height(0),
+				layer_count(1),
+				format(w_format::R8G8B8A8_UNORM),
+				rgba(nullptr),
+				gli_texture_2D_array(nullptr)
+			{
+			}
+
+			~w_texture_decoded_data()
+			{
+				if (this->rgba)
+				{
+					stbi_image_free(this->rgba);
+					this->rgba = nullptr;
+				}
+				SAFE_DELETE(this->gli_texture_2D_array);
+			}
+
+			std::wstring				path;
+			std::wstring				texture_name;
+			uint32_t					width;
+			uint32_t					height;
+			uint32_t					layer_count;
+			w_format					format;
+			//rgba pixels which have been decoded with stbi
+			uint8_t*					rgba;
+			//for dds and ktx
+			gli::texture2d_array*		gli_texture_2D_array;
+
+		private:
+			//prevent copying
+			w_texture_decoded_data(w_texture_decoded_data const&);
+			w_texture_decoded_data& operator= (w_texture_decoded_data const&);
+		};
+
         class w_texture_pimp
         {
         public:
@@ -32,7 +74,8 @@ namespace wolf
 				_image_type(w_image_type::_2D_TYPE),
 				_image_view_type(w_image_view_type::_2D),
 				_buffer_type(VkImageAspectFlagBits::VK_IMAGE_ASPECT_COLOR_BIT),
-				_image_layout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
+				_image_layout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL),
+				_upload_ticket(0)
 			{
 				this->_image_view.attachment_desc.desc.format = VkFormat::VK_FORMAT_R8G8B8A8_UNORM;
 			}
@@ -76,8 +119,8 @@ namespace wolf
 				//bind to memory
 				if (vkBindImageMemory(this->_gDevice->vk_device,
 					this->_image_view.image,
-					this->_memory.handle,
-					0))
+					this->_allocation.memory.handle,
+					this->_allocation.offset))
 				{
 					V(W_FAILED, "binding VkImage for graphics device: " + this->_gDevice->device_info->get_device_name() +
 						" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()), this->_name, 3, false);
@@ -94,17 +137,33 @@ namespace wolf
 			}
 
 			W_RESULT load_texture_2D_from_file(_In_z_ std::wstring pPath, _In_ bool pIsAbsolutePath)
+			{
+				w_texture_decoded_data _decoded;
+				auto _hr = decode_texture_2D_from_file(pPath, pIsAbsolutePath, _decoded);
+				if (_hr == W_FAILED) return W_FAILED;
+
+				return load_texture_2D_from_decoded_data(_decoded);
+			}
+
+			//read and decode texture file, this function does not touch gpu resources, so it can be called from any thread
+			static W_RESULT decode_texture_2D_from_file(
+				_In_z_ std::wstring pPath, 
+				_In_ bool pIsAbsolutePath,
+				_Inout_ w_texture_decoded_data& pDecoded)
 			{
 				using namespace std;
 				using namespace system::io;
 
+				const char* _trace_info = "w_texture";
+
 				std::wstring _path = pPath;
 				if (!pIsAbsolutePath)
 				{
 					_path = content_path + pPath;
 				}
 				auto _ext = get_file_extentionW(_path.c_str());
-				this->_texture_name = get_base_file_nameW(_path.c_str()) + L"." + _ext;
+				pDecoded.path = _path;
+				pDecoded.texture_name = get_base_file_nameW(_path.c_str()) + L"." + _ext;
 
 #if defined(__WIN32) || defined(__UWP)
 				std::wstring _str = _path;
@@ -115,7 +174,7 @@ namespace wolf
 				if (W_FAILED == system::io::get_is_file(_str.c_str()))
 				{
 					wstring msg = L"could not find the texture file: ";
-					V(W_FAILED, msg + _path, this->_name, 3);
+					V(W_FAILED, msg + _path, _trace_info, 3);
 					return W_FAILED;
 				}
 
@@ -127,11 +186,6 @@ namespace wolf
 				_g_path = _str;
 #endif
 
-				//ptr to rgba data
-				uint8_t* _rgba = nullptr;
-				//for dds and ktx
-				gli::texture2d_array* _gli_tex_2D_array = nullptr;
-
 				//lower it
 				std::transform(_ext.begin(), _ext.end(), _ext.begin(), ::tolower);
 
@@ -158,12 +212,12 @@ namespace wolf
 #endif
 					if (_gli_tex.size())
 					{
-						_gli_tex_2D_array = new gli::texture2d_array(_gli_tex);
+						pDecoded.gli_texture_2D_array = new gli::texture2d_array(_gli_tex);
 
-						this->_image_view.width = _gli_tex_2D_array->extent().x;
-						this->_image_view.height = _gli_tex_2D_array->extent().y;
-						this->_layer_count = (uint32_t)_gli_tex_2D_array->layers();
-						this->_image_view.attachment_desc.desc.format = (VkFormat)_gli_format_to_wolf_format(_gli_tex_2D_array->format());
+						pDecoded.width = pDecoded.gli_texture_2D_array->extent().x;
+						pDecoded.height = pDecoded.gli_texture_2D_array->extent().y;
+						pDecoded.layer_count = (uint32_t)pDecoded.gli_texture_2D_array->layers();
+						pDecoded.format = _gli_format_to_wolf_format(pDecoded.gli_texture_2D_array->format());
 					}
 
 					_g_path.clear();
@@ -172,13 +226,13 @@ namespace wolf
 				{
 					//we re loading file with stbi header
 
-					int __width, __height, __comp;
+					int __width = 0, __height = 0, __comp = 0;
 
-					_rgba = stbi_load(_g_path.c_str(), &__width, &__height, &__comp, STBI_rgb_alpha);
+					pDecoded.rgba = stbi_load(_g_path.c_str(), &__width, &__height, &__comp, STBI_rgb_alpha);
 
-					this->_image_view.width = __width;
-					this->_image_view.height = __height;
-					this->_layer_count = 1;
+					pDecoded.width = __width;
+					pDecoded.height = __height;
+					pDecoded.layer_count = 1;
 
 					_g_path.clear();
 				}
@@ -188,15 +242,49 @@ namespace wolf
 					return W_FAILED;
 				}
 				
-				if (this->_image_view.width == 0 || this->_image_view.height == 0)
+				if (pDecoded.width == 0 || pDecoded.height == 0)
 				{
 					wstring msg = L"Width or Height of texture file is zero: ";
-					V(W_FAILED, msg + _path, this->_name, 3);
-					if (_rgba)
+					V(W_FAILED, msg + _path, _trace_info, 3);
+					return W_FAILED;
+				}
+
+				if (!pDecoded.rgba && !pDecoded.gli_texture_2D_array)
+				{
+					wstring msg = L"texture file is corrupted: ";
+					V(W_FAILED, msg + _path, _trace_info, 3);
+					return W_FAILED;
+				}
+
+				return W_PASSED;
+			}
+
+			//create texture from decoded data, this function must be called from the thread which owns graphics device
+			W_RESULT load_texture_2D_from_decoded_data(_In_ const w_texture_decoded_data& pDecoded)
+			{
+				using namespace std;
+
+				this->_texture_name = pDecoded.texture_name;
+				this->_image_view.width = pDecoded.width;
+				this->_image_view.height = pDecoded.height;
+				this->_layer_count = pDecoded.layer_count;
+				if (pDecoded.gli_texture_2D_array)
+				{
+					this->_image_view.attachment_desc.desc.format = (VkFormat)pDecoded.format;
+
+					//levels of cooked files will be uploaded as they are, block compressed formats can not be blitted
+					auto _levels = static_cast<uint32_t>(pDecoded.gli_texture_2D_array->levels());
+					if (_levels > 1)
 					{
-						free(_rgba);
-						_rgba = nullptr;
+						this->_generate_mip_maps = false;
+						this->_mip_map_levels = _levels;
 					}
+				}
+
+				if (this->_image_view.width == 0 || this->_image_view.height == 0)
+				{
+					wstring msg = L"Width or Height of texture file is zero: ";
+					V(W_FAILED, msg + pDecoded.path, this->_name, 3);
 					release();
 					return W_FAILED;
 				}
@@ -204,11 +292,6 @@ namespace wolf
 				auto _hr = _create_image();
 				if (_hr == W_FAILED)
 				{
-					if (_rgba)
-					{
-						free(_rgba);
-						_rgba = nullptr;
-					}
 					release();
 					return W_FAILED;
 				}
@@ -216,11 +299,6 @@ namespace wolf
 				_hr = _allocate_memory();
 				if (_hr == W_FAILED)
 				{
-					if (_rgba)
-					{
-						free(_rgba);
-						_rgba = nullptr;
-					}
 					release();
 					return W_FAILED;
 				}
@@ -228,8 +306,8 @@ namespace wolf
 				//bind to memory
 				if (vkBindImageMemory(this->_gDevice->vk_device,
 					this->_image_view.image,
-					this->_memory.handle,
-					0))
+					this->_allocation.memory.handle,
+					this->_allocation.offset))
 				{
 					V(W_FAILED, "binding VkImage for graphics device: " + this->_gDevice->device_info->get_device_name() +
 						" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()), this->_name, 3, false);
@@ -237,23 +315,20 @@ namespace wolf
 				}
 
 				//copy data to texture
-				if (_rgba)
+				if (pDecoded.rgba)
 				{
-					_hr = copy_data_to_texture_2D(_rgba);
+					_hr = copy_data_to_texture_2D(pDecoded.rgba);
 					if (_hr == W_FAILED) return W_FAILED;
-
-					free(_rgba);
 				}
-				else if (_gli_tex_2D_array)
+				else if (pDecoded.gli_texture_2D_array)
 				{
-					_hr = copy_data_to_texture_2D_array(*_gli_tex_2D_array);
+					_hr = copy_data_to_texture_2D_array(*pDecoded.gli_texture_2D_array);
 					if (_hr == W_FAILED) return W_FAILED;
-					SAFE_DELETE(_gli_tex_2D_array);
 				}
 				else
 				{
 					wstring msg = L"texture file is corrupted: ";
-					V(W_FAILED, msg + _path, this->_name, 3);
+					V(W_FAILED, msg + pDecoded.path, this->_name, 3);
 					release();
 					return W_FAILED;
 				}
@@ -267,6 +342,268 @@ namespace wolf
 				return W_PASSED;
 			}
 
+			//create texture from resident levels of mip chain, this function must be called from the thread which owns graphics device
+			W_RESULT load_texture_2D_from_mip_chain(
+				_In_ const w_texture_mip_chain& pMipChain,
+				_In_ const uint32_t& pBaseLevel,
+				_In_opt_ w_texture_pimp* pResidentTexture)
+			{
+				const std::string _trace_info = this->_name + "::load_texture_2D_from_mip_chain";
+
+				if (pBaseLevel >= pMipChain.levels.size())
+				{
+					V(W_FAILED, "base level of mip chain is out of range", _trace_info, 3, false);
+					return W_FAILED;
+				}
+				//levels are copied on transfer queue, so loading does not wait for GPU
+				if (!this->_gDevice || !this->_gDevice->upload_manager)
+				{
+					V(W_FAILED, "upload manager of graphics device is required for loading texture from mip chain", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				auto _base_level = &pMipChain.levels[pBaseLevel];
+
+				this->_texture_name = L"texture_from_mip_chain";
+				this->_image_view.width = _base_level->width;
+				this->_image_view.height = _base_level->height;
+				this->_image_view.attachment_desc.desc.format = (VkFormat)pMipChain.format;
+				this->_layer_count = 1;
+				this->_generate_mip_maps = false;
+				this->_mip_map_levels = static_cast<uint32_t>(pMipChain.levels.size()) - pBaseLevel;
+				//the next texture of this mip chain may copy resident levels from this one
+				this->_usage_flags |= w_image_usage_flag_bits::IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+				//levels from _copy_level to the smallest one are resident in pResidentTexture, so they will be copied on GPU
+				uint32_t _copy_level = this->_mip_map_levels;
+				uint32_t _resident_base_level = 0;
+				if (pResidentTexture &&
+					pResidentTexture->_image_view.image &&
+					(pResidentTexture->_usage_flags & w_image_usage_flag_bits::IMAGE_USAGE_TRANSFER_SRC_BIT) &&
+					pResidentTexture->_mip_map_levels &&
+					pResidentTexture->_mip_map_levels <= pMipChain.levels.size())
+				{
+					_resident_base_level = static_cast<uint32_t>(pMipChain.levels.size()) - pResidentTexture->_mip_map_levels;
+					auto _resident_level = &pMipChain.levels[_resident_base_level];
+					if (pResidentTexture->_image_view.width == _resident_level->width &&
+						pResidentTexture->_image_view.height == _resident_level->height &&
+						pResidentTexture->_image_view.attachment_desc.desc.format == this->_image_view.attachment_desc.desc.format)
+					{
+						_copy_level = _resident_base_level > pBaseLevel ? _resident_base_level - pBaseLevel : 0;
+					}
+				}
+
+				auto _hr = _create_image();
+				if (_hr == W_FAILED) return W_FAILED;
+
+				_hr = _allocate_memory();
+				if (_hr == W_FAILED) return W_FAILED;
+
+				//bind to memory
+				if (vkBindImageMemory(this->_gDevice->vk_device,
+					this->_image_view.image,
+					this->_allocation.memory.handle,
+					this->_allocation.offset))
+				{
+					V(W_FAILED, "binding VkImage for graphics device: " + this->_gDevice->device_info->get_device_name() +
+						" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()), this->_name, 3, false);
+					return W_FAILED;
+				}
+
+				if (_copy_level)
+				{
+					//levels which are not resident are contiguous, so all of them are copied with one upload
+					std::vector<VkBufferImageCopy> _buffer_copy_regions;
+					for (uint32_t i = 0; i < _copy_level; ++i)
+					{
+						auto _level = &pMipChain.levels[pBaseLevel + i];
+
+						VkBufferImageCopy _buffer_image_copy_info = {};
+						_buffer_image_copy_info.bufferOffset = _level->offset - _base_level->offset;
+						_buffer_image_copy_info.imageSubresource = { this->_buffer_type, i, 0, 1 };
+						_buffer_image_copy_info.imageExtent = { _level->width, _level->height, 1 };
+						_buffer_copy_regions.push_back(_buffer_image_copy_info);
+					}
+
+					const VkImageSubresourceRange _image_subresource_range =
+					{
+						this->_buffer_type,								// AspectMask
+						0,                                              // BaseMipLevel
+						_copy_level,                                    // LevelCount
+						0,                                              // BaseArrayLayer
+						1                                               // LayerCount
+					};
+
+					auto _size = _copy_level == this->_mip_map_levels ?
+						pMipChain.get_size(pBaseLevel) :
+						pMipChain.levels[pBaseLevel + _copy_level].offset - _base_level->offset;
+
+					_hr = _upload(
+						pMipChain.data.data() + _base_level->offset,
+						_size,
+						_image_subresource_range,
+						_buffer_copy_regions,
+						this->_image_layout,
+						_trace_info);
+					if (_hr == W_FAILED) return W_FAILED;
+				}
+
+				if (_copy_level < this->_mip_map_levels)
+				{
+					std::vector<VkImageCopy> _image_copy_regions;
+					for (uint32_t i = _copy_level; i < this->_mip_map_levels; ++i)
+					{
+						auto _level = &pMipChain.levels[pBaseLevel + i];
+
+						VkImageCopy _image_copy_info = {};
+						_image_copy_info.srcSubresource = { this->_buffer_type, pBaseLevel + i - _resident_base_level, 0, 1 };
+						_image_copy_info.dstSubresource = { this->_buffer_type, i, 0, 1 };
+						_image_copy_info.extent = { _level->width, _level->height, 1 };
+						_image_copy_regions.push_back(_image_copy_info);
+					}
+
+					const VkImageSubresourceRange _src_subresource_range =
+					{
+						this->_buffer_type,								// AspectMask
+						pBaseLevel + _copy_level - _resident_base_level,// BaseMipLevel
+						this->_mip_map_levels - _copy_level,            // LevelCount
+						0,                                              // BaseArrayLayer
+						1                                               // LayerCount
+					};
+					const VkImageSubresourceRange _dst_subresource_range =
+					{
+						this->_buffer_type,								// AspectMask
+						_copy_level,                                    // BaseMipLevel
+						this->_mip_map_levels - _copy_level,            // LevelCount
+						0,                                              // BaseArrayLayer
+						1                                               // LayerCount
+					};
+
+					if (this->_gDevice->upload_manager->copy_image(
+						pResidentTexture->_image_view.image,
+						pResidentTexture->_image_layout,
+						_src_subresource_range,
+						this->_image_view.image,
+						_dst_subresource_range,
+						_image_copy_regions,
+						this->_image_layout,
+						&this->_upload_ticket) == W_FAILED)
+					{
+						V(W_FAILED, "copying resident levels of texture on graphics device: " +
+							this->_gDevice->device_info->get_device_name() + " ID: " + std::to_string(this->_gDevice->device_info->get_device_id()),
+							_trace_info,
+							3,
+							false);
+						return W_FAILED;
+					}
+					//resident texture is the source of copy, so releasing it must wait for this batch
+					pResidentTexture->_upload_ticket = this->_upload_ticket;
+				}
+
+				_hr = _create_sampler();
+				if (_hr == W_FAILED) return W_FAILED;
+
+				return _create_image_view();
+			}
+
+			//decode all levels of texture file, this function does not touch gpu resources, so it can be called from any thread
+			static W_RESULT decode_mip_chain_from_file(
+				_In_z_ const std::wstring& pPath,
+				_In_ const bool& pIsAbsolutePath,
+				_Inout_ w_texture_mip_chain& pMipChain)
+			{
+				w_texture_decoded_data _decoded;
+				auto _hr = decode_texture_2D_from_file(pPath, pIsAbsolutePath, _decoded);
+				if (_hr == W_FAILED) return W_FAILED;
+
+				pMipChain.levels.clear();
+				pMipChain.data.clear();
+
+				if (_decoded.gli_texture_2D_array)
+				{
+					//levels have been generated offline, only the first layer will be used
+					auto _gli = _decoded.gli_texture_2D_array;
+					pMipChain.format = _decoded.format;
+
+					size_t _size = 0;
+					for (size_t i = 0; i < _gli->levels(); ++i)
+					{
+						_size += (*_gli)[0][i].size();
+					}
+					pMipChain.data.resize(_size);
+
+					uint64_t _offset = 0;
+					for (size_t i = 0; i < _gli->levels(); ++i)
+					{
+						auto _gli_level = (*_gli)[0][i];
+
+						w_texture_mip_level _level;
+						_level.width = static_cast<uint32_t>(_gli_level.extent().x);
+						_level.height = static_cast<uint32_t>(_gli_level.extent().y);
+						_level.offset = _offset;
+						_level.size = _gli_level.size();
+						std::memcpy(pMipChain.data.data() + _offset, _gli_level.data(), _gli_level.size());
+
+						pMipChain.levels.push_back(_level);
+						_offset += _level.size;
+					}
+					return W_PASSED;
+				}
+
+				//generate levels of rgba image with 2x2 box filter
+				pMipChain.format = w_format::R8G8B8A8_UNORM;
+
+				auto _width = _decoded.width;
+				auto _height = _decoded.height;
+				uint64_t _size = 0;
+				while (true)
+				{
+					w_texture_mip_level _level;
+					_level.width = _width;
+					_level.height = _height;
+					_level.offset = _size;
+					_level.size = static_cast<uint64_t>(_width) * _height * 4;
+					pMipChain.levels.push_back(_level);
+
+					_size += _level.size;
+					if (_width == 1 && _height == 1) break;
+					_width = std::max<uint32_t>(1, _width / 2);
+					_height = std::max<uint32_t>(1, _height / 2);
+				}
+				pMipChain.data.resize(_size);
+				std::memcpy(pMipChain.data.data(), _decoded.rgba, pMipChain.levels[0].size);
+
+				for (size_t i = 1; i < pMipChain.levels.size(); ++i)
+				{
+					auto _src_level = &pMipChain.levels[i - 1];
+					auto _dst_level = &pMipChain.levels[i];
+					auto _src = pMipChain.data.data() + _src_level->offset;
+					auto _dst = pMipChain.data.data() + _dst_level->offset;
+
+					for (uint32_t y = 0; y < _dst_level->height; ++y)
+					{
+						auto _y0 = std::min(y * 2, _src_level->height - 1);
+						auto _y1 = std::min(y * 2 + 1, _src_level->height - 1);
+						for (uint32_t x = 0; x < _dst_level->width; ++x)
+						{
+							auto _x0 = std::min(x * 2, _src_level->width - 1);
+							auto _x1 = std::min(x * 2 + 1, _src_level->width - 1);
+							for (uint32_t c = 0; c < 4; ++c)
+							{
+								uint32_t _sum =
+									_src[(_y0 * _src_level->width + _x0) * 4 + c] +
+									_src[(_y0 * _src_level->width + _x1) * 4 + c] +
+									_src[(_y1 * _src_level->width + _x0) * 4 + c] +
+									_src[(_y1 * _src_level->width + _x1) * 4 + c];
+								_dst[(y * _dst_level->width + x) * 4 + c] = static_cast<uint8_t>((_sum + 2) / 4);
+							}
+						}
+					}
+				}
+
+				return W_PASSED;
+			}
+
             W_RESULT load_texture_from_memory_rgba(_In_ uint8_t* pRGBAData)
             {
 				this->_texture_name = L"texture_from_memory_rgba";
@@ -280,8 +617,8 @@ namespace wolf
                 //bind to memory
 				if (vkBindImageMemory(this->_gDevice->vk_device,
 					this->_image_view.image,
-					this->_memory.handle,
-					0))
+					this->_allocation.memory.handle,
+					this->_allocation.offset))
 				{
 					V(W_FAILED, "binding VkImage for graphics device: " + this->_gDevice->device_info->get_device_name() +
 						" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()), this->_name, 3, false);
@@ -357,10 +694,17 @@ namespace wolf
             
 			W_RESULT _allocate_memory()
 			{
+				if (!this->_gDevice->memory_allocator)
+				{
+					V(W_FAILED, "memory allocator of graphics device: " + this->_gDevice->device_info->get_device_name() +
+						" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()) + " is not available", this->_name, 3, false);
+					return W_FAILED;
+				}
+
 				//release the old one
-				if (this->_memory.handle)
+				if (this->_allocation.memory.handle)
 				{
-					vkFreeMemory(this->_gDevice->vk_device, this->_memory.handle, nullptr);
+					this->_gDevice->memory_allocator->free(this->_allocation);
 				}
 
 				VkMemoryRequirements _image_memory_requirements;
@@ -369,33 +713,12 @@ namespace wolf
 					this->_image_view.image,
 					&_image_memory_requirements);
 
-				VkPhysicalDeviceMemoryProperties _memory_properties;
-				vkGetPhysicalDeviceMemoryProperties(this->_gDevice->vk_physical_device, &_memory_properties);
-
-				uint32_t _mem_index = 0;
-				if (w_graphics_device_manager::memory_type_from_properties(
-					_memory_properties,
-					_image_memory_requirements.memoryTypeBits,
-					(VkMemoryPropertyFlags)this->_memory_property_flags,
-					&_mem_index))
-				{
-					V(W_FAILED, "finding memory index of Image for graphics device: " + this->_gDevice->device_info->get_device_name() +
-						" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()), this->_name, 3, false);
-					return W_FAILED;
-				}
-
-				const VkMemoryAllocateInfo _memory_allocate_info =
-				{
-					VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,     // Type
-					nullptr,                                    // Next
-					_image_memory_requirements.size,            // AllocationSize
-					_mem_index                                  // MemoryTypeIndex
-				};
-
-				if (vkAllocateMemory(this->_gDevice->vk_device,
-					&_memory_allocate_info,
-					nullptr,
-					&this->_memory.handle))
+				//sub allocate from memory blocks of graphics device, images do not share blocks with buffers
+				if (this->_gDevice->memory_allocator->allocate(
+						_image_memory_requirements,
+						this->_memory_property_flags,
+						true,
+						this->_allocation) == W_FAILED)
 				{
 					V(W_FAILED, "allocating memory for Image for graphics device: " + this->_gDevice->device_info->get_device_name() +
 						" ID: " + std::to_string(this->_gDevice->device_info->get_device_id()), this->_name, 3, false);
@@ -543,7 +866,7 @@ namespace wolf
 				return W_PASSED;
 			}
             
-			w_format _gli_format_to_wolf_format(_In_ gli::format pFormat)
+			static w_format _gli_format_to_wolf_format(_In_ gli::format pFormat)
 			{
 				//direct map to vulkan formats
 				return (w_format)pFormat;
@@ -573,6 +896,42 @@ namespace wolf
 
                 auto _data_size = this->_image_view.width * this->_image_view.height * 4;
 
+                if (_use_upload_manager())
+                {
+                    const VkImageSubresourceRange _image_subresource_range =
+                    {
+                        this->_buffer_type,								// AspectMask
+                        0,                                              // BaseMipLevel
+                        1,                                              // LevelCount
+                        0,                                              // BaseArrayLayer
+                        this->_layer_count                              // LayerCount
+                    };
+                    const VkBufferImageCopy _buffer_image_copy_info =
+                    {
+                        0,                                    // BufferOffset
+                        0,                                    // BufferRowLength
+                        0,                                    // BufferImageHeight
+                        {                                     // ImageSubresource
+                            this->_buffer_type,				  // AspectMask
+                            0,                                // MipLevel
+                            0,                                // BaseArrayLayer
+                            this->_layer_count                // LayerCount
+                        },
+                        {                                     // ImageOffset
+                            0,                                // X
+                            0,                                // Y
+                            0                                 // Z
+                        },
+                        {                                     // ImageExtent
+                            this->_image_view.width,          // Width
+                            this->_image_view.height,         // Height
+                            1                                 // Depth
+                        }
+                    };
+                    return _upload(pRGBA, _data_size, _image_subresource_range, { _buffer_image_copy_info },
+                        VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, _trace_info);
+                }
+
                 auto _hResult = this->_staging_buffer.load_as_staging(this->_gDevice, _data_size);
                 if (_hResult == W_FAILED)
                 {
@@ -585,14 +944,8 @@ namespace wolf
                     return _hResult;
                 }
 
-				auto _mem_handle = this->_staging_buffer.get_memory().handle;
-                if(vkMapMemory(
-					this->_gDevice->vk_device,
-					_mem_handle,
-                    0,
-                    _data_size,
-                    0,
-                    &this->_staging_buffer_memory_pointer))
+                this->_staging_buffer_memory_pointer = this->_staging_buffer.map();
+                if (!this->_staging_buffer_memory_pointer)
                 {
                     V(W_FAILED, "Could not map memory and upload texture data to a staging buffer on graphics device: " +
                         this->_gDevice->device_info->get_device_name() + " ID: " + std::to_string(this->_gDevice->device_info->get_device_id()),
@@ -604,20 +957,8 @@ namespace wolf
 
                 memcpy(this->_staging_buffer_memory_pointer, pRGBA, (size_t)_data_size);
 
-                VkMappedMemoryRange _flush_range =
-                {
-                    VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,              // Type
-                    nullptr,                                            // Next
-					_mem_handle,										// Memory
-                    0,                                                  // Offset
-                    _data_size                                          // Size
-                };
-
-                vkFlushMappedMemoryRanges(
-					this->_gDevice->vk_device,
-                    1,
-                    &_flush_range);
-                vkUnmapMemory(this->_gDevice->vk_device, _mem_handle);
+                this->_staging_buffer.flush(_data_size);
+                this->_staging_buffer.unmap();
 
 
                 //create command buffer
@@ -759,6 +1100,43 @@ namespace wolf
 
 				auto _data_size = static_cast<uint32_t>(pTextureArrayRGBA.size());
 
+				//each layer stores all of its levels, copy the levels which have been allocated for image
+				auto _levels = std::min(static_cast<uint32_t>(pTextureArrayRGBA.levels()), this->_mip_map_levels);
+				auto _base = static_cast<const uint8_t*>(pTextureArrayRGBA.data());
+				std::vector<VkBufferImageCopy> _buffer_copy_regions;
+				for (uint32_t i = 0; i < this->_layer_count; ++i)
+				{
+					for (uint32_t j = 0; j < _levels; ++j)
+					{
+						auto _image = pTextureArrayRGBA[i][j];
+
+						VkBufferImageCopy _buffer_image_copy_info = {};
+						_buffer_image_copy_info.bufferOffset = static_cast<VkDeviceSize>(static_cast<const uint8_t*>(_image.data()) - _base);
+						_buffer_image_copy_info.imageSubresource = { this->_buffer_type, j, i, 1 };
+						_buffer_image_copy_info.imageExtent =
+						{
+							static_cast<uint32_t>(_image.extent().x),
+							static_cast<uint32_t>(_image.extent().y),
+							1
+						};
+						_buffer_copy_regions.push_back(_buffer_image_copy_info);
+					}
+				}
+
+				if (_use_upload_manager())
+				{
+					const VkImageSubresourceRange _image_subresource_range =
+					{
+						this->_buffer_type,								// AspectMask
+						0,                                              // BaseMipLevel
+						_levels,                                        // LevelCount
+						0,                                              // BaseArrayLayer
+						this->_layer_count                              // LayerCount
+					};
+					return _upload(pTextureArrayRGBA.data(), _data_size, _image_subresource_range, _buffer_copy_regions,
+						this->_image_layout, _trace_info);
+				}
+
 				auto _hResult = this->_staging_buffer.load_as_staging(this->_gDevice, _data_size);
 				if (_hResult == W_FAILED)
 				{
@@ -771,13 +1149,8 @@ namespace wolf
 					return _hResult;
 				}
 
-				auto _mem_handle = this->_staging_buffer.get_memory().handle;
-				if(vkMapMemory(this->_gDevice->vk_device,
-					_mem_handle,
-					0,
-					_data_size,
-					0,
-					&this->_staging_buffer_memory_pointer))
+				this->_staging_buffer_memory_pointer = this->_staging_buffer.map();
+				if (!this->_staging_buffer_memory_pointer)
 				{
 					V(W_FAILED, "Could not map memory and upload texture data to a staging buffer on graphics device: " +
 						this->_gDevice->device_info->get_device_name() + " ID: " + std::to_string(this->_gDevice->device_info->get_device_id()),
@@ -789,19 +1162,8 @@ namespace wolf
 
 				memcpy(this->_staging_buffer_memory_pointer, pTextureArrayRGBA.data(), (size_t)_data_size);
 
-				VkMappedMemoryRange _flush_range =
-				{
-					VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE,              // Type
-					nullptr,                                            // Next
-					_mem_handle,										// Memory
-					0,                                                  // Offset
-					_data_size                                          // Size
-				};
-
-				vkFlushMappedMemoryRanges(this->_gDevice->vk_device,
-					1,
-					&_flush_range);
-				vkUnmapMemory(this->_gDevice->vk_device, _mem_handle);
+				this->_staging_buffer.flush(_data_size);
+				this->_staging_buffer.unmap();
 
 
 				//create command buffer
@@ -815,7 +1177,7 @@ namespace wolf
 					{
 						this->_buffer_type,								// AspectMask
 						0,                                              // BaseMipLevel
-						1,                                              // LevelCount
+						_levels,                                        // LevelCount
 						0,                                              // BaseArrayLayer
 						this->_layer_count                              // LayerCount
 					};
@@ -844,39 +1206,6 @@ namespace wolf
 						&_image_memory_barrier);
 					
 #pragma region copy all textures to buffer
-					std::vector<VkBufferImageCopy> _buffer_copy_regions;
-					size_t offset = 0;
-
-					for (uint32_t i = 0; i < this->_layer_count; ++i)
-					{
-						VkBufferImageCopy _buffer_image_copy_info =
-						{
-							offset,                               // BufferOffset
-							0,                                    // BufferRowLength
-							0,                                    // BufferImageHeight
-							{                                     // ImageSubresource
-								this->_buffer_type,				  // AspectMask
-								0,                                // MipLevel
-								i,                                // BaseArrayLayer
-								1                                 // LayerCount
-							},
-							{                                     // ImageOffset
-								0,                                // X
-								0,                                // Y
-								0                                 // Z
-							},
-							{                                     // ImageExtent
-								this->_image_view.width,          // Width
-								this->_image_view.height,         // Height
-								1                                 // Depth
-							}
-						};
-
-						_buffer_copy_regions.push_back(_buffer_image_copy_info);
-
-						offset += pTextureArrayRGBA[i][0].size();
-					}
-
 					auto _staging_buffer_handle = this->_staging_buffer.get_buffer_handle();
 					vkCmdCopyBufferToImage(_cmd.handle,
 						_staging_buffer_handle.handle,
@@ -1480,6 +1809,13 @@ namespace wolf
             
             ULONG release()
             {
+                //image may still be the destination of a pending upload
+                if (this->_upload_ticket && this->_gDevice && this->_gDevice->upload_manager)
+                {
+                    this->_gDevice->upload_manager->wait(this->_upload_ticket);
+                }
+                this->_upload_ticket = 0;
+
                 //release sampler
 				for (auto _iter : this->_samplers)
 				{
@@ -1515,12 +1851,9 @@ namespace wolf
 				}
                 
                 //release memory
-                if( this->_memory.handle)
+                if (this->_allocation.memory.handle && this->_gDevice->memory_allocator)
                 {
-                    vkFreeMemory(this->_gDevice->vk_device,
-                                 this->_memory.handle,
-                                 nullptr);
-                    this->_memory.handle = 0;
+                    this->_gDevice->memory_allocator->free(this->_allocation);
                 }
                 
                 if (this->_is_staging)
@@ -1637,7 +1970,40 @@ namespace wolf
 #pragma endregion
 
         private:
-            
+
+            //textures without staging buffer and generated mipmaps are uploaded through upload manager of graphics device
+            bool _use_upload_manager() const
+            {
+                return !this->_is_staging && !this->_generate_mip_maps && this->_gDevice && this->_gDevice->upload_manager;
+            }
+
+            W_RESULT _upload(
+                _In_ const void* pData,
+                _In_ const VkDeviceSize& pSize,
+                _In_ const VkImageSubresourceRange& pSubresourceRange,
+                _In_ const std::vector<VkBufferImageCopy>& pRegions,
+                _In_ const VkImageLayout& pFinalLayout,
+                _In_z_ const std::string& pTraceInfo)
+            {
+                if (this->_gDevice->upload_manager->upload_image(
+                    pData,
+                    pSize,
+                    this->_image_view.image,
+                    pSubresourceRange,
+                    pRegions,
+                    pFinalLayout,
+                    &this->_upload_ticket) == W_FAILED)
+                {
+                    V(W_FAILED, "uploading texture data on graphics device: " +
+                        this->_gDevice->device_info->get_device_name() + " ID: " + std::to_string(this->_gDevice->device_info->get_device_id()),
+                        pTraceInfo,
+                        3,
+                        false);
+                    return W_FAILED;
+                }
+                return W_PASSED;
+            }
+
             std::string                                     _name;
             std::shared_ptr<w_graphics_device>              _gDevice;
 			uint32_t										_usage_flags;
@@ -1651,11 +2017,13 @@ namespace wolf
 			w_image_view									_image_view;
 			VkImageAspectFlags								_buffer_type;
 			std::map<w_sampler_type, w_sampler>				_samplers;
-            w_device_memory                                 _memory;
+            w_memory_allocation                             _allocation;
 			w_image_type                                    _image_type;
             w_image_view_type                               _image_view_type;
 			VkImageLayout									_image_layout;
 			std::wstring									_texture_name;
+            //ticket of upload manager for data of image
+            uint64_t                                        _upload_ticket;
         };
     }
 }
@@ -1756,6 +2124,24 @@ W_RESULT w_texture::load_texture_from_memory_all_channels_same(_In_ uint8_t pDat
     return _hr;
 }
 
+W_RESULT w_texture::load_texture_2D_from_mip_chain(
+    _In_ const w_texture_mip_chain& pMipChain,
+    _In_ const uint32_t& pBaseLevel,
+    _In_opt_ w_texture* pResidentTexture)
+{
+    if (!this->_pimp) return W_FAILED;
+    return this->_pimp->load_texture_2D_from_mip_chain(pMipChain, pBaseLevel,
+        pResidentTexture ? pResidentTexture->_pimp : nullptr);
+}
+
+W_RESULT w_texture::load_mip_chain_from_file(
+    _In_z_ const std::wstring& pPath,
+    _In_ const bool& pIsAbsolutePath,
+    _Inout_ w_texture_mip_chain& pMipChain)
+{
+    return w_texture_pimp::decode_mip_chain_from_file(pPath, pIsAbsolutePath, pMipChain);
+}
+
 W_RESULT w_texture::load_texture_from_memory_color(_In_ w_color pColor)
 {
     if (!this->_pimp) return W_FAILED;
@@ -1838,6 +2224,59 @@ W_RESULT w_texture::load_to_shared_textures(_In_ const std::shared_ptr<w_graphic
     return W_PASSED;
 }
 
+std::shared_ptr<wolf::system::w_async_load_request> w_texture::load_to_shared_textures_async(
+    _In_ wolf::system::w_async_loader& pAsyncLoader,
+    _In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+    _In_z_ const std::wstring& pPath,
+    _In_ const bool& pGenerateMipMaps,
+    _In_ const int& pPriority,
+    _In_ const std::function<void(const W_RESULT&, w_texture*)>& pOnLoaded)
+{
+    auto _decoded = std::make_shared<w_texture_decoded_data>();
+    //shared textures are accessed only by the thread which owns graphics device
+    auto _is_shared = _shared.find(pPath) != _shared.end();
+
+    return pAsyncLoader.load(
+        pPriority,
+        [_decoded, _is_shared, pPath]() -> W_RESULT
+        {
+            if (_is_shared) return W_PASSED;
+            return w_texture_pimp::decode_texture_2D_from_file(pPath, true, *_decoded);
+        },
+        [_decoded, pGDevice, pPath, pGenerateMipMaps, pOnLoaded](_In_ const W_RESULT& pResult)
+        {
+            w_texture* _texture = nullptr;
+
+            auto _iter = _shared.find(pPath);
+            if (_iter != _shared.end())
+            {
+                _texture = _iter->second;
+            }
+            else if (pResult == W_PASSED)
+            {
+                _texture = new (std::nothrow) w_texture();
+                if (!_texture)
+                {
+                    logger.error(L"Could not perform allocation for shared texture: " + pPath);
+                }
+                else if (_texture->initialize(pGDevice, 32, 32, pGenerateMipMaps) == W_FAILED ||
+                    _texture->_pimp->load_texture_2D_from_decoded_data(*_decoded) == W_FAILED)
+                {
+                    SAFE_RELEASE(_texture);
+                }
+                else
+                {
+                    _shared[pPath] = _texture;
+                }
+            }
+
+            if (pOnLoaded)
+            {
+                pOnLoaded(_texture ? W_PASSED : W_FAILED, _texture);
+            }
+        });
+}
+
 //void w_texture::write_bitmap_to_file(
 //    _In_z_ const char* pFilename,
 //    _In_ const uint8_t* pData,
@@ -1888,6 +2327,7 @@ ULONG w_texture::release()
 {
 	if (_super::get_is_released()) return 1;
     
+    this->on_released.emit(this);
     SAFE_RELEASE(this->_pimp);
     
 	return _super::release();
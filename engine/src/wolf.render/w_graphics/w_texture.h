@@ -17,6 +17,7 @@
 #include "w_graphics_device_manager.h"
 #include <w_logger.h>
 #include <w_io.h>
+#include <w_async_loader.h>
 
 #ifdef __PYTHON__
 #include "w_std.h"
@@ -42,6 +43,31 @@ namespace wolf
 			MIPMAP_AND_ANISOTROPY
 		} w_sampler_type;
 
+		struct w_texture_mip_level
+		{
+			uint32_t	width = 0;
+			uint32_t	height = 0;
+			//offset and size of level in data of mip chain
+			uint64_t	offset = 0;
+			uint64_t	size = 0;
+		};
+
+		//all mip levels of a 2D texture in system memory, level 0 is the largest one and levels are stored in order,
+		//so levels from any base level to the smallest one are contiguous
+		struct w_texture_mip_chain
+		{
+			w_format							format = w_format::R8G8B8A8_UNORM;
+			std::vector<w_texture_mip_level>	levels;
+			std::vector<uint8_t>				data;
+
+			//size of levels from pBaseLevel to the smallest one in bytes
+			uint64_t get_size(_In_ const uint32_t& pBaseLevel) const
+			{
+				if (pBaseLevel >= this->levels.size()) return 0;
+				return this->data.size() - this->levels[pBaseLevel].offset;
+			}
+		};
+
         class w_texture_pimp;
 		class w_texture : public system::w_object
 		{
@@ -69,6 +95,19 @@ namespace wolf
             W_EXP W_RESULT load_texture_from_memory_all_channels_same(_In_ uint8_t pData);
             //Load texture from w_color
             W_EXP W_RESULT load_texture_from_memory_color(_In_ w_color pColor);
+            /*
+                create texture from levels of mip chain, from pBaseLevel to the smallest one. Data will be copied with
+                upload manager of graphics device and this function does not wait for GPU
+                @param pMipChain, mip chain in system memory
+                @param pBaseLevel, the largest level which will be resident
+                @param pResidentTexture, optional texture which has been loaded from the same mip chain, its levels will be copied on GPU
+                and only the other levels will be uploaded. Releasing it will wait for the copy
+                @return W_PASSED means function did succesfully and W_FAILED means function failed
+            */
+            W_EXP W_RESULT load_texture_2D_from_mip_chain(
+                _In_ const w_texture_mip_chain& pMipChain,
+                _In_ const uint32_t& pBaseLevel,
+                _In_opt_ w_texture* pResidentTexture = nullptr);
             /*
                 copy data to texture
                 if this is a staging buffer, do not use this function because it will cause memory leaks,
@@ -91,6 +130,39 @@ namespace wolf
                 _In_z_ const std::wstring& pPath,
 				_In_z_ const bool& pGenerateMipMaps,
                 _Inout_ w_texture** pPointerToTexture);
+
+            /*
+                read texture file and decode all of its mip levels into system memory, for dds and ktx files levels of the first layer
+                will be copied and for other formats levels will be generated with box filter. This function does not touch
+                gpu resources, so it can be called from any thread
+                @param pPath, path of texture
+                @param pIsAbsolutePath, false means path is relative to content path
+                @param pMipChain, decoded mip chain
+                @return W_PASSED means function did succesfully and W_FAILED means function failed
+            */
+            W_EXP static W_RESULT load_mip_chain_from_file(
+                _In_z_ const std::wstring& pPath,
+                _In_ const bool& pIsAbsolutePath,
+                _Inout_ w_texture_mip_chain& pMipChain);
+
+            /*
+                read and decode texture on a thread of async loader, then create texture and store it into the shared on the thread 
+                which calls w_async_loader::update. Texture will be shared, so do not release it
+                @param pAsyncLoader, async loader
+                @param pGDevice, graphics device
+                @param pPath, absolute path of texture
+                @param pGenerateMipMaps, generate mip maps
+                @param pPriority, textures with higher priority will be loaded first
+                @param pOnLoaded, will be called with the result and the shared texture
+                @return handle of request
+            */
+            W_EXP static std::shared_ptr<system::w_async_load_request> load_to_shared_textures_async(
+                _In_ system::w_async_loader& pAsyncLoader,
+                _In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+                _In_z_ const std::wstring& pPath,
+                _In_ const bool& pGenerateMipMaps,
+                _In_ const int& pPriority,
+                _In_ const std::function<void(const W_RESULT&, w_texture*)>& pOnLoaded);
         
 			/*
 				save png image file
@@ -178,6 +250,8 @@ namespace wolf
 #pragma region
 
             W_EXP static w_texture*                               default_texture;
+            //raised before releasing resources of texture, i.e. w_bindless_texture_table will free the slot of texture
+            system::w_signal<void(w_texture*)>                    on_released;
             
 #ifdef __PYTHON__
 			
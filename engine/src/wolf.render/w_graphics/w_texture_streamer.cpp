@@ -0,0 +1,682 @@
+#include "w_render_pch.h"
+#include "w_texture_streamer.h"
+#include <chrono>
+
+namespace wolf
+{
+	namespace graphics
+	{
+		struct w_streamed_texture
+		{
+			bool											used = false;
+			std::wstring									path;
+			std::shared_ptr<w_texture_mip_chain>			mip_chain;
+			std::shared_ptr<system::w_async_load_request>	request;
+			w_texture*										texture = nullptr;
+			//the largest resident level, UINT32_MAX means nothing is resident
+			uint32_t										resident_level = UINT32_MAX;
+			//levels from tail level to the smallest one are always resident
+			uint32_t										tail_level = 0;
+			//the largest level which has been requested since the previous update
+			uint32_t										requested_level = UINT32_MAX;
+			//the largest level which should be resident
+			uint32_t										wanted_level = UINT32_MAX;
+			uint64_t										last_requested_frame = 0;
+		};
+
+		struct w_retired_texture
+		{
+			w_texture*										texture = nullptr;
+			//the update which texture has been replaced
+			uint64_t										frame = 0;
+			//size of levels of texture, it still uses memory of device until it has been released
+			uint64_t										bytes = 0;
+		};
+
+		class w_texture_streamer_pimp
+		{
+		public:
+			w_texture_streamer_pimp(_In_ system::w_signal<void(const uint32_t&, w_texture*, w_texture*)>* pOnTextureChanged) :
+				_name("w_texture_streamer"),
+				_gDevice(nullptr),
+				_async_loader(nullptr),
+				_min_resident_size(64),
+				_max_upload_bytes_per_update(0),
+				_retire_frames(4),
+				_unused_frames(120),
+				_frame(0),
+				_bandwidth_window_bytes(0),
+				_on_texture_changed(pOnTextureChanged)
+			{
+			}
+
+			~w_texture_streamer_pimp()
+			{
+				release();
+			}
+
+			W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ system::w_async_loader* pAsyncLoader,
+				_In_ const uint64_t& pBudgetInBytes,
+				_In_ const uint32_t& pMinResidentSize,
+				_In_ const uint64_t& pMaxUploadBytesPerUpdate,
+				_In_ const uint32_t& pRetireFrames,
+				_In_ const uint32_t& pUnusedFrames)
+			{
+				const std::string _trace_info = this->_name + "::load";
+
+				if (!pGDevice || !pAsyncLoader || pBudgetInBytes == 0)
+				{
+					V(W_FAILED, "loading texture streamer with invalid parameters", _trace_info, 3, false);
+					return W_FAILED;
+				}
+				//streaming must not wait for GPU, so residency changes are uploaded on transfer queue
+				if (!pGDevice->upload_manager)
+				{
+					V(W_FAILED, "texture streamer requires upload manager, upload_ring_buffer_size of configs must not be zero for graphics device: " +
+						pGDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				this->_gDevice = pGDevice;
+				this->_async_loader = pAsyncLoader;
+				this->_statistics = w_texture_streamer_statistics();
+				this->_statistics.budget = pBudgetInBytes;
+				this->_min_resident_size = std::max<uint32_t>(1, pMinResidentSize);
+				this->_max_upload_bytes_per_update = pMaxUploadBytesPerUpdate;
+				this->_retire_frames = std::max<uint32_t>(1, pRetireFrames);
+				this->_unused_frames = pUnusedFrames;
+				this->_frame = 0;
+				this->_bandwidth_window_start = std::chrono::steady_clock::now();
+				this->_bandwidth_window_bytes = 0;
+
+				return W_PASSED;
+			}
+
+			W_RESULT add_texture(
+				_In_z_ const std::wstring& pPath,
+				_In_ const bool& pIsAbsolutePath,
+				_In_ const int& pPriority,
+				_Out_ uint32_t& pHandle)
+			{
+				pHandle = UINT32_MAX;
+				if (!this->_gDevice) return W_FAILED;
+
+				//reuse handles of removed textures
+				uint32_t _handle = 0;
+				if (!this->_free_handles.empty())
+				{
+					_handle = this->_free_handles.back();
+					this->_free_handles.pop_back();
+				}
+				else
+				{
+					_handle = static_cast<uint32_t>(this->_textures.size());
+					this->_textures.push_back(w_streamed_texture());
+				}
+
+				auto _entry = &this->_textures[_handle];
+				*_entry = w_streamed_texture();
+				_entry->used = true;
+				_entry->path = pPath;
+				_entry->last_requested_frame = this->_frame;
+
+				auto _mip_chain = std::make_shared<w_texture_mip_chain>();
+				_entry->request = this->_async_loader->load(
+					pPriority,
+					[_mip_chain, pPath, pIsAbsolutePath]() -> W_RESULT
+					{
+						return w_texture::load_mip_chain_from_file(pPath, pIsAbsolutePath, *_mip_chain);
+					},
+					[this, _handle, _mip_chain](_In_ const W_RESULT& pResult)
+					{
+						//requests of removed textures have been canceled, so handle still refers to this texture
+						auto _entry = &this->_textures[_handle];
+						_entry->request = nullptr;
+						if (pResult == W_FAILED || _mip_chain->levels.empty())
+						{
+							logger.error(L"could not decode mip chain of streamed texture: " + _entry->path);
+							return;
+						}
+
+						_entry->mip_chain = _mip_chain;
+						_entry->tail_level = _get_tail_level(*_mip_chain);
+						_entry->wanted_level = _entry->tail_level;
+						this->_statistics.system_memory_bytes += _mip_chain->data.size();
+
+						//tail levels are small and always resident, so they do not count against upload budget
+						_set_resident_level(_handle, _entry->tail_level);
+					});
+
+				if (!_entry->request)
+				{
+					remove_texture(_handle);
+					return W_FAILED;
+				}
+
+				pHandle = _handle;
+				return W_PASSED;
+			}
+
+			W_RESULT remove_texture(_In_ const uint32_t& pHandle)
+			{
+				if (!_is_valid(pHandle)) return W_FAILED;
+
+				auto _entry = &this->_textures[pHandle];
+				if (_entry->request)
+				{
+					_entry->request->cancel();
+				}
+				if (_entry->texture)
+				{
+					_retire(_entry->texture, _entry->mip_chain->get_size(_entry->resident_level));
+				}
+				if (_entry->mip_chain)
+				{
+					this->_statistics.system_memory_bytes -= _entry->mip_chain->data.size();
+				}
+				if (_entry->resident_level != UINT32_MAX)
+				{
+					this->_statistics.resident_bytes -= _entry->mip_chain->get_size(_entry->resident_level);
+				}
+
+				*_entry = w_streamed_texture();
+				this->_free_handles.push_back(pHandle);
+
+				return W_PASSED;
+			}
+
+			void request_size(_In_ const uint32_t& pHandle, _In_ const float& pSizeInPixels)
+			{
+				if (!_is_valid(pHandle)) return;
+
+				auto _entry = &this->_textures[pHandle];
+				if (!_entry->mip_chain) return;
+
+				//each level halves the size, so the level whose size is nearest to size on screen will be enough
+				auto _base_level = &_entry->mip_chain->levels[0];
+				auto _size = static_cast<float>(std::max(_base_level->width, _base_level->height));
+				auto _level = 0u;
+				if (pSizeInPixels > 0.0f && pSizeInPixels < _size)
+				{
+					_level = static_cast<uint32_t>(std::floor(std::log2(_size / pSizeInPixels)));
+				}
+				else if (pSizeInPixels <= 0.0f)
+				{
+					_level = _entry->tail_level;
+				}
+
+				request_level(pHandle, _level);
+			}
+
+			void request_level(_In_ const uint32_t& pHandle, _In_ const uint32_t& pLevel)
+			{
+				if (!_is_valid(pHandle)) return;
+
+				auto _entry = &this->_textures[pHandle];
+				_entry->requested_level = std::min(_entry->requested_level, pLevel);
+			}
+
+			void apply_feedback(_In_ const uint32_t* pLevels, _In_ const uint32_t& pCount)
+			{
+				if (!pLevels) return;
+
+				auto _count = std::min(pCount, static_cast<uint32_t>(this->_textures.size()));
+				for (uint32_t i = 0; i < _count; ++i)
+				{
+					if (pLevels[i] != UINT32_MAX)
+					{
+						request_level(i, pLevels[i]);
+					}
+				}
+			}
+
+			W_RESULT update()
+			{
+				if (!this->_gDevice) return W_FAILED;
+
+				this->_frame++;
+				this->_statistics.uploaded_bytes_of_last_update = 0;
+
+				_release_retired_textures();
+
+				//resolve requests of this update
+				std::vector<uint32_t> _stream_ins;
+				for (uint32_t i = 0; i < this->_textures.size(); ++i)
+				{
+					auto _entry = &this->_textures[i];
+					if (!_entry->used || !_entry->mip_chain) continue;
+
+					if (_entry->requested_level != UINT32_MAX)
+					{
+						_entry->wanted_level = std::min(_entry->requested_level, _entry->tail_level);
+						_entry->last_requested_frame = this->_frame;
+						_entry->requested_level = UINT32_MAX;
+					}
+					else if (this->_frame - _entry->last_requested_frame > this->_unused_frames)
+					{
+						_entry->wanted_level = _entry->tail_level;
+					}
+
+					if (_entry->resident_level != UINT32_MAX && _entry->resident_level > _entry->wanted_level)
+					{
+						_stream_ins.push_back(i);
+					}
+				}
+
+				//evict levels which are not required anymore
+				for (uint32_t i = 0; i < this->_textures.size(); ++i)
+				{
+					auto _entry = &this->_textures[i];
+					if (!_entry->used || !_entry->mip_chain) continue;
+
+					if (_entry->resident_level < _entry->wanted_level)
+					{
+						if (_set_resident_level(i, _entry->wanted_level) == W_PASSED)
+						{
+							this->_statistics.number_of_evictions++;
+						}
+					}
+				}
+
+				//textures which miss more levels first, then textures which have been requested recently
+				std::sort(_stream_ins.begin(), _stream_ins.end(), [this](const uint32_t& pLeft, const uint32_t& pRight)
+				{
+					auto _left = &this->_textures[pLeft];
+					auto _right = &this->_textures[pRight];
+					auto _left_missing = _left->resident_level - _left->wanted_level;
+					auto _right_missing = _right->resident_level - _right->wanted_level;
+					if (_left_missing != _right_missing) return _left_missing > _right_missing;
+					return _left->last_requested_frame > _right->last_requested_frame;
+				});
+
+				//stream in one level per update, so the lowest levels of all textures arrive before the highest ones
+				uint64_t _uploaded_bytes = 0;
+				for (auto _handle : _stream_ins)
+				{
+					auto _entry = &this->_textures[_handle];
+					//_make_room of previous stream ins may have evicted this texture to its wanted level
+					if (_entry->resident_level == UINT32_MAX || _entry->resident_level <= _entry->wanted_level) continue;
+
+					auto _level = _entry->resident_level - 1;
+					//only the new level will be uploaded, the others are copied from the current texture
+					auto _upload_size = _entry->mip_chain->levels[_level].size;
+					auto _size = _entry->mip_chain->get_size(_level);
+					auto _grow = _size - _entry->mip_chain->get_size(_entry->resident_level);
+
+					if (_uploaded_bytes && _uploaded_bytes + _upload_size > this->_max_upload_bytes_per_update) break;
+
+					if (this->_statistics.resident_bytes + _grow > this->_statistics.budget &&
+						!_make_room(_handle, this->_statistics.resident_bytes + _grow - this->_statistics.budget))
+					{
+						this->_statistics.number_of_budget_misses++;
+						continue;
+					}
+
+					//the current texture will be retired, so new texture and all retired ones must fit until they have been released
+					if (this->_statistics.resident_bytes + this->_statistics.retired_bytes + _size > this->_statistics.budget)
+					{
+						this->_statistics.number_of_budget_misses++;
+						continue;
+					}
+
+					if (_set_resident_level(_handle, _level) == W_PASSED)
+					{
+						this->_statistics.number_of_stream_ins++;
+						_uploaded_bytes += _upload_size;
+					}
+				}
+
+				_update_bandwidth();
+
+				return W_PASSED;
+			}
+
+			ULONG release()
+			{
+				for (uint32_t i = 0; i < this->_textures.size(); ++i)
+				{
+					auto _entry = &this->_textures[i];
+					if (_entry->request)
+					{
+						_entry->request->cancel();
+						_entry->request = nullptr;
+					}
+					SAFE_RELEASE(_entry->texture);
+				}
+				this->_textures.clear();
+				this->_free_handles.clear();
+
+				for (auto& _iter : this->_retired)
+				{
+					SAFE_RELEASE(_iter.texture);
+				}
+				this->_retired.clear();
+
+				this->_statistics = w_texture_streamer_statistics();
+				this->_async_loader = nullptr;
+				this->_gDevice = nullptr;
+
+				return 0;
+			}
+
+#pragma region Getters
+
+			w_texture* get_texture(_In_ const uint32_t& pHandle) const
+			{
+				if (!_is_valid(pHandle)) return nullptr;
+				return this->_textures[pHandle].texture;
+			}
+
+			uint32_t get_resident_level(_In_ const uint32_t& pHandle) const
+			{
+				if (!_is_valid(pHandle)) return UINT32_MAX;
+				return this->_textures[pHandle].resident_level;
+			}
+
+			const w_texture_streamer_statistics get_statistics() const
+			{
+				auto _statistics = this->_statistics;
+				for (auto& _entry : this->_textures)
+				{
+					if (!_entry.used) continue;
+
+					_statistics.number_of_textures++;
+					if (!_entry.mip_chain)
+					{
+						_statistics.number_of_pending_textures++;
+						continue;
+					}
+					if (_entry.resident_level == UINT32_MAX) continue;
+
+					auto _levels = static_cast<uint32_t>(_entry.mip_chain->levels.size());
+					_statistics.number_of_resident_levels += _levels - _entry.resident_level;
+					if (_entry.resident_level == 0)
+					{
+						_statistics.number_of_fully_resident_textures++;
+					}
+					if (_entry.resident_level > _entry.wanted_level)
+					{
+						_statistics.number_of_missing_levels += _entry.resident_level - _entry.wanted_level;
+					}
+				}
+				return _statistics;
+			}
+
+#pragma endregion
+
+		private:
+			bool _is_valid(_In_ const uint32_t& pHandle) const
+			{
+				return pHandle < this->_textures.size() && this->_textures[pHandle].used;
+			}
+
+			//the largest level which is not bigger than min resident size
+			uint32_t _get_tail_level(_In_ const w_texture_mip_chain& pMipChain) const
+			{
+				for (uint32_t i = 0; i < pMipChain.levels.size(); ++i)
+				{
+					auto _level = &pMipChain.levels[i];
+					if (std::max(_level->width, _level->height) <= this->_min_resident_size) return i;
+				}
+				return static_cast<uint32_t>(pMipChain.levels.size()) - 1;
+			}
+
+			//create a new texture with levels from pLevel to the smallest one and retire the previous one, levels which are resident
+			//in the previous texture are copied on GPU, so only the new levels are uploaded
+			W_RESULT _set_resident_level(_In_ const uint32_t& pHandle, _In_ const uint32_t& pLevel)
+			{
+				const std::string _trace_info = this->_name + "::_set_resident_level";
+
+				auto _entry = &this->_textures[pHandle];
+				auto _mip_chain = _entry->mip_chain.get();
+
+				auto _texture = new (std::nothrow) w_texture();
+				if (!_texture)
+				{
+					V(W_FAILED, "allocating memory for streamed texture", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				auto _level = &_mip_chain->levels[pLevel];
+				if (_texture->initialize(this->_gDevice, _level->width, _level->height) == W_FAILED ||
+					_texture->load_texture_2D_from_mip_chain(*_mip_chain, pLevel, _entry->texture) == W_FAILED)
+				{
+					SAFE_RELEASE(_texture);
+					V(W_FAILED, L"loading level " + std::to_wstring(pLevel) + L" of streamed texture: " + _entry->path, _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				auto _size = _mip_chain->get_size(pLevel);
+				auto _uploaded_size = _size;
+				uint64_t _previous_size = 0;
+				if (_entry->resident_level != UINT32_MAX)
+				{
+					_previous_size = _mip_chain->get_size(_entry->resident_level);
+					_uploaded_size = _size > _previous_size ? _size - _previous_size : 0;
+					this->_statistics.resident_bytes -= _previous_size;
+				}
+				this->_statistics.resident_bytes += _size;
+				this->_statistics.uploaded_bytes += _uploaded_size;
+				this->_statistics.uploaded_bytes_of_last_update += _uploaded_size;
+				this->_bandwidth_window_bytes += _uploaded_size;
+
+				auto _previous = _entry->texture;
+				_entry->texture = _texture;
+				_entry->resident_level = pLevel;
+
+				if (this->_on_texture_changed)
+				{
+					this->_on_texture_changed->emit(pHandle, _previous, _texture);
+				}
+				if (_previous)
+				{
+					_retire(_previous, _previous_size);
+				}
+
+				return W_PASSED;
+			}
+
+			//evict textures which have not been requested for the longest time, returns true if pBytes have been freed
+			bool _make_room(_In_ const uint32_t& pExceptHandle, _In_ const uint64_t& pBytes)
+			{
+				std::vector<uint32_t> _candidates;
+				for (uint32_t i = 0; i < this->_textures.size(); ++i)
+				{
+					auto _entry = &this->_textures[i];
+					if (i == pExceptHandle || !_entry->used || !_entry->mip_chain) continue;
+					//textures which have been requested on this update keep their levels
+					if (_entry->last_requested_frame == this->_frame) continue;
+					if (_entry->resident_level < _entry->tail_level)
+					{
+						_candidates.push_back(i);
+					}
+				}
+				std::sort(_candidates.begin(), _candidates.end(), [this](const uint32_t& pLeft, const uint32_t& pRight)
+				{
+					return this->_textures[pLeft].last_requested_frame < this->_textures[pRight].last_requested_frame;
+				});
+
+				uint64_t _freed = 0;
+				for (auto _handle : _candidates)
+				{
+					if (_freed >= pBytes) break;
+
+					auto _entry = &this->_textures[_handle];
+					auto _before = _entry->mip_chain->get_size(_entry->resident_level);
+					if (_set_resident_level(_handle, _entry->tail_level) == W_PASSED)
+					{
+						_entry->wanted_level = _entry->tail_level;
+						_freed += _before - _entry->mip_chain->get_size(_entry->tail_level);
+						this->_statistics.number_of_evictions++;
+					}
+				}
+				return _freed >= pBytes;
+			}
+
+			void _retire(_In_ w_texture* pTexture, _In_ const uint64_t& pBytes)
+			{
+				w_retired_texture _retired;
+				_retired.texture = pTexture;
+				_retired.frame = this->_frame;
+				_retired.bytes = pBytes;
+				this->_retired.push_back(_retired);
+				this->_statistics.retired_bytes += pBytes;
+			}
+
+			void _release_retired_textures()
+			{
+				auto _iter = this->_retired.begin();
+				while (_iter != this->_retired.end())
+				{
+					if (this->_frame - _iter->frame >= this->_retire_frames)
+					{
+						this->_statistics.retired_bytes -= _iter->bytes;
+						SAFE_RELEASE(_iter->texture);
+						_iter = this->_retired.erase(_iter);
+					}
+					else
+					{
+						++_iter;
+					}
+				}
+			}
+
+			void _update_bandwidth()
+			{
+				auto _now = std::chrono::steady_clock::now();
+				auto _elapsed = std::chrono::duration<double>(_now - this->_bandwidth_window_start).count();
+				if (_elapsed < 1.0) return;
+
+				this->_statistics.upload_bandwidth_in_mb_per_sec = static_cast<double>(this->_bandwidth_window_bytes) / (1024.0 * 1024.0) / _elapsed;
+				this->_bandwidth_window_bytes = 0;
+				this->_bandwidth_window_start = _now;
+			}
+
+			std::string														_name;
+			std::shared_ptr<w_graphics_device>								_gDevice;
+			system::w_async_loader*											_async_loader;
+			uint32_t														_min_resident_size;
+			uint64_t														_max_upload_bytes_per_update;
+			uint32_t														_retire_frames;
+			uint32_t														_unused_frames;
+			uint64_t														_frame;
+			std::vector<w_streamed_texture>									_textures;
+			std::vector<uint32_t>											_free_handles;
+			//replaced textures which may still be used by frames in flight
+			std::vector<w_retired_texture>									_retired;
+			w_texture_streamer_statistics									_statistics;
+			std::chrono::steady_clock::time_point							_bandwidth_window_start;
+			uint64_t														_bandwidth_window_bytes;
+			system::w_signal<void(const uint32_t&, w_texture*, w_texture*)>*	_on_texture_changed;
+		};
+	}
+}
+
+using namespace wolf::graphics;
+
+w_texture_streamer::w_texture_streamer() : _pimp(new w_texture_streamer_pimp(&this->on_texture_changed))
+{
+	_super::set_class_name("w_texture_streamer");
+}
+
+w_texture_streamer::~w_texture_streamer()
+{
+	release();
+}
+
+W_RESULT w_texture_streamer::load(
+	_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_ system::w_async_loader* pAsyncLoader,
+	_In_ const uint64_t& pBudgetInBytes,
+	_In_ const uint32_t& pMinResidentSize,
+	_In_ const uint64_t& pMaxUploadBytesPerUpdate,
+	_In_ const uint32_t& pRetireFrames,
+	_In_ const uint32_t& pUnusedFrames)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->load(
+		pGDevice,
+		pAsyncLoader,
+		pBudgetInBytes,
+		pMinResidentSize,
+		pMaxUploadBytesPerUpdate,
+		pRetireFrames,
+		pUnusedFrames);
+}
+
+W_RESULT w_texture_streamer::add_texture(
+	_In_z_ const std::wstring& pPath,
+	_In_ const bool& pIsAbsolutePath,
+	_In_ const int& pPriority,
+	_Out_ uint32_t& pHandle)
+{
+	if (!this->_pimp)
+	{
+		pHandle = UINT32_MAX;
+		return W_FAILED;
+	}
+	return this->_pimp->add_texture(pPath, pIsAbsolutePath, pPriority, pHandle);
+}
+
+W_RESULT w_texture_streamer::remove_texture(_In_ const uint32_t& pHandle)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->remove_texture(pHandle);
+}
+
+void w_texture_streamer::request_size(_In_ const uint32_t& pHandle, _In_ const float& pSizeInPixels)
+{
+	if (!this->_pimp) return;
+	this->_pimp->request_size(pHandle, pSizeInPixels);
+}
+
+void w_texture_streamer::request_level(_In_ const uint32_t& pHandle, _In_ const uint32_t& pLevel)
+{
+	if (!this->_pimp) return;
+	this->_pimp->request_level(pHandle, pLevel);
+}
+
+void w_texture_streamer::apply_feedback(_In_ const uint32_t* pLevels, _In_ const uint32_t& pCount)
+{
+	if (!this->_pimp) return;
+	this->_pimp->apply_feedback(pLevels, pCount);
+}
+
+W_RESULT w_texture_streamer::update()
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->update();
+}
+
+ULONG w_texture_streamer::release()
+{
+	if (_super::get_is_released()) return 0;
+
+	SAFE_RELEASE(this->_pimp);
+
+	return _super::release();
+}
+
+#pragma region Getters
+
+w_texture* w_texture_streamer::get_texture(_In_ const uint32_t& pHandle) const
+{
+	if (!this->_pimp) return nullptr;
+	return this->_pimp->get_texture(pHandle);
+}
+
+uint32_t w_texture_streamer::get_resident_level(_In_ const uint32_t& pHandle) const
+{
+	if (!this->_pimp) return UINT32_MAX;
+	return this->_pimp->get_resident_level(pHandle);
+}
+
+const w_texture_streamer_statistics w_texture_streamer::get_statistics() const
+{
+	if (!this->_pimp) return w_texture_streamer_statistics();
+	return this->_pimp->get_statistics();
+}
+
+#pragma endregion
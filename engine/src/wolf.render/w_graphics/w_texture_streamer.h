@@ -0,0 +1,161 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_texture_streamer.h
+	Description		 : Streams mip levels of textures on demand and keeps resident levels under a memory budget
+	Comment          : Mip chains are decoded on threads of w_async_loader and kept in system memory. At first only the tail levels
+					   (levels which are not bigger than min resident size) become resident, then higher levels are streamed one level
+					   per update based on feedback, i.e. screen space size of objects or levels which have been written by shaders.
+					   Without sparse residency a texture can not change its levels in place, so each residency change creates a new
+					   texture with levels from new base level to the smallest one, uploads only the new levels through upload manager
+					   of graphics device, copies the others from the previous texture on GPU and retires the previous texture once
+					   frames in flight which may use it have been completed.
+					   Subscribe to on_texture_changed to refresh descriptor sets, i.e. with w_bindless_texture_table::replace_texture
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_TEXTURE_STREAMER_H__
+#define __W_TEXTURE_STREAMER_H__
+
+#include "w_graphics_device_manager.h"
+#include "w_texture.h"
+#include <w_async_loader.h>
+
+namespace wolf
+{
+	namespace graphics
+	{
+		struct w_texture_streamer_statistics
+		{
+			//budget of resident levels in bytes
+			uint64_t	budget = 0;
+			//bytes of resident levels of all textures
+			uint64_t	resident_bytes = 0;
+			//bytes of replaced textures which are waiting for frames in flight, they are counted against budget until released
+			uint64_t	retired_bytes = 0;
+			//bytes of mip chains which are kept in system memory
+			uint64_t	system_memory_bytes = 0;
+			uint32_t	number_of_textures = 0;
+			//textures which are waiting for decoding of their mip chain
+			uint32_t	number_of_pending_textures = 0;
+			//textures whose all levels are resident
+			uint32_t	number_of_fully_resident_textures = 0;
+			//sum of resident levels of all textures
+			uint32_t	number_of_resident_levels = 0;
+			//sum of levels which have been requested but are not resident yet
+			uint32_t	number_of_missing_levels = 0;
+			//number of residency changes since loading
+			uint64_t	number_of_stream_ins = 0;
+			uint64_t	number_of_evictions = 0;
+			//number of stream ins which have been skipped because budget was not enough
+			uint64_t	number_of_budget_misses = 0;
+			//bytes which have been uploaded since loading
+			uint64_t	uploaded_bytes = 0;
+			//bytes which have been uploaded on the last update
+			uint64_t	uploaded_bytes_of_last_update = 0;
+			//average upload bandwidth of the last second in megabytes per second
+			double		upload_bandwidth_in_mb_per_sec = 0.0;
+		};
+
+		class w_texture_streamer_pimp;
+		class w_texture_streamer : public system::w_object
+		{
+		public:
+			W_EXP w_texture_streamer();
+			W_EXP ~w_texture_streamer();
+
+			/*
+				initialize streamer, upload manager of graphics device is required
+				@param pGDevice, graphics device
+				@param pAsyncLoader, async loader which decodes mip chains, w_async_loader::update must be called once per frame
+				@param pBudgetInBytes, budget of resident levels, tail levels of all textures are always resident
+				@param pMinResidentSize, levels which are not bigger than this size in pixels are always resident
+				@param pMaxUploadBytesPerUpdate, upload budget of each update, at least one residency change will be done
+				@param pRetireFrames, number of updates before releasing textures which have been replaced, must be greater than frames in flight
+				@param pUnusedFrames, number of updates without request before a texture falls back to its tail levels
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ system::w_async_loader* pAsyncLoader,
+				_In_ const uint64_t& pBudgetInBytes,
+				_In_ const uint32_t& pMinResidentSize = 64,
+				_In_ const uint64_t& pMaxUploadBytesPerUpdate = 8 * 1024 * 1024,
+				_In_ const uint32_t& pRetireFrames = 4,
+				_In_ const uint32_t& pUnusedFrames = 120);
+
+			/*
+				add a texture, its mip chain will be decoded asynchronously and then its tail levels will become resident
+				@param pPath, path of texture
+				@param pIsAbsolutePath, false means path is relative to content path
+				@param pPriority, textures with higher priority will be decoded first
+				@param pHandle, handle of texture
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT add_texture(
+				_In_z_ const std::wstring& pPath,
+				_In_ const bool& pIsAbsolutePath,
+				_In_ const int& pPriority,
+				_Out_ uint32_t& pHandle);
+
+			//remove texture, its resident levels will be released once frames in flight have been completed
+			W_EXP W_RESULT remove_texture(_In_ const uint32_t& pHandle);
+
+			/*
+				request levels of texture based on size of texture on screen, call it each frame for visible objects.
+				The largest request of each update will be used
+				@param pHandle, handle of texture
+				@param pSizeInPixels, the biggest dimension of texture on screen in pixels
+			*/
+			W_EXP void request_size(_In_ const uint32_t& pHandle, _In_ const float& pSizeInPixels);
+
+			//request the largest level which is required by texture, i.e. the level which has been calculated with textureQueryLod
+			W_EXP void request_level(_In_ const uint32_t& pHandle, _In_ const uint32_t& pLevel);
+
+			/*
+				apply feedback which has been written by shaders, i.e. atomicMin(feedback[handle], uint(textureQueryLod(t, uv).x))
+				into a storage buffer which has been cleared with UINT32_MAX and then read back
+				@param pLevels, requested level of each handle, UINT32_MAX means texture has not been sampled
+				@param pCount, number of elements of pLevels
+			*/
+			W_EXP void apply_feedback(_In_ const uint32_t* pLevels, _In_ const uint32_t& pCount);
+
+			/*
+				stream in or evict levels based on requests, then release retired textures. Call it once per frame from the thread
+				which owns graphics device, after w_async_loader::update
+			*/
+			W_EXP W_RESULT update();
+
+			//release all resources, graphics device must be idle
+			W_EXP ULONG release() override;
+
+#pragma region Getters
+
+			//returns current texture of handle, or nullptr if its mip chain has not been decoded yet
+			W_EXP w_texture* get_texture(_In_ const uint32_t& pHandle) const;
+			//returns the largest resident level of texture, or UINT32_MAX if texture is not resident
+			W_EXP uint32_t get_resident_level(_In_ const uint32_t& pHandle) const;
+			W_EXP const w_texture_streamer_statistics get_statistics() const;
+
+#pragma endregion
+
+			//raised when texture of handle has been replaced with arguments handle, previous texture and new texture. Previous texture
+			//will be nullptr on the first residency and remains valid until frames in flight have been completed
+			system::w_signal<void(const uint32_t&, w_texture*, w_texture*)>		on_texture_changed;
+
+		private:
+			//prevent copying
+			w_texture_streamer(w_texture_streamer const&);
+			w_texture_streamer& operator= (w_texture_streamer const&);
+
+			typedef system::w_object						_super;
+			w_texture_streamer_pimp*						_pimp;
+		};
+	}
+}
+
+#endif //__W_TEXTURE_STREAMER_H__
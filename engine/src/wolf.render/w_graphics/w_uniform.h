@@ -23,7 +23,9 @@ namespace wolf
 		{
 		public:
             w_uniform() :
-                _host_visible(false)
+                _host_visible(false),
+                _number_of_frames(1),
+                _frame_stride(0)
             {
                 _super::name = "w_uniform";
             }
@@ -37,16 +39,30 @@ namespace wolf
                 Load the uniform buffer
                 _In_ pGDevice : Graphics Device
                 _In_ pHostVisible : True means host memory of uniform's buffer in DRAM, otherwise host memory in VRAM
+                _In_ pNumberOfFrames : Number of frames in flight, usually number of swap chain images. More than one frame keeps
+                     one aligned copy of data for each frame in a host visible buffer, which must be bound as UNIFORM_DYNAMIC
+                     with the offset of get_dynamic_offset_at
             */
 			W_RESULT load(_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
-                _In_ const bool& pHostVisible = false)
+                _In_ const bool& pHostVisible = false,
+                _In_ const uint32_t& pNumberOfFrames = 1)
 			{
                 const std::string _trace = this->name + "::update";
 
-                this->_host_visible = pHostVisible;
+                this->_number_of_frames = std::max<uint32_t>(1, pNumberOfFrames);
+                this->_host_visible = pHostVisible || this->_number_of_frames > 1;
 
                 //store the shared graphics device pointer
                 auto _buffer_size = static_cast<uint32_t>(sizeof(T));
+                this->_frame_stride = _buffer_size;
+                if (this->_number_of_frames > 1)
+                {
+                    //dynamic offsets must be multiple of minUniformBufferOffsetAlignment
+                    auto _alignment = static_cast<uint32_t>(std::max<VkDeviceSize>(1,
+                        pGDevice->device_info->device_properties->limits.minUniformBufferOffsetAlignment));
+                    this->_frame_stride = (_buffer_size + _alignment - 1) / _alignment * _alignment;
+                    _buffer_size = this->_frame_stride * this->_number_of_frames;
+                }
                 
                 this->_gDevice = pGDevice;
                 
@@ -129,6 +145,16 @@ namespace wolf
 
                 W_RESULT _hr = W_PASSED;
 
+                //write all frames, no frame which uses this uniform must be in flight
+                if (this->_number_of_frames > 1)
+                {
+                    for (uint32_t i = 0; i < this->_number_of_frames; ++i)
+                    {
+                        if (update_at(i) == W_FAILED) _hr = W_FAILED;
+                    }
+                    return _hr;
+                }
+
                 if (this->_host_visible)
                 {
                     _hr = this->_buffer.set_data(&this->data);
@@ -168,9 +194,45 @@ namespace wolf
                 return _hr;
             }
 
+            //copy data to the region of a frame, the frame which has used this region must be completed by GPU
+            W_RESULT update_at(_In_ const uint32_t& pFrameIndex)
+            {
+                const std::string _trace = this->name + "update_at";
+
+                if (pFrameIndex >= this->_number_of_frames) return W_FAILED;
+                if (this->_number_of_frames == 1) return update();
+
+                auto _mapped = static_cast<uint8_t*>(this->_buffer.map());
+                if (!_mapped)
+                {
+                    V(W_FAILED, "mapping host visible buffer " +
+                        _gDevice->get_info(),
+                        _trace,
+                        3);
+                    return W_FAILED;
+                }
+                memcpy(_mapped + pFrameIndex * this->_frame_stride, &this->data, sizeof(T));
+                auto _hr = this->_buffer.flush(this->_frame_stride, pFrameIndex * this->_frame_stride);
+                this->_buffer.unmap();
+
+                return _hr;
+            }
+
             const w_descriptor_buffer_info get_descriptor_info() const
             {
-                return this->_buffer.get_descriptor_info();
+                auto _info = this->_buffer.get_descriptor_info();
+                //shader sees one frame, the frame is selected with dynamic offset
+                if (this->_number_of_frames > 1)
+                {
+                    _info.range = sizeof(T);
+                }
+                return _info;
+            }
+
+            //dynamic offset of the region of a frame
+            uint32_t get_dynamic_offset_at(_In_ const uint32_t& pFrameIndex) const
+            {
+                return pFrameIndex * this->_frame_stride;
             }
                 
 			//Release resources
@@ -205,6 +267,8 @@ namespace wolf
             w_buffer                             _buffer;
             w_buffer                             _staging_buffer;
             bool                                 _host_visible;
+            uint32_t                             _number_of_frames;
+            uint32_t                             _frame_stride;
 		};
 	}
 }
@@ -0,0 +1,273 @@
+#include "w_render_pch.h"
+#include "w_uniform_ring.h"
+#include "w_buffer.h"
+
+namespace wolf
+{
+	namespace graphics
+	{
+		class w_uniform_ring_pimp
+		{
+		public:
+			w_uniform_ring_pimp() :
+				_name("w_uniform_ring"),
+				_gDevice(nullptr),
+				_mapped(nullptr),
+				_number_of_frames(0),
+				_range_size(0),
+				_frame_index(0)
+			{
+			}
+
+			~w_uniform_ring_pimp()
+			{
+				release();
+			}
+
+			W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const uint32_t& pFrameSizeInBytes,
+				_In_ const uint32_t& pNumberOfFrames,
+				_In_ const uint32_t& pRangeSizeInBytes,
+				_In_ const bool& pStorage)
+			{
+				const std::string _trace_info = this->_name + "::load";
+
+				if (!pGDevice || !pGDevice->device_info || !pGDevice->device_info->device_properties ||
+					pFrameSizeInBytes == 0 || pNumberOfFrames == 0 || pRangeSizeInBytes == 0)
+				{
+					V(W_FAILED, "loading uniform ring with invalid parameters", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				this->_gDevice = pGDevice;
+
+				auto _limits = &pGDevice->device_info->device_properties->limits;
+				auto _max_range = pStorage ? _limits->maxStorageBufferRange : _limits->maxUniformBufferRange;
+				if (pRangeSizeInBytes > _max_range)
+				{
+					V(W_FAILED, "range size of uniform ring is bigger than limit of device " + std::to_string(_max_range) + " for graphics device: " +
+						this->_gDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//dynamic offsets must be multiple of this alignment
+				this->_statistics.alignment = static_cast<uint32_t>(std::max<VkDeviceSize>(1, pStorage ?
+					_limits->minStorageBufferOffsetAlignment : _limits->minUniformBufferOffsetAlignment));
+
+				//each frame region must start at an aligned offset and have room for at least one range
+				this->_statistics.frame_size = _align(std::max(pFrameSizeInBytes, pRangeSizeInBytes));
+				this->_number_of_frames = pNumberOfFrames;
+				this->_range_size = pRangeSizeInBytes;
+
+				auto _hr = this->_buffer.load(
+					pGDevice,
+					this->_statistics.frame_size * pNumberOfFrames,
+					pStorage ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT : VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+				if (_hr == W_FAILED)
+				{
+					V(W_FAILED, "loading buffer of uniform ring for graphics device: " + this->_gDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				_hr = this->_buffer.bind();
+				if (_hr == W_FAILED)
+				{
+					V(W_FAILED, "binding buffer of uniform ring for graphics device: " + this->_gDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//memory remains mapped until releasing the ring
+				this->_mapped = static_cast<uint8_t*>(this->_buffer.map());
+				if (!this->_mapped)
+				{
+					V(W_FAILED, "mapping buffer of uniform ring for graphics device: " + this->_gDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//shader sees one range and the dynamic offset selects which one
+				this->_descriptor_info = this->_buffer.get_descriptor_info();
+				this->_descriptor_info.offset = 0;
+				this->_descriptor_info.range = this->_range_size;
+
+				return begin_frame(0);
+			}
+
+			W_RESULT begin_frame(_In_ const uint32_t& pFrameIndex)
+			{
+				if (!this->_mapped || pFrameIndex >= this->_number_of_frames) return W_FAILED;
+
+				this->_frame_index = pFrameIndex;
+				this->_statistics.used_bytes = 0;
+				this->_statistics.number_of_allocations = 0;
+				this->_statistics.number_of_failed_allocations = 0;
+
+				return W_PASSED;
+			}
+
+			void* allocate(
+				_In_ const uint32_t& pSizeInBytes,
+				_Out_ uint32_t& pDynamicOffset)
+			{
+				pDynamicOffset = 0;
+				if (!this->_mapped || pSizeInBytes == 0 || pSizeInBytes > this->_range_size) return nullptr;
+
+				//the whole range must fit in region of frame, because shader may read all of it
+				auto _offset = this->_statistics.used_bytes;
+				if (_offset + this->_range_size > this->_statistics.frame_size)
+				{
+					this->_statistics.number_of_failed_allocations++;
+					return nullptr;
+				}
+
+				this->_statistics.used_bytes = _align(_offset + pSizeInBytes);
+				this->_statistics.number_of_allocations++;
+
+				pDynamicOffset = this->_frame_index * this->_statistics.frame_size + _offset;
+				return this->_mapped + pDynamicOffset;
+			}
+
+			W_RESULT flush()
+			{
+				if (!this->_mapped) return W_FAILED;
+				if (!this->_statistics.used_bytes) return W_PASSED;
+
+				return this->_buffer.flush(
+					this->_statistics.used_bytes,
+					this->_frame_index * this->_statistics.frame_size);
+			}
+
+			ULONG release()
+			{
+				this->_mapped = nullptr;
+				this->_buffer.release();
+				this->_statistics = w_uniform_ring_statistics();
+				this->_gDevice = nullptr;
+
+				return 0;
+			}
+
+#pragma region Getters
+
+			const w_descriptor_buffer_info get_descriptor_info() const
+			{
+				return this->_descriptor_info;
+			}
+
+			const uint32_t get_alignment() const
+			{
+				return this->_statistics.alignment;
+			}
+
+			const w_uniform_ring_statistics get_statistics() const
+			{
+				return this->_statistics;
+			}
+
+#pragma endregion
+
+		private:
+			uint32_t _align(_In_ const uint32_t& pValue) const
+			{
+				auto _alignment = this->_statistics.alignment;
+				return ((pValue + _alignment - 1) / _alignment) * _alignment;
+			}
+
+			std::string											_name;
+			std::shared_ptr<w_graphics_device>					_gDevice;
+			w_buffer											_buffer;
+			uint8_t*											_mapped;
+			w_descriptor_buffer_info							_descriptor_info;
+			uint32_t											_number_of_frames;
+			uint32_t											_range_size;
+			uint32_t											_frame_index;
+			w_uniform_ring_statistics							_statistics;
+		};
+	}
+}
+
+using namespace wolf::graphics;
+
+w_uniform_ring::w_uniform_ring() : _pimp(new w_uniform_ring_pimp())
+{
+	_super::set_class_name("w_uniform_ring");
+}
+
+w_uniform_ring::~w_uniform_ring()
+{
+	release();
+}
+
+W_RESULT w_uniform_ring::load(
+	_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_ const uint32_t& pFrameSizeInBytes,
+	_In_ const uint32_t& pNumberOfFrames,
+	_In_ const uint32_t& pRangeSizeInBytes,
+	_In_ const bool& pStorage)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->load(pGDevice, pFrameSizeInBytes, pNumberOfFrames, pRangeSizeInBytes, pStorage);
+}
+
+W_RESULT w_uniform_ring::begin_frame(_In_ const uint32_t& pFrameIndex)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->begin_frame(pFrameIndex);
+}
+
+void* w_uniform_ring::allocate(
+	_In_ const uint32_t& pSizeInBytes,
+	_Out_ uint32_t& pDynamicOffset)
+{
+	if (!this->_pimp)
+	{
+		pDynamicOffset = 0;
+		return nullptr;
+	}
+	return this->_pimp->allocate(pSizeInBytes, pDynamicOffset);
+}
+
+W_RESULT w_uniform_ring::flush()
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->flush();
+}
+
+ULONG w_uniform_ring::release()
+{
+	if (_super::get_is_released()) return 0;
+
+	SAFE_RELEASE(this->_pimp);
+
+	return _super::release();
+}
+
+#pragma region Getters
+
+const w_descriptor_buffer_info w_uniform_ring::get_descriptor_info() const
+{
+	if (!this->_pimp)
+	{
+		w_descriptor_buffer_info _buffer_info;
+		_buffer_info.buffer = 0;
+		_buffer_info.offset = 0;
+		_buffer_info.range = 0;
+		return _buffer_info;
+	}
+	return this->_pimp->get_descriptor_info();
+}
+
+const uint32_t w_uniform_ring::get_alignment() const
+{
+	if (!this->_pimp) return 0;
+	return this->_pimp->get_alignment();
+}
+
+const w_uniform_ring_statistics w_uniform_ring::get_statistics() const
+{
+	if (!this->_pimp) return w_uniform_ring_statistics();
+	return this->_pimp->get_statistics();
+}
+
+#pragma endregion
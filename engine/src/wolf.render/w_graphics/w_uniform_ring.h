@@ -0,0 +1,115 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_uniform_ring.h
+	Description		 : Per frame ring of dynamic uniform or storage buffer for per draw constants
+	Comment          : One persistently mapped buffer is divided into one region for each frame in flight. Each draw allocates
+					   an aligned block of the current region, copies its constants with memcpy and binds it with a dynamic offset,
+					   so all draws share one buffer, one descriptor and no staging copy.
+					   Region of a frame will be reused on begin_frame, so the frame which has used it must be completed by GPU
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_UNIFORM_RING_H__
+#define __W_UNIFORM_RING_H__
+
+#include "w_graphics_device_manager.h"
+#include <cstring>
+
+namespace wolf
+{
+	namespace graphics
+	{
+		struct w_uniform_ring_statistics
+		{
+			//size of each frame region in bytes
+			uint32_t	frame_size = 0;
+			//alignment of each allocation, minUniformBufferOffsetAlignment or minStorageBufferOffsetAlignment of device
+			uint32_t	alignment = 0;
+			//bytes and allocations of current frame
+			uint32_t	used_bytes = 0;
+			uint32_t	number_of_allocations = 0;
+			//number of allocations which failed because region of current frame was full
+			uint32_t	number_of_failed_allocations = 0;
+		};
+
+		class w_uniform_ring_pimp;
+		class w_uniform_ring : public system::w_object
+		{
+		public:
+			W_EXP w_uniform_ring();
+			W_EXP ~w_uniform_ring();
+
+			/*
+				create persistently mapped buffer of ring
+				@param pGDevice, graphics device
+				@param pFrameSizeInBytes, size of region of each frame
+				@param pNumberOfFrames, number of frames in flight, usually number of swap chain images
+				@param pRangeSizeInBytes, size of each sub allocation which will be visible to shader, it must be the size of uniform block
+				@param pStorage, true means storage buffer, otherwise uniform buffer
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT load(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const uint32_t& pFrameSizeInBytes,
+				_In_ const uint32_t& pNumberOfFrames,
+				_In_ const uint32_t& pRangeSizeInBytes,
+				_In_ const bool& pStorage = false);
+
+			/*
+				begin allocations of a frame, previous allocations of this frame will be discarded
+				@param pFrameIndex, index of frame, usually index of swap chain image
+			*/
+			W_EXP W_RESULT begin_frame(_In_ const uint32_t& pFrameIndex);
+
+			/*
+				allocate an aligned block from region of current frame
+				@param pSizeInBytes, size of block, must be less than or equal to range size of ring
+				@param pDynamicOffset, dynamic offset of block which must be passed to w_pipeline::bind or w_pipeline::bind_descriptor_set
+				@return mapped pointer of block, or nullptr if region of current frame is full
+			*/
+			W_EXP void* allocate(
+				_In_ const uint32_t& pSizeInBytes,
+				_Out_ uint32_t& pDynamicOffset);
+
+			//allocate a block and copy pData to it, returns W_FAILED if region of current frame is full
+			template<typename T>
+			W_RESULT push(_In_ const T& pData, _Out_ uint32_t& pDynamicOffset)
+			{
+				auto _mapped = allocate(static_cast<uint32_t>(sizeof(T)), pDynamicOffset);
+				if (!_mapped) return W_FAILED;
+				std::memcpy(_mapped, &pData, sizeof(T));
+				return W_PASSED;
+			}
+
+			//flush allocations of current frame, only required if memory of ring is not host coherent
+			W_EXP W_RESULT flush();
+
+			//release all resources
+			W_EXP ULONG release() override;
+
+#pragma region Getters
+
+			//descriptor info of ring, use it with UNIFORM_DYNAMIC or STORAGE_DYNAMIC binding type of shader
+			W_EXP const w_descriptor_buffer_info get_descriptor_info() const;
+			W_EXP const uint32_t get_alignment() const;
+			W_EXP const w_uniform_ring_statistics get_statistics() const;
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_uniform_ring(w_uniform_ring const&);
+			w_uniform_ring& operator= (w_uniform_ring const&);
+
+			typedef system::w_object						_super;
+			w_uniform_ring_pimp*							_pimp;
+		};
+	}
+}
+
+#endif //__W_UNIFORM_RING_H__
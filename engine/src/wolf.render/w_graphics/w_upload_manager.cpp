@@ -0,0 +1,1007 @@
+#include "w_render_pch.h"
+#include "w_graphics_device_manager.h"
+#include "w_upload_manager.h"
+#include "w_memory_allocator.h"
+#include <deque>
+#include <mutex>
+#include <algorithm>
+
+//minimum alignment of staging allocations, covers texel sizes of uncompressed and block compressed formats
+#define MIN_STAGING_ALIGNMENT	16
+
+namespace wolf
+{
+	namespace graphics
+	{
+		struct w_upload_staging_buffer
+		{
+			VkBuffer												buffer = 0;
+			w_memory_allocation										allocation;
+		};
+
+		//copy between two images which is recorded on graphics queue, after ownership of uploaded images has been acquired
+		struct w_upload_image_copy
+		{
+			VkImage													src_image = 0;
+			VkImageLayout											src_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+			VkImageSubresourceRange									src_subresource_range;
+			VkImage													dst_image = 0;
+			VkImageSubresourceRange									dst_subresource_range;
+			std::vector<VkImageCopy>								regions;
+			VkImageLayout											final_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+		};
+
+		struct w_upload_batch
+		{
+			uint64_t												ticket = 0;
+			bool													recording = false;
+			VkCommandBuffer											transfer_command_buffer = 0;
+			//command buffer of graphics queue which acquires ownership, only used for dedicated transfer queue
+			VkCommandBuffer											acquire_command_buffer = 0;
+			VkSemaphore												transfer_done_semaphore = 0;
+			VkFence													fence = 0;
+			//head of ring buffer after this batch, tail of ring moves here once batch completed
+			VkDeviceSize											ring_end = 0;
+			std::vector<w_upload_staging_buffer>					oversized_buffers;
+			std::vector<VkBufferMemoryBarrier>						buffer_barriers;
+			std::vector<VkImageMemoryBarrier>						image_barriers;
+			std::vector<w_upload_image_copy>						image_copies;
+			VkPipelineStageFlags									dst_stage_mask = 0;
+		};
+
+		class w_upload_manager_pimp
+		{
+		public:
+			w_upload_manager_pimp() :
+				_name("w_upload_manager"),
+				_gDevice(nullptr),
+				_dedicated_transfer_queue(false),
+				_transfer_command_pool(0),
+				_graphics_command_pool(0),
+				_alignment(MIN_STAGING_ALIGNMENT),
+				_ring_size(0),
+				_ring_head(0),
+				_ring_tail(0),
+				_current(nullptr),
+				_last_ticket(0),
+				_last_completed_ticket(0)
+			{
+			}
+
+			~w_upload_manager_pimp()
+			{
+				release();
+			}
+
+			W_RESULT initialize(
+				_In_ w_graphics_device* pGDevice,
+				_In_ const VkDeviceSize& pRingSize)
+			{
+				release();
+
+				if (!pGDevice || !pGDevice->vk_device || !pGDevice->memory_allocator || pRingSize == 0) return W_FAILED;
+
+				this->_gDevice = pGDevice;
+				this->_graphics_queue = pGDevice->vk_graphics_queue;
+				this->_transfer_queue = pGDevice->vk_transfer_queue;
+				if (!this->_transfer_queue.queue || this->_transfer_queue.index == UINT32_MAX)
+				{
+					this->_transfer_queue = this->_graphics_queue;
+				}
+				this->_dedicated_transfer_queue = this->_transfer_queue.index != this->_graphics_queue.index;
+
+				if (pGDevice->device_info && pGDevice->device_info->device_properties)
+				{
+					auto _limits = &pGDevice->device_info->device_properties->limits;
+					this->_alignment = std::max<VkDeviceSize>(this->_alignment, _limits->optimalBufferCopyOffsetAlignment);
+					this->_alignment = std::max<VkDeviceSize>(this->_alignment, _limits->nonCoherentAtomSize);
+				}
+
+				if (_create_command_pool(this->_transfer_queue.index, this->_transfer_command_pool) == W_FAILED) return W_FAILED;
+				if (this->_dedicated_transfer_queue &&
+					_create_command_pool(this->_graphics_queue.index, this->_graphics_command_pool) == W_FAILED) return W_FAILED;
+
+				if (_create_staging_buffer(pRingSize, this->_ring) == W_FAILED)
+				{
+					V(W_FAILED, "creating staging ring buffer for graphics device: " + this->_gDevice->get_info(), this->_name, 3, false);
+					return W_FAILED;
+				}
+				this->_ring_size = pRingSize;
+				this->_ring_head = 0;
+				this->_ring_tail = 0;
+
+				logger.write("upload manager initialized with " + std::to_string(pRingSize / (1024 * 1024)) + "MB staging ring buffer on " +
+					(this->_dedicated_transfer_queue ? "dedicated transfer queue" : "graphics queue"));
+
+				return W_PASSED;
+			}
+
+			W_RESULT upload_buffer(
+				_In_ const void* pData,
+				_In_ const VkDeviceSize& pSize,
+				_In_ const VkBuffer& pDstBuffer,
+				_In_ const VkDeviceSize& pDstOffset,
+				_In_ const VkAccessFlags& pDstAccessMask,
+				_In_ const VkPipelineStageFlags& pDstStageMask,
+				_Out_opt_ uint64_t* pTicket)
+			{
+				if (!pData || !pSize || !pDstBuffer) return W_FAILED;
+
+				std::lock_guard<std::mutex> _lock(this->_mutex);
+				if (!this->_gDevice) return W_FAILED;
+
+				VkBuffer _src_buffer = 0;
+				VkDeviceSize _src_offset = 0;
+				if (_stage(pData, pSize, _src_buffer, _src_offset) == W_FAILED) return W_FAILED;
+
+				auto _batch = _get_batch();
+				if (!_batch) return W_FAILED;
+
+				const VkBufferCopy _copy_region =
+				{
+					_src_offset,                                    // SrcOffset
+					pDstOffset,                                     // DstOffset
+					pSize                                           // Size
+				};
+				vkCmdCopyBuffer(_batch->transfer_command_buffer, _src_buffer, pDstBuffer, 1, &_copy_region);
+
+				VkBufferMemoryBarrier _barrier = {};
+				_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+				_barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				_barrier.dstAccessMask = pDstAccessMask;
+				_barrier.srcQueueFamilyIndex = this->_dedicated_transfer_queue ? this->_transfer_queue.index : VK_QUEUE_FAMILY_IGNORED;
+				_barrier.dstQueueFamilyIndex = this->_dedicated_transfer_queue ? this->_graphics_queue.index : VK_QUEUE_FAMILY_IGNORED;
+				_barrier.buffer = pDstBuffer;
+				_barrier.offset = pDstOffset;
+				_barrier.size = pSize;
+
+				_batch->buffer_barriers.push_back(_barrier);
+				_batch->dst_stage_mask |= pDstStageMask;
+
+				this->_statistics.number_of_uploads++;
+				this->_statistics.uploaded_bytes += pSize;
+				if (pTicket) *pTicket = _batch->ticket;
+
+				return W_PASSED;
+			}
+
+			W_RESULT upload_image(
+				_In_ const void* pData,
+				_In_ const VkDeviceSize& pSize,
+				_In_ const VkImage& pDstImage,
+				_In_ const VkImageSubresourceRange& pSubresourceRange,
+				_In_ const std::vector<VkBufferImageCopy>& pRegions,
+				_In_ const VkImageLayout& pFinalLayout,
+				_Out_opt_ uint64_t* pTicket)
+			{
+				if (!pData || !pSize || !pDstImage || pRegions.empty()) return W_FAILED;
+
+				std::lock_guard<std::mutex> _lock(this->_mutex);
+				if (!this->_gDevice) return W_FAILED;
+
+				VkBuffer _src_buffer = 0;
+				VkDeviceSize _src_offset = 0;
+				if (_stage(pData, pSize, _src_buffer, _src_offset) == W_FAILED) return W_FAILED;
+
+				auto _batch = _get_batch();
+				if (!_batch) return W_FAILED;
+
+				VkImageMemoryBarrier _barrier = {};
+				_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				_barrier.srcAccessMask = 0;
+				_barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				_barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+				_barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				_barrier.image = pDstImage;
+				_barrier.subresourceRange = pSubresourceRange;
+
+				vkCmdPipelineBarrier(_batch->transfer_command_buffer,
+					VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+					VK_PIPELINE_STAGE_TRANSFER_BIT,
+					0,
+					0,
+					nullptr,
+					0,
+					nullptr,
+					1,
+					&_barrier);
+
+				//offsets of regions are relative to data
+				auto _regions = pRegions;
+				for (auto& _region : _regions)
+				{
+					_region.bufferOffset += _src_offset;
+				}
+				vkCmdCopyBufferToImage(_batch->transfer_command_buffer,
+					_src_buffer,
+					pDstImage,
+					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+					static_cast<uint32_t>(_regions.size()),
+					_regions.data());
+
+				//transition to final layout will be recorded on submit
+				_barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				_barrier.newLayout = pFinalLayout;
+				w_graphics_device_manager::set_src_dst_masks_of_image_barrier(_barrier);
+				_barrier.srcQueueFamilyIndex = this->_dedicated_transfer_queue ? this->_transfer_queue.index : VK_QUEUE_FAMILY_IGNORED;
+				_barrier.dstQueueFamilyIndex = this->_dedicated_transfer_queue ? this->_graphics_queue.index : VK_QUEUE_FAMILY_IGNORED;
+
+				_batch->image_barriers.push_back(_barrier);
+				_batch->dst_stage_mask |= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+				this->_statistics.number_of_uploads++;
+				this->_statistics.uploaded_bytes += pSize;
+				if (pTicket) *pTicket = _batch->ticket;
+
+				return W_PASSED;
+			}
+
+			W_RESULT copy_image(
+				_In_ const VkImage& pSrcImage,
+				_In_ const VkImageLayout& pSrcLayout,
+				_In_ const VkImageSubresourceRange& pSrcSubresourceRange,
+				_In_ const VkImage& pDstImage,
+				_In_ const VkImageSubresourceRange& pDstSubresourceRange,
+				_In_ const std::vector<VkImageCopy>& pRegions,
+				_In_ const VkImageLayout& pFinalLayout,
+				_Out_opt_ uint64_t* pTicket)
+			{
+				if (!pSrcImage || !pDstImage || pRegions.empty()) return W_FAILED;
+
+				std::lock_guard<std::mutex> _lock(this->_mutex);
+				if (!this->_gDevice) return W_FAILED;
+
+				auto _batch = _get_batch();
+				if (!_batch) return W_FAILED;
+
+				//source image is owned by graphics queue, so copy will be recorded on submit
+				w_upload_image_copy _copy;
+				_copy.src_image = pSrcImage;
+				_copy.src_layout = pSrcLayout;
+				_copy.src_subresource_range = pSrcSubresourceRange;
+				_copy.dst_image = pDstImage;
+				_copy.dst_subresource_range = pDstSubresourceRange;
+				_copy.regions = pRegions;
+				_copy.final_layout = pFinalLayout;
+				_batch->image_copies.push_back(_copy);
+
+				this->_statistics.number_of_image_copies++;
+				if (pTicket) *pTicket = _batch->ticket;
+
+				return W_PASSED;
+			}
+
+			W_RESULT submit()
+			{
+				std::lock_guard<std::mutex> _lock(this->_mutex);
+				return _submit_current();
+			}
+
+			void update()
+			{
+				std::lock_guard<std::mutex> _lock(this->_mutex);
+				_retire_completed_batches();
+			}
+
+			W_RESULT wait(_In_ const uint64_t& pTicket)
+			{
+				std::lock_guard<std::mutex> _lock(this->_mutex);
+				if (pTicket == 0 || pTicket <= this->_last_completed_ticket) return W_PASSED;
+
+				if (this->_current && this->_current->ticket == pTicket)
+				{
+					if (_submit_current() == W_FAILED) return W_FAILED;
+				}
+
+				for (auto _batch : this->_in_flight)
+				{
+					if (_batch->ticket == pTicket)
+					{
+						if (vkWaitForFences(this->_gDevice->vk_device, 1, &_batch->fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT) != VK_SUCCESS)
+						{
+							V(W_FAILED, "waiting for upload batch " + std::to_string(pTicket) + " on graphics device: " + this->_gDevice->get_info(),
+								this->_name, 3, false);
+							return W_FAILED;
+						}
+						break;
+					}
+				}
+				_retire_completed_batches();
+
+				return W_PASSED;
+			}
+
+			W_RESULT wait_all()
+			{
+				std::lock_guard<std::mutex> _lock(this->_mutex);
+				return _wait_all();
+			}
+
+			ULONG release()
+			{
+				std::lock_guard<std::mutex> _lock(this->_mutex);
+				if (!this->_gDevice) return 1;
+
+				_wait_all();
+
+				auto _device = this->_gDevice->vk_device;
+				for (auto _batch : this->_batches)
+				{
+					for (auto& _buffer : _batch->oversized_buffers)
+					{
+						_destroy_staging_buffer(_buffer);
+					}
+					if (_batch->fence)
+					{
+						vkDestroyFence(_device, _batch->fence, nullptr);
+					}
+					if (_batch->transfer_done_semaphore)
+					{
+						vkDestroySemaphore(_device, _batch->transfer_done_semaphore, nullptr);
+					}
+					delete _batch;
+				}
+				this->_batches.clear();
+				this->_free_batches.clear();
+				this->_in_flight.clear();
+				this->_current = nullptr;
+
+				//command buffers will be freed by their pools
+				if (this->_transfer_command_pool)
+				{
+					vkDestroyCommandPool(_device, this->_transfer_command_pool, nullptr);
+					this->_transfer_command_pool = 0;
+				}
+				if (this->_graphics_command_pool)
+				{
+					vkDestroyCommandPool(_device, this->_graphics_command_pool, nullptr);
+					this->_graphics_command_pool = 0;
+				}
+
+				_destroy_staging_buffer(this->_ring);
+				this->_ring_size = 0;
+				this->_ring_head = 0;
+				this->_ring_tail = 0;
+
+				this->_gDevice = nullptr;
+
+				return 0;
+			}
+
+#pragma region Getters
+
+			bool get_is_completed(_In_ const uint64_t& pTicket)
+			{
+				std::lock_guard<std::mutex> _lock(this->_mutex);
+				_retire_completed_batches();
+				return pTicket <= this->_last_completed_ticket;
+			}
+
+			w_upload_manager_statistics get_statistics()
+			{
+				std::lock_guard<std::mutex> _lock(this->_mutex);
+				auto _statistics = this->_statistics;
+				_statistics.dedicated_transfer_queue = this->_dedicated_transfer_queue;
+				_statistics.ring_size = this->_ring_size;
+				_statistics.ring_used_bytes = this->_ring_head - this->_ring_tail;
+				return _statistics;
+			}
+
+#pragma endregion
+
+		private:
+			W_RESULT _create_command_pool(_In_ const uint32_t& pQueueFamilyIndex, _Out_ VkCommandPool& pCommandPool)
+			{
+				VkCommandPoolCreateInfo _command_pool_info = {};
+				_command_pool_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+				_command_pool_info.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT | VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+				_command_pool_info.queueFamilyIndex = pQueueFamilyIndex;
+
+				if (vkCreateCommandPool(this->_gDevice->vk_device, &_command_pool_info, nullptr, &pCommandPool))
+				{
+					V(W_FAILED, "creating command pool of queue family " + std::to_string(pQueueFamilyIndex) +
+						" for graphics device: " + this->_gDevice->get_info(), this->_name, 3, false);
+					pCommandPool = 0;
+					return W_FAILED;
+				}
+				return W_PASSED;
+			}
+
+			W_RESULT _create_staging_buffer(_In_ const VkDeviceSize& pSize, _Inout_ w_upload_staging_buffer& pStagingBuffer)
+			{
+				const VkBufferCreateInfo _buffer_create_info =
+				{
+					VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,             // Type
+					nullptr,                                          // Next
+					0,                                                // Flags
+					pSize,                                            // Size
+					VK_BUFFER_USAGE_TRANSFER_SRC_BIT,                 // Usage
+					VK_SHARING_MODE_EXCLUSIVE,                        // SharingMode
+					0,                                                // QueueFamilyIndexCount
+					nullptr                                           // QueueFamilyIndices
+				};
+
+				if (vkCreateBuffer(this->_gDevice->vk_device, &_buffer_create_info, nullptr, &pStagingBuffer.buffer))
+				{
+					pStagingBuffer.buffer = 0;
+					return W_FAILED;
+				}
+
+				VkMemoryRequirements _memory_requirements;
+				vkGetBufferMemoryRequirements(this->_gDevice->vk_device, pStagingBuffer.buffer, &_memory_requirements);
+
+				//host visible memories are mapped persistently by memory allocator
+				if (this->_gDevice->memory_allocator->allocate(
+					_memory_requirements,
+					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+					false,
+					pStagingBuffer.allocation) == W_FAILED ||
+					!pStagingBuffer.allocation.mapped ||
+					vkBindBufferMemory(this->_gDevice->vk_device,
+						pStagingBuffer.buffer,
+						pStagingBuffer.allocation.memory.handle,
+						pStagingBuffer.allocation.offset) != VK_SUCCESS)
+				{
+					_destroy_staging_buffer(pStagingBuffer);
+					return W_FAILED;
+				}
+
+				return W_PASSED;
+			}
+
+			void _destroy_staging_buffer(_Inout_ w_upload_staging_buffer& pStagingBuffer)
+			{
+				if (pStagingBuffer.buffer)
+				{
+					vkDestroyBuffer(this->_gDevice->vk_device, pStagingBuffer.buffer, nullptr);
+					pStagingBuffer.buffer = 0;
+				}
+				if (pStagingBuffer.allocation.memory.handle)
+				{
+					this->_gDevice->memory_allocator->free(pStagingBuffer.allocation);
+				}
+				pStagingBuffer.allocation = w_memory_allocation();
+			}
+
+			//copy data to staging memory, it may submit the current batch and wait for GPU if ring buffer is full
+			W_RESULT _stage(
+				_In_ const void* pData,
+				_In_ const VkDeviceSize& pSize,
+				_Out_ VkBuffer& pSrcBuffer,
+				_Out_ VkDeviceSize& pSrcOffset)
+			{
+				if (pSize > this->_ring_size)
+				{
+					//bigger than ring buffer, use a staging buffer which will be released once batch completed
+					auto _batch = _get_batch();
+					if (!_batch) return W_FAILED;
+
+					w_upload_staging_buffer _staging_buffer;
+					if (_create_staging_buffer(pSize, _staging_buffer) == W_FAILED)
+					{
+						V(W_FAILED, "creating staging buffer of " + std::to_string(pSize) + " bytes for graphics device: " +
+							this->_gDevice->get_info(), this->_name, 3, false);
+						return W_FAILED;
+					}
+					std::memcpy(_staging_buffer.allocation.mapped, pData, static_cast<size_t>(pSize));
+					this->_gDevice->memory_allocator->flush(_staging_buffer.allocation, 0, pSize);
+
+					_batch->oversized_buffers.push_back(_staging_buffer);
+					this->_statistics.number_of_oversized_uploads++;
+
+					pSrcBuffer = _staging_buffer.buffer;
+					pSrcOffset = 0;
+					return W_PASSED;
+				}
+
+				while (true)
+				{
+					//head and tail are increased monotonically, allocations never wrap around the end of ring
+					auto _offset = (this->_ring_head + this->_alignment - 1) / this->_alignment * this->_alignment;
+					if ((_offset % this->_ring_size) + pSize > this->_ring_size)
+					{
+						_offset = (_offset / this->_ring_size + 1) * this->_ring_size;
+					}
+					if (_offset + pSize - this->_ring_tail <= this->_ring_size)
+					{
+						this->_ring_head = _offset + pSize;
+						pSrcBuffer = this->_ring.buffer;
+						pSrcOffset = _offset % this->_ring_size;
+
+						std::memcpy(static_cast<uint8_t*>(this->_ring.allocation.mapped) + pSrcOffset, pData, static_cast<size_t>(pSize));
+						this->_gDevice->memory_allocator->flush(this->_ring.allocation, pSrcOffset, pSize);
+
+						return W_PASSED;
+					}
+
+					//ring buffer is full, submit pending uploads and wait for the oldest batch
+					this->_statistics.number_of_ring_waits++;
+					if (_submit_current() == W_FAILED) return W_FAILED;
+
+					if (this->_in_flight.empty())
+					{
+						//nothing is in flight, so start from the beginning of ring
+						this->_ring_head = (this->_ring_head + this->_ring_size - 1) / this->_ring_size * this->_ring_size;
+						this->_ring_tail = this->_ring_head;
+						continue;
+					}
+
+					auto _oldest = this->_in_flight.front();
+					if (vkWaitForFences(this->_gDevice->vk_device, 1, &_oldest->fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT) != VK_SUCCESS)
+					{
+						V(W_FAILED, "waiting for upload batch on graphics device: " + this->_gDevice->get_info(), this->_name, 3, false);
+						return W_FAILED;
+					}
+					_retire_completed_batches();
+				}
+			}
+
+			//get the recording batch, a new batch will be started if there is no recording batch
+			w_upload_batch* _get_batch()
+			{
+				if (this->_current) return this->_current;
+
+				w_upload_batch* _batch = nullptr;
+				if (!this->_free_batches.empty())
+				{
+					_batch = this->_free_batches.back();
+					this->_free_batches.pop_back();
+				}
+				else
+				{
+					_batch = _create_batch();
+					if (!_batch) return nullptr;
+				}
+
+				const VkCommandBufferBeginInfo _begin_info =
+				{
+					VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,        // Type
+					nullptr,                                            // Next
+					VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,        // Flags
+					nullptr                                             // InheritanceInfo
+				};
+				if (vkBeginCommandBuffer(_batch->transfer_command_buffer, &_begin_info))
+				{
+					V(W_FAILED, "begining command buffer of upload batch for graphics device: " + this->_gDevice->get_info(), this->_name, 3, false);
+					this->_free_batches.push_back(_batch);
+					return nullptr;
+				}
+
+				_batch->ticket = ++this->_last_ticket;
+				_batch->recording = true;
+				this->_current = _batch;
+
+				return _batch;
+			}
+
+			w_upload_batch* _create_batch()
+			{
+				auto _device = this->_gDevice->vk_device;
+				auto _batch = new (std::nothrow) w_upload_batch();
+				if (!_batch) return nullptr;
+				this->_batches.push_back(_batch);
+
+				VkCommandBufferAllocateInfo _allocate_info = {};
+				_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				_allocate_info.commandPool = this->_transfer_command_pool;
+				_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+				_allocate_info.commandBufferCount = 1;
+
+				auto _hr = vkAllocateCommandBuffers(_device, &_allocate_info, &_batch->transfer_command_buffer);
+				if (_hr == VK_SUCCESS && this->_dedicated_transfer_queue)
+				{
+					_allocate_info.commandPool = this->_graphics_command_pool;
+					_hr = vkAllocateCommandBuffers(_device, &_allocate_info, &_batch->acquire_command_buffer);
+					if (_hr == VK_SUCCESS)
+					{
+						VkSemaphoreCreateInfo _semaphore_create_info = {};
+						_semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+						_hr = vkCreateSemaphore(_device, &_semaphore_create_info, nullptr, &_batch->transfer_done_semaphore);
+					}
+				}
+				if (_hr == VK_SUCCESS)
+				{
+					VkFenceCreateInfo _fence_create_info = {};
+					_fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+					_hr = vkCreateFence(_device, &_fence_create_info, nullptr, &_batch->fence);
+				}
+				if (_hr != VK_SUCCESS)
+				{
+					V(W_FAILED, "creating upload batch for graphics device: " + this->_gDevice->get_info(), this->_name, 3, false);
+					//resources of batch will be released by release function
+					this->_free_batches.push_back(_batch);
+					return nullptr;
+				}
+
+				return _batch;
+			}
+
+			W_RESULT _submit_current()
+			{
+				if (!this->_current) return W_PASSED;
+
+				auto _batch = this->_current;
+				this->_current = nullptr;
+
+				auto _dst_stage_mask = _batch->dst_stage_mask ? _batch->dst_stage_mask : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+				auto _buffer_barriers = _batch->buffer_barriers;
+				auto _image_barriers = _batch->image_barriers;
+
+				VkResult _hr;
+				if (this->_dedicated_transfer_queue)
+				{
+					//release ownership on transfer queue
+					for (auto& _barrier : _buffer_barriers) _barrier.dstAccessMask = 0;
+					for (auto& _barrier : _image_barriers) _barrier.dstAccessMask = 0;
+					vkCmdPipelineBarrier(_batch->transfer_command_buffer,
+						VK_PIPELINE_STAGE_TRANSFER_BIT,
+						VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+						0,
+						0,
+						nullptr,
+						static_cast<uint32_t>(_buffer_barriers.size()),
+						_buffer_barriers.data(),
+						static_cast<uint32_t>(_image_barriers.size()),
+						_image_barriers.data());
+					_hr = vkEndCommandBuffer(_batch->transfer_command_buffer);
+
+					//acquire ownership on graphics queue
+					if (_hr == VK_SUCCESS)
+					{
+						const VkCommandBufferBeginInfo _begin_info =
+						{
+							VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,        // Type
+							nullptr,                                            // Next
+							VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT,        // Flags
+							nullptr                                             // InheritanceInfo
+						};
+						_hr = vkBeginCommandBuffer(_batch->acquire_command_buffer, &_begin_info);
+					}
+					if (_hr == VK_SUCCESS)
+					{
+						for (auto& _barrier : _batch->buffer_barriers) _barrier.srcAccessMask = 0;
+						for (auto& _barrier : _batch->image_barriers) _barrier.srcAccessMask = 0;
+						vkCmdPipelineBarrier(_batch->acquire_command_buffer,
+							VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+							_dst_stage_mask,
+							0,
+							0,
+							nullptr,
+							static_cast<uint32_t>(_batch->buffer_barriers.size()),
+							_batch->buffer_barriers.data(),
+							static_cast<uint32_t>(_batch->image_barriers.size()),
+							_batch->image_barriers.data());
+						_record_image_copies(_batch->acquire_command_buffer, _batch);
+						_hr = vkEndCommandBuffer(_batch->acquire_command_buffer);
+					}
+					if (_hr == VK_SUCCESS)
+					{
+						VkSubmitInfo _submit_info = {};
+						_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+						_submit_info.commandBufferCount = 1;
+						_submit_info.pCommandBuffers = &_batch->transfer_command_buffer;
+						_submit_info.signalSemaphoreCount = 1;
+						_submit_info.pSignalSemaphores = &_batch->transfer_done_semaphore;
+						_hr = vkQueueSubmit(this->_transfer_queue.queue, 1, &_submit_info, 0);
+					}
+					if (_hr == VK_SUCCESS)
+					{
+						const VkPipelineStageFlags _wait_stage_mask = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+						VkSubmitInfo _submit_info = {};
+						_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+						_submit_info.waitSemaphoreCount = 1;
+						_submit_info.pWaitSemaphores = &_batch->transfer_done_semaphore;
+						_submit_info.pWaitDstStageMask = &_wait_stage_mask;
+						_submit_info.commandBufferCount = 1;
+						_submit_info.pCommandBuffers = &_batch->acquire_command_buffer;
+						_hr = vkQueueSubmit(this->_graphics_queue.queue, 1, &_submit_info, _batch->fence);
+					}
+				}
+				else
+				{
+					vkCmdPipelineBarrier(_batch->transfer_command_buffer,
+						VK_PIPELINE_STAGE_TRANSFER_BIT,
+						_dst_stage_mask,
+						0,
+						0,
+						nullptr,
+						static_cast<uint32_t>(_buffer_barriers.size()),
+						_buffer_barriers.data(),
+						static_cast<uint32_t>(_image_barriers.size()),
+						_image_barriers.data());
+					_record_image_copies(_batch->transfer_command_buffer, _batch);
+					_hr = vkEndCommandBuffer(_batch->transfer_command_buffer);
+					if (_hr == VK_SUCCESS)
+					{
+						VkSubmitInfo _submit_info = {};
+						_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+						_submit_info.commandBufferCount = 1;
+						_submit_info.pCommandBuffers = &_batch->transfer_command_buffer;
+						_hr = vkQueueSubmit(this->_graphics_queue.queue, 1, &_submit_info, _batch->fence);
+					}
+				}
+
+				_batch->recording = false;
+				_batch->ring_end = this->_ring_head;
+				if (_hr != VK_SUCCESS)
+				{
+					V(W_FAILED, "submiting upload batch " + std::to_string(_batch->ticket) + " for graphics device: " + this->_gDevice->get_info(),
+						this->_name, 3, false);
+					//uploads of this batch are lost, so wait for the others then reuse the ring space of this batch
+					_wait_in_flight();
+					this->_last_completed_ticket = _batch->ticket;
+					_recycle(_batch);
+					return W_FAILED;
+				}
+
+				this->_in_flight.push_back(_batch);
+				this->_statistics.submitted_batches++;
+
+				return W_PASSED;
+			}
+
+			//record copies of batch into a command buffer of graphics queue, layout of source images will be restored after copy
+			void _record_image_copies(_In_ const VkCommandBuffer& pCommandBuffer, _In_ w_upload_batch* pBatch)
+			{
+				for (auto& _copy : pBatch->image_copies)
+				{
+					VkImageMemoryBarrier _barriers[2] = {};
+					_barriers[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+					_barriers[0].srcAccessMask = 0;
+					_barriers[0].dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+					_barriers[0].oldLayout = _copy.src_layout;
+					_barriers[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+					_barriers[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+					_barriers[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+					_barriers[0].image = _copy.src_image;
+					_barriers[0].subresourceRange = _copy.src_subresource_range;
+
+					_barriers[1] = _barriers[0];
+					_barriers[1].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+					_barriers[1].oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+					_barriers[1].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+					_barriers[1].image = _copy.dst_image;
+					_barriers[1].subresourceRange = _copy.dst_subresource_range;
+
+					//source image may be read by commands which have been submitted before
+					vkCmdPipelineBarrier(pCommandBuffer,
+						VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+						VK_PIPELINE_STAGE_TRANSFER_BIT,
+						0,
+						0,
+						nullptr,
+						0,
+						nullptr,
+						2,
+						_barriers);
+
+					vkCmdCopyImage(pCommandBuffer,
+						_copy.src_image,
+						VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+						_copy.dst_image,
+						VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+						static_cast<uint32_t>(_copy.regions.size()),
+						_copy.regions.data());
+
+					_barriers[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+					_barriers[0].newLayout = _copy.src_layout;
+					w_graphics_device_manager::set_src_dst_masks_of_image_barrier(_barriers[0]);
+
+					_barriers[1].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+					_barriers[1].newLayout = _copy.final_layout;
+					w_graphics_device_manager::set_src_dst_masks_of_image_barrier(_barriers[1]);
+
+					vkCmdPipelineBarrier(pCommandBuffer,
+						VK_PIPELINE_STAGE_TRANSFER_BIT,
+						VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+						0,
+						0,
+						nullptr,
+						0,
+						nullptr,
+						2,
+						_barriers);
+				}
+			}
+
+			//wait for all batches which have been submitted
+			void _wait_in_flight()
+			{
+				for (auto _batch : this->_in_flight)
+				{
+					vkWaitForFences(this->_gDevice->vk_device, 1, &_batch->fence, VK_TRUE, DEFAULT_FENCE_TIMEOUT);
+				}
+				_retire_completed_batches();
+			}
+
+			W_RESULT _wait_all()
+			{
+				auto _hr = _submit_current();
+				_wait_in_flight();
+				return _hr;
+			}
+
+			//batches are completed in order of submission, so only the oldest ones need to be checked
+			void _retire_completed_batches()
+			{
+				while (!this->_in_flight.empty())
+				{
+					auto _batch = this->_in_flight.front();
+					if (vkGetFenceStatus(this->_gDevice->vk_device, _batch->fence) != VK_SUCCESS) break;
+
+					this->_in_flight.pop_front();
+					this->_last_completed_ticket = _batch->ticket;
+					this->_statistics.completed_batches++;
+					_recycle(_batch);
+				}
+			}
+
+			void _recycle(_In_ w_upload_batch* pBatch)
+			{
+				this->_ring_tail = std::max(this->_ring_tail, pBatch->ring_end);
+
+				for (auto& _buffer : pBatch->oversized_buffers)
+				{
+					_destroy_staging_buffer(_buffer);
+				}
+				pBatch->oversized_buffers.clear();
+				pBatch->buffer_barriers.clear();
+				pBatch->image_barriers.clear();
+				pBatch->image_copies.clear();
+				pBatch->dst_stage_mask = 0;
+
+				vkResetFences(this->_gDevice->vk_device, 1, &pBatch->fence);
+				vkResetCommandBuffer(pBatch->transfer_command_buffer, 0);
+				if (pBatch->acquire_command_buffer)
+				{
+					vkResetCommandBuffer(pBatch->acquire_command_buffer, 0);
+				}
+
+				this->_free_batches.push_back(pBatch);
+			}
+
+			std::string												_name;
+			w_graphics_device*										_gDevice;
+			std::mutex												_mutex;
+
+			w_queue													_graphics_queue;
+			w_queue													_transfer_queue;
+			bool													_dedicated_transfer_queue;
+			VkCommandPool											_transfer_command_pool;
+			VkCommandPool											_graphics_command_pool;
+
+			w_upload_staging_buffer									_ring;
+			VkDeviceSize											_alignment;
+			VkDeviceSize											_ring_size;
+			VkDeviceSize											_ring_head;
+			VkDeviceSize											_ring_tail;
+
+			std::vector<w_upload_batch*>							_batches;
+			std::vector<w_upload_batch*>							_free_batches;
+			std::deque<w_upload_batch*>								_in_flight;
+			w_upload_batch*											_current;
+
+			uint64_t												_last_ticket;
+			uint64_t												_last_completed_ticket;
+			w_upload_manager_statistics								_statistics;
+		};
+	}
+}
+
+using namespace wolf::graphics;
+
+w_upload_manager::w_upload_manager() : _pimp(new w_upload_manager_pimp())
+{
+}
+
+w_upload_manager::~w_upload_manager()
+{
+	release();
+}
+
+W_RESULT w_upload_manager::initialize(
+	_In_ w_graphics_device* pGDevice,
+	_In_ const VkDeviceSize& pRingSize)
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->initialize(pGDevice, pRingSize);
+}
+
+W_RESULT w_upload_manager::upload_buffer(
+	_In_ const void* pData,
+	_In_ const VkDeviceSize& pSize,
+	_In_ const VkBuffer& pDstBuffer,
+	_In_ const VkDeviceSize& pDstOffset,
+	_In_ const VkAccessFlags& pDstAccessMask,
+	_In_ const VkPipelineStageFlags& pDstStageMask,
+	_Out_opt_ uint64_t* pTicket)
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->upload_buffer(pData, pSize, pDstBuffer, pDstOffset, pDstAccessMask, pDstStageMask, pTicket);
+}
+
+W_RESULT w_upload_manager::upload_image(
+	_In_ const void* pData,
+	_In_ const VkDeviceSize& pSize,
+	_In_ const VkImage& pDstImage,
+	_In_ const VkImageSubresourceRange& pSubresourceRange,
+	_In_ const std::vector<VkBufferImageCopy>& pRegions,
+	_In_ const VkImageLayout& pFinalLayout,
+	_Out_opt_ uint64_t* pTicket)
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->upload_image(pData, pSize, pDstImage, pSubresourceRange, pRegions, pFinalLayout, pTicket);
+}
+
+W_RESULT w_upload_manager::copy_image(
+	_In_ const VkImage& pSrcImage,
+	_In_ const VkImageLayout& pSrcLayout,
+	_In_ const VkImageSubresourceRange& pSrcSubresourceRange,
+	_In_ const VkImage& pDstImage,
+	_In_ const VkImageSubresourceRange& pDstSubresourceRange,
+	_In_ const std::vector<VkImageCopy>& pRegions,
+	_In_ const VkImageLayout& pFinalLayout,
+	_Out_opt_ uint64_t* pTicket)
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->copy_image(pSrcImage, pSrcLayout, pSrcSubresourceRange, pDstImage, pDstSubresourceRange,
+		pRegions, pFinalLayout, pTicket);
+}
+
+W_RESULT w_upload_manager::submit()
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->submit();
+}
+
+void w_upload_manager::update()
+{
+	if (!this->_pimp) return;
+
+	this->_pimp->update();
+}
+
+W_RESULT w_upload_manager::wait(_In_ const uint64_t& pTicket)
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->wait(pTicket);
+}
+
+W_RESULT w_upload_manager::wait_all()
+{
+	if (!this->_pimp) return W_FAILED;
+
+	return this->_pimp->wait_all();
+}
+
+ULONG w_upload_manager::release()
+{
+	SAFE_DELETE(this->_pimp);
+	return 0;
+}
+
+#pragma region Getters
+
+bool w_upload_manager::get_is_completed(_In_ const uint64_t& pTicket)
+{
+	if (!this->_pimp) return true;
+
+	return this->_pimp->get_is_completed(pTicket);
+}
+
+w_upload_manager_statistics w_upload_manager::get_statistics()
+{
+	if (!this->_pimp) return w_upload_manager_statistics();
+
+	return this->_pimp->get_statistics();
+}
+
+#pragma endregion
@@ -0,0 +1,166 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_upload_manager.h
+	Description		 : Batched uploads of buffers and images through a persistently mapped staging ring buffer
+	Comment          : Copies are recorded into one command buffer of transfer queue and submitted together, each batch has a fence
+					   and the space of ring buffer will be reused once that fence has been signaled.
+					   If transfer queue belongs to another queue family, ownership of resources will be released on transfer queue
+					   and acquired on graphics queue. Pending uploads are submitted before each w_graphics_device::submit, so
+					   command buffers of graphics queue see the uploaded data without waiting for device to become idle
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_UPLOAD_MANAGER_H__
+#define __W_UPLOAD_MANAGER_H__
+
+#include <w_graphics_headers.h>
+#include <w_render_export.h>
+
+namespace wolf
+{
+	namespace graphics
+	{
+		struct w_upload_manager_statistics
+		{
+			//true if copies are executed on a queue family other than graphics
+			bool			dedicated_transfer_queue = false;
+			//size of staging ring buffer
+			VkDeviceSize	ring_size = 0;
+			//bytes of ring buffer which are used by batches in flight
+			VkDeviceSize	ring_used_bytes = 0;
+			//number of uploads since initializing
+			uint64_t		number_of_uploads = 0;
+			//bytes which have been uploaded since initializing
+			uint64_t		uploaded_bytes = 0;
+			//number of submitted batches
+			uint64_t		submitted_batches = 0;
+			//number of batches which have been completed by GPU
+			uint64_t		completed_batches = 0;
+			//number of times that uploads had to wait for GPU because ring buffer was full
+			uint64_t		number_of_ring_waits = 0;
+			//number of uploads which were bigger than ring buffer and had their own staging buffers
+			uint64_t		number_of_oversized_uploads = 0;
+			//number of copies between images which did not need staging memory
+			uint64_t		number_of_image_copies = 0;
+		};
+
+		class w_upload_manager_pimp;
+		class w_upload_manager
+		{
+		public:
+			W_EXP w_upload_manager();
+			W_EXP ~w_upload_manager();
+
+			/*
+				initialize upload manager for graphics device, this function will be called by graphics device manager
+				@param pGDevice, graphics device
+				@param pRingSize, size of staging ring buffer in bytes
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT initialize(
+				_In_ w_graphics_device* pGDevice,
+				_In_ const VkDeviceSize& pRingSize);
+
+			/*
+				copy data to the ring buffer and record a copy to the destination buffer in the current batch
+				@param pData, source data, will be copied before returning
+				@param pSize, size of data in bytes
+				@param pDstBuffer, destination buffer which must be created with VK_BUFFER_USAGE_TRANSFER_DST_BIT and must not be in use by GPU
+				@param pDstOffset, offset of destination buffer
+				@param pDstAccessMask, how destination buffer will be accessed after upload, i.e. VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT
+				@param pDstStageMask, pipeline stages which will access destination buffer after upload
+				@param pTicket, if not null, ticket of the batch which contains this upload will be stored in it
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT upload_buffer(
+				_In_ const void* pData,
+				_In_ const VkDeviceSize& pSize,
+				_In_ const VkBuffer& pDstBuffer,
+				_In_ const VkDeviceSize& pDstOffset,
+				_In_ const VkAccessFlags& pDstAccessMask,
+				_In_ const VkPipelineStageFlags& pDstStageMask,
+				_Out_opt_ uint64_t* pTicket = nullptr);
+
+			/*
+				copy data to the ring buffer and record a copy to the destination image in the current batch, the image will be
+				transitioned from undefined layout to transfer destination and then to the final layout
+				@param pData, source data, will be copied before returning
+				@param pSize, size of data in bytes
+				@param pDstImage, destination image which must be created with VK_IMAGE_USAGE_TRANSFER_DST_BIT and must not be in use by GPU
+				@param pSubresourceRange, subresources which will be transitioned
+				@param pRegions, regions of copy, buffer offsets are relative to pData
+				@param pFinalLayout, layout of image after upload
+				@param pTicket, if not null, ticket of the batch which contains this upload will be stored in it
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT upload_image(
+				_In_ const void* pData,
+				_In_ const VkDeviceSize& pSize,
+				_In_ const VkImage& pDstImage,
+				_In_ const VkImageSubresourceRange& pSubresourceRange,
+				_In_ const std::vector<VkBufferImageCopy>& pRegions,
+				_In_ const VkImageLayout& pFinalLayout,
+				_Out_opt_ uint64_t* pTicket = nullptr);
+
+			/*
+				record a copy from an image which is owned by graphics queue to the destination image in the current batch,
+				the copy is executed on graphics queue after uploads of batch, so levels which are already on GPU do not need staging memory
+				@param pSrcImage, source image which must be created with VK_IMAGE_USAGE_TRANSFER_SRC_BIT and must not be released before the batch completed
+				@param pSrcLayout, current layout of source image, it will be restored after copy
+				@param pSrcSubresourceRange, subresources of source image which will be read
+				@param pDstImage, destination image which must be created with VK_IMAGE_USAGE_TRANSFER_DST_BIT and must not be in use by GPU
+				@param pDstSubresourceRange, subresources of destination image which will be transitioned, they must not be uploaded in the same batch
+				@param pRegions, regions of copy
+				@param pFinalLayout, layout of destination subresources after copy
+				@param pTicket, if not null, ticket of the batch which contains this copy will be stored in it
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT copy_image(
+				_In_ const VkImage& pSrcImage,
+				_In_ const VkImageLayout& pSrcLayout,
+				_In_ const VkImageSubresourceRange& pSrcSubresourceRange,
+				_In_ const VkImage& pDstImage,
+				_In_ const VkImageSubresourceRange& pDstSubresourceRange,
+				_In_ const std::vector<VkImageCopy>& pRegions,
+				_In_ const VkImageLayout& pFinalLayout,
+				_Out_opt_ uint64_t* pTicket = nullptr);
+
+			//submit all pending uploads as one batch, it does not wait for GPU
+			W_EXP W_RESULT submit();
+
+			//release ring space of batches which have been completed by GPU, it does not wait for GPU
+			W_EXP void update();
+
+			//wait for the batch of ticket, the batch will be submitted if it is still pending
+			W_EXP W_RESULT wait(_In_ const uint64_t& pTicket);
+
+			//submit pending uploads and wait for all batches
+			W_EXP W_RESULT wait_all();
+
+			//release all resources
+			W_EXP ULONG release();
+
+#pragma region Getters
+
+			//returns true if the batch of ticket has been completed by GPU
+			W_EXP bool get_is_completed(_In_ const uint64_t& pTicket);
+			W_EXP w_upload_manager_statistics get_statistics();
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_upload_manager(w_upload_manager const&);
+			w_upload_manager& operator= (w_upload_manager const&);
+
+			w_upload_manager_pimp*		_pimp;
+		};
+	}
+}
+
+#endif //__W_UPLOAD_MANAGER_H__
@@ -0,0 +1,515 @@
+#include "w_render_pch.h"
+#include "w_video_texture.h"
+#include "w_buffer.h"
+#include "w_fences.h"
+#include <chrono>
+
+namespace wolf
+{
+	namespace graphics
+	{
+		class w_video_texture_pimp
+		{
+		public:
+			w_video_texture_pimp() :
+				_name("w_video_texture"),
+				_gDevice(nullptr),
+				_mapped(nullptr),
+				_format(w_video_texture_format::VIDEO_TEXTURE_RGBA),
+				_number_of_planes(0),
+				_ring_size(0),
+				_width(0),
+				_height(0)
+			{
+				for (uint32_t i = 0; i < 3; ++i)
+				{
+					this->_textures[i] = nullptr;
+					this->_plane_offsets[i] = 0;
+					this->_row_pitches[i] = 0;
+					this->_plane_widths[i] = 0;
+					this->_plane_heights[i] = 0;
+					this->_texel_sizes[i] = 0;
+				}
+			}
+
+			~w_video_texture_pimp()
+			{
+				release();
+			}
+
+			W_RESULT initialize(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const uint32_t& pWidth,
+				_In_ const uint32_t& pHeight,
+				_In_ const w_video_texture_format& pFormat,
+				_In_ const uint32_t& pRingSize)
+			{
+				const std::string _trace_info = this->_name + "::initialize";
+
+				if (!pGDevice || !pGDevice->device_info || !pGDevice->device_info->device_properties ||
+					pWidth == 0 || pHeight == 0 || pRingSize == 0)
+				{
+					V(W_FAILED, "initializing video texture with invalid parameters", _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				this->_gDevice = pGDevice;
+				this->_format = pFormat;
+				this->_ring_size = pRingSize;
+				this->_width = pWidth;
+				this->_height = pHeight;
+
+				//each slot contains all planes, offsets and row pitches follow the optimal alignments of copying buffer to image
+				auto _limits = &pGDevice->device_info->device_properties->limits;
+				auto _row_alignment = static_cast<uint32_t>(std::max<VkDeviceSize>(4, _limits->optimalBufferCopyRowPitchAlignment));
+				auto _offset_alignment = static_cast<uint32_t>(std::max<VkDeviceSize>(16, _limits->optimalBufferCopyOffsetAlignment));
+
+				w_format _formats[3];
+				if (pFormat == w_video_texture_format::VIDEO_TEXTURE_YUV420P)
+				{
+					this->_number_of_planes = 3;
+					for (uint32_t i = 0; i < 3; ++i)
+					{
+						_formats[i] = w_format::R8_UNORM;
+						this->_texel_sizes[i] = 1;
+						this->_plane_widths[i] = i ? (pWidth + 1) / 2 : pWidth;
+						this->_plane_heights[i] = i ? (pHeight + 1) / 2 : pHeight;
+					}
+				}
+				else
+				{
+					this->_number_of_planes = 1;
+					_formats[0] = w_format::R8G8B8A8_UNORM;
+					this->_texel_sizes[0] = 4;
+					this->_plane_widths[0] = pWidth;
+					this->_plane_heights[0] = pHeight;
+				}
+
+				uint32_t _slot_size = 0;
+				for (uint32_t i = 0; i < this->_number_of_planes; ++i)
+				{
+					this->_plane_offsets[i] = _slot_size;
+					this->_row_pitches[i] = _align(this->_plane_widths[i] * this->_texel_sizes[i], _row_alignment);
+					_slot_size = _align(_slot_size + this->_row_pitches[i] * this->_plane_heights[i], _offset_alignment);
+				}
+				this->_statistics.slot_size = _slot_size;
+
+				auto _hr = this->_staging_buffer.load(
+					pGDevice,
+					_slot_size * pRingSize,
+					VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+					VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+				if (_hr == W_FAILED || this->_staging_buffer.bind() == W_FAILED)
+				{
+					V(W_FAILED, "loading staging ring of video texture for graphics device: " + this->_gDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				//memory remains mapped until releasing the video texture, so decoder threads can write into it
+				this->_mapped = static_cast<uint8_t*>(this->_staging_buffer.map());
+				if (!this->_mapped)
+				{
+					V(W_FAILED, "mapping staging ring of video texture for graphics device: " + this->_gDevice->get_info(), _trace_info, 3, false);
+					return W_FAILED;
+				}
+
+				for (uint32_t i = 0; i < this->_number_of_planes; ++i)
+				{
+					auto _texture = new (std::nothrow) w_texture();
+					if (!_texture)
+					{
+						V(W_FAILED, "allocating memory for texture of plane " + std::to_string(i), _trace_info, 3, false);
+						return W_FAILED;
+					}
+					this->_textures[i] = _texture;
+
+					_texture->set_format(_formats[i]);
+					if (_texture->initialize(pGDevice, this->_plane_widths[i], this->_plane_heights[i]) == W_FAILED ||
+						_texture->load() == W_FAILED)
+					{
+						V(W_FAILED, "loading texture of plane " + std::to_string(i) + " for graphics device: " + this->_gDevice->get_info(),
+							_trace_info, 3, false);
+						return W_FAILED;
+					}
+				}
+
+				return _clear();
+			}
+
+			W_RESULT get_staging_frame(
+				_In_ const uint32_t& pSlot,
+				_Inout_ w_video_texture_staging_frame& pFrame) const
+			{
+				pFrame = w_video_texture_staging_frame();
+				if (!this->_mapped || pSlot >= this->_ring_size) return W_FAILED;
+
+				auto _slot = this->_mapped + static_cast<size_t>(pSlot) * this->_statistics.slot_size;
+				for (uint32_t i = 0; i < this->_number_of_planes; ++i)
+				{
+					pFrame.planes[i] = _slot + this->_plane_offsets[i];
+					pFrame.row_pitches[i] = this->_row_pitches[i];
+				}
+				pFrame.number_of_planes = this->_number_of_planes;
+
+				return W_PASSED;
+			}
+
+			W_RESULT record_upload(
+				_In_ const w_command_buffer& pCommandBuffer,
+				_In_ const uint32_t& pSlot)
+			{
+				if (!this->_mapped || !pCommandBuffer.handle || pSlot >= this->_ring_size) return W_FAILED;
+
+				auto _start = std::chrono::steady_clock::now();
+
+				auto _cmd = pCommandBuffer.handle;
+				auto _slot_offset = static_cast<VkDeviceSize>(pSlot) * this->_statistics.slot_size;
+
+				VkImageMemoryBarrier _barriers[3];
+				VkBufferImageCopy _copies[3];
+				for (uint32_t i = 0; i < this->_number_of_planes; ++i)
+				{
+					_barriers[i] = _get_barrier(i, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+
+					_copies[i] = {};
+					_copies[i].bufferOffset = _slot_offset + this->_plane_offsets[i];
+					//row length is in texels
+					_copies[i].bufferRowLength = this->_row_pitches[i] / this->_texel_sizes[i];
+					_copies[i].bufferImageHeight = this->_plane_heights[i];
+					_copies[i].imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+					_copies[i].imageSubresource.mipLevel = 0;
+					_copies[i].imageSubresource.baseArrayLayer = 0;
+					_copies[i].imageSubresource.layerCount = 1;
+					_copies[i].imageExtent = { this->_plane_widths[i], this->_plane_heights[i], 1 };
+				}
+
+				//wait for fragment shaders of previous frames which sample the textures
+				vkCmdPipelineBarrier(_cmd,
+					VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+					VK_PIPELINE_STAGE_TRANSFER_BIT,
+					0,
+					0,
+					nullptr,
+					0,
+					nullptr,
+					this->_number_of_planes,
+					_barriers);
+
+				auto _buffer = this->_staging_buffer.get_buffer_handle().handle;
+				uint64_t _bytes = 0;
+				for (uint32_t i = 0; i < this->_number_of_planes; ++i)
+				{
+					vkCmdCopyBufferToImage(_cmd,
+						_buffer,
+						this->_textures[i]->get_image_view().image,
+						VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+						1,
+						&_copies[i]);
+					_bytes += static_cast<uint64_t>(this->_plane_widths[i]) * this->_texel_sizes[i] * this->_plane_heights[i];
+
+					_barriers[i] = _get_barrier(i, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+				}
+
+				vkCmdPipelineBarrier(_cmd,
+					VK_PIPELINE_STAGE_TRANSFER_BIT,
+					VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+					0,
+					0,
+					nullptr,
+					0,
+					nullptr,
+					this->_number_of_planes,
+					_barriers);
+
+				this->_statistics.uploaded_frames++;
+				this->_statistics.uploaded_bytes += _bytes;
+				this->_statistics.recorded_copies += this->_number_of_planes;
+				this->_statistics.last_record_time_in_ms =
+					std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start).count();
+
+				return W_PASSED;
+			}
+
+			ULONG release()
+			{
+				if (this->_mapped)
+				{
+					this->_staging_buffer.unmap();
+					this->_mapped = nullptr;
+				}
+				this->_staging_buffer.release();
+				for (uint32_t i = 0; i < 3; ++i)
+				{
+					SAFE_RELEASE(this->_textures[i]);
+				}
+				this->_number_of_planes = 0;
+				this->_ring_size = 0;
+				this->_statistics = w_video_texture_statistics();
+				this->_gDevice = nullptr;
+
+				return 0;
+			}
+
+#pragma region Getters
+
+			w_texture* get_texture(_In_ const uint32_t& pPlane) const
+			{
+				return pPlane < this->_number_of_planes ? this->_textures[pPlane] : nullptr;
+			}
+
+			const uint32_t get_number_of_planes() const
+			{
+				return this->_number_of_planes;
+			}
+
+			const w_video_texture_format get_format() const
+			{
+				return this->_format;
+			}
+
+			const uint32_t get_ring_size() const
+			{
+				return this->_ring_size;
+			}
+
+			const uint32_t get_width() const
+			{
+				return this->_width;
+			}
+
+			const uint32_t get_height() const
+			{
+				return this->_height;
+			}
+
+			const w_video_texture_statistics get_statistics() const
+			{
+				return this->_statistics;
+			}
+
+#pragma endregion
+
+		private:
+			static uint32_t _align(_In_ const uint32_t& pValue, _In_ const uint32_t& pAlignment)
+			{
+				return ((pValue + pAlignment - 1) / pAlignment) * pAlignment;
+			}
+
+			VkImageMemoryBarrier _get_barrier(
+				_In_ const uint32_t& pPlane,
+				_In_ const VkImageLayout& pOldLayout,
+				_In_ const VkImageLayout& pNewLayout) const
+			{
+				VkImageMemoryBarrier _barrier = {};
+				_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				_barrier.oldLayout = pOldLayout;
+				_barrier.newLayout = pNewLayout;
+				_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+				_barrier.image = this->_textures[pPlane]->get_image_view().image;
+				_barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+				w_graphics_device_manager::set_src_dst_masks_of_image_barrier(_barrier);
+
+				return _barrier;
+			}
+
+			//clear textures to black and move them to shader read only layout, so they can be sampled before the first upload
+			W_RESULT _clear()
+			{
+				const std::string _trace_info = this->_name + "::_clear";
+
+				w_command_buffers _command_buffer;
+				w_fences _fence;
+				if (_command_buffer.load(this->_gDevice, 1) == W_FAILED || _fence.initialize(this->_gDevice) == W_FAILED)
+				{
+					V(W_FAILED, "loading command buffer for clearing video texture", _trace_info, 3, false);
+					return W_FAILED;
+				}
+				auto _cmd = _command_buffer.get_command_at(0);
+
+				_command_buffer.begin(0, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT);
+				{
+					VkImageMemoryBarrier _barriers[3];
+					for (uint32_t i = 0; i < this->_number_of_planes; ++i)
+					{
+						_barriers[i] = _get_barrier(i, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+					}
+					vkCmdPipelineBarrier(_cmd.handle,
+						VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+						VK_PIPELINE_STAGE_TRANSFER_BIT,
+						0,
+						0,
+						nullptr,
+						0,
+						nullptr,
+						this->_number_of_planes,
+						_barriers);
+
+					const VkImageSubresourceRange _range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+					for (uint32_t i = 0; i < this->_number_of_planes; ++i)
+					{
+						//black of YUV is zero luma and half chroma
+						VkClearColorValue _color = {};
+						auto _value = (this->_format == w_video_texture_format::VIDEO_TEXTURE_YUV420P && i) ? 0.5f : 0.0f;
+						_color.float32[0] = _value;
+						_color.float32[3] = 1.0f;
+
+						vkCmdClearColorImage(_cmd.handle,
+							this->_textures[i]->get_image_view().image,
+							VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+							&_color,
+							1,
+							&_range);
+
+						_barriers[i] = _get_barrier(i, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+					}
+					vkCmdPipelineBarrier(_cmd.handle,
+						VK_PIPELINE_STAGE_TRANSFER_BIT,
+						VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+						0,
+						0,
+						nullptr,
+						0,
+						nullptr,
+						this->_number_of_planes,
+						_barriers);
+				}
+				_command_buffer.end(0);
+
+				auto _hr = this->_gDevice->submit(
+					{ &_cmd },
+					this->_gDevice->vk_graphics_queue,
+					nullptr,
+					{},
+					{},
+					&_fence);
+				if (_hr == W_PASSED)
+				{
+					_hr = _fence.wait();
+				}
+
+				_fence.release();
+				_command_buffer.release();
+
+				if (_hr == W_FAILED)
+				{
+					V(W_FAILED, "submitting command buffer for clearing video texture on graphics device: " + this->_gDevice->get_info(),
+						_trace_info, 3, false);
+				}
+				return _hr;
+			}
+
+			std::string											_name;
+			std::shared_ptr<w_graphics_device>					_gDevice;
+			w_buffer											_staging_buffer;
+			uint8_t*											_mapped;
+			w_texture*											_textures[3];
+			w_video_texture_format								_format;
+			uint32_t											_number_of_planes;
+			uint32_t											_ring_size;
+			uint32_t											_width;
+			uint32_t											_height;
+			//layout of planes inside each slot
+			uint32_t											_plane_offsets[3];
+			uint32_t											_row_pitches[3];
+			uint32_t											_plane_widths[3];
+			uint32_t											_plane_heights[3];
+			uint32_t											_texel_sizes[3];
+			w_video_texture_statistics							_statistics;
+		};
+	}
+}
+
+using namespace wolf::graphics;
+
+w_video_texture::w_video_texture() : _pimp(new w_video_texture_pimp())
+{
+	_super::set_class_name("w_video_texture");
+}
+
+w_video_texture::~w_video_texture()
+{
+	release();
+}
+
+W_RESULT w_video_texture::initialize(
+	_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_ const uint32_t& pWidth,
+	_In_ const uint32_t& pHeight,
+	_In_ const w_video_texture_format& pFormat,
+	_In_ const uint32_t& pRingSize)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->initialize(pGDevice, pWidth, pHeight, pFormat, pRingSize);
+}
+
+W_RESULT w_video_texture::get_staging_frame(
+	_In_ const uint32_t& pSlot,
+	_Inout_ w_video_texture_staging_frame& pFrame) const
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->get_staging_frame(pSlot, pFrame);
+}
+
+W_RESULT w_video_texture::record_upload(
+	_In_ const w_command_buffer& pCommandBuffer,
+	_In_ const uint32_t& pSlot)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->record_upload(pCommandBuffer, pSlot);
+}
+
+ULONG w_video_texture::release()
+{
+	if (_super::get_is_released()) return 0;
+
+	SAFE_RELEASE(this->_pimp);
+
+	return _super::release();
+}
+
+#pragma region Getters
+
+w_texture* w_video_texture::get_texture(_In_ const uint32_t& pPlane) const
+{
+	if (!this->_pimp) return nullptr;
+	return this->_pimp->get_texture(pPlane);
+}
+
+const uint32_t w_video_texture::get_number_of_planes() const
+{
+	if (!this->_pimp) return 0;
+	return this->_pimp->get_number_of_planes();
+}
+
+const w_video_texture_format w_video_texture::get_format() const
+{
+	if (!this->_pimp) return w_video_texture_format::VIDEO_TEXTURE_RGBA;
+	return this->_pimp->get_format();
+}
+
+const uint32_t w_video_texture::get_ring_size() const
+{
+	if (!this->_pimp) return 0;
+	return this->_pimp->get_ring_size();
+}
+
+const uint32_t w_video_texture::get_width() const
+{
+	if (!this->_pimp) return 0;
+	return this->_pimp->get_width();
+}
+
+const uint32_t w_video_texture::get_height() const
+{
+	if (!this->_pimp) return 0;
+	return this->_pimp->get_height();
+}
+
+const w_video_texture_statistics w_video_texture::get_statistics() const
+{
+	if (!this->_pimp) return w_video_texture_statistics();
+	return this->_pimp->get_statistics();
+}
+
+#pragma endregion
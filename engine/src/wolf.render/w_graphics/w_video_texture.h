@@ -0,0 +1,127 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_video_texture.h
+	Description		 : Textures of video frames which are uploaded from a persistently mapped, multi buffered staging ring
+	Comment          : Each slot of ring holds all planes of one frame, so decoder can convert frames straight into mapped memory
+					   and the only copy after conversion is the copy from slot to textures which will be recorded into the
+					   command buffer of frame. YUV420P frames are uploaded as three R8 textures and converted to RGB by
+					   fragment shader. A slot can be written again when the command buffer which has uploaded it is completed
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_VIDEO_TEXTURE_H__
+#define __W_VIDEO_TEXTURE_H__
+
+#include "w_graphics_device_manager.h"
+#include "w_command_buffers.h"
+#include "w_texture.h"
+
+namespace wolf
+{
+	namespace graphics
+	{
+		enum w_video_texture_format
+		{
+			//one R8G8B8A8 texture
+			VIDEO_TEXTURE_RGBA = 0,
+			//three R8 textures of Y, U and V, size of U and V is half of Y
+			VIDEO_TEXTURE_YUV420P
+		};
+
+		//mapped planes of one slot of ring
+		struct w_video_texture_staging_frame
+		{
+			uint8_t*	planes[3] = { nullptr, nullptr, nullptr };
+			uint32_t	row_pitches[3] = { 0, 0, 0 };
+			uint32_t	number_of_planes = 0;
+		};
+
+		struct w_video_texture_statistics
+		{
+			//size of each slot of ring in bytes
+			uint32_t	slot_size = 0;
+			uint64_t	uploaded_frames = 0;
+			uint64_t	uploaded_bytes = 0;
+			//number of buffer to image copies which have been recorded, one for each plane of uploaded frame
+			uint64_t	recorded_copies = 0;
+			//cpu time of recording the last upload
+			double		last_record_time_in_ms = 0.0;
+		};
+
+		class w_video_texture_pimp;
+		class w_video_texture : public system::w_object
+		{
+		public:
+			W_EXP w_video_texture();
+			W_EXP ~w_video_texture();
+
+			/*
+				create staging ring and textures of planes, textures will be cleared to black
+				@param pGDevice, graphics device
+				@param pWidth, width of video frames
+				@param pHeight, height of video frames
+				@param pFormat, format of video frames
+				@param pRingSize, number of slots, must be bigger than number of frames which are being converted or uploaded
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT initialize(
+				_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+				_In_ const uint32_t& pWidth,
+				_In_ const uint32_t& pHeight,
+				_In_ const w_video_texture_format& pFormat,
+				_In_ const uint32_t& pRingSize = 3);
+
+			/*
+				get mapped planes of a slot, memory remains mapped until release, so planes can be written from any thread
+				@param pSlot, index of slot
+				@param pFrame, mapped planes and their row pitches
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT get_staging_frame(
+				_In_ const uint32_t& pSlot,
+				_Inout_ w_video_texture_staging_frame& pFrame) const;
+
+			/*
+				record copy of all planes of a slot to textures, call it outside of render pass.
+				Textures will be in shader read only layout after the copy
+				@param pCommandBuffer, command buffer
+				@param pSlot, index of slot which has been written
+				@return W_PASSED means function did succesfully and W_FAILED means function failed
+			*/
+			W_EXP W_RESULT record_upload(
+				_In_ const w_command_buffer& pCommandBuffer,
+				_In_ const uint32_t& pSlot);
+
+			//release all resources
+			W_EXP ULONG release() override;
+
+#pragma region Getters
+
+			//get texture of a plane, Y is plane 0, U is plane 1 and V is plane 2
+			W_EXP w_texture* get_texture(_In_ const uint32_t& pPlane = 0) const;
+			W_EXP const uint32_t get_number_of_planes() const;
+			W_EXP const w_video_texture_format get_format() const;
+			W_EXP const uint32_t get_ring_size() const;
+			W_EXP const uint32_t get_width() const;
+			W_EXP const uint32_t get_height() const;
+			W_EXP const w_video_texture_statistics get_statistics() const;
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_video_texture(w_video_texture const&);
+			w_video_texture& operator= (w_video_texture const&);
+
+			typedef system::w_object						_super;
+			w_video_texture_pimp*							_pimp;
+		};
+	}
+}
+
+#endif //__W_VIDEO_TEXTURE_H__
@@ -5,7 +5,11 @@
 #include "w_graphics/w_command_buffers.h"
 #include "w_graphics/w_texture.h"
 #include "w_graphics/w_shader.h"
+#include "w_graphics/w_memory_allocator.h"
+#include "w_graphics/w_upload_manager.h"
+#include "w_graphics/w_pipeline.h"
 #include <signal.h>
+#include <chrono>
 
 static std::once_flag _graphics_device_static_constructor;
 
@@ -182,13 +186,20 @@ W_RESULT w_graphics_device::submit(
 	_In_ const uint32_t*					  pWaitDstStageMask,
 	_In_ std::vector<w_semaphore>             pWaitForSemaphores,
 	_In_ std::vector<w_semaphore>             pSignalForSemaphores,
-	_In_ w_fences*                            pFence)
+	_In_ w_fences*                            pFence,
+	_In_ const uint32_t&                      pFenceIndex)
 {
 	const std::string _trace_info = "w_graphics_device::submit";
 
 	auto _size = static_cast<uint32_t>(pCommandBuffers.size());
 	if (!_size) return W_FAILED;
 	
+	//pending uploads must be submitted before command buffers which use them
+	if (this->upload_manager)
+	{
+		this->upload_manager->submit();
+	}
+
 	W_RESULT _hr = W_PASSED;
 	std::vector<VkCommandBuffer> _cmds(_size);
 	for (size_t i = 0; i < _size; ++i)
@@ -237,7 +248,18 @@ W_RESULT w_graphics_device::submit(
 		_submit_info.pSignalSemaphores = _signal_semaphors.data();
 	}
 
-	VkFence _fence = pFence ? *(pFence->get()) : 0;
+	VkFence _fence = 0;
+	if (pFence)
+	{
+		auto _fence_ptr = pFence->get_at(pFenceIndex);
+		if (!_fence_ptr)
+		{
+			_hr = W_FAILED;
+			V(_hr, "fence index " + std::to_string(pFenceIndex) + " is out of range", _trace_info, 3, false);
+			goto submit_clear;
+		}
+		_fence = *_fence_ptr;
+	}
 
 	// Submit to queue
 	if (vkQueueSubmit(pQueue.queue, 1, &_submit_info, _fence))
@@ -274,6 +296,43 @@ submit_clear:
 	return _hr;
 }
 
+void w_graphics_device::release_on_frame_completed(_In_ const std::function<void(void)>& pReleaseFunction)
+{
+	if (!pReleaseFunction) return;
+
+	auto _frame_index = this->output_presentation_window.frame_index;
+	if (this->_frames_transient_resources.size() <= _frame_index)
+	{
+		this->_frames_transient_resources.resize(_frame_index + 1);
+	}
+	this->_frames_transient_resources[_frame_index].push_back(pReleaseFunction);
+}
+
+void w_graphics_device::_release_frame_transient_resources(_In_ const uint32_t& pFrameIndex)
+{
+	if (pFrameIndex < this->_frames_transient_resources.size())
+	{
+		auto _resources = &this->_frames_transient_resources[pFrameIndex];
+		for (auto& _release : *_resources)
+		{
+			_release();
+		}
+		_resources->clear();
+	}
+
+	//GPU finished this frame, so the linear memory of this frame can be reused
+	if (this->memory_allocator)
+	{
+		this->memory_allocator->reset_linear_pool(pFrameIndex);
+	}
+
+	//reuse ring buffer space of completed uploads
+	if (this->upload_manager)
+	{
+		this->upload_manager->update();
+	}
+}
+
 W_RESULT w_graphics_device::capture(
 	_In_ VkImage pSourceImage, 
 	_In_ VkFormat pSourceImageFormat, 
@@ -1164,6 +1223,16 @@ ULONG w_graphics_device::release()
     //wait for device to become IDLE
     vkDeviceWaitIdle(this->vk_device);
 
+	//release staging ring buffer before memory allocator
+	SAFE_RELEASE(this->upload_manager);
+
+	//GPU is idle, release transient resources of all frames
+	for (uint32_t i = 0; i < static_cast<uint32_t>(this->_frames_transient_resources.size()); ++i)
+	{
+		_release_frame_transient_resources(i);
+	}
+	this->_frames_transient_resources.clear();
+
 	_clean_swap_chain();
 
 	this->output_presentation_window.release();
@@ -1188,6 +1257,9 @@ ULONG w_graphics_device::release()
         nullptr);
     this->vk_command_allocator_pool = 0;
 
+    //release all memory blocks
+    SAFE_RELEASE(this->memory_allocator);
+
     SAFE_RELEASE(this->device_info);
 
     //release vulkan resources
@@ -1208,6 +1280,12 @@ static PFN_vkCreateDebugReportCallbackEXT sCreateDebugReportCallback = 0;
 static PFN_vkDestroyDebugReportCallbackEXT sDestroyDebugReportCallback = 0;
 static PFN_vkDebugReportMessageEXT sDebugBreakCallback = 0;
 
+#ifdef VK_KHR_get_physical_device_properties2
+//queries of extended features and properties, they will be null if VK_KHR_get_physical_device_properties2 is not supported by instance
+static PFN_vkGetPhysicalDeviceFeatures2KHR sGetPhysicalDeviceFeatures2 = 0;
+static PFN_vkGetPhysicalDeviceProperties2KHR sGetPhysicalDeviceProperties2 = 0;
+#endif
+
 static VkDebugReportCallbackEXT MsgCallback;
 static VkBool32 DebugMessageCallback(
     VkDebugReportFlagsEXT pFlags,
@@ -1686,6 +1764,20 @@ namespace wolf
                 }
 #endif
 
+#ifdef VK_KHR_get_physical_device_properties2
+				//required by device extensions such as VK_EXT_descriptor_indexing on Vulkan 1.0
+				auto _has_physical_device_properties_2 = false;
+				for (size_t i = 0; i < _extension_count; ++i)
+				{
+					if (std::strcmp(_extensions_available[i].extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME) == 0)
+					{
+						_vk_instance_enabled_extensions.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+						_has_physical_device_properties_2 = true;
+						break;
+					}
+				}
+#endif
+
                 VkInstanceCreateInfo _instance_create_info = {};
                 _instance_create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
                 _instance_create_info.pNext = nullptr;
@@ -1730,6 +1822,16 @@ namespace wolf
                     std::exit(EXIT_FAILURE);
                 }
 
+#ifdef VK_KHR_get_physical_device_properties2
+				if (_has_physical_device_properties_2)
+				{
+					sGetPhysicalDeviceFeatures2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(
+						vkGetInstanceProcAddr(w_graphics_device::vk_instance, "vkGetPhysicalDeviceFeatures2KHR"));
+					sGetPhysicalDeviceProperties2 = reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(
+						vkGetInstanceProcAddr(w_graphics_device::vk_instance, "vkGetPhysicalDeviceProperties2KHR"));
+				}
+#endif
+
 
 #if !defined(__APPLE__) && !defined(__iOS__)
                 if (this->_config.debug_gpu)
@@ -2055,7 +2157,20 @@ namespace wolf
                     }
 
 
+                    //prefer dedicated transfer queue family, its copy engine runs in parallel with graphics queue
                     for (size_t j = 0; j < _queue_family_property_count; ++j)
+                    {
+                        auto _flags = _gDevice->vk_queue_family_properties[j].queueFlags;
+                        if ((_flags & VK_QUEUE_TRANSFER_BIT) && !(_flags & (VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT)))
+                        {
+                            _gDevice->vk_transfer_queue.index = static_cast<uint32_t>(j);
+                            _msg += "\r\n\t\t\t\t\t\t_queue_family_properties: " + std::to_string(j) + 
+                                "\r\n\t\t\t\t\t\t\tdedicated VK_QUEUE_TRANSFER_BIT supported.";
+                            break;
+                        }
+                    }
+
+                    for (size_t j = 0; _gDevice->vk_transfer_queue.index == UINT32_MAX && j < _queue_family_property_count; ++j)
                     {
                         _msg += "\r\n\t\t\t\t\t\t_queue_family_properties: " + std::to_string(j);
                         if (_gDevice->vk_queue_family_properties[j].queueFlags & VK_QUEUE_TRANSFER_BIT)
@@ -2092,22 +2207,41 @@ namespace wolf
 						std::exit(EXIT_FAILURE);
 					}
 
-					//create queue info
+					//create one queue for each queue family which is used by device
 					float _queue_priorities[1] = { 1.0f };
-					VkDeviceQueueCreateInfo _queue_info = {};
-					_queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-					_queue_info.pNext = nullptr;
-					_queue_info.flags = 0;
-					_queue_info.queueCount = 1;
-					_queue_info.queueFamilyIndex = 0;
-					_queue_info.pQueuePriorities = _queue_priorities;
+					std::vector<VkDeviceQueueCreateInfo> _queue_infos;
+					std::vector<uint32_t> _queue_family_indices =
+					{
+						0,
+						_gDevice->vk_graphics_queue.index,
+						_gDevice->vk_compute_queue.index,
+						_gDevice->vk_transfer_queue.index,
+						_gDevice->vk_sparse_queue.index
+					};
+					for (auto _family_index : _queue_family_indices)
+					{
+						if (_family_index == UINT32_MAX) continue;
+
+						auto _found = std::find_if(_queue_infos.begin(), _queue_infos.end(),
+							[_family_index](const VkDeviceQueueCreateInfo& pInfo) { return pInfo.queueFamilyIndex == _family_index; });
+						if (_found != _queue_infos.end()) continue;
+
+						VkDeviceQueueCreateInfo _queue_info = {};
+						_queue_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+						_queue_info.pNext = nullptr;
+						_queue_info.flags = 0;
+						_queue_info.queueCount = 1;
+						_queue_info.queueFamilyIndex = _family_index;
+						_queue_info.pQueuePriorities = _queue_priorities;
+						_queue_infos.push_back(_queue_info);
+					}
 
 					//create device info
 					VkDeviceCreateInfo _create_device_info = {};
 					_create_device_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 					_create_device_info.pNext = nullptr;
-					_create_device_info.queueCreateInfoCount = 1;
-					_create_device_info.pQueueCreateInfos = &_queue_info;
+					_create_device_info.queueCreateInfoCount = static_cast<uint32_t>(_queue_infos.size());
+					_create_device_info.pQueueCreateInfos = _queue_infos.data();
 					_create_device_info.enabledLayerCount = 0;
 					_create_device_info.ppEnabledLayerNames = nullptr;
 					_create_device_info.pEnabledFeatures = &_gDevice->vk_physical_device_features;
@@ -2117,6 +2251,106 @@ namespace wolf
 						_create_device_info.ppEnabledExtensionNames = _gDevice->device_info->device_extensions.data();
 					}
 
+#ifdef VK_EXT_descriptor_indexing
+					//features of descriptor indexing which are required by w_bindless_texture_table,
+					//extension will be removed if device does not support it, so bindless texture tables will use their fallback
+					VkPhysicalDeviceDescriptorIndexingFeaturesEXT _descriptor_indexing_features = {};
+					_descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+					auto _device_extensions = &_gDevice->device_info->device_extensions;
+					for (auto _iter = _device_extensions->begin(); _iter != _device_extensions->end(); ++_iter)
+					{
+						if (std::strcmp(*_iter, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0)
+						{
+							uint32_t _extension_count = 0;
+							vkEnumerateDeviceExtensionProperties(_gpus[i], nullptr, &_extension_count, nullptr);
+							std::vector<VkExtensionProperties> _extension_properties(_extension_count);
+							vkEnumerateDeviceExtensionProperties(_gpus[i], nullptr, &_extension_count, _extension_properties.data());
+
+							auto _supported = std::any_of(_extension_properties.begin(), _extension_properties.end(),
+								[](const VkExtensionProperties& pProperties)
+							{
+								return std::strcmp(pProperties.extensionName, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0;
+							});
+							if (!_supported)
+							{
+								logger.warning(std::string(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) + " is not supported by graphics device: " +
+									_gDevice->get_info());
+								_device_extensions->erase(_iter);
+								_create_device_info.enabledExtensionCount = static_cast<uint32_t>(_device_extensions->size());
+								_create_device_info.ppEnabledExtensionNames = _device_extensions->size() ? _device_extensions->data() : nullptr;
+								break;
+							}
+
+							//some drivers expose the extension without all of features which are required by bindless texture tables
+							VkPhysicalDeviceDescriptorIndexingFeaturesEXT _supported_features = {};
+							_supported_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+#ifdef VK_KHR_get_physical_device_properties2
+							if (sGetPhysicalDeviceFeatures2)
+							{
+								VkPhysicalDeviceFeatures2KHR _features_2 = {};
+								_features_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+								_features_2.pNext = &_supported_features;
+								sGetPhysicalDeviceFeatures2(_gpus[i], &_features_2);
+							}
+#endif
+							if (!_supported_features.shaderSampledImageArrayNonUniformIndexing ||
+								!_supported_features.descriptorBindingSampledImageUpdateAfterBind ||
+								!_supported_features.descriptorBindingUpdateUnusedWhilePending ||
+								!_supported_features.descriptorBindingPartiallyBound ||
+								!_supported_features.runtimeDescriptorArray)
+							{
+								logger.warning("features of " + std::string(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) +
+									" which are required by bindless texture tables are not supported by graphics device: " +
+									_gDevice->get_info());
+								_device_extensions->erase(_iter);
+								_create_device_info.enabledExtensionCount = static_cast<uint32_t>(_device_extensions->size());
+								_create_device_info.ppEnabledExtensionNames = _device_extensions->size() ? _device_extensions->data() : nullptr;
+								break;
+							}
+
+#ifdef VK_KHR_maintenance3
+							//VK_EXT_descriptor_indexing depends on VK_KHR_maintenance3
+							auto _has_maintenance3 = std::any_of(_device_extensions->begin(), _device_extensions->end(),
+								[](const char* pName) { return std::strcmp(pName, VK_KHR_MAINTENANCE3_EXTENSION_NAME) == 0; });
+							if (!_has_maintenance3)
+							{
+								_device_extensions->push_back(VK_KHR_MAINTENANCE3_EXTENSION_NAME);
+								_create_device_info.enabledExtensionCount = static_cast<uint32_t>(_device_extensions->size());
+								_create_device_info.ppEnabledExtensionNames = _device_extensions->data();
+							}
+#endif
+							_descriptor_indexing_features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+							_descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+							_descriptor_indexing_features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+							_descriptor_indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
+							_descriptor_indexing_features.runtimeDescriptorArray = VK_TRUE;
+							_descriptor_indexing_features.pNext = const_cast<void*>(_create_device_info.pNext);
+							_create_device_info.pNext = &_descriptor_indexing_features;
+
+							//limits of update after bind pools, bindless texture tables will be clamped to them
+#ifdef VK_KHR_get_physical_device_properties2
+							if (sGetPhysicalDeviceProperties2)
+							{
+								VkPhysicalDeviceDescriptorIndexingPropertiesEXT _descriptor_indexing_properties = {};
+								_descriptor_indexing_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+								VkPhysicalDeviceProperties2KHR _properties_2 = {};
+								_properties_2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+								_properties_2.pNext = &_descriptor_indexing_properties;
+								sGetPhysicalDeviceProperties2(_gpus[i], &_properties_2);
+
+								_gDevice->vk_max_update_after_bind_sampled_images = std::min(
+									std::min(_descriptor_indexing_properties.maxDescriptorSetUpdateAfterBindSampledImages,
+										_descriptor_indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages),
+									std::min(_descriptor_indexing_properties.maxDescriptorSetUpdateAfterBindSamplers,
+										_descriptor_indexing_properties.maxPerStageDescriptorUpdateAfterBindSamplers));
+							}
+#endif
+							_gDevice->vk_descriptor_indexing = true;
+							break;
+						}
+					}
+#endif
+
 					//create device
 					_hr = vkCreateDevice(_gpus[i], &_create_device_info, nullptr, &_gDevice->vk_device);
 					if (_hr)
@@ -2148,6 +2382,20 @@ namespace wolf
                         std::exit(EXIT_FAILURE);
                     }
 
+					//create device memory allocator
+					_gDevice->memory_allocator = new (std::nothrow) w_memory_allocator();
+					if (!_gDevice->memory_allocator ||
+						_gDevice->memory_allocator->initialize(
+							_gDevice.get(),
+							this->_config.device_local_memory_block_size,
+							this->_config.host_visible_memory_block_size,
+							this->_config.linear_memory_block_size) == W_FAILED)
+					{
+						logger.error("error on creating memory allocator for graphics device: " +
+							std::string(_device_properties->deviceName) + " ID:" + std::to_string(_device_properties->deviceID));
+						release();
+						std::exit(EXIT_FAILURE);
+					}
 
 					if (!this->_config.off_screen_mode)
 					{
@@ -2369,6 +2617,20 @@ namespace wolf
                             &_gDevice->vk_sparse_queue.queue);
                     }
 
+					//create upload manager of staging buffers
+					if (this->_config.upload_ring_buffer_size)
+					{
+						_gDevice->upload_manager = new (std::nothrow) w_upload_manager();
+						if (!_gDevice->upload_manager ||
+							_gDevice->upload_manager->initialize(_gDevice.get(), this->_config.upload_ring_buffer_size) == W_FAILED)
+						{
+							logger.error("error on creating upload manager for graphics device: " +
+								std::string(_device_properties->deviceName) + " ID:" + std::to_string(_device_properties->deviceID));
+							release();
+							std::exit(EXIT_FAILURE);
+						}
+					}
+
 					pGraphicsDevices.push_back(_gDevice);
 
 					//each window for each gpu
@@ -3419,21 +3681,44 @@ namespace wolf
 				auto _device_id = pGDevice->device_info->get_device_id();
 				auto _output_presentation_window = &(pGDevice->output_presentation_window);
 
-                //create semaphores fro this graphics device
-                if (_output_presentation_window->swap_chain_image_is_available_semaphore.initialize(pGDevice) == W_FAILED)
+                //create semaphores and fences for each frame in flight of this graphics device
+                auto _frames_in_flight = this->_config.frames_in_flight;
+                if (_frames_in_flight == 0) _frames_in_flight = 1;
+
+                _output_presentation_window->frames_in_flight = _frames_in_flight;
+                _output_presentation_window->frame_index = 0;
+                _output_presentation_window->frames_image_is_available_semaphores.resize(_frames_in_flight);
+                _output_presentation_window->frames_rendering_done_semaphores.resize(_frames_in_flight);
+                _output_presentation_window->frames_fences.resize(_frames_in_flight);
+
+                for (uint32_t i = 0; i < _frames_in_flight; ++i)
                 {
-                    logger.error("error on creating image_is_available semaphore for graphics device: " +
-                                 _device_name + " ID:" + std::to_string(_device_id));
-                    release();
-                    std::exit(EXIT_FAILURE);
+                    if (_output_presentation_window->frames_image_is_available_semaphores[i].initialize(pGDevice) == W_FAILED)
+                    {
+                        logger.error("error on creating image_is_available semaphore for graphics device: " +
+                            _device_name + " ID:" + std::to_string(_device_id) + " frame: " + std::to_string(i));
+                        release();
+                        std::exit(EXIT_FAILURE);
+                    }
+                    if (_output_presentation_window->frames_rendering_done_semaphores[i].initialize(pGDevice) == W_FAILED)
+                    {
+                        logger.error("error on creating rendering_is_done semaphore for graphics device: " +
+                            _device_name + " ID:" + std::to_string(_device_id) + " frame: " + std::to_string(i));
+                        release();
+                        std::exit(EXIT_FAILURE);
+                    }
+                    //fences will be created in signaled state, so the first wait of each frame will not block
+                    if (_output_presentation_window->frames_fences[i].initialize(pGDevice) == W_FAILED)
+                    {
+                        logger.error("error on creating fence for graphics device: " +
+                            _device_name + " ID:" + std::to_string(_device_id) + " frame: " + std::to_string(i));
+                        release();
+                        std::exit(EXIT_FAILURE);
+                    }
                 }
-                if (_output_presentation_window->rendering_done_semaphore.initialize(pGDevice) == W_FAILED)
-                {
-					logger.error("error on creating rendering_is_done semaphore for graphics device: " +
-						_device_name + " ID:" + std::to_string(_device_id));
-					release();
-					std::exit(EXIT_FAILURE);
-				}
+
+                _output_presentation_window->swap_chain_image_is_available_semaphore = _output_presentation_window->frames_image_is_available_semaphores[0];
+                _output_presentation_window->rendering_done_semaphore = _output_presentation_window->frames_rendering_done_semaphores[0];
 #endif
 			}
             
@@ -3858,6 +4143,25 @@ W_RESULT w_graphics_device_manager::prepare()
         _wait_for_previous_frame(_gDevice, j);
 
 #elif defined(__VULKAN__)
+        auto _frame_index = _output_window->frame_index;
+        auto _cpu_wait_start = std::chrono::steady_clock::now();
+
+        //wait for GPU to finish the frame which used these synchronization objects N frames ago
+        if (_frame_index < _output_window->frames_fences.size())
+        {
+            if (_output_window->frames_fences[_frame_index].wait() == W_FAILED)
+            {
+                logger.error("error on waiting for fence of frame in flight for graphics device: " +
+                    std::to_string(i));
+                release();
+                std::exit(EXIT_FAILURE);
+            }
+            _gDevice->_release_frame_transient_resources(_frame_index);
+
+            _output_window->swap_chain_image_is_available_semaphore = _output_window->frames_image_is_available_semaphores[_frame_index];
+            _output_window->rendering_done_semaphore = _output_window->frames_rendering_done_semaphores[_frame_index];
+        }
+
         auto _semaphore = _output_window->swap_chain_image_is_available_semaphore.get();
         auto _hr = vkAcquireNextImageKHR(_gDevice->vk_device,
             _output_window->vk_swap_chain,
@@ -3873,6 +4177,37 @@ W_RESULT w_graphics_device_manager::prepare()
             release();
             std::exit(EXIT_FAILURE);
         }
+
+        //the acquired image might still be used by another frame in flight, wait for that frame too
+        auto _images_frame_index = &_output_window->swap_chain_images_frame_index;
+        if (_images_frame_index->size() != _output_window->swap_chain_image_views.size())
+        {
+            _images_frame_index->assign(_output_window->swap_chain_image_views.size(), -1);
+        }
+        auto _image_index = _output_window->swap_chain_image_index;
+        if (_image_index < _images_frame_index->size())
+        {
+            auto _last_frame = (*_images_frame_index)[_image_index];
+            if (_last_frame >= 0 && 
+                static_cast<uint32_t>(_last_frame) != _frame_index &&
+                static_cast<size_t>(_last_frame) < _output_window->frames_fences.size())
+            {
+                _output_window->frames_fences[_last_frame].wait();
+            }
+            (*_images_frame_index)[_image_index] = static_cast<int>(_frame_index);
+        }
+
+        //update frame pacing counters
+        auto _pacing = &_output_window->frame_pacing;
+        _pacing->last_cpu_wait_time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _cpu_wait_start).count();
+        _pacing->total_cpu_wait_time += _pacing->last_cpu_wait_time;
+        _pacing->average_cpu_wait_time = _pacing->number_of_frames == 0 ? _pacing->last_cpu_wait_time :
+            0.9 * _pacing->average_cpu_wait_time + 0.1 * _pacing->last_cpu_wait_time;
+        if (_pacing->last_cpu_wait_time > _pacing->max_cpu_wait_time)
+        {
+            _pacing->max_cpu_wait_time = _pacing->last_cpu_wait_time;
+        }
+        _pacing->number_of_frames++;
 #endif
     }
 
@@ -4113,13 +4448,21 @@ W_RESULT w_graphics_device_manager::present()
             std::exit(EXIT_FAILURE);
         }
 
-        _hr = vkQueueWaitIdle(_gDevice->vk_present_queue.queue);
-        if (_hr)
+        //instead of waiting for queue to become idle, signal the fence of this frame when GPU finished all submitted works
+        auto _frame_index = _present_window->frame_index;
+        if (_frame_index < _present_window->frames_fences.size())
         {
-            logger.error("error on wait idle queue of graphics device: " +
-                _gDevice->device_info->get_device_name() );
-            release();
-            std::exit(EXIT_FAILURE);
+            auto _fence = &_present_window->frames_fences[_frame_index];
+            _fence->reset();
+            _hr = vkQueueSubmit(_gDevice->vk_graphics_queue.queue, 0, nullptr, *_fence->get());
+            if (_hr)
+            {
+                logger.error("error on submitting fence of frame in flight for graphics device: " +
+                    _gDevice->device_info->get_device_name());
+                release();
+                std::exit(EXIT_FAILURE);
+            }
+            _present_window->frame_index = (_frame_index + 1) % _present_window->frames_in_flight;
         }
 #endif
     }
@@ -4149,6 +4492,11 @@ ULONG w_graphics_device_manager::release()
 		//	//Present to avoid leak all references held by previous render
 		//	present();
 		//}
+#elif defined(__VULKAN__)
+        //release cached compute pipeline variants of this device
+        w_pipeline::release_all_compute_pipeline_variants(_gDevice);
+        //save pipeline caches of this device for the next run
+        w_pipeline::release_all_pipeline_caches(_gDevice);
 #endif
         
         SHARED_RELEASE(_gDevice);
@@ -4341,6 +4689,12 @@ const size_t w_graphics_device_manager::get_number_of_graphics_devices() const
 	return this->graphics_devices.size();
 }
 
+const w_frame_pacing w_graphics_device_manager::get_frame_pacing(_In_ const size_t& pGraphicsDeviceIndex) const
+{
+	if (pGraphicsDeviceIndex >= this->graphics_devices.size()) return w_frame_pacing();
+	return this->graphics_devices[pGraphicsDeviceIndex]->output_presentation_window.frame_pacing;
+}
+
 #ifdef	__DX11_X__
 concurrency::accelerator_view w_graphics_device_manager::get_camp_accelerator_view(const CPP_AMP_DEVICE_TYPE pCppAMPDeviceType, ID3D11Device1* pDevice)
 {
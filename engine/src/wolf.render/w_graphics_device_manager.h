@@ -22,6 +22,7 @@
 #include <w_signal.h>
 #include <w_point.h>
 #include <map>
+#include <functional>
 #include <mutex>
 #include <array>
 #include "w_graphics/w_queue.h"
@@ -39,6 +40,8 @@ namespace wolf
 	{
         //forward declaration
         struct w_graphics_device_manager_configs;
+        class  w_memory_allocator;
+        class  w_upload_manager;
         struct w_viewport;
         struct w_viewport_scissor;
         //struct w_buffer;
@@ -110,6 +113,21 @@ namespace wolf
 			}
 		};
 
+        //frame pacing counters, used for measuring how long CPU waited for GPU before recording next frame
+        struct w_frame_pacing
+        {
+            //CPU wait time of last frame in milliseconds
+            double                              last_cpu_wait_time = 0.0;
+            //exponential moving average of CPU wait time in milliseconds
+            double                              average_cpu_wait_time = 0.0;
+            //maximum CPU wait time in milliseconds
+            double                              max_cpu_wait_time = 0.0;
+            //sum of all CPU wait times in milliseconds
+            double                              total_cpu_wait_time = 0.0;
+            //number of prepared frames
+            uint64_t                            number_of_frames = 0;
+        };
+
         struct w_image_view
         {
 #ifdef __VULKAN__
@@ -132,9 +150,28 @@ namespace wolf
 				if (this->_is_released) return 0;
 				this->_is_released = true;
                    
-				//release semaphores
-				this->rendering_done_semaphore.release();
-				this->swap_chain_image_is_available_semaphore.release();
+#ifdef __VULKAN__
+				//release synchronization objects of frames in flight, current semaphores are just copies of them
+				for (auto& _semaphore : this->frames_rendering_done_semaphores)
+				{
+					_semaphore.release();
+				}
+				this->frames_rendering_done_semaphores.clear();
+				for (auto& _semaphore : this->frames_image_is_available_semaphores)
+				{
+					_semaphore.release();
+				}
+				this->frames_image_is_available_semaphores.clear();
+				for (auto& _fence : this->frames_fences)
+				{
+					_fence.release();
+				}
+				this->frames_fences.clear();
+				this->swap_chain_images_frame_index.clear();
+
+				this->rendering_done_semaphore = w_semaphore();
+				this->swap_chain_image_is_available_semaphore = w_semaphore();
+#endif
 
 #ifdef __WIN32
 				this->hwnd = NULL;
@@ -217,10 +254,22 @@ namespace wolf
             w_image_view							        depth_buffer_image_view;
             VkDeviceMemory							        depth_buffer_memory = 0;
             
-			//Synchronization objects
+			//Synchronization objects of current frame, they will be switched to the objects of next frame in flight on each w_graphics_device_manager::prepare
             w_semaphore								        swap_chain_image_is_available_semaphore;
             w_semaphore								        rendering_done_semaphore;
 
+            //number of frames which CPU can record while GPU is executing the previous ones
+            uint32_t                                        frames_in_flight = 1;
+            //index of current frame in flight
+            uint32_t                                        frame_index = 0;
+            std::vector<w_semaphore>                        frames_image_is_available_semaphores;
+            std::vector<w_semaphore>                        frames_rendering_done_semaphores;
+            //signaled when GPU finished all works of the frame in flight
+            std::vector<w_fences>                           frames_fences;
+            //the frame in flight which used each swap chain image for the last time
+            std::vector<int>                                swap_chain_images_frame_index;
+            w_frame_pacing                                  frame_pacing;
+
             //Required objects for sharing swap chain's buffer with CPU
             struct shared_objs_between_cpu_gpu
             {
@@ -296,14 +345,19 @@ namespace wolf
                 _In_ const uint32_t&			pFirstVertex,
                 _In_ const uint32_t&			pFirstInstance);
             
-            //submit command buffer
+            /*
+                submit command buffer
+                @param pFence, the fence which will be signaled on completion, if it is nullptr the queue will be idled
+                @param pFenceIndex, index of fence inside pFence, usually index of swap chain image when there is a fence per frame
+            */
             W_EXP W_RESULT submit(
 				_In_ const std::vector<const w_command_buffer*>&	pCommandBuffers,
                 _In_ const w_queue&									pQueue,
                 _In_ const uint32_t*								pWaitDstStageMask,
                 _In_ std::vector<w_semaphore> 						pWaitForSemaphores,
                 _In_ std::vector<w_semaphore> 						pSignalForSemaphores,
-                _In_ w_fences*										pFence);
+                _In_ w_fences*										pFence,
+                _In_ const uint32_t&								pFenceIndex = 0);
             
             /*
                 capture image buffer's data and save to D-RAM and make it accessable by CPU, 
@@ -331,6 +385,13 @@ namespace wolf
 			*/
             W_EXP W_RESULT capture_presented_swap_chain_buffer(_In_ wolf::system::w_signal<void(const w_point_t, uint8_t*)>& pOnPixelsDataCaptured);
 
+			/*
+				release a transient resource of current frame after GPU finished executing this frame,
+				use it for per frame resources like staging buffers instead of waiting for device to become idle
+				@param pReleaseFunction, the function which will be called for releasing the resource
+			*/
+			W_EXP void release_on_frame_completed(_In_ const std::function<void(void)>& pReleaseFunction);
+
 			w_device_info*												device_info = nullptr;
 
 #ifdef __DX12__
@@ -350,6 +411,10 @@ namespace wolf
                         
             VkPhysicalDevice                                                vk_physical_device;
             VkPhysicalDeviceFeatures                                        vk_physical_device_features;
+            //true if VK_EXT_descriptor_indexing has been enabled by user and device supports its features, bindless texture tables will use partially bound arrays
+            bool                                                            vk_descriptor_indexing = false;
+            //maximum number of combined image samplers of update after bind descriptor sets, zero if it could not be queried
+            uint32_t                                                        vk_max_update_after_bind_sampled_images = 0;
             VkPhysicalDeviceMemoryProperties                                vk_physical_device_memory_properties;
             
             std::vector<VkQueueFamilyProperties>                            vk_queue_family_properties;
@@ -364,6 +429,11 @@ namespace wolf
             VkDevice                                                        vk_device;
 
             VkCommandPool                                                   vk_command_allocator_pool;
+
+            //sub allocates device memory of buffers and textures
+            w_memory_allocator*                                             memory_allocator = nullptr;
+            //batches uploads of staging buffers, will be nullptr if upload_ring_buffer_size of configs is zero
+            w_upload_manager*                                               upload_manager = nullptr;
                         
             //static pipeline defaults
 			struct defaults_states
@@ -489,8 +559,11 @@ namespace wolf
             w_graphics_device& operator= (w_graphics_device const&);
             
 			void _clean_swap_chain();
+			void _release_frame_transient_resources(_In_ const uint32_t& pFrameIndex);
 
             bool                                                            _is_released;
+            //transient resources of each frame in flight
+            std::vector<std::vector<std::function<void(void)>>>            _frames_transient_resources;
             std::string                                                     _name;
 		};
 
@@ -530,6 +603,8 @@ namespace wolf
             W_EXP std::shared_ptr<w_graphics_device> get_graphics_device(_In_ const size_t& pGraphicsDeviceIndex) const;
 			//Get number of available graphics devices
             W_EXP const size_t get_number_of_graphics_devices() const;
+			//Get frame pacing counters of graphics device
+			W_EXP const w_frame_pacing get_frame_pacing(_In_ const size_t& pGraphicsDeviceIndex) const;
 
 //#ifdef __DX11__
 //            //Get DPI
@@ -589,6 +664,15 @@ namespace wolf
             bool debug_gpu = false;
 			//used for compute mode
 			bool off_screen_mode = false;
+			//number of frames which CPU can record while GPU is executing the previous ones, 1 means CPU waits for each frame
+			uint32_t frames_in_flight = 2;
+			//size of each block of device memory allocator in bytes, must be power of two
+			uint64_t device_local_memory_block_size = 64 * 1024 * 1024;
+			uint64_t host_visible_memory_block_size = 16 * 1024 * 1024;
+			//size of each block of per frame linear pools in bytes
+			uint64_t linear_memory_block_size = 4 * 1024 * 1024;
+			//size of staging ring buffer of upload manager in bytes, zero disables upload manager and each upload waits for GPU
+			uint64_t upload_ring_buffer_size = 32 * 1024 * 1024;
         };
 
         struct w_viewport : 
@@ -0,0 +1,371 @@
+#include "w_system_pch.h"
+#include "w_async_loader.h"
+#include "w_thread.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+#include <cstring>
+
+namespace wolf
+{
+	namespace system
+	{
+		class w_async_loader_pimp
+		{
+		public:
+			w_async_loader_pimp() :
+				_is_released(true),
+				_next_id(0),
+				_in_flight(0),
+				_requested(0),
+				_completed(0),
+				_failed(0),
+				_canceled(0),
+				_max_update_time(0)
+			{
+			}
+
+			~w_async_loader_pimp()
+			{
+				release();
+			}
+
+			W_RESULT allocate(_In_ size_t pNumberOfThreads)
+			{
+				release();
+
+				if (pNumberOfThreads == 0)
+				{
+					//leave one thread context for the calling thread
+					auto _hardware_threads = std::thread::hardware_concurrency();
+					pNumberOfThreads = _hardware_threads > 1 ? _hardware_threads - 1 : 1;
+				}
+
+				this->_is_released = false;
+				this->_max_update_time = 0;
+				this->_threads.reserve(pNumberOfThreads);
+				for (size_t i = 0; i < pNumberOfThreads; ++i)
+				{
+					this->_threads.push_back(std::thread(&w_async_loader_pimp::_thread_loop, this, i));
+				}
+
+				return W_PASSED;
+			}
+
+			std::shared_ptr<w_async_load_request> load(
+				_In_ const int& pPriority,
+				_In_ const std::function<W_RESULT(void)>& pLoad,
+				_In_ const std::function<void(const W_RESULT&)>& pOnCompleted)
+			{
+				if (this->_threads.empty())
+				{
+					logger.error("async loader must be allocated before adding requests");
+					return nullptr;
+				}
+
+				auto _request = std::make_shared<w_async_load_request>();
+				_request->_id = this->_next_id.fetch_add(1, std::memory_order_relaxed);
+				_request->_priority = pPriority;
+				_request->_load = pLoad;
+				_request->_on_completed = pOnCompleted;
+
+				this->_requested.fetch_add(1, std::memory_order_relaxed);
+				this->_in_flight.fetch_add(1, std::memory_order_acq_rel);
+				{
+					std::lock_guard<std::mutex> _lock(this->_pending_mutex);
+					this->_pending.push_back(_request);
+					std::push_heap(this->_pending.begin(), this->_pending.end(), _compare_priority);
+				}
+				this->_pending_cv.notify_one();
+
+				return _request;
+			}
+
+			size_t update(_In_ const double& pTimeBudgetInMilliseconds)
+			{
+				typedef std::chrono::steady_clock _clock;
+				auto _start = _clock::now();
+
+				size_t _executed = 0;
+				while (true)
+				{
+					std::shared_ptr<w_async_load_request> _request;
+					{
+						std::lock_guard<std::mutex> _lock(this->_loaded_mutex);
+						if (this->_loaded.empty()) break;
+						_request = this->_loaded.front();
+						this->_loaded.pop_front();
+					}
+
+					if (_request->get_is_cancel_requested())
+					{
+						_cancel(_request);
+						continue;
+					}
+
+					auto _on_completed = std::move(_request->_on_completed);
+					_request->_on_completed = nullptr;
+					if (_on_completed)
+					{
+						_on_completed(_request->_result);
+					}
+
+					if (_request->_result == W_PASSED)
+					{
+						this->_completed.fetch_add(1, std::memory_order_relaxed);
+						_request->_state.store(ASYNC_LOAD_COMPLETED, std::memory_order_release);
+					}
+					else
+					{
+						this->_failed.fetch_add(1, std::memory_order_relaxed);
+						_request->_state.store(ASYNC_LOAD_FAILED, std::memory_order_release);
+					}
+					_executed++;
+
+					if (std::chrono::duration<double, std::milli>(_clock::now() - _start).count() >= pTimeBudgetInMilliseconds) break;
+				}
+
+				auto _elapsed = std::chrono::duration<double, std::milli>(_clock::now() - _start).count();
+				if (_elapsed > this->_max_update_time)
+				{
+					this->_max_update_time = _elapsed;
+				}
+
+				return _executed;
+			}
+
+			void flush()
+			{
+				while (true)
+				{
+					update(std::numeric_limits<double>::max());
+
+					std::unique_lock<std::mutex> _lock(this->_loaded_mutex);
+					if (this->_loaded.empty() && this->_in_flight.load(std::memory_order_acquire) == 0) break;
+
+					this->_loaded_cv.wait_for(_lock, std::chrono::milliseconds(1), [this]()
+					{
+						return !this->_loaded.empty() || this->_in_flight.load(std::memory_order_acquire) == 0;
+					});
+				}
+			}
+
+			ULONG release()
+			{
+				if (this->_is_released) return 1;
+
+				{
+					std::lock_guard<std::mutex> _lock(this->_pending_mutex);
+					this->_is_released = true;
+				}
+				this->_pending_cv.notify_all();
+
+				for (auto& _thread : this->_threads)
+				{
+					if (_thread.joinable())
+					{
+						_thread.join();
+					}
+				}
+				this->_threads.clear();
+
+				//cancel remaining requests
+				for (auto& _request : this->_pending)
+				{
+					_cancel(_request);
+					this->_in_flight.fetch_sub(1, std::memory_order_acq_rel);
+				}
+				this->_pending.clear();
+
+				for (auto& _request : this->_loaded)
+				{
+					_cancel(_request);
+				}
+				this->_loaded.clear();
+
+				return 0;
+			}
+
+#pragma region Getters
+
+			size_t get_number_of_threads() const
+			{
+				return this->_threads.size();
+			}
+
+			w_async_loader_statistics get_statistics()
+			{
+				w_async_loader_statistics _stats;
+				_stats.number_of_threads = this->_threads.size();
+				_stats.requested = this->_requested.load(std::memory_order_relaxed);
+				_stats.completed = this->_completed.load(std::memory_order_relaxed);
+				_stats.failed = this->_failed.load(std::memory_order_relaxed);
+				_stats.canceled = this->_canceled.load(std::memory_order_relaxed);
+				_stats.in_flight = static_cast<size_t>(this->_in_flight.load(std::memory_order_relaxed));
+				{
+					std::lock_guard<std::mutex> _lock(this->_loaded_mutex);
+					_stats.waiting_for_completion = this->_loaded.size();
+				}
+				_stats.max_update_time_in_milliseconds = this->_max_update_time;
+				return _stats;
+			}
+
+#pragma endregion
+
+		private:
+			void _thread_loop(_In_ const size_t pIndex)
+			{
+				w_thread::set_current_thread_name(("wolf_loader_" + std::to_string(pIndex)).c_str());
+
+				while (true)
+				{
+					std::shared_ptr<w_async_load_request> _request;
+					{
+						std::unique_lock<std::mutex> _lock(this->_pending_mutex);
+						this->_pending_cv.wait(_lock, [this]()
+						{
+							return this->_is_released || !this->_pending.empty();
+						});
+						if (this->_is_released) break;
+
+						std::pop_heap(this->_pending.begin(), this->_pending.end(), _compare_priority);
+						_request = this->_pending.back();
+						this->_pending.pop_back();
+					}
+
+					if (_request->get_is_cancel_requested())
+					{
+						_cancel(_request);
+						this->_in_flight.fetch_sub(1, std::memory_order_acq_rel);
+						this->_loaded_cv.notify_all();
+						continue;
+					}
+
+					_request->_state.store(ASYNC_LOAD_LOADING, std::memory_order_release);
+					_request->_result = _request->_load ? _request->_load() : W_PASSED;
+					//release resources which have been captured by load function on this thread
+					_request->_load = nullptr;
+					_request->_state.store(ASYNC_LOAD_LOADED, std::memory_order_release);
+
+					{
+						std::lock_guard<std::mutex> _lock(this->_loaded_mutex);
+						this->_loaded.push_back(_request);
+						this->_in_flight.fetch_sub(1, std::memory_order_acq_rel);
+					}
+					this->_loaded_cv.notify_all();
+				}
+			}
+
+			void _cancel(_In_ const std::shared_ptr<w_async_load_request>& pRequest)
+			{
+				pRequest->_load = nullptr;
+				pRequest->_on_completed = nullptr;
+				pRequest->_state.store(ASYNC_LOAD_CANCELED, std::memory_order_release);
+				this->_canceled.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			//max heap by priority, requests with the same priority are ordered by their ids
+			static bool _compare_priority(
+				_In_ const std::shared_ptr<w_async_load_request>& pLeft,
+				_In_ const std::shared_ptr<w_async_load_request>& pRight)
+			{
+				if (pLeft->_priority != pRight->_priority) return pLeft->_priority < pRight->_priority;
+				return pLeft->_id > pRight->_id;
+			}
+
+			bool													_is_released;
+			std::vector<std::thread>								_threads;
+
+			std::mutex												_pending_mutex;
+			std::condition_variable									_pending_cv;
+			std::vector<std::shared_ptr<w_async_load_request>>		_pending;
+
+			std::mutex												_loaded_mutex;
+			std::condition_variable									_loaded_cv;
+			std::deque<std::shared_ptr<w_async_load_request>>		_loaded;
+
+			std::atomic<uint64_t>									_next_id;
+			std::atomic<int64_t>									_in_flight;
+			std::atomic<size_t>										_requested;
+			std::atomic<size_t>										_completed;
+			std::atomic<size_t>										_failed;
+			std::atomic<size_t>										_canceled;
+			double													_max_update_time;
+		};
+	}
+}
+
+using namespace wolf::system;
+
+w_async_loader::w_async_loader() : _pimp(new w_async_loader_pimp())
+{
+}
+
+w_async_loader::~w_async_loader()
+{
+	release();
+	if (this->_pimp)
+	{
+		delete this->_pimp;
+		this->_pimp = nullptr;
+	}
+}
+
+W_RESULT w_async_loader::allocate(_In_ const size_t& pNumberOfThreads)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->allocate(pNumberOfThreads);
+}
+
+std::shared_ptr<w_async_load_request> w_async_loader::load(
+	_In_ const int& pPriority,
+	_In_ const std::function<W_RESULT(void)>& pLoad,
+	_In_ const std::function<void(const W_RESULT&)>& pOnCompleted)
+{
+	if (!this->_pimp) return nullptr;
+	return this->_pimp->load(pPriority, pLoad, pOnCompleted);
+}
+
+size_t w_async_loader::update(_In_ const double& pTimeBudgetInMilliseconds)
+{
+	if (!this->_pimp) return 0;
+	return this->_pimp->update(pTimeBudgetInMilliseconds);
+}
+
+void w_async_loader::flush()
+{
+	if (!this->_pimp) return;
+	this->_pimp->flush();
+}
+
+ULONG w_async_loader::release()
+{
+	if (!this->_pimp) return 1;
+	return this->_pimp->release();
+}
+
+#pragma region Getters
+
+size_t w_async_loader::get_number_of_threads() const
+{
+	if (!this->_pimp) return 0;
+	return this->_pimp->get_number_of_threads();
+}
+
+w_async_loader_statistics w_async_loader::get_statistics() const
+{
+	if (!this->_pimp)
+	{
+		w_async_loader_statistics _stats;
+		std::memset(&_stats, 0, sizeof(_stats));
+		return _stats;
+	}
+	return this->_pimp->get_statistics();
+}
+
+#pragma endregion
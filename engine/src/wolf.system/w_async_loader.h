@@ -0,0 +1,159 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_async_loader.h
+	Description		 : A cross platform asynchronous loader for streaming assets
+	Comment          : Each request has a load function and a completion function. Load functions (file I/O, decoding, ...)
+					   are executed on threads of loader in order of priority, then completion functions (creating gpu resources, ...)
+					   are executed on the thread which calls update, within the given time budget
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_ASYNC_LOADER_H__
+#define __W_ASYNC_LOADER_H__
+
+#include "w_system_export.h"
+#include "w_std.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+
+namespace wolf
+{
+	namespace system
+	{
+		enum w_async_load_state
+		{
+			//waiting for a thread of loader
+			ASYNC_LOAD_PENDING = 0,
+			//load function is running
+			ASYNC_LOAD_LOADING,
+			//load function has been done, waiting for update
+			ASYNC_LOAD_LOADED,
+			//completion function has been executed
+			ASYNC_LOAD_COMPLETED,
+			//load function failed, completion function has been executed with the result of load function
+			ASYNC_LOAD_FAILED,
+			//canceled before completion, completion function will not be executed
+			ASYNC_LOAD_CANCELED
+		};
+
+		class w_async_loader_pimp;
+		class w_async_load_request
+		{
+		public:
+			w_async_load_request() :
+				_id(0),
+				_priority(0),
+				_state(ASYNC_LOAD_PENDING),
+				_result(W_PASSED),
+				_cancel_requested(false)
+			{
+			}
+
+			//request cancellation, returns false if request has already been completed
+			bool cancel()
+			{
+				this->_cancel_requested.store(true, std::memory_order_release);
+				auto _state = get_state();
+				return _state != ASYNC_LOAD_COMPLETED && _state != ASYNC_LOAD_FAILED;
+			}
+
+#pragma region Getters
+			uint64_t get_id() const								{ return this->_id; }
+			int get_priority() const							{ return this->_priority; }
+			w_async_load_state get_state() const				{ return static_cast<w_async_load_state>(this->_state.load(std::memory_order_acquire)); }
+			bool get_is_cancel_requested() const				{ return this->_cancel_requested.load(std::memory_order_acquire); }
+			//returns true if request has been completed, failed or canceled
+			bool get_is_done() const
+			{
+				auto _state = get_state();
+				return _state == ASYNC_LOAD_COMPLETED || _state == ASYNC_LOAD_FAILED || _state == ASYNC_LOAD_CANCELED;
+			}
+#pragma endregion
+
+		private:
+			friend class w_async_loader_pimp;
+
+			//prevent copying
+			w_async_load_request(w_async_load_request const&);
+			w_async_load_request& operator= (w_async_load_request const&);
+
+			uint64_t											_id;
+			int													_priority;
+			std::atomic<int>									_state;
+			W_RESULT											_result;
+			std::atomic<bool>									_cancel_requested;
+			std::function<W_RESULT(void)>						_load;
+			std::function<void(const W_RESULT&)>				_on_completed;
+		};
+
+		struct w_async_loader_statistics
+		{
+			size_t	number_of_threads;
+			size_t	requested;
+			size_t	completed;
+			size_t	failed;
+			size_t	canceled;
+			//requests which are waiting for a thread or are loading
+			size_t	in_flight;
+			//requests which are waiting for update
+			size_t	waiting_for_completion;
+			//the longest update in milliseconds
+			double	max_update_time_in_milliseconds;
+		};
+
+		class w_async_loader
+		{
+		public:
+			WSYS_EXP w_async_loader();
+			WSYS_EXP ~w_async_loader();
+
+			//allocate threads of loader, zero means number of hardware thread contexts minus one for the calling thread
+			WSYS_EXP W_RESULT allocate(_In_ const size_t& pNumberOfThreads = 0);
+
+			/*
+				add a request
+				@param pPriority, requests with higher priority will be loaded first, requests with same priority will be loaded in order of adding
+				@param pLoad, will be executed on a thread of loader, must not touch resources of calling thread
+				@param pOnCompleted, will be executed with the result of pLoad on the thread which calls update
+				@return handle of request, which can be used for canceling or querying state of request
+			*/
+			WSYS_EXP std::shared_ptr<w_async_load_request> load(
+				_In_ const int& pPriority,
+				_In_ const std::function<W_RESULT(void)>& pLoad,
+				_In_ const std::function<void(const W_RESULT&)>& pOnCompleted);
+
+			/*
+				execute completion functions of loaded requests on the calling thread, call this function once per frame.
+				At least one completion will be executed, the rest will be executed until pTimeBudgetInMilliseconds elapsed
+				@return number of executed completions
+			*/
+			WSYS_EXP size_t update(_In_ const double& pTimeBudgetInMilliseconds);
+
+			//block until all requests have been loaded, then execute all of completions on the calling thread
+			WSYS_EXP void flush();
+
+			//cancel all pending requests and wait for threads, completion functions of remaining requests will not be executed
+			WSYS_EXP ULONG release();
+
+#pragma region Getters
+			WSYS_EXP size_t get_number_of_threads() const;
+			WSYS_EXP w_async_loader_statistics get_statistics() const;
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_async_loader(w_async_loader const&);
+			w_async_loader& operator= (w_async_loader const&);
+
+			w_async_loader_pimp*								_pimp;
+		};
+	}
+}
+
+#endif //__W_ASYNC_LOADER_H__
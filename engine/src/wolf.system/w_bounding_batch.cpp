@@ -0,0 +1,477 @@
+#include "w_system_pch.h"
+#include "w_bounding_batch.h"
+#include "w_job_system.h"
+#include <cmath>
+
+#if defined(__AVX__) || defined(__AVX2__)
+#include <immintrin.h>
+#define W_BOUNDING_BATCH_AVX
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define W_BOUNDING_BATCH_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define W_BOUNDING_BATCH_NEON
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+using namespace wolf::system;
+
+//number of objects of one word of visibility mask
+static const size_t W_OBJECTS_PER_WORD = 32;
+//minimum number of words of one job, i.e. 2048 objects
+static const size_t W_MIN_WORDS_PER_JOB = 64;
+
+struct w_culling_planes
+{
+	float x[6];
+	float y[6];
+	float z[6];
+	float w[6];
+	float abs_x[6];
+	float abs_y[6];
+	float abs_z[6];
+};
+
+struct w_culling_arrays
+{
+	const float* center_x;
+	const float* center_y;
+	const float* center_z;
+	const float* extent_x;
+	const float* extent_y;
+	const float* extent_z;
+	const float* radius;
+};
+
+static inline uint32_t count_bits(_In_ uint32_t pValue)
+{
+	pValue = pValue - ((pValue >> 1) & 0x55555555u);
+	pValue = (pValue & 0x33333333u) + ((pValue >> 2) & 0x33333333u);
+	return (((pValue + (pValue >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+static inline uint32_t lowest_bit_index(_In_ uint32_t pValue)
+{
+#ifdef _MSC_VER
+	unsigned long _index;
+	_BitScanForward(&_index, pValue);
+	return static_cast<uint32_t>(_index);
+#else
+	return static_cast<uint32_t>(__builtin_ctz(pValue));
+#endif
+}
+
+//planes of w_bounding_frustum are normalized as 4D vectors, normalize them with length of their normals to get distances
+static w_culling_planes get_culling_planes(_In_ const w_bounding_frustum& pFrustum)
+{
+	w_culling_planes _planes;
+	auto _frustum_planes = pFrustum.get_plans();
+	for (size_t i = 0; i < 6; ++i)
+	{
+		auto& _p = _frustum_planes[i];
+		auto _length = std::sqrt(_p.x * _p.x + _p.y * _p.y + _p.z * _p.z);
+		auto _inv_length = _length > 0.0f ? 1.0f / _length : 0.0f;
+
+		_planes.x[i] = _p.x * _inv_length;
+		_planes.y[i] = _p.y * _inv_length;
+		_planes.z[i] = _p.z * _inv_length;
+		_planes.w[i] = _p.w * _inv_length;
+		_planes.abs_x[i] = std::fabs(_planes.x[i]);
+		_planes.abs_y[i] = std::fabs(_planes.y[i]);
+		_planes.abs_z[i] = std::fabs(_planes.z[i]);
+	}
+	return _planes;
+}
+
+//returns true if object is not completely behind any plane
+static inline bool is_visible(
+	_In_ const w_culling_planes& pPlanes,
+	_In_ const w_culling_arrays& pArrays,
+	_In_ const size_t& pIndex)
+{
+	for (size_t i = 0; i < 6; ++i)
+	{
+		auto _distance =
+			pPlanes.x[i] * pArrays.center_x[pIndex] +
+			pPlanes.y[i] * pArrays.center_y[pIndex] +
+			pPlanes.z[i] * pArrays.center_z[pIndex] + pPlanes.w[i];
+		auto _box_radius =
+			pPlanes.abs_x[i] * pArrays.extent_x[pIndex] +
+			pPlanes.abs_y[i] * pArrays.extent_y[pIndex] +
+			pPlanes.abs_z[i] * pArrays.extent_z[pIndex];
+		auto _radius = _box_radius < pArrays.radius[pIndex] ? _box_radius : pArrays.radius[pIndex];
+		if (_distance + _radius <= 0.0f) return false;
+	}
+	return true;
+}
+
+#pragma region kernels
+
+#if defined(W_BOUNDING_BATCH_AVX)
+
+static const size_t W_LANES = 8;
+
+//returns visibility bits of 8 objects starting from pIndex
+static inline uint32_t cull_lanes(
+	_In_ const w_culling_planes& pPlanes,
+	_In_ const w_culling_arrays& pArrays,
+	_In_ const size_t& pIndex)
+{
+	auto _cx = _mm256_loadu_ps(pArrays.center_x + pIndex);
+	auto _cy = _mm256_loadu_ps(pArrays.center_y + pIndex);
+	auto _cz = _mm256_loadu_ps(pArrays.center_z + pIndex);
+	auto _ex = _mm256_loadu_ps(pArrays.extent_x + pIndex);
+	auto _ey = _mm256_loadu_ps(pArrays.extent_y + pIndex);
+	auto _ez = _mm256_loadu_ps(pArrays.extent_z + pIndex);
+	auto _r = _mm256_loadu_ps(pArrays.radius + pIndex);
+	auto _zero = _mm256_setzero_ps();
+
+	int _mask = 0xFF;
+	for (size_t i = 0; i < 6 && _mask; ++i)
+	{
+		auto _distance = _mm256_add_ps(
+			_mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(pPlanes.x[i]), _cx),
+				_mm256_mul_ps(_mm256_set1_ps(pPlanes.y[i]), _cy)),
+			_mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(pPlanes.z[i]), _cz),
+				_mm256_set1_ps(pPlanes.w[i])));
+		auto _box_radius = _mm256_add_ps(
+			_mm256_add_ps(
+				_mm256_mul_ps(_mm256_set1_ps(pPlanes.abs_x[i]), _ex),
+				_mm256_mul_ps(_mm256_set1_ps(pPlanes.abs_y[i]), _ey)),
+			_mm256_mul_ps(_mm256_set1_ps(pPlanes.abs_z[i]), _ez));
+		auto _sum = _mm256_add_ps(_distance, _mm256_min_ps(_box_radius, _r));
+		_mask &= _mm256_movemask_ps(_mm256_cmp_ps(_sum, _zero, _CMP_GT_OQ));
+	}
+	return static_cast<uint32_t>(_mask);
+}
+
+const char* w_bounding_batch::get_kernel_name()
+{
+	return "avx";
+}
+
+#elif defined(W_BOUNDING_BATCH_SSE2)
+
+static const size_t W_LANES = 4;
+
+//returns visibility bits of 4 objects starting from pIndex
+static inline uint32_t cull_lanes(
+	_In_ const w_culling_planes& pPlanes,
+	_In_ const w_culling_arrays& pArrays,
+	_In_ const size_t& pIndex)
+{
+	auto _cx = _mm_loadu_ps(pArrays.center_x + pIndex);
+	auto _cy = _mm_loadu_ps(pArrays.center_y + pIndex);
+	auto _cz = _mm_loadu_ps(pArrays.center_z + pIndex);
+	auto _ex = _mm_loadu_ps(pArrays.extent_x + pIndex);
+	auto _ey = _mm_loadu_ps(pArrays.extent_y + pIndex);
+	auto _ez = _mm_loadu_ps(pArrays.extent_z + pIndex);
+	auto _r = _mm_loadu_ps(pArrays.radius + pIndex);
+	auto _zero = _mm_setzero_ps();
+
+	int _mask = 0xF;
+	for (size_t i = 0; i < 6 && _mask; ++i)
+	{
+		auto _distance = _mm_add_ps(
+			_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(pPlanes.x[i]), _cx),
+				_mm_mul_ps(_mm_set1_ps(pPlanes.y[i]), _cy)),
+			_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(pPlanes.z[i]), _cz),
+				_mm_set1_ps(pPlanes.w[i])));
+		auto _box_radius = _mm_add_ps(
+			_mm_add_ps(
+				_mm_mul_ps(_mm_set1_ps(pPlanes.abs_x[i]), _ex),
+				_mm_mul_ps(_mm_set1_ps(pPlanes.abs_y[i]), _ey)),
+			_mm_mul_ps(_mm_set1_ps(pPlanes.abs_z[i]), _ez));
+		auto _sum = _mm_add_ps(_distance, _mm_min_ps(_box_radius, _r));
+		_mask &= _mm_movemask_ps(_mm_cmpgt_ps(_sum, _zero));
+	}
+	return static_cast<uint32_t>(_mask);
+}
+
+const char* w_bounding_batch::get_kernel_name()
+{
+	return "sse2";
+}
+
+#elif defined(W_BOUNDING_BATCH_NEON)
+
+static const size_t W_LANES = 4;
+
+//returns visibility bits of 4 objects starting from pIndex
+static inline uint32_t cull_lanes(
+	_In_ const w_culling_planes& pPlanes,
+	_In_ const w_culling_arrays& pArrays,
+	_In_ const size_t& pIndex)
+{
+	auto _cx = vld1q_f32(pArrays.center_x + pIndex);
+	auto _cy = vld1q_f32(pArrays.center_y + pIndex);
+	auto _cz = vld1q_f32(pArrays.center_z + pIndex);
+	auto _ex = vld1q_f32(pArrays.extent_x + pIndex);
+	auto _ey = vld1q_f32(pArrays.extent_y + pIndex);
+	auto _ez = vld1q_f32(pArrays.extent_z + pIndex);
+	auto _r = vld1q_f32(pArrays.radius + pIndex);
+
+	auto _visible = vdupq_n_u32(0xFFFFFFFFu);
+	for (size_t i = 0; i < 6; ++i)
+	{
+		auto _distance = vmlaq_n_f32(vmlaq_n_f32(vmlaq_n_f32(vdupq_n_f32(pPlanes.w[i]),
+			_cx, pPlanes.x[i]),
+			_cy, pPlanes.y[i]),
+			_cz, pPlanes.z[i]);
+		auto _box_radius = vmlaq_n_f32(vmlaq_n_f32(vmulq_n_f32(
+			_ex, pPlanes.abs_x[i]),
+			_ey, pPlanes.abs_y[i]),
+			_ez, pPlanes.abs_z[i]);
+		auto _sum = vaddq_f32(_distance, vminq_f32(_box_radius, _r));
+		_visible = vandq_u32(_visible, vcgtq_f32(_sum, vdupq_n_f32(0.0f)));
+	}
+
+	//gather one bit per lane
+	const uint32_t _lane_bits[4] = { 1, 2, 4, 8 };
+	auto _bits = vandq_u32(_visible, vld1q_u32(_lane_bits));
+	auto _pair = vadd_u32(vget_low_u32(_bits), vget_high_u32(_bits));
+	_pair = vpadd_u32(_pair, _pair);
+	return vget_lane_u32(_pair, 0);
+}
+
+const char* w_bounding_batch::get_kernel_name()
+{
+	return "neon";
+}
+
+#else
+
+static const size_t W_LANES = 1;
+
+static inline uint32_t cull_lanes(
+	_In_ const w_culling_planes& pPlanes,
+	_In_ const w_culling_arrays& pArrays,
+	_In_ const size_t& pIndex)
+{
+	return is_visible(pPlanes, pArrays, pIndex) ? 1u : 0u;
+}
+
+const char* w_bounding_batch::get_kernel_name()
+{
+	return "scalar";
+}
+
+#endif
+
+//cull words of visibility mask in range of [pBeginWord, pEndWord)
+static void cull_words(
+	_In_ const w_culling_planes& pPlanes,
+	_In_ const w_culling_arrays& pArrays,
+	_In_ const size_t& pCount,
+	_In_ const size_t& pBeginWord,
+	_In_ const size_t& pEndWord,
+	_Inout_ uint32_t* pVisibility)
+{
+	for (size_t _word = pBeginWord; _word < pEndWord; ++_word)
+	{
+		auto _begin = _word * W_OBJECTS_PER_WORD;
+		auto _end = _begin + W_OBJECTS_PER_WORD < pCount ? _begin + W_OBJECTS_PER_WORD : pCount;
+
+		uint32_t _bits = 0;
+		auto i = _begin;
+		for (; i + W_LANES <= _end; i += W_LANES)
+		{
+			_bits |= cull_lanes(pPlanes, pArrays, i) << (i - _begin);
+		}
+		//remaining objects of the last word
+		for (; i < _end; ++i)
+		{
+			if (is_visible(pPlanes, pArrays, i))
+			{
+				_bits |= 1u << (i - _begin);
+			}
+		}
+		pVisibility[_word] = _bits;
+	}
+}
+
+#pragma endregion
+
+w_bounding_batch::w_bounding_batch()
+{
+}
+
+w_bounding_batch::~w_bounding_batch()
+{
+}
+
+void w_bounding_batch::reserve(_In_ const size_t& pCount)
+{
+	this->_center_x.reserve(pCount);
+	this->_center_y.reserve(pCount);
+	this->_center_z.reserve(pCount);
+	this->_extent_x.reserve(pCount);
+	this->_extent_y.reserve(pCount);
+	this->_extent_z.reserve(pCount);
+	this->_radius.reserve(pCount);
+}
+
+void w_bounding_batch::clear()
+{
+	this->_center_x.clear();
+	this->_center_y.clear();
+	this->_center_z.clear();
+	this->_extent_x.clear();
+	this->_extent_y.clear();
+	this->_extent_z.clear();
+	this->_radius.clear();
+}
+
+size_t w_bounding_batch::add(_In_ const w_bounding_box& pBox)
+{
+	auto _index = get_size();
+	add(glm::vec3(0.0f), glm::vec3(0.0f), 0.0f);
+	set(_index, pBox);
+	return _index;
+}
+
+size_t w_bounding_batch::add(_In_ const w_bounding_sphere& pSphere)
+{
+	auto _index = get_size();
+	add(glm::vec3(0.0f), glm::vec3(0.0f), 0.0f);
+	set(_index, pSphere);
+	return _index;
+}
+
+size_t w_bounding_batch::add(_In_ const glm::vec3& pCenter, _In_ const glm::vec3& pHalfExtents, _In_ float pRadius)
+{
+	auto _index = get_size();
+
+	this->_center_x.push_back(0.0f);
+	this->_center_y.push_back(0.0f);
+	this->_center_z.push_back(0.0f);
+	this->_extent_x.push_back(0.0f);
+	this->_extent_y.push_back(0.0f);
+	this->_extent_z.push_back(0.0f);
+	this->_radius.push_back(0.0f);
+
+	set(_index, pCenter, pHalfExtents, pRadius);
+	return _index;
+}
+
+void w_bounding_batch::set(_In_ const size_t& pIndex, _In_ const w_bounding_box& pBox)
+{
+	glm::vec3 _min(pBox.min[0], pBox.min[1], pBox.min[2]);
+	glm::vec3 _max(pBox.max[0], pBox.max[1], pBox.max[2]);
+	set(pIndex, (_min + _max) * 0.5f, (_max - _min) * 0.5f);
+}
+
+void w_bounding_batch::set(_In_ const size_t& pIndex, _In_ const w_bounding_sphere& pSphere)
+{
+	set(pIndex,
+		glm::vec3(pSphere.center[0], pSphere.center[1], pSphere.center[2]),
+		glm::vec3(pSphere.radius),
+		pSphere.radius);
+}
+
+void w_bounding_batch::set(_In_ const size_t& pIndex, _In_ const glm::vec3& pCenter, _In_ const glm::vec3& pHalfExtents, _In_ float pRadius)
+{
+	if (pRadius < 0.0f)
+	{
+		pRadius = std::sqrt(
+			pHalfExtents.x * pHalfExtents.x +
+			pHalfExtents.y * pHalfExtents.y +
+			pHalfExtents.z * pHalfExtents.z);
+	}
+
+	this->_center_x[pIndex] = pCenter.x;
+	this->_center_y[pIndex] = pCenter.y;
+	this->_center_z[pIndex] = pCenter.z;
+	this->_extent_x[pIndex] = pHalfExtents.x;
+	this->_extent_y[pIndex] = pHalfExtents.y;
+	this->_extent_z[pIndex] = pHalfExtents.z;
+	this->_radius[pIndex] = pRadius;
+}
+
+size_t w_bounding_batch::cull(
+	_In_ const w_bounding_frustum& pFrustum,
+	_Inout_ std::vector<uint32_t>& pVisibility,
+	_In_opt_ w_job_system* pJobSystem) const
+{
+	auto _count = get_size();
+	auto _words = (_count + W_OBJECTS_PER_WORD - 1) / W_OBJECTS_PER_WORD;
+	pVisibility.resize(_words);
+	if (_count == 0) return 0;
+
+	auto _planes = get_culling_planes(pFrustum);
+
+	w_culling_arrays _arrays;
+	_arrays.center_x = this->_center_x.data();
+	_arrays.center_y = this->_center_y.data();
+	_arrays.center_z = this->_center_z.data();
+	_arrays.extent_x = this->_extent_x.data();
+	_arrays.extent_y = this->_extent_y.data();
+	_arrays.extent_z = this->_extent_z.data();
+	_arrays.radius = this->_radius.data();
+
+	auto _visibility = pVisibility.data();
+	if (pJobSystem && _words > W_MIN_WORDS_PER_JOB)
+	{
+		//each job writes its own words, so jobs never share a word of visibility mask
+		auto _ranges = 4 * pJobSystem->get_number_of_workers();
+		auto _grain = (_words + _ranges - 1) / _ranges;
+		if (_grain < W_MIN_WORDS_PER_JOB) _grain = W_MIN_WORDS_PER_JOB;
+
+		pJobSystem->parallel_for(_words, _grain, [&](_In_ const size_t& pBegin, _In_ const size_t& pEnd)
+		{
+			cull_words(_planes, _arrays, _count, pBegin, pEnd, _visibility);
+		});
+	}
+	else
+	{
+		cull_words(_planes, _arrays, _count, 0, _words, _visibility);
+	}
+
+	size_t _visible = 0;
+	for (size_t i = 0; i < _words; ++i)
+	{
+		_visible += count_bits(_visibility[i]);
+	}
+	return _visible;
+}
+
+size_t w_bounding_batch::cull_to_indices(
+	_In_ const w_bounding_frustum& pFrustum,
+	_Inout_ std::vector<uint32_t>& pVisibleIndices,
+	_In_opt_ w_job_system* pJobSystem) const
+{
+	std::vector<uint32_t> _visibility;
+	auto _visible = cull(pFrustum, _visibility, pJobSystem);
+
+	//compact indices of set bits
+	pVisibleIndices.resize(_visible);
+	size_t _index = 0;
+	for (size_t i = 0; i < _visibility.size(); ++i)
+	{
+		auto _bits = _visibility[i];
+		auto _base = static_cast<uint32_t>(i * W_OBJECTS_PER_WORD);
+		while (_bits)
+		{
+			pVisibleIndices[_index++] = _base + lowest_bit_index(_bits);
+			_bits &= _bits - 1;
+		}
+	}
+	return _visible;
+}
+
+#pragma region Getters
+
+size_t w_bounding_batch::get_size() const
+{
+	return this->_radius.size();
+}
+
+#pragma endregion
@@ -0,0 +1,104 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_bounding_batch.h
+	Description		 : Structure of arrays storage of bounding volumes which are culled against frustum in batches
+	Comment          : Each object is stored as center, half extents and radius in separate arrays, so culling only reads
+					   28 bytes per object instead of the whole w_bounding_box. Kernel tests 8 objects per iteration with AVX,
+					   4 objects with SSE2 or NEON and falls back to scalar code on other platforms.
+					   An object is visible if it is not completely behind one of the planes, both of its box and its sphere
+					   are tested, so culling of boxes is tighter than w_bounding_frustum::intersects
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_BOUNDING_BATCH_H__
+#define __W_BOUNDING_BATCH_H__
+
+#include "w_system_export.h"
+#include "w_std.h"
+#include "w_bounding.h"
+#include <vector>
+
+namespace wolf
+{
+	namespace system
+	{
+		class w_job_system;
+		class w_bounding_batch
+		{
+		public:
+			WSYS_EXP w_bounding_batch();
+			WSYS_EXP ~w_bounding_batch();
+
+			//reserve memory for number of objects
+			WSYS_EXP void reserve(_In_ const size_t& pCount);
+			//remove all objects
+			WSYS_EXP void clear();
+
+			//add bounding box and returns index of object
+			WSYS_EXP size_t add(_In_ const w_bounding_box& pBox);
+			//add bounding sphere and returns index of object
+			WSYS_EXP size_t add(_In_ const w_bounding_sphere& pSphere);
+			//add an object from center and half extents, radius will be length of half extents if it is negative
+			WSYS_EXP size_t add(_In_ const glm::vec3& pCenter, _In_ const glm::vec3& pHalfExtents, _In_ float pRadius = -1.0f);
+
+			//update bounding box of object
+			WSYS_EXP void set(_In_ const size_t& pIndex, _In_ const w_bounding_box& pBox);
+			//update bounding sphere of object
+			WSYS_EXP void set(_In_ const size_t& pIndex, _In_ const w_bounding_sphere& pSphere);
+			//update center and half extents of object, radius will be length of half extents if it is negative
+			WSYS_EXP void set(_In_ const size_t& pIndex, _In_ const glm::vec3& pCenter, _In_ const glm::vec3& pHalfExtents, _In_ float pRadius = -1.0f);
+
+			/*
+				cull all objects against frustum
+				@param pFrustum, frustum which has been updated with view projection matrix
+				@param pVisibility, bit i of word (i / 32) will be set if object i is visible, size of vector will be (get_size() + 31) / 32
+				@param pJobSystem, optional job system, if it is not null, objects will be culled in parallel
+				@return number of visible objects
+			*/
+			WSYS_EXP size_t cull(
+				_In_ const w_bounding_frustum& pFrustum,
+				_Inout_ std::vector<uint32_t>& pVisibility,
+				_In_opt_ w_job_system* pJobSystem = nullptr) const;
+
+			/*
+				cull all objects against frustum and write indices of visible objects
+				@param pFrustum, frustum which has been updated with view projection matrix
+				@param pVisibleIndices, indices of visible objects in ascending order
+				@param pJobSystem, optional job system, if it is not null, objects will be culled in parallel
+				@return number of visible objects
+			*/
+			WSYS_EXP size_t cull_to_indices(
+				_In_ const w_bounding_frustum& pFrustum,
+				_Inout_ std::vector<uint32_t>& pVisibleIndices,
+				_In_opt_ w_job_system* pJobSystem = nullptr) const;
+
+#pragma region Getters
+
+			WSYS_EXP size_t get_size() const;
+			//returns name of culling kernel which has been compiled, i.e. "avx", "sse2", "neon" or "scalar"
+			WSYS_EXP static const char* get_kernel_name();
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_bounding_batch(w_bounding_batch const&);
+			w_bounding_batch& operator= (w_bounding_batch const&);
+
+			std::vector<float>								_center_x;
+			std::vector<float>								_center_y;
+			std::vector<float>								_center_z;
+			std::vector<float>								_extent_x;
+			std::vector<float>								_extent_y;
+			std::vector<float>								_extent_z;
+			std::vector<float>								_radius;
+		};
+	}
+}
+
+#endif //__W_BOUNDING_BATCH_H__
@@ -17,6 +17,17 @@
 #include <vector>
 #include <codecvt>
 #include <string.h>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define __W_CONVERT_SSE2__
+#include <emmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
 
 #if	defined(__WIN32) || defined(__UWP)
 
@@ -282,6 +293,232 @@ namespace wolf
 
 #pragma endregion
 
+#pragma region fast number convert functions
+
+			//returns pointer to the first character which is not space, tab, carriage return or new line
+			inline const char* skip_white_spaces(_In_ const char* pBegin, _In_ const char* pEnd)
+			{
+#ifdef __W_CONVERT_SSE2__
+				//characters less than or equal to space are treated as white spaces, 16 characters per iteration
+				const __m128i _space = _mm_set1_epi8(' ');
+				while (pEnd - pBegin >= 16)
+				{
+					auto _chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBegin));
+					auto _mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(_chars, _space), _space));
+					if (_mask != 0xFFFF)
+					{
+#ifdef _MSC_VER
+						unsigned long _index;
+						_BitScanForward(&_index, static_cast<unsigned long>(~_mask & 0xFFFF));
+						return pBegin + _index;
+#else
+						return pBegin + __builtin_ctz(static_cast<unsigned int>(~_mask & 0xFFFF));
+#endif
+					}
+					pBegin += 16;
+				}
+#endif
+				while (pBegin < pEnd && (*pBegin == ' ' || *pBegin == '\n' || *pBegin == '\r' || *pBegin == '\t'))
+				{
+					++pBegin;
+				}
+				return pBegin;
+			}
+
+			/*
+				convert characters to integer same as std::from_chars of C++17
+				@param pBegin, first character
+				@param pEnd, end of characters
+				@param pValue, converted value
+				@return pointer to the first character after number, or pBegin if there is no number
+			*/
+			template<class T>
+			auto from_chars(_In_ const char* pBegin, _In_ const char* pEnd, _Out_ T& pValue) -> typename std::enable_if<std::is_integral<T>::value, const char*>::type
+			{
+				auto _ptr = pBegin;
+				auto _negative = false;
+				if (_ptr < pEnd && (*_ptr == '-' || *_ptr == '+'))
+				{
+					_negative = *_ptr == '-';
+					++_ptr;
+				}
+
+				auto _digits_begin = _ptr;
+				uint64_t _value = 0;
+				while (_ptr < pEnd && static_cast<unsigned char>(*_ptr - '0') < 10)
+				{
+					_value = _value * 10 + static_cast<uint64_t>(*_ptr - '0');
+					++_ptr;
+				}
+				if (_ptr == _digits_begin) return pBegin;
+
+				pValue = static_cast<T>(_negative ? static_cast<uint64_t>(0) - _value : _value);
+				return _ptr;
+			}
+
+			/*
+				convert characters to floating point same as std::from_chars of C++17, numbers with up to 19 significant digits
+				and exponents in range of exactly representable powers of ten are computed directly, others use strtod
+				@param pBegin, first character
+				@param pEnd, end of characters
+				@param pValue, converted value
+				@return pointer to the first character after number, or pBegin if there is no number
+			*/
+			template<class T>
+			auto from_chars(_In_ const char* pBegin, _In_ const char* pEnd, _Out_ T& pValue) -> typename std::enable_if<std::is_floating_point<T>::value, const char*>::type
+			{
+				static const double _powers_of_ten[] =
+				{
+					1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+					1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+				};
+				const uint64_t _max_mantissa = 1000000000000000000ULL;
+
+				auto _ptr = pBegin;
+				auto _negative = false;
+				if (_ptr < pEnd && (*_ptr == '-' || *_ptr == '+'))
+				{
+					_negative = *_ptr == '-';
+					++_ptr;
+				}
+
+				uint64_t _mantissa = 0;
+				int _exponent = 0;
+				size_t _digits = 0;
+				bool _truncated = false;
+
+				while (_ptr < pEnd && static_cast<unsigned char>(*_ptr - '0') < 10)
+				{
+					if (_mantissa < _max_mantissa)
+					{
+						_mantissa = _mantissa * 10 + static_cast<uint64_t>(*_ptr - '0');
+					}
+					else
+					{
+						_exponent++;
+						_truncated = true;
+					}
+					++_digits;
+					++_ptr;
+				}
+				if (_ptr < pEnd && *_ptr == '.')
+				{
+					++_ptr;
+					while (_ptr < pEnd && static_cast<unsigned char>(*_ptr - '0') < 10)
+					{
+						if (_mantissa < _max_mantissa)
+						{
+							_mantissa = _mantissa * 10 + static_cast<uint64_t>(*_ptr - '0');
+							_exponent--;
+						}
+						else
+						{
+							_truncated = true;
+						}
+						++_digits;
+						++_ptr;
+					}
+				}
+				if (!_digits) return pBegin;
+
+				//exponent will be used only if it has digits
+				if (_ptr < pEnd && (*_ptr == 'e' || *_ptr == 'E'))
+				{
+					auto _exp_ptr = _ptr + 1;
+					auto _exp_negative = false;
+					if (_exp_ptr < pEnd && (*_exp_ptr == '-' || *_exp_ptr == '+'))
+					{
+						_exp_negative = *_exp_ptr == '-';
+						++_exp_ptr;
+					}
+					if (_exp_ptr < pEnd && static_cast<unsigned char>(*_exp_ptr - '0') < 10)
+					{
+						int _exp_value = 0;
+						while (_exp_ptr < pEnd && static_cast<unsigned char>(*_exp_ptr - '0') < 10)
+						{
+							if (_exp_value < 100000)
+							{
+								_exp_value = _exp_value * 10 + (*_exp_ptr - '0');
+							}
+							++_exp_ptr;
+						}
+						_exponent += _exp_negative ? -_exp_value : _exp_value;
+						_ptr = _exp_ptr;
+					}
+				}
+
+				double _value;
+				if (!_truncated && _mantissa <= (1ULL << 53) && _exponent >= -22 && _exponent <= 22)
+				{
+					//mantissa and power of ten are exact, so the result is correctly rounded
+					_value = static_cast<double>(_mantissa);
+					_value = _exponent < 0 ? _value / _powers_of_ten[-_exponent] : _value * _powers_of_ten[_exponent];
+					if (_negative) _value = -_value;
+				}
+				else
+				{
+					char _buffer[64];
+					auto _size = static_cast<size_t>(_ptr - pBegin);
+					if (_size < sizeof(_buffer))
+					{
+						std::memcpy(_buffer, pBegin, _size);
+						_buffer[_size] = '\0';
+						_value = std::strtod(_buffer, nullptr);
+					}
+					else
+					{
+						_value = std::strtod(std::string(pBegin, _size).c_str(), nullptr);
+					}
+				}
+
+				pValue = static_cast<T>(_value);
+				return _ptr;
+			}
+
+			/*
+				convert all numbers of characters which have been separated by white spaces, characters which are not part of
+				any number will be skipped
+				@param pStr, characters
+				@param pLength, length of characters
+				@param pResult, converted numbers will be appended to this vector
+				@param pExpectedCount, number of expected numbers, used for reserving memory of result
+			*/
+			template<class T>
+			inline void parse_all_numbers_then_convert_to(
+				_In_ const char* pStr,
+				_In_ const size_t& pLength,
+				_Inout_ std::vector<T>& pResult,
+				_In_ const size_t& pExpectedCount = 0)
+			{
+				if (!pStr) return;
+
+				if (pExpectedCount)
+				{
+					pResult.reserve(pResult.size() + pExpectedCount);
+				}
+
+				auto _end = pStr + pLength;
+				auto _ptr = skip_white_spaces(pStr, _end);
+				while (_ptr < _end)
+				{
+					T _value;
+					auto _next = from_chars(_ptr, _end, _value);
+					if (_next == _ptr)
+					{
+						//not a number, skip it
+						++_ptr;
+					}
+					else
+					{
+						pResult.push_back(_value);
+						_ptr = _next;
+					}
+					_ptr = skip_white_spaces(_ptr, _end);
+				}
+			}
+
+#pragma endregion
+
 #pragma region sub wstring convert functions
 
 #ifdef __WIN32
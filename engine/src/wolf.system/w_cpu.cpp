@@ -1,18 +1,450 @@
 #include "w_system_pch.h"
 #include "w_cpu.h"
+#include "w_thread.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
-#ifdef __WIN32
+#if defined(__ANDROID) || defined(__linux)
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#define W_CPU_PROCFS
+#elif defined(__WIN32)
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#endif
+
+namespace wolf
+{
+	namespace system
+	{
+		class w_cpu_pimp
+		{
+		public:
+			w_cpu_pimp() :
+				_is_running(false),
+				_stop_requested(false),
+				_back(0),
+				_middle(1),
+				_front(2),
+				_sequence(0)
+			{
+			}
+
+			~w_cpu_pimp()
+			{
+				stop();
+			}
+
+			W_RESULT start(_In_ const w_cpu_configs& pConfigs)
+			{
+#if !defined(W_CPU_PROCFS) && !defined(__WIN32)
+				W_UNUSED(pConfigs);
+				logger.error("w_cpu sampling is not supported on this platform");
+				return W_FAILED;
+#else
+				if (this->_is_running.load(std::memory_order_acquire))
+				{
+					logger.error("w_cpu sampler has already been started");
+					return W_FAILED;
+				}
+
+				this->_configs = pConfigs;
+				if (this->_configs.sample_interval_in_ms == 0)
+				{
+					this->_configs.sample_interval_in_ms = 1;
+				}
+
+				//counters of previous run must not be the base of the first sample
+				std::fill(std::begin(this->_core_ticks), std::end(this->_core_ticks), 0);
+				std::fill(std::begin(this->_core_idle_ticks), std::end(this->_core_idle_ticks), 0);
+				this->_process_ticks = 0;
+				this->_thread_ticks.clear();
+
+				this->_stop_requested = false;
+				this->_is_running.store(true, std::memory_order_release);
+				this->_thread = std::thread(&w_cpu_pimp::_sampler_loop, this);
+
+				return W_PASSED;
+#endif
+			}
+
+			void stop()
+			{
+				if (!this->_thread.joinable()) return;
+
+				{
+					std::lock_guard<std::mutex> _lock(this->_mutex);
+					this->_stop_requested = true;
+				}
+				this->_cv.notify_one();
+				this->_thread.join();
+				this->_is_running.store(false, std::memory_order_release);
+			}
+
+			bool get_snapshot(_Inout_ w_cpu_snapshot& pSnapshot)
+			{
+				//swap front buffer with the published one, the sampler only writes to the back buffer
+				auto _has_new = (this->_middle.load(std::memory_order_acquire) & FRESH_BIT) != 0;
+				if (_has_new)
+				{
+					this->_front = this->_middle.exchange(this->_front, std::memory_order_acq_rel) & INDEX_MASK;
+				}
+				pSnapshot = this->_buffers[this->_front];
+				return _has_new;
+			}
+
+			bool get_is_running() const
+			{
+				return this->_is_running.load(std::memory_order_acquire);
+			}
+
+		private:
+			typedef std::chrono::steady_clock _clock;
+
+			void _sampler_loop()
+			{
+				w_thread::set_current_thread_name("wolf_cpu");
+
+				auto _start = _clock::now();
+				auto _interval = std::chrono::milliseconds(this->_configs.sample_interval_in_ms);
+
+				//take the first sample as the base of utilizations, it will not be published
+				_sample(this->_buffers[this->_back]);
+
+				while (true)
+				{
+					{
+						std::unique_lock<std::mutex> _lock(this->_mutex);
+						if (this->_cv.wait_for(_lock, _interval, [this]() { return this->_stop_requested; })) break;
+					}
+
+					auto _t0 = _clock::now();
+
+					auto& _snapshot = this->_buffers[this->_back];
+					_sample(_snapshot);
+
+					auto _t1 = _clock::now();
+					_snapshot.sequence = ++this->_sequence;
+					_snapshot.time_in_seconds = std::chrono::duration<double>(_t1 - _start).count();
+					_snapshot.sample_time_in_ms = std::chrono::duration<double, std::milli>(_t1 - _t0).count();
+
+					//publish back buffer and take the previous middle buffer as the next back buffer
+					this->_back = this->_middle.exchange(this->_back | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+				}
+			}
+
+#ifdef W_CPU_PROCFS
+
+			void _sample(_Inout_ w_cpu_snapshot& pSnapshot)
+			{
+				uint64_t _total_ticks = 0;
+				_sample_cores(pSnapshot, _total_ticks);
+				_sample_process(pSnapshot, _total_ticks);
+				_sample_threads(pSnapshot, _total_ticks);
+			}
+
+			//read utilizations of cores from /proc/stat, pTotalTicks is the sum of ticks of all cores since last sample
+			void _sample_cores(_Inout_ w_cpu_snapshot& pSnapshot, _Inout_ uint64_t& pTotalTicks)
+			{
+				pSnapshot.total_utilization = 0.0f;
+				pSnapshot.number_of_cores = 0;
+
+				auto _file = std::fopen("/proc/stat", "r");
+				if (!_file) return;
+
+				char _line[256];
+				while (std::fgets(_line, sizeof(_line), _file))
+				{
+					//cpu lines are at the beginning of file
+					if (std::strncmp(_line, "cpu", 3) != 0) break;
+
+					//index zero is the sum of all cores
+					size_t _index = 0;
+					const char* _values = _line + 3;
+					if (*_values != ' ')
+					{
+						char* _end = nullptr;
+						_index = static_cast<size_t>(std::strtoul(_values, &_end, 10)) + 1;
+						_values = _end;
+						if (_index > W_CPU_MAX_CORES) continue;
+					}
+
+					unsigned long long _user = 0, _nice = 0, _system = 0, _idle = 0,
+						_iowait = 0, _irq = 0, _softirq = 0, _steal = 0;
+					if (std::sscanf(_values, "%llu %llu %llu %llu %llu %llu %llu %llu",
+						&_user, &_nice, &_system, &_idle, &_iowait, &_irq, &_softirq, &_steal) < 4) continue;
+
+					uint64_t _idle_ticks = _idle + _iowait;
+					uint64_t _ticks = _user + _nice + _system + _irq + _softirq + _steal + _idle_ticks;
+
+					//counters may go backward when a core goes offline
+					uint64_t _delta = _ticks > this->_core_ticks[_index] ? _ticks - this->_core_ticks[_index] : 0;
+					uint64_t _delta_idle = _idle_ticks > this->_core_idle_ticks[_index] ? _idle_ticks - this->_core_idle_ticks[_index] : 0;
+					this->_core_ticks[_index] = _ticks;
+					this->_core_idle_ticks[_index] = _idle_ticks;
+
+					float _utilization = 0.0f;
+					if (_delta)
+					{
+						_utilization = 100.0f * static_cast<float>(_delta - std::min(_delta, _delta_idle)) / static_cast<float>(_delta);
+					}
+
+					if (_index == 0)
+					{
+						pSnapshot.total_utilization = _utilization;
+						pTotalTicks = _delta;
+					}
+					else
+					{
+						pSnapshot.core_utilizations[_index - 1] = _utilization;
+						pSnapshot.number_of_cores = std::max(pSnapshot.number_of_cores, static_cast<uint32_t>(_index));
+					}
+				}
+				std::fclose(_file);
+			}
+
+			void _sample_process(_Inout_ w_cpu_snapshot& pSnapshot, _In_ const uint64_t& pTotalTicks)
+			{
+				//getrusage accumulates the counters of all threads of process
+				struct rusage _usage;
+				if (getrusage(RUSAGE_SELF, &_usage) == 0)
+				{
+					pSnapshot.process_user_time_in_ms = _usage.ru_utime.tv_sec * 1000.0 + _usage.ru_utime.tv_usec / 1000.0;
+					pSnapshot.process_system_time_in_ms = _usage.ru_stime.tv_sec * 1000.0 + _usage.ru_stime.tv_usec / 1000.0;
+					//ru_maxrss is in kilobytes
+					pSnapshot.peak_rss_in_bytes = static_cast<uint64_t>(_usage.ru_maxrss) * 1024;
+					pSnapshot.voluntary_context_switches = static_cast<uint64_t>(_usage.ru_nvcsw);
+					pSnapshot.involuntary_context_switches = static_cast<uint64_t>(_usage.ru_nivcsw);
+					pSnapshot.minor_page_faults = static_cast<uint64_t>(_usage.ru_minflt);
+					pSnapshot.major_page_faults = static_cast<uint64_t>(_usage.ru_majflt);
+				}
+
+				//second value of statm is the number of resident pages
+				auto _file = std::fopen("/proc/self/statm", "r");
+				if (_file)
+				{
+					unsigned long long _size = 0, _resident = 0;
+					if (std::fscanf(_file, "%llu %llu", &_size, &_resident) == 2)
+					{
+						pSnapshot.rss_in_bytes = _resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+					}
+					std::fclose(_file);
+				}
+
+				//convert process time to ticks, so it can be compared with the ticks of /proc/stat
+				auto _ms_per_tick = 1000.0 / _get_ticks_per_second();
+				auto _process_ticks = static_cast<uint64_t>(
+					(pSnapshot.process_user_time_in_ms + pSnapshot.process_system_time_in_ms) / _ms_per_tick);
+				auto _delta = _process_ticks > this->_process_ticks ? _process_ticks - this->_process_ticks : 0;
+				this->_process_ticks = _process_ticks;
+
+				pSnapshot.process_utilization = pTotalTicks ?
+					std::min(100.0f, 100.0f * static_cast<float>(_delta) / static_cast<float>(pTotalTicks)) : 0.0f;
+			}
+
+			//read cpu time of threads from /proc/self/task/<tid>/stat
+			void _sample_threads(_Inout_ w_cpu_snapshot& pSnapshot, _In_ const uint64_t& pTotalTicks)
+			{
+				pSnapshot.number_of_threads = 0;
+				pSnapshot.number_of_dropped_threads = 0;
+
+				auto _dir = opendir("/proc/self/task");
+				if (!_dir) return;
+
+				//ticks of one core during last interval
+				auto _core_ticks = pSnapshot.number_of_cores ?
+					static_cast<double>(pTotalTicks) / pSnapshot.number_of_cores : 0.0;
+				auto _ms_per_tick = 1000.0 / _get_ticks_per_second();
+				auto& _prefix = this->_configs.thread_name_prefix;
+
+				std::unordered_map<int64_t, uint64_t> _thread_ticks;
+				struct dirent* _entry = nullptr;
+				while ((_entry = readdir(_dir)) != nullptr)
+				{
+					if (_entry->d_name[0] < '0' || _entry->d_name[0] > '9') continue;
+
+					char _path[320];
+					std::snprintf(_path, sizeof(_path), "/proc/self/task/%s/stat", _entry->d_name);
+					auto _file = std::fopen(_path, "r");
+					if (!_file) continue;
+
+					char _buffer[512];
+					auto _size = std::fread(_buffer, 1, sizeof(_buffer) - 1, _file);
+					std::fclose(_file);
+					_buffer[_size] = '\0';
+
+					//name of thread is between parentheses and it may contain spaces or parentheses
+					auto _open = std::strchr(_buffer, '(');
+					auto _close = std::strrchr(_buffer, ')');
+					if (!_open || !_close || _close < _open) continue;
+
+					auto _name_length = static_cast<size_t>(_close - _open - 1);
+					if (_name_length < _prefix.size() ||
+						std::strncmp(_open + 1, _prefix.c_str(), _prefix.size()) != 0) continue;
+
+					//utime and stime are fields 14 and 15, fields after name start from 3
+					unsigned long long _utime = 0, _stime = 0;
+					if (std::sscanf(_close + 1, " %*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu",
+						&_utime, &_stime) != 2) continue;
+
+					auto _id = static_cast<int64_t>(std::strtoll(_entry->d_name, nullptr, 10));
+					uint64_t _ticks = _utime + _stime;
+					_thread_ticks[_id] = _ticks;
+
+					if (pSnapshot.number_of_threads == W_CPU_MAX_THREADS)
+					{
+						pSnapshot.number_of_dropped_threads++;
+						continue;
+					}
+
+					auto& _thread = pSnapshot.threads[pSnapshot.number_of_threads++];
+					_name_length = std::min(_name_length, static_cast<size_t>(W_CPU_MAX_THREAD_NAME - 1));
+					std::memcpy(_thread.name, _open + 1, _name_length);
+					_thread.name[_name_length] = '\0';
+					_thread.id = _id;
+					_thread.user_time_in_ms = _utime * _ms_per_tick;
+					_thread.system_time_in_ms = _stime * _ms_per_tick;
+
+					//threads which have been created during last interval have no previous ticks
+					auto _previous = this->_thread_ticks.find(_id);
+					auto _delta = _previous != this->_thread_ticks.end() && _ticks > _previous->second ?
+						_ticks - _previous->second : 0;
+					_thread.utilization = _core_ticks > 0.0 ?
+						std::min(100.0f, static_cast<float>(100.0 * _delta / _core_ticks)) : 0.0f;
+				}
+				closedir(_dir);
+
+				//keep only alive threads for the next sample
+				this->_thread_ticks.swap(_thread_ticks);
+
+				std::sort(pSnapshot.threads, pSnapshot.threads + pSnapshot.number_of_threads,
+					[](const w_cpu_thread_usage& pLeft, const w_cpu_thread_usage& pRight)
+				{
+					return std::strcmp(pLeft.name, pRight.name) < 0;
+				});
+			}
+
+			static double _get_ticks_per_second()
+			{
+				static const double _ticks_per_second = static_cast<double>(sysconf(_SC_CLK_TCK));
+				return _ticks_per_second > 0.0 ? _ticks_per_second : 100.0;
+			}
+
+#elif defined(__WIN32)
+
+			static uint64_t _to_uint64(_In_ const FILETIME& pTime)
+			{
+				return (static_cast<uint64_t>(pTime.dwHighDateTime) << 32) | pTime.dwLowDateTime;
+			}
+
+			//per core and per thread values and context switches are not available on windows
+			void _sample(_Inout_ w_cpu_snapshot& pSnapshot)
+			{
+				uint64_t _delta_total = 0;
+
+				//kernel time of GetSystemTimes includes idle time, all values are accumulated over all cores
+				FILETIME _idle_time, _kernel_time, _user_time;
+				if (GetSystemTimes(&_idle_time, &_kernel_time, &_user_time))
+				{
+					auto _idle = _to_uint64(_idle_time);
+					auto _total = _to_uint64(_kernel_time) + _to_uint64(_user_time);
+
+					_delta_total = _total > this->_core_ticks[0] ? _total - this->_core_ticks[0] : 0;
+					auto _delta_idle = _idle > this->_core_idle_ticks[0] ? _idle - this->_core_idle_ticks[0] : 0;
+					this->_core_ticks[0] = _total;
+					this->_core_idle_ticks[0] = _idle;
+
+					pSnapshot.total_utilization = _delta_total ?
+						100.0f * static_cast<float>(_delta_total - std::min(_delta_total, _delta_idle)) / static_cast<float>(_delta_total) : 0.0f;
+				}
+
+				FILETIME _creation_time, _exit_time, _process_kernel_time, _process_user_time;
+				if (GetProcessTimes(GetCurrentProcess(), &_creation_time, &_exit_time, &_process_kernel_time, &_process_user_time))
+				{
+					//FILETIME is in 100 nanoseconds
+					auto _user = _to_uint64(_process_user_time);
+					auto _kernel = _to_uint64(_process_kernel_time);
+					pSnapshot.process_user_time_in_ms = _user / 10000.0;
+					pSnapshot.process_system_time_in_ms = _kernel / 10000.0;
+
+					auto _process_time = _user + _kernel;
+					auto _delta = _process_time > this->_process_ticks ? _process_time - this->_process_ticks : 0;
+					this->_process_ticks = _process_time;
+
+					pSnapshot.process_utilization = _delta_total ?
+						std::min(100.0f, 100.0f * static_cast<float>(_delta) / static_cast<float>(_delta_total)) : 0.0f;
+				}
+
+				PROCESS_MEMORY_COUNTERS _counters;
+				if (GetProcessMemoryInfo(GetCurrentProcess(), &_counters, sizeof(_counters)))
+				{
+					pSnapshot.rss_in_bytes = _counters.WorkingSetSize;
+					pSnapshot.peak_rss_in_bytes = _counters.PeakWorkingSetSize;
+					//windows does not separate soft and hard page faults
+					pSnapshot.minor_page_faults = _counters.PageFaultCount;
+				}
+			}
+
+#else
+
+			void _sample(_Inout_ w_cpu_snapshot& pSnapshot)
+			{
+				W_UNUSED(pSnapshot);
+			}
+
+#endif
+
+			static const uint32_t INDEX_MASK = 0x3;
+			static const uint32_t FRESH_BIT = 0x4;
+
+			w_cpu_configs							_configs;
+			std::thread								_thread;
+			std::mutex								_mutex;
+			std::condition_variable					_cv;
+			std::atomic<bool>						_is_running;
+			bool									_stop_requested;
+
+			//triple buffer, back is owned by sampler, front is owned by reader and middle is the latest published one
+			w_cpu_snapshot							_buffers[3];
+			uint32_t								_back;
+			std::atomic<uint32_t>					_middle;
+			uint32_t								_front;
+			uint64_t								_sequence;
+
+			//previous counters which are only accessed by sampler, index zero of cores is the sum of all cores
+			uint64_t								_core_ticks[W_CPU_MAX_CORES + 1] = {};
+			uint64_t								_core_idle_ticks[W_CPU_MAX_CORES + 1] = {};
+			uint64_t								_process_ticks = 0;
+			std::unordered_map<int64_t, uint64_t>	_thread_ticks;
+		};
+	}
+}
 
 using namespace wolf::system;
 
-w_cpu::w_cpu()
+w_cpu::w_cpu() :
+	_pimp(new w_cpu_pimp())
+#ifdef __WIN32
+	, _canReadCpu(false)
+#endif
 {
 }
 
 w_cpu::~w_cpu()
 {
+	release();
 }
 
+#ifdef __WIN32
+
 bool w_cpu::initialize()
 {
 	this->_canReadCpu = true;
@@ -65,16 +497,49 @@ int w_cpu::get_cpu_percentage() const
 	return 0;
 }
 
+#endif
+
+W_RESULT w_cpu::start(_In_ const w_cpu_configs& pConfigs)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->start(pConfigs);
+}
+
+void w_cpu::stop()
+{
+	if (!this->_pimp) return;
+	this->_pimp->stop();
+}
+
 ULONG w_cpu::release()
 {
 	if (this->get_is_released()) return 1;
 
+	SAFE_DELETE(this->_pimp);
+
+#ifdef __WIN32
 	if (this->_canReadCpu)
 	{
 		PdhCloseQuery(this->_queryHandle);
+		this->_canReadCpu = false;
 	}
+#endif
+
+	return _super::release();
+}
 
-	return w_object::release();
+#pragma region Getters
+
+bool w_cpu::get_snapshot(_Inout_ w_cpu_snapshot& pSnapshot)
+{
+	if (!this->_pimp) return false;
+	return this->_pimp->get_snapshot(pSnapshot);
+}
+
+bool w_cpu::get_is_running() const
+{
+	if (!this->_pimp) return false;
+	return this->_pimp->get_is_running();
 }
 
-#endif
\ No newline at end of file
+#pragma endregion
@@ -4,7 +4,10 @@
 	Website			 : http://WolfSource.io
 	Name			 : w_cpu.h
 	Description		 : This class responsible to show the information of CPU
-	Comment          :
+	Comment          : After start, a background thread samples utilization of cores, memory of process, context switches,
+					   page faults and cpu time of named threads at the configured rate. Each sample is published into a triple
+					   buffer, so get_snapshot never blocks the sampler and the sampler never blocks the caller.
+					   On linux and android all values are read from procfs, on windows per core and per thread values are not available
 */
 
 #if _MSC_VER > 1000
@@ -15,43 +18,139 @@
 #define __W_CPU_H__
 
 #ifdef __WIN32
-
 #include <pdh.h>
+#pragma comment(lib, "pdh.lib")
+#endif
+
 #include "w_object.h"
 #include "w_system_export.h"
+#include <stdint.h>
+#include <string>
 
-#pragma comment(lib, "pdh.lib")
+#define W_CPU_MAX_CORES					128
+#define W_CPU_MAX_THREADS				64
+#define W_CPU_MAX_THREAD_NAME			16
 
 namespace wolf
 {
 	namespace system
 	{
+		struct w_cpu_configs
+		{
+			//interval between two samples
+			uint32_t	sample_interval_in_ms = 250;
+			//only threads whose names start with this prefix will be reported, empty prefix means all threads of process
+			std::string	thread_name_prefix = "wolf";
+		};
+
+		struct w_cpu_thread_usage
+		{
+			char		name[W_CPU_MAX_THREAD_NAME];
+			int64_t		id = 0;
+			//total cpu time of thread since it has been created
+			double		user_time_in_ms = 0.0;
+			double		system_time_in_ms = 0.0;
+			//percentage of one core which has been used by thread during last interval
+			float		utilization = 0.0f;
+		};
+
+		struct w_cpu_snapshot
+		{
+			//number of samples which have been taken since start, zero means no sample is available yet
+			uint64_t			sequence = 0;
+			//time of sample since start
+			double				time_in_seconds = 0.0;
+			//time which has been spent on taking this sample
+			double				sample_time_in_ms = 0.0;
+
+			//percentage of all cores which has been used during last interval
+			float				total_utilization = 0.0f;
+			uint32_t			number_of_cores = 0;
+			float				core_utilizations[W_CPU_MAX_CORES];
+
+			//percentage of all cores which has been used by this process during last interval
+			float				process_utilization = 0.0f;
+			double				process_user_time_in_ms = 0.0;
+			double				process_system_time_in_ms = 0.0;
+
+			uint64_t			rss_in_bytes = 0;
+			uint64_t			peak_rss_in_bytes = 0;
+
+			//counters are accumulated since the process has been started, subtract two snapshots to get the values of a period
+			uint64_t			voluntary_context_switches = 0;
+			uint64_t			involuntary_context_switches = 0;
+			uint64_t			minor_page_faults = 0;
+			uint64_t			major_page_faults = 0;
+
+			uint32_t			number_of_threads = 0;
+			//number of matched threads which did not fit into threads
+			uint32_t			number_of_dropped_threads = 0;
+			w_cpu_thread_usage	threads[W_CPU_MAX_THREADS];
+
+			w_cpu_snapshot()
+			{
+				for (size_t i = 0; i < W_CPU_MAX_CORES; ++i) this->core_utilizations[i] = 0.0f;
+				for (size_t i = 0; i < W_CPU_MAX_THREADS; ++i) this->threads[i].name[0] = '\0';
+			}
+		};
+
+		class w_cpu_pimp;
 		class w_cpu : public system::w_object
 		{
 		public:
 			WSYS_EXP w_cpu();
 			WSYS_EXP virtual ~w_cpu();
 
-			//Initialize the cpu info and return true or false value which indicates that function did initialize successfully or not. 
+#ifdef __WIN32
+			//Initialize the cpu info and return true or false value which indicates that function did initialize successfully or not.
 			WSYS_EXP bool initialize();
 			//Update the percentage of CPU usage
 			WSYS_EXP void update();
 			//Get the value of CPU percentage
 			WSYS_EXP int get_cpu_percentage() const;
+#endif
+
+			/*
+				start sampling on a background thread
+				@param pConfigs, configurations of sampler
+				@return W_PASSED means function did succesfully and W_FAILED means sampling is not supported on this platform
+			*/
+			WSYS_EXP W_RESULT start(_In_ const w_cpu_configs& pConfigs);
+			//stop background thread, the last snapshot remains available
+			WSYS_EXP void stop();
+
 			//Release all resources
 			WSYS_EXP ULONG release() override;
 
+#pragma region Getters
+
+			/*
+				get the latest snapshot, it never blocks and it must be called from only one thread at a time
+				@param pSnapshot, the latest snapshot
+				@return true if a new snapshot has been published since the previous call
+			*/
+			WSYS_EXP bool get_snapshot(_Inout_ w_cpu_snapshot& pSnapshot);
+			WSYS_EXP bool get_is_running() const;
+
+#pragma endregion
+
 		private:
+			//prevent copying
+			w_cpu(w_cpu const&);
+			w_cpu& operator= (w_cpu const&);
+
+			typedef system::w_object	_super;
+			w_cpu_pimp*					_pimp;
+
+#ifdef __WIN32
 			bool _canReadCpu;
 			HQUERY _queryHandle;
 			HCOUNTER _counterHandle;
 			unsigned long _lastSampleTime;
 			long _cpuUsage;
-
+#endif
 		};
 	}
 }
 
-#endif // __WIN32
-
-#endif //  __W_CPU_H__
\ No newline at end of file
+#endif //  __W_CPU_H__
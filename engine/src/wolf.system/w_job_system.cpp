@@ -0,0 +1,650 @@
+#include "w_system_pch.h"
+#include "w_job_system.h"
+#include "w_thread.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <chrono>
+#include <memory>
+#include <cstring>
+
+namespace wolf
+{
+	namespace system
+	{
+		//Chase-Lev work stealing deque with fixed capacity. Only the owner calls push and pop, other workers call steal
+		class w_job_deque
+		{
+		public:
+			static const int64_t CAPACITY = 4096;
+			static const int64_t MASK = CAPACITY - 1;
+
+			w_job_deque() : _top(0), _bottom(0)
+			{
+				for (auto& _item : this->_buffer)
+				{
+					_item.store(nullptr, std::memory_order_relaxed);
+				}
+			}
+
+			bool push(_In_ w_job* pJob)
+			{
+				auto _b = this->_bottom.load(std::memory_order_relaxed);
+				auto _t = this->_top.load(std::memory_order_acquire);
+				if (_b - _t >= CAPACITY) return false;
+
+				this->_buffer[_b & MASK].store(pJob, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+				this->_bottom.store(_b + 1, std::memory_order_relaxed);
+				return true;
+			}
+
+			w_job* pop()
+			{
+				auto _b = this->_bottom.load(std::memory_order_relaxed) - 1;
+				this->_bottom.store(_b, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				auto _t = this->_top.load(std::memory_order_relaxed);
+
+				if (_t > _b)
+				{
+					//queue is empty
+					this->_bottom.store(_b + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				auto _job = this->_buffer[_b & MASK].load(std::memory_order_relaxed);
+				if (_t == _b)
+				{
+					//the last item, race against stealers
+					if (!this->_top.compare_exchange_strong(_t, _t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					{
+						_job = nullptr;
+					}
+					this->_bottom.store(_b + 1, std::memory_order_relaxed);
+				}
+				return _job;
+			}
+
+			w_job* steal()
+			{
+				auto _t = this->_top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				auto _b = this->_bottom.load(std::memory_order_acquire);
+				if (_t >= _b) return nullptr;
+
+				auto _job = this->_buffer[_t & MASK].load(std::memory_order_relaxed);
+				if (!this->_top.compare_exchange_strong(_t, _t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					return nullptr;
+				}
+				return _job;
+			}
+
+		private:
+			//keep top and bottom on separated cache lines
+			std::atomic<int64_t>							_top;
+			char											_pad0[64 - sizeof(std::atomic<int64_t>)];
+			std::atomic<int64_t>							_bottom;
+			char											_pad1[64 - sizeof(std::atomic<int64_t>)];
+			std::atomic<w_job*>								_buffer[CAPACITY];
+		};
+
+		struct w_job_worker
+		{
+			w_job_worker() :
+				next_job(0),
+				random_state(0),
+				executed(0),
+				stolen(0),
+				deferred(0),
+				executed_inline(0),
+				heap_allocated(0)
+			{
+			}
+
+			static const size_t POOL_SIZE = 4096;
+
+			w_job_deque										queue;
+			w_job											pool[POOL_SIZE];
+			size_t											next_job;
+			uint32_t										random_state;
+			std::thread										thread;
+
+			//statistics, written only by the owner
+			std::atomic<size_t>								executed;
+			std::atomic<size_t>								stolen;
+			std::atomic<size_t>								deferred;
+			std::atomic<size_t>								executed_inline;
+			std::atomic<size_t>								heap_allocated;
+		};
+
+		static thread_local w_job_system_pimp*				sCurrentJobSystem = nullptr;
+		static thread_local int								sCurrentWorkerIndex = -1;
+
+		class w_job_system_pimp
+		{
+		public:
+			w_job_system_pimp() :
+				_is_released(false),
+				_pending(0),
+				_sleeping(0),
+				_injected_size(0),
+				_deferred_size(0),
+				_wake_epoch(0),
+				_external_pool_size(0),
+				_external_next_job(0)
+			{
+			}
+
+			~w_job_system_pimp()
+			{
+				release();
+			}
+
+			W_RESULT allocate(_In_ size_t pNumberOfWorkers)
+			{
+				release();
+
+				if (pNumberOfWorkers == 0)
+				{
+					pNumberOfWorkers = std::thread::hardware_concurrency();
+					if (pNumberOfWorkers == 0) pNumberOfWorkers = 1;
+				}
+
+				this->_is_released.store(false);
+				this->_workers.resize(pNumberOfWorkers);
+				for (auto& _w : this->_workers)
+				{
+					_w = new (std::nothrow) w_job_worker();
+					if (!_w)
+					{
+						logger.error("could not allocate memory for job system worker");
+						return W_OUTOFMEMORY;
+					}
+					for (auto& _job : _w->pool)
+					{
+						_job.in_use.store(false, std::memory_order_relaxed);
+					}
+				}
+
+				//the external pool will be used by threads which are not workers of this job system
+				this->_external_pool_size = w_job_worker::POOL_SIZE;
+				this->_external_pool.reset(new (std::nothrow) w_job[this->_external_pool_size]);
+				if (!this->_external_pool)
+				{
+					logger.error("could not allocate memory for external pool of job system");
+					return W_OUTOFMEMORY;
+				}
+				for (size_t i = 0; i < this->_external_pool_size; ++i)
+				{
+					this->_external_pool[i].in_use.store(false, std::memory_order_relaxed);
+				}
+				this->_external_next_job = 0;
+
+				//calling thread is the worker 0
+				sCurrentJobSystem = this;
+				sCurrentWorkerIndex = 0;
+				this->_workers[0]->random_state = 1;
+
+				for (size_t i = 1; i < this->_workers.size(); ++i)
+				{
+					auto _w = this->_workers[i];
+					_w->random_state = static_cast<uint32_t>(i * 2654435761u) | 1;
+					_w->thread = std::thread(&w_job_system_pimp::_worker_loop, this, static_cast<int>(i));
+				}
+
+				return W_PASSED;
+			}
+
+			w_job* allocate_job()
+			{
+				if (sCurrentJobSystem == this && sCurrentWorkerIndex >= 0)
+				{
+					auto _w = this->_workers[sCurrentWorkerIndex];
+					while (true)
+					{
+						for (size_t i = 0; i < w_job_worker::POOL_SIZE; ++i)
+						{
+							auto _job = &_w->pool[_w->next_job++ & (w_job_worker::POOL_SIZE - 1)];
+							if (!_job->in_use.load(std::memory_order_acquire))
+							{
+								_job->in_use.store(true, std::memory_order_relaxed);
+								return _job;
+							}
+						}
+						//all jobs of this worker are in flight, help others until one of them becomes free
+						if (!_help_once()) std::this_thread::yield();
+					}
+				}
+
+				std::unique_lock<std::mutex> _lock(this->_external_mutex);
+				while (true)
+				{
+					for (size_t i = 0; i < this->_external_pool_size; ++i)
+					{
+						auto _job = &this->_external_pool[this->_external_next_job++ % this->_external_pool_size];
+						if (!_job->in_use.load(std::memory_order_acquire))
+						{
+							_job->in_use.store(true, std::memory_order_relaxed);
+							return _job;
+						}
+					}
+					_lock.unlock();
+					if (!_help_once()) std::this_thread::yield();
+					_lock.lock();
+				}
+			}
+
+			void push(_In_ w_job* pJob)
+			{
+				//count it before publishing, so stealers never see a negative number of pending jobs
+				this->_pending.fetch_add(1, std::memory_order_release);
+
+				if (sCurrentJobSystem == this && sCurrentWorkerIndex >= 0)
+				{
+					auto _w = this->_workers[sCurrentWorkerIndex];
+					if (!_w->queue.push(pJob))
+					{
+						//queue is full, execute it right now
+						this->_pending.fetch_sub(1, std::memory_order_acq_rel);
+						_w->executed_inline.fetch_add(1, std::memory_order_relaxed);
+						if (pJob->dependency) wait(*pJob->dependency);
+						_execute(pJob);
+						return;
+					}
+				}
+				else
+				{
+					std::lock_guard<std::mutex> _lock(this->_injected_mutex);
+					this->_injected.push_back(pJob);
+					this->_injected_size.fetch_add(1, std::memory_order_release);
+				}
+
+				if (this->_sleeping.load(std::memory_order_acquire) > 0)
+				{
+					std::lock_guard<std::mutex> _lock(this->_sleep_mutex);
+					this->_sleep_cv.notify_one();
+				}
+			}
+
+			void wait(_In_ const w_job_counter& pCounter)
+			{
+				int _idle = 0;
+				while (!pCounter.is_done())
+				{
+					if (_help_once())
+					{
+						_idle = 0;
+						continue;
+					}
+					//only deferred jobs or running jobs of other threads are left, back off
+					if (++_idle < SPIN_COUNT)
+					{
+						std::this_thread::yield();
+						continue;
+					}
+					_sleep([&pCounter]() { return pCounter.is_done(); });
+				}
+			}
+
+			ULONG release()
+			{
+				if (this->_workers.empty()) return 1;
+
+				//drain the pending jobs
+				int _idle = 0;
+				while (this->_pending.load(std::memory_order_acquire) > 0)
+				{
+					if (_help_once())
+					{
+						_idle = 0;
+						continue;
+					}
+					if (++_idle < SPIN_COUNT)
+					{
+						std::this_thread::yield();
+						continue;
+					}
+					_sleep([]() { return false; });
+				}
+
+				{
+					std::lock_guard<std::mutex> _lock(this->_sleep_mutex);
+					this->_is_released.store(true);
+					this->_sleep_cv.notify_all();
+				}
+
+				for (auto _w : this->_workers)
+				{
+					if (_w->thread.joinable())
+					{
+						_w->thread.join();
+					}
+				}
+				for (auto _w : this->_workers)
+				{
+					delete _w;
+				}
+				this->_workers.clear();
+				this->_external_pool.reset();
+				this->_external_pool_size = 0;
+
+				if (sCurrentJobSystem == this)
+				{
+					sCurrentJobSystem = nullptr;
+					sCurrentWorkerIndex = -1;
+				}
+
+				return 0;
+			}
+
+			void count_heap_allocation()
+			{
+				if (this->_workers.empty()) return;
+				auto _index = (sCurrentJobSystem == this && sCurrentWorkerIndex >= 0) ? sCurrentWorkerIndex : 0;
+				this->_workers[_index]->heap_allocated.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			size_t get_number_of_workers() const
+			{
+				return this->_workers.size();
+			}
+
+			w_job_system_statistics get_statistics() const
+			{
+				w_job_system_statistics _stats;
+				std::memset(&_stats, 0, sizeof(_stats));
+				_stats.number_of_workers = this->_workers.size();
+				for (auto _w : this->_workers)
+				{
+					_stats.executed += _w->executed.load(std::memory_order_relaxed);
+					_stats.stolen += _w->stolen.load(std::memory_order_relaxed);
+					_stats.deferred += _w->deferred.load(std::memory_order_relaxed);
+					_stats.executed_inline += _w->executed_inline.load(std::memory_order_relaxed);
+					_stats.heap_allocated += _w->heap_allocated.load(std::memory_order_relaxed);
+				}
+				return _stats;
+			}
+
+		private:
+			void _worker_loop(_In_ int pIndex)
+			{
+				sCurrentJobSystem = this;
+				sCurrentWorkerIndex = pIndex;
+				w_thread::set_current_thread_name(("wolf_worker_" + std::to_string(pIndex)).c_str());
+
+				while (!this->_is_released.load(std::memory_order_acquire))
+				{
+					if (_help_once()) continue;
+
+					//spin for a while before going to sleep, deferred jobs do not count, otherwise workers
+					//would spin on them until their dependencies are done
+					bool _found = false;
+					for (int i = 0; i < SPIN_COUNT && !_found; ++i)
+					{
+						std::this_thread::yield();
+						_found = _has_runnable_jobs();
+					}
+					if (_found) continue;
+
+					_sleep([]() { return false; });
+				}
+
+				sCurrentJobSystem = nullptr;
+				sCurrentWorkerIndex = -1;
+			}
+
+			//find a job and execute it, returns false if no job found
+			bool _help_once()
+			{
+				auto _job = _get_job();
+				if (!_job) return false;
+
+				if (_job->dependency && !_job->dependency->is_done())
+				{
+					//dependency is not ready, defer this job to the shared queue
+					if (sCurrentJobSystem == this && sCurrentWorkerIndex >= 0)
+					{
+						this->_workers[sCurrentWorkerIndex]->deferred.fetch_add(1, std::memory_order_relaxed);
+					}
+					{
+						std::lock_guard<std::mutex> _lock(this->_injected_mutex);
+						//count it as deferred first, so it never looks like a runnable job
+						this->_deferred.push_back(_job);
+						this->_deferred_size.fetch_add(1, std::memory_order_release);
+						this->_pending.fetch_add(1, std::memory_order_release);
+					}
+					return false;
+				}
+
+				_execute(_job);
+				return true;
+			}
+
+			w_job* _get_job()
+			{
+				w_job* _job = nullptr;
+				w_job_worker* _self = nullptr;
+
+				if (sCurrentJobSystem == this && sCurrentWorkerIndex >= 0)
+				{
+					_self = this->_workers[sCurrentWorkerIndex];
+					_job = _self->queue.pop();
+				}
+
+				if (!_job && this->_injected_size.load(std::memory_order_acquire) > 0)
+				{
+					std::lock_guard<std::mutex> _lock(this->_injected_mutex);
+					if (!this->_injected.empty())
+					{
+						_job = this->_injected.front();
+						this->_injected.pop_front();
+						this->_injected_size.fetch_sub(1, std::memory_order_release);
+					}
+				}
+
+				if (!_job)
+				{
+					//try to steal from a random victim
+					auto _size = this->_workers.size();
+					uint32_t _random = _self ? _next_random(_self->random_state) : static_cast<uint32_t>(
+						std::hash<std::thread::id>()(std::this_thread::get_id()));
+					for (size_t i = 0; i < _size && !_job; ++i)
+					{
+						auto _victim = this->_workers[(_random + i) % _size];
+						if (_victim == _self) continue;
+						_job = _victim->queue.steal();
+					}
+					if (_job && _self)
+					{
+						_self->stolen.fetch_add(1, std::memory_order_relaxed);
+					}
+				}
+
+				if (_job)
+				{
+					this->_pending.fetch_sub(1, std::memory_order_acq_rel);
+					return _job;
+				}
+
+				//retry deferred jobs only when there is nothing else to do
+				if (this->_deferred_size.load(std::memory_order_acquire) > 0)
+				{
+					std::lock_guard<std::mutex> _lock(this->_injected_mutex);
+					if (!this->_deferred.empty())
+					{
+						_job = this->_deferred.front();
+						this->_deferred.pop_front();
+						//uncount it as pending first, so it never looks like a runnable job
+						this->_pending.fetch_sub(1, std::memory_order_acq_rel);
+						this->_deferred_size.fetch_sub(1, std::memory_order_release);
+					}
+				}
+				return _job;
+			}
+
+			void _execute(_In_ w_job* pJob)
+			{
+				pJob->execute(pJob);
+				pJob->destroy(pJob);
+
+				auto _counter = pJob->counter;
+				pJob->in_use.store(false, std::memory_order_release);
+
+				if (sCurrentJobSystem == this && sCurrentWorkerIndex >= 0)
+				{
+					this->_workers[sCurrentWorkerIndex]->executed.fetch_add(1, std::memory_order_relaxed);
+				}
+				if (_counter)
+				{
+					_counter->value.fetch_sub(1, std::memory_order_acq_rel);
+
+					//a dependency or a waited counter may have been done, wake the sleeping threads
+					if (this->_sleeping.load(std::memory_order_acquire) > 0)
+					{
+						std::lock_guard<std::mutex> _lock(this->_sleep_mutex);
+						this->_wake_epoch.fetch_add(1, std::memory_order_release);
+						this->_sleep_cv.notify_all();
+					}
+				}
+			}
+
+			/*
+				sleep until a runnable job is pushed, a job with a counter is done or pWakeUp returns true.
+				Deferred jobs will be retried after the timeout
+			*/
+			template<typename P>
+			void _sleep(_In_ const P& pWakeUp)
+			{
+				std::unique_lock<std::mutex> _lock(this->_sleep_mutex);
+				this->_sleeping.fetch_add(1, std::memory_order_acq_rel);
+				auto _epoch = this->_wake_epoch.load(std::memory_order_acquire);
+				this->_sleep_cv.wait_for(_lock, std::chrono::milliseconds(1), [this, _epoch, &pWakeUp]()
+				{
+					return this->_is_released.load(std::memory_order_acquire) || _has_runnable_jobs() ||
+						this->_wake_epoch.load(std::memory_order_acquire) != _epoch || pWakeUp();
+				});
+				this->_sleeping.fetch_sub(1, std::memory_order_acq_rel);
+			}
+
+			//pending jobs which are not waiting for their dependencies
+			bool _has_runnable_jobs() const
+			{
+				return this->_pending.load(std::memory_order_acquire) >
+					static_cast<int64_t>(this->_deferred_size.load(std::memory_order_acquire));
+			}
+
+			static uint32_t _next_random(_Inout_ uint32_t& pState)
+			{
+				//xorshift32
+				pState ^= pState << 13;
+				pState ^= pState >> 17;
+				pState ^= pState << 5;
+				return pState;
+			}
+
+			//number of yields before sleeping
+			static const int SPIN_COUNT = 64;
+
+			std::vector<w_job_worker*>						_workers;
+			std::atomic<bool>								_is_released;
+			std::atomic<int64_t>							_pending;
+			std::atomic<int>								_sleeping;
+
+			std::mutex										_sleep_mutex;
+			std::condition_variable							_sleep_cv;
+
+			//jobs which submitted from non worker threads
+			std::mutex										_injected_mutex;
+			std::deque<w_job*>								_injected;
+			std::atomic<size_t>								_injected_size;
+			//jobs which deferred because of their dependencies, guarded by _injected_mutex
+			std::deque<w_job*>								_deferred;
+			std::atomic<size_t>								_deferred_size;
+			std::atomic<uint32_t>							_wake_epoch;
+
+			std::mutex										_external_mutex;
+			std::unique_ptr<w_job[]>						_external_pool;
+			size_t											_external_pool_size;
+			size_t											_external_next_job;
+		};
+	}
+}
+
+using namespace wolf::system;
+
+w_job_system::w_job_system() : _pimp(new w_job_system_pimp())
+{
+}
+
+w_job_system::~w_job_system()
+{
+	release();
+	if (this->_pimp)
+	{
+		delete this->_pimp;
+		this->_pimp = nullptr;
+	}
+}
+
+W_RESULT w_job_system::allocate(_In_ const size_t& pNumberOfWorkers)
+{
+	if (!this->_pimp) return W_FAILED;
+	return this->_pimp->allocate(pNumberOfWorkers);
+}
+
+void w_job_system::wait(_In_ const w_job_counter& pCounter)
+{
+	if (!this->_pimp) return;
+	this->_pimp->wait(pCounter);
+}
+
+ULONG w_job_system::release()
+{
+	if (!this->_pimp) return 1;
+	return this->_pimp->release();
+}
+
+w_job* w_job_system::_allocate_job()
+{
+	return this->_pimp->allocate_job();
+}
+
+void w_job_system::_push(_In_ w_job* pJob)
+{
+	this->_pimp->push(pJob);
+}
+
+void w_job_system::_count_heap_allocation()
+{
+	this->_pimp->count_heap_allocation();
+}
+
+#pragma region Getters
+
+size_t w_job_system::get_number_of_workers() const
+{
+	if (!this->_pimp) return 0;
+	return this->_pimp->get_number_of_workers();
+}
+
+w_job_system_statistics w_job_system::get_statistics() const
+{
+	if (!this->_pimp)
+	{
+		w_job_system_statistics _stats;
+		std::memset(&_stats, 0, sizeof(_stats));
+		return _stats;
+	}
+	return this->_pimp->get_statistics();
+}
+
+int w_job_system::get_current_worker_index()
+{
+	return sCurrentWorkerIndex;
+}
+
+#pragma endregion
@@ -0,0 +1,179 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_job_system.h
+	Description		 : A cross platform work stealing job system
+	Comment          : Each worker owns a lock free deque, pops its own jobs in LIFO order and steals from
+					   the other workers in FIFO order. Small jobs are stored inside the job itself, so
+					   submitting a lambda with a small capture does not allocate on the heap
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_JOB_SYSTEM_H__
+#define __W_JOB_SYSTEM_H__
+
+#include "w_system_export.h"
+#include "w_std.h"
+#include <atomic>
+#include <new>
+#include <utility>
+#include <type_traits>
+
+namespace wolf
+{
+	namespace system
+	{
+		//a counter which will be decreased on completion of each job, wait on this counter until it reaches zero
+		struct w_job_counter
+		{
+			w_job_counter() : value(0) {}
+
+			bool is_done() const
+			{
+				return this->value.load(std::memory_order_acquire) == 0;
+			}
+
+			std::atomic<int>									value;
+
+		private:
+			//prevent copying
+			w_job_counter(w_job_counter const&);
+			w_job_counter& operator= (w_job_counter const&);
+		};
+
+		struct w_job
+		{
+			typedef void(*w_job_function)(_In_ w_job* pJob);
+
+			//size of inline storage of job, bigger callables will be allocated on the heap
+			static const size_t STORAGE_SIZE = 96;
+
+			w_job_function										execute;
+			w_job_function										destroy;
+			w_job_counter*										counter;
+			const w_job_counter*								dependency;
+			std::atomic<bool>									in_use;
+			alignas(16) unsigned char							storage[STORAGE_SIZE];
+		};
+
+		struct w_job_system_statistics
+		{
+			size_t	number_of_workers;
+			//number of executed jobs
+			size_t	executed;
+			//number of jobs which have been stolen from other workers
+			size_t	stolen;
+			//number of jobs which have been deferred because of their dependency
+			size_t	deferred;
+			//number of jobs which have been executed immediately because the queue of worker was full
+			size_t	executed_inline;
+			//number of jobs which did not fit into inline storage of job
+			size_t	heap_allocated;
+		};
+
+		class w_job_system_pimp;
+		class w_job_system
+		{
+		public:
+			WSYS_EXP w_job_system();
+			WSYS_EXP ~w_job_system();
+
+			//allocate job system, zero means number of hardware thread contexts. The calling thread will be the worker 0 and will execute jobs inside wait and parallel_for
+			WSYS_EXP W_RESULT allocate(_In_ const size_t& pNumberOfWorkers = 0);
+
+			//submit a job, pCounter will be increased now and decreased on completion of job. The job will not start before pDependency reaches zero
+			template<typename F>
+			void submit(_In_ F&& pJob, _In_opt_ w_job_counter* pCounter = nullptr, _In_opt_ const w_job_counter* pDependency = nullptr)
+			{
+				auto _job = _allocate_job();
+				_store(_job, std::forward<F>(pJob));
+				_job->counter = pCounter;
+				_job->dependency = pDependency;
+				if (pCounter) pCounter->value.fetch_add(1, std::memory_order_relaxed);
+				_push(_job);
+			}
+
+			//split [0, pCount) into ranges of pGrainSize and call pFunction(begin, end) for each range in parallel, this function returns when all ranges are done
+			template<typename F>
+			void parallel_for(_In_ const size_t& pCount, _In_ size_t pGrainSize, _In_ const F& pFunction)
+			{
+				if (pCount == 0) return;
+				if (pGrainSize == 0)
+				{
+					//create almost 4 ranges per worker
+					auto _ranges = 4 * get_number_of_workers();
+					pGrainSize = (pCount + _ranges - 1) / _ranges;
+					if (pGrainSize == 0) pGrainSize = 1;
+				}
+
+				w_job_counter _counter;
+				for (size_t _begin = 0; _begin < pCount; _begin += pGrainSize)
+				{
+					auto _end = _begin + pGrainSize < pCount ? _begin + pGrainSize : pCount;
+					auto _func = &pFunction;
+					submit([_func, _begin, _end]()
+					{
+						(*_func)(_begin, _end);
+					}, &_counter);
+				}
+				wait(_counter);
+			}
+
+			//wait for counter to reach zero, the calling thread will execute the pending jobs while waiting
+			WSYS_EXP void wait(_In_ const w_job_counter& pCounter);
+			//release all resources, the pending jobs will be executed before releasing
+			WSYS_EXP ULONG release();
+
+#pragma region Getters
+			WSYS_EXP size_t get_number_of_workers() const;
+			WSYS_EXP w_job_system_statistics get_statistics() const;
+			//returns index of worker for the calling thread, or -1 if the calling thread is not a worker of any job system
+			WSYS_EXP static int get_current_worker_index();
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_job_system(w_job_system const&);
+			w_job_system& operator= (w_job_system const&);
+
+			WSYS_EXP w_job* _allocate_job();
+			WSYS_EXP void _push(_In_ w_job* pJob);
+			WSYS_EXP void _count_heap_allocation();
+
+			template<typename F>
+			void _store(_In_ w_job* pJob, _In_ F&& pFunction)
+			{
+				typedef typename std::decay<F>::type _func_type;
+				_store_impl<_func_type>(pJob, std::forward<F>(pFunction),
+					std::integral_constant<bool, sizeof(_func_type) <= w_job::STORAGE_SIZE && alignof(_func_type) <= 16>());
+			}
+
+			//store callable inside the job
+			template<typename T, typename F>
+			void _store_impl(_In_ w_job* pJob, _In_ F&& pFunction, std::true_type)
+			{
+				new (pJob->storage) T(std::forward<F>(pFunction));
+				pJob->execute = [](_In_ w_job* pJ) { (*reinterpret_cast<T*>(pJ->storage))(); };
+				pJob->destroy = [](_In_ w_job* pJ) { reinterpret_cast<T*>(pJ->storage)->~T(); };
+			}
+
+			//callable is too big, store a pointer to the heap
+			template<typename T, typename F>
+			void _store_impl(_In_ w_job* pJob, _In_ F&& pFunction, std::false_type)
+			{
+				_count_heap_allocation();
+				*reinterpret_cast<T**>(pJob->storage) = new T(std::forward<F>(pFunction));
+				pJob->execute = [](_In_ w_job* pJ) { (**reinterpret_cast<T**>(pJ->storage))(); };
+				pJob->destroy = [](_In_ w_job* pJ) { delete *reinterpret_cast<T**>(pJ->storage); };
+			}
+
+			w_job_system_pimp*									_pimp;
+		};
+	}
+}
+
+#endif //__W_JOB_SYSTEM_H__
@@ -228,6 +228,8 @@ namespace wolf
                 }
 #endif
 
+                //messages might be written from worker threads
+                std::unique_lock<std::mutex> _lock(this->_mutex);
                 if (this->_log_file.is_open())
                 {
                     this->_log_file << pMsg.c_str();
@@ -236,7 +238,6 @@ namespace wolf
                 else
                 {
                     //log file is not available yet, so store it in to the buffer
-                    std::unique_lock<std::mutex> _lock(this->_mutex);
                     this->_msgs.push_back(pMsg);
                 }
             }
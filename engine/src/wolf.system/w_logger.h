@@ -34,7 +34,8 @@ inline std::string get_date_time()
 #if defined(__WIN32) || defined(__UWP)
     localtime_s(&_time, &_rawtime);
 #elif defined(__ANDROID) || defined(__linux) || defined(__APPLE__)
-    _time = *localtime(&_rawtime);
+    //localtime_r is thread safe
+    localtime_r(&_rawtime, &_time);
 #endif
 
     strftime(_buffer, sizeof(_buffer), "%d-%b-%Y %X%p", &_time);
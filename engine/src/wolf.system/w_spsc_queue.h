@@ -0,0 +1,140 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : w_spsc_queue.h
+	Description		 : A bounded lock free queue for one producer thread and one consumer thread
+	Comment          : Capacity will be rounded up to the next power of two. Head and tail live on separate cache lines
+					   and each side caches the last seen index of the other side, so push and pop touch shared
+					   cache lines only when the queue looks full or empty
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __W_SPSC_QUEUE_H__
+#define __W_SPSC_QUEUE_H__
+
+#include "w_std.h"
+#include <atomic>
+#include <vector>
+#include <utility>
+
+namespace wolf
+{
+	namespace system
+	{
+		template<typename T>
+		class w_spsc_queue
+		{
+		public:
+			w_spsc_queue() :
+				_mask(0),
+				_head(0),
+				_cached_tail(0),
+				_tail(0),
+				_cached_head(0)
+			{
+			}
+
+			//allocate queue, must be called before producer and consumer threads start
+			void allocate(_In_ const size_t& pCapacity)
+			{
+				size_t _capacity = 2;
+				while (_capacity < pCapacity) _capacity <<= 1;
+
+				this->_items.clear();
+				this->_items.resize(_capacity);
+				this->_mask = _capacity - 1;
+				this->_head.store(0, std::memory_order_relaxed);
+				this->_tail.store(0, std::memory_order_relaxed);
+				this->_cached_head = 0;
+				this->_cached_tail = 0;
+			}
+
+			//called by producer, returns false if queue is full
+			bool try_push(_In_ T pItem)
+			{
+				const auto _tail = this->_tail.load(std::memory_order_relaxed);
+				if (_tail - this->_cached_head > this->_mask)
+				{
+					this->_cached_head = this->_head.load(std::memory_order_acquire);
+					if (_tail - this->_cached_head > this->_mask) return false;
+				}
+				this->_items[_tail & this->_mask] = std::move(pItem);
+				this->_tail.store(_tail + 1, std::memory_order_release);
+				return true;
+			}
+
+			//called by consumer, returns false if queue is empty
+			bool try_pop(_Inout_ T& pItem)
+			{
+				const auto _head = this->_head.load(std::memory_order_relaxed);
+				if (_head == this->_cached_tail)
+				{
+					this->_cached_tail = this->_tail.load(std::memory_order_acquire);
+					if (_head == this->_cached_tail) return false;
+				}
+				pItem = std::move(this->_items[_head & this->_mask]);
+				this->_head.store(_head + 1, std::memory_order_release);
+				return true;
+			}
+
+			//called by consumer, returns the item which will be popped next or nullptr if queue is empty
+			T* peek()
+			{
+				const auto _head = this->_head.load(std::memory_order_relaxed);
+				if (_head == this->_cached_tail)
+				{
+					this->_cached_tail = this->_tail.load(std::memory_order_acquire);
+					if (_head == this->_cached_tail) return nullptr;
+				}
+				return &this->_items[_head & this->_mask];
+			}
+
+#pragma region Getters
+
+			//number of items, exact only when it is called from producer or consumer while the other side is idle
+			size_t get_size() const
+			{
+				return this->_tail.load(std::memory_order_acquire) - this->_head.load(std::memory_order_acquire);
+			}
+
+			size_t get_capacity() const
+			{
+				return this->_items.size();
+			}
+
+			bool get_is_empty() const
+			{
+				return get_size() == 0;
+			}
+
+#pragma endregion
+
+		private:
+			//prevent copying
+			w_spsc_queue(w_spsc_queue const&);
+			w_spsc_queue& operator= (w_spsc_queue const&);
+
+			std::vector<T>										_items;
+			size_t												_mask;
+
+			//padding keeps indices of consumer and producer on separate cache lines without requiring over aligned allocations
+			char												_padding_0[64];
+
+			//owned by consumer
+			std::atomic<size_t>									_head;
+			size_t												_cached_tail;
+			char												_padding_1[64];
+
+			//owned by producer
+			std::atomic<size_t>									_tail;
+			size_t												_cached_head;
+			char												_padding_2[64];
+		};
+	}
+}
+
+#endif //__W_SPSC_QUEUE_H__
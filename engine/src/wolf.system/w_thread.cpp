@@ -10,6 +10,11 @@
 #include <sstream>
 #endif
 
+#if defined(__ANDROID) || defined(__linux) || defined(__APPLE__)
+#include <pthread.h>
+#include <cstring>
+#endif
+
 namespace wolf
 {
     namespace system
@@ -263,3 +268,33 @@ void w_thread::release()
     if (!this->_pimp) return;
     this->_pimp->release();
 }
+
+void w_thread::set_current_thread_name(_In_ const char* pName)
+{
+    if (!pName) return;
+
+#if defined(__WIN32)
+    //SetThreadDescription is available since windows 10 version 1607, so load it at runtime
+    typedef HRESULT(WINAPI* set_thread_description_fn)(HANDLE, PCWSTR);
+    static auto _set_thread_description = reinterpret_cast<set_thread_description_fn>(
+        GetProcAddress(GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription"));
+    if (!_set_thread_description) return;
+
+    wchar_t _name[64];
+    size_t i = 0;
+    for (; pName[i] != '\0' && i < 63; ++i)
+    {
+        _name[i] = static_cast<wchar_t>(pName[i]);
+    }
+    _name[i] = L'\0';
+    _set_thread_description(GetCurrentThread(), _name);
+#elif defined(__ANDROID) || defined(__linux)
+    //name of thread on linux is limited to 16 bytes including null terminator
+    char _name[16];
+    std::strncpy(_name, pName, sizeof(_name) - 1);
+    _name[sizeof(_name) - 1] = '\0';
+    pthread_setname_np(pthread_self(), _name);
+#elif defined(__APPLE__)
+    pthread_setname_np(pName);
+#endif
+}
@@ -48,6 +48,12 @@ namespace wolf
                 return std::thread::hardware_concurrency();
             }
 
+            /*
+                set the name of calling thread, which will be shown by debuggers, profilers and w_cpu.
+                On linux and android only the first 15 characters will be used
+            */
+            WSYS_EXP static void set_current_thread_name(_In_ const char* pName);
+
 #if defined(__WIN32) || defined(__UWP)
             WSYS_EXP static DWORD get_current_thread_id()
             {
@@ -0,0 +1,189 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample shows how to use work stealing job system and compares it with thread pool
+	Comment          : Read more information about this sample on http://wolfsource.io/gpunotes/wolfengine/
+*/
+
+#include "pch.h"
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+
+//namespaces
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+
+typedef std::chrono::steady_clock w_clock;
+
+static const size_t NUMBER_OF_JOBS = 200000;
+static const size_t WORK_PER_JOB = 256;
+
+//a small amount of work for each job
+static void do_work(_In_ const size_t& pSeed, _Inout_ std::atomic<uint64_t>& pSink)
+{
+    uint64_t _x = pSeed;
+    for (size_t i = 0; i < WORK_PER_JOB; ++i)
+    {
+        _x = _x * 6364136223846793005ull + 1442695040888963407ull;
+    }
+    pSink.fetch_add(_x & 1, std::memory_order_relaxed);
+}
+
+struct benchmark_result
+{
+    double  jobs_per_sec;
+    double  p50_us;
+    double  p99_us;
+    double  p999_us;
+};
+
+static benchmark_result make_result(_In_ const double& pSeconds, _Inout_ std::vector<double>& pLatencies)
+{
+    benchmark_result _result;
+    _result.jobs_per_sec = NUMBER_OF_JOBS / pSeconds;
+
+    std::sort(pLatencies.begin(), pLatencies.end());
+    _result.p50_us = pLatencies[pLatencies.size() / 2];
+    _result.p99_us = pLatencies[pLatencies.size() * 99 / 100];
+    _result.p999_us = pLatencies[pLatencies.size() * 999 / 1000];
+
+    return _result;
+}
+
+static benchmark_result benchmark_thread_pool(_In_ const size_t& pNumberOfThreads)
+{
+    std::vector<double> _latencies(NUMBER_OF_JOBS);
+    std::atomic<uint64_t> _sink(0);
+
+    w_thread_pool _thread_pool;
+    _thread_pool.allocate(pNumberOfThreads);
+
+    auto _start = w_clock::now();
+    for (size_t i = 0; i < NUMBER_OF_JOBS; ++i)
+    {
+        auto _submit_time = w_clock::now();
+        //thread pool needs to balance the jobs by hand
+        _thread_pool.add_job_for_thread(i % pNumberOfThreads, [i, _submit_time, &_sink, &_latencies]()
+        {
+            do_work(i, _sink);
+            _latencies[i] = std::chrono::duration<double, std::micro>(w_clock::now() - _submit_time).count();
+        });
+    }
+    _thread_pool.wait_all();
+    auto _seconds = std::chrono::duration<double>(w_clock::now() - _start).count();
+
+    _thread_pool.release();
+
+    return make_result(_seconds, _latencies);
+}
+
+static benchmark_result benchmark_job_system(_In_ const size_t& pNumberOfWorkers, _Out_ w_job_system_statistics& pStatistics)
+{
+    std::vector<double> _latencies(NUMBER_OF_JOBS);
+    std::atomic<uint64_t> _sink(0);
+
+    w_job_system _job_system;
+    _job_system.allocate(pNumberOfWorkers);
+
+    w_job_counter _counter;
+    auto _start = w_clock::now();
+    for (size_t i = 0; i < NUMBER_OF_JOBS; ++i)
+    {
+        auto _submit_time = w_clock::now();
+        _job_system.submit([i, _submit_time, &_sink, &_latencies]()
+        {
+            do_work(i, _sink);
+            _latencies[i] = std::chrono::duration<double, std::micro>(w_clock::now() - _submit_time).count();
+        }, &_counter);
+    }
+    _job_system.wait(_counter);
+    auto _seconds = std::chrono::duration<double>(w_clock::now() - _start).count();
+
+    pStatistics = _job_system.get_statistics();
+    _job_system.release();
+
+    return make_result(_seconds, _latencies);
+}
+
+static std::string to_string(_In_ const benchmark_result& pResult)
+{
+    char _buffer[256];
+    std::snprintf(_buffer, sizeof(_buffer), "%12.0f jobs/sec, latency p50: %9.1f us, p99: %9.1f us, p99.9: %9.1f us",
+        pResult.jobs_per_sec, pResult.p50_us, pResult.p99_us, pResult.p999_us);
+    return std::string(_buffer);
+}
+
+WOLF_MAIN()
+{
+    //initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+    logger.initialize(L"20_job_system", wolf::system::io::get_current_directoryW());
+
+    //log to output file
+    logger.write(L"Wolf initialized");
+
+    //simple usage of job system
+    {
+        w_job_system _job_system;
+        _job_system.allocate();
+
+        //sum of a large array with parallel_for
+        std::vector<int> _numbers(1000000, 1);
+        std::atomic<int64_t> _sum(0);
+        _job_system.parallel_for(_numbers.size(), 0, [&_numbers, &_sum](_In_ size_t pBegin, _In_ size_t pEnd)
+        {
+            int64_t _local_sum = 0;
+            for (size_t i = pBegin; i < pEnd; ++i)
+            {
+                _local_sum += _numbers[i];
+            }
+            _sum.fetch_add(_local_sum);
+        });
+        logger.write("sum of numbers: " + std::to_string(_sum.load()));
+
+        //the second job will not start before the first one is done
+        w_job_counter _load_counter, _build_counter;
+        _job_system.submit([]()
+        {
+            logger.write("loading data on worker: " + std::to_string(w_job_system::get_current_worker_index()));
+        }, &_load_counter);
+        _job_system.submit([]()
+        {
+            logger.write("building data on worker: " + std::to_string(w_job_system::get_current_worker_index()));
+        }, &_build_counter, &_load_counter);
+        _job_system.wait(_build_counter);
+
+        _job_system.release();
+    }
+
+    //compare job system with thread pool on 1..N cores
+    auto _max_threads = w_thread::get_number_of_hardware_thread_contexts();
+    if (_max_threads == 0) _max_threads = 1;
+
+    logger.write("benchmarking " + std::to_string(NUMBER_OF_JOBS) + " jobs");
+    for (size_t _threads = 1; _threads <= _max_threads; ++_threads)
+    {
+        auto _pool_result = benchmark_thread_pool(_threads);
+
+        w_job_system_statistics _stats;
+        auto _job_result = benchmark_job_system(_threads, _stats);
+
+        logger.write("threads: " + std::to_string(_threads));
+        logger.write("    thread pool : " + to_string(_pool_result));
+        logger.write("    job system  : " + to_string(_job_result));
+        logger.write("    job system stolen: " + std::to_string(_stats.stolen) +
+            " executed inline: " + std::to_string(_stats.executed_inline) +
+            " heap allocated: " + std::to_string(_stats.heap_allocated));
+    }
+
+    //output a message to the log file
+    logger.write(L"shutting down Wolf");
+
+    //release logger
+    logger.release();
+
+    return EXIT_SUCCESS;
+}
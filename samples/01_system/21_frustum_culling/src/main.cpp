@@ -0,0 +1,186 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample shows how to cull objects in batches with w_bounding_batch and compares it with w_bounding_frustum
+	Comment          : Read more information about this sample on http://wolfsource.io/gpunotes/wolfengine/
+*/
+
+#include "pch.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstring>
+
+//namespaces
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+
+typedef std::chrono::steady_clock w_clock;
+
+//objects are scattered inside a cube with this half size
+static const float WORLD_HALF_SIZE = 500.0f;
+//number of culls of each benchmark is (CULLS_PER_BENCHMARK / number of objects) + 1
+static const size_t CULLS_PER_BENCHMARK = 10000000;
+
+//measure average time of one call in milliseconds
+template<typename F>
+static double measure(_In_ const size_t& pIterations, _In_ const F& pFunction)
+{
+    auto _start = w_clock::now();
+    for (size_t i = 0; i < pIterations; ++i)
+    {
+        pFunction();
+    }
+    return std::chrono::duration<double, std::milli>(w_clock::now() - _start).count() / pIterations;
+}
+
+static void benchmark(_In_ const size_t& pNumberOfObjects, _In_ w_bounding_frustum& pFrustum, _In_ w_job_system& pJobSystem)
+{
+    std::mt19937 _random(static_cast<uint32_t>(pNumberOfObjects));
+    std::uniform_real_distribution<float> _position(-WORLD_HALF_SIZE, WORLD_HALF_SIZE);
+    std::uniform_real_distribution<float> _size(0.5f, 5.0f);
+
+    //array of structures, each w_bounding_box has vertices of masked occlusion culling
+    std::vector<w_bounding_box> _boxes;
+    try
+    {
+        _boxes.resize(pNumberOfObjects);
+    }
+    catch (const std::bad_alloc&)
+    {
+        logger.warning("could not allocate " + std::to_string(pNumberOfObjects) + " w_bounding_box");
+        _boxes.clear();
+    }
+
+    //structure of arrays
+    w_bounding_batch _batch;
+    _batch.reserve(pNumberOfObjects);
+    for (size_t i = 0; i < pNumberOfObjects; ++i)
+    {
+        w_bounding_box _box;
+        for (size_t j = 0; j < 3; ++j)
+        {
+            auto _center = _position(_random);
+            auto _half_size = _size(_random);
+            _box.min[j] = _center - _half_size;
+            _box.max[j] = _center + _half_size;
+        }
+        if (!_boxes.empty())
+        {
+            std::memcpy(_boxes[i].min, _box.min, sizeof(_box.min));
+            std::memcpy(_boxes[i].max, _box.max, sizeof(_box.max));
+        }
+        _batch.add(_box);
+    }
+
+    auto _iterations = CULLS_PER_BENCHMARK / pNumberOfObjects + 1;
+
+    //cull one object at a time
+    size_t _aos_visible = 0;
+    double _aos_time = 0.0;
+    if (!_boxes.empty())
+    {
+        _aos_time = measure(_iterations, [&]()
+        {
+            _aos_visible = 0;
+            for (auto& _box : _boxes)
+            {
+                if (pFrustum.intersects(_box)) _aos_visible++;
+            }
+        });
+    }
+
+    //cull in batches on the calling thread
+    std::vector<uint32_t> _visibility;
+    size_t _batch_visible = 0;
+    auto _batch_time = measure(_iterations, [&]()
+    {
+        _batch_visible = _batch.cull(pFrustum, _visibility);
+    });
+
+    //cull in batches on all workers
+    size_t _parallel_visible = 0;
+    auto _parallel_time = measure(_iterations, [&]()
+    {
+        _parallel_visible = _batch.cull(pFrustum, _visibility, &pJobSystem);
+    });
+
+    //cull in batches on all workers and compact indices of visible objects
+    std::vector<uint32_t> _indices;
+    auto _indices_time = measure(_iterations, [&]()
+    {
+        _batch.cull_to_indices(pFrustum, _indices, &pJobSystem);
+    });
+
+    //batch tests boxes instead of their bounding spheres, so every object which is visible for batch must be visible for w_bounding_frustum
+    size_t _mismatches = 0;
+    if (!_boxes.empty())
+    {
+        for (auto _index : _indices)
+        {
+            if (!pFrustum.intersects(_boxes[_index])) _mismatches++;
+        }
+    }
+
+    char _buffer[512];
+    std::snprintf(_buffer, sizeof(_buffer),
+        "objects: %8zu | w_bounding_frustum: %9.3f ms (%zu visible) | batch: %8.3f ms (%zu visible) | parallel batch: %8.3f ms | parallel indices: %8.3f ms | speed up: %6.1fx, %6.1fx | mismatches: %zu",
+        pNumberOfObjects,
+        _aos_time,
+        _aos_visible,
+        _batch_time,
+        _batch_visible,
+        _parallel_time,
+        _indices_time,
+        _batch_time > 0.0 ? _aos_time / _batch_time : 0.0,
+        _parallel_time > 0.0 ? _aos_time / _parallel_time : 0.0,
+        _mismatches);
+    logger.write(_buffer);
+
+    if (_parallel_visible != _batch_visible || _indices.size() != _batch_visible)
+    {
+        logger.error("results of parallel culling do not match");
+    }
+}
+
+WOLF_MAIN()
+{
+    //initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+    logger.initialize(L"21_frustum_culling", wolf::system::io::get_current_directoryW());
+
+    //log to output file
+    logger.write(L"Wolf initialized");
+
+    //camera is at the center of world and looks at +z
+    auto _projection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, WORLD_HALF_SIZE);
+    auto _view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    w_bounding_frustum _frustum;
+    _frustum.update(_projection * _view);
+
+    w_job_system _job_system;
+    _job_system.allocate();
+
+    logger.write("culling kernel: " + std::string(w_bounding_batch::get_kernel_name()) +
+        ", workers: " + std::to_string(_job_system.get_number_of_workers()));
+
+    const size_t _number_of_objects[] = { 10000, 100000, 1000000 };
+    for (auto _count : _number_of_objects)
+    {
+        benchmark(_count, _frustum, _job_system);
+    }
+
+    _job_system.release();
+
+    //output a message to the log file
+    logger.write(L"shutting down Wolf");
+
+    //release logger
+    logger.release();
+
+    return EXIT_SUCCESS;
+}
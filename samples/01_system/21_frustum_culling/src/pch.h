@@ -0,0 +1,21 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : pch.h
+	Description		 : Pre-Compiled header
+	Comment          : Read more information about this sample on http://wolfsource.io/gpunotes/wolfengine/
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __PCH_H__
+#define __PCH_H__
+
+#include <wolf.h>
+#include <w_bounding_batch.h>
+#include <w_job_system.h>
+
+#endif
@@ -90,7 +90,7 @@ void scene::load()
 	}
 
 	//Fence for render sync
-	_hr = this->_draw_fence.initialize(_gDevice);
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -260,21 +260,21 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 
 	//set active command buffer
 	auto _cmd = this->_draw_command_buffers.get_command_at(_frame_index);
-	//reset draw fence
-	this->_draw_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
 	if (_gDevice->submit(
 		{ &_cmd },//command buffers
 		_gDevice->vk_graphics_queue, //graphics queue
 		&_wait_dst_stage_mask[0], //destination masks
 		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing gui", _trace_info, 3, true);
 	}
 
-	// Wait for fence to signal that all command buffers are ready
-	this->_draw_fence.wait();
 
 	return w_game::render(pGameTime);
 }
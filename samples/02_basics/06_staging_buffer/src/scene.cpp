@@ -101,7 +101,7 @@ void scene::load()
 	}
 
 	//Fence for render sync
-	_hr = this->_draw_fence.initialize(_gDevice);
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -150,20 +150,18 @@ void scene::load()
     const auto _width = 640;
     const auto _height = 480;
 
-    //load texture as staging buffer
-    _hr = this->_texture.initialize(_gDevice, _width, _height, false, true);
+    //load texture with one staging slot for each swap chain image, so a frame never writes a slot which is being copied
+    _hr = this->_texture.initialize(
+        _gDevice,
+        _width,
+        _height,
+        w_video_texture_format::VIDEO_TEXTURE_RGBA,
+        static_cast<uint32_t>(_swap_chain_image_size));
     if (_hr == W_FAILED)
     {
         release();
         V(W_FAILED, "loading staging texture", _trace_info, 3, true);
     }
-    //load texture from memory
-    _hr = this->_texture.load_texture_from_memory_color(w_color::CYAN());
-    if (_hr == W_FAILED)
-    {
-        release();
-        V(W_FAILED, "initializing staging texture buffer", _trace_info, 3, true);
-    }
 
     //++++++++++++++++++++++++++++++++++++++++++++++++++++
     //++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -174,7 +172,7 @@ void scene::load()
     _shader_param.index = 0;
     _shader_param.type = w_shader_binding_type::SAMPLER2D;
     _shader_param.stage = w_shader_stage_flag_bits::FRAGMENT_SHADER;
-    _shader_param.image_info = this->_texture.get_descriptor_info();
+    _shader_param.image_info = this->_texture.get_texture()->get_descriptor_info();
 
     _hr = this->_shader.set_shader_binding_params(
     {
@@ -229,7 +227,7 @@ void scene::load()
         2
     };
 
-    this->_mesh.set_texture(&this->_texture);
+    this->_mesh.set_texture(this->_texture.get_texture());
 	_hr = this->_mesh.load(_gDevice,
 		_vertex_data.data(),
 		static_cast<uint32_t>(_vertex_data.size() * sizeof(float)),
@@ -247,35 +245,56 @@ void scene::load()
 
 W_RESULT scene::_build_draw_command_buffers()
 {
-	const std::string _trace_info = this->name + "::build_draw_command_buffers";
 	W_RESULT _hr = W_PASSED;
 
-	auto _gDevice = this->get_graphics_device(0);
 	auto _size = this->_draw_command_buffers.get_commands_size();
-	
 	for (uint32_t i = 0; i < _size; ++i)
 	{
-		auto _cmd = this->_draw_command_buffers.get_command_at(i);
-		this->_draw_command_buffers.begin(i);
+		if (_build_draw_command_buffer(i, false) == W_FAILED)
+		{
+			_hr = W_FAILED;
+		}
+	}
+	return _hr;
+}
+
+W_RESULT scene::_build_draw_command_buffer(_In_ const uint32_t& pIndex, _In_ const bool& pUpload)
+{
+	const std::string _trace_info = this->name + "::build_draw_command_buffer";
+	W_RESULT _hr = W_PASSED;
+
+	auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+	this->_draw_command_buffers.begin(pIndex);
+	{
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		//The following codes have been added for this project
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		//copy staging slot of this swap chain image to texture, copies must be recorded outside of render pass
+		if (pUpload && this->_texture.record_upload(_cmd, pIndex) == W_FAILED)
 		{
-			this->_draw_render_pass.begin(
-				i,
-				_cmd,
-				w_color::CORNFLOWER_BLUE(),
-				1.0f,
-				0.0f);
+			V(W_FAILED, "recording upload of staging texture", _trace_info, 3, false);
+		}
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+		this->_draw_render_pass.begin(
+			pIndex,
+			_cmd,
+			w_color::CORNFLOWER_BLUE(),
+			1.0f,
+			0.0f);
+		{
+			this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
+			_hr = this->_mesh.draw(_cmd, nullptr, 0, false);
+			if (_hr == W_FAILED)
 			{
-				this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
-				_hr = this->_mesh.draw(_cmd, nullptr, 0, false);
-				if (_hr == W_FAILED)
-				{
-					V(W_FAILED, "drawing mesh", _trace_info, 3, false);
-				}
+				V(W_FAILED, "drawing mesh", _trace_info, 3, false);
 			}
-			this->_draw_render_pass.end(_cmd);
 		}
-		this->_draw_command_buffers.end(i);
+		this->_draw_render_pass.end(_cmd);
 	}
+	this->_draw_command_buffers.end(pIndex);
+
 	return _hr;
 }
 
@@ -284,27 +303,6 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
 	if (w_game::exiting) return;
 	const std::string _trace_info = this->name + "::update";
 
-    //++++++++++++++++++++++++++++++++++++++++++++++++++++
-    //The following codes have been added for this project
-    //++++++++++++++++++++++++++++++++++++++++++++++++++++
-    const size_t _length = this->_texture.get_width() * this->_texture.get_height();
-    auto _px = (uint8_t*)this->_texture.read_data_of_texture();
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, _length), [&](const tbb::blocked_range<size_t>& pRange)
-    {
-        for (size_t i = pRange.begin(); i < pRange.end(); ++i)
-        {
-            auto _j = i * 4;
-            _px[_j] = randi(0, 255);//R
-            _px[_j + 1] = randi(0, 255);//G
-            _px[_j + 2] = randi(0, 255);//B
-            _px[_j + 3] = randi(0, 255);//A
-        }
-    });
-    //update texture staging buffer
-    this->_texture.flush_staging_data();
-    //++++++++++++++++++++++++++++++++++++++++++++++++++++
-    //++++++++++++++++++++++++++++++++++++++++++++++++++++
-
 	w_game::update(pGameTime);
 }
 
@@ -325,20 +323,49 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 
 	//set active command buffer
 	auto _cmd = this->_draw_command_buffers.get_command_at(_frame_index);
-	//reset draw fence
-	this->_draw_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+    //++++++++++++++++++++++++++++++++++++++++++++++++++++
+    //The following codes have been added for this project
+    //++++++++++++++++++++++++++++++++++++++++++++++++++++
+    //staging slot and command buffer of this swap chain image are not in use anymore
+    w_video_texture_staging_frame _staging;
+    if (this->_texture.get_staging_frame(_frame_index, _staging) == W_PASSED)
+    {
+        const size_t _width = this->_texture.get_width();
+        const size_t _length = _width * this->_texture.get_height();
+        tbb::parallel_for(tbb::blocked_range<size_t>(0, _length), [&](const tbb::blocked_range<size_t>& pRange)
+        {
+            for (size_t i = pRange.begin(); i < pRange.end(); ++i)
+            {
+                auto _px = _staging.planes[0] + (i / _width) * _staging.row_pitches[0] + (i % _width) * 4;
+                _px[0] = randi(0, 255);//R
+                _px[1] = randi(0, 255);//G
+                _px[2] = randi(0, 255);//B
+                _px[3] = randi(0, 255);//A
+            }
+        });
+    }
+    if (_build_draw_command_buffer(_frame_index, true) == W_FAILED)
+    {
+        V(W_FAILED, "building draw command buffer", _trace_info, 3, false);
+    }
+    //++++++++++++++++++++++++++++++++++++++++++++++++++++
+    //++++++++++++++++++++++++++++++++++++++++++++++++++++
+
 	if (_gDevice->submit(
 		{ &_cmd },//command buffers
 		_gDevice->vk_graphics_queue, //graphics queue
 		&_wait_dst_stage_mask[0], //destination masks
 		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing gui", _trace_info, 3, true);
 	}
-	// Wait for fence to signal that all command buffers are ready
-	this->_draw_fence.wait();
 	
 	return w_game::render(pGameTime);
 }
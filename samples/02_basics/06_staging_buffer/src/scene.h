@@ -21,7 +21,7 @@
 #include <w_graphics/w_shader.h>
 #include <w_graphics/w_pipeline.h>
 #include <w_graphics/w_mesh.h>
-#include <w_graphics/w_texture.h>
+#include <w_graphics/w_video_texture.h>
 
 class scene : public wolf::framework::w_game
 {
@@ -56,6 +56,7 @@ public:
 
 private:
 	W_RESULT _build_draw_command_buffers();
+	W_RESULT _build_draw_command_buffer(_In_ const uint32_t& pIndex, _In_ const bool& pUpload);
 
 	wolf::graphics::w_viewport                                      _viewport;
 	wolf::graphics::w_viewport_scissor                              _viewport_scissor;
@@ -70,7 +71,8 @@ private:
 	wolf::graphics::w_pipeline                                      _pipeline;
 
     wolf::graphics::w_mesh											_mesh;
-    wolf::graphics::w_texture										_texture;
+    //staging ring with one slot for each swap chain image
+    wolf::graphics::w_video_texture									_texture;
 };
 
 #endif
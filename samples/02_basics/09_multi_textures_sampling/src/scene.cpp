@@ -89,7 +89,7 @@ void scene::load()
 	}
 
 	//Fence for render sync
-	_hr = this->_draw_fence.initialize(_gDevice);
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -134,8 +134,8 @@ void scene::load()
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//The following codes have been added for this project
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
-	//load fragment shader uniform
-	_hr = this->_u0.load(_gDevice);
+	//load fragment shader uniform, one region for each swap chain image
+	_hr = this->_u0.load(_gDevice, true, static_cast<uint32_t>(_swap_chain_image_size));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -189,7 +189,7 @@ void scene::load()
 	_shader_params.push_back(_shader_param);
 	
 	_shader_param.index = 1;
-	_shader_param.type = w_shader_binding_type::UNIFORM;
+	_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 	_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
 	_shader_param.buffer_info = this->_u0.get_descriptor_info();
 	_shader_params.push_back(_shader_param);
@@ -272,7 +272,7 @@ W_RESULT scene::_build_draw_command_buffers()
 				1.0f,
 				0.0f);
 			{
-				this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
+				this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS, { this->_u0.get_dynamic_offset_at(i) });
 				_hr = this->_mesh.draw(_cmd, nullptr, 0, false);
 				if (_hr == W_FAILED)
 				{
@@ -291,12 +291,8 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
 	if (w_game::exiting) return;
 	const std::string _trace_info = this->name + "::update";
 
+	//it will be copied to region of swap chain image in render
 	this->_u0.data.time = cos(pGameTime.get_total_seconds());
-	auto _hr = this->_u0.update();
-	if (_hr == W_FAILED)
-	{
-		V(W_FAILED, "updating vertex uniform", _trace_info, 3, false);
-	}
 
 	w_game::update(pGameTime);
 }
@@ -318,20 +314,27 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 
 	//set active command buffer
 	auto _cmd = this->_draw_command_buffers.get_command_at(_frame_index);
-	//reset draw fence
-	this->_draw_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//uniform of this swap chain image is not in use anymore
+	if (this->_u0.update_at(_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "updating vertex uniform", _trace_info, 3, false);
+	}
+
 	if (_gDevice->submit(
 		{ &_cmd },//command buffers
 		_gDevice->vk_graphics_queue, //graphics queue
 		&_wait_dst_stage_mask[0], //destination masks
 		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing gui", _trace_info, 3, true);
 	}
-	// Wait for fence to signal that all command buffers are ready
-	this->_draw_fence.wait();
 
 	return w_game::render(pGameTime);
 }
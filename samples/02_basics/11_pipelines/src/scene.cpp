@@ -100,7 +100,7 @@ void scene::load()
 	}
 
 	//Fence for syncing
-	_hr = this->_draw_fence.initialize(_gDevice);
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -279,47 +279,58 @@ void scene::load()
 
 W_RESULT scene::_build_draw_command_buffers()
 {
-	const std::string _trace_info = this->name + "::build_draw_command_buffers";
 	W_RESULT _hr = W_PASSED;
 
-	auto _gDevice = this->get_graphics_device(0);
 	auto _size = this->_draw_command_buffers.get_commands_size();
-
+	this->_rebuild_draw_command_buffers.assign(_size, false);
 	for (uint32_t i = 0; i < _size; ++i)
 	{
-		auto _cmd = this->_draw_command_buffers.get_command_at(i);
-		this->_draw_command_buffers.begin(i);
+		if (_build_draw_command_buffer(i) == W_FAILED)
+		{
+			_hr = W_FAILED;
+		}
+	}
+	return _hr;
+}
+
+W_RESULT scene::_build_draw_command_buffer(_In_ const uint32_t& pIndex)
+{
+	const std::string _trace_info = this->name + "::build_draw_command_buffer";
+	W_RESULT _hr = W_PASSED;
+
+	auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+	this->_draw_command_buffers.begin(pIndex);
+	{
+		this->_draw_render_pass.begin(
+			pIndex,
+			_cmd,
+			w_color::CORNFLOWER_BLUE(),
+			1.0f,
+			0.0f);
 		{
-			this->_draw_render_pass.begin(
-				i,
-				_cmd,
-				w_color::CORNFLOWER_BLUE(),
-				1.0f,
-				0.0f);
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//The following codes have been added for this project
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			if (_show_wireframe)
+			{
+				this->_wireframe_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
+			}
+			else
+			{
+				this->_solid_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
+			}
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			_hr = this->_mesh.draw(_cmd, nullptr, 0, false);
+			if (_hr == W_FAILED)
 			{
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				//The following codes have been added for this project
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				if (_show_wireframe)
-				{
-					this->_wireframe_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
-				}
-				else
-				{
-					this->_solid_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
-				}
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				_hr = this->_mesh.draw(_cmd, nullptr, 0, false);
-				if (_hr == W_FAILED)
-				{
-					V(W_FAILED, "drawing mesh", _trace_info, 3, false);
-				}
+				V(W_FAILED, "drawing mesh", _trace_info, 3, false);
 			}
-			this->_draw_render_pass.end(_cmd);
 		}
-		this->_draw_command_buffers.end(i);
+		this->_draw_render_pass.end(_cmd);
 	}
+	this->_draw_command_buffers.end(pIndex);
+
 	return _hr;
 }
 
@@ -350,9 +361,9 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
     auto _keys = wolf::inputs_manager.is_keys_released({ _w_key_code });
     if (_keys.size() && _keys[0])
     {
-        //change pipeline
+        //change pipeline, command buffers will be recorded again after their previous submissions
         this->_show_wireframe = !this->_show_wireframe;
-        _build_draw_command_buffers();
+        std::fill(this->_rebuild_draw_command_buffers.begin(), this->_rebuild_draw_command_buffers.end(), true);
     }
     //++++++++++++++++++++++++++++++++++++++++++++++++++++
     //++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -375,26 +386,38 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		w_pipeline_stage_flag_bits::COLOR_ATTACHMENT_OUTPUT_BIT,
 	};
 
-	w_imgui::render();
-
 	//set active command buffer
 	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
 	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
 
-	//reset draw fence
-	this->_draw_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//command buffer of this swap chain image is not in use anymore, so record it again if it has been invalidated
+	if (this->_rebuild_draw_command_buffers[_frame_index])
+	{
+		this->_rebuild_draw_command_buffers[_frame_index] = false;
+		if (_build_draw_command_buffer(_frame_index) == W_FAILED)
+		{
+			V(W_FAILED, "building draw command buffer", _trace_info, 3, false);
+		}
+	}
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
 	if (_gDevice->submit(
 		{ &_draw_cmd, &_gui_cmd },//command buffers
 		_gDevice->vk_graphics_queue, //graphics queue
 		&_wait_dst_stage_mask[0], //destination masks
 		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing gui", _trace_info, 3, true);
 	}
-	// Wait for fence to signal that all command buffers are ready
-	this->_draw_fence.wait();
 
 	return w_game::render(pGameTime);
 }
@@ -57,12 +57,15 @@ public:
 
 private:
 	W_RESULT _build_draw_command_buffers();
+	W_RESULT _build_draw_command_buffer(_In_ const uint32_t& pIndex);
     bool     _update_gui();
 
 	wolf::graphics::w_viewport                                      _viewport;
 	wolf::graphics::w_viewport_scissor                              _viewport_scissor;
 
 	wolf::graphics::w_command_buffers                               _draw_command_buffers;
+	//swap chain images which their command buffers must be recorded again before next submission
+	std::vector<bool>                                               _rebuild_draw_command_buffers;
 	wolf::graphics::w_render_pass                                   _draw_render_pass;
 
 	wolf::graphics::w_fences                                        _draw_fence;
@@ -89,7 +89,7 @@ void scene::load()
 	}
 
 	//Fence for render sync
-	_hr = this->_draw_fence.initialize(_gDevice);
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -138,7 +138,7 @@ void scene::load()
 	}
 
 	//create fence for syncing
-	_hr = this->_rt_fence.initialize(_gDevice);
+	_hr = this->_rt_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -310,20 +310,6 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
 	if (w_game::exiting) return;
 	const std::string _trace_info = this->name + "::update";
 
-	//++++++++++++++++++++++++++++++++++++++++++++++++++++
-	//The following codes have been added for this project
-	//++++++++++++++++++++++++++++++++++++++++++++++++++++
-	auto _time = pGameTime.get_total_seconds();
-	auto _clear_color = w_color();
-	_clear_color.r = static_cast<uint8_t>((float)(std::abs(std::sin(_time)) * 255.0f));
-	_clear_color.g = static_cast<uint8_t>((float)(std::abs(std::cos(_time)) * 255.0f));
-	_clear_color.b = 155;
-	_clear_color.a = 255;
-
-	this->_rt.record_command_buffer(&this->_rt_command_buffer, nullptr, _clear_color, 1.0f, 0);
-	//++++++++++++++++++++++++++++++++++++++++++++++++++++
-	//++++++++++++++++++++++++++++++++++++++++++++++++++++
-
 	w_game::update(pGameTime);
 }
 
@@ -348,8 +334,22 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 
 	auto _rt_cmd = this->_rt_command_buffer.get_command_at(_frame_index);
 
-	//reset render target fence
-	this->_rt_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_rt_fence.wait_at(_frame_index);
+	this->_rt_fence.reset_at(_frame_index);
+
+	//only command buffer of this swap chain image will be recorded again with new clear color
+	auto _time = pGameTime.get_total_seconds();
+	auto _clear_color = w_color();
+	_clear_color.r = static_cast<uint8_t>((float)(std::abs(std::sin(_time)) * 255.0f));
+	_clear_color.g = static_cast<uint8_t>((float)(std::abs(std::cos(_time)) * 255.0f));
+	_clear_color.b = 155;
+	_clear_color.a = 255;
+
+	if (this->_rt.record_command_buffer_at(&this->_rt_command_buffer, _frame_index, nullptr, _clear_color, 1.0f, 0) == W_FAILED)
+	{
+		V(W_FAILED, "recording command buffer of render target", _trace_info, 3, false);
+	}
 
 	if (_gDevice->submit(
 		{ &_rt_cmd },//command buffers
@@ -357,30 +357,28 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		&_wait_dst_stage_mask[0], //destination masks
 		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 		{ this->_rt_semaphore }, //signal semaphores
-		&this->_rt_fence) == W_FAILED)
+		&this->_rt_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing to render target", _trace_info, 3, true);
 	}
 
-	// Wait for fence to signal that command buffer done
-	this->_rt_fence.wait();
-
 	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
 
-	//reset draw fence
-	this->_draw_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
 	if (_gDevice->submit(
 		{ &_draw_cmd },
 		_gDevice->vk_graphics_queue,
 		&_wait_dst_stage_mask[0],
 		{ this->_rt_semaphore },
 		{ _output_window->rendering_done_semaphore },
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing gui", _trace_info, 3, true);
 	}
-	// Wait for fence to signal main command buffers done their job
-	this->_draw_fence.wait();
 
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -95,7 +95,7 @@ void scene::load()
     }
 
     //Fence for syncing
-    _hr = this->_draw_fence.initialize(_gDevice);
+    _hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
     if (_hr == W_FAILED)
     {
         release();
@@ -179,8 +179,8 @@ void scene::load()
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 
-	//load vertex shader uniform
-	_hr = this->_u0.load(_gDevice);
+	//load vertex shader uniform, one region for each swap chain image
+	_hr = this->_u0.load(_gDevice, true, static_cast<uint32_t>(_swap_chain_image_size));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -203,7 +203,7 @@ void scene::load()
 
     w_shader_binding_param _shader_param;
 	_shader_param.index = 0;
-	_shader_param.type = w_shader_binding_type::UNIFORM;
+	_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 	_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
 	_shader_param.buffer_info = this->_u0.get_descriptor_info();
 	_shader_params.push_back(_shader_param);
@@ -298,7 +298,7 @@ W_RESULT scene::_build_draw_command_buffers()
 				1.0f,
 				0.0f);
 			{
-				this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
+				this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS, { this->_u0.get_dynamic_offset_at(i) });
 				_hr = this->_mesh.draw(_cmd, nullptr, 0, false);
 				if (_hr == W_FAILED)
 				{
@@ -326,16 +326,8 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
         _update_gui();
     });
     
-	//we must update uniform
-	if (this->_u0.data.texture_lod != sTextureLOD)
-	{
-		this->_u0.data.texture_lod = sTextureLOD;
-		//update uniform
-		if (this->_u0.update() == W_FAILED)
-		{
-			V(W_FAILED, "updating uniform", _trace_info, 3, false);
-		}
-	}
+	//update uniform's data, it will be copied to region of swap chain image in render
+	this->_u0.data.texture_lod = sTextureLOD;
 
 	w_game::update(pGameTime);
 }
@@ -350,8 +342,6 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 	auto _output_window = &(_gDevice->output_presentation_window);
 	auto _frame_index = _output_window->swap_chain_image_index;
 
-	w_imgui::render();
-
 	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
 	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
 
@@ -360,19 +350,30 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
 	};
 
-	//reset draw fence
-	this->_draw_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
+	//uniform of this swap chain image is not in use anymore
+	if (this->_u0.update_at(_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "updating uniform", _trace_info, 3, false);
+	}
+
 	if (_gDevice->submit(
 		{ &_draw_cmd, &_gui_cmd },//command buffers
 		_gDevice->vk_graphics_queue, //graphics queue
 		&_wait_dst_stage_mask[0], //destination masks
 		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
 	}
-	this->_draw_fence.wait();
 
 	return w_game::render(pGameTime);
 }
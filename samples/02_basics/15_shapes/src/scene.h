@@ -75,6 +75,7 @@ private:
 	wolf::graphics::w_shapes*										_shape_circle;
 	wolf::graphics::w_shapes*										_shape_box;
 	wolf::graphics::w_shapes*										_shape_sphere;
+	glm::mat4														_wvp;
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 };
@@ -98,7 +98,7 @@ void scene::load()
     }
 
     //Fence for syncing
-    _hr = this->_draw_fence.initialize(_gDevice);
+    _hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
     if (_hr == W_FAILED)
     {
         release();
@@ -131,7 +131,7 @@ void scene::load()
 		release();
 		V(W_FAILED, "allocating memory for shape coordinate axis", _trace_info, 3, true);
 	}
-	_hr = this->_shape_coordinate_axis->load(_gDevice, this->_draw_render_pass, this->_viewport, this->_viewport_scissor);
+	_hr = this->_shape_coordinate_axis->load(_gDevice, this->_draw_render_pass, this->_viewport, this->_viewport_scissor, static_cast<uint32_t>(_swap_chain_image_size));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -166,7 +166,7 @@ W_RESULT scene::_build_draw_command_buffers()
 				//++++++++++++++++++++++++++++++++++++++++++++++++++++
 				//The following codes have been added for this project
 				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				this->_shape_coordinate_axis->draw(_cmd);
+				this->_shape_coordinate_axis->draw(_cmd, i);
 				//++++++++++++++++++++++++++++++++++++++++++++++++++++
 				//++++++++++++++++++++++++++++++++++++++++++++++++++++
 			}
@@ -204,8 +204,8 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
 		0.1f,
 		1000.0f);
 
-	auto _wvp = _projection * _view * _world;
-	this->_shape_coordinate_axis->update(_wvp);
+	//shape will be updated in render, after the previous submission of swap chain image
+	this->_wvp = _projection * _view * _world;
 
 	w_game::update(pGameTime);
 }
@@ -220,8 +220,6 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 	auto _output_window = &(_gDevice->output_presentation_window);
 	auto _frame_index = _output_window->swap_chain_image_index;
 
-	w_imgui::render();
-
 	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
 	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
 
@@ -230,19 +228,27 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		VkPipelineStageFlagBits::VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
 	};
 
-	//reset draw fence
-	this->_draw_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
+	//uniform of shape for this swap chain image is not in use anymore
+	this->_shape_coordinate_axis->update(this->_wvp, _frame_index);
+
 	if (_gDevice->submit(
 		{ &_draw_cmd, &_gui_cmd },//command buffers
 		_gDevice->vk_graphics_queue, //graphics queue
 		&_wait_dst_stage_mask[0], //destination masks
 		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
 	}
-	this->_draw_fence.wait();
 
 	return w_game::render(pGameTime);
 }
@@ -76,6 +76,7 @@ private:
 	//The following codes have been added for this project
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	wolf::graphics::w_shapes*										_shape_coordinate_axis;
+	glm::mat4														_wvp;
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 };
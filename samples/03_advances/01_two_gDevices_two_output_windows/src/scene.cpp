@@ -91,7 +91,7 @@ void scene::load()
 		}
 
 		//Fence for syncing
-		_hr = this->_draw_fence[i].initialize(_gDevice);
+		_hr = this->_draw_fence[i].initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
 		if (_hr == W_FAILED)
 		{
 			release();
@@ -164,19 +164,20 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 			w_pipeline_stage_flag_bits::COLOR_ATTACHMENT_OUTPUT_BIT,
 		};
 
-		//reset draw fence
-		this->_draw_fence[i].reset();
+		//wait for the previous submission of this swap chain image, other frames stay in flight
+		this->_draw_fence[i].wait_at(_frame_index);
+		this->_draw_fence[i].reset_at(_frame_index);
 		if (_gDevice->submit(
 			{ &_draw_cmd },//command buffers
 			_gDevice->vk_graphics_queue, //graphics queue
 			&_wait_dst_stage_mask[0], //destination masks
 			{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 			{ _output_window->rendering_done_semaphore }, //signal semaphores
-			&this->_draw_fence[i]) == W_FAILED)
+			&this->_draw_fence[i], //fence
+			_frame_index) == W_FAILED)
 		{
 			V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
 		}
-		this->_draw_fence[i].wait();
 	}
 
 	return w_game::render(pGameTime);
@@ -3,13 +3,21 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 
-layout(location = 0) in vec3 i_position;
+//quantized position, the other attributes of quantized vertex are not used
+layout(location = 0) in vec4 i_position;
 
 layout(set = 0, binding = 0) uniform U0
 {
 	mat4	wvp;
 } u0;
 
+//w_mesh_dequantization of mesh
+layout(push_constant) uniform DEQUANTIZATION
+{
+	vec4	position_scale;
+	vec4	position_offset;
+} dequantization;
+
 out gl_PerVertex
 {
   vec4 gl_Position;
@@ -17,5 +25,6 @@ out gl_PerVertex
 
 void main() 
 {
-    gl_Position = u0.wvp * vec4(i_position, 1.0);
+	vec3 _position = i_position.xyz * dequantization.position_scale.xyz + dequantization.position_offset.xyz;
+    gl_Position = u0.wvp * vec4(_position, 1.0);
 }
@@ -13,7 +13,7 @@ static uint32_t sFPS = 0;
 static float sElapsedTimeInSec = 0;
 static float sTotalTimeTimeInSec = 0;
 static bool sShowBoundingBox = true;
-static bool sReBuild = true;
+static bool sReBuild = false;
 
 scene::scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring& pLogPath, _In_z_ const std::wstring& pAppName) :
     w_game(pContentPath, pLogPath, pAppName)
@@ -24,7 +24,6 @@ scene::scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring&
 
 	w_game::set_fixed_time_step(false);
 
-	this->_mesh = nullptr;
 	this->_shape_bounding_box = nullptr;
 }
 
@@ -101,7 +100,7 @@ void scene::load()
     }
 
     //Fence for syncing
-    _hr = this->_draw_fence.initialize(_gDevice);
+    _hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
     if (_hr == W_FAILED)
     {
         release();
@@ -155,8 +154,8 @@ void scene::load()
 		V(W_FAILED, "loading fragment shader", _trace_info, 3, true);
 	}
 
-	//load vertex shader uniform
-	_hr = this->_u0.load(_gDevice);
+	//load vertex shader uniform, one region for each swap chain image
+	_hr = this->_u0.load(_gDevice, true, static_cast<uint32_t>(_swap_chain_image_size));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -167,7 +166,7 @@ void scene::load()
 
 	w_shader_binding_param _shader_param;
 	_shader_param.index = 0;
-	_shader_param.type = w_shader_binding_type::UNIFORM;
+	_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 	_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
 	_shader_param.buffer_info = this->_u0.get_descriptor_info();
 	_shader_params.push_back(_shader_param);
@@ -187,7 +186,13 @@ void scene::load()
 		_pipeline_cache_name.clear();
 	}
 
-	w_vertex_binding_attributes _vertex_binding_attributes(w_vertex_declaration::VERTEX_POSITION);
+	//scale and offset of quantized positions will be sent with push constants
+	w_push_constant_range _push_constants_buffer_range;
+	_push_constants_buffer_range.offset = 0;
+	_push_constants_buffer_range.size = static_cast<uint32_t>(sizeof(w_mesh_dequantization));
+	_push_constants_buffer_range.stageFlags = w_shader_stage_flag_bits::VERTEX_SHADER;
+
+	w_vertex_binding_attributes _vertex_binding_attributes(w_vertex_declaration::VERTEX_QUANTIZED_POSITION_NORMAL_UV_TANGENT_COLOR_BLEND_WEIGHT_BLEND_INDICES);
 	_hr = this->_pipeline.load(
 		_gDevice,
 		_vertex_binding_attributes,
@@ -195,7 +200,10 @@ void scene::load()
 		&this->_draw_render_pass,
 		&this->_shader,
 		{ this->_viewport },
-		{ this->_viewport_scissor });
+		{ this->_viewport_scissor },
+		_pipeline_cache_name,
+		{},
+		{ _push_constants_buffer_range });
 
 	if (_hr == W_FAILED)
 	{
@@ -215,64 +223,50 @@ void scene::load()
 			//load first model
 			if (_model)
 			{
+				//quantize vertices of meshes, positions will be decoded in vertex shader
+				if (_model->quantize_meshes() == W_FAILED)
+				{
+					V(W_FAILED, "quantizing meshes of model", _trace_info);
+					break;
+				}
+
 				std::vector<w_cpipeline_mesh*> _meshes;
 				_model->get_meshes(_meshes);
 
-				std::vector<float> _vertices;
-				std::vector<uint32_t> _indices;
-
-				//get vertices and indices
 				for (auto _mesh : _meshes)
 				{
-					for (size_t i = 0; i < _mesh->indices.size(); ++i)
+					//create mesh
+					auto _gMesh = new (std::nothrow) wolf::graphics::w_mesh();
+					if (!_gMesh)
 					{
-						_indices.push_back(_mesh->indices[i]);
+						V(W_FAILED, "allocating memory of mesh", _trace_info);
+						break;
 					}
 
-					for (auto& _v : _mesh->vertices)
+					if (_gMesh->load(
+						_gDevice,
+						_mesh->quantized.vertices.data(),
+						static_cast<uint32_t>(_mesh->quantized.vertices.size()),
+						_mesh->quantized.position_scale,
+						_mesh->quantized.position_offset,
+						_mesh->indices.data(),
+						static_cast<uint32_t>(_mesh->indices.size())) == W_FAILED)
 					{
-						//just store position
-						auto _pos = _v.position;
-
-						//position
-						_vertices.push_back(_pos[0]);//x
-						_vertices.push_back(_pos[1]);//y
-						_vertices.push_back(_pos[2]);//z
+						SAFE_RELEASE(_gMesh);
+						V(W_FAILED, "loading mesh", _trace_info);
+						continue;
 					}
+					this->_meshes.push_back(_gMesh);
 
 					//merge all bounding box of meshes
 					this->_mesh_bounding_box.merge(_mesh->bounding_box);
 				}
 
-				//create mesh
-				this->_mesh = new (std::nothrow) wolf::graphics::w_mesh();
-				if (_mesh)
-				{
-					auto _v_size = static_cast<uint32_t>(_vertices.size());
-
-					//set vertex declaration
-					_mesh->set_vertex_binding_attributes(_vertex_binding_attributes);
-					if (_mesh->load(
-						_gDevice,
-						_vertices.data(),
-						_v_size * sizeof(float),
-						_v_size,
-						_indices.data(),
-						_indices.size()) == W_FAILED)
-					{
-						V(W_FAILED, "loading mesh", _trace_info);
-					}
-				}
-				else
-				{
-					V(W_FAILED, "allocating memory of mesh", _trace_info);
-				}
-
 				//create shape
 				this->_shape_bounding_box = new (std::nothrow) w_shapes(this->_mesh_bounding_box, w_color::YELLOW());
 				if (this->_shape_bounding_box)
 				{
-					_hr = this->_shape_bounding_box->load(_gDevice, this->_draw_render_pass, this->_viewport, this->_viewport_scissor);
+					_hr = this->_shape_bounding_box->load(_gDevice, this->_draw_render_pass, this->_viewport, this->_viewport_scissor, static_cast<uint32_t>(_swap_chain_image_size));
 					if (_hr == W_FAILED)
 					{
 						SAFE_RELEASE(this->_shape_bounding_box);
@@ -285,10 +279,6 @@ void scene::load()
 					V(W_FAILED, "allocating memory for _shape_bounding_box", _trace_info, 3, true);
 				}
 
-				//clear resources
-				_vertices.clear();
-				_indices.clear();
-
 				//store position and rotation of model into bounding box
 				auto _t = _model->get_transform();
 				_position.x = _t.position[0];
@@ -308,42 +298,61 @@ void scene::load()
 
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	_build_draw_command_buffers();
 }
 
 W_RESULT scene::_build_draw_command_buffers()
 {
-    const std::string _trace_info = this->name + "::build_draw_command_buffers";
+	W_RESULT _hr = W_PASSED;
+
+	auto _size = this->_draw_command_buffers.get_commands_size();
+	this->_rebuild_draw_command_buffers.assign(_size, false);
+	for (uint32_t i = 0; i < _size; ++i)
+	{
+		if (_build_draw_command_buffer(i) == W_FAILED)
+		{
+			_hr = W_FAILED;
+		}
+	}
+	return _hr;
+}
+
+W_RESULT scene::_build_draw_command_buffer(_In_ const uint32_t& pIndex)
+{
+    const std::string _trace_info = this->name + "::build_draw_command_buffer";
     W_RESULT _hr = W_PASSED;
 
-    auto _size = this->_draw_command_buffers.get_commands_size();
-    for (uint32_t i = 0; i < _size; ++i)
+    this->_draw_command_buffers.begin(pIndex);
     {
-        this->_draw_command_buffers.begin(i);
+        auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+        this->_draw_render_pass.begin(
+			pIndex,
+			_cmd,
+            w_color::CORNFLOWER_BLUE(),
+            1.0f,
+            0.0f);
         {
-            auto _cmd = this->_draw_command_buffers.get_command_at(i);
-            this->_draw_render_pass.begin(
-				i,
-				_cmd,
-                w_color::CORNFLOWER_BLUE(),
-                1.0f,
-                0.0f);
-            {
-				this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
-				if (this->_mesh)
-				{
-					this->_mesh->draw(_cmd, nullptr, 0);
-				}
-				if (sShowBoundingBox && this->_shape_bounding_box)
-				{
-					this->_shape_bounding_box->draw(_cmd);
-				}
-            }
-            this->_draw_render_pass.end(_cmd);
+			this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS, { this->_u0.get_dynamic_offset_at(pIndex) });
+			for (auto _mesh : this->_meshes)
+			{
+				auto _dequantization = _mesh->get_dequantization();
+				this->_pipeline.set_push_constant_buffer(
+					_cmd,
+					w_shader_stage_flag_bits::VERTEX_SHADER,
+					0,
+					static_cast<uint32_t>(sizeof(w_mesh_dequantization)),
+					&_dequantization);
+				_mesh->draw(_cmd, nullptr, 0);
+			}
+			if (sShowBoundingBox && this->_shape_bounding_box)
+			{
+				this->_shape_bounding_box->draw(_cmd, pIndex);
+			}
         }
-        this->_draw_command_buffers.end(i);
+        this->_draw_render_pass.end(_cmd);
     }
-
-	sReBuild = false;
+    this->_draw_command_buffers.end(pIndex);
 
     return _hr;
 }
@@ -384,22 +393,14 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
 		0.1f, 
 		1000.0f);
 
-	auto _wvp = _projection * _view * _world;
-	
-	this->_u0.data.wvp = _wvp;
-	auto _hr = this->_u0.update();
-	if (_hr == W_FAILED)
-	{
-		V(W_FAILED, "updating uniform WorldViewProjection", _trace_info, 3, false);
-	}
+	//uniforms will be copied to region of swap chain image in render
+	this->_u0.data.wvp = _projection * _view * _world;
 
-	if (sShowBoundingBox && this->_shape_bounding_box)
-	{
-		this->_shape_bounding_box->update(_wvp);
-	}
 	if (sReBuild)
 	{
-		_build_draw_command_buffers();
+		sReBuild = false;
+		//command buffers will be recorded again after their previous submissions
+		std::fill(this->_rebuild_draw_command_buffers.begin(), this->_rebuild_draw_command_buffers.end(), true);
 	}
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -417,8 +418,6 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 	auto _output_window = &(_gDevice->output_presentation_window);
 	auto _frame_index = _output_window->swap_chain_image_index;
 
-	w_imgui::render();
-
 	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
 	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
 
@@ -427,19 +426,44 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		w_pipeline_stage_flag_bits::COLOR_ATTACHMENT_OUTPUT_BIT,
 	};
 
-	//reset draw fence
-	this->_draw_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//command buffer of this swap chain image is not in use anymore, so record it again if it has been invalidated
+	if (this->_rebuild_draw_command_buffers[_frame_index])
+	{
+		this->_rebuild_draw_command_buffers[_frame_index] = false;
+		if (_build_draw_command_buffer(_frame_index) == W_FAILED)
+		{
+			V(W_FAILED, "building draw command buffer", _trace_info, 3, false);
+		}
+	}
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
+	//uniforms of this swap chain image are not in use anymore
+	if (this->_u0.update_at(_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "updating uniform WorldViewProjection", _trace_info, 3, false);
+	}
+	if (sShowBoundingBox && this->_shape_bounding_box)
+	{
+		this->_shape_bounding_box->update(this->_u0.data.wvp, _frame_index);
+	}
+
 	if (_gDevice->submit(
 		{ &_draw_cmd, &_gui_cmd },//command buffers
 		_gDevice->vk_graphics_queue, //graphics queue
 		&_wait_dst_stage_mask[0], //destination masks
 		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
 	}
-	this->_draw_fence.wait();
 
 	return w_game::render(pGameTime);
 }
@@ -474,7 +498,11 @@ ULONG scene::release()
 	this->_u0.release();
 	this->_pipeline.release();
 	this->_shader.release();
-	SAFE_RELEASE(this->_mesh);
+	for (auto _mesh : this->_meshes)
+	{
+		SAFE_RELEASE(_mesh);
+	}
+	this->_meshes.clear();
 	SAFE_RELEASE(this->_shape_bounding_box);
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -66,6 +66,7 @@ public:
 
 private:
 	W_RESULT _build_draw_command_buffers();
+	W_RESULT _build_draw_command_buffer(_In_ const uint32_t& pIndex);
     bool	_update_gui();
 
 	wolf::graphics::w_viewport                                      _viewport;
@@ -73,6 +74,8 @@ private:
 
 
 	wolf::graphics::w_command_buffers                               _draw_command_buffers;
+	//swap chain images which their command buffers must be recorded again before next submission
+	std::vector<bool>                                               _rebuild_draw_command_buffers;
 	wolf::graphics::w_render_pass                                   _draw_render_pass;
 
 
@@ -88,7 +91,8 @@ private:
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	
 	float															_distance_from_eye;
-	wolf::graphics::w_mesh*											_mesh;
+	//quantized meshes of model, each one has its own scale and offset of positions
+	std::vector<wolf::graphics::w_mesh*>							_meshes;
 	wolf::system::w_bounding_box									_mesh_bounding_box;
 	wolf::graphics::w_shapes*										_shape_bounding_box;
 	glm::vec3														_position;
@@ -107,7 +107,7 @@ void scene::load()
     }
 
     //Fence for syncing
-    _hr = this->_draw_fence.initialize(_gDevice);
+    _hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
     if (_hr == W_FAILED)
     {
         release();
@@ -158,8 +158,8 @@ void scene::load()
 		V(W_FAILED, "loading fragment shader", _trace_info, 3, true);
 	}
 
-	//load vertex shader uniform
-	_hr = this->_u0.load(_gDevice);
+	//load vertex shader uniform, one region for each swap chain image
+	_hr = this->_u0.load(_gDevice, true, static_cast<uint32_t>(_swap_chain_image_size));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -170,7 +170,7 @@ void scene::load()
 
 	w_shader_binding_param _shader_param;
 	_shader_param.index = 0;
-	_shader_param.type = w_shader_binding_type::UNIFORM;
+	_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 	_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
 	_shader_param.buffer_info = this->_u0.get_descriptor_info();
 	_shader_params.push_back(_shader_param);
@@ -402,7 +402,7 @@ W_RESULT scene::_build_draw_command_buffers()
                 1.0f,
                 0.0f);
             {
-				this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
+				this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS, { this->_u0.get_dynamic_offset_at(i) });
 				if (this->_mesh)
 				{
 					//++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -456,13 +456,9 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//The following codes have been added for this project
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//update uniform's data, it will be copied to region of swap chain image in render
 	this->_u0.data.view = _view;
 	this->_u0.data.projection = _projection;
-	auto _hr = this->_u0.update();
-	if (_hr == W_FAILED)
-	{
-		V(W_FAILED, "updating uniform ViewProjection", _trace_info, 3, false);
-	}
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 
@@ -479,8 +475,6 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 	auto _output_window = &(_gDevice->output_presentation_window);
 	auto _frame_index = _output_window->swap_chain_image_index;
 
-	w_imgui::render();
-    
 	auto _draw_command_buffer = this->_draw_command_buffers.get_command_at(_frame_index);
     auto _gui_command_buffer = w_imgui::get_command_buffer_at(_frame_index);
 
@@ -489,20 +483,31 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		w_pipeline_stage_flag_bits::COLOR_ATTACHMENT_OUTPUT_BIT,
 	};
 
-	//reset draw fence
-	this->_draw_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
+	//uniform of this swap chain image is not in use anymore
+	if (this->_u0.update_at(_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "updating uniform ViewProjection", _trace_info, 3, false);
+	}
+
 	if (_gDevice->submit(
 		{ &_draw_command_buffer, &_gui_command_buffer },//command buffers
 		_gDevice->vk_graphics_queue, //graphics queue
 		&_wait_dst_stage_mask[0], //destination masks
 		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
 	}
 
-	this->_draw_fence.wait();
 
 	return w_game::render(pGameTime);
 }
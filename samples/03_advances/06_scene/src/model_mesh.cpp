@@ -22,6 +22,7 @@ public:
 		_name("model"),
 		_mesh(nullptr),
 		_c_model(pContentPipelineModel),
+		_number_of_frames(1),
 		_visible(true)
 	{
 	}
@@ -31,10 +32,14 @@ public:
 		_In_z_ const std::string& pPipelineCacheName, 
 		_In_z_ const std::wstring& pVertexShaderPath,
 		_In_z_ const std::wstring& pFragmentShaderPath,
-		_In_ const w_render_pass& pRenderPass)
+		_In_ const w_render_pass& pRenderPass,
+		_In_ const uint32_t& pNumberOfFrames)
 	{
 		if (!pGDevice || !_c_model) return W_FAILED;
 		this->_gDevice = pGDevice;
+		this->_number_of_frames = pNumberOfFrames;
+		//uniforms of all frames must be copied before their first submission
+		this->_update_frames.assign(pNumberOfFrames, true);
 
 		const std::string _trace_info = this->_name + "::load";
 
@@ -213,7 +218,34 @@ public:
 		return W_PASSED;
 	}
 
-	W_RESULT draw(_In_ const w_command_buffer& pCommandBuffer, _In_ const bool& pInDirectMode)
+	W_RESULT update(_In_ const uint32_t& pFrameIndex)
+	{
+		if (pFrameIndex >= this->_update_frames.size() || !this->_update_frames[pFrameIndex]) return W_PASSED;
+
+		const std::string _trace_info = this->_name + "::update";
+
+		this->_update_frames[pFrameIndex] = false;
+
+		auto _hr = this->_instnaces_transforms.size() ? 
+			this->_instance_u0.update_at(pFrameIndex) : 
+			this->_basic_u0.update_at(pFrameIndex);
+		if (_hr == W_FAILED)
+		{
+			V(W_FAILED, "updating uniform ViewProjection for model: " + this->_model_name, _trace_info, 3);
+			return W_FAILED;
+		}
+
+		_hr = this->_u1.update_at(pFrameIndex);
+		if (_hr == W_FAILED)
+		{
+			V(W_FAILED, "updating u1 uniform for model: " + this->_model_name, _trace_info, 3);
+			return W_FAILED;
+		}
+
+		return W_PASSED;
+	}
+
+	W_RESULT draw(_In_ const w_command_buffer& pCommandBuffer, _In_ const uint32_t& pFrameIndex, _In_ const bool& pInDirectMode)
 	{
 		if (!this->_visible) return W_PASSED;
 
@@ -222,7 +254,13 @@ public:
 		if (!this->_mesh) return W_FAILED;
 
 		//bind pipeline
-		this->_pipeline.bind(pCommandBuffer, w_pipeline_bind_point::GRAPHICS);
+		this->_pipeline.bind(pCommandBuffer, w_pipeline_bind_point::GRAPHICS, 
+			{
+				this->_instnaces_transforms.size() ? 
+					this->_instance_u0.get_dynamic_offset_at(pFrameIndex) : 
+					this->_basic_u0.get_dynamic_offset_at(pFrameIndex),
+				this->_u1.get_dynamic_offset_at(pFrameIndex)
+			});
 		auto _buffer_handle = this->_instances_buffer.get_buffer_handle();
 		return this->_mesh->draw(pCommandBuffer, _buffer_handle.handle ? &_buffer_handle : nullptr, this->_instnaces_transforms.size(), pInDirectMode);
 	}
@@ -261,17 +299,10 @@ public:
 
 	void set_view_projection(_In_ const glm::mat4& pView, _In_ const glm::mat4& pProjection)
 	{
-		const std::string _trace_info = this->_name + "::set_view_projection";
-
 		if (this->_instnaces_transforms.size())
 		{
 			this->_instance_u0.data.view = pView;
 			this->_instance_u0.data.projection = pProjection;
-			auto _hr = this->_instance_u0.update();
-			if (_hr == W_FAILED)
-			{
-				V(W_FAILED, "updating instance uniform ViewProjection for model: " + this->_model_name, _trace_info, 3);
-			}
 		}
 		else
 		{
@@ -282,24 +313,16 @@ public:
 			this->_basic_u0.data.model = glm::translate(_position) * glm::rotate(_rotation) * glm::scale(_scale);
 			this->_basic_u0.data.view = pView;
 			this->_basic_u0.data.projection = pProjection;
-			auto _hr = this->_basic_u0.update();
-			if (_hr == W_FAILED)
-			{
-				V(W_FAILED, "updating basic uniform ViewProjection for model: " + this->_model_name, _trace_info, 3);
-			}
 		}
+		//uniforms will be copied to region of each frame in update
+		std::fill(this->_update_frames.begin(), this->_update_frames.end(), true);
 	}
 
 	void set_enable_instances_colors(_In_ const bool& pEnable)
 	{
-		const std::string _trace_info = this->_name + "::set_enable_instances_colors";
-
 		this->_u1.data.cmds = pEnable ? 1 : 0;
-		auto _hr = this->_u1.update();
-		if (_hr == W_FAILED)
-		{
-			V(W_FAILED, "updating u1 uniform for model: " + this->_model_name, _trace_info, 3);
-		}
+		//uniforms will be copied to region of each frame in update
+		std::fill(this->_update_frames.begin(), this->_update_frames.end(), true);
 	}
 
 	void set_visible(_In_ const bool& pValue)
@@ -954,13 +977,13 @@ private:
 
 		w_shader_binding_param _shader_param;
 		_shader_param.index = 0;
-		_shader_param.type = w_shader_binding_type::UNIFORM;
+		_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 		_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
 		
 		//load vertex shader uniform
 		if (this->_instnaces_transforms.size())
 		{
-			_hr = this->_instance_u0.load(_gDevice);
+			_hr = this->_instance_u0.load(_gDevice, true, this->_number_of_frames);
 			if (_hr == W_FAILED)
 			{
 				this->_shader.release();
@@ -971,7 +994,7 @@ private:
 		}
 		else
 		{
-			_hr = this->_basic_u0.load(_gDevice);
+			_hr = this->_basic_u0.load(_gDevice, true, this->_number_of_frames);
 			if (_hr == W_FAILED)
 			{
 				this->_shader.release();
@@ -990,7 +1013,7 @@ private:
 
 		_shader_params.push_back(_shader_param);
 
-		_hr = this->_u1.load(_gDevice);
+		_hr = this->_u1.load(_gDevice, true, this->_number_of_frames);
 		if (_hr == W_FAILED)
 		{
 			this->_shader.release();
@@ -998,7 +1021,7 @@ private:
 			return W_FAILED;
 		}
 		_shader_param.index = 2;
-		_shader_param.type = w_shader_binding_type::UNIFORM;
+		_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 		_shader_param.stage = w_shader_stage_flag_bits::FRAGMENT_SHADER;
 		_shader_param.buffer_info = this->_u1.get_descriptor_info();
 
@@ -1077,6 +1100,11 @@ private:
 	};
 	wolf::graphics::w_uniform<u1>			_u1;
 
+	//one region of uniforms for each frame in flight
+	uint32_t								_number_of_frames;
+	//frames which their uniforms must be copied again
+	std::vector<bool>						_update_frames;
+
 	bool									_visible;
 };
 
@@ -1098,19 +1126,29 @@ W_RESULT model_mesh::load(
 	_In_ const std::string& pPipelineCacheName,
 	_In_z_ const std::wstring& pVertexShaderPath,
 	_In_z_ const std::wstring& pFragmentShaderPath,
-	_In_ const w_render_pass& pDrawRenderPass)
+	_In_ const w_render_pass& pDrawRenderPass,
+	_In_ const uint32_t& pNumberOfFrames)
 {
 	return !this->_pimp ? W_FAILED : this->_pimp->load(
 		pGDevice, 
 		pPipelineCacheName, 
 		pVertexShaderPath, 
 		pFragmentShaderPath,
-		pDrawRenderPass);
+		pDrawRenderPass,
+		pNumberOfFrames);
+}
+
+W_RESULT model_mesh::update(_In_ const uint32_t& pFrameIndex)
+{
+	return !this->_pimp ? W_FAILED : this->_pimp->update(pFrameIndex);
 }
 
-W_RESULT model_mesh::draw(_In_ const w_command_buffer& pCommandBuffer, _In_ const bool& pInDirectDraw)
+W_RESULT model_mesh::draw(
+	_In_ const w_command_buffer& pCommandBuffer,
+	_In_ const uint32_t& pFrameIndex,
+	_In_ const bool& pInDirectDraw)
 {
-	return !this->_pimp ? W_FAILED : this->_pimp->draw(pCommandBuffer, pInDirectDraw);
+	return !this->_pimp ? W_FAILED : this->_pimp->draw(pCommandBuffer, pFrameIndex, pInDirectDraw);
 }
 
 ULONG model_mesh::release()
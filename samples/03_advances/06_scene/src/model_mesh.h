@@ -42,14 +42,21 @@ public:
 		_In_ const std::string& pPipelineCacheName,
 		_In_z_ const std::wstring& pVertexShaderPath,
 		_In_z_ const std::wstring& pFragmentShaderPath,
-		_In_ const wolf::graphics::w_render_pass& pDrawRenderPass);
+		_In_ const wolf::graphics::w_render_pass& pDrawRenderPass,
+		_In_ const uint32_t& pNumberOfFrames = 1);
+
+	//copy uniforms to the region of a frame, previous submission of this frame must be completed by GPU
+	W_RESULT update(_In_ const uint32_t& pFrameIndex);
 	
 	/*
 		direct draw to graphics device or indirect draw.
 		Unlike direct drawing function, indirect drawing functions take their draw commands from a
 		buffer object containing information like index count, index offset and number of instances to draw.
 	*/
-	W_RESULT draw(_In_ const wolf::graphics::w_command_buffer& pCommandBuffer, _In_ const bool& pInDirectDraw = false);
+	W_RESULT draw(
+		_In_ const wolf::graphics::w_command_buffer& pCommandBuffer,
+		_In_ const uint32_t& pFrameIndex,
+		_In_ const bool& pInDirectDraw = false);
 
 	//release all resources
 	W_EXP ULONG release() override;
@@ -50,7 +50,7 @@ scene::scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring&
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	_current_selected_model(nullptr),
 	_show_all_instances_colors(false),
-	_rebuild_command_buffer(true)
+	_rebuild_command_buffer(false)
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 {
@@ -149,7 +149,7 @@ void scene::load()
 	}
 
 	//Fence for syncing
-	_hr = this->_draw_fence.initialize(_gDevice);
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -277,7 +277,8 @@ void scene::load()
 				_model_pipeline_cache_name, 
 				_vertex_shader_path,
 				_fragment_shader_path, 
-				this->_draw_render_pass);
+				this->_draw_render_pass,
+				static_cast<uint32_t>(_swap_chain_image_size));
 			if (_hr == W_FAILED)
 			{
 				V(W_FAILED, "loading model: " + _m->get_name(), _trace_info, 2);
@@ -293,41 +294,55 @@ void scene::load()
 	}
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	_build_draw_command_buffers();
 }
 
 W_RESULT scene::_build_draw_command_buffers()
 {
-	const std::string _trace_info = this->name + "::build_draw_command_buffers";
 	W_RESULT _hr = W_PASSED;
 
 	auto _size = this->_draw_command_buffers.get_commands_size();
+	this->_rebuild_draw_command_buffers.assign(_size, false);
 	for (uint32_t i = 0; i < _size; ++i)
 	{
-		this->_draw_command_buffers.begin(i);
+		if (_build_draw_command_buffer(i) == W_FAILED)
+		{
+			_hr = W_FAILED;
+		}
+	}
+	return _hr;
+}
+
+W_RESULT scene::_build_draw_command_buffer(_In_ const uint32_t& pIndex)
+{
+	const std::string _trace_info = this->name + "::build_draw_command_buffer";
+	W_RESULT _hr = W_PASSED;
+
+	this->_draw_command_buffers.begin(pIndex);
+	{
+		auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+		this->_draw_render_pass.begin(
+			pIndex,
+			_cmd,
+			w_color::CORNFLOWER_BLUE(),
+			1.0f,
+			0.0f);
 		{
-			auto _cmd = this->_draw_command_buffers.get_command_at(i);
-			this->_draw_render_pass.begin(
-				i,
-				_cmd,
-				w_color::CORNFLOWER_BLUE(),
-				1.0f,
-				0.0f);
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//The following codes have been added for this project
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//draw all models
+			for (auto _model : this->_models)
 			{
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				//The following codes have been added for this project
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				//draw all models
-				for (auto _model : this->_models)
-				{
-					_model->draw(_cmd, false);
-				}
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
+				_model->draw(_cmd, pIndex, false);
 			}
-			this->_draw_render_pass.end(_cmd);
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
 		}
-		this->_draw_command_buffers.end(i);
+		this->_draw_render_pass.end(_cmd);
 	}
+	this->_draw_command_buffers.end(pIndex);
 
 	return _hr;
 }
@@ -370,8 +385,9 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
 
 	if (this->_rebuild_command_buffer)
 	{
-		_build_draw_command_buffers();
 		this->_rebuild_command_buffer = false;
+		//command buffers will be recorded again after their previous submissions
+		std::fill(this->_rebuild_draw_command_buffers.begin(), this->_rebuild_draw_command_buffers.end(), true);
 	}
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -389,8 +405,6 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 	auto _output_window = &(_gDevice->output_presentation_window);
 	auto _frame_index = _output_window->swap_chain_image_index;
 
-	w_imgui::render();
-
 	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
 	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
 
@@ -399,19 +413,40 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		w_pipeline_stage_flag_bits::COLOR_ATTACHMENT_OUTPUT_BIT,
 	};
 
-	//reset draw fence
-	this->_draw_fence.reset();
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//command buffer of this swap chain image is not in use anymore, so record it again if it has been invalidated
+	if (this->_rebuild_draw_command_buffers[_frame_index])
+	{
+		this->_rebuild_draw_command_buffers[_frame_index] = false;
+		if (_build_draw_command_buffer(_frame_index) == W_FAILED)
+		{
+			V(W_FAILED, "building draw command buffer", _trace_info, 3, false);
+		}
+	}
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
+	//uniforms of models for this swap chain image are not in use anymore
+	for (auto _model : this->_models)
+	{
+		_model->update(_frame_index);
+	}
+
 	if (_gDevice->submit(
 		{ &_draw_cmd, &_gui_cmd },//command buffers
 		_gDevice->vk_graphics_queue, //graphics queue
 		&_wait_dst_stage_mask[0], //destination masks
 		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
 	}
-	this->_draw_fence.wait();
 
 	return w_game::render(pGameTime);
 }
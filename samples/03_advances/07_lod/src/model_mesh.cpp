@@ -19,7 +19,9 @@ model_mesh::model_mesh(
 	global_visiblity(true),
 	c_model(pContentPipelineModel),
 	_selected_lod_index(0),
-	_texture_mip_map_level(0.0f)
+	_texture_mip_map_level(0.0f),
+	_number_of_frames(1),
+	_cs_out_stride(0)
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 {
@@ -36,10 +38,14 @@ W_RESULT model_mesh::load(
 	_In_z_ const std::string& pComputePipelineCacheName,
 	_In_z_ const std::wstring& pVertexShaderPath,
 	_In_z_ const std::wstring& pFragmentShaderPath,
-	_In_ const w_render_pass& pRenderPass)
+	_In_ const w_render_pass& pRenderPass,
+	_In_ const uint32_t& pNumberOfFrames)
 {
-	if (!pGDevice || !this->c_model) return W_FAILED;
+	if (!pGDevice || !this->c_model || !pNumberOfFrames) return W_FAILED;
 	this->gDevice = pGDevice;
+	this->_number_of_frames = pNumberOfFrames;
+	//uniforms of all frames must be copied before their first submission
+	this->_update_frames.assign(pNumberOfFrames, true);
 
 	const std::string _trace_info = this->_name + "::load";
 
@@ -127,8 +133,8 @@ W_RESULT model_mesh::load(
 			V(W_FAILED, "initializing compute semaphore for model: " + this->model_name, _trace_info, 2);
 			return W_FAILED;
 		}
-		//build compute command buffer
-		if (_build_compute_command_buffer() == W_FAILED)
+		//build compute command buffers
+		if (_build_compute_command_buffers() == W_FAILED)
 		{
 			release();
 			V(W_FAILED, "building compute command buffer for model: " + this->model_name, _trace_info, 2);
@@ -145,13 +151,14 @@ W_RESULT model_mesh::load(
 //The following codes have been added for this project
 //++++++++++++++++++++++++++++++++++++++++++++++++++++
 
-W_RESULT model_mesh::_build_compute_command_buffer()
+W_RESULT model_mesh::_build_compute_command_buffers()
 {
-	const std::string _trace_info = this->name + "::_build_compute_command_buffer";
+	const std::string _trace_info = this->name + "::_build_compute_command_buffers";
 
+	//one command buffer for each frame, which works on region of that frame
 	if (this->_cs.command_buffers.load(
 		this->gDevice,
-		1,
+		this->_number_of_frames,
 		w_command_buffer_level::PRIMARY,
 		true,
 		&gDevice->vk_compute_queue) == W_FAILED)
@@ -160,67 +167,75 @@ W_RESULT model_mesh::_build_compute_command_buffer()
 		return W_FAILED;
 	}
 
-	auto _cmd = this->_cs.command_buffers.get_command_at(0);
-	this->_cs.command_buffers.begin(0);
+	auto _indirect_draws_buffer = this->indirect_draws.buffer.get_buffer_handle();
+	for (uint32_t i = 0; i < this->_number_of_frames; ++i)
 	{
-		auto _indirect_draws_buffer = this->indirect_draws.buffer.get_buffer_handle();
-		auto _size = this->indirect_draws.buffer.get_descriptor_info().range;
-
-		// Add memory barrier to ensure that the indirect commands have been consumed before the compute shader updates them
-		VkBufferMemoryBarrier _barrier = {};
-		_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
-		_barrier.buffer = _indirect_draws_buffer.handle;
-		_barrier.size = _size;
-		_barrier.srcAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-		_barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-		_barrier.srcQueueFamilyIndex = this->gDevice->vk_graphics_queue.index;
-		_barrier.dstQueueFamilyIndex = this->gDevice->vk_compute_queue.index;
-
-		vkCmdPipelineBarrier(
-			_cmd.handle,
-			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
-			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-			0,
-			0, nullptr,
-			1, &_barrier,
-			0, nullptr);
-
-		if (this->_cs.pipeline.bind(_cmd, w_pipeline_bind_point::COMPUTE) == W_FAILED)
+		auto _cmd = this->_cs.command_buffers.get_command_at(i);
+		this->_cs.command_buffers.begin(i);
 		{
-			this->_cs.command_buffers.end(0);
-			V(W_FAILED, "binding compute command buffer for " + this->model_name, _trace_info);
-			return W_FAILED;
-		}
+			// Add memory barrier to ensure that the indirect commands have been consumed before the compute shader updates them
+			VkBufferMemoryBarrier _barrier = {};
+			_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+			_barrier.buffer = _indirect_draws_buffer.handle;
+			_barrier.offset = this->indirect_draws.get_offset_at(i);
+			_barrier.size = this->indirect_draws.frame_size;
+			_barrier.srcAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+			_barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			_barrier.srcQueueFamilyIndex = this->gDevice->vk_graphics_queue.index;
+			_barrier.dstQueueFamilyIndex = this->gDevice->vk_compute_queue.index;
+
+			vkCmdPipelineBarrier(
+				_cmd.handle,
+				VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				0,
+				0, nullptr,
+				1, &_barrier,
+				0, nullptr);
+
+			//indirect draws, uniform and output of this frame
+			if (this->_cs.pipeline->bind(
+				_cmd,
+				w_pipeline_bind_point::COMPUTE,
+				{
+					this->indirect_draws.get_offset_at(i),
+					this->_cs.unifrom->get_dynamic_offset_at(i),
+					i * this->_cs_out_stride
+				}) == W_FAILED)
+			{
+				this->_cs.command_buffers.end(i);
+				V(W_FAILED, "binding compute command buffer for " + this->model_name, _trace_info);
+				return W_FAILED;
+			}
 
-		vkCmdDispatch(
-			_cmd.handle,
-			(uint32_t)(this->indirect_draws.drawing_commands.size() / this->_cs.batch_local_size),
-			1,
-			1);
-
-		// Add memory barrier to ensure that the compute shader has finished writing the indirect command buffer before it's consumed
-		_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
-		_barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-		_barrier.buffer = _indirect_draws_buffer.handle;
-		_barrier.size = _size;
-		_barrier.srcQueueFamilyIndex = this->gDevice->vk_compute_queue.index;
-		_barrier.dstQueueFamilyIndex = this->gDevice->vk_graphics_queue.index;
-
-		vkCmdPipelineBarrier(
-			_cmd.handle,
-			VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
-			0,
-			0, nullptr,
-			1, &_barrier,
-			0, nullptr);
+			vkCmdDispatch(
+				_cmd.handle,
+				(uint32_t)(this->indirect_draws.drawing_commands.size() / this->_cs.batch_local_size),
+				1,
+				1);
+
+			// Add memory barrier to ensure that the compute shader has finished writing the indirect command buffer before it's consumed
+			_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			_barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+			_barrier.srcQueueFamilyIndex = this->gDevice->vk_compute_queue.index;
+			_barrier.dstQueueFamilyIndex = this->gDevice->vk_graphics_queue.index;
+
+			vkCmdPipelineBarrier(
+				_cmd.handle,
+				VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+				VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT,
+				0,
+				0, nullptr,
+				1, &_barrier,
+				0, nullptr);
+		}
+		this->_cs.command_buffers.end(i);
 	}
-	this->_cs.command_buffers.end(0);
 
 	return W_PASSED;
 }
 
-W_RESULT model_mesh::submit_compute_shader(_In_ const glm::vec3 pCameraPosition)
+W_RESULT model_mesh::submit_compute_shader(_In_ const glm::vec3 pCameraPosition, _In_ const uint32_t& pFrameIndex)
 {
 	W_RESULT _hr = W_PASSED;
 	const std::string _trace_info = this->_name + "::submit_compute_shader";
@@ -271,102 +286,20 @@ W_RESULT model_mesh::submit_compute_shader(_In_ const glm::vec3 pCameraPosition)
 		return W_FAILED;
 	}
 
-	switch (this->_cs.batch_local_size)
-	{
-	case 1:
-		this->_cs.unifrom_x1->data.camera_pos = _cam_pos;
-		std::memcpy(
-			&this->_cs.unifrom_x1->data.is_visible[0],
-			this->visibilities.data(),
-			sizeof(this->_cs.unifrom_x1->data.is_visible));
-		_hr = this->_cs.unifrom_x1->update();
-		break;
-	case 2:
-		this->_cs.unifrom_x2->data.camera_pos = _cam_pos;
-		std::memcpy(
-			&this->_cs.unifrom_x2->data.is_visible[0],
-			this->visibilities.data(),
-			sizeof(this->_cs.unifrom_x2->data.is_visible));
-		_hr = this->_cs.unifrom_x2->update();
-		break;
-	case 4:
-		this->_cs.unifrom_x4->data.camera_pos = _cam_pos;
-		std::memcpy(
-			&this->_cs.unifrom_x4->data.is_visible[0],
-			this->visibilities.data(),
-			sizeof(this->_cs.unifrom_x4->data.is_visible));
-		_hr = this->_cs.unifrom_x4->update();
-		break;
-	case 8:
-		this->_cs.unifrom_x8->data.camera_pos = _cam_pos;
-		std::memcpy(
-			&this->_cs.unifrom_x8->data.is_visible[0],
-			this->visibilities.data(),
-			sizeof(this->_cs.unifrom_x8->data.is_visible));
-		_hr = this->_cs.unifrom_x8->update();
-		break;
-	case 16:
-		this->_cs.unifrom_x16->data.camera_pos = _cam_pos;
-		std::memcpy(
-			&this->_cs.unifrom_x16->data.is_visible[0],
-			this->visibilities.data(),
-			sizeof(this->_cs.unifrom_x16->data.is_visible));
-		_hr = this->_cs.unifrom_x16->update();
-		break;
-	case 32:
-		this->_cs.unifrom_x32->data.camera_pos = _cam_pos;
-		std::memcpy(
-			&this->_cs.unifrom_x32->data.is_visible[0],
-			this->visibilities.data(),
-			sizeof(this->_cs.unifrom_x32->data.is_visible));
-		_hr = this->_cs.unifrom_x32->update();
-		break;
-	case 64:
-		this->_cs.unifrom_x64->data.camera_pos = _cam_pos;
-		std::memcpy(
-			&this->_cs.unifrom_x64->data.is_visible[0],
-			this->visibilities.data(),
-			sizeof(this->_cs.unifrom_x64->data.is_visible));
-		_hr = this->_cs.unifrom_x64->update();
-		break;
-	case 128:
-		this->_cs.unifrom_x128->data.camera_pos = _cam_pos;
-		std::memcpy(&this->_cs.unifrom_x128->data.is_visible[0],
-			this->visibilities.data(), sizeof(this->_cs.unifrom_x128->data.is_visible));
-		_hr = this->_cs.unifrom_x128->update();
-		break;
-	case 256:
-		this->_cs.unifrom_x256->data.camera_pos = _cam_pos;
-		std::memcpy(
-			&this->_cs.unifrom_x256->data.is_visible[0],
-			this->visibilities.data(),
-			sizeof(this->_cs.unifrom_x256->data.is_visible));
-		_hr = this->_cs.unifrom_x256->update();
-		break;
-	case 512:
-		this->_cs.unifrom_x512->data.camera_pos = _cam_pos;
-		std::memcpy(
-			&this->_cs.unifrom_x512->data.is_visible[0],
-			this->visibilities.data(),
-			sizeof(this->_cs.unifrom_x512->data.is_visible));
-		_hr = this->_cs.unifrom_x512->update();
-		break;
-	case 1024:
-		this->_cs.unifrom_x1024->data.camera_pos = _cam_pos;
-		std::memcpy(
-			&this->_cs.unifrom_x1024->data.is_visible[0],
-			this->visibilities.data(),
-			sizeof(this->_cs.unifrom_x1024->data.is_visible));
-		_hr = this->_cs.unifrom_x1024->update();
-		break;
-	}
+	this->_cs.unifrom->data.camera_pos = _cam_pos;
+	std::memcpy(
+		&this->_cs.unifrom->data.is_visible[0],
+		this->visibilities.data(),
+		this->visibilities.size() * sizeof(float));
+	//region of this frame is not in use anymore
+	_hr = this->_cs.unifrom->update_at(pFrameIndex);
 
 	if (_hr == W_FAILED)
 	{
 		V(_hr, "updating compute shader's unifrom for model: " + this->model_name, _trace_info, 3);
 	}
 
-	auto _cmd = this->_cs.command_buffers.get_command_at(0);
+	auto _cmd = this->_cs.command_buffers.get_command_at(pFrameIndex);
 
 	VkSubmitInfo _submit_info = {};
 	_submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -385,7 +318,34 @@ W_RESULT model_mesh::submit_compute_shader(_In_ const glm::vec3 pCameraPosition)
 	return _hr;
 }
 
-W_RESULT model_mesh::draw(_In_ const w_command_buffer& pCommandBuffer)
+W_RESULT model_mesh::update_uniforms(_In_ const uint32_t& pFrameIndex)
+{
+	if (pFrameIndex >= this->_update_frames.size() || !this->_update_frames[pFrameIndex]) return W_PASSED;
+
+	const std::string _trace_info = this->_name + "::update_uniforms";
+
+	this->_update_frames[pFrameIndex] = false;
+
+	auto _hr = this->instnaces_transforms.size() ?
+		this->_instance_u0.update_at(pFrameIndex) :
+		this->_basic_u0.update_at(pFrameIndex);
+	if (_hr == W_FAILED)
+	{
+		V(W_FAILED, "updating uniform ViewProjection for model: " + this->model_name, _trace_info, 3);
+		return W_FAILED;
+	}
+
+	_hr = this->_u2.update_at(pFrameIndex);
+	if (_hr == W_FAILED)
+	{
+		V(W_FAILED, "updating uniform u2(cmds) for model: " + this->model_name, _trace_info, 3);
+		return W_FAILED;
+	}
+
+	return W_PASSED;
+}
+
+W_RESULT model_mesh::draw(_In_ const w_command_buffer& pCommandBuffer, _In_ const uint32_t& pFrameIndex)
 {
 	if (!this->global_visiblity) return W_PASSED;
 
@@ -393,16 +353,23 @@ W_RESULT model_mesh::draw(_In_ const w_command_buffer& pCommandBuffer)
 
 	if (!this->_mesh) return W_FAILED;
 
-	if (this->_texture_mip_map_level != this->_u1.data.texture_lod)
+	//command buffer of this frame is being recorded, so its region is not in use anymore
+	this->_u1.data.texture_lod = this->_texture_mip_map_level;
+	if (this->_u1.update_at(pFrameIndex) == W_FAILED)
 	{
-		this->_u1.data.texture_lod = this->_texture_mip_map_level;
-		if (this->_u1.update() == W_FAILED)
-		{
-			V(W_FAILED, "updating uniform u1(mipmaps) for model: " + this->model_name, _trace_info, 3);
-		}
+		V(W_FAILED, "updating uniform u1(mipmaps) for model: " + this->model_name, _trace_info, 3);
 	}
-	//bind pipeline
-	this->_pipeline.bind(pCommandBuffer, w_pipeline_bind_point::GRAPHICS);
+	//bind pipeline with uniforms of this frame
+	this->_pipeline.bind(
+		pCommandBuffer,
+		w_pipeline_bind_point::GRAPHICS,
+		{
+			this->instnaces_transforms.size() ?
+				this->_instance_u0.get_dynamic_offset_at(pFrameIndex) :
+				this->_basic_u0.get_dynamic_offset_at(pFrameIndex),
+			this->_u1.get_dynamic_offset_at(pFrameIndex),
+			this->_u2.get_dynamic_offset_at(pFrameIndex)
+		});
 	if (get_instances_count())
 	{
 		auto _buffer_handle = this->_instances_buffer.get_buffer_handle();
@@ -411,7 +378,13 @@ W_RESULT model_mesh::draw(_In_ const w_command_buffer& pCommandBuffer)
 			&_buffer_handle, 
 			this->instnaces_transforms.size(), 
 			0, 
-			&this->indirect_draws);
+			&this->indirect_draws,
+			0,
+			-1,
+			0,
+			-1,
+			0,
+			this->indirect_draws.get_offset_at(pFrameIndex));
 	}
 	else
 	{
@@ -1003,7 +976,7 @@ W_RESULT model_mesh::_create_buffers()
 	}
 
 	//load indirect draws
-	if (this->indirect_draws.load(this->gDevice, _draw_counts) == W_FAILED)
+	if (this->indirect_draws.load(this->gDevice, _draw_counts, this->_number_of_frames) == W_FAILED)
 	{
 		V(W_FAILED, "loading indirect draws command buffer for model: " + this->model_name, _trace_info, 3);
 		return W_FAILED;
@@ -1230,8 +1203,11 @@ W_RESULT model_mesh::_create_cs_out_buffer()
 	auto _number_of_instances = static_cast<uint32_t>(this->instnaces_transforms.size());
 	if (!_number_of_instances) return W_PASSED;
 
-	//create buffer of compute stage output
-	auto _size = (uint32_t)sizeof(compute_stage_output);
+	//create buffer of compute stage output, dynamic offsets must be multiple of minStorageBufferOffsetAlignment
+	auto _alignment = static_cast<uint32_t>(std::max<VkDeviceSize>(1,
+		this->gDevice->device_info->device_properties->limits.minStorageBufferOffsetAlignment));
+	this->_cs_out_stride = ((uint32_t)sizeof(compute_stage_output) + _alignment - 1) / _alignment * _alignment;
+	auto _size = this->_cs_out_stride * this->_number_of_frames;
 	if (this->_cs_out_buffer.load(
 		this->gDevice,
 		_size,
@@ -1250,168 +1226,28 @@ W_RESULT model_mesh::_create_cs_out_buffer()
 	return W_PASSED;
 }
 
-W_RESULT model_mesh::_prepare_cs_path_uniform_based_on_local_size(
-	_Inout_ w_shader_binding_param& pShaderBindingParam,
-	_Inout_ std::wstring& pComputeShaderPath)
+W_RESULT model_mesh::_create_cs_uniform(_Inout_ w_shader_binding_param& pShaderBindingParam)
 {
-	const std::string _trace_info = this->_name + "::_prepare_compute_shader_based_on_batch_local_size";
+	const std::string _trace_info = this->_name + "::_create_cs_uniform";
 
-	auto _lod_level = this->lods_info.size() ? this->lods_info.size() - 1 : 0;
-	pComputeShaderPath = L"lod_" + std::to_wstring(_lod_level) + L"_local_size_x" + std::to_wstring(this->_cs.batch_local_size) + L".comp.spv";
-	
-	auto _hr = W_PASSED;
-	switch (this->_cs.batch_local_size)
+	if (this->_cs.batch_local_size > MAX_BATCH_LOCAL_SIZE)
 	{
-	default:
-		_hr = W_FAILED;
-		V(_hr, "batch_local_size " + std::to_string(this->_cs.batch_local_size) +
+		V(W_FAILED, "batch_local_size " + std::to_string(this->_cs.batch_local_size) +
 			" not supported for model: " + this->model_name, _trace_info);
-	case 1:
-		this->visibilities.resize(1);
-		this->_cs.unifrom_x1 = new w_uniform<compute_unifrom_x1>();
-		if (this->_cs.unifrom_x1->load(this->gDevice) == W_FAILED)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader uniform_x1 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x1->get_descriptor_info();
-		}
-		break;
-	case 2:
-		this->visibilities.resize(2);
-		this->_cs.unifrom_x2 = new w_uniform<compute_unifrom_x2>();
-		if (this->_cs.unifrom_x2->load(this->gDevice) == W_FAILED)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader unifrom_x2 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x2->get_descriptor_info();
-		}
-		break;
-	case 4:
-		this->visibilities.resize(4);
-		this->_cs.unifrom_x4 = new w_uniform<compute_unifrom_x4>();
-		if (this->_cs.unifrom_x4->load(this->gDevice) == W_FAILED)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader unifrom_x4 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x4->get_descriptor_info();
-		}
-		break;
-	case 8:
-		this->visibilities.resize(8);
-		this->_cs.unifrom_x8 = new w_uniform<compute_unifrom_x8>();
-		if (this->_cs.unifrom_x8->load(this->gDevice) == W_FAILED)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader unifrom_x8 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x8->get_descriptor_info();
-		}
-		break;
-	case 16:
-		this->visibilities.resize(16);
-		this->_cs.unifrom_x16 = new w_uniform<compute_unifrom_x16>();
-		if (this->_cs.unifrom_x16->load(this->gDevice) == W_FAILED)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader unifrom_x16 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x16->get_descriptor_info();
-		}
-		break;
-	case 32:
-		this->visibilities.resize(32);
-		this->_cs.unifrom_x32 = new w_uniform<compute_unifrom_x32>();
-		if (this->_cs.unifrom_x32->load(this->gDevice) == W_FAILED)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader unifrom_x32 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x32->get_descriptor_info();
-		}
-		break;
-	case 64:
-		this->visibilities.resize(64);
-		this->_cs.unifrom_x64 = new w_uniform<compute_unifrom_x64>();
-		if (this->_cs.unifrom_x64->load(this->gDevice) == W_FAILED)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader unifrom_x64 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x64->get_descriptor_info();
-		}
-		break;
-	case 128:
-		this->visibilities.resize(128);
-		this->_cs.unifrom_x128 = new w_uniform<compute_unifrom_x128>();
-		if (this->_cs.unifrom_x128->load(this->gDevice) == W_FAILED)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader uniform_x128 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x128->get_descriptor_info();
-		}
-		break;
-	case 256:
-		this->visibilities.resize(256);
-		this->_cs.unifrom_x256 = new w_uniform<compute_unifrom_x256>();
-		if (this->_cs.unifrom_x256->load(this->gDevice) == S_FALSE)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader uniform_x256 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x256->get_descriptor_info();
-		}
-		break;
-	case 512:
-		this->visibilities.resize(512);
-		this->_cs.unifrom_x512 = new w_uniform<compute_unifrom_x512>();
-		if (this->_cs.unifrom_x512->load(this->gDevice) == S_FALSE)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader uniform_x512 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x512->get_descriptor_info();
-		}
-		break;
-	case 1024:
-		this->visibilities.resize(1024);
-		this->_cs.unifrom_x1024 = new w_uniform<compute_unifrom_x1024>();
-		if (this->_cs.unifrom_x1024->load(this->gDevice) == S_FALSE)
-		{
-			_hr = W_FAILED;
-			V(_hr, "loading compute shader uniform_x512 for " + this->model_name, _trace_info);
-		}
-		else
-		{
-			pShaderBindingParam.buffer_info = this->_cs.unifrom_x1024->get_descriptor_info();
-		}
-		break;
+		return W_FAILED;
 	}
 
-	return _hr;
+	//one uniform for all batch sizes, compute shader only reads visibilities of its local size
+	this->visibilities.resize(this->_cs.batch_local_size);
+	this->_cs.unifrom = new w_uniform<compute_unifrom>();
+	if (this->_cs.unifrom->load(this->gDevice, true, this->_number_of_frames) == W_FAILED)
+	{
+		V(W_FAILED, "loading compute shader uniform for " + this->model_name, _trace_info);
+		return W_FAILED;
+	}
+	pShaderBindingParam.buffer_info = this->_cs.unifrom->get_descriptor_info();
+
+	return W_PASSED;
 }
 
 W_RESULT model_mesh::_create_shader_modules(
@@ -1426,13 +1262,13 @@ W_RESULT model_mesh::_create_shader_modules(
 
 	w_shader_binding_param _shader_param;
 	_shader_param.index = 0;
-	_shader_param.type = w_shader_binding_type::UNIFORM;
+	_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 	_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
 
 	//set U0 uniform of instance vertex shader, which has seperate structure for basic model or instanced models
 	if (this->instnaces_transforms.size())
 	{
-		_hr = this->_instance_u0.load(this->gDevice);
+		_hr = this->_instance_u0.load(this->gDevice, true, this->_number_of_frames);
 		if (_hr == W_FAILED)
 		{
 			V(W_FAILED, "loading vertex shader instance uniform for model: " + this->model_name, _trace_info, 3);
@@ -1442,7 +1278,7 @@ W_RESULT model_mesh::_create_shader_modules(
 	}
 	else
 	{
-		_hr = this->_basic_u0.load(this->gDevice);
+		_hr = this->_basic_u0.load(this->gDevice, true, this->_number_of_frames);
 		if (_hr == W_FAILED)
 		{
 			V(W_FAILED, "loading vertex shader basic uniform for model: " + this->model_name, _trace_info, 3);
@@ -1453,14 +1289,14 @@ W_RESULT model_mesh::_create_shader_modules(
 	_shader_params.push_back(_shader_param);
 
 	//The texture lod index
-	_hr = this->_u1.load(this->gDevice);
+	_hr = this->_u1.load(this->gDevice, true, this->_number_of_frames);
 	if (_hr == W_FAILED)
 	{
 		V(W_FAILED, "loading vertex shader uniform 1 for model: " + this->model_name, _trace_info, 3);
 		return W_FAILED;
 	}
 	_shader_param.index = 1;
-	_shader_param.type = w_shader_binding_type::UNIFORM;
+	_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 	_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
 	_shader_param.buffer_info = this->_u1.get_descriptor_info();
 	_shader_params.push_back(_shader_param);
@@ -1473,14 +1309,14 @@ W_RESULT model_mesh::_create_shader_modules(
 	_shader_params.push_back(_shader_param);
 
 	//the U1 uniform of fragment shader
-	_hr = this->_u2.load(this->gDevice);
+	_hr = this->_u2.load(this->gDevice, true, this->_number_of_frames);
 	if (_hr == W_FAILED)
 	{
 		V(W_FAILED, "loading fragment shader uniform 2 for model: " + this->model_name, _trace_info, 3);
 		return W_FAILED;
 	}
 	_shader_param.index = 3;
-	_shader_param.type = w_shader_binding_type::UNIFORM;
+	_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 	_shader_param.stage = w_shader_stage_flag_bits::FRAGMENT_SHADER;
 	_shader_param.buffer_info = this->_u2.get_descriptor_info();
 	_shader_params.push_back(_shader_param);
@@ -1495,28 +1331,30 @@ W_RESULT model_mesh::_create_shader_modules(
 		_shader_param.buffer_info = this->_cs.instances_buffer.get_descriptor_info();
 		_shader_params.push_back(_shader_param);
 
+		//indirect draws and output of compute shader have one region for each frame
 		_shader_param.index = 1;
-		_shader_param.type = w_shader_binding_type::STORAGE;
+		_shader_param.type = w_shader_binding_type::STORAGE_DYNAMIC;
 		_shader_param.stage = w_shader_stage_flag_bits::COMPUTE_SHADER;
 		_shader_param.buffer_info = this->indirect_draws.buffer.get_descriptor_info();
+		_shader_param.buffer_info.range = this->indirect_draws.frame_size;
 		_shader_params.push_back(_shader_param);
 
 		_shader_param.index = 2;
-		_shader_param.type = w_shader_binding_type::UNIFORM;
+		_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
 		_shader_param.stage = w_shader_stage_flag_bits::COMPUTE_SHADER;
 
-		std::wstring _compute_shader_path;
-		if (_prepare_cs_path_uniform_based_on_local_size(_shader_param, _compute_shader_path) == W_FAILED)
+		if (_create_cs_uniform(_shader_param) == W_FAILED)
 		{
-			V(W_FAILED, "getting compute shader uniform and filename path for model: " + this->model_name, _trace_info, 3);
+			V(W_FAILED, "creating compute shader uniform for model: " + this->model_name, _trace_info, 3);
 			return W_FAILED;
 		}
 		_shader_params.push_back(_shader_param);
 
 		_shader_param.index = 3;
-		_shader_param.type = w_shader_binding_type::STORAGE;
+		_shader_param.type = w_shader_binding_type::STORAGE_DYNAMIC;
 		_shader_param.stage = w_shader_stage_flag_bits::COMPUTE_SHADER;
 		_shader_param.buffer_info = this->_cs_out_buffer.get_descriptor_info();
+		_shader_param.buffer_info.range = sizeof(compute_stage_output);
 		_shader_params.push_back(_shader_param);
 
 		_shader_param.index = 4;
@@ -1528,13 +1366,13 @@ W_RESULT model_mesh::_create_shader_modules(
 		//load shaders
 		if (w_shader::load_shader(
 			this->gDevice,
-			"model_mesh_" + wolf::system::convert::wstring_to_string(_compute_shader_path),
+			"model_mesh_cull_lod",
 			pVertexShaderPath,
 			L"",
 			L"",
 			L"",
 			pFragmentShaderPath,
-			shared::scene_content_path + L"shaders/compute/" + _compute_shader_path,
+			wolf::content_path + L"shaders/compute/cull_lod.comp.spv",
 			_shader_params,
 			false,
 			&this->_shader) == W_FAILED)
@@ -1597,11 +1435,19 @@ W_RESULT model_mesh::_create_pipelines(
 	auto _number_of_instances = static_cast<uint32_t>(this->instnaces_transforms.size());
 	if (_number_of_instances)
 	{
-		if (this->_cs.pipeline.load_compute(
+		//local size and max lod level of cull_lod.comp are specialization constants
+		w_specialization_info _specialization_info;
+		_specialization_info.add(0, this->_cs.batch_local_size);
+		_specialization_info.add(1, static_cast<uint32_t>(std::min<size_t>(
+			this->lods_info.size() ? this->lods_info.size() - 1 : 0,
+			MAX_LOD_LEVEL)));
+
+		this->_cs.pipeline = w_pipeline::get_compute_pipeline_variant(
 			this->gDevice,
 			this->_shader,
-			5,
-			pComputePipelineCacheName) == W_FAILED)
+			_specialization_info,
+			pComputePipelineCacheName);
+		if (!this->_cs.pipeline)
 		{
 			V(W_FAILED, "loading computing pipeline for model: " + this->model_name, _trace_info, 3);
 			return W_FAILED;
@@ -1714,13 +1560,13 @@ w_semaphore* model_mesh::get_compute_semaphore()
 	return &(this->_cs.semaphore);
 }
 
-compute_stage_output model_mesh::get_result_of_compute_shader()
+compute_stage_output model_mesh::get_result_of_compute_shader(_In_ const uint32_t& pFrameIndex)
 {
-	// Get draw count from compute
+	// Get draw count from compute shader of a frame
 	auto _mapped = this->_cs_out_buffer.map();
-	if (_mapped)
+	if (_mapped && pFrameIndex < this->_number_of_frames)
 	{
-		memcpy(&this->_cs_out_struct, _mapped, sizeof(compute_stage_output));
+		memcpy(&this->_cs_out_struct, (uint8_t*)_mapped + pFrameIndex * this->_cs_out_stride, sizeof(compute_stage_output));
 	}
 	this->_cs_out_buffer.unmap();
 	_mapped = nullptr;
@@ -1734,17 +1580,10 @@ compute_stage_output model_mesh::get_result_of_compute_shader()
 
 void model_mesh::set_view_projection(_In_ const glm::mat4& pView, _In_ const glm::mat4& pProjection)
 {
-	const std::string _trace_info = this->_name + "::set_view_projection";
-
 	if (this->instnaces_transforms.size())
 	{
 		this->_instance_u0.data.view = pView;
 		this->_instance_u0.data.projection = pProjection;
-		auto _hr = this->_instance_u0.update();
-		if (_hr == W_FAILED)
-		{
-			V(W_FAILED, "updating instance uniform ViewProjection for model: " + this->model_name, _trace_info, 3);
-		}
 	}
 	else
 	{
@@ -1755,24 +1594,16 @@ void model_mesh::set_view_projection(_In_ const glm::mat4& pView, _In_ const glm
 		this->_basic_u0.data.model = glm::translate(_position) * glm::rotate(_rotation) * glm::scale(_scale);
 		this->_basic_u0.data.view = pView;
 		this->_basic_u0.data.projection = pProjection;
-		auto _hr = this->_basic_u0.update();
-		if (_hr == W_FAILED)
-		{
-			V(W_FAILED, "updating basic uniform ViewProjection for model: " + this->model_name, _trace_info, 3);
-		}
 	}
+	//uniforms will be copied to region of each frame in update_uniforms
+	std::fill(this->_update_frames.begin(), this->_update_frames.end(), true);
 }
 
 void model_mesh::set_enable_instances_colors(_In_ const bool& pEnable)
 {
-	const std::string _trace_info = this->_name + "::set_enable_instances_colors";
-
 	this->_u2.data.cmds = pEnable ? 1 : 0;
-	auto _hr = this->_u2.update();
-	if (_hr == W_FAILED)
-	{
-		V(W_FAILED, "updating uniform u2(cmds) for model: " + this->model_name, _trace_info, 3);
-	}
+	//uniforms will be copied to region of each frame in update_uniforms
+	std::fill(this->_update_frames.begin(), this->_update_frames.end(), true);
 }
 
 void model_mesh::set_global_visiblity(_In_ const bool& pValue)
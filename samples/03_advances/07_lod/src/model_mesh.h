@@ -45,17 +45,23 @@ public:
 		_In_z_ const std::string& pComputePipelineCacheName,
 		_In_z_ const std::wstring& pVertexShaderPath,
 		_In_z_ const std::wstring& pFragmentShaderPath,
-		_In_ const wolf::graphics::w_render_pass& pRenderPass
+		_In_ const wolf::graphics::w_render_pass& pRenderPass,
+		_In_ const uint32_t& pNumberOfFrames = 1
 	);
 
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//The following codes have been added for this project
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
-	W_RESULT submit_compute_shader(_In_ const glm::vec3 pCameraPosition);
+	//submit compute shader of a frame, previous submission of this frame must be completed by GPU
+	W_RESULT submit_compute_shader(_In_ const glm::vec3 pCameraPosition, _In_ const uint32_t& pFrameIndex);
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 
-	W_RESULT draw(_In_ const wolf::graphics::w_command_buffer& pCommandBuffer);
+	//copy uniforms to the region of a frame, previous submission of this frame must be completed by GPU
+	W_RESULT update_uniforms(_In_ const uint32_t& pFrameIndex);
+
+	//record drawing commands of a frame
+	W_RESULT draw(_In_ const wolf::graphics::w_command_buffer& pCommandBuffer, _In_ const uint32_t& pFrameIndex);
 
 	//release all resources
 	ULONG release() override;
@@ -76,7 +82,7 @@ public:
 	bool													get_global_visiblity() const;
 	bool													get_visiblity(_In_ const uint32_t& pModelInstanceIndex = 0) const;
 	wolf::graphics::w_semaphore*							get_compute_semaphore();
-	compute_stage_output									get_result_of_compute_shader();
+	compute_stage_output									get_result_of_compute_shader(_In_ const uint32_t& pFrameIndex);
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 
@@ -148,9 +154,7 @@ private:
 	W_RESULT	_create_instance_buffers();
 	W_RESULT	_create_lod_levels_buffer();
 	W_RESULT	_create_cs_out_buffer();
-	W_RESULT	_prepare_cs_path_uniform_based_on_local_size(
-		_Inout_ wolf::graphics::w_shader_binding_param& pShaderBindingParam,
-		_Inout_ std::wstring& pComputeShaderPath);
+	W_RESULT	_create_cs_uniform(_Inout_ wolf::graphics::w_shader_binding_param& pShaderBindingParam);
 	W_RESULT	_create_shader_modules(
 		_In_z_ const std::wstring& pVertexShaderPath,
 		_In_z_ const std::wstring& pFragmentShaderPath);
@@ -158,7 +162,7 @@ private:
 		_In_z_ const std::string& pPipelineCacheName,
 		_In_ const wolf::graphics::w_render_pass& pRenderPass);
 	
-	W_RESULT   _build_compute_command_buffer();
+	W_RESULT   _build_compute_command_buffers();
 	
 	typedef	 wolf::system::w_object							_super;
 
@@ -215,6 +219,13 @@ private:
 	bool													_show_only_lod;
 
 	uint32_t												_selected_lod_index;
+
+	//one region of uniforms, indirect draws and compute shader output for each frame in flight
+	uint32_t												_number_of_frames;
+	//distance between regions of compute shader output of two frames
+	uint32_t												_cs_out_stride;
+	//frames which their uniforms must be copied again
+	std::vector<bool>										_update_frames;
 };
 
 #endif
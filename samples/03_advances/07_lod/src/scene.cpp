@@ -141,7 +141,7 @@ void scene::load()
 	}
 
 	//fence for syncing
-	_hr = this->_draw_fence.initialize(_gDevice);
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -183,6 +183,8 @@ void scene::load()
 	//create two primary command buffers for clearing screen
 	auto _swap_chain_image_size = _output_window->swap_chain_image_views.size();
 	_hr = this->_draw_command_buffers.load(_gDevice, _swap_chain_image_size);
+	//all command buffers will be recorded in render
+	this->_rebuild_draw_command_buffers.assign(_swap_chain_image_size, true);
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -279,7 +281,8 @@ void scene::load()
 					_model_compute_pipeline_cache_name,
 					_vertex_shader_path,
 					_fragment_shader_path,
-					this->_draw_render_pass);
+					this->_draw_render_pass,
+					static_cast<uint32_t>(_swap_chain_image_size));
 				if (_hr == W_FAILED)
 				{
 					V(W_FAILED, "loading model: " + _m->get_name(), _trace_info, 2);
@@ -298,39 +301,35 @@ void scene::load()
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 }
 
-W_RESULT scene::_build_draw_command_buffers()
+W_RESULT scene::_build_draw_command_buffer(_In_ const uint32_t& pIndex)
 {
-	const std::string _trace_info = this->name + "::build_draw_command_buffers";
+	const std::string _trace_info = this->name + "::build_draw_command_buffer";
 	W_RESULT _hr = W_PASSED;
 
-	auto _size = this->_draw_command_buffers.get_commands_size();
-	for (uint32_t i = 0; i < _size; ++i)
+	this->_draw_command_buffers.begin(pIndex);
 	{
-		this->_draw_command_buffers.begin(i);
+		auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+		this->_draw_render_pass.begin(
+			pIndex,
+			_cmd,
+			w_color::CORNFLOWER_BLUE(),
+			1.0f,
+			0.0f);
 		{
-			auto _cmd = this->_draw_command_buffers.get_command_at(i);
-			this->_draw_render_pass.begin(
-				i,
-				_cmd,
-				w_color::CORNFLOWER_BLUE(),
-				1.0f,
-				0.0f);
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//The following codes have been added for this project
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//draw all models
+			for (auto _model : this->_models)
 			{
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				//The following codes have been added for this project
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				//draw all models
-				for (auto _model : this->_models)
-				{
-					_model->draw(_cmd);
-				}
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
-				//++++++++++++++++++++++++++++++++++++++++++++++++++++
+				_model->draw(_cmd, pIndex);
 			}
-			this->_draw_render_pass.end(_cmd);
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
 		}
-		this->_draw_command_buffers.end(i);
+		this->_draw_render_pass.end(_cmd);
 	}
+	this->_draw_command_buffers.end(pIndex);
 
 	return _hr;
 }
@@ -390,8 +389,6 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 	auto _output_window = &(_gDevice->output_presentation_window);
 	auto _frame_index = _output_window->swap_chain_image_index;
 
-	w_imgui::render();
-
 	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
 	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
 
@@ -401,22 +398,44 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		w_pipeline_stage_flag_bits::COMPUTE_SHADER_BIT,
 	};
 
-	//reset draw fence
 	std::vector<w_semaphore> _wait_semaphors = { _output_window->swap_chain_image_is_available_semaphore };
 
-	this->_draw_fence.reset();
-		
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
 	if (this->_rebuild_command_buffer)
 	{
+		this->_rebuild_command_buffer = false;
+		//command buffers will be recorded again after their previous submissions
+		std::fill(this->_rebuild_draw_command_buffers.begin(), this->_rebuild_draw_command_buffers.end(), true);
+	}
+
+	//uniforms of models for this swap chain image are not in use anymore
+	for (auto _model : this->_models)
+	{
+		if (_model && _model->update_uniforms(_frame_index) == W_FAILED)
+		{
+			V(W_FAILED, "updating uniforms of model: " + _model->get_model_name(), _trace_info, 3, false);
+		}
+	}
+
+	if (this->_rebuild_draw_command_buffers[_frame_index])
+	{
+		this->_rebuild_draw_command_buffers[_frame_index] = false;
+
 		auto _camera_pos = this->_first_camera.get_translate();
 
-		//submit compute shader for all visible models
+		//submit compute shader of this swap chain image for all visible models
 		std::for_each(this->_models.begin(), this->_models.end(),
 			[&](_In_ model* pModel)
 		{
 			if (pModel)
 			{
-				if (pModel->submit_compute_shader(_camera_pos) == W_PASSED)
+				if (pModel->submit_compute_shader(_camera_pos, _frame_index) == W_PASSED)
 				{
 					auto _semaphore = pModel->get_compute_semaphore();
 					if (_semaphore)
@@ -427,8 +446,10 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 			}
 		});
 
-		_build_draw_command_buffers();
-		this->_rebuild_command_buffer = false;
+		if (_build_draw_command_buffer(_frame_index) == W_FAILED)
+		{
+			V(W_FAILED, "building draw command buffer", _trace_info, 3, false);
+		}
 	}
 
 	if (_gDevice->submit(
@@ -437,11 +458,11 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		&_wait_dst_stage_mask[0], //destination masks
 		_wait_semaphors, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
 	}
-	this->_draw_fence.wait();
 
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//The following codes have been added for this project
@@ -450,7 +471,7 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 	{
 		if (_current_selected_model->get_instances_count())
 		{
-			auto _result = _current_selected_model->get_result_of_compute_shader();
+			auto _result = _current_selected_model->get_result_of_compute_shader(_frame_index);
 			logger.write(std::to_string(_result.draw_count));
 			logger.write(std::to_string(_result.lod_level[0]));
 			logger.write(std::to_string(_result.lod_level[1]));
@@ -63,7 +63,7 @@ private:
 		ImVec2	pos;
 	};
 
-	W_RESULT	_build_draw_command_buffers();
+	W_RESULT	_build_draw_command_buffer(_In_ const uint32_t& pIndex);
 	void		_show_floating_debug_window();
 	widget_info	_show_left_widget_controller();
 	widget_info	_show_search_widget(_In_ widget_info* pRelatedWidgetInfo);
@@ -74,6 +74,8 @@ private:
 	wolf::graphics::w_viewport_scissor                              _viewport_scissor;
 
 	wolf::graphics::w_command_buffers                               _draw_command_buffers;
+	//swap chain images which their command buffers must be recorded again before next submission
+	std::vector<bool>                                               _rebuild_draw_command_buffers;
 	wolf::graphics::w_render_pass                                   _draw_render_pass;
 
 	wolf::graphics::w_fences                                        _draw_fence;
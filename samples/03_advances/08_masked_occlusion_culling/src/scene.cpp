@@ -47,6 +47,7 @@ scene::scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring&
 	_show_all(true),
 	_show_lods(false),
 	_masked_occlusion_culling_debug_frame(nullptr),
+	_masked_occlusion_culling_debug_data(nullptr),
 	_show_moc_debug(false)
 {
 #ifdef __WIN32
@@ -121,29 +122,19 @@ void scene::load()
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//The following codes have been added for this project
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
-	this->_masked_occlusion_culling_debug_frame = new (std::nothrow) w_texture();
-	if (this->_masked_occlusion_culling_debug_frame)
-	{
-		if (this->_masked_occlusion_culling_debug_frame->initialize(
-			_gDevice,
-			_preferred_backbuffer_size.x,
-			_preferred_backbuffer_size.y,
-			false,
-			true) == W_PASSED)
-		{
-			if (this->_masked_occlusion_culling_debug_frame->load_texture_from_memory_all_channels_same(255) == W_FAILED)
-			{
-				V(W_FAILED, "loading texture for masked occlusion culling debug frame", _trace_info, 2);
-			}
-		}
-		else
-		{
-			V(W_FAILED, "initializing texture memory for masked occlusion culling debug frame", _trace_info, 2);
-		}
+	//debug frame is uploaded by command buffer of each swap chain image, so each image has its own staging slot
+	if (this->_masked_occlusion_culling_debug_frames.initialize(
+		_gDevice,
+		_preferred_backbuffer_size.x,
+		_preferred_backbuffer_size.y,
+		w_video_texture_format::VIDEO_TEXTURE_RGBA,
+		static_cast<uint32_t>(_output_window->swap_chain_image_views.size())) == W_PASSED)
+	{
+		this->_masked_occlusion_culling_debug_frame = this->_masked_occlusion_culling_debug_frames.get_texture();
 	}
 	else
 	{
-		V(W_FAILED, "allocating memory for texture of masked occlusion culling debug frame", _trace_info, 2);
+		V(W_FAILED, "initializing texture of masked occlusion culling debug frame", _trace_info, 2);
 	}
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -179,7 +170,7 @@ void scene::load()
 	}
 
 	//fence for syncing
-	_hr = this->_draw_fence.initialize(_gDevice);
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -227,6 +218,8 @@ void scene::load()
 	//create two primary command buffers for clearing screen
 	auto _swap_chain_image_size = _output_window->swap_chain_image_views.size();
 	_hr = this->_draw_command_buffers.load(_gDevice, _swap_chain_image_size);
+	//all command buffers will be recorded in render
+	this->_rebuild_draw_command_buffers.assign(_swap_chain_image_size, true);
 	if (_hr == W_FAILED)
 	{
 		release();
@@ -324,7 +317,8 @@ void scene::load()
 					_model_compute_pipeline_cache_name,
 					_vertex_shader_path,
 					_fragment_shader_path,
-					this->_draw_render_pass);
+					this->_draw_render_pass,
+					static_cast<uint32_t>(_swap_chain_image_size));
 				if (_hr == W_FAILED)
 				{
 					V(W_FAILED, "loading model: " + _m->get_name(), _trace_info, 2);
@@ -351,34 +345,58 @@ void scene::load()
 	}
 }
 
-W_RESULT scene::_build_draw_command_buffers()
+W_RESULT scene::_build_draw_command_buffer(_In_ const uint32_t& pIndex)
 {
-	const std::string _trace_info = this->name + "::build_draw_command_buffers";
+	const std::string _trace_info = this->name + "::build_draw_command_buffer";
 	W_RESULT _hr = W_PASSED;
 
-	auto _size = this->_draw_command_buffers.get_commands_size();
-	for (uint32_t i = 0; i < _size; ++i)
+	this->_draw_command_buffers.begin(pIndex);
 	{
-		this->_draw_command_buffers.begin(i);
+		auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+
+		//copy debug frame to slot of this swap chain image and upload it outside of render pass
+		if (this->_show_moc_debug && this->_masked_occlusion_culling_debug_data)
 		{
-			auto _cmd = this->_draw_command_buffers.get_command_at(i);
-			this->_draw_render_pass.begin(
-				i,
-				_cmd,
-				w_color::CORNFLOWER_BLUE(),
-				1.0f,
-				0.0f);
+			w_video_texture_staging_frame _staging;
+			if (this->_masked_occlusion_culling_debug_frames.get_staging_frame(pIndex, _staging) == W_PASSED)
 			{
-				//draw all models
-				for (auto _model : this->_drawable_models)
+				auto _width = this->_masked_occlusion_culling_debug_frames.get_width();
+				auto _height = this->_masked_occlusion_culling_debug_frames.get_height();
+				for (uint32_t _row = 0; _row < _height; ++_row)
 				{
-					_model->draw(_cmd);
+					std::memcpy(
+						_staging.planes[0] + _row * _staging.row_pitches[0],
+						this->_masked_occlusion_culling_debug_data + _row * _width * 4,
+						_width * 4);
 				}
+				_hr = this->_masked_occlusion_culling_debug_frames.record_upload(_cmd, pIndex);
+			}
+			else
+			{
+				_hr = W_FAILED;
+			}
+			if (_hr == W_FAILED)
+			{
+				V(W_FAILED, "uploading masked occlusion culling debug frame", _trace_info, 3, false);
 			}
-			this->_draw_render_pass.end(_cmd);
 		}
-		this->_draw_command_buffers.end(i);
+
+		this->_draw_render_pass.begin(
+			pIndex,
+			_cmd,
+			w_color::CORNFLOWER_BLUE(),
+			1.0f,
+			0.0f);
+		{
+			//draw all models
+			for (auto _model : this->_drawable_models)
+			{
+				_model->draw(_cmd, pIndex);
+			}
+		}
+		this->_draw_render_pass.end(_cmd);
 	}
+	this->_draw_command_buffers.end(pIndex);
 
 	return _hr;
 }
@@ -445,17 +463,9 @@ void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
 			});
 			this->_rebuild_command_buffer = true;
 
-			if (_show_moc_debug)
-			{
-				auto _moc_debug_depth_frame = this->_masked_occlusion_culling.get_debug_frame(true);
-				if (_moc_debug_depth_frame)
-				{
-					if (this->_masked_occlusion_culling_debug_frame->copy_data_to_texture_2D(_moc_debug_depth_frame) == W_FAILED)
-					{
-						V(W_FAILED, "copying data to texture of masked occlusion culling debug frame", _trace_info, 2);
-					}
-				}
-			}
+			//debug frame will be uploaded by command buffers after their previous submissions
+			this->_masked_occlusion_culling_debug_data = _show_moc_debug ?
+				this->_masked_occlusion_culling.get_debug_frame(true) : nullptr;
 		}
 		//this->_masked_occlusion_culling.suspend_threads();
 	}
@@ -476,8 +486,6 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 	auto _output_window = &(_gDevice->output_presentation_window);
 	auto _frame_index = _output_window->swap_chain_image_index;
 
-	w_imgui::render();
-
 	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
 	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
 
@@ -487,22 +495,44 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		w_pipeline_stage_flag_bits::COMPUTE_SHADER_BIT,
 	};
 
-	//reset draw fence
 	std::vector<w_semaphore> _wait_semaphors = { _output_window->swap_chain_image_is_available_semaphore };
 
-	this->_draw_fence.reset();
-		
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
 	if (this->_rebuild_command_buffer)
 	{
+		this->_rebuild_command_buffer = false;
+		//command buffers will be recorded again after their previous submissions
+		std::fill(this->_rebuild_draw_command_buffers.begin(), this->_rebuild_draw_command_buffers.end(), true);
+	}
+
+	//uniforms of models for this swap chain image are not in use anymore
+	for (auto _model : this->_drawable_models)
+	{
+		if (_model && _model->update_uniforms(_frame_index) == W_FAILED)
+		{
+			V(W_FAILED, "updating uniforms of model: " + _model->get_model_name(), _trace_info, 3, false);
+		}
+	}
+
+	if (this->_rebuild_draw_command_buffers[_frame_index])
+	{
+		this->_rebuild_draw_command_buffers[_frame_index] = false;
+
 		auto _camera_pos = this->_first_camera.get_translate();
 
-		//submit compute shader for all visible models
+		//submit compute shader of this swap chain image for all visible models
 		std::for_each(this->_drawable_models.begin(), this->_drawable_models.end(),
 			[&](_In_ model* pModel)
 		{
 			if (pModel)
 			{
-				if (pModel->submit_compute_shader(_camera_pos) == W_PASSED)
+				if (pModel->submit_compute_shader(_camera_pos, _frame_index) == W_PASSED)
 				{
 					auto _semaphore = pModel->get_compute_semaphore();
 					if (_semaphore)
@@ -513,8 +543,10 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 			}
 		});
 
-		_build_draw_command_buffers();
-		this->_rebuild_command_buffer = false;
+		if (_build_draw_command_buffer(_frame_index) == W_FAILED)
+		{
+			V(W_FAILED, "building draw command buffer", _trace_info, 3, false);
+		}
 	}
 
 	if (_gDevice->submit(
@@ -523,17 +555,17 @@ W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
 		&_wait_dst_stage_mask[0], //destination masks
 		_wait_semaphors, //wait semaphores
 		{ _output_window->rendering_done_semaphore }, //signal semaphores
-		&this->_draw_fence) == W_FAILED)
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
 	{
 		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
 	}
-	this->_draw_fence.wait();
 
 	/*if (_current_selected_model)
 	{
 		if (_current_selected_model->get_instances_count())
 		{
-			auto _result = _current_selected_model->get_result_of_compute_shader();
+			auto _result = _current_selected_model->get_result_of_compute_shader(_frame_index);
 			logger.write(std::to_string(_result.draw_count));
 			logger.write(std::to_string(_result.lod_level[0]));
 			logger.write(std::to_string(_result.lod_level[1]));
@@ -577,7 +609,8 @@ ULONG scene::release()
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 
 	this->_masked_occlusion_culling.release();
-	SAFE_DELETE(_masked_occlusion_culling_debug_frame);
+	this->_masked_occlusion_culling_debug_frame = nullptr;
+	this->_masked_occlusion_culling_debug_frames.release();
 
 	//release gui's resources
 	w_imgui::release();
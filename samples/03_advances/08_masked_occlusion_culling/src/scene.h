@@ -20,6 +20,7 @@
 #include <w_graphics/w_semaphore.h>
 #include <w_graphics/w_pipeline.h>
 #include <w_graphics/w_shader.h>
+#include <w_graphics/w_video_texture.h>
 #include <w_graphics/w_imgui.h>
 #include <w_framework/w_first_person_camera.h>
 #include "model.h"
@@ -70,7 +71,7 @@ private:
 		ImVec2	pos;
 	};
 
-	W_RESULT	_build_draw_command_buffers();
+	W_RESULT	_build_draw_command_buffer(_In_ const uint32_t& pIndex);
 	void		_show_floating_debug_window();
 	void		_show_floating_moc_debug_window();
 	widget_info	_show_left_widget_controller();
@@ -82,6 +83,8 @@ private:
 	wolf::graphics::w_viewport_scissor                              _viewport_scissor;
 
 	wolf::graphics::w_command_buffers                               _draw_command_buffers;
+	//swap chain images which their command buffers must be recorded again before next submission
+	std::vector<bool>                                               _rebuild_draw_command_buffers;
 	wolf::graphics::w_render_pass                                   _draw_render_pass;
 
 	wolf::graphics::w_fences                                        _draw_fence;
@@ -102,7 +105,10 @@ private:
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	bool															_show_moc_debug;
 	wolf::framework::w_masked_occlusion_culling						_masked_occlusion_culling;
+	//one staging slot of debug frame for each swap chain image, uploaded by command buffer of that image
+	wolf::graphics::w_video_texture									_masked_occlusion_culling_debug_frames;
 	wolf::graphics::w_texture*										_masked_occlusion_culling_debug_frame;
+	const uint8_t*													_masked_occlusion_culling_debug_data;
 	std::vector<model*>												_drawable_models;
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
 	//++++++++++++++++++++++++++++++++++++++++++++++++++++
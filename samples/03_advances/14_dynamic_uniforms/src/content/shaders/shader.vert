@@ -0,0 +1,27 @@
+#version 450
+
+layout(location = 0) in vec3 i_position;
+layout(location = 1) in vec2 i_uv;
+
+//per draw constants, this block is a sub allocation of w_uniform_ring which will be selected by dynamic offset
+layout(set=0, binding=0) uniform UBO 
+{
+	//xy is offset and zw is scale
+	vec4 transform;
+	vec4 diffuse_color;
+} u0;
+
+out gl_PerVertex
+{
+  vec4 gl_Position;
+};
+
+layout(location = 0) out vec2 o_uv;
+layout(location = 1) out vec4 o_diffuse_color;
+
+void main() 
+{
+    gl_Position = vec4(i_position.xy * u0.transform.zw + u0.transform.xy, 0.0, 1.0);
+    o_uv = i_uv;
+	o_diffuse_color = u0.diffuse_color;
+}
@@ -0,0 +1,518 @@
+#include "pch.h"
+#include "scene.h"
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::graphics;
+
+static uint32_t sFPS = 0;
+static float sElapsedTimeInSec = 0;
+static float sTotalTimeTimeInSec = 0;
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//draws are placed on a grid of sGridSize x sGridSize quads
+static const uint32_t sGridSize = 64;
+static const uint32_t sNumberOfDraws = sGridSize * sGridSize;
+//the biggest minUniformBufferOffsetAlignment which is allowed by specification
+static const uint32_t sMaxUniformAlignment = 256;
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+scene::scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring& pLogPath, _In_z_ const std::wstring& pAppName) :
+    w_game(pContentPath, pLogPath, pAppName),
+	_update_time_in_ms(0.0)
+{
+	w_graphics_device_manager_configs _config;
+	_config.debug_gpu = false;
+	w_game::set_graphics_device_manager_configs(_config);
+
+	w_game::set_fixed_time_step(false);
+}
+
+scene::~scene()
+{
+	//release all resources
+	release();
+}
+
+void scene::initialize(_In_ std::map<int, w_window_info> pOutputWindowsInfo)
+{
+	// TODO: Add your pre-initialization logic here
+	w_game::initialize(pOutputWindowsInfo);
+}
+
+void scene::load()
+{
+	defer(nullptr, [&](...)
+	{
+		w_game::load();
+	});
+
+	const std::string _trace_info = this->name + "::load";
+
+	auto _gDevice = this->graphics_devices[0];
+	auto _output_window = &(_gDevice->output_presentation_window);
+
+	w_point_t _screen_size;
+	_screen_size.x = _output_window->width;
+	_screen_size.y = _output_window->height;
+
+	//initialize viewport
+	this->_viewport.y = 0;
+	this->_viewport.width = static_cast<float>(_screen_size.x);
+	this->_viewport.height = static_cast<float>(_screen_size.y);
+	this->_viewport.minDepth = 0;
+	this->_viewport.maxDepth = 1;
+
+	//initialize scissor of viewport
+	this->_viewport_scissor.offset.x = 0;
+	this->_viewport_scissor.offset.y = 0;
+	this->_viewport_scissor.extent.width = _screen_size.x;
+	this->_viewport_scissor.extent.height = _screen_size.y;
+
+	//define color and depth as an attachments buffers for render pass
+	std::vector<std::vector<w_image_view>> _render_pass_attachments;
+	for (size_t i = 0; i < _output_window->swap_chain_image_views.size(); ++i)
+	{
+		_render_pass_attachments.push_back
+		(
+			//COLOR									   , DEPTH
+			{ _output_window->swap_chain_image_views[i], _output_window->depth_buffer_image_view }
+		);
+	}
+	//create render pass
+	auto _hr = this->_draw_render_pass.load(
+		_gDevice,
+		_viewport,
+		_viewport_scissor,
+		_render_pass_attachments);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating render pass", _trace_info, 3, true);
+	}
+
+	//create semaphore
+	_hr = this->_draw_semaphore.initialize(_gDevice);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw semaphore", _trace_info, 3, true);
+	}
+
+	//Fence for syncing
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw fence", _trace_info, 3, true);
+	}
+
+	//load imgui
+	w_imgui::load(
+		_gDevice,
+		_output_window,
+		this->_viewport,
+		this->_viewport_scissor,
+		nullptr);
+
+	//create one command buffer for each swap chain image
+	auto _swap_chain_image_size = _output_window->swap_chain_image_views.size();
+	_hr = this->_draw_command_buffers.load(_gDevice, _swap_chain_image_size);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw command buffers", _trace_info, 3, true);
+	}
+
+#ifdef WIN32
+	auto _content_path_dir = wolf::system::io::get_current_directoryW() + L"/../../../../samples/03_advances/14_dynamic_uniforms/src/content/";
+#elif defined(__APPLE__)
+	auto _content_path_dir = wolf::system::io::get_current_directoryW() + L"/../../../../../samples/03_advances/14_dynamic_uniforms/src/content/";
+#endif // WIN32
+
+	//loading vertex shaders
+	_hr = this->_shader.load(_gDevice,
+		_content_path_dir + L"shaders/shader.vert.spv",
+		w_shader_stage_flag_bits::VERTEX_SHADER);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading vertex shader", _trace_info, 3, true);
+	}
+
+	//loading fragment shader
+	_hr = this->_shader.load(_gDevice,
+		_content_path_dir + L"shaders/shader.frag.spv",
+		w_shader_stage_flag_bits::FRAGMENT_SHADER);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading fragment shader", _trace_info, 3, true);
+	}
+
+	//load texture
+	_hr = this->_texture.initialize(_gDevice);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading texture", _trace_info, 3, true);
+	}
+	//load texture from file
+	_hr = this->_texture.load_texture_2D_from_file(content_path + L"../Logo.jpg", true);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading Logo.jpg texture", _trace_info, 3, true);
+	}
+
+	//just we need vertex position color
+	this->_mesh.set_vertex_binding_attributes(w_vertex_declaration::VERTEX_POSITION_UV);
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//one region for each swap chain image, each draw uses one aligned block of region of its frame
+	_hr = this->_uniform_ring.load(
+		_gDevice,
+		sNumberOfDraws * sMaxUniformAlignment,
+		static_cast<uint32_t>(_swap_chain_image_size),
+		static_cast<uint32_t>(sizeof(per_draw_uniform)));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading uniform ring", _trace_info, 3, true);
+	}
+
+	std::vector<w_shader_binding_param> _shader_params;
+
+	//one descriptor for all draws, dynamic offset selects uniform of each draw
+	w_shader_binding_param _shader_param;
+	_shader_param.index = 0;
+	_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
+	_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
+	_shader_param.buffer_info = this->_uniform_ring.get_descriptor_info();
+	_shader_params.push_back(_shader_param);
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	_shader_param.index = 1;
+	_shader_param.type = w_shader_binding_type::SAMPLER2D;
+	_shader_param.stage = w_shader_stage_flag_bits::FRAGMENT_SHADER;
+	_shader_param.image_info = this->_texture.get_descriptor_info();
+	_shader_params.push_back(_shader_param);
+
+	_hr = this->_shader.set_shader_binding_params(_shader_params);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "setting shader binding param", _trace_info, 3, true);
+	}
+
+	//loading pipeline cache
+	std::string _pipeline_cache_name = "pipeline_cache";
+	if (w_pipeline::create_pipeline_cache(_gDevice, _pipeline_cache_name) == W_FAILED)
+	{
+		logger.error("could not create pipeline cache");
+		_pipeline_cache_name.clear();
+	}
+
+	_hr = this->_pipeline.load(_gDevice,
+		this->_mesh.get_vertex_binding_attributes(),
+		w_primitive_topology::TRIANGLE_LIST,
+		&this->_draw_render_pass,
+		&this->_shader,
+		{ this->_viewport },
+		{ this->_viewport_scissor },
+		_pipeline_cache_name);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating solid pipeline", _trace_info, 3, true);
+	}
+
+	std::vector<float> _vertex_data =
+	{
+		-0.7f, -0.7f,	0.0f,		//pos0
+		 0.0f,  0.0f,               //uv0
+		-0.7f,  0.7f,	0.0f,		//pos1
+		 0.0f,  1.0f,               //uv1
+		 0.7f,  0.7f,	0.0f,		//pos2
+		 1.0f,  1.0f,           	//uv2
+		 0.7f, -0.7f,	0.0f,		//pos3
+		 1.0f,  0.0f,               //uv3
+	};
+
+	std::vector<uint32_t> _index_data = { 0, 1, 3, 3, 1, 2 };
+
+	this->_mesh.set_texture(&this->_texture);
+	_hr = this->_mesh.load(_gDevice,
+		_vertex_data.data(),
+		static_cast<uint32_t>(_vertex_data.size() * sizeof(float)),
+		static_cast<uint32_t>(_vertex_data.size()),
+		_index_data.data(),
+		static_cast<uint32_t>(_index_data.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading mesh", _trace_info, 3, true);
+	}
+
+	_hr = _build_draw_command_buffers();
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "building draw command buffers", _trace_info, 3, true);
+	}
+}
+
+W_RESULT scene::_build_draw_command_buffers()
+{
+	const std::string _trace_info = this->name + "::build_draw_command_buffers";
+	W_RESULT _hr = W_PASSED;
+
+	auto _size = this->_draw_command_buffers.get_commands_size();
+	for (uint32_t i = 0; i < _size; ++i)
+	{
+		auto _cmd = this->_draw_command_buffers.get_command_at(i);
+		this->_draw_command_buffers.begin(i);
+		{
+			this->_draw_render_pass.begin(
+				i,
+				_cmd,
+				w_color::CORNFLOWER_BLUE(),
+				1.0f,
+				0);
+			{
+				//++++++++++++++++++++++++++++++++++++++++++++++++++++
+				//The following codes have been added for this project
+				//++++++++++++++++++++++++++++++++++++++++++++++++++++
+				//allocate blocks of this frame in the same order which render will use them
+				this->_uniform_ring.begin_frame(i);
+
+				uint32_t _dynamic_offset = 0;
+				for (uint32_t j = 0; j < sNumberOfDraws; ++j)
+				{
+					if (!this->_uniform_ring.allocate(static_cast<uint32_t>(sizeof(per_draw_uniform)), _dynamic_offset))
+					{
+						V(W_FAILED, "allocating per draw uniform", _trace_info, 3, false);
+						_hr = W_FAILED;
+						break;
+					}
+					//pipeline will be bound once and then only the dynamic offset changes
+					if (j == 0)
+					{
+						this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS, { _dynamic_offset });
+					}
+					else
+					{
+						this->_pipeline.bind_descriptor_set(_cmd, w_pipeline_bind_point::GRAPHICS, { _dynamic_offset });
+					}
+					this->_mesh.draw(_cmd, nullptr, 0);
+				}
+				//++++++++++++++++++++++++++++++++++++++++++++++++++++
+				//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			}
+			this->_draw_render_pass.end(_cmd);
+		}
+		this->_draw_command_buffers.end(i);
+	}
+	return _hr;
+}
+
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+W_RESULT scene::_update_per_draw_uniforms(_In_ const uint32_t& pFrameIndex)
+{
+	auto _start = std::chrono::high_resolution_clock::now();
+
+	//GPU finished the previous use of this region, so each draw only needs a memcpy
+	if (this->_uniform_ring.begin_frame(pFrameIndex) == W_FAILED) return W_FAILED;
+
+	const float _cell_size = 2.0f / static_cast<float>(sGridSize);
+	per_draw_uniform _uniform;
+	uint32_t _dynamic_offset = 0;
+	for (uint32_t i = 0; i < sNumberOfDraws; ++i)
+	{
+		auto _x = i % sGridSize;
+		auto _y = i / sGridSize;
+		auto _wave = 0.5f + 0.5f * std::sin(sTotalTimeTimeInSec * 2.0f + static_cast<float>(_x + _y) * 0.2f);
+
+		_uniform.transform = glm::vec4(
+			-1.0f + (static_cast<float>(_x) + 0.5f) * _cell_size,
+			-1.0f + (static_cast<float>(_y) + 0.5f) * _cell_size,
+			_cell_size * 0.5f * (0.5f + 0.5f * _wave),
+			_cell_size * 0.5f * (0.5f + 0.5f * _wave));
+		_uniform.diffuse_color = glm::vec4(_wave, static_cast<float>(_x) / sGridSize, static_cast<float>(_y) / sGridSize, 1.0f);
+
+		if (this->_uniform_ring.push(_uniform, _dynamic_offset) == W_FAILED) return W_FAILED;
+	}
+	auto _hr = this->_uniform_ring.flush();
+
+	this->_update_time_in_ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - _start).count();
+
+	return _hr;
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (w_game::exiting) return;
+	const std::string _trace_info = this->name + "::update";
+
+    sFPS = pGameTime.get_frames_per_second();
+    sElapsedTimeInSec = pGameTime.get_elapsed_seconds();
+    sTotalTimeTimeInSec = pGameTime.get_total_seconds();
+
+    w_imgui::new_frame(sElapsedTimeInSec, [this]()
+    {
+        _update_gui();
+    });
+
+	w_game::update(pGameTime);
+}
+
+W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (w_game::exiting) return W_PASSED;
+
+	const std::string _trace_info = this->name + "::render";
+
+	auto _gDevice = this->graphics_devices[0];
+	auto _output_window = &(_gDevice->output_presentation_window);
+	auto _frame_index = _output_window->swap_chain_image_index;
+
+	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
+	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
+
+	const uint32_t _wait_dst_stage_mask[] =
+	{
+		w_pipeline_stage_flag_bits::COLOR_ATTACHMENT_OUTPUT_BIT,
+	};
+
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//gui buffers of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//region of ring which belongs to this swap chain image is not in use anymore
+	if (_update_per_draw_uniforms(_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "updating per draw uniforms", _trace_info, 3, false);
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	if (_gDevice->submit(
+		{ &_draw_cmd, &_gui_cmd },//command buffers
+		_gDevice->vk_graphics_queue, //graphics queue
+		&_wait_dst_stage_mask[0], //destination masks
+		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
+		{ _output_window->rendering_done_semaphore }, //signal semaphores
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
+	}
+
+	return w_game::render(pGameTime);
+}
+
+void scene::on_window_resized(_In_ const uint32_t& pIndex, _In_ const w_point& pNewSizeOfWindow)
+{
+	w_game::on_window_resized(pIndex, pNewSizeOfWindow);
+}
+
+void scene::on_device_lost()
+{
+	w_game::on_device_lost();
+}
+
+ULONG scene::release()
+{
+    if (this->get_is_released()) return 1;
+
+    //release draw's objects
+	this->_draw_fence.release();
+	this->_draw_semaphore.release();
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	this->_uniform_ring.release();
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	this->_draw_command_buffers.release();
+	this->_draw_render_pass.release();
+
+    //release gui's objects
+    w_imgui::release();
+
+	this->_shader.release();
+
+    this->_pipeline.release();
+
+	this->_mesh.release();
+    this->_texture.release();
+
+	return w_game::release();
+}
+
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+bool scene::_update_gui()
+{
+    //Setting Style
+    ImGuiStyle& _style = ImGui::GetStyle();
+    _style.Colors[ImGuiCol_Text].x = 1.0f;
+    _style.Colors[ImGuiCol_Text].y = 1.0f;
+    _style.Colors[ImGuiCol_Text].z = 1.0f;
+    _style.Colors[ImGuiCol_Text].w = 1.0f;
+
+    _style.Colors[ImGuiCol_WindowBg].x = 0.0f;
+    _style.Colors[ImGuiCol_WindowBg].y = 0.4f;
+    _style.Colors[ImGuiCol_WindowBg].z = 1.0f;
+    _style.Colors[ImGuiCol_WindowBg].w = 1.0f;
+
+    ImGuiWindowFlags  _window_flags = 0;;
+    ImGui::SetNextWindowSize(ImVec2(400, 400), ImGuiSetCond_FirstUseEver);
+    bool _is_open = true;
+    if (!ImGui::Begin("Wolf.Engine", &_is_open, _window_flags))
+    {
+        ImGui::End();
+        return false;
+    }
+
+    ImGui::Text("Press Esc to exit\r\nFPS:%d\r\nFrameTime:%f\r\nTotalTime:%f\r\nMouse Position:%d,%d\r\n",
+        sFPS,
+        sElapsedTimeInSec,
+        sTotalTimeTimeInSec,
+        wolf::inputs_manager.mouse.pos_x, wolf::inputs_manager.mouse.pos_y);
+
+	auto _statistics = this->_uniform_ring.get_statistics();
+	ImGui::Text("Draws:%u\r\nAlignment:%u bytes\r\nUsed:%u of %u bytes\r\nUniforms update:%f ms\r\n",
+		_statistics.number_of_allocations,
+		_statistics.alignment,
+		_statistics.used_bytes,
+		_statistics.frame_size,
+		this->_update_time_in_ms);
+
+    ImGui::End();
+
+    return true;
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -0,0 +1,151 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample shows how to optimize meshes with portable mesh optimizer and benchmarks it on sponza
+	Comment          : Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#include "pch.h"
+#include <w_io.h>
+#include <w_content_manager.h>
+#include <w_mesh_optimizer.h>
+#include <chrono>
+#include <cstdio>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+typedef std::chrono::steady_clock w_clock;
+
+struct benchmark_mesh
+{
+	std::vector<w_vertex_struct>	vertices;
+	std::vector<uint32_t>			indices;
+};
+
+static void benchmark(
+	_In_z_ const std::string& pName,
+	_In_ const std::vector<benchmark_mesh>& pMeshes,
+	_In_ const w_mesh_optimizer_configs& pConfigs)
+{
+	const uint32_t _cache_size = 16;
+
+	double _misses = 0.0;
+	double _triangles = 0.0;
+	double _vertices = 0.0;
+	double _seconds = 0.0;
+
+	for (auto& _mesh : pMeshes)
+	{
+		//work on a copy, so each config starts from the same input
+		auto _vertices_data = _mesh.vertices;
+		auto _indices_data = _mesh.indices;
+
+		auto _start = w_clock::now();
+		if (w_mesh_optimizer::optimize(_vertices_data, _indices_data, pConfigs) == W_FAILED)
+		{
+			logger.error("could not optimize mesh with " + pName);
+			return;
+		}
+		_seconds += std::chrono::duration<double>(w_clock::now() - _start).count();
+
+		auto _triangles_count = static_cast<double>(_indices_data.size() / 3);
+		_misses += w_mesh_optimizer::compute_acmr(_indices_data, _vertices_data.size(), _cache_size) * _triangles_count;
+		_triangles += _triangles_count;
+		//welded vertices are all referenced by indices
+		_vertices += static_cast<double>(_vertices_data.size());
+	}
+
+	if (_triangles == 0.0) return;
+
+	char _buffer[256];
+	std::snprintf(_buffer, sizeof(_buffer), "%-32s ACMR: %6.3f ATVR: %6.3f time: %9.2f ms per million triangles",
+		pName.c_str(), _misses / _triangles, _misses / _vertices, _seconds * 1000.0 / (_triangles / 1000000.0));
+	logger.write(_buffer);
+}
+
+int main()
+{
+	//initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+	logger.initialize(L"18_mesh_optimizer", wolf::system::io::get_current_directoryW());
+
+	//set content path directory
+	auto _content_path_dir = wolf::system::io::get_current_directoryW();
+#ifdef WIN32
+	_content_path_dir += L"/../../../../content/";
+#elif defined(__APPLE__)
+	_content_path_dir += L"/../../../../../content/";
+#endif // WIN32
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//load welded meshes of sponza without any optimization
+	auto _scene = new w_cpipeline_scene();
+	collada::c_parser _parser;
+	auto _hr = _parser.parse_collada_from_file(
+		_content_path_dir + L"models/sponza/sponza.DAE",
+		_scene,
+		false,
+#ifdef __WIN32
+		false,
+#endif
+		false,
+		false);
+	if (_hr == W_FAILED)
+	{
+		logger.error("sponza not found");
+		SAFE_RELEASE(_scene);
+		logger.release();
+		return EXIT_FAILURE;
+	}
+
+	std::vector<benchmark_mesh> _meshes;
+	std::vector<w_cpipeline_model*> _models;
+	_scene->get_all_models(_models);
+	for (auto _model : _models)
+	{
+		std::vector<w_cpipeline_mesh*> _model_meshes;
+		_model->get_meshes(_model_meshes);
+		for (auto _mesh : _model_meshes)
+		{
+			benchmark_mesh _benchmark_mesh;
+			_benchmark_mesh.vertices = _mesh->vertices;
+			_benchmark_mesh.indices = _mesh->indices;
+			_meshes.push_back(_benchmark_mesh);
+		}
+	}
+	SAFE_RELEASE(_scene);
+
+	logger.write("benchmarking " + std::to_string(_meshes.size()) + " meshes of sponza with FIFO cache of 16 entries");
+
+	w_mesh_optimizer_configs _configs;
+	_configs.optimize_overdraw = false;
+	_configs.optimize_vertex_fetch = false;
+	benchmark("input", _meshes, _configs);
+
+	_configs.vertex_cache_optimizer = w_vertex_cache_optimizer::FORSYTH_VERTEX_CACHE_OPTIMIZING;
+	benchmark("forsyth", _meshes, _configs);
+
+	_configs.vertex_cache_optimizer = w_vertex_cache_optimizer::TIPSIFY_VERTEX_CACHE_OPTIMIZING;
+	benchmark("tipsify", _meshes, _configs);
+
+	_configs.optimize_overdraw = true;
+	benchmark("tipsify + overdraw", _meshes, _configs);
+
+	_configs.optimize_vertex_fetch = true;
+	benchmark("tipsify + overdraw + vertex fetch", _meshes, _configs);
+
+	_meshes.clear();
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	//release logger
+	logger.release();
+
+	return EXIT_SUCCESS;
+}
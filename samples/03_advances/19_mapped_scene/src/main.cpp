@@ -0,0 +1,212 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample shows how to convert collada file to memory mapped Wolf Scene Pack and compares loading time
+					   and peak memory of mapped scene with msgpack scene
+	Comment          : Peak memory of process never decreases, so run this sample with "mapped" or "msgpack" argument for measuring
+					   each path in its own process. Without any argument, mapped path will be measured first.
+					   Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#include "pch.h"
+#include <w_io.h>
+#include <w_content_manager.h>
+#include <w_mapped_scene.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#ifdef __WIN32
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+typedef std::chrono::steady_clock w_clock;
+
+//peak resident memory of process in mega bytes
+static double get_peak_memory_mb()
+{
+#ifdef __WIN32
+	PROCESS_MEMORY_COUNTERS _counters;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &_counters, sizeof(_counters)))
+	{
+		return static_cast<double>(_counters.PeakWorkingSetSize) / (1024.0 * 1024.0);
+	}
+	return 0.0;
+#else
+	struct rusage _usage;
+	if (getrusage(RUSAGE_SELF, &_usage) == 0)
+	{
+#ifdef __APPLE__
+		//bytes on OSX
+		return static_cast<double>(_usage.ru_maxrss) / (1024.0 * 1024.0);
+#else
+		//kilo bytes on linux
+		return static_cast<double>(_usage.ru_maxrss) / 1024.0;
+#endif
+	}
+	return 0.0;
+#endif
+}
+
+//sum of all indices, makes sure all pages of vertices and indices have been touched
+static uint64_t touch_mesh(_In_ const w_vertex_struct* pVertices, _In_ const size_t& pVerticesCount,
+	_In_ const uint32_t* pIndices, _In_ const size_t& pIndicesCount)
+{
+	uint64_t _sum = 0;
+	for (size_t i = 0; i < pIndicesCount; ++i)
+	{
+		_sum += pIndices[i];
+	}
+	for (size_t i = 0; i < pVerticesCount; ++i)
+	{
+		_sum += pVertices[i].vertex_index;
+	}
+	return _sum;
+}
+
+static void report(_In_z_ const char* pName, _In_ const double& pSeconds, _In_ const uint64_t& pSum)
+{
+	printf("%-8s load time: %9.3f ms peak memory: %9.2f MB checksum: %llu\r\n",
+		pName, pSeconds * 1000.0, get_peak_memory_mb(), static_cast<unsigned long long>(pSum));
+}
+
+static bool load_mapped(_In_z_ const std::wstring& pPath)
+{
+	auto _start = w_clock::now();
+
+	w_mapped_scene _mapped_scene;
+	if (_mapped_scene.load(pPath) == W_FAILED)
+	{
+		printf("could not load mapped scene\r\n");
+		return false;
+	}
+
+	//vertices and indices are accessed in place, they could be copied to staging buffers directly
+	uint64_t _sum = 0;
+	w_mapped_mesh _mesh;
+	for (size_t i = 0; i < _mapped_scene.get_meshes_count(); ++i)
+	{
+		if (_mapped_scene.get_mesh(i, _mesh) == W_PASSED)
+		{
+			_sum += touch_mesh(_mesh.vertices, _mesh.vertices_count, _mesh.indices, _mesh.indices_count);
+		}
+	}
+	auto _seconds = std::chrono::duration<double>(w_clock::now() - _start).count();
+
+	report("mapped", _seconds, _sum);
+	_mapped_scene.release();
+
+	return true;
+}
+
+static bool load_msgpack(_In_z_ const std::wstring& pPath)
+{
+	auto _start = w_clock::now();
+
+	std::vector<w_cpipeline_scene> _scenes;
+	if (w_content_manager::load_wolf_scenes_from_file(_scenes, pPath) == W_FAILED)
+	{
+		printf("could not load msgpack scene\r\n");
+		return false;
+	}
+
+	uint64_t _sum = 0;
+	for (auto& _scene : _scenes)
+	{
+		std::vector<w_cpipeline_model*> _models;
+		_scene.get_all_models(_models);
+
+		std::vector<w_cpipeline_mesh*> _meshes;
+		for (auto _model : _models)
+		{
+			_model->get_meshes(_meshes);
+		}
+		for (auto _mesh : _meshes)
+		{
+			_sum += touch_mesh(_mesh->vertices.data(), _mesh->vertices.size(), _mesh->indices.data(), _mesh->indices.size());
+		}
+	}
+	auto _seconds = std::chrono::duration<double>(w_clock::now() - _start).count();
+
+	report("msgpack", _seconds, _sum);
+	for (auto& _scene : _scenes)
+	{
+		_scene.release();
+	}
+	_scenes.clear();
+
+	return true;
+}
+
+int main(int pArgc, char** pArgv)
+{
+	//set content path directory
+	auto _content_path_dir = wolf::system::io::get_current_directoryW();
+#ifdef WIN32
+	_content_path_dir += L"/../../../../content/";
+#elif defined(__APPLE__)
+	_content_path_dir += L"/../../../../../content/";
+#endif // WIN32
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	auto _model_dir = _content_path_dir + L"models/sponza/";
+	auto _msgpack_path = _model_dir + L"sponza.wscene";
+	auto _mapped_path = _model_dir + L"sponza_mapped.wscene";
+
+	const char* _mode = pArgc > 1 ? pArgv[1] : nullptr;
+	if (!_mode)
+	{
+		//convert collada model to both formats
+		auto _scene = w_content_manager::load<w_cpipeline_scene>(_model_dir + L"sponza.DAE");
+		if (!_scene)
+		{
+			printf("scene not found\r\n");
+			w_content_manager::release();
+			return EXIT_FAILURE;
+		}
+
+		std::vector<w_cpipeline_scene> _scene_packs = { *_scene };
+		_scene->release();
+
+		if (w_content_manager::save_wolf_scenes_to_file(_scene_packs, _msgpack_path) == W_FAILED ||
+			w_content_manager::save_mapped_wolf_scenes_to_file(_scene_packs, _mapped_path) == W_FAILED)
+		{
+			printf("error on converting\r\n");
+			w_content_manager::release();
+			return EXIT_FAILURE;
+		}
+		for (auto& _pack : _scene_packs)
+		{
+			_pack.release();
+		}
+		_scene_packs.clear();
+		printf("scene converted\r\n");
+	}
+
+	auto _succeeded = true;
+	if (!_mode || std::strcmp(_mode, "mapped") == 0)
+	{
+		_succeeded &= load_mapped(_mapped_path);
+	}
+	if (!_mode || std::strcmp(_mode, "msgpack") == 0)
+	{
+		_succeeded &= load_msgpack(_msgpack_path);
+	}
+	w_content_manager::release();
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	return _succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
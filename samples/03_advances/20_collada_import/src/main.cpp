@@ -0,0 +1,292 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample benchmarks importing large collada files, numbers of float_array and p elements are parsed
+					   with both find_all_numbers_then_convert_to and parse_all_numbers_then_convert_to, then the whole file is imported
+					   with 1 to N threads
+	Comment          : Pass path of a collada file as argument, otherwise tiles of a grid will be generated.
+					   Pass numbers for changing quads per side of each tile and number of tiles, default is 256 and 16.
+					   Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#include "pch.h"
+#include <w_io.h>
+#include <w_content_manager.h>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <algorithm>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+typedef std::chrono::steady_clock w_clock;
+
+//write tiles of a grid with positions, normals and uvs to a collada file, each tile is a geometry with its own node
+static bool generate_grid(_In_z_ const std::string& pPath, _In_ const uint32_t& pQuads, _In_ const uint32_t& pTiles)
+{
+	std::ofstream _file(pPath, std::ios::out | std::ios::binary);
+	if (!_file) return false;
+
+	const uint32_t _side = pQuads + 1;
+	const uint32_t _vertices_count = _side * _side;
+	const uint32_t _triangles_count = pQuads * pQuads * 2;
+
+	_file << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+		"<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\" version=\"1.4.1\">\n"
+		"  <asset><up_axis>Y_UP</up_axis></asset>\n"
+		"  <library_geometries>\n";
+
+	char _buffer[128];
+	uint32_t _tile = 0;
+	auto _write_source = [&](_In_z_ const char* pName, _In_ const uint32_t& pStride, _In_ const int& pType)
+	{
+		_file << "        <source id=\"geom-grid" << _tile << "-" << pName << "\">\n"
+			<< "          <float_array id=\"geom-grid" << _tile << "-" << pName << "-array\" count=\"" << _vertices_count * pStride << "\">";
+		for (uint32_t y = 0; y < _side; ++y)
+		{
+			for (uint32_t x = 0; x < _side; ++x)
+			{
+				auto _u = static_cast<float>(x) / static_cast<float>(pQuads);
+				auto _v = static_cast<float>(y) / static_cast<float>(pQuads);
+				if (pType == 0)
+				{
+					std::snprintf(_buffer, sizeof(_buffer), "%.6f %.6f %.6f ", _u * 100.0f - 50.0f + _tile * 100.0f, std::sin(_u * 20.0f) * std::cos(_v * 20.0f), _v * 100.0f - 50.0f);
+				}
+				else if (pType == 1)
+				{
+					std::snprintf(_buffer, sizeof(_buffer), "0 1 0 ");
+				}
+				else
+				{
+					std::snprintf(_buffer, sizeof(_buffer), "%.6f %.6f ", _u, _v);
+				}
+				_file << _buffer;
+			}
+			_file << "\n";
+		}
+		_file << "</float_array>\n"
+			<< "          <technique_common>\n"
+			<< "            <accessor source=\"#geom-grid" << _tile << "-" << pName << "-array\" count=\"" << _vertices_count << "\" stride=\"" << pStride << "\"/>\n"
+			<< "          </technique_common>\n"
+			<< "        </source>\n";
+	};
+	for (_tile = 0; _tile < pTiles; ++_tile)
+	{
+		_file << "    <geometry id=\"geom-grid" << _tile << "\" name=\"grid" << _tile << "\">\n"
+			"      <mesh>\n";
+
+		_write_source("positions", 3, 0);
+		_write_source("normals", 3, 1);
+		_write_source("map1", 2, 2);
+
+		_file << "        <vertices id=\"geom-grid" << _tile << "-vertices\">\n"
+			"          <input semantic=\"POSITION\" source=\"#geom-grid" << _tile << "-positions\"/>\n"
+			"        </vertices>\n"
+			"        <triangles material=\"grid_material\" count=\"" << _triangles_count << "\">\n"
+			"          <input semantic=\"VERTEX\" source=\"#geom-grid" << _tile << "-vertices\" offset=\"0\"/>\n"
+			"          <input semantic=\"NORMAL\" source=\"#geom-grid" << _tile << "-normals\" offset=\"1\"/>\n"
+			"          <input semantic=\"TEXCOORD\" source=\"#geom-grid" << _tile << "-map1\" offset=\"2\" set=\"0\"/>\n"
+			"          <p>";
+		for (uint32_t y = 0; y < pQuads; ++y)
+		{
+			for (uint32_t x = 0; x < pQuads; ++x)
+			{
+				uint32_t _i0 = y * _side + x;
+				uint32_t _i1 = _i0 + 1;
+				uint32_t _i2 = _i0 + _side;
+				uint32_t _i3 = _i2 + 1;
+				std::snprintf(_buffer, sizeof(_buffer), "%u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u %u ",
+					_i0, _i0, _i0, _i2, _i2, _i2, _i1, _i1, _i1,
+					_i1, _i1, _i1, _i2, _i2, _i2, _i3, _i3, _i3);
+				_file << _buffer;
+			}
+			_file << "\n";
+		}
+		_file << "</p>\n"
+			"        </triangles>\n"
+			"      </mesh>\n"
+			"    </geometry>\n";
+	}
+	_file << "  </library_geometries>\n"
+		"  <library_visual_scenes>\n"
+		"    <visual_scene id=\"scene\">\n";
+	for (_tile = 0; _tile < pTiles; ++_tile)
+	{
+		_file << "      <node id=\"node-grid" << _tile << "\" name=\"grid" << _tile << "\">\n"
+			"        <instance_geometry url=\"#geom-grid" << _tile << "\"/>\n"
+			"      </node>\n";
+	}
+	_file << "    </visual_scene>\n"
+		"  </library_visual_scenes>\n"
+		"  <scene>\n"
+		"    <instance_visual_scene url=\"#scene\"/>\n"
+		"  </scene>\n"
+		"</COLLADA>\n";
+
+	_file.flush();
+	return !_file.fail();
+}
+
+//collect text of all elements with the given tag
+static void collect_elements(_In_z_ const std::string& pContent, _In_z_ const std::string& pTag, _Inout_ std::vector<std::string>& pTexts)
+{
+	auto _open = "<" + pTag;
+	auto _close = "</" + pTag + ">";
+	size_t _pos = 0;
+	while ((_pos = pContent.find(_open, _pos)) != std::string::npos)
+	{
+		auto _begin = pContent.find('>', _pos);
+		if (_begin == std::string::npos) break;
+		auto _end = pContent.find(_close, _begin);
+		if (_end == std::string::npos) break;
+
+		pTexts.push_back(pContent.substr(_begin + 1, _end - _begin - 1));
+		_pos = _end + _close.size();
+	}
+}
+
+template<class T>
+static void benchmark_parsers(_In_z_ const char* pName, _In_ const std::vector<std::string>& pTexts)
+{
+	size_t _bytes = 0;
+	for (auto& _text : pTexts)
+	{
+		_bytes += _text.size();
+	}
+	if (!_bytes) return;
+
+	size_t _old_count = 0, _new_count = 0;
+
+	auto _start = w_clock::now();
+	for (auto& _text : pTexts)
+	{
+		std::vector<T> _numbers;
+		wolf::system::convert::find_all_numbers_then_convert_to<T>(_text, _numbers);
+		_old_count += _numbers.size();
+	}
+	auto _old_seconds = std::chrono::duration<double>(w_clock::now() - _start).count();
+
+	_start = w_clock::now();
+	for (auto& _text : pTexts)
+	{
+		std::vector<T> _numbers;
+		wolf::system::convert::parse_all_numbers_then_convert_to<T>(_text.data(), _text.size(), _numbers);
+		_new_count += _numbers.size();
+	}
+	auto _new_seconds = std::chrono::duration<double>(w_clock::now() - _start).count();
+
+	auto _mb = static_cast<double>(_bytes) / (1024.0 * 1024.0);
+	printf("%-12s %9.2f MB find_all_numbers: %9.2f ms (%7.1f MB/s, %zu numbers) parse_all_numbers: %9.2f ms (%7.1f MB/s, %zu numbers)\r\n",
+		pName, _mb,
+		_old_seconds * 1000.0, _mb / _old_seconds, _old_count,
+		_new_seconds * 1000.0, _mb / _new_seconds, _new_count);
+}
+
+int main(int pArgc, char** pArgv)
+{
+	//initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+	logger.initialize(L"20_collada_import", wolf::system::io::get_current_directoryW());
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	std::string _path;
+	if (pArgc > 1 && !std::isdigit(static_cast<unsigned char>(pArgv[1][0])))
+	{
+		_path = pArgv[1];
+	}
+	else
+	{
+		uint32_t _quads = pArgc > 1 ? static_cast<uint32_t>(std::atoi(pArgv[1])) : 256;
+		if (_quads == 0) _quads = 256;
+		uint32_t _tiles = pArgc > 2 ? static_cast<uint32_t>(std::atoi(pArgv[2])) : 16;
+		if (_tiles == 0) _tiles = 16;
+
+		_path = wolf::system::convert::wstring_to_string(wolf::system::io::get_current_directoryW()) + "/collada_import_benchmark.DAE";
+		printf("generating %u tiles of grid with %u quads per side\r\n", _tiles, _quads);
+		if (!generate_grid(_path, _quads, _tiles))
+		{
+			printf("could not generate collada file\r\n");
+			logger.release();
+			return EXIT_FAILURE;
+		}
+	}
+
+	std::string _content;
+	{
+		std::ifstream _file(_path, std::ios::in | std::ios::binary);
+		if (!_file)
+		{
+			printf("could not open collada file\r\n");
+			logger.release();
+			return EXIT_FAILURE;
+		}
+		std::stringstream _stream;
+		_stream << _file.rdbuf();
+		_content = _stream.str();
+	}
+	printf("collada file: %s (%.2f MB)\r\n", _path.c_str(), static_cast<double>(_content.size()) / (1024.0 * 1024.0));
+
+	//benchmark number parsers
+	std::vector<std::string> _texts;
+	collect_elements(_content, "float_array", _texts);
+	benchmark_parsers<float>("float_array", _texts);
+
+	_texts.clear();
+	collect_elements(_content, "p", _texts);
+	benchmark_parsers<uint32_t>("p", _texts);
+
+	_texts.clear();
+	_content.clear();
+	_content.shrink_to_fit();
+
+	//benchmark whole import without mesh optimizing, models are built in parallel and added to scene in order of nodes
+	W_RESULT _hr = W_PASSED;
+	size_t _threads = std::max(std::thread::hardware_concurrency(), 1u);
+	for (size_t _number_of_threads = 1; _number_of_threads <= _threads && _hr == W_PASSED; ++_number_of_threads)
+	{
+		auto _scene = new w_cpipeline_scene();
+		collada::c_parser _parser;
+		_parser.set_number_of_threads(_number_of_threads);
+
+		auto _start = w_clock::now();
+		_hr = _parser.parse_collada_from_file(
+			wolf::system::convert::string_to_wstring(_path),
+			_scene,
+			false,
+#ifdef __WIN32
+			false,
+#endif
+			false,
+			false);
+		auto _seconds = std::chrono::duration<double>(w_clock::now() - _start).count();
+
+		if (_hr == W_PASSED)
+		{
+			std::vector<w_cpipeline_model*> _models;
+			_scene->get_all_models(_models);
+			printf("imported %zu models with %2zu threads in %9.2f ms\r\n", _models.size(), _number_of_threads, _seconds * 1000.0);
+		}
+		else
+		{
+			printf("could not import collada file\r\n");
+		}
+		SAFE_RELEASE(_scene);
+	}
+	w_content_manager::release();
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	logger.release();
+
+	return _hr == W_PASSED ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,167 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample shows how to load scenes with w_async_loader while frames are running, and compares
+					   the longest frame of loading scenes synchronously with the longest frame of loading them asynchronously
+	Comment          : Pass number of scenes as argument, default is 16. The last request will be canceled
+					   Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#include "pch.h"
+#include <w_io.h>
+#include <w_content_manager.h>
+#include <w_async_loader.h>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+typedef std::chrono::steady_clock w_clock;
+
+//target of each frame in milliseconds
+static const double FRAME_TIME = 16.6;
+//time budget of completion functions in each frame in milliseconds
+static const double COMPLETION_BUDGET = 2.0;
+
+static double elapsed_ms(_In_ const w_clock::time_point& pStart)
+{
+	return std::chrono::duration<double, std::milli>(w_clock::now() - pStart).count();
+}
+
+//simulate rest of frame, returns time of frame
+static double end_frame(_In_ const w_clock::time_point& pStart)
+{
+	auto _elapsed = elapsed_ms(pStart);
+	if (_elapsed < FRAME_TIME)
+	{
+		std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(FRAME_TIME - _elapsed));
+	}
+	return elapsed_ms(pStart);
+}
+
+static void release_scene(_Inout_ w_cpipeline_scene* pScene)
+{
+	SAFE_RELEASE(pScene);
+}
+
+static void load_sync(_In_ const std::vector<std::wstring>& pPaths)
+{
+	size_t _loaded = 0;
+	auto _frame_start = w_clock::now();
+	for (auto& _path : pPaths)
+	{
+		auto _scene = w_content_manager::load<w_cpipeline_scene>(_path);
+		if (_scene)
+		{
+			_loaded++;
+			release_scene(_scene);
+		}
+	}
+	auto _frame_time = end_frame(_frame_start);
+
+	printf("sync   loaded %zu scenes, frames: %4d longest frame: %9.2f ms\r\n", _loaded, 1, _frame_time);
+}
+
+static void load_async(_In_ const std::vector<std::wstring>& pPaths)
+{
+	w_async_loader _loader;
+	_loader.allocate();
+
+	size_t _loaded = 0;
+	auto _on_loaded = [&_loaded](_In_ const W_RESULT& pResult, _In_ w_cpipeline_scene* pScene)
+	{
+		if (pResult == W_PASSED)
+		{
+			_loaded++;
+		}
+		release_scene(pScene);
+	};
+
+	//the first scene has the highest priority
+	std::vector<std::shared_ptr<w_async_load_request>> _requests;
+	for (size_t i = 0; i < pPaths.size(); ++i)
+	{
+		auto _priority = i == 0 ? 1 : 0;
+		_requests.push_back(w_content_manager::load_async<w_cpipeline_scene>(_loader, pPaths[i], _priority, _on_loaded));
+	}
+	if (_requests.size() > 1 && _requests.back())
+	{
+		_requests.back()->cancel();
+	}
+
+	int _frames = 0;
+	double _longest_frame = 0;
+	while (true)
+	{
+		auto _frame_start = w_clock::now();
+		_loader.update(COMPLETION_BUDGET);
+
+		auto _frame_time = end_frame(_frame_start);
+		if (_frame_time > _longest_frame)
+		{
+			_longest_frame = _frame_time;
+		}
+		_frames++;
+
+		bool _done = true;
+		for (auto& _request : _requests)
+		{
+			if (_request && !_request->get_is_done())
+			{
+				_done = false;
+				break;
+			}
+		}
+		if (_done) break;
+	}
+
+	auto _stats = _loader.get_statistics();
+	printf("async  loaded %zu scenes, frames: %4d longest frame: %9.2f ms threads: %zu completed: %zu failed: %zu canceled: %zu longest update: %.2f ms\r\n",
+		_loaded, _frames, _longest_frame, _stats.number_of_threads, _stats.completed, _stats.failed, _stats.canceled,
+		_stats.max_update_time_in_milliseconds);
+
+	_loader.release();
+}
+
+int main(int pArgc, char** pArgv)
+{
+	//set content path directory
+	auto _content_path_dir = wolf::system::io::get_current_directoryW();
+#ifdef WIN32
+	_content_path_dir += L"/../../../../content/";
+#elif defined(__APPLE__)
+	_content_path_dir += L"/../../../../../content/";
+#endif // WIN32
+
+	//initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+	logger.initialize(L"21_async_loading", wolf::system::io::get_current_directoryW());
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	size_t _number_of_scenes = pArgc > 1 ? static_cast<size_t>(std::atoi(pArgv[1])) : 16;
+	if (_number_of_scenes == 0) _number_of_scenes = 16;
+
+	std::vector<std::wstring> _paths;
+	for (size_t i = 0; i < _number_of_scenes; ++i)
+	{
+		_paths.push_back(_content_path_dir + (i % 2 ? L"models/camera.DAE" : L"models/model.DAE"));
+	}
+
+	load_sync(_paths);
+	load_async(_paths);
+
+	w_content_manager::release();
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	logger.release();
+
+	return EXIT_SUCCESS;
+}
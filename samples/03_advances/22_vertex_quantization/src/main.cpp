@@ -0,0 +1,190 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample shows how to quantize vertices of collada models to packed vertex formats,
+					   reports bytes per vertex and quantization errors of each model and stores quantized vertices in wolf scene files
+	Comment          : Pass paths of collada files as arguments, otherwise models of content folder will be used.
+					   Each model will be written to a memory mapped wolf scene file next to it and will be verified after loading.
+					   Quantized vertices can be rendered with VERTEX_QUANTIZED_POSITION_NORMAL_UV_TANGENT_COLOR_BLEND_WEIGHT_BLEND_INDICES,
+					   see content/shaders/quantized_model.vert
+					   Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#include "pch.h"
+#include <w_io.h>
+#include <w_content_manager.h>
+#include <w_vertex_quantizer.h>
+#include <cstdio>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+static void print_report(_In_z_ const std::string& pName, _In_ const w_vertex_quantization_report& pReport)
+{
+	auto _source_bytes = static_cast<double>(pReport.source_bytes_per_vertex) * pReport.vertices_count;
+	auto _quantized_bytes = static_cast<double>(pReport.quantized_bytes_per_vertex) * pReport.vertices_count;
+
+	printf("%-24s vertices: %8zu bytes/vertex: %3u -> %3u (%7.2f KB -> %7.2f KB)\r\n",
+		pName.c_str(), pReport.vertices_count,
+		pReport.source_bytes_per_vertex, pReport.quantized_bytes_per_vertex,
+		_source_bytes / 1024.0, _quantized_bytes / 1024.0);
+	printf("%-24s position max: %.6f avg: %.6f normal max: %.4f deg avg: %.4f deg uv max: %.6f tangent max: %.4f deg color max: %.4f blend weight max: %.4f\r\n",
+		"", pReport.max_position_error, pReport.average_position_error,
+		pReport.max_normal_error_in_degrees, pReport.average_normal_error_in_degrees,
+		pReport.max_uv_error, pReport.max_tangent_error_in_degrees,
+		pReport.max_color_error, pReport.max_blend_weight_error);
+}
+
+//all meshes of scenes, including meshes of lods and convex hulls
+static void get_all_meshes(_In_ std::vector<w_cpipeline_scene>& pScenes, _Inout_ std::vector<w_cpipeline_mesh*>& pMeshes)
+{
+	for (auto& _scene : pScenes)
+	{
+		std::vector<w_cpipeline_model*> _models;
+		_scene.get_all_models(_models);
+		while (!_models.empty())
+		{
+			auto _model = _models.back();
+			_models.pop_back();
+
+			_model->get_meshes(pMeshes);
+			_model->get_lods(_models);
+			_model->get_convex_hulls(_models);
+		}
+	}
+}
+
+//write quantized scenes to wolf scene file, then load it and compare the quantized vertices
+static bool save_and_verify(_In_ std::vector<w_cpipeline_scene>& pScenes, _In_z_ const std::wstring& pPath)
+{
+	if (w_content_manager::save_mapped_wolf_scenes_to_file(pScenes, pPath) == W_FAILED)
+	{
+		printf("could not write %s\r\n", wolf::system::convert::wstring_to_string(pPath).c_str());
+		return false;
+	}
+
+	std::vector<w_cpipeline_scene> _loaded_scenes;
+	if (w_content_manager::load_wolf_scenes_from_file(_loaded_scenes, pPath) == W_FAILED)
+	{
+		printf("could not load %s\r\n", wolf::system::convert::wstring_to_string(pPath).c_str());
+		return false;
+	}
+
+	std::vector<w_cpipeline_mesh*> _meshes, _loaded_meshes;
+	get_all_meshes(pScenes, _meshes);
+	get_all_meshes(_loaded_scenes, _loaded_meshes);
+
+	auto _succeeded = _meshes.size() == _loaded_meshes.size();
+	for (size_t i = 0; _succeeded && i < _meshes.size(); ++i)
+	{
+		const auto& _quantized = _meshes[i]->quantized;
+		const auto& _loaded = _loaded_meshes[i]->quantized;
+		_succeeded = _quantized.vertices.size() == _loaded.vertices.size() &&
+			std::memcmp(_quantized.position_scale, _loaded.position_scale, sizeof(_quantized.position_scale)) == 0 &&
+			std::memcmp(_quantized.position_offset, _loaded.position_offset, sizeof(_quantized.position_offset)) == 0 &&
+			(_quantized.vertices.empty() ||
+				std::memcmp(_quantized.vertices.data(), _loaded.vertices.data(), _quantized.vertices.size() * sizeof(w_quantized_vertex_struct)) == 0);
+	}
+	for (auto& _scene : _loaded_scenes)
+	{
+		_scene.release();
+	}
+
+	printf("%-24s %s\r\n", "wolf scene", _succeeded ? "quantized vertices have been verified" : "quantized vertices do not match");
+	return _succeeded;
+}
+
+static bool quantize_scene(_In_z_ const std::wstring& pPath, _Inout_ w_vertex_quantization_report& pTotalReport)
+{
+	auto _scene = w_content_manager::load<w_cpipeline_scene>(pPath);
+	if (!_scene)
+	{
+		printf("could not load %s\r\n", wolf::system::convert::wstring_to_string(pPath).c_str());
+		return false;
+	}
+
+	auto _succeeded = true;
+
+	std::vector<w_cpipeline_model*> _models;
+	_scene->get_all_models(_models);
+	for (auto _model : _models)
+	{
+		//each mesh has its own scale and offset of positions
+		w_vertex_quantization_report _model_report;
+		if (_model->quantize_meshes(&_model_report) == W_FAILED)
+		{
+			printf("could not quantize meshes of %s\r\n", _model->get_name().c_str());
+			_succeeded = false;
+			continue;
+		}
+		if (_model_report.vertices_count)
+		{
+			print_report(_model->get_name(), _model_report);
+			pTotalReport.merge(_model_report);
+		}
+	}
+
+	//the quantized vertices will be stored in wolf scene
+	std::vector<w_cpipeline_scene> _scenes;
+	_scenes.push_back(std::move(*_scene));
+	SAFE_RELEASE(_scene);
+
+	_succeeded &= save_and_verify(_scenes, pPath + L".wscene");
+	for (auto& _s : _scenes)
+	{
+		_s.release();
+	}
+
+	return _succeeded;
+}
+
+int main(int pArgc, char** pArgv)
+{
+	//set content path directory
+	auto _content_path_dir = wolf::system::io::get_current_directoryW();
+#ifdef WIN32
+	_content_path_dir += L"/../../../../content/";
+#elif defined(__APPLE__)
+	_content_path_dir += L"/../../../../../content/";
+#endif // WIN32
+
+	//initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+	logger.initialize(L"22_vertex_quantization", wolf::system::io::get_current_directoryW());
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	std::vector<std::wstring> _paths;
+	for (int i = 1; i < pArgc; ++i)
+	{
+		_paths.push_back(wolf::system::convert::string_to_wstring(pArgv[i]));
+	}
+	if (_paths.empty())
+	{
+		_paths.push_back(_content_path_dir + L"models/model.DAE");
+		_paths.push_back(_content_path_dir + L"models/camera.DAE");
+	}
+
+	auto _succeeded = true;
+	w_vertex_quantization_report _total_report;
+	for (auto& _path : _paths)
+	{
+		_succeeded &= quantize_scene(_path, _total_report);
+	}
+	if (_total_report.vertices_count)
+	{
+		print_report("total", _total_report);
+	}
+
+	w_content_manager::release();
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	logger.release();
+
+	return _succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
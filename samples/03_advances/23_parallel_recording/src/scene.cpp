@@ -0,0 +1,579 @@
+#include "pch.h"
+#include "scene.h"
+#include <chrono>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::graphics;
+
+static uint32_t sFPS = 0;
+static float sElapsedTimeInSec = 0;
+static float sTotalTimeTimeInSec = 0;
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//number of draw calls of each frame
+static const size_t sNumberOfDraws = 16384;
+//number of recordings for each number of threads in benchmark
+static const int sBenchmarkIterations = 10;
+static bool sRebuildCommandBuffers = true;
+static bool sRunBenchmark = false;
+static int sNumberOfThreads = 0;
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+scene::scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring& pLogPath, _In_z_ const std::wstring& pAppName) :
+    w_game(pContentPath, pLogPath, pAppName)
+{
+	w_graphics_device_manager_configs _config;
+	_config.debug_gpu = false;
+	w_game::set_graphics_device_manager_configs(_config);
+
+	w_game::set_fixed_time_step(false);
+}
+
+scene::~scene()
+{
+	//release all resources
+	release();
+}
+
+void scene::initialize(_In_ std::map<int, w_window_info> pOutputWindowsInfo)
+{
+	// TODO: Add your pre-initialization logic here
+	w_game::initialize(pOutputWindowsInfo);
+}
+
+void scene::load()
+{
+	defer(nullptr, [&](...)
+	{
+		w_game::load();
+	});
+
+	const std::string _trace_info = this->name + "::load";
+
+	auto _gDevice = this->graphics_devices[0];
+	auto _output_window = &(_gDevice->output_presentation_window);
+
+	w_point_t _screen_size;
+	_screen_size.x = _output_window->width;
+	_screen_size.y = _output_window->height;
+
+	//initialize viewport
+	this->_viewport.y = 0;
+	this->_viewport.width = static_cast<float>(_screen_size.x);
+	this->_viewport.height = static_cast<float>(_screen_size.y);
+	this->_viewport.minDepth = 0;
+	this->_viewport.maxDepth = 1;
+
+	//initialize scissor of viewport
+	this->_viewport_scissor.offset.x = 0;
+	this->_viewport_scissor.offset.y = 0;
+	this->_viewport_scissor.extent.width = _screen_size.x;
+	this->_viewport_scissor.extent.height = _screen_size.y;
+
+	//define color and depth as an attachments buffers for render pass
+	std::vector<std::vector<w_image_view>> _render_pass_attachments;
+	for (size_t i = 0; i < _output_window->swap_chain_image_views.size(); ++i)
+	{
+		_render_pass_attachments.push_back
+		(
+			//COLOR									   , DEPTH
+			{ _output_window->swap_chain_image_views[i], _output_window->depth_buffer_image_view }
+		);
+	}
+	//create render pass
+	auto _hr = this->_draw_render_pass.load(
+		_gDevice,
+		_viewport,
+		_viewport_scissor,
+		_render_pass_attachments);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating render pass", _trace_info, 3, true);
+	}
+
+	//create semaphore
+	_hr = this->_draw_semaphore.initialize(_gDevice);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw semaphore", _trace_info, 3, true);
+	}
+
+	//Fence for syncing
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw fence", _trace_info, 3, true);
+	}
+
+	//load imgui
+	w_imgui::load(
+		_gDevice,
+		_output_window,
+		this->_viewport,
+		this->_viewport_scissor,
+		nullptr);
+
+	//create primary command buffers, they only execute secondary command buffers
+	auto _swap_chain_image_size = _output_window->swap_chain_image_views.size();
+	_hr = this->_draw_command_buffers.load(_gDevice, _swap_chain_image_size);
+	//all command buffers will be recorded in render
+	this->_rebuild_draw_command_buffers.assign(_swap_chain_image_size, true);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw command buffers", _trace_info, 3, true);
+	}
+
+#ifdef WIN32
+	auto _content_path_dir = wolf::system::io::get_current_directoryW() + L"/../../../../samples/03_advances/23_parallel_recording/src/content/";
+#elif defined(__APPLE__)
+	auto _content_path_dir = wolf::system::io::get_current_directoryW() + L"/../../../../../samples/03_advances/23_parallel_recording/src/content/";
+#endif // WIN32
+
+	//loading vertex shaders
+	_hr = this->_shader.load(_gDevice,
+		_content_path_dir + L"shaders/shader.vert.spv",
+		w_shader_stage_flag_bits::VERTEX_SHADER);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading vertex shader", _trace_info, 3, true);
+	}
+
+	//loading fragment shader
+	_hr = this->_shader.load(_gDevice,
+		_content_path_dir + L"shaders/shader.frag.spv",
+		w_shader_stage_flag_bits::FRAGMENT_SHADER);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading fragment shader", _trace_info, 3, true);
+	}
+
+	//load texture
+	_hr = this->_texture.initialize(_gDevice);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading texture", _trace_info, 3, true);
+	}
+	//load texture from file
+	_hr = this->_texture.load_texture_2D_from_file(content_path + L"../Logo.jpg", true);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading Logo.jpg texture", _trace_info, 3, true);
+	}
+
+	//just we need vertex position color
+	this->_mesh.set_vertex_binding_attributes(w_vertex_declaration::VERTEX_POSITION_UV);
+
+	w_shader_binding_param _shader_param;
+	_shader_param.index = 0;
+	_shader_param.type = w_shader_binding_type::SAMPLER2D;
+	_shader_param.stage = w_shader_stage_flag_bits::FRAGMENT_SHADER;
+	_shader_param.image_info = this->_texture.get_descriptor_info();
+
+	_hr = this->_shader.set_shader_binding_params(
+		{
+			_shader_param
+		});
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "setting shader binding param", _trace_info, 3, true);
+	}
+
+	//loading pipeline cache
+	std::string _pipeline_cache_name = "pipeline_cache";
+	if (w_pipeline::create_pipeline_cache(_gDevice, _pipeline_cache_name) == W_FAILED)
+	{
+		logger.error("could not create pipeline cache");
+		_pipeline_cache_name.clear();
+	}
+
+	w_push_constant_range _push_constants_buffer_range;
+	_push_constants_buffer_range.offset = 0;
+	_push_constants_buffer_range.size = static_cast<uint32_t>(4 * sizeof(float));
+	_push_constants_buffer_range.stageFlags = w_shader_stage_flag_bits::VERTEX_SHADER;
+
+	_hr = this->_pipeline.load(_gDevice,
+		this->_mesh.get_vertex_binding_attributes(),
+		w_primitive_topology::TRIANGLE_LIST,
+		&this->_draw_render_pass,
+		&this->_shader,
+		{ this->_viewport },
+		{ this->_viewport_scissor },
+		"pipeline_cache",
+		{},
+		{ _push_constants_buffer_range });
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating solid pipeline", _trace_info, 3, true);
+	}
+
+	std::vector<float> _vertex_data =
+	{
+		-0.7f, -0.7f,	0.0f,		//pos0
+		 0.0f,  0.0f,               //uv0
+		-0.7f,  0.7f,	0.0f,		//pos1
+		 0.0f,  1.0f,               //uv1
+		 0.7f,  0.7f,	0.0f,		//pos2
+		 1.0f,  1.0f,           	//uv2
+		 0.7f, -0.7f,	0.0f,		//pos3
+		 1.0f,  0.0f,               //uv3
+	};
+
+	std::vector<uint32_t> _index_data = { 0, 1, 3, 3, 1, 2 };
+
+	this->_mesh.set_texture(&this->_texture);
+	_hr = this->_mesh.load(_gDevice,
+		_vertex_data.data(),
+		static_cast<uint32_t>(_vertex_data.size() * sizeof(float)),
+		static_cast<uint32_t>(_vertex_data.size()),
+		_index_data.data(),
+		static_cast<uint32_t>(_index_data.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading mesh", _trace_info, 3, true);
+	}
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//all of hardware threads, this thread will be the worker 0
+	_hr = this->_job_system.allocate();
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "allocating job system", _trace_info, 3, true);
+	}
+
+	//each swap chain image has its own command pools for each worker
+	_hr = this->_parallel_command_buffers.load(
+		_gDevice,
+		&this->_job_system,
+		static_cast<uint32_t>(_swap_chain_image_size));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading parallel command buffers", _trace_info, 3, true);
+	}
+
+	//each draw fades from black to white
+	this->_colors.resize(sNumberOfDraws);
+	for (size_t i = 0; i < sNumberOfDraws; ++i)
+	{
+		auto _c = static_cast<float>(i) / static_cast<float>(sNumberOfDraws - 1);
+		this->_colors[i] = glm::vec4(_c, _c, _c, 1.0f);
+	}
+
+	sNumberOfThreads = static_cast<int>(this->_parallel_command_buffers.get_number_of_workers());
+	_run_benchmark(0);
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+}
+
+W_RESULT scene::_build_draw_command_buffer(_In_ const uint32_t& pIndex)
+{
+	const std::string _trace_info = this->name + "::build_draw_command_buffer";
+	W_RESULT _hr = W_PASSED;
+
+	auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+	this->_draw_command_buffers.begin(pIndex);
+	{
+		this->_draw_render_pass.begin(
+			pIndex,
+			_cmd,
+			w_color::CORNFLOWER_BLUE(),
+			1.0f,
+			0,
+			VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+		{
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//The following codes have been added for this project
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//each thread records one partition of draws into a secondary command buffer
+			_hr = this->_parallel_command_buffers.record(
+				pIndex,
+				_cmd,
+				this->_draw_render_pass,
+				pIndex,
+				sNumberOfDraws,
+				[this](_In_ const w_command_buffer& pCommandBuffer, _In_ const size_t& pBegin, _In_ const size_t& pEnd)
+				{
+					return _record_draws(pCommandBuffer, pBegin, pEnd);
+				},
+				static_cast<size_t>(sNumberOfThreads));
+			if (_hr == W_FAILED)
+			{
+				V(W_FAILED, "recording draws in parallel", _trace_info, 3, false);
+			}
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		}
+		this->_draw_render_pass.end(_cmd);
+	}
+	this->_draw_command_buffers.end(pIndex);
+
+	return _hr;
+}
+
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+W_RESULT scene::_record_draws(
+	_In_ const w_command_buffer& pCommandBuffer,
+	_In_ const size_t& pBegin,
+	_In_ const size_t& pEnd)
+{
+	this->_pipeline.bind(pCommandBuffer, w_pipeline_bind_point::GRAPHICS);
+	for (auto i = pBegin; i < pEnd; ++i)
+	{
+		this->_pipeline.set_push_constant_buffer(
+			pCommandBuffer,
+			w_shader_stage_flag_bits::VERTEX_SHADER,
+			0,
+			static_cast<uint32_t>(4 * sizeof(float)),
+			&this->_colors[i][0]);
+		if (this->_mesh.draw(pCommandBuffer, nullptr, 0) == W_FAILED) return W_FAILED;
+	}
+	return W_PASSED;
+}
+
+void scene::_run_benchmark(_In_ const uint32_t& pIndex)
+{
+	//GPU does not use command buffer of this swap chain image, so record it several times with 1..N threads
+	auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+	auto _number_of_workers = this->_parallel_command_buffers.get_number_of_workers();
+
+	this->_benchmark_results.clear();
+	for (size_t _threads = 1; _threads <= _number_of_workers; ++_threads)
+	{
+		double _total_time_in_ms = 0.0;
+		for (int i = 0; i < sBenchmarkIterations; ++i)
+		{
+			auto _start = std::chrono::high_resolution_clock::now();
+
+			this->_draw_command_buffers.begin(pIndex);
+			this->_draw_render_pass.begin(pIndex, _cmd, w_color::CORNFLOWER_BLUE(), 1.0f, 0, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+			this->_parallel_command_buffers.record(
+				pIndex,
+				_cmd,
+				this->_draw_render_pass,
+				pIndex,
+				sNumberOfDraws,
+				[this](_In_ const w_command_buffer& pCommandBuffer, _In_ const size_t& pBegin, _In_ const size_t& pEnd)
+				{
+					return _record_draws(pCommandBuffer, pBegin, pEnd);
+				},
+				_threads);
+			this->_draw_render_pass.end(_cmd);
+			this->_draw_command_buffers.end(pIndex);
+
+			_total_time_in_ms += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - _start).count();
+		}
+		auto _average = _total_time_in_ms / sBenchmarkIterations;
+		this->_benchmark_results.push_back(_average);
+
+		logger.write("recording " + std::to_string(sNumberOfDraws) + " draws with " + std::to_string(_threads) +
+			" thread(s) took " + std::to_string(_average) + " ms, speedup: " + std::to_string(this->_benchmark_results[0] / _average));
+	}
+	sRebuildCommandBuffers = true;
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (w_game::exiting) return;
+	const std::string _trace_info = this->name + "::update";
+
+    sFPS = pGameTime.get_frames_per_second();
+    sElapsedTimeInSec = pGameTime.get_elapsed_seconds();
+    sTotalTimeTimeInSec = pGameTime.get_total_seconds();
+
+    w_imgui::new_frame(sElapsedTimeInSec, [this]()
+    {
+        _update_gui();
+    });
+
+	w_game::update(pGameTime);
+}
+
+W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (w_game::exiting) return W_PASSED;
+
+	const std::string _trace_info = this->name + "::render";
+
+	auto _gDevice = this->graphics_devices[0];
+	auto _output_window = &(_gDevice->output_presentation_window);
+	auto _frame_index = _output_window->swap_chain_image_index;
+
+	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
+	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
+
+	const uint32_t _wait_dst_stage_mask[] =
+	{
+		w_pipeline_stage_flag_bits::COLOR_ATTACHMENT_OUTPUT_BIT,
+	};
+
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//command pools of this swap chain image are not in use anymore
+	if (sRunBenchmark)
+	{
+		_run_benchmark(_frame_index);
+		sRunBenchmark = false;
+	}
+	if (sRebuildCommandBuffers)
+	{
+		sRebuildCommandBuffers = false;
+		//command buffers will be recorded again after their previous submissions
+		std::fill(this->_rebuild_draw_command_buffers.begin(), this->_rebuild_draw_command_buffers.end(), true);
+	}
+
+	//command buffer of this swap chain image is not in use anymore, so record it again if it has been invalidated
+	if (this->_rebuild_draw_command_buffers[_frame_index])
+	{
+		this->_rebuild_draw_command_buffers[_frame_index] = false;
+		if (_build_draw_command_buffer(_frame_index) == W_FAILED)
+		{
+			V(W_FAILED, "building draw command buffer", _trace_info, 3, false);
+		}
+	}
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
+	if (_gDevice->submit(
+		{ &_draw_cmd, &_gui_cmd },//command buffers
+		_gDevice->vk_graphics_queue, //graphics queue
+		&_wait_dst_stage_mask[0], //destination masks
+		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
+		{ _output_window->rendering_done_semaphore }, //signal semaphores
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
+	}
+
+	return w_game::render(pGameTime);
+}
+
+void scene::on_window_resized(_In_ const uint32_t& pIndex, _In_ const w_point& pNewSizeOfWindow)
+{
+	w_game::on_window_resized(pIndex, pNewSizeOfWindow);
+}
+
+void scene::on_device_lost()
+{
+	w_game::on_device_lost();
+}
+
+ULONG scene::release()
+{
+    if (this->get_is_released()) return 1;
+
+    //release draw's objects
+	this->_draw_fence.release();
+	this->_draw_semaphore.release();
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	this->_parallel_command_buffers.release();
+	this->_job_system.release();
+	this->_colors.clear();
+	this->_benchmark_results.clear();
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	this->_draw_command_buffers.release();
+	this->_draw_render_pass.release();
+
+    //release gui's objects
+    w_imgui::release();
+
+	this->_shader.release();
+
+    this->_pipeline.release();
+
+	this->_mesh.release();
+    this->_texture.release();
+
+	return w_game::release();
+}
+
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+bool scene::_update_gui()
+{
+    //Setting Style
+    ImGuiStyle& _style = ImGui::GetStyle();
+    _style.Colors[ImGuiCol_Text].x = 1.0f;
+    _style.Colors[ImGuiCol_Text].y = 1.0f;
+    _style.Colors[ImGuiCol_Text].z = 1.0f;
+    _style.Colors[ImGuiCol_Text].w = 1.0f;
+
+    _style.Colors[ImGuiCol_WindowBg].x = 0.0f;
+    _style.Colors[ImGuiCol_WindowBg].y = 0.4f;
+    _style.Colors[ImGuiCol_WindowBg].z = 1.0f;
+    _style.Colors[ImGuiCol_WindowBg].w = 1.0f;
+
+    ImGuiWindowFlags  _window_flags = 0;;
+    ImGui::SetNextWindowSize(ImVec2(400, 400), ImGuiSetCond_FirstUseEver);
+    bool _is_open = true;
+    if (!ImGui::Begin("Wolf.Engine", &_is_open, _window_flags))
+    {
+        ImGui::End();
+        return false;
+    }
+
+    ImGui::Text("Press Esc to exit\r\nFPS:%d\r\nFrameTime:%f\r\nTotalTime:%f\r\nMouse Position:%d,%d\r\n",
+        sFPS,
+        sElapsedTimeInSec,
+        sTotalTimeTimeInSec,
+        wolf::inputs_manager.mouse.pos_x, wolf::inputs_manager.mouse.pos_y);
+
+	auto _statistics = this->_parallel_command_buffers.get_statistics();
+	ImGui::Text("Draws:%zu\r\nPartitions:%zu\r\nSecondary command buffers:%zu\r\nLast recording:%f ms\r\n",
+		sNumberOfDraws,
+		_statistics.number_of_partitions,
+		_statistics.number_of_secondary_command_buffers,
+		_statistics.recording_time_in_ms);
+
+	if (ImGui::SliderInt("Threads", &sNumberOfThreads, 1, static_cast<int>(_statistics.number_of_workers)))
+	{
+		sRebuildCommandBuffers = true;
+	}
+
+	for (size_t i = 0; i < this->_benchmark_results.size(); ++i)
+	{
+		ImGui::Text("%zu thread(s): %f ms, speedup: %f", i + 1, this->_benchmark_results[i],
+			this->_benchmark_results[0] / this->_benchmark_results[i]);
+	}
+	if (ImGui::Button("Run benchmark"))
+	{
+		sRunBenchmark = true;
+	}
+
+    ImGui::End();
+
+    return true;
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
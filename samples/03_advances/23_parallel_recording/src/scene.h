@@ -0,0 +1,99 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : scene.h
+	Description		 : The main scene of Wolf Engine
+	Comment          : Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __SCENE_H__
+#define __SCENE_H__
+
+#include <w_framework/w_game.h>
+#include <w_graphics/w_command_buffers.h>
+#include <w_graphics/w_parallel_command_buffers.h>
+#include <w_graphics/w_render_pass.h>
+#include <w_graphics/w_semaphore.h>
+#include <w_graphics/w_shader.h>
+#include <w_graphics/w_pipeline.h>
+#include <w_graphics/w_mesh.h>
+#include <w_graphics/w_texture.h>
+#include <w_graphics/w_imgui.h>
+#include <w_job_system.h>
+
+class scene : public wolf::framework::w_game
+{
+public:
+	scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring& pLogPath, _In_z_ const std::wstring& pAppName);
+	virtual ~scene();
+
+	/*
+        Allows the game to perform any initialization and it needs to before starting to run.
+        Calling Game::Initialize() will enumerate through any components and initialize them as well.
+        The parameter pOutputWindowsInfo represents the information of output window(s) of this game.
+	*/
+	void initialize(_In_ std::map<int, w_window_info> pOutputWindowsInfo) override;
+
+	//The function "Load()" will be called once per game and is the place to load all of your game assets.
+	void load() override;
+
+	//This is the place where allows the game to run logic such as updating the world, checking camera, collisions, physics, input, playing audio and etc.
+	void update(_In_ const wolf::system::w_game_time& pGameTime) override;
+
+	//This is called when the game should draw itself.
+	W_RESULT render(_In_ const wolf::system::w_game_time& pGameTime) override;
+
+	//This is called when the window game should resized.
+	void on_window_resized(_In_ const uint32_t& pGraphicsDeviceIndex, _In_ const w_point& pNewSizeOfWindow) override;
+
+	//This is called when the we lost graphics device.
+	void on_device_lost() override;
+
+	//Release will be called once per game and is the place to unload assets and release all resources
+	ULONG release() override;
+
+private:
+	W_RESULT	_build_draw_command_buffer(_In_ const uint32_t& pIndex);
+	W_RESULT	_record_draws(
+		_In_ const wolf::graphics::w_command_buffer& pCommandBuffer,
+		_In_ const size_t& pBegin,
+		_In_ const size_t& pEnd);
+	void		_run_benchmark(_In_ const uint32_t& pIndex);
+    bool		_update_gui();
+
+	wolf::graphics::w_viewport                                      _viewport;
+	wolf::graphics::w_viewport_scissor                              _viewport_scissor;
+
+	wolf::graphics::w_command_buffers                               _draw_command_buffers;
+	//swap chain images which their command buffers must be recorded again before next submission
+	std::vector<bool>                                               _rebuild_draw_command_buffers;
+	wolf::graphics::w_render_pass                                   _draw_render_pass;
+
+	wolf::graphics::w_fences                                        _draw_fence;
+	wolf::graphics::w_semaphore                                     _draw_semaphore;
+
+	wolf::graphics::w_shader                                        _shader;
+    wolf::graphics::w_pipeline                                      _pipeline;
+
+    wolf::graphics::w_mesh											_mesh;
+    wolf::graphics::w_texture										_texture;
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	wolf::system::w_job_system										_job_system;
+	wolf::graphics::w_parallel_command_buffers						_parallel_command_buffers;
+	//push constant color of each draw
+	std::vector<glm::vec4>											_colors;
+	//average recording time of all draws in milliseconds for 1..N threads
+	std::vector<double>												_benchmark_results;
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+};
+
+#endif
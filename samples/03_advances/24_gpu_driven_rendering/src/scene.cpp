@@ -0,0 +1,775 @@
+#include "pch.h"
+#include "scene.h"
+#include <chrono>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::graphics;
+
+static uint32_t sFPS = 0;
+static float sElapsedTimeInSec = 0;
+static float sTotalTimeTimeInSec = 0;
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//number of instances of each step of benchmark
+static const uint32_t sNumberOfInstances[] = { 1024, 4096, 16384, 65536, 262144 };
+static const int sNumberOfSteps = sizeof(sNumberOfInstances) / sizeof(sNumberOfInstances[0]);
+//frames of each step, the first frames will be skipped because uploads and pipeline creation happen in them
+static const uint32_t sBenchmarkWarmUpFrames = 10;
+static const uint32_t sBenchmarkFrames = 120;
+//distance between instances in grid
+static const float sSpacing = 4.0f;
+static int sSelectedStep = 2;
+//index of the running step of benchmark, -1 means benchmark is not running
+static int sBenchmarkStep = -1;
+static uint32_t sBenchmarkFrame = 0;
+static bool sReloadInstances = true;
+static bool sRebuildCommandBuffers = true;
+
+//append a sphere with radius of one to vertices and indices, each vertex contains position, normal and uv
+static void generate_sphere(
+	_In_ const uint32_t& pSlices,
+	_In_ const uint32_t& pStacks,
+	_Inout_ std::vector<float>& pVertices,
+	_Inout_ std::vector<uint32_t>& pIndices,
+	_Inout_ w_gpu_driven_lod& pLOD)
+{
+	pLOD.first_index = static_cast<uint32_t>(pIndices.size());
+	pLOD.vertex_offset = static_cast<int32_t>(pVertices.size() / 8);
+
+	for (uint32_t _stack = 0; _stack <= pStacks; ++_stack)
+	{
+		auto _phi = glm::pi<float>() * _stack / pStacks;
+		for (uint32_t _slice = 0; _slice <= pSlices; ++_slice)
+		{
+			auto _theta = 2.0f * glm::pi<float>() * _slice / pSlices;
+			auto _normal = glm::vec3(
+				std::sin(_phi) * std::cos(_theta),
+				std::cos(_phi),
+				std::sin(_phi) * std::sin(_theta));
+
+			pVertices.insert(pVertices.end(),
+			{
+				_normal.x, _normal.y, _normal.z,	//position
+				_normal.x, _normal.y, _normal.z,	//normal
+				static_cast<float>(_slice) / pSlices, static_cast<float>(_stack) / pStacks	//uv
+			});
+		}
+	}
+
+	for (uint32_t _stack = 0; _stack < pStacks; ++_stack)
+	{
+		for (uint32_t _slice = 0; _slice < pSlices; ++_slice)
+		{
+			auto _a = _stack * (pSlices + 1) + _slice;
+			auto _b = _a + pSlices + 1;
+			pIndices.insert(pIndices.end(), { _a, _b, _a + 1, _a + 1, _b, _b + 1 });
+		}
+	}
+
+	pLOD.index_count = static_cast<uint32_t>(pIndices.size()) - pLOD.first_index;
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+scene::scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring& pLogPath, _In_z_ const std::wstring& pAppName) :
+    w_game(pContentPath, pLogPath, pAppName),
+	_camera_position(0.0f),
+	_gpu_driven_renderer(nullptr),
+	_instances_vertex_buffer(nullptr)
+{
+	w_graphics_device_manager_configs _config;
+	_config.debug_gpu = false;
+	w_game::set_graphics_device_manager_configs(_config);
+
+	w_game::set_fixed_time_step(false);
+}
+
+scene::~scene()
+{
+	//release all resources
+	release();
+}
+
+void scene::initialize(_In_ std::map<int, w_window_info> pOutputWindowsInfo)
+{
+	// TODO: Add your pre-initialization logic here
+	w_game::initialize(pOutputWindowsInfo);
+}
+
+void scene::load()
+{
+	defer(nullptr, [&](...)
+	{
+		w_game::load();
+	});
+
+	const std::string _trace_info = this->name + "::load";
+
+	auto _gDevice = this->graphics_devices[0];
+	auto _output_window = &(_gDevice->output_presentation_window);
+
+	w_point_t _screen_size;
+	_screen_size.x = _output_window->width;
+	_screen_size.y = _output_window->height;
+
+	//initialize viewport
+	this->_viewport.y = 0;
+	this->_viewport.width = static_cast<float>(_screen_size.x);
+	this->_viewport.height = static_cast<float>(_screen_size.y);
+	this->_viewport.minDepth = 0;
+	this->_viewport.maxDepth = 1;
+
+	//initialize scissor of viewport
+	this->_viewport_scissor.offset.x = 0;
+	this->_viewport_scissor.offset.y = 0;
+	this->_viewport_scissor.extent.width = _screen_size.x;
+	this->_viewport_scissor.extent.height = _screen_size.y;
+
+	//define color and depth as an attachments buffers for render pass
+	std::vector<std::vector<w_image_view>> _render_pass_attachments;
+	for (size_t i = 0; i < _output_window->swap_chain_image_views.size(); ++i)
+	{
+		_render_pass_attachments.push_back
+		(
+			//COLOR									   , DEPTH
+			{ _output_window->swap_chain_image_views[i], _output_window->depth_buffer_image_view }
+		);
+	}
+	//create render pass
+	auto _hr = this->_draw_render_pass.load(
+		_gDevice,
+		_viewport,
+		_viewport_scissor,
+		_render_pass_attachments);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating render pass", _trace_info, 3, true);
+	}
+
+	//create semaphore
+	_hr = this->_draw_semaphore.initialize(_gDevice);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw semaphore", _trace_info, 3, true);
+	}
+
+	//Fence for syncing
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw fence", _trace_info, 3, true);
+	}
+
+	//load imgui
+	w_imgui::load(
+		_gDevice,
+		_output_window,
+		this->_viewport,
+		this->_viewport_scissor,
+		nullptr);
+
+	//create draw command buffers
+	_hr = this->_draw_command_buffers.load(_gDevice, _output_window->swap_chain_image_views.size());
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw command buffers", _trace_info, 3, true);
+	}
+	//all command buffers will be recorded in render
+	this->_rebuild_draw_command_buffers.assign(_output_window->swap_chain_image_views.size(), true);
+
+#ifdef WIN32
+	auto _content_path_dir = wolf::system::io::get_current_directoryW() + L"/../../../../samples/03_advances/24_gpu_driven_rendering/src/content/";
+#elif defined(__APPLE__)
+	auto _content_path_dir = wolf::system::io::get_current_directoryW() + L"/../../../../../samples/03_advances/24_gpu_driven_rendering/src/content/";
+#endif // WIN32
+
+	//loading vertex shaders
+	_hr = this->_shader.load(_gDevice,
+		_content_path_dir + L"shaders/instance.vert.spv",
+		w_shader_stage_flag_bits::VERTEX_SHADER);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading vertex shader", _trace_info, 3, true);
+	}
+
+	//loading fragment shader
+	_hr = this->_shader.load(_gDevice,
+		_content_path_dir + L"shaders/shader.frag.spv",
+		w_shader_stage_flag_bits::FRAGMENT_SHADER);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading fragment shader", _trace_info, 3, true);
+	}
+
+	//load texture
+	_hr = this->_texture.initialize(_gDevice);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading texture", _trace_info, 3, true);
+	}
+	//load texture from file
+	_hr = this->_texture.load_texture_2D_from_file(content_path + L"../Logo.jpg", true);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading Logo.jpg texture", _trace_info, 3, true);
+	}
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//view and projection will be updated in each frame, one region for each swap chain image
+	_hr = this->_u0.load(_gDevice, true, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading uniform u0", _trace_info, 3, true);
+	}
+
+	_hr = this->_u1.load(_gDevice);
+	if (_hr == W_FAILED || this->_u1.update() == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading uniform u1", _trace_info, 3, true);
+	}
+
+	//first instance will be drawn with red and the others with green
+	_hr = this->_u2.load(_gDevice);
+	if (_hr == W_FAILED || this->_u2.update() == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading uniform u2", _trace_info, 3, true);
+	}
+
+	std::vector<w_shader_binding_param> _shader_params;
+
+	w_shader_binding_param _shader_param;
+	_shader_param.index = 0;
+	_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
+	_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
+	_shader_param.buffer_info = this->_u0.get_descriptor_info();
+	_shader_params.push_back(_shader_param);
+
+	_shader_param.index = 1;
+	_shader_param.type = w_shader_binding_type::UNIFORM;
+	_shader_param.buffer_info = this->_u1.get_descriptor_info();
+	_shader_params.push_back(_shader_param);
+
+	_shader_param.index = 2;
+	_shader_param.type = w_shader_binding_type::SAMPLER2D;
+	_shader_param.stage = w_shader_stage_flag_bits::FRAGMENT_SHADER;
+	_shader_param.image_info = this->_texture.get_descriptor_info();
+	_shader_params.push_back(_shader_param);
+
+	_shader_param.index = 3;
+	_shader_param.type = w_shader_binding_type::UNIFORM;
+	_shader_param.buffer_info = this->_u2.get_descriptor_info();
+	_shader_params.push_back(_shader_param);
+
+	_hr = this->_shader.set_shader_binding_params(_shader_params);
+	_shader_params.clear();
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "setting shader binding param", _trace_info, 3, true);
+	}
+
+	//loading pipeline cache
+	std::string _pipeline_cache_name = "pipeline_cache";
+	if (w_pipeline::create_pipeline_cache(_gDevice, _pipeline_cache_name) == W_FAILED)
+	{
+		logger.error("could not create pipeline cache");
+		_pipeline_cache_name.clear();
+	}
+
+	//position, normal and uv per each vertex and position, rotation per each instance
+	std::map<uint32_t, std::vector<w_vertex_attribute>> _vertex_declaration;
+	_vertex_declaration[0] = { W_POS, W_NORM, W_UV };
+	_vertex_declaration[1] = { W_POS, W_ROT };
+
+	_hr = this->_pipeline.load(_gDevice,
+		w_vertex_binding_attributes(_vertex_declaration),
+		w_primitive_topology::TRIANGLE_LIST,
+		&this->_draw_render_pass,
+		&this->_shader,
+		{ this->_viewport },
+		{ this->_viewport_scissor },
+		_pipeline_cache_name);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating solid pipeline", _trace_info, 3, true);
+	}
+
+	//one sphere with three lods shares the vertex and index buffers of renderer
+	w_gpu_driven_lod _lod;
+	generate_sphere(32, 16, this->_vertices, this->_indices, _lod);
+	_lod.max_distance = 60.0f;
+	this->_lods.push_back(_lod);
+	generate_sphere(16, 8, this->_vertices, this->_indices, _lod);
+	_lod.max_distance = 150.0f;
+	this->_lods.push_back(_lod);
+	generate_sphere(8, 4, this->_vertices, this->_indices, _lod);
+	this->_lods.push_back(_lod);
+
+	w_gpu_driven_mesh _mesh;
+	_mesh.first_lod = 0;
+	_mesh.lod_count = static_cast<uint32_t>(this->_lods.size());
+	this->_meshes.push_back(_mesh);
+
+	//run benchmark at startup
+	sBenchmarkStep = 0;
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+}
+
+W_RESULT scene::_build_draw_command_buffer(_In_ const uint32_t& pIndex)
+{
+	const std::string _trace_info = this->name + "::build_draw_command_buffer";
+	W_RESULT _hr = W_PASSED;
+
+	if (!this->_gpu_driven_renderer || !this->_instances_vertex_buffer) return W_FAILED;
+	auto _instances_handle = this->_instances_vertex_buffer->get_buffer_handle();
+
+	auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+	this->_draw_command_buffers.begin(pIndex);
+	{
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		//The following codes have been added for this project
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		//culling pass must be recorded outside of render pass, command buffers do not change per frame
+		_hr = this->_gpu_driven_renderer->record_culling(_cmd, pIndex);
+		if (_hr == W_FAILED)
+		{
+			V(W_FAILED, "recording culling pass", _trace_info, 3, false);
+		}
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+		this->_draw_render_pass.begin(
+			pIndex,
+			_cmd,
+			w_color::CORNFLOWER_BLUE(),
+			1.0f,
+			0);
+		{
+			this->_pipeline.bind(
+				_cmd,
+				w_pipeline_bind_point::GRAPHICS,
+				{ this->_u0.get_dynamic_offset_at(pIndex) });
+
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//The following codes have been added for this project
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//all surviving instances will be drawn with one indirect draw
+			_hr = this->_gpu_driven_renderer->draw(_cmd, &_instances_handle);
+			if (_hr == W_FAILED)
+			{
+				V(W_FAILED, "drawing instances", _trace_info, 3, false);
+			}
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		}
+		this->_draw_render_pass.end(_cmd);
+	}
+	this->_draw_command_buffers.end(pIndex);
+
+	return _hr;
+}
+
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+W_RESULT scene::_load_instances(_In_ const uint32_t& pNumberOfInstances)
+{
+	const std::string _trace_info = this->name + "::_load_instances";
+
+	auto _gDevice = this->graphics_devices[0];
+
+	//GPU has finished all frames, so resources of previous number of instances can be released
+	SAFE_RELEASE(this->_gpu_driven_renderer);
+	SAFE_RELEASE(this->_instances_vertex_buffer);
+
+	//instances are placed on a grid around the origin
+	auto _side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(pNumberOfInstances))));
+	auto _half = 0.5f * static_cast<float>(_side - 1);
+
+	std::vector<w_gpu_driven_instance> _instances(pNumberOfInstances);
+	std::vector<float> _instances_vertex_data(pNumberOfInstances * 6, 0.0f);
+	for (uint32_t i = 0; i < pNumberOfInstances; ++i)
+	{
+		auto _x = (static_cast<float>(i % _side) - _half) * sSpacing;
+		auto _z = (static_cast<float>(i / _side) - _half) * sSpacing;
+
+		_instances[i].bounding_sphere = glm::vec4(_x, 0.0f, _z, 1.0f);
+		_instances[i].mesh_index = 0;
+
+		//position and rotation
+		_instances_vertex_data[i * 6 + 0] = _x;
+		_instances_vertex_data[i * 6 + 2] = _z;
+	}
+
+	this->_instances_vertex_buffer = new (std::nothrow) w_buffer();
+	if (!this->_instances_vertex_buffer ||
+		this->_instances_vertex_buffer->load(
+			_gDevice,
+			static_cast<uint32_t>(_instances_vertex_data.size() * sizeof(float)),
+			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) == W_FAILED ||
+		this->_instances_vertex_buffer->bind() == W_FAILED ||
+		this->_instances_vertex_buffer->set_data(_instances_vertex_data.data()) == W_FAILED)
+	{
+		V(W_FAILED, "loading instances vertex buffer", _trace_info, 3, false);
+		return W_FAILED;
+	}
+
+	this->_gpu_driven_renderer = new (std::nothrow) w_gpu_driven_renderer();
+	if (!this->_gpu_driven_renderer ||
+		this->_gpu_driven_renderer->load(
+			_gDevice,
+			this->_vertices.data(),
+			static_cast<uint32_t>(this->_vertices.size() * sizeof(float)),
+			this->_indices,
+			this->_meshes,
+			this->_lods,
+			_instances,
+			nullptr,
+			static_cast<uint32_t>(this->_draw_command_buffers.get_commands_size())) == W_FAILED)
+	{
+		V(W_FAILED, "loading gpu driven renderer", _trace_info, 3, false);
+		return W_FAILED;
+	}
+
+	this->_current_result = benchmark_result();
+	this->_current_result.number_of_instances = pNumberOfInstances;
+	sBenchmarkFrame = 0;
+	sRebuildCommandBuffers = true;
+
+	return W_PASSED;
+}
+
+void scene::_update_benchmark(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (sBenchmarkStep < 0 || !this->_gpu_driven_renderer) return;
+
+	//skip the first frames
+	if (sBenchmarkFrame++ < sBenchmarkWarmUpFrames)
+	{
+		this->_current_result.cpu_time_in_ms = 0.0;
+		return;
+	}
+
+	auto _statistics = this->_gpu_driven_renderer->get_statistics();
+	this->_current_result.number_of_draws = _statistics.number_of_draws;
+	this->_current_result.culling_time_in_ms += _statistics.culling_time_in_ms;
+	this->_current_result.frame_time_in_ms += pGameTime.get_elapsed_seconds() * 1000.0;
+
+	if (sBenchmarkFrame < sBenchmarkWarmUpFrames + sBenchmarkFrames) return;
+
+	this->_current_result.culling_time_in_ms /= sBenchmarkFrames;
+	this->_current_result.frame_time_in_ms /= sBenchmarkFrames;
+	this->_current_result.cpu_time_in_ms /= sBenchmarkFrames;
+	this->_benchmark_results.push_back(this->_current_result);
+
+	logger.write(std::to_string(this->_current_result.number_of_instances) + " instances, " +
+		std::to_string(this->_current_result.number_of_draws) + " draws, culling on GPU: " +
+		std::to_string(this->_current_result.culling_time_in_ms) + " ms, CPU per frame: " +
+		std::to_string(this->_current_result.cpu_time_in_ms) + " ms, frame: " +
+		std::to_string(this->_current_result.frame_time_in_ms) + " ms");
+
+	//go to the next step or finish benchmark
+	if (++sBenchmarkStep == sNumberOfSteps)
+	{
+		sBenchmarkStep = -1;
+	}
+	sReloadInstances = true;
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (w_game::exiting) return;
+	const std::string _trace_info = this->name + "::update";
+
+    sFPS = pGameTime.get_frames_per_second();
+    sElapsedTimeInSec = pGameTime.get_elapsed_seconds();
+    sTotalTimeTimeInSec = pGameTime.get_total_seconds();
+
+    w_imgui::new_frame(sElapsedTimeInSec, [this]()
+    {
+        _update_gui();
+    });
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	if (this->_gpu_driven_renderer)
+	{
+		//camera orbits around the grid, so some instances will be culled and the others use different lods
+		auto _side = std::ceil(std::sqrt(static_cast<float>(this->_gpu_driven_renderer->get_number_of_instances())));
+		auto _radius = 0.5f * _side * sSpacing + 20.0f;
+		auto _angle = sTotalTimeTimeInSec * 0.2f;
+		auto _eye = glm::vec3(std::cos(_angle) * _radius, 20.0f, std::sin(_angle) * _radius);
+		auto _up = glm::vec3(0, -1, 0);
+		auto _look_at = glm::vec3(0, 0, 0);
+
+		this->_u0.data.view = glm::lookAtRH(_eye, _look_at, _up);
+		this->_u0.data.projection = glm::perspectiveRH(
+			45.0f * glm::pi<float>() / 180.0f,
+			this->_viewport.width / this->_viewport.height,
+			0.1f,
+			5000.0f);
+		//uniform and camera will be copied to region of swap chain image in render
+		this->_camera_position = _eye;
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	w_game::update(pGameTime);
+}
+
+W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (w_game::exiting) return W_PASSED;
+
+	const std::string _trace_info = this->name + "::render";
+
+	auto _gDevice = this->graphics_devices[0];
+	auto _output_window = &(_gDevice->output_presentation_window);
+	auto _frame_index = _output_window->swap_chain_image_index;
+
+	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
+	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
+
+	const uint32_t _wait_dst_stage_mask[] =
+	{
+		w_pipeline_stage_flag_bits::COLOR_ATTACHMENT_OUTPUT_BIT,
+	};
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	if (sReloadInstances)
+	{
+		//command buffers of all swap chain images use the renderer, so all frames in flight must be completed before reloading instances
+		this->_draw_fence.wait();
+
+		auto _step = sBenchmarkStep < 0 ? sSelectedStep : sBenchmarkStep;
+		if (_load_instances(sNumberOfInstances[_step]) == W_FAILED)
+		{
+			V(W_FAILED, "loading " + std::to_string(sNumberOfInstances[_step]) + " instances", _trace_info, 3, true);
+		}
+		sReloadInstances = false;
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	if (this->_gpu_driven_renderer)
+	{
+		auto _start = std::chrono::high_resolution_clock::now();
+
+		//uniform and camera of this swap chain image are not in use anymore
+		if (this->_u0.update_at(_frame_index) == W_FAILED)
+		{
+			V(W_FAILED, "updating uniform u0", _trace_info, 3, false);
+		}
+
+		//the only per frame work of CPU for culling, it does not depend on number of instances
+		this->_gpu_driven_renderer->set_camera(
+			this->_u0.data.projection * this->_u0.data.view,
+			this->_camera_position,
+			1.0f,
+			_frame_index);
+
+		this->_current_result.cpu_time_in_ms += std::chrono::duration<double, std::milli>(
+			std::chrono::high_resolution_clock::now() - _start).count();
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	if (sRebuildCommandBuffers)
+	{
+		sRebuildCommandBuffers = false;
+		//command buffers will be recorded again after their previous submissions
+		std::fill(this->_rebuild_draw_command_buffers.begin(), this->_rebuild_draw_command_buffers.end(), true);
+	}
+
+	//command buffer of this swap chain image is not in use anymore, so record it again if it has been invalidated
+	if (this->_rebuild_draw_command_buffers[_frame_index])
+	{
+		this->_rebuild_draw_command_buffers[_frame_index] = false;
+		if (_build_draw_command_buffer(_frame_index) == W_FAILED)
+		{
+			V(W_FAILED, "building draw command buffer", _trace_info, 3, false);
+		}
+	}
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
+	if (_gDevice->submit(
+		{ &_draw_cmd, &_gui_cmd },//command buffers
+		_gDevice->vk_graphics_queue, //graphics queue
+		&_wait_dst_stage_mask[0], //destination masks
+		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
+		{ _output_window->rendering_done_semaphore }, //signal semaphores
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
+	}
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	_update_benchmark(pGameTime);
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	return w_game::render(pGameTime);
+}
+
+void scene::on_window_resized(_In_ const uint32_t& pIndex, _In_ const w_point& pNewSizeOfWindow)
+{
+	w_game::on_window_resized(pIndex, pNewSizeOfWindow);
+}
+
+void scene::on_device_lost()
+{
+	w_game::on_device_lost();
+}
+
+ULONG scene::release()
+{
+    if (this->get_is_released()) return 1;
+
+    //release draw's objects
+	this->_draw_fence.release();
+	this->_draw_semaphore.release();
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	SAFE_RELEASE(this->_gpu_driven_renderer);
+	SAFE_RELEASE(this->_instances_vertex_buffer);
+	this->_u0.release();
+	this->_u1.release();
+	this->_u2.release();
+	this->_vertices.clear();
+	this->_indices.clear();
+	this->_meshes.clear();
+	this->_lods.clear();
+	this->_benchmark_results.clear();
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	this->_draw_command_buffers.release();
+	this->_draw_render_pass.release();
+
+    //release gui's objects
+    w_imgui::release();
+
+	this->_shader.release();
+
+    this->_pipeline.release();
+
+    this->_texture.release();
+
+	return w_game::release();
+}
+
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+bool scene::_update_gui()
+{
+    //Setting Style
+    ImGuiStyle& _style = ImGui::GetStyle();
+    _style.Colors[ImGuiCol_Text].x = 1.0f;
+    _style.Colors[ImGuiCol_Text].y = 1.0f;
+    _style.Colors[ImGuiCol_Text].z = 1.0f;
+    _style.Colors[ImGuiCol_Text].w = 1.0f;
+
+    _style.Colors[ImGuiCol_WindowBg].x = 0.0f;
+    _style.Colors[ImGuiCol_WindowBg].y = 0.4f;
+    _style.Colors[ImGuiCol_WindowBg].z = 1.0f;
+    _style.Colors[ImGuiCol_WindowBg].w = 1.0f;
+
+    ImGuiWindowFlags  _window_flags = 0;;
+    ImGui::SetNextWindowSize(ImVec2(500, 400), ImGuiSetCond_FirstUseEver);
+    bool _is_open = true;
+    if (!ImGui::Begin("Wolf.Engine", &_is_open, _window_flags))
+    {
+        ImGui::End();
+        return false;
+    }
+
+    ImGui::Text("Press Esc to exit\r\nFPS:%d\r\nFrameTime:%f\r\nTotalTime:%f\r\nMouse Position:%d,%d\r\n",
+        sFPS,
+        sElapsedTimeInSec,
+        sTotalTimeTimeInSec,
+        wolf::inputs_manager.mouse.pos_x, wolf::inputs_manager.mouse.pos_y);
+
+	if (this->_gpu_driven_renderer)
+	{
+		auto _statistics = this->_gpu_driven_renderer->get_statistics();
+		ImGui::Text("Instances:%u\r\nDraws:%u\r\nCulled by frustum:%u\r\nCulling on GPU:%f ms\r\nDraw indirect count:%s\r\n",
+			_statistics.number_of_instances,
+			_statistics.number_of_draws,
+			_statistics.culled_by_frustum,
+			_statistics.culling_time_in_ms,
+			_statistics.draw_indirect_count ? "yes" : "no");
+	}
+
+	if (sBenchmarkStep < 0)
+	{
+		if (ImGui::SliderInt("Step", &sSelectedStep, 0, sNumberOfSteps - 1, std::to_string(sNumberOfInstances[sSelectedStep]).c_str()))
+		{
+			sReloadInstances = true;
+		}
+		if (ImGui::Button("Run benchmark"))
+		{
+			this->_benchmark_results.clear();
+			sBenchmarkStep = 0;
+			sReloadInstances = true;
+		}
+	}
+	else
+	{
+		ImGui::Text("Running benchmark with %u instances", sNumberOfInstances[sBenchmarkStep]);
+	}
+
+	for (auto& _result : this->_benchmark_results)
+	{
+		ImGui::Text("%u instances: %u draws, GPU culling: %f ms, CPU: %f ms, frame: %f ms",
+			_result.number_of_instances,
+			_result.number_of_draws,
+			_result.culling_time_in_ms,
+			_result.cpu_time_in_ms,
+			_result.frame_time_in_ms);
+	}
+
+    ImGui::End();
+
+    return true;
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -0,0 +1,129 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : scene.h
+	Description		 : The main scene of Wolf Engine
+	Comment          : Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __SCENE_H__
+#define __SCENE_H__
+
+#include <w_framework/w_game.h>
+#include <w_graphics/w_command_buffers.h>
+#include <w_graphics/w_gpu_driven_renderer.h>
+#include <w_graphics/w_uniform.h>
+#include <w_graphics/w_render_pass.h>
+#include <w_graphics/w_semaphore.h>
+#include <w_graphics/w_shader.h>
+#include <w_graphics/w_pipeline.h>
+#include <w_graphics/w_mesh.h>
+#include <w_graphics/w_texture.h>
+#include <w_graphics/w_imgui.h>
+
+class scene : public wolf::framework::w_game
+{
+public:
+	scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring& pLogPath, _In_z_ const std::wstring& pAppName);
+	virtual ~scene();
+
+	/*
+        Allows the game to perform any initialization and it needs to before starting to run.
+        Calling Game::Initialize() will enumerate through any components and initialize them as well.
+        The parameter pOutputWindowsInfo represents the information of output window(s) of this game.
+	*/
+	void initialize(_In_ std::map<int, w_window_info> pOutputWindowsInfo) override;
+
+	//The function "Load()" will be called once per game and is the place to load all of your game assets.
+	void load() override;
+
+	//This is the place where allows the game to run logic such as updating the world, checking camera, collisions, physics, input, playing audio and etc.
+	void update(_In_ const wolf::system::w_game_time& pGameTime) override;
+
+	//This is called when the game should draw itself.
+	W_RESULT render(_In_ const wolf::system::w_game_time& pGameTime) override;
+
+	//This is called when the window game should resized.
+	void on_window_resized(_In_ const uint32_t& pGraphicsDeviceIndex, _In_ const w_point& pNewSizeOfWindow) override;
+
+	//This is called when the we lost graphics device.
+	void on_device_lost() override;
+
+	//Release will be called once per game and is the place to unload assets and release all resources
+	ULONG release() override;
+
+private:
+	W_RESULT	_build_draw_command_buffer(_In_ const uint32_t& pIndex);
+	W_RESULT	_load_instances(_In_ const uint32_t& pNumberOfInstances);
+	void		_update_benchmark(_In_ const wolf::system::w_game_time& pGameTime);
+    bool		_update_gui();
+
+	wolf::graphics::w_viewport                                      _viewport;
+	wolf::graphics::w_viewport_scissor                              _viewport_scissor;
+
+	wolf::graphics::w_command_buffers                               _draw_command_buffers;
+	//swap chain images which their command buffers must be recorded again before next submission
+	std::vector<bool>                                               _rebuild_draw_command_buffers;
+	wolf::graphics::w_render_pass                                   _draw_render_pass;
+
+	wolf::graphics::w_fences                                        _draw_fence;
+	wolf::graphics::w_semaphore                                     _draw_semaphore;
+
+	wolf::graphics::w_shader                                        _shader;
+    wolf::graphics::w_pipeline                                      _pipeline;
+
+    wolf::graphics::w_texture										_texture;
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	struct U0
+	{
+		glm::mat4	view;
+		glm::mat4	projection;
+	};
+	struct U1
+	{
+		float		texture_lod = 0.0f;
+	};
+	struct U2
+	{
+		float		cmds = 1.0f;
+	};
+	wolf::graphics::w_uniform<U0>									_u0;
+	//position of camera which will be used for culling pass of the next frame
+	glm::vec3														_camera_position;
+	wolf::graphics::w_uniform<U1>									_u1;
+	wolf::graphics::w_uniform<U2>									_u2;
+
+	//vertices and indices of all lods of sphere
+	std::vector<float>												_vertices;
+	std::vector<uint32_t>											_indices;
+	std::vector<wolf::graphics::w_gpu_driven_mesh>					_meshes;
+	std::vector<wolf::graphics::w_gpu_driven_lod>					_lods;
+
+	//renderer and per instance vertex buffer will be recreated for each number of instances
+	wolf::graphics::w_gpu_driven_renderer*							_gpu_driven_renderer;
+	wolf::graphics::w_buffer*										_instances_vertex_buffer;
+
+	struct benchmark_result
+	{
+		uint32_t	number_of_instances = 0;
+		uint32_t	number_of_draws = 0;
+		double		culling_time_in_ms = 0.0;
+		double		frame_time_in_ms = 0.0;
+		//CPU time of each frame for updating culling pass, it must not depend on number of instances
+		double		cpu_time_in_ms = 0.0;
+	};
+	std::vector<benchmark_result>									_benchmark_results;
+	benchmark_result												_current_result;
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+};
+
+#endif
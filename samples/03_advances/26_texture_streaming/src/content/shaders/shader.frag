@@ -0,0 +1,17 @@
+#version 450
+
+#extension GL_EXT_nonuniform_qualifier : require
+
+//all textures of bindless texture table, array is partially bound
+layout(set=1, binding=0) uniform sampler2D t_textures[];
+
+layout(location = 0) in vec2 i_uv;
+layout(location = 1) flat in uint i_material;
+
+layout(location = 0) out vec4 o_color;
+
+void main() 
+{
+	//instances of one draw use different textures
+	o_color = texture( t_textures[nonuniformEXT(i_material)], i_uv );
+}
@@ -0,0 +1,32 @@
+#version 450
+
+layout(location = 0) in vec3 i_position;
+layout(location = 1) in vec2 i_uv;
+
+//per instance data, xy of transform is offset and zw is scale
+layout(location = 2) in vec4 i_ins_transform;
+//slot of texture in bindless texture table
+layout(location = 3) in float i_ins_material;
+
+layout(set=0, binding=0) uniform U0
+{
+	//x is total time in seconds
+	vec4 animation;
+} u0;
+
+out gl_PerVertex
+{
+  vec4 gl_Position;
+};
+
+layout(location = 0) out vec2 o_uv;
+layout(location = 1) flat out uint o_material;
+
+void main() 
+{
+	//must match with scene::_request_levels
+	float _wave = 0.55 + 0.45 * sin(u0.animation.x * 0.5 + i_ins_material);
+    gl_Position = vec4(i_position.xy * i_ins_transform.zw * _wave + i_ins_transform.xy, 0.0, 1.0);
+    o_uv = i_uv;
+	o_material = uint(i_ins_material);
+}
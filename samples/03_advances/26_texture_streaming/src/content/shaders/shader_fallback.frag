@@ -0,0 +1,17 @@
+#version 450
+
+//must be equal to capacity of bindless texture table, unused slots refer to default texture
+#define MAX_TEXTURES 16
+
+layout(set=1, binding=0) uniform sampler2D t_textures[MAX_TEXTURES];
+
+layout(location = 0) in vec2 i_uv;
+layout(location = 1) flat in uint i_material;
+
+layout(location = 0) out vec4 o_color;
+
+void main() 
+{
+	//all instances of one draw have the same material, so index is dynamically uniform
+	o_color = texture( t_textures[i_material], i_uv );
+}
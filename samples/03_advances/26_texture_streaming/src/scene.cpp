@@ -0,0 +1,723 @@
+#include "pch.h"
+#include "scene.h"
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::graphics;
+
+static uint32_t sFPS = 0;
+static float sElapsedTimeInSec = 0;
+static float sTotalTimeTimeInSec = 0;
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//16 is the minimum maxPerStageDescriptorSamplers of specification, so fallback will not be clamped
+static const uint32_t sNumberOfTextures = 16;
+//each texture is one quad on a grid of sGridSize x sGridSize quads
+static const uint32_t sGridSize = 4;
+static const uint32_t sNumberOfInstances = sGridSize * sGridSize;
+//small budget, so growing quads force streamer to evict levels of shrinking ones
+static const uint64_t sStreamingBudgetInBytes = 8 * 1024 * 1024;
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+scene::scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring& pLogPath, _In_z_ const std::wstring& pAppName) :
+    w_game(pContentPath, pLogPath, pAppName),
+	_number_of_draws(0)
+{
+	w_graphics_device_manager_configs _config;
+	_config.debug_gpu = false;
+	w_game::set_graphics_device_manager_configs(_config);
+
+	w_game::set_fixed_time_step(false);
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+#ifdef VK_EXT_descriptor_indexing
+	//graphics device manager removes this extension if GPU does not support it, then texture table uses its fallback
+	this->on_device_info_fetched += [](w_device_info** pDeviceInfo)
+	{
+		(*pDeviceInfo)->device_extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+	};
+#endif
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+}
+
+scene::~scene()
+{
+	//release all resources
+	release();
+}
+
+void scene::initialize(_In_ std::map<int, w_window_info> pOutputWindowsInfo)
+{
+	// TODO: Add your pre-initialization logic here
+	w_game::initialize(pOutputWindowsInfo);
+}
+
+void scene::load()
+{
+	defer(nullptr, [&](...)
+	{
+		w_game::load();
+	});
+
+	const std::string _trace_info = this->name + "::load";
+
+	auto _gDevice = this->graphics_devices[0];
+	auto _output_window = &(_gDevice->output_presentation_window);
+
+	w_point_t _screen_size;
+	_screen_size.x = _output_window->width;
+	_screen_size.y = _output_window->height;
+
+	//initialize viewport
+	this->_viewport.y = 0;
+	this->_viewport.width = static_cast<float>(_screen_size.x);
+	this->_viewport.height = static_cast<float>(_screen_size.y);
+	this->_viewport.minDepth = 0;
+	this->_viewport.maxDepth = 1;
+
+	//initialize scissor of viewport
+	this->_viewport_scissor.offset.x = 0;
+	this->_viewport_scissor.offset.y = 0;
+	this->_viewport_scissor.extent.width = _screen_size.x;
+	this->_viewport_scissor.extent.height = _screen_size.y;
+
+	//define color and depth as an attachments buffers for render pass
+	std::vector<std::vector<w_image_view>> _render_pass_attachments;
+	for (size_t i = 0; i < _output_window->swap_chain_image_views.size(); ++i)
+	{
+		_render_pass_attachments.push_back
+		(
+			//COLOR									   , DEPTH
+			{ _output_window->swap_chain_image_views[i], _output_window->depth_buffer_image_view }
+		);
+	}
+	//create render pass
+	auto _hr = this->_draw_render_pass.load(
+		_gDevice,
+		_viewport,
+		_viewport_scissor,
+		_render_pass_attachments);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating render pass", _trace_info, 3, true);
+	}
+
+	//create semaphore
+	_hr = this->_draw_semaphore.initialize(_gDevice);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw semaphore", _trace_info, 3, true);
+	}
+
+	//Fence for syncing
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw fence", _trace_info, 3, true);
+	}
+
+	//load imgui
+	w_imgui::load(
+		_gDevice,
+		_output_window,
+		this->_viewport,
+		this->_viewport_scissor,
+		nullptr);
+
+	//create one command buffer for each swap chain image
+	auto _swap_chain_image_size = _output_window->swap_chain_image_views.size();
+	_hr = this->_draw_command_buffers.load(_gDevice, _swap_chain_image_size);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw command buffers", _trace_info, 3, true);
+	}
+
+#ifdef WIN32
+	auto _content_path_dir = wolf::system::io::get_current_directoryW() + L"/../../../../samples/03_advances/26_texture_streaming/src/content/";
+#elif defined(__APPLE__)
+	auto _content_path_dir = wolf::system::io::get_current_directoryW() + L"/../../../../../samples/03_advances/26_texture_streaming/src/content/";
+#endif // WIN32
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//create table before textures, so it can be filled with them
+	_hr = this->_texture_table.load(_gDevice, sNumberOfTextures, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading bindless texture table", _trace_info, 3, true);
+	}
+	auto _descriptor_indexing = this->_texture_table.get_statistics().descriptor_indexing;
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	//loading vertex shaders
+	_hr = this->_shader.load(_gDevice,
+		_content_path_dir + L"shaders/shader.vert.spv",
+		w_shader_stage_flag_bits::VERTEX_SHADER);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading vertex shader", _trace_info, 3, true);
+	}
+
+	//loading fragment shader, without descriptor indexing index of texture must be dynamically uniform
+	_hr = this->_shader.load(_gDevice,
+		_content_path_dir + (_descriptor_indexing ? L"shaders/shader.frag.spv" : L"shaders/shader_fallback.frag.spv"),
+		w_shader_stage_flag_bits::FRAGMENT_SHADER);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading fragment shader", _trace_info, 3, true);
+	}
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	_hr = _load_textures(_gDevice, _content_path_dir);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading textures", _trace_info, 3, true);
+	}
+
+	//load vertex shader uniform, one region for each swap chain image
+	_hr = this->_u0.load(_gDevice, true, static_cast<uint32_t>(_swap_chain_image_size));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading uniform", _trace_info, 3, true);
+	}
+
+	std::vector<w_shader_binding_param> _shader_params;
+
+	w_shader_binding_param _shader_param;
+	_shader_param.index = 0;
+	_shader_param.type = w_shader_binding_type::UNIFORM_DYNAMIC;
+	_shader_param.stage = w_shader_stage_flag_bits::VERTEX_SHADER;
+	_shader_param.buffer_info = this->_u0.get_descriptor_info();
+	_shader_params.push_back(_shader_param);
+
+	_hr = this->_shader.set_shader_binding_params(_shader_params);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "setting shader binding param", _trace_info, 3, true);
+	}
+
+	//all textures will be bound once at set 1
+	_hr = this->_shader.add_descriptor_set(
+		this->_texture_table.get_descriptor_set_layout(),
+		this->_texture_table.get_descriptor_set());
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "adding descriptor set of bindless texture table", _trace_info, 3, true);
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	//loading pipeline cache
+	std::string _pipeline_cache_name = "pipeline_cache";
+	if (w_pipeline::create_pipeline_cache(_gDevice, _pipeline_cache_name) == W_FAILED)
+	{
+		logger.error("could not create pipeline cache");
+		_pipeline_cache_name.clear();
+	}
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	std::map<uint32_t, std::vector<w_vertex_attribute>> _declaration;
+	_declaration[0] = { W_POS, W_UV }; //position and uv per each vertex
+	_declaration[1] = { W_VEC4, W_TEXTURE_INDEX }; //transform and slot of texture per each instance
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	w_vertex_binding_attributes _vertex_binding_attributes(_declaration);
+	_hr = this->_pipeline.load(_gDevice,
+		_vertex_binding_attributes,
+		w_primitive_topology::TRIANGLE_LIST,
+		&this->_draw_render_pass,
+		&this->_shader,
+		{ this->_viewport },
+		{ this->_viewport_scissor },
+		_pipeline_cache_name);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating solid pipeline", _trace_info, 3, true);
+	}
+
+	std::vector<float> _vertex_data =
+	{
+		-0.7f, -0.7f,	0.0f,		//pos0
+		 0.0f,  0.0f,               //uv0
+		-0.7f,  0.7f,	0.0f,		//pos1
+		 0.0f,  1.0f,               //uv1
+		 0.7f,  0.7f,	0.0f,		//pos2
+		 1.0f,  1.0f,           	//uv2
+		 0.7f, -0.7f,	0.0f,		//pos3
+		 1.0f,  0.0f,               //uv3
+	};
+
+	std::vector<uint32_t> _index_data = { 0, 1, 3, 3, 1, 2 };
+
+	this->_mesh.set_vertex_binding_attributes(_vertex_binding_attributes);
+	_hr = this->_mesh.load(_gDevice,
+		_vertex_data.data(),
+		static_cast<uint32_t>(_vertex_data.size() * sizeof(float)),
+		static_cast<uint32_t>(_vertex_data.size()),
+		_index_data.data(),
+		static_cast<uint32_t>(_index_data.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading mesh", _trace_info, 3, true);
+	}
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	_hr = _load_instances(_gDevice);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading instances", _trace_info, 3, true);
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	_hr = _build_draw_command_buffers();
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "building draw command buffers", _trace_info, 3, true);
+	}
+}
+
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+W_RESULT scene::_load_textures(
+	_In_ const std::shared_ptr<w_graphics_device>& pGDevice,
+	_In_z_ const std::wstring& pContentPathDir)
+{
+	const std::string _trace_info = this->name + "::_load_textures";
+
+	if (this->_async_loader.allocate() == W_FAILED)
+	{
+		V(W_FAILED, "allocating threads of async loader", _trace_info, 3, false);
+		return W_FAILED;
+	}
+
+	if (this->_streamer.load(pGDevice, &this->_async_loader, sStreamingBudgetInBytes) == W_FAILED)
+	{
+		V(W_FAILED, "loading texture streamer", _trace_info, 3, false);
+		return W_FAILED;
+	}
+
+	//keep slots of table in sync with resident textures of streamer
+	this->_streamer.on_texture_changed += [this](const uint32_t& pHandle, w_texture* pPrevious, w_texture* pTexture)
+	{
+		uint32_t _slot = 0;
+		auto _hr = pPrevious ?
+			this->_texture_table.replace_texture(pPrevious, pTexture) :
+			this->_texture_table.add_texture(pTexture, _slot);
+		if (_hr == W_FAILED)
+		{
+			logger.error("could not update slot of streamed texture " + std::to_string(pHandle));
+		}
+	};
+
+	//jpg has been decoded without mip maps, so its levels will be generated, dds files contain their own mip maps
+	const std::wstring _paths[] =
+	{
+		content_path + L"../Logo.jpg",
+		pContentPathDir + L"../../../../02_basics/08_texture_arrays/src/content/textures/Logo.dds",
+		pContentPathDir + L"../../../../02_basics/09_multi_textures_sampling/src/content/textures/smoke_logo.dds",
+	};
+	const size_t _number_of_paths = sizeof(_paths) / sizeof(_paths[0]);
+
+	for (uint32_t i = 0; i < sNumberOfTextures; ++i)
+	{
+		uint32_t _handle = 0;
+		if (this->_streamer.add_texture(_paths[i % _number_of_paths], true, 0, _handle) == W_FAILED)
+		{
+			V(W_FAILED, "adding texture " + std::to_string(i) + " to texture streamer", _trace_info, 3, false);
+			return W_FAILED;
+		}
+		this->_handles.push_back(_handle);
+	}
+
+	//wait for decoding of all mip chains, so tail levels of all textures are resident and have their slots
+	this->_async_loader.flush();
+	for (auto _handle : this->_handles)
+	{
+		if (!this->_streamer.get_texture(_handle))
+		{
+			V(W_FAILED, "decoding mip chain of texture " + std::to_string(_handle), _trace_info, 3, false);
+			return W_FAILED;
+		}
+	}
+
+	//write descriptor sets of all swap chain images once, before any command buffer uses the table
+	auto _number_of_frames = this->_texture_table.get_statistics().number_of_frames;
+	for (uint32_t i = 0; i < _number_of_frames; ++i)
+	{
+		if (this->_texture_table.update(i) == W_FAILED)
+		{
+			V(W_FAILED, "updating descriptor set " + std::to_string(i) + " of bindless texture table", _trace_info, 3, false);
+			return W_FAILED;
+		}
+	}
+	return W_PASSED;
+}
+
+W_RESULT scene::_load_instances(_In_ const std::shared_ptr<w_graphics_device>& pGDevice)
+{
+	const std::string _trace_info = this->name + "::_load_instances";
+
+	const float _cell_size = 2.0f / static_cast<float>(sGridSize);
+
+	std::vector<vertex_instance_data> _instances(sNumberOfInstances);
+	for (uint32_t i = 0; i < sNumberOfInstances; ++i)
+	{
+		auto _x = i % sGridSize;
+		auto _y = i / sGridSize;
+
+		//each quad samples one texture, so without descriptor indexing each quad is one draw
+		auto _instance = &_instances[i];
+		_instance->transform[0] = -1.0f + (static_cast<float>(_x) + 0.5f) * _cell_size;
+		_instance->transform[1] = -1.0f + (static_cast<float>(_y) + 0.5f) * _cell_size;
+		_instance->transform[2] = _cell_size * 0.5f;
+		_instance->transform[3] = _cell_size * 0.5f;
+		_instance->material = static_cast<float>(this->_texture_table.get_slot(this->_streamer.get_texture(this->_handles[i])));
+	}
+
+	auto _size = static_cast<uint32_t>(_instances.size() * sizeof(vertex_instance_data));
+	w_buffer _staging_buffer;
+	if (_staging_buffer.load_as_staging(pGDevice, _size) == W_FAILED ||
+		_staging_buffer.bind() == W_FAILED ||
+		_staging_buffer.set_data(_instances.data()) == W_FAILED)
+	{
+		V(W_FAILED, "loading staging buffer of instances", _trace_info, 3, false);
+		return W_FAILED;
+	}
+
+	if (this->_instances_buffer.load(
+		pGDevice,
+		_size,
+		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT) == W_FAILED ||
+		this->_instances_buffer.bind() == W_FAILED ||
+		_staging_buffer.copy_to(this->_instances_buffer) == W_FAILED)
+	{
+		V(W_FAILED, "loading device buffer of instances", _trace_info, 3, false);
+		return W_FAILED;
+	}
+	_staging_buffer.release();
+
+	return W_PASSED;
+}
+
+void scene::_request_levels()
+{
+	//size of each quad on screen, the same animation as vertex shader
+	const float _cell_size = 2.0f / static_cast<float>(sGridSize);
+	const float _half_screen = 0.5f * std::max(this->_viewport.width, this->_viewport.height);
+	for (auto _handle : this->_handles)
+	{
+		auto _material = static_cast<float>(this->_texture_table.get_slot(this->_streamer.get_texture(_handle)));
+		auto _wave = 0.55f + 0.45f * std::sin(sTotalTimeTimeInSec * 0.5f + _material);
+		this->_streamer.request_size(_handle, 1.4f * _cell_size * 0.5f * _wave * _half_screen);
+	}
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+W_RESULT scene::_build_draw_command_buffers()
+{
+	W_RESULT _hr = W_PASSED;
+
+	auto _size = this->_draw_command_buffers.get_commands_size();
+	for (uint32_t i = 0; i < _size; ++i)
+	{
+		if (_build_draw_command_buffer(i) == W_FAILED)
+		{
+			_hr = W_FAILED;
+		}
+	}
+	return _hr;
+}
+
+W_RESULT scene::_build_draw_command_buffer(_In_ const uint32_t& pIndex)
+{
+	const std::string _trace_info = this->name + "::build_draw_command_buffer";
+	W_RESULT _hr = W_PASSED;
+
+	auto _descriptor_indexing = this->_texture_table.get_statistics().descriptor_indexing;
+	auto _instances_handle = this->_instances_buffer.get_buffer_handle();
+
+	auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+	this->_draw_command_buffers.begin(pIndex);
+	{
+		this->_draw_render_pass.begin(
+			pIndex,
+			_cmd,
+			w_color::CORNFLOWER_BLUE(),
+			1.0f,
+			0);
+		{
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//The following codes have been added for this project
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//pipeline and all textures are bound once, each swap chain image has its own descriptor set of table
+			this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS, { this->_u0.get_dynamic_offset_at(pIndex) });
+			this->_texture_table.bind(_cmd, w_pipeline_bind_point::GRAPHICS, this->_pipeline.get_layout_handle(), 1, pIndex);
+
+			this->_number_of_draws = 0;
+			if (_descriptor_indexing)
+			{
+				//one draw for all materials, fragment shader indexes the table with nonuniformEXT
+				_hr = this->_mesh.draw(_cmd, &_instances_handle, sNumberOfInstances);
+				this->_number_of_draws++;
+			}
+			else
+			{
+				//index of texture must be dynamically uniform, so each quad is one draw
+				for (uint32_t j = 0; j < sNumberOfInstances; ++j)
+				{
+					_hr = this->_mesh.draw(_cmd, &_instances_handle, 1, j);
+					if (_hr == W_FAILED) break;
+					this->_number_of_draws++;
+				}
+			}
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+			//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		}
+		this->_draw_render_pass.end(_cmd);
+	}
+	this->_draw_command_buffers.end(pIndex);
+
+	return _hr;
+}
+
+void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (w_game::exiting) return;
+	const std::string _trace_info = this->name + "::update";
+
+    sFPS = pGameTime.get_frames_per_second();
+    sElapsedTimeInSec = pGameTime.get_elapsed_seconds();
+    sTotalTimeTimeInSec = pGameTime.get_total_seconds();
+
+    w_imgui::new_frame(sElapsedTimeInSec, [this]()
+    {
+        _update_gui();
+    });
+
+	w_game::update(pGameTime);
+}
+
+W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (w_game::exiting) return W_PASSED;
+
+	const std::string _trace_info = this->name + "::render";
+
+	auto _gDevice = this->graphics_devices[0];
+	auto _output_window = &(_gDevice->output_presentation_window);
+	auto _frame_index = _output_window->swap_chain_image_index;
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//completions of decoded mip chains, then residency changes based on size of quads on screen
+	this->_async_loader.update(2.0);
+	_request_levels();
+	if (this->_streamer.update() == W_FAILED)
+	{
+		V(W_FAILED, "updating texture streamer", _trace_info, 3, false);
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
+	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
+
+	const uint32_t _wait_dst_stage_mask[] =
+	{
+		w_pipeline_stage_flag_bits::COLOR_ATTACHMENT_OUTPUT_BIT,
+	};
+
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//gui buffers and command buffer of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//uniform of this swap chain image is not in use anymore
+	this->_u0.data.animation = glm::vec4(sTotalTimeTimeInSec, 0.0f, 0.0f, 0.0f);
+	if (this->_u0.update_at(_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "updating uniform", _trace_info, 3, false);
+	}
+
+	//previous submission of this swap chain image has been completed, so its descriptor set can be written even without
+	//descriptor indexing, descriptor sets of other swap chain images will be written on their own frames
+	uint32_t _number_of_writes = 0;
+	if (this->_texture_table.update(_frame_index, &_number_of_writes) == W_FAILED)
+	{
+		V(W_FAILED, "updating bindless texture table", _trace_info, 3, false);
+	}
+	//without update after bind, updating descriptor set invalidates the command buffer which has used it
+	else if (_number_of_writes &&
+		!this->_texture_table.get_statistics().descriptor_indexing &&
+		_build_draw_command_buffer(_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "building draw command buffer", _trace_info, 3, false);
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	if (_gDevice->submit(
+		{ &_draw_cmd, &_gui_cmd },//command buffers
+		_gDevice->vk_graphics_queue, //graphics queue
+		&_wait_dst_stage_mask[0], //destination masks
+		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
+		{ _output_window->rendering_done_semaphore }, //signal semaphores
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
+	}
+
+	return w_game::render(pGameTime);
+}
+
+void scene::on_window_resized(_In_ const uint32_t& pIndex, _In_ const w_point& pNewSizeOfWindow)
+{
+	w_game::on_window_resized(pIndex, pNewSizeOfWindow);
+}
+
+void scene::on_device_lost()
+{
+	w_game::on_device_lost();
+}
+
+ULONG scene::release()
+{
+    if (this->get_is_released()) return 1;
+
+    //release draw's objects
+	this->_draw_fence.release();
+	this->_draw_semaphore.release();
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	this->_u0.release();
+	this->_instances_buffer.release();
+	//cancel decoding before releasing streamer, completions refer to it
+	this->_async_loader.release();
+	this->_streamer.release();
+	this->_handles.clear();
+	this->_texture_table.release();
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	this->_draw_command_buffers.release();
+	this->_draw_render_pass.release();
+
+    //release gui's objects
+    w_imgui::release();
+
+	this->_shader.release();
+
+    this->_pipeline.release();
+
+	this->_mesh.release();
+
+	return w_game::release();
+}
+
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+bool scene::_update_gui()
+{
+    //Setting Style
+    ImGuiStyle& _style = ImGui::GetStyle();
+    _style.Colors[ImGuiCol_Text].x = 1.0f;
+    _style.Colors[ImGuiCol_Text].y = 1.0f;
+    _style.Colors[ImGuiCol_Text].z = 1.0f;
+    _style.Colors[ImGuiCol_Text].w = 1.0f;
+
+    _style.Colors[ImGuiCol_WindowBg].x = 0.0f;
+    _style.Colors[ImGuiCol_WindowBg].y = 0.4f;
+    _style.Colors[ImGuiCol_WindowBg].z = 1.0f;
+    _style.Colors[ImGuiCol_WindowBg].w = 1.0f;
+
+    ImGuiWindowFlags  _window_flags = 0;;
+    ImGui::SetNextWindowSize(ImVec2(400, 400), ImGuiSetCond_FirstUseEver);
+    bool _is_open = true;
+    if (!ImGui::Begin("Wolf.Engine", &_is_open, _window_flags))
+    {
+        ImGui::End();
+        return false;
+    }
+
+    ImGui::Text("Press Esc to exit\r\nFPS:%d\r\nFrameTime:%f\r\nTotalTime:%f\r\nMouse Position:%d,%d\r\n",
+        sFPS,
+        sElapsedTimeInSec,
+        sTotalTimeTimeInSec,
+        wolf::inputs_manager.mouse.pos_x, wolf::inputs_manager.mouse.pos_y);
+
+	auto _table_statistics = this->_texture_table.get_statistics();
+	ImGui::Text("Descriptor indexing:%s\r\nDraws:%u\r\n",
+		_table_statistics.descriptor_indexing ? "enabled" : "not available, one draw per quad",
+		this->_number_of_draws);
+
+	auto _statistics = this->_streamer.get_statistics();
+	ImGui::Text("Resident:%.2f of %.2f MB\r\nRetired:%.2f MB\r\nSystem memory:%.2f MB\r\nTextures:%u (%u pending, %u fully resident)\r\nResident levels:%u\r\nMissing levels:%u\r\nStream ins:%llu\r\nEvictions:%llu\r\nBudget misses:%llu\r\nUpload bandwidth:%.2f MB/s\r\n",
+		static_cast<double>(_statistics.resident_bytes) / (1024.0 * 1024.0),
+		static_cast<double>(_statistics.budget) / (1024.0 * 1024.0),
+		static_cast<double>(_statistics.retired_bytes) / (1024.0 * 1024.0),
+		static_cast<double>(_statistics.system_memory_bytes) / (1024.0 * 1024.0),
+		_statistics.number_of_textures,
+		_statistics.number_of_pending_textures,
+		_statistics.number_of_fully_resident_textures,
+		_statistics.number_of_resident_levels,
+		_statistics.number_of_missing_levels,
+		static_cast<unsigned long long>(_statistics.number_of_stream_ins),
+		static_cast<unsigned long long>(_statistics.number_of_evictions),
+		static_cast<unsigned long long>(_statistics.number_of_budget_misses),
+		_statistics.upload_bandwidth_in_mb_per_sec);
+
+	for (auto _handle : this->_handles)
+	{
+		ImGui::Text("Texture %u: level %u", _handle, this->_streamer.get_resident_level(_handle));
+	}
+
+    ImGui::End();
+
+    return true;
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
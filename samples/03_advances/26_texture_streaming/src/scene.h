@@ -0,0 +1,119 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : scene.h
+	Description		 : The main scene of Wolf Engine
+	Comment          : Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#if _MSC_VER > 1000
+#pragma once
+#endif
+
+#ifndef __SCENE_H__
+#define __SCENE_H__
+
+#include <w_framework/w_game.h>
+#include <w_graphics/w_command_buffers.h>
+#include <w_graphics/w_render_pass.h>
+#include <w_graphics/w_semaphore.h>
+#include <w_graphics/w_shader.h>
+#include <w_graphics/w_pipeline.h>
+#include <w_graphics/w_mesh.h>
+#include <w_graphics/w_texture.h>
+#include <w_graphics/w_uniform.h>
+#include <w_graphics/w_buffer.h>
+#include <w_graphics/w_bindless_texture_table.h>
+#include <w_graphics/w_texture_streamer.h>
+#include <w_async_loader.h>
+#include <w_graphics/w_imgui.h>
+
+class scene : public wolf::framework::w_game
+{
+public:
+	scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring& pLogPath, _In_z_ const std::wstring& pAppName);
+	virtual ~scene();
+
+	/*
+        Allows the game to perform any initialization and it needs to before starting to run.
+        Calling Game::Initialize() will enumerate through any components and initialize them as well.
+        The parameter pOutputWindowsInfo represents the information of output window(s) of this game.
+	*/
+	void initialize(_In_ std::map<int, w_window_info> pOutputWindowsInfo) override;
+
+	//The function "Load()" will be called once per game and is the place to load all of your game assets.
+	void load() override;
+
+	//This is the place where allows the game to run logic such as updating the world, checking camera, collisions, physics, input, playing audio and etc.
+	void update(_In_ const wolf::system::w_game_time& pGameTime) override;
+
+	//This is called when the game should draw itself.
+	W_RESULT render(_In_ const wolf::system::w_game_time& pGameTime) override;
+
+	//This is called when the window game should resized.
+	void on_window_resized(_In_ const uint32_t& pGraphicsDeviceIndex, _In_ const w_point& pNewSizeOfWindow) override;
+
+	//This is called when the we lost graphics device.
+	void on_device_lost() override;
+
+	//Release will be called once per game and is the place to unload assets and release all resources
+	ULONG release() override;
+
+private:
+	W_RESULT	_build_draw_command_buffers();
+	W_RESULT	_build_draw_command_buffer(_In_ const uint32_t& pIndex);
+	W_RESULT	_load_textures(_In_ const std::shared_ptr<wolf::graphics::w_graphics_device>& pGDevice,
+		_In_z_ const std::wstring& pContentPathDir);
+	void		_request_levels();
+	W_RESULT	_load_instances(_In_ const std::shared_ptr<wolf::graphics::w_graphics_device>& pGDevice);
+    bool		_update_gui();
+
+	wolf::graphics::w_viewport                                      _viewport;
+	wolf::graphics::w_viewport_scissor                              _viewport_scissor;
+
+	wolf::graphics::w_command_buffers                               _draw_command_buffers;
+	wolf::graphics::w_render_pass                                   _draw_render_pass;
+
+	wolf::graphics::w_fences                                        _draw_fence;
+	wolf::graphics::w_semaphore                                     _draw_semaphore;
+
+	wolf::graphics::w_shader                                        _shader;
+    wolf::graphics::w_pipeline                                      _pipeline;
+
+    wolf::graphics::w_mesh											_mesh;
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	struct u0
+	{
+		//x is total time in seconds
+		glm::vec4	animation;
+	};
+	wolf::graphics::w_uniform<u0>									_u0;
+
+	//layout of this structure must match with instance attributes of vertex shader
+	struct vertex_instance_data
+	{
+		//xy is offset and zw is scale
+		float	transform[4];
+		//slot of texture in bindless texture table
+		float	material;
+	};
+	wolf::graphics::w_buffer										_instances_buffer;
+
+	//decodes mip chains of textures on its threads
+	wolf::system::w_async_loader									_async_loader;
+	//streams mip levels of textures based on their size on screen
+	wolf::graphics::w_texture_streamer								_streamer;
+	//handles of streamed textures, each handle is one material
+	std::vector<uint32_t>											_handles;
+	//streamer replaces textures on residency changes, slots of table remain valid
+	wolf::graphics::w_bindless_texture_table						_texture_table;
+	uint32_t														_number_of_draws;
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+};
+
+#endif
@@ -0,0 +1,260 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample is the command line texture cooker, it generates mip chains and block compresses textures
+					   into dds or ktx files which w_texture uploads without generating mip maps at runtime
+	Comment          : Usage: 27_texture_cooker source destination [rgba8|bc1|bc3|bc4|bc5|bc7] [linear] [normal] [nomips] [ktx] [alpha=0.5]
+					   Without any argument, textures of sponza will be cooked next to their sources and load time and memory of
+					   cooked files will be compared with source files.
+					   Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#include "pch.h"
+#include <w_io.h>
+#include <w_convert.h>
+#include <w_texture_cooker.h>
+#include <gli/gli.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::content_pipeline;
+
+typedef std::chrono::steady_clock w_clock;
+
+static const char* get_format_name(_In_ const w_texture_cooker_format& pFormat)
+{
+	switch (pFormat)
+	{
+	case RGBA8_TEXTURE_COOKER_FORMAT: return "rgba8";
+	case BC1_TEXTURE_COOKER_FORMAT: return "bc1";
+	case BC3_TEXTURE_COOKER_FORMAT: return "bc3";
+	case BC4_TEXTURE_COOKER_FORMAT: return "bc4";
+	case BC5_TEXTURE_COOKER_FORMAT: return "bc5";
+	case BC7_TEXTURE_COOKER_FORMAT: return "bc7";
+	default: return "unknown";
+	}
+}
+
+static bool parse_format(_In_z_ const char* pName, _Out_ w_texture_cooker_format& pFormat)
+{
+	for (uint8_t i = RGBA8_TEXTURE_COOKER_FORMAT; i <= BC7_TEXTURE_COOKER_FORMAT; ++i)
+	{
+		auto _format = static_cast<w_texture_cooker_format>(i);
+		if (std::strcmp(pName, get_format_name(_format)) == 0)
+		{
+			pFormat = _format;
+			return true;
+		}
+	}
+	return false;
+}
+
+static void report(_In_z_ const std::string& pName, _In_ const w_texture_cooker_configs& pConfigs,
+	_In_ const w_texture_cooker_statistics& pStatistics)
+{
+	printf("%-28s %5s %4ux%-4u levels: %2u mips: %7.2f ms encode: %8.2f ms rgba8: %7.2f MB cooked: %6.2f MB\r\n",
+		pName.c_str(),
+		get_format_name(pConfigs.format),
+		pStatistics.width,
+		pStatistics.height,
+		pStatistics.levels,
+		pStatistics.mip_maps_time_in_ms,
+		pStatistics.encode_time_in_ms,
+		static_cast<double>(pStatistics.rgba_bytes) / (1024.0 * 1024.0),
+		static_cast<double>(pStatistics.cooked_bytes) / (1024.0 * 1024.0));
+}
+
+//cook one texture with configs of command line
+static int cook_from_command_line(_In_ int pArgc, _In_ char** pArgv)
+{
+	w_texture_cooker_configs _configs;
+	for (int i = 3; i < pArgc; ++i)
+	{
+		w_texture_cooker_format _format;
+		if (parse_format(pArgv[i], _format))
+		{
+			_configs.format = _format;
+		}
+		else if (std::strcmp(pArgv[i], "linear") == 0)
+		{
+			_configs.srgb = false;
+		}
+		else if (std::strcmp(pArgv[i], "normal") == 0)
+		{
+			_configs.normal_map = true;
+		}
+		else if (std::strcmp(pArgv[i], "nomips") == 0)
+		{
+			_configs.generate_mip_maps = false;
+		}
+		else if (std::strcmp(pArgv[i], "ktx") == 0)
+		{
+			_configs.container = KTX_TEXTURE_COOKER_CONTAINER;
+		}
+		else if (std::strncmp(pArgv[i], "alpha=", 6) == 0)
+		{
+			_configs.alpha_coverage_reference = static_cast<float>(std::atof(pArgv[i] + 6));
+		}
+		else
+		{
+			printf("unknown argument: %s\r\n", pArgv[i]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	w_texture_cooker_statistics _statistics;
+	if (w_texture_cooker::cook(
+		convert::string_to_wstring(pArgv[1]),
+		convert::string_to_wstring(pArgv[2]),
+		_configs,
+		&_statistics) == W_FAILED)
+	{
+		printf("could not cook %s\r\n", pArgv[1]);
+		return EXIT_FAILURE;
+	}
+	report(io::get_file_name(pArgv[1]), _configs, _statistics);
+
+	return EXIT_SUCCESS;
+}
+
+int main(int pArgc, char** pArgv)
+{
+	//initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+	logger.initialize(L"27_texture_cooker", wolf::system::io::get_current_directoryW());
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	if (pArgc > 1)
+	{
+		if (pArgc < 3)
+		{
+			printf("usage: 27_texture_cooker source destination [rgba8|bc1|bc3|bc4|bc5|bc7] [linear] [normal] [nomips] [ktx] [alpha=0.5]\r\n");
+			logger.release();
+			return EXIT_FAILURE;
+		}
+		auto _result = cook_from_command_line(pArgc, pArgv);
+		logger.release();
+		return _result;
+	}
+
+	//set content path directory
+	auto _content_path_dir = wolf::system::io::get_current_directoryW();
+#ifdef WIN32
+	_content_path_dir += L"/../../../../content/";
+#elif defined(__APPLE__)
+	_content_path_dir += L"/../../../../../content/";
+#endif // WIN32
+
+	auto _texture_dir = _content_path_dir + L"models/sponza/sponza/";
+	const wchar_t* _names[] =
+	{
+		L"chain_texture",
+		L"chain_texture_ddn",
+		L"chain_texture_mask",
+		L"spnza_bricks_a_ddn",
+		L"spnza_bricks_a_diff",
+		L"spnza_bricks_a_spec",
+		L"sponza_fabric_blue_diff",
+		L"sponza_fabric_diff",
+		L"sponza_fabric_green_diff",
+		L"sponza_fabric_spec",
+		L"sponza_floor_a_diff",
+		L"sponza_floor_a_spec",
+	};
+
+	//choose format of each texture based on its suffix
+	std::vector<std::wstring> _sources;
+	std::vector<std::wstring> _destinations;
+	std::vector<w_texture_cooker_configs> _configs;
+	for (auto _name : _names)
+	{
+		std::wstring _base_name(_name);
+		w_texture_cooker_configs _config;
+
+		auto _ends_with = [&_base_name](_In_z_ const std::wstring& pSuffix)
+		{
+			return _base_name.size() >= pSuffix.size() &&
+				_base_name.compare(_base_name.size() - pSuffix.size(), pSuffix.size(), pSuffix) == 0;
+		};
+		if (_ends_with(L"_ddn"))
+		{
+			_config.format = BC5_TEXTURE_COOKER_FORMAT;
+			_config.normal_map = true;
+		}
+		else if (_ends_with(L"_spec") || _ends_with(L"_mask"))
+		{
+			_config.format = BC4_TEXTURE_COOKER_FORMAT;
+			_config.srgb = false;
+		}
+		else
+		{
+			_config.format = BC7_TEXTURE_COOKER_FORMAT;
+		}
+
+		_sources.push_back(_texture_dir + _base_name + L".tga");
+		_destinations.push_back(_texture_dir + _base_name + L".dds");
+		_configs.push_back(_config);
+	}
+
+	//all textures and their tiles will be cooked in parallel
+	std::vector<w_texture_cooker_statistics> _statistics;
+	auto _start = w_clock::now();
+	auto _hr = w_texture_cooker::cook(_sources, _destinations, _configs, &_statistics);
+	auto _cook_time = std::chrono::duration<double, std::milli>(w_clock::now() - _start).count();
+	if (_hr == W_FAILED)
+	{
+		printf("could not cook textures of sponza\r\n");
+		logger.release();
+		return EXIT_FAILURE;
+	}
+
+	double _decode_time = 0.0;
+	double _mip_maps_time = 0.0;
+	double _load_time = 0.0;
+	uint64_t _rgba_bytes = 0;
+	uint64_t _cooked_bytes = 0;
+	for (size_t i = 0; i < _sources.size(); ++i)
+	{
+		report(convert::wstring_to_string(_names[i]), _configs[i], _statistics[i]);
+
+		//cooked files are loaded without decoding and without generating mip maps
+		_start = w_clock::now();
+		gli::texture _texture = gli::load(convert::wstring_to_string(_destinations[i]));
+		_load_time += std::chrono::duration<double, std::milli>(w_clock::now() - _start).count();
+		if (_texture.empty() || _texture.levels() != _statistics[i].levels)
+		{
+			printf("could not load cooked texture %s\r\n", convert::wstring_to_string(_destinations[i]).c_str());
+			logger.release();
+			return EXIT_FAILURE;
+		}
+
+		_decode_time += _statistics[i].decode_time_in_ms;
+		_mip_maps_time += _statistics[i].mip_maps_time_in_ms;
+		_rgba_bytes += _statistics[i].rgba_bytes;
+		_cooked_bytes += _statistics[i].cooked_bytes;
+	}
+
+	printf("\r\ncooking time of %zu textures: %.2f ms\r\n", _sources.size(), _cook_time);
+	printf("source files: decode %.2f ms, then mip maps must be generated on GPU (%.2f ms on CPU), rgba8 memory: %.2f MB\r\n",
+		_decode_time,
+		_mip_maps_time,
+		static_cast<double>(_rgba_bytes) / (1024.0 * 1024.0));
+	printf("cooked files: load %.2f ms, all levels are ready to upload, memory: %.2f MB (%.1f%% saved)\r\n",
+		_load_time,
+		static_cast<double>(_cooked_bytes) / (1024.0 * 1024.0),
+		_rgba_bytes ? 100.0 * (1.0 - static_cast<double>(_cooked_bytes) / static_cast<double>(_rgba_bytes)) : 0.0);
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	logger.release();
+
+	return EXIT_SUCCESS;
+}
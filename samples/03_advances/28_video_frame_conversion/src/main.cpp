@@ -0,0 +1,230 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample benchmarks conversion of decoded video frames with w_media_frame_converter
+	Comment          : The previous path of w_media_core, which created SwsContext for each frame, converted to BGRA,
+					   cleared destination and swizzled each pixel to ARGB, is compared with cached contexts which convert
+					   directly in to the destination at 720p, 1080p and 4K.
+					   Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#include "pch.h"
+#include <w_io.h>
+#include <w_job_system.h>
+#include <w_media_frame_converter.h>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+
+extern "C"
+{
+	#include <libavutil/imgutils.h>
+}
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::framework;
+
+typedef std::chrono::steady_clock w_clock;
+
+struct benchmark_resolution
+{
+	const char*	name;
+	int			width;
+	int			height;
+	int			frames;
+};
+
+//create a decoded frame with a moving gradient
+static AVFrame* create_yuv420p_frame(_In_ const int& pWidth, _In_ const int& pHeight)
+{
+	auto _frame = av_frame_alloc();
+	if (!_frame) return nullptr;
+
+	_frame->format = AV_PIX_FMT_YUV420P;
+	_frame->width = pWidth;
+	_frame->height = pHeight;
+	if (av_frame_get_buffer(_frame, 32) < 0)
+	{
+		av_frame_free(&_frame);
+		return nullptr;
+	}
+
+	for (int y = 0; y < pHeight; ++y)
+	{
+		for (int x = 0; x < pWidth; ++x)
+		{
+			_frame->data[0][y * _frame->linesize[0] + x] = static_cast<uint8_t>((x + y) & 0xFF);
+		}
+	}
+	for (int y = 0; y < pHeight / 2; ++y)
+	{
+		for (int x = 0; x < pWidth / 2; ++x)
+		{
+			_frame->data[1][y * _frame->linesize[1] + x] = static_cast<uint8_t>((x * 3) & 0xFF);
+			_frame->data[2][y * _frame->linesize[2] + x] = static_cast<uint8_t>((y * 5) & 0xFF);
+		}
+	}
+	return _frame;
+}
+
+//the previous path of w_media_core::buffer_video_to_memory
+static void convert_per_frame_context(
+	_In_ const AVFrame* pFrame,
+	_In_ uint8_t* pBGRA,
+	_In_ const int& pBGRARowPitch,
+	_Inout_ int* pDestination)
+{
+	auto _context = sws_getContext(
+		pFrame->width,
+		pFrame->height,
+		static_cast<AVPixelFormat>(pFrame->format),
+		pFrame->width,
+		pFrame->height,
+		AV_PIX_FMT_BGRA,
+		SWS_BICUBIC,
+		NULL,
+		NULL,
+		NULL);
+
+	uint8_t* _dst_data[4] = { pBGRA, nullptr, nullptr, nullptr };
+	int _dst_linesize[4] = { pBGRARowPitch, 0, 0, 0 };
+	sws_scale(_context, pFrame->data, pFrame->linesize, 0, pFrame->height, _dst_data, _dst_linesize);
+
+	const size_t _size = static_cast<size_t>(pFrame->width) * pFrame->height;
+	std::fill(&pDestination[0], &pDestination[_size - 1], 0);
+	for (size_t i = 0; i < _size * 4; i += 4)
+	{
+		pDestination[i / 4] = (int)((pBGRA[i + 3] & 0xFF) << 24) | ((pBGRA[i] & 0xFF) << 16) | ((pBGRA[i + 1] & 0xFF) << 8) | (pBGRA[i + 2] & 0xFF);
+	}
+
+	sws_freeContext(_context);
+}
+
+template<typename F>
+static double measure(_In_ const int& pFrames, _In_ const F& pFunction)
+{
+	auto _start = w_clock::now();
+	for (int i = 0; i < pFrames; ++i)
+	{
+		pFunction();
+	}
+	return std::chrono::duration<double, std::milli>(w_clock::now() - _start).count() / pFrames;
+}
+
+static size_t count_mismatches(_In_ const std::vector<uint8_t>& pA, _In_ const std::vector<uint8_t>& pB)
+{
+	size_t _mismatches = 0;
+	for (size_t i = 0; i < pA.size(); ++i)
+	{
+		if (pA[i] != pB[i]) _mismatches++;
+	}
+	return _mismatches;
+}
+
+int main()
+{
+	//initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+	logger.initialize(L"28_video_frame_conversion", wolf::system::io::get_current_directoryW());
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	w_job_system _job_system;
+	_job_system.allocate();
+
+	logger.write("swizzle kernel: " + std::string(w_media_frame_converter::get_swizzle_kernel_name()) +
+		", workers: " + std::to_string(_job_system.get_number_of_workers()));
+
+	const benchmark_resolution _resolutions[] =
+	{
+		{ "720p", 1280, 720, 60 },
+		{ "1080p", 1920, 1080, 30 },
+		{ "4K", 3840, 2160, 10 },
+	};
+
+	for (auto& _resolution : _resolutions)
+	{
+		auto _frame = create_yuv420p_frame(_resolution.width, _resolution.height);
+		if (!_frame)
+		{
+			logger.error("could not allocate frame of " + std::string(_resolution.name));
+			continue;
+		}
+
+		const size_t _pixels = static_cast<size_t>(_resolution.width) * _resolution.height;
+		const uint32_t _row_pitch = static_cast<uint32_t>(_resolution.width * 4);
+		std::vector<uint8_t> _bgra(_pixels * 4);
+		std::vector<uint8_t> _previous(_pixels * 4);
+		std::vector<uint8_t> _cached(_pixels * 4);
+		std::vector<uint8_t> _parallel(_pixels * 4);
+
+		//SwsContext and BGRA frame for each frame, then clear and swizzle per pixel
+		auto _previous_time = measure(_resolution.frames, [&]()
+		{
+			convert_per_frame_context(_frame, _bgra.data(), static_cast<int>(_row_pitch), reinterpret_cast<int*>(_previous.data()));
+		});
+
+		//cached context converts directly in to the destination
+		w_media_frame_converter _converter;
+		auto _cached_time = measure(_resolution.frames, [&]()
+		{
+			_converter.convert(_frame, _cached.data(), _row_pitch, AV_PIX_FMT_RGBA);
+		});
+
+		//bands of rows on all workers
+		w_media_frame_converter _parallel_converter;
+		auto _parallel_time = measure(_resolution.frames, [&]()
+		{
+			_parallel_converter.convert(_frame, _parallel.data(), _row_pitch, AV_PIX_FMT_RGBA, 0, 0, &_job_system);
+		});
+
+		//swizzle of BGRA frames, i.e. frames of capture cards
+		std::vector<uint8_t> _swizzled(_pixels * 4);
+		auto _swizzle_time = measure(_resolution.frames, [&]()
+		{
+			w_media_frame_converter::swizzle_red_blue(_bgra.data(), _row_pitch, _swizzled.data(), _row_pitch,
+				_resolution.width, _resolution.height);
+		});
+		auto _parallel_swizzle_time = measure(_resolution.frames, [&]()
+		{
+			w_media_frame_converter::swizzle_red_blue(_bgra.data(), _row_pitch, _swizzled.data(), _row_pitch,
+				_resolution.width, _resolution.height, &_job_system);
+		});
+
+		auto _statistics = _parallel_converter.get_statistics();
+		char _buffer[512];
+		std::snprintf(_buffer, sizeof(_buffer), "%-5s previous: %7.2f ms | cached: %7.2f ms | cached in %u bands: %7.2f ms | swizzle: %6.2f ms, parallel: %6.2f ms | context rebuilds: %u/%d frames | mismatched bytes: %zu, %zu, %zu",
+			_resolution.name,
+			_previous_time,
+			_cached_time,
+			_statistics.bands,
+			_parallel_time,
+			_swizzle_time,
+			_parallel_swizzle_time,
+			_converter.get_statistics().context_rebuilds,
+			_resolution.frames,
+			count_mismatches(_previous, _cached),
+			count_mismatches(_cached, _parallel),
+			count_mismatches(_previous, _swizzled));
+		logger.write(_buffer);
+
+		_converter.release();
+		_parallel_converter.release();
+		av_frame_free(&_frame);
+	}
+
+	_job_system.release();
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	logger.release();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,189 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample shows how to play media with w_media_pipeline without blocking the render loop
+	Comment          : The first pass measures how fast the pipeline can demux, decode and convert the media.
+					   The second pass plays the media in real time, audio frames are consumed like an audio device does
+					   and the render loop pops the frame of the master clock at 60 Hz.
+					   Usage: 29_media_pipeline.Win32.exe <path of media, e.g. a 4K60 H.264 or HEVC file>
+					   Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#include "pch.h"
+#include <w_io.h>
+#include <w_job_system.h>
+#include <w_media_core.h>
+#include <w_media_pipeline.h>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::framework;
+
+typedef std::chrono::steady_clock w_clock;
+
+//maximum seconds of each pass
+static const double MAX_PASS_TIME_IN_SECONDS = 10.0;
+//render loop of the second pass
+static const std::chrono::microseconds RENDER_INTERVAL(16667);
+
+//decode as fast as possible and measure throughput of pipeline
+static void benchmark_throughput(_In_ const std::wstring& pMediaPath, _In_ w_job_system& pJobSystem)
+{
+	w_media_pipeline_configs _configs;
+	_configs.enable_audio = false;
+
+	w_media_pipeline _pipeline;
+	if (_pipeline.open(pMediaPath, _configs, &pJobSystem) == W_FAILED || !_pipeline.get_has_video())
+	{
+		logger.error("could not open video of media");
+		return;
+	}
+
+	auto _start = w_clock::now();
+	double _elapsed = 0.0;
+	while (!_pipeline.get_is_end_of_stream() && _elapsed < MAX_PASS_TIME_IN_SECONDS)
+	{
+		w_media_video_frame _frame;
+		if (_pipeline.try_pop_latest_video_frame(_frame))
+		{
+			_pipeline.release_video_frame(_frame);
+		}
+		else
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		_elapsed = std::chrono::duration<double>(w_clock::now() - _start).count();
+	}
+
+	auto _statistics = _pipeline.get_statistics();
+	auto _frames = static_cast<double>(_statistics.converted_video_frames);
+	auto _fps = _elapsed > 0.0 ? _frames / _elapsed : 0.0;
+
+	char _buffer[512];
+	std::snprintf(_buffer, sizeof(_buffer),
+		"throughput of %ux%u@%.2f: %.1f fps (%.2fx real time) | decode: %.2f ms | convert: %.2f ms per frame | stalls: %llu",
+		_pipeline.get_video_width(),
+		_pipeline.get_video_height(),
+		_pipeline.get_video_frame_rate(),
+		_fps,
+		_pipeline.get_video_frame_rate() > 0.0 ? _fps / _pipeline.get_video_frame_rate() : 0.0,
+		_frames > 0.0 ? _statistics.total_decode_time_in_ms / static_cast<double>(_statistics.decoded_video_frames) : 0.0,
+		_frames > 0.0 ? _statistics.total_convert_time_in_ms / _frames : 0.0,
+		static_cast<unsigned long long>(_statistics.stalls));
+	logger.write(_buffer);
+
+	_pipeline.release();
+}
+
+//play in real time, video follows audio clock
+static void play(_In_ const std::wstring& pMediaPath, _In_ w_job_system& pJobSystem)
+{
+	w_media_pipeline_configs _configs;
+	_configs.enable_audio = true;
+
+	w_media_pipeline _pipeline;
+	if (_pipeline.open(pMediaPath, _configs, &pJobSystem) == W_FAILED)
+	{
+		logger.error("could not open media");
+		return;
+	}
+
+	size_t _shown = 0;
+	size_t _late = 0;
+	size_t _audio_frames = 0;
+	//seconds of audio which have been given to the simulated audio device
+	double _audio_queued = 0.0;
+	double _worst_render_time_in_ms = 0.0;
+
+	auto _start = w_clock::now();
+	auto _next_render = _start;
+	while (!_pipeline.get_is_end_of_stream() &&
+		std::chrono::duration<double>(w_clock::now() - _start).count() < MAX_PASS_TIME_IN_SECONDS)
+	{
+		auto _render_start = w_clock::now();
+
+		//an audio device plays continuously and requests the next frame when the previous one has been played
+		w_media_audio_frame _audio;
+		while (_pipeline.get_has_audio() &&
+			std::chrono::duration<double>(_render_start - _start).count() >= _audio_queued &&
+			_pipeline.try_pop_audio_frame(_audio))
+		{
+			_audio_queued += _audio.duration;
+			_audio_frames++;
+			_pipeline.release_audio_frame(_audio);
+		}
+
+		//upload the frame of current time, i.e. copy it to the staging buffer of texture
+		w_media_video_frame _frame;
+		if (_pipeline.try_pop_video_frame(_frame))
+		{
+			if (_frame.pts + _frame.duration < _pipeline.get_clock()) _late++;
+			_shown++;
+			_pipeline.release_video_frame(_frame);
+		}
+
+		auto _render_time = std::chrono::duration<double, std::milli>(w_clock::now() - _render_start).count();
+		if (_render_time > _worst_render_time_in_ms) _worst_render_time_in_ms = _render_time;
+
+		_next_render += RENDER_INTERVAL;
+		std::this_thread::sleep_until(_next_render);
+	}
+
+	auto _statistics = _pipeline.get_statistics();
+
+	char _buffer[512];
+	std::snprintf(_buffer, sizeof(_buffer),
+		"playback: clock: %.2f s | shown: %zu | late: %zu | skipped: %llu | audio frames: %zu | worst time of render loop: %.3f ms",
+		_pipeline.get_clock(),
+		_shown,
+		_late,
+		static_cast<unsigned long long>(_statistics.skipped_video_frames),
+		_audio_frames,
+		_worst_render_time_in_ms);
+	logger.write(_buffer);
+
+	_pipeline.release();
+}
+
+int main(int pArgc, char** pArgv)
+{
+	//initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+	logger.initialize(L"29_media_pipeline", wolf::system::io::get_current_directoryW());
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	if (pArgc < 2)
+	{
+		logger.error("usage: 29_media_pipeline <path of media>");
+		logger.release();
+		return EXIT_FAILURE;
+	}
+
+	w_media_core::register_all();
+
+	//workers convert bands of rows of each frame
+	w_job_system _job_system;
+	_job_system.allocate();
+
+	auto _media_path = wolf::system::convert::string_to_wstring(pArgv[1]);
+	benchmark_throughput(_media_path, _job_system);
+	play(_media_path, _job_system);
+
+	_job_system.release();
+	w_media_core::shut_down();
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	logger.release();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,118 @@
+/*
+	Project			 : Wolf Engine. Copyright(c) Pooya Eimandar (http://PooyaEimandar.com) . All rights reserved.
+	Source			 : Please direct any bug to https://github.com/PooyaEimandar/Wolf.Engine/issues
+	Website			 : http://WolfSource.io
+	Name			 : main.cpp
+	Description		 : This sample shows how to stream frames with the pipelined stream server of w_media_core
+	Comment          : Frames are streamed as mpegts over local udp loopback at different frame rates with both policies
+					   of late frames, and the achievable frame rate and glass to wire latency are reported for each pass.
+					   For watching the stream, use ffplay, e.g. ./ffplay udp://127.0.0.1:1234
+					   Read more information about this sample on http://wolfsource.io/gpunotes/
+*/
+
+#include "pch.h"
+#include <w_io.h>
+#include <w_media_core.h>
+#include <chrono>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::framework;
+
+static const char* STREAM_URL = "udp://127.0.0.1:1234";
+static const uint32_t STREAM_WIDTH = 1280;
+static const uint32_t STREAM_HEIGHT = 720;
+//seconds of each pass
+static const std::chrono::seconds PASS_TIME(3);
+
+static void stream(_In_ const int64_t& pFrameRate, _In_ const w_stream_late_frame_policy& pPolicy)
+{
+	w_signal<void(const w_stream_connection_info&)> _on_connection_established;
+	w_signal<void(const w_stream_frame_info&)> _on_filling_video_frame_buffer;
+	w_signal<void(const char*)> _on_connection_lost;
+
+	_on_filling_video_frame_buffer += [](const w_stream_frame_info& pFrameInfo)
+	{
+		//render a moving gradient in to the luma plane and keep chroma gray
+		auto _picture = pFrameInfo.picture;
+		for (uint32_t y = 0; y < pFrameInfo.height; ++y)
+		{
+			std::memset(_picture->data[0] + y * _picture->linesize[0], static_cast<int>((y + pFrameInfo.index * 4) & 0xff), pFrameInfo.width);
+		}
+		for (uint32_t y = 0; y < pFrameInfo.height / 2; ++y)
+		{
+			std::memset(_picture->data[1] + y * _picture->linesize[1], 128, pFrameInfo.width / 2);
+			std::memset(_picture->data[2] + y * _picture->linesize[2], 128, pFrameInfo.width / 2);
+		}
+	};
+
+	w_stream_server_configs _configs;
+	_configs.late_frame_policy = pPolicy;
+
+	w_media_core _media_core;
+	_media_core.open_stream_server_async(
+		STREAM_URL,
+		"mpegts",
+		AV_CODEC_ID_H264,
+		pFrameRate,
+		AV_PIX_FMT_YUV420P,
+		STREAM_WIDTH,
+		STREAM_HEIGHT,
+		_on_connection_established,
+		_on_filling_video_frame_buffer,
+		_on_connection_lost,
+		_configs);
+
+	std::this_thread::sleep_for(PASS_TIME);
+	auto _statistics = _media_core.get_stream_server_statistics();
+	_media_core.stop_stream_server();
+
+	auto _elapsed = _statistics.elapsed_time_in_seconds;
+	char _buffer[512];
+	std::snprintf(_buffer, sizeof(_buffer),
+		"%3lld fps target (%s): achieved %.1f fps | captured: %llu | dropped: %llu | duplicated: %llu | sent: %.2f MB | latency avg: %.2f ms max: %.2f ms",
+		static_cast<long long>(pFrameRate),
+		pPolicy == STREAM_DROP_LATE_FRAMES ? "drop" : "duplicate",
+		_elapsed > 0.0 ? static_cast<double>(_statistics.encoded_frames) / _elapsed : 0.0,
+		static_cast<unsigned long long>(_statistics.captured_frames),
+		static_cast<unsigned long long>(_statistics.dropped_frames),
+		static_cast<unsigned long long>(_statistics.duplicated_frames),
+		static_cast<double>(_statistics.sent_bytes) / (1024.0 * 1024.0),
+		_statistics.average_glass_to_wire_latency_in_ms,
+		_statistics.max_glass_to_wire_latency_in_ms);
+	logger.write(_buffer);
+
+	_media_core.release();
+}
+
+int main()
+{
+	//initialize logger, and log in to the output debug window of visual studio(just for windows) and Log folder inside running directory
+	logger.initialize(L"30_stream_server", wolf::system::io::get_current_directoryW());
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	w_media_core::register_all();
+
+	const int64_t _frame_rates[] = { 30, 60, 120, 240 };
+	for (auto _frame_rate : _frame_rates)
+	{
+		stream(_frame_rate, STREAM_DROP_LATE_FRAMES);
+		stream(_frame_rate, STREAM_DUPLICATE_LATE_FRAMES);
+	}
+
+	w_media_core::shut_down();
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	logger.release();
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,13 @@
+#version 450
+
+//frame has been converted to RGBA by decoder
+layout(binding = 0) uniform sampler2D t_frame;
+
+layout(location = 0) in vec2 i_uv;
+
+layout(location = 0) out vec4 o_color;
+
+void main() 
+{
+	o_color = texture( t_frame, i_uv );
+}
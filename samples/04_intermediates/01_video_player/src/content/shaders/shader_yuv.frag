@@ -0,0 +1,24 @@
+#version 450
+
+//planes of YUV420P frame, size of U and V is half of Y
+layout(binding = 0) uniform sampler2D t_y;
+layout(binding = 1) uniform sampler2D t_u;
+layout(binding = 2) uniform sampler2D t_v;
+
+layout(location = 0) in vec2 i_uv;
+
+layout(location = 0) out vec4 o_color;
+
+void main() 
+{
+	//limited range BT.709
+	float _y = 1.164383 * (texture( t_y, i_uv ).r - 0.062745);
+	float _u = texture( t_u, i_uv ).r - 0.501961;
+	float _v = texture( t_v, i_uv ).r - 0.501961;
+
+	o_color = vec4(
+		_y + 1.792741 * _v,
+		_y - 0.213249 * _u - 0.532909 * _v,
+		_y + 2.112402 * _u,
+		1.0);
+}
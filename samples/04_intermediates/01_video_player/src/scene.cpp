@@ -0,0 +1,563 @@
+#include "pch.h"
+#include "scene.h"
+#include <w_media_core.h>
+
+using namespace std;
+using namespace wolf;
+using namespace wolf::system;
+using namespace wolf::graphics;
+using namespace wolf::framework;
+
+static uint32_t sFPS = 0;
+static float sElapsedTimeInSec = 0;
+static float sTotalTimeTimeInSec = 0;
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//path of media inside content folder of this sample, copy any video to this path
+static const wchar_t* sMediaPath = L"media/video.mp4";
+//decoder scales frames to size of video texture
+static const uint32_t sVideoWidth = 1280;
+static const uint32_t sVideoHeight = 720;
+//false means decoder converts frames to RGBA with swscale
+static const bool sUploadYUV = true;
+//besides one slot for each swap chain image which may be copied by GPU, one slot is ready and the others are being converted
+static const uint32_t sConvertingSlots = 2;
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+scene::scene(_In_z_ const std::wstring& pContentPath, _In_z_ const std::wstring& pLogPath, _In_z_ const std::wstring& pAppName) :
+    w_game(pContentPath, pLogPath, pAppName),
+	_shown_frames(0)
+{
+	w_graphics_device_manager_configs _config;
+	_config.debug_gpu = false;
+	w_game::set_graphics_device_manager_configs(_config);
+
+	w_game::set_fixed_time_step(false);
+}
+
+scene::~scene()
+{
+	//release all resources
+	release();
+}
+
+void scene::initialize(_In_ std::map<int, w_window_info> pOutputWindowsInfo)
+{
+	// TODO: Add your pre-initialization logic here
+	w_game::initialize(pOutputWindowsInfo);
+}
+
+void scene::load()
+{
+	defer(nullptr, [&](...)
+	{
+		w_game::load();
+	});
+
+	const std::string _trace_info = this->name + "::load";
+
+	auto _gDevice = this->graphics_devices[0];
+	auto _output_window = &(_gDevice->output_presentation_window);
+
+	w_point_t _screen_size;
+	_screen_size.x = _output_window->width;
+	_screen_size.y = _output_window->height;
+
+	//initialize viewport
+	this->_viewport.y = 0;
+	this->_viewport.width = static_cast<float>(_screen_size.x);
+	this->_viewport.height = static_cast<float>(_screen_size.y);
+	this->_viewport.minDepth = 0;
+	this->_viewport.maxDepth = 1;
+
+	//initialize scissor of viewport
+	this->_viewport_scissor.offset.x = 0;
+	this->_viewport_scissor.offset.y = 0;
+	this->_viewport_scissor.extent.width = _screen_size.x;
+	this->_viewport_scissor.extent.height = _screen_size.y;
+
+	//define color and depth as an attachments buffers for render pass
+	std::vector<std::vector<w_image_view>> _render_pass_attachments;
+	for (size_t i = 0; i < _output_window->swap_chain_image_views.size(); ++i)
+	{
+		_render_pass_attachments.push_back
+		(
+			//COLOR									   , DEPTH
+			{ _output_window->swap_chain_image_views[i], _output_window->depth_buffer_image_view }
+		);
+	}
+	//create render pass
+	auto _hr = this->_draw_render_pass.load(
+		_gDevice,
+		_viewport,
+		_viewport_scissor,
+		_render_pass_attachments);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating render pass", _trace_info, 3, true);
+	}
+
+	//create semaphore
+	_hr = this->_draw_semaphore.initialize(_gDevice);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw semaphore", _trace_info, 3, true);
+	}
+
+	//Fence for syncing
+	_hr = this->_draw_fence.initialize(_gDevice, static_cast<uint32_t>(_output_window->swap_chain_image_views.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw fence", _trace_info, 3, true);
+	}
+
+	//load imgui
+	w_imgui::load(
+		_gDevice,
+		_output_window,
+		this->_viewport,
+		this->_viewport_scissor,
+		nullptr);
+
+	//create one command buffer for each swap chain image
+	auto _swap_chain_image_size = _output_window->swap_chain_image_views.size();
+	_hr = this->_draw_command_buffers.load(_gDevice, _swap_chain_image_size);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating draw command buffers", _trace_info, 3, true);
+	}
+
+#ifdef WIN32
+	auto _content_path_dir = wolf::system::io::get_current_directoryW() + L"/../../../../samples/04_intermediates/01_video_player/src/content/";
+#elif defined(__APPLE__)
+	auto _content_path_dir = wolf::system::io::get_current_directoryW() + L"/../../../../../samples/04_intermediates/01_video_player/src/content/";
+#endif // WIN32
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//staging ring and textures of planes, textures are black until the first upload
+	_hr = this->_video_texture.initialize(
+		_gDevice,
+		sVideoWidth,
+		sVideoHeight,
+		sUploadYUV ? w_video_texture_format::VIDEO_TEXTURE_YUV420P : w_video_texture_format::VIDEO_TEXTURE_RGBA,
+		static_cast<uint32_t>(_swap_chain_image_size) + sConvertingSlots);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "initializing video texture", _trace_info, 3, true);
+	}
+	this->_frames.resize(_swap_chain_image_size);
+	this->_has_frames.assign(_swap_chain_image_size, false);
+
+	w_media_core::register_all();
+	this->_job_system.allocate();
+	this->_media_path = _content_path_dir + sMediaPath;
+	if (_open_media() == W_FAILED)
+	{
+		release();
+		V(W_FAILED, L"opening media: " + this->_media_path, _trace_info, 3, true);
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	//loading vertex shaders
+	_hr = this->_shader.load(_gDevice,
+		_content_path_dir + L"shaders/shader.vert.spv",
+		w_shader_stage_flag_bits::VERTEX_SHADER);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading vertex shader", _trace_info, 3, true);
+	}
+
+	//loading fragment shader, YUV planes will be converted to RGB by fragment shader
+	_hr = this->_shader.load(_gDevice,
+		_content_path_dir + (sUploadYUV ? L"shaders/shader_yuv.frag.spv" : L"shaders/shader_rgba.frag.spv"),
+		w_shader_stage_flag_bits::FRAGMENT_SHADER);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading fragment shader", _trace_info, 3, true);
+	}
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//one sampler for each plane, textures of planes will not be changed, so descriptors are written once
+	std::vector<w_shader_binding_param> _shader_params;
+	for (uint32_t i = 0; i < this->_video_texture.get_number_of_planes(); ++i)
+	{
+		w_shader_binding_param _shader_param;
+		_shader_param.index = i;
+		_shader_param.type = w_shader_binding_type::SAMPLER2D;
+		_shader_param.stage = w_shader_stage_flag_bits::FRAGMENT_SHADER;
+		_shader_param.image_info = this->_video_texture.get_texture(i)->get_descriptor_info();
+		_shader_params.push_back(_shader_param);
+	}
+
+	_hr = this->_shader.set_shader_binding_params(_shader_params);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "setting shader binding param", _trace_info, 3, true);
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	//loading pipeline cache
+	std::string _pipeline_cache_name = "pipeline_cache";
+	if (w_pipeline::create_pipeline_cache(_gDevice, _pipeline_cache_name) == W_FAILED)
+	{
+		logger.error("could not create pipeline cache");
+		_pipeline_cache_name.clear();
+	}
+
+	w_vertex_binding_attributes _vertex_binding_attributes(w_vertex_declaration::VERTEX_POSITION_UV);
+	_hr = this->_pipeline.load(_gDevice,
+		_vertex_binding_attributes,
+		w_primitive_topology::TRIANGLE_LIST,
+		&this->_draw_render_pass,
+		&this->_shader,
+		{ this->_viewport },
+		{ this->_viewport_scissor },
+		_pipeline_cache_name);
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "creating solid pipeline", _trace_info, 3, true);
+	}
+
+	//full screen quad, the first row of frame is the top of screen
+	std::vector<float> _vertex_data =
+	{
+		-1.0f, -1.0f,	0.0f,		//pos0
+		 0.0f,  0.0f,               //uv0
+		-1.0f,  1.0f,	0.0f,		//pos1
+		 0.0f,  1.0f,               //uv1
+		 1.0f,  1.0f,	0.0f,		//pos2
+		 1.0f,  1.0f,           	//uv2
+		 1.0f, -1.0f,	0.0f,		//pos3
+		 1.0f,  0.0f,               //uv3
+	};
+
+	std::vector<uint32_t> _index_data = { 0, 1, 3, 3, 1, 2 };
+
+	this->_mesh.set_vertex_binding_attributes(_vertex_binding_attributes);
+	_hr = this->_mesh.load(_gDevice,
+		_vertex_data.data(),
+		static_cast<uint32_t>(_vertex_data.size() * sizeof(float)),
+		static_cast<uint32_t>(_vertex_data.size()),
+		_index_data.data(),
+		static_cast<uint32_t>(_index_data.size()));
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "loading mesh", _trace_info, 3, true);
+	}
+
+	_hr = _build_draw_command_buffers();
+	if (_hr == W_FAILED)
+	{
+		release();
+		V(W_FAILED, "building draw command buffers", _trace_info, 3, true);
+	}
+}
+
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+W_RESULT scene::_open_media()
+{
+	const std::string _trace_info = this->name + "::_open_media";
+
+	w_media_pipeline_configs _configs;
+	_configs.video_format = sUploadYUV ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_RGBA;
+	_configs.video_width = sVideoWidth;
+	_configs.video_height = sVideoHeight;
+	_configs.enable_audio = false;
+
+	//each slot of staging ring is one pooled buffer of pipeline, so converter writes straight into mapped memory
+	for (uint32_t i = 0; i < this->_video_texture.get_ring_size(); ++i)
+	{
+		w_video_texture_staging_frame _staging;
+		if (this->_video_texture.get_staging_frame(i, _staging) == W_FAILED)
+		{
+			V(W_FAILED, "getting slot " + std::to_string(i) + " of video texture", _trace_info, 3, false);
+			return W_FAILED;
+		}
+
+		w_media_video_buffer _buffer;
+		for (uint32_t j = 0; j < _staging.number_of_planes; ++j)
+		{
+			_buffer.planes[j] = _staging.planes[j];
+			_buffer.row_pitches[j] = _staging.row_pitches[j];
+		}
+		_configs.video_buffers.push_back(_buffer);
+	}
+
+	return this->_media_pipeline.open(this->_media_path, _configs, &this->_job_system);
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+W_RESULT scene::_build_draw_command_buffers()
+{
+	auto _size = this->_draw_command_buffers.get_commands_size();
+	for (uint32_t i = 0; i < _size; ++i)
+	{
+		if (_build_draw_command_buffer(i, false) == W_FAILED) return W_FAILED;
+	}
+	return W_PASSED;
+}
+
+W_RESULT scene::_build_draw_command_buffer(_In_ const uint32_t& pIndex, _In_ const bool& pUpload)
+{
+	W_RESULT _hr = W_PASSED;
+
+	auto _cmd = this->_draw_command_buffers.get_command_at(pIndex);
+	this->_draw_command_buffers.begin(pIndex);
+	{
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		//The following codes have been added for this project
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		//copy slot of new frame to textures before drawing, copies must be recorded outside of render pass
+		if (pUpload)
+		{
+			_hr = this->_video_texture.record_upload(_cmd, this->_frames[pIndex].slot);
+		}
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+		//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+		this->_draw_render_pass.begin(
+			pIndex,
+			_cmd,
+			w_color::BLACK(),
+			1.0f,
+			0);
+		{
+			this->_pipeline.bind(_cmd, w_pipeline_bind_point::GRAPHICS);
+			if (this->_mesh.draw(_cmd, nullptr, 0) == W_FAILED)
+			{
+				_hr = W_FAILED;
+			}
+		}
+		this->_draw_render_pass.end(_cmd);
+	}
+	this->_draw_command_buffers.end(pIndex);
+
+	return _hr;
+}
+
+void scene::update(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (w_game::exiting) return;
+	const std::string _trace_info = this->name + "::update";
+
+    sFPS = pGameTime.get_frames_per_second();
+    sElapsedTimeInSec = pGameTime.get_elapsed_seconds();
+    sTotalTimeTimeInSec = pGameTime.get_total_seconds();
+
+    w_imgui::new_frame(sElapsedTimeInSec, [this]()
+    {
+        _update_gui();
+    });
+
+	w_game::update(pGameTime);
+}
+
+W_RESULT scene::render(_In_ const wolf::system::w_game_time& pGameTime)
+{
+	if (w_game::exiting) return W_PASSED;
+
+	const std::string _trace_info = this->name + "::render";
+
+	auto _gDevice = this->graphics_devices[0];
+	auto _output_window = &(_gDevice->output_presentation_window);
+	auto _frame_index = _output_window->swap_chain_image_index;
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	if (this->_media_pipeline.get_is_end_of_stream())
+	{
+		//play media in loop, open stops threads of previous media and converts into all slots again,
+		//so only here, once per loop, wait for all frames in flight and release their frames
+		this->_draw_fence.wait();
+		for (size_t i = 0; i < this->_frames.size(); ++i)
+		{
+			if (!this->_has_frames[i]) continue;
+			this->_media_pipeline.release_video_frame(this->_frames[i]);
+			this->_has_frames[i] = false;
+		}
+		if (_open_media() == W_FAILED)
+		{
+			V(W_FAILED, L"reopening media: " + this->_media_path, _trace_info, 3, false);
+		}
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	auto _draw_cmd = this->_draw_command_buffers.get_command_at(_frame_index);
+	auto _gui_cmd = w_imgui::get_command_buffer_at(_frame_index);
+
+	const uint32_t _wait_dst_stage_mask[] =
+	{
+		w_pipeline_stage_flag_bits::COLOR_ATTACHMENT_OUTPUT_BIT,
+	};
+
+	//wait for the previous submission of this swap chain image, other frames stay in flight
+	this->_draw_fence.wait_at(_frame_index);
+	this->_draw_fence.reset_at(_frame_index);
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//GPU finished copying the slot of frame which was recorded into previous submission of this swap chain image
+	if (this->_has_frames[_frame_index])
+	{
+		this->_media_pipeline.release_video_frame(this->_frames[_frame_index]);
+		this->_has_frames[_frame_index] = false;
+	}
+
+	//textures keep the last frame when no new frame is ready
+	this->_has_frames[_frame_index] = this->_media_pipeline.try_pop_video_frame(this->_frames[_frame_index]);
+	if (this->_has_frames[_frame_index])
+	{
+		this->_shown_frames++;
+	}
+	if (_build_draw_command_buffer(_frame_index, this->_has_frames[_frame_index]) == W_FAILED)
+	{
+		V(W_FAILED, "building draw command buffer", _trace_info, 3, false);
+	}
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	//gui buffers of this swap chain image are not in use anymore
+	w_imgui::render(_frame_index);
+
+	if (_gDevice->submit(
+		{ &_draw_cmd, &_gui_cmd },//command buffers
+		_gDevice->vk_graphics_queue, //graphics queue
+		&_wait_dst_stage_mask[0], //destination masks
+		{ _output_window->swap_chain_image_is_available_semaphore }, //wait semaphores
+		{ _output_window->rendering_done_semaphore }, //signal semaphores
+		&this->_draw_fence, //fence
+		_frame_index) == W_FAILED)
+	{
+		V(W_FAILED, "submiting queue for drawing", _trace_info, 3, true);
+	}
+
+	return w_game::render(pGameTime);
+}
+
+void scene::on_window_resized(_In_ const uint32_t& pIndex, _In_ const w_point& pNewSizeOfWindow)
+{
+	w_game::on_window_resized(pIndex, pNewSizeOfWindow);
+}
+
+void scene::on_device_lost()
+{
+	w_game::on_device_lost();
+}
+
+ULONG scene::release()
+{
+    if (this->get_is_released()) return 1;
+
+    //release draw's objects
+	this->_draw_fence.release();
+	this->_draw_semaphore.release();
+
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//The following codes have been added for this project
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//stop converter before releasing the mapped memory which it writes into
+	this->_media_pipeline.release();
+	this->_job_system.release();
+	this->_video_texture.release();
+	w_media_core::shut_down();
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+	//++++++++++++++++++++++++++++++++++++++++++++++++++++
+
+	this->_draw_command_buffers.release();
+	this->_draw_render_pass.release();
+
+    //release gui's objects
+    w_imgui::release();
+
+	this->_shader.release();
+
+    this->_pipeline.release();
+
+	this->_mesh.release();
+
+	return w_game::release();
+}
+
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//The following codes have been added for this project
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+bool scene::_update_gui()
+{
+    //Setting Style
+    ImGuiStyle& _style = ImGui::GetStyle();
+    _style.Colors[ImGuiCol_Text].x = 1.0f;
+    _style.Colors[ImGuiCol_Text].y = 1.0f;
+    _style.Colors[ImGuiCol_Text].z = 1.0f;
+    _style.Colors[ImGuiCol_Text].w = 1.0f;
+
+    _style.Colors[ImGuiCol_WindowBg].x = 0.0f;
+    _style.Colors[ImGuiCol_WindowBg].y = 0.4f;
+    _style.Colors[ImGuiCol_WindowBg].z = 1.0f;
+    _style.Colors[ImGuiCol_WindowBg].w = 1.0f;
+
+    ImGuiWindowFlags  _window_flags = 0;;
+    ImGui::SetNextWindowSize(ImVec2(400, 400), ImGuiSetCond_FirstUseEver);
+    bool _is_open = true;
+    if (!ImGui::Begin("Wolf.Engine", &_is_open, _window_flags))
+    {
+        ImGui::End();
+        return false;
+    }
+
+    ImGui::Text("Press Esc to exit\r\nFPS:%d\r\nFrameTime:%f\r\nTotalTime:%f\r\nMouse Position:%d,%d\r\n",
+        sFPS,
+        sElapsedTimeInSec,
+        sTotalTimeTimeInSec,
+        wolf::inputs_manager.mouse.pos_x, wolf::inputs_manager.mouse.pos_y);
+
+	//converter writes each frame into mapped staging memory by one plane copy, swizzle or sws_scale pass and GPU copies each plane of it to textures
+	auto _pipeline_statistics = this->_media_pipeline.get_statistics();
+	auto _texture_statistics = this->_video_texture.get_statistics();
+	auto _converted = _pipeline_statistics.converted_video_frames;
+	auto _uploaded = _texture_statistics.uploaded_frames;
+	ImGui::Text("Video:%ux%u %s\r\nFrame rate:%.2f\r\nShown frames:%llu\r\nSkipped frames:%llu\r\nCPU copies:%llu plane copy, %llu swizzle, %llu sws_scale\r\nGPU copies:%llu, %.2f per frame\r\nConvert CPU time:%.3f ms/frame\r\nRecord upload CPU time:%.3f ms\r\nUploaded:%.2f MB\r\n",
+		this->_video_texture.get_width(),
+		this->_video_texture.get_height(),
+		sUploadYUV ? "YUV420P, converted to RGB by shader" : "RGBA, converted by swscale",
+		this->_media_pipeline.get_video_frame_rate(),
+		static_cast<unsigned long long>(this->_shown_frames),
+		static_cast<unsigned long long>(_pipeline_statistics.skipped_video_frames),
+		static_cast<unsigned long long>(_pipeline_statistics.copied_video_frames),
+		static_cast<unsigned long long>(_pipeline_statistics.swizzled_video_frames),
+		static_cast<unsigned long long>(_pipeline_statistics.scaled_video_frames),
+		static_cast<unsigned long long>(_texture_statistics.recorded_copies),
+		_uploaded ? static_cast<double>(_texture_statistics.recorded_copies) / static_cast<double>(_uploaded) : 0.0,
+		_converted ? _pipeline_statistics.total_convert_time_in_ms / static_cast<double>(_converted) : 0.0,
+		_texture_statistics.last_record_time_in_ms,
+		static_cast<double>(_texture_statistics.uploaded_bytes) / (1024.0 * 1024.0));
+
+    ImGui::End();
+
+    return true;
+}
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
+//++++++++++++++++++++++++++++++++++++++++++++++++++++
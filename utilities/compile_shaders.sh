@@ -0,0 +1,41 @@
+#!/bin/bash
+#compile glsl shaders to spir-v, each shader will be written next to its source as <shader>.spv
+#usage: compile_shaders.sh [-f] [directories or files...], default is content/shaders
+#	-f forces compiling all shaders, otherwise only missing or out of date .spv files will be compiled
+#set GLSLANG_VALIDATOR to the path of glslangValidator if it is not in PATH
+set -e
+
+RUN_DIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+GLSLANG_VALIDATOR="${GLSLANG_VALIDATOR:-glslangValidator}"
+
+FORCE=0
+if [ "$1" == "-f" ]; then
+	FORCE=1
+	shift
+fi
+
+if ! command -v "$GLSLANG_VALIDATOR" > /dev/null 2>&1; then
+	echo "could not find $GLSLANG_VALIDATOR, install the vulkan sdk or set GLSLANG_VALIDATOR"
+	exit 1
+fi
+
+if [ $# -eq 0 ]; then
+	set -- "$RUN_DIR/../content/shaders"
+fi
+
+COMPILED=0
+FAILED=0
+while IFS= read -r -d '' SHADER; do
+	if [ $FORCE -eq 1 ] || [ ! -f "$SHADER.spv" ] || [ "$SHADER" -nt "$SHADER.spv" ]; then
+		if "$GLSLANG_VALIDATOR" -V -o "$SHADER.spv" "$SHADER"; then
+			COMPILED=$((COMPILED + 1))
+		else
+			FAILED=$((FAILED + 1))
+		fi
+	fi
+done < <(find "$@" -type f \( -name "*.vert" -o -name "*.frag" -o -name "*.comp" -o -name "*.geom" -o -name "*.tesc" -o -name "*.tese" \) -print0)
+
+echo "$COMPILED shader(s) compiled, $FAILED failed"
+if [ $FAILED -ne 0 ]; then
+	exit 1
+fi